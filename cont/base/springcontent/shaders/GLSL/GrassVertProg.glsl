@@ -1,6 +1,10 @@
 #version 410 core
 
-uniform mat4 turfMatrices[128];
+uniform vec4 blockParams[128]; // xy := grass-square coors, z := draw probability
+uniform int turfsPerBlock;
+
+uniform sampler2D heightMapTex;
+
 uniform mat4 viewMatrix;
 uniform mat4 projMatrix;
 
@@ -42,6 +46,9 @@ out float fogFactor;
 
 const float PI = 3.14159265358979323846264;
 
+const float SQUARE_SIZE = 8.0;
+const float GRASS_SQUARE_SIZE = SQUARE_SIZE * 4.0;
+
 
 
 //////////////////////////////////////////////////////////////////////
@@ -82,15 +89,54 @@ void ApplyDetailBending(inout vec3 vPos, vec3 vNormal, float fDetailPhase, float
 
 
 
+// deterministic per-turf randomness; the same turf always draws the
+// same values so density-thinning with distance does not shimmer
+float HashRand(vec2 seed) { return fract(sin(dot(seed, vec2(12.9898, 78.233))) * 43758.5453); }
+
+float GroundHeight(vec2 worldPos, out float slope)
+{
+	vec2 hmCoor = worldPos * (1.0 / SQUARE_SIZE);
+	ivec2 hmSize = textureSize(heightMapTex, 0) - ivec2(1);
+	ivec2 hmIndx = clamp(ivec2(hmCoor), ivec2(0), hmSize - ivec2(1));
+	vec2 hmFrac = clamp(hmCoor - vec2(hmIndx), 0.0, 1.0);
+
+	float h00 = texelFetch(heightMapTex, hmIndx              , 0).x;
+	float h10 = texelFetch(heightMapTex, hmIndx + ivec2(1, 0), 0).x;
+	float h01 = texelFetch(heightMapTex, hmIndx + ivec2(0, 1), 0).x;
+	float h11 = texelFetch(heightMapTex, hmIndx + ivec2(1, 1), 0).x;
+
+	vec2 grad = vec2(h10 - h00, h01 - h00) * (1.0 / SQUARE_SIZE);
+	slope = 1.0 - inversesqrt(1.0 + dot(grad, grad));
+
+	return mix(mix(h00, h10, hmFrac.x), mix(h01, h11, hmFrac.x), hmFrac.y);
+}
+
+
 
 void main() {
-	// NB: technically need the inverse transpose, etc
-	mat4 turfMatrix = turfMatrices[gl_InstanceID];
-	mat3 nrmlMatrix = mat3(turfMatrix);
+	int blockIndx = gl_InstanceID / turfsPerBlock;
+	int turfIndx  = gl_InstanceID - (blockIndx * turfsPerBlock);
+
+	vec4 block = blockParams[blockIndx];
+	vec2 seed  = block.xy + vec2(turfIndx * 2, turfIndx * 3);
+
+	float turfProb = float(HashRand(seed + 17.0) <= block.z);
+	float rotAngle = HashRand(seed + 29.0) * 2.0 * PI;
+
+	vec2 basePosXZ = (block.xy + vec2(HashRand(seed + 3.0), HashRand(seed + 7.0))) * GRASS_SQUARE_SIZE;
+
+	float slope = 0.0;
+	float height = GroundHeight(basePosXZ, slope);
 
-	vec4 vertexPos = vec4(positionAttr, 1.0);
-	vec4 worldPos = turfMatrix * vertexPos;
-	vec3 objPos = nrmlMatrix * vertexPos.xyz;
+	// sink turfs into steeper terrain like the CPU placement did
+	vec3 basePos = vec3(basePosXZ.x, height - slope * 30.0, basePosXZ.y);
+
+	float ca = cos(rotAngle);
+	float sa = sin(rotAngle);
+	mat3 nrmlMatrix = mat3(ca, 0.0, -sa,  0.0, 1.0, 0.0,  sa, 0.0, ca);
+
+	vec3 objPos = nrmlMatrix * positionAttr;
+	vec4 worldPos = vec4(basePos + objPos, 1.0);
 
 	wsNormal = nrmlMatrix * normalAttr;
 	// animate
@@ -98,6 +144,9 @@ void main() {
 
 	ApplyDetailBending(worldPos.xyz, wsNormal,  texCoordAttr.s, frame / 30.0, 0.3, texCoordAttr.t * 0.4);
 
+	// density-culled turfs collapse into zero-area triangles at their base
+	worldPos.xyz = mix(basePos, worldPos.xyz, turfProb);
+
 	{
 		// compute ambient & diffuse lighting per-vertex, specular is per-pixel
 		// TODO: make front/back surface constants customizable?
@@ -136,4 +185,3 @@ void main() {
 		// fogFactor = clamp(fogDepth, 0.0, 1.0);
 	}
 }
-
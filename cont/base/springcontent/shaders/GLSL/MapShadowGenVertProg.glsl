@@ -2,11 +2,21 @@ uniform mat4 shadowViewMat;
 uniform mat4 shadowProjMat;
 uniform vec4 shadowParams;
 
+// replaces vertex heights by the current heightmap values when set
+// to 1 (GroundGPUDisplacement); must stay a uniform rather than a
+// compile-time flag since the border skirt is drawn undisplaced
+uniform sampler2D heightMapTex;
+uniform float heightMapDisplace;
+
 layout(location = 0) in vec3 vtxPositionAttr;
 
 
 void main() {
-	vec4 vertexShadowPos = shadowViewMat * vec4(vtxPositionAttr, 1.0);
+	vec4 vertexPos = vec4(vtxPositionAttr, 1.0);
+
+	vertexPos.y = mix(vertexPos.y, texelFetch(heightMapTex, ivec2(vertexPos.xz * (1.0 / SMF_SQUARE_SIZE)), 0).x, heightMapDisplace);
+
+	vec4 vertexShadowPos = shadowViewMat * vertexPos;
 
 	gl_Position = shadowProjMat * vertexShadowPos;
 }
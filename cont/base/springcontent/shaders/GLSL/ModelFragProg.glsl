@@ -38,7 +38,9 @@ uniform vec4 nanoColor;
 uniform vec4 alphaTestCtrl;
 
 // fwdDynLights[i] := {pos, dir, diffuse, specular, ambient, {fov, radius, -, -}}
+// only the first numDynLights entries are valid, the rest are culled
 uniform vec4 fwdDynLights[MAX_LIGHT_UNIFORM_VECS];
+uniform int numDynLights;
 
 
 in vec4 worldPos;
@@ -77,7 +79,7 @@ vec3 DynamicLighting(vec3 wsNormal, vec3 camDir, vec3 diffuseColor, vec4 specula
 	vec3 light = vec3(0.0);
 
 	#if (NUM_DYNAMIC_MODEL_LIGHTS > 0)
-	for (int i = 0; i < NUM_DYNAMIC_MODEL_LIGHTS; i++) {
+	for (int i = 0; i < numDynLights; i++) {
 		int j = i * 6;
 
 		vec4 wsLightPos = fwdDynLights[j + 0];
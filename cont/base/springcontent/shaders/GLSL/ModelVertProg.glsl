@@ -12,12 +12,22 @@ layout(location = 6) in uint pieceIdxAttr;
 // #define use_normalmapping
 // #define flip_normalmap
 
-uniform mat4 pieceMatrices[128];
+// bound once to IUnitDrawerState::PIECE_MATRIX_UBO_BINDING, the engine
+// uploads each unit's piece matrices as a single block before drawing
+layout(std140) uniform PieceMatrices {
+	mat4 pieceMatrices[128];
+};
 
 uniform mat4 modelMatrix;
 uniform mat4  viewMatrix;
 uniform mat4  projMatrix;
 
+// per-instance (model + piece) matrices when drawing instanced batches;
+// each instance occupies instanceMatCount consecutive mat4's (the model
+// matrix followed by its piece matrices), 0 selects the uniform path
+uniform samplerBuffer instanceMats;
+uniform int instanceMatCount;
+
 uniform vec3 cameraPos;
 uniform vec3 fogParams;
 
@@ -46,11 +56,27 @@ mat4 mat4mix(mat4 a, mat4 b, float alpha) {
 	return (a * (1.0 - alpha) + b * alpha);
 }
 
+mat4 GetInstanceMatrix(int idx) {
+	int base = (gl_InstanceID * instanceMatCount + idx) * 4;
+	return mat4(
+		texelFetch(instanceMats, base + 0),
+		texelFetch(instanceMats, base + 1),
+		texelFetch(instanceMats, base + 2),
+		texelFetch(instanceMats, base + 3)
+	);
+}
+
 void main(void)
 {
-	// mat4 pieceMatrix = mat4mix(mat4(1.0), pieceMatrices[pieceIdxAttr], pieceMatrices[0][3][3]);
-	mat4 pieceMatrix = pieceMatrices[pieceIdxAttr];
-	mat4 modelPieceMatrix = modelMatrix * pieceMatrix;
+	mat4 modelPieceMatrix;
+
+	if (instanceMatCount != 0) {
+		modelPieceMatrix = GetInstanceMatrix(0) * GetInstanceMatrix(1 + int(pieceIdxAttr));
+	} else {
+		// mat4 pieceMatrix = mat4mix(mat4(1.0), pieceMatrices[pieceIdxAttr], pieceMatrices[0][3][3]);
+		mat4 pieceMatrix = pieceMatrices[pieceIdxAttr];
+		modelPieceMatrix = modelMatrix * pieceMatrix;
+	}
 
 	vec4 vertexPos = vec4(positionAttr, 1.0);
 	vec4 vertexModelPos = modelPieceMatrix * vertexPos;
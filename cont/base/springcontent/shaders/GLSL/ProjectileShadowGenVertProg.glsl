@@ -1,7 +1,9 @@
 uniform mat4 shadowViewMat;
 uniform mat4 shadowProjMat;
 uniform mat4 modelMat;
-uniform mat4 pieceMats[128];
+layout(std140) uniform PieceMatrices {
+	mat4 pieceMats[128];
+};
 uniform vec4 shadowParams;
 
 
@@ -33,7 +33,9 @@ uniform vec4 fogColor;
 
 uniform mat4 viewMat;
 
+// only the first numDynLights entries are valid, the rest are culled
 uniform vec4 fwdDynLights[MAX_LIGHT_UNIFORM_VECS];
+uniform int numDynLights;
 
 uniform ivec4 texSquare;
 
@@ -258,7 +260,7 @@ vec3 DynamicLighting(vec3 wsNormal, vec3 camDir, vec3 diffuseColor, vec4 specula
 	#endif
 
 	#if (NUM_DYNAMIC_MAP_LIGHTS > 0)
-	for (int i = 0; i < NUM_DYNAMIC_MAP_LIGHTS; i++) {
+	for (int i = 0; i < numDynLights; i++) {
 		int j = i * 6;
 
 		vec4 wsLightPos = fwdDynLights[j + 0];
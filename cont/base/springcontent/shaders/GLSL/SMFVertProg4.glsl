@@ -13,6 +13,10 @@ uniform mat4 viewMat;
 uniform mat4 viewMatInv;
 uniform mat4 viewProjMat;
 
+#if (SMF_GPU_DISPLACEMENT == 1)
+uniform sampler2D heightMapTex;
+#endif
+
 
 layout(location = 0) in vec3 vertexPosAttr;
 
@@ -25,13 +29,20 @@ out float fogFactor;
 
 
 void main() {
+	vertexPos = vec4(vertexPosAttr, 1.0);
+
+	#if (SMF_GPU_DISPLACEMENT == 1)
+	// mesh vertices sit at heightmap texel corners; sampling the current
+	// height here keeps patch buffers static across terrain deformation
+	vertexPos.y = texelFetch(heightMapTex, ivec2(vertexPos.xz * (1.0 / SMF_SQUARE_SIZE)), 0).x;
+	#endif
+
 	// vec4 viewDir = viewMatInv * vec4(0.0, 0.0, 0.0, 1.0);
 	vec4 viewDir = vec4(cameraPos, 1.0);
 
-	viewDir.xyz = normalize(viewDir.xyz - vertexPosAttr);
+	viewDir.xyz = normalize(viewDir.xyz - vertexPos.xyz);
 	halfDir.xyz = normalize(lightDir.xyz + viewDir.xyz);
 
-	vertexPos = vec4(vertexPosAttr, 1.0);
 	diffuseTexCoords = (floor(vertexPos.xz) / SMF_TEXSQR_SIZE) - texSquare.xy;
 
 	gl_Position = viewProjMat * vertexPos;
@@ -7,7 +7,7 @@ uniform mat4 shadowViewMat;
 uniform mat4 shadowProjMat;
 uniform vec4 shadowParams;
 
-uniform mat4 treeMat;
+uniform mat4 treeMats[64];
 uniform vec3 cameraDirX;
 uniform vec3 cameraDirY;
 
@@ -21,6 +21,7 @@ out vec4 vBaseColor;
 
 
 void main() {
+	mat4 treeMat = treeMats[gl_InstanceID];
 	vec4 vertexPos = vec4(vtxPositionAttr, 1.0);
 		vertexPos.xyz += (cameraDirX * vtxNormalAttr.x);
 		vertexPos.xyz += (cameraDirY * vtxNormalAttr.y);
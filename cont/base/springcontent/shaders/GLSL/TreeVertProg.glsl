@@ -2,7 +2,7 @@
 
 uniform mat4 projMat;
 uniform mat4 viewMat;
-uniform mat4 treeMat;             // world-transform
+uniform mat4 treeMats[64];        // world-transforms, one per instance
 
 uniform vec3 cameraDirX;          // needed for bush-type trees
 uniform vec3 cameraDirY;
@@ -27,6 +27,7 @@ out float vFogFactor;
 
 
 void main() {
+	mat4 treeMat = treeMats[gl_InstanceID];
 	vec4 vertexPos = vec4(vtxPositionAttr, 1.0);
 
 	vertexPos.xyz += (cameraDirX * vtxNormalAttr.x);
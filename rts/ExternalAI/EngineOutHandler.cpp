@@ -19,6 +19,7 @@
 #include "Sim/Units/CommandAI/Command.h"
 #include "Sim/Weapons/WeaponDef.h"
 #include "Net/Protocol/NetProtocol.h"
+#include "System/Config/ConfigHandler.h"
 #include "System/Log/ILog.h"
 #include "System/TimeProfiler.h"
 #include "System/SafeUtil.h"
@@ -29,11 +30,18 @@ CR_REG_METADATA(CEngineOutHandler, (
 	CR_IGNORED(hostSkirmishAIs),
 	CR_IGNORED(teamSkirmishAIs),
 	CR_IGNORED(activeSkirmishAIs),
+	CR_IGNORED(queuedEvents),
+	CR_IGNORED(batchEvents),
 
 	CR_POSTLOAD(PostLoad)
 ))
 
 
+CONFIG(bool, BatchedAIEvents)
+	.defaultValue(false)
+	.description("If enabled, Skirmish-AI events generated during a sim frame are queued and handed to the AI's in one batch at the start of the next frame, instead of interrupting the simulation for every event.");
+
+
 static inline bool IsUnitInLosOrRadarOfAllyTeam(const CUnit& unit, const int allyTeamId) {
 	// NOTE:
 	//   we check for globalLOS because the LOS-state of a
@@ -76,6 +84,14 @@ void CEngineOutHandler::Destroy() {
 }
 
 
+void CEngineOutHandler::Init() {
+	activeSkirmishAIs.reserve(16);
+
+	// can be null when running the dedicated server
+	batchEvents = (configHandler != nullptr && configHandler->GetBool("BatchedAIEvents"));
+}
+
+
 // This macro should be inserted at the start of each method sending AI events
 #define AI_SCOPED_TIMER()           \
 	if (activeSkirmishAIs.empty())  \
@@ -87,6 +103,17 @@ void CEngineOutHandler::Destroy() {
 		hostSkirmishAIs[aiID].FUNC;          \
 	}
 
+// Dispatch <FUNC> to a single AI, either immediately or (if batching
+// is enabled) via the per-frame event queue drained in Update(); the
+// arguments are all captured by value and visibility filtering runs
+// at queuing time, so batched delivery preserves the event semantics.
+#define AI_EVENT(AI_ID, FUNC)                                                         \
+	if (!batchEvents) {                                                               \
+		hostSkirmishAIs[AI_ID].FUNC;                                                  \
+	} else {                                                                          \
+		queuedEvents.emplace_back(AI_ID, [=](CSkirmishAIWrapper& aiInst) { aiInst.FUNC; });   \
+	}
+
 
 void CEngineOutHandler::PostLoad()
 {
@@ -95,6 +122,9 @@ void CEngineOutHandler::PostLoad()
 }
 
 void CEngineOutHandler::PreDestroy() {
+	// drop (rather than deliver) any still-queued events
+	queuedEvents.clear();
+
 	AI_SCOPED_TIMER();
 	DO_FOR_SKIRMISH_AIS(PreDestroy())
 }
@@ -127,6 +157,20 @@ void CEngineOutHandler::Save(std::ostream* s, const uint8_t skirmishAIId) {
 
 void CEngineOutHandler::Update() {
 	AI_SCOPED_TIMER();
+
+	// deliver the events queued during the last sim frame in one batch
+	if (!queuedEvents.empty()) {
+		for (const auto& ev: queuedEvents) {
+			// AI might have been destroyed after the event was queued
+			if (!hostSkirmishAIs[ev.first].Active())
+				continue;
+
+			ev.second(hostSkirmishAIs[ev.first]);
+		}
+
+		queuedEvents.clear();
+	}
+
 	DO_FOR_SKIRMISH_AIS(Update(gs->frameNum))
 }
 
@@ -143,7 +187,7 @@ void CEngineOutHandler::Update() {
 		const int aiAllyTeam = teamHandler.AllyTeam(ai.GetTeamId());         \
                                                                              \
 		if (teamHandler.Ally(aiAllyTeam, ALLY_TEAM_ID)) {                    \
-			ai.FUNC;                                                         \
+			AI_EVENT(aiID, FUNC)                                             \
 		}                                                                    \
 	}
 
@@ -191,7 +235,7 @@ void CEngineOutHandler::UnitLeftRadar(const CUnit& unit, int allyTeamId) {
 		return;                                       \
                                                       \
 	for (uint8_t aiID: teamSkirmishAIs[TEAM_ID]) {    \
-		hostSkirmishAIs[aiID].FUNC;                   \
+		AI_EVENT(aiID, FUNC)                          \
 	}                                                 \
 
 
@@ -212,7 +256,7 @@ void CEngineOutHandler::UnitLeftRadar(const CUnit& unit, int allyTeamId) {
 		if (!cheatingAI && !IsUnitInLosOrRadarOfAllyTeam(UNIT, aiAllyTeam))     \
 			continue;                                                           \
                                                                                 \
-		aiWrapper.FUNC;                                                         \
+		AI_EVENT(aiID, FUNC)                                                    \
 	}
 
 
@@ -291,7 +335,7 @@ void CEngineOutHandler::UnitGiven(const CUnit& unit, int oldTeam, int newTeam) {
 		if (!informAI)
 			continue;
 
-		aiWrapper.UnitGiven(unitId, oldTeam, newTeam);
+		AI_EVENT(aiID, UnitGiven(unitId, oldTeam, newTeam))
 	}
 }
 
@@ -327,7 +371,7 @@ void CEngineOutHandler::UnitCaptured(const CUnit& unit, int oldTeam, int newTeam
 		if (!informAI)
 			continue;
 
-		aiWrapper.UnitCaptured(unitId, oldTeam, newTeam);
+		AI_EVENT(aiID, UnitCaptured(unitId, oldTeam, newTeam))
 	}
 }
 
@@ -348,7 +392,7 @@ void CEngineOutHandler::UnitDestroyed(const CUnit& destroyed, const CUnit* attac
 			if (attackerInLosOrRadar || hostSkirmishAIs[aiID].CheatEventsEnabled())
 				visibleAttackerId = attackerId;
 
-			hostSkirmishAIs[aiID].UnitDestroyed(destroyedId, visibleAttackerId);
+			AI_EVENT(aiID, UnitDestroyed(destroyedId, visibleAttackerId))
 		}
 	}
 
@@ -370,7 +414,7 @@ void CEngineOutHandler::UnitDestroyed(const CUnit& destroyed, const CUnit* attac
 		if ((attacker != nullptr) && teamHandler.Ally(aiAllyTeam, attacker->allyteam))
 			myAttackerId = attackerId;
 
-		aiWrapper.EnemyDestroyed(destroyedId, myAttackerId);
+		AI_EVENT(aiID, EnemyDestroyed(destroyedId, myAttackerId))
 	}
 }
 
@@ -404,7 +448,7 @@ void CEngineOutHandler::UnitDamaged(
 			if (attackerInLosOrRadar || hostSkirmishAIs[aiID].CheatEventsEnabled())
 				visibleAttackerUnitId = attackerUnitId;
 
-			hostSkirmishAIs[aiID].UnitDamaged(damagedUnitId, visibleAttackerUnitId, damage, attackeeDir, weaponDefID, paralyzer);
+			AI_EVENT(aiID, UnitDamaged(damagedUnitId, visibleAttackerUnitId, damage, attackeeDir, weaponDefID, paralyzer))
 		}
 	}
 
@@ -427,7 +471,7 @@ void CEngineOutHandler::UnitDamaged(
 		if (!damagedInLosOrRadar && !hostSkirmishAIs[aiID].CheatEventsEnabled())
 			continue;
 
-		hostSkirmishAIs[aiID].EnemyDamaged(damagedUnitId, attackerUnitId, damage, attackerDir, weaponDefID, paralyzer);
+		AI_EVENT(aiID, EnemyDamaged(damagedUnitId, attackerUnitId, damage, attackerDir, weaponDefID, paralyzer))
 	}
 }
 
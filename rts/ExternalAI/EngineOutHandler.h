@@ -8,6 +8,8 @@
 #include "Sim/Misc/GlobalConstants.h"
 
 #include <array>
+#include <functional>
+#include <utility>
 #include <vector>
 #include <string>
 
@@ -31,7 +33,7 @@ public:
 	static void Create();
 	static void Destroy();
 
-	void Init() { activeSkirmishAIs.reserve(16); }
+	void Init();
 	void Kill() {
 		PreDestroy();
 
@@ -116,6 +118,16 @@ private:
 	std::array<std::vector<uint8_t>, MAX_TEAMS> teamSkirmishAIs;
 
 	std::vector<uint8_t> activeSkirmishAIs;
+
+	/**
+	 * Events queued during a sim frame for batched delivery at the
+	 * start of the next Update; pairs of AI ID and bound dispatch.
+	 * Only used if batchEvents is set.
+	 */
+	std::vector< std::pair<uint8_t, std::function<void(CSkirmishAIWrapper&)>> > queuedEvents;
+
+	/// see the BatchedAIEvents config-option
+	bool batchEvents = false;
 };
 
 #define eoh CEngineOutHandler::GetInstance()
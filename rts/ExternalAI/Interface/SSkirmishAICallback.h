@@ -2269,6 +2269,25 @@ struct SSkirmishAICallback {
 
 	bool              (CALLING_CONV *Debug_GraphDrawer_isEnabled)(int skirmishAIId);
 
+	/**
+	 * Bulk per-frame snapshot of all units currently known to this AI
+	 * (own and allied units plus enemies in LOS/radar, everything with
+	 * cheats enabled). Fills the caller-supplied parallel arrays in a
+	 * single callback instead of one Unit_get* round-trip per field per
+	 * unit; any output pointer may be NULL to skip that field. Field
+	 * values follow the same LOS/radar-error/decoy rules as the scalar
+	 * getters.
+	 *
+	 * @param unitIds    output ids, or NULL
+	 * @param pos_posF3s output positions (3 floats per unit), or NULL
+	 * @param vel_posF3s output velocities (3 floats per unit), or NULL
+	 * @param healths    output current healths, or NULL
+	 * @param teamIds    output owning team ids, or NULL
+	 * @param unitIds_sizeMax capacity of each array, in units
+	 * @return number of units written
+	 */
+	int               (CALLING_CONV *getUnitsSnapshot)(int skirmishAIId, int* unitIds, float* pos_posF3s, float* vel_posF3s, float* healths, int* teamIds, int unitIds_sizeMax); //$ ARRAY:unitIds
+
 };
 
 #if	defined(__cplusplus)
@@ -3953,6 +3953,57 @@ EXPORT(int) skirmishAiCallback_getSelectedUnits(int skirmishAIId, int* unitIds,
 	return GetCallBack(skirmishAIId)->GetSelectedUnits(unitIds, unitIdsMaxSize);
 }
 
+EXPORT(int) skirmishAiCallback_getUnitsSnapshot(
+	int skirmishAIId,
+	int* unitIds,
+	float* pos_posF3s,
+	float* vel_posF3s,
+	float* healths,
+	int* teamIds,
+	int maxUnits
+) {
+	if (maxUnits <= 0)
+		return 0;
+
+	// scratch id list; callbacks all run sequentially on the main thread
+	static std::vector<int> snapshotIds;
+
+	snapshotIds.resize(unitHandler.MaxUnits());
+
+	CAICallback* cb = GetCallBack(skirmishAIId);
+
+	int* ids = snapshotIds.data();
+	int numUnits = cb->GetFriendlyUnits(ids, snapshotIds.size());
+
+	if (skirmishAiCallback_Cheats_isEnabled(skirmishAIId)) {
+		numUnits += GetCheatCallBack(skirmishAIId)->GetEnemyUnits(&ids[numUnits], snapshotIds.size() - numUnits);
+	} else {
+		numUnits += cb->GetEnemyUnitsInRadarAndLos(&ids[numUnits], snapshotIds.size() - numUnits);
+	}
+
+	numUnits = std::min(numUnits, maxUnits);
+
+	// only one crossing of the AI<->engine boundary; the per-field
+	// getters are plain function calls from here and keep the exact
+	// LOS, radar-error and decoy semantics of the scalar interface
+	for (int i = 0; i < numUnits; i++) {
+		const int unitId = ids[i];
+
+		if (unitIds != nullptr)
+			unitIds[i] = unitId;
+		if (pos_posF3s != nullptr)
+			skirmishAiCallback_Unit_getPos(skirmishAIId, unitId, &pos_posF3s[i * 3]);
+		if (vel_posF3s != nullptr)
+			skirmishAiCallback_Unit_getVel(skirmishAIId, unitId, &vel_posF3s[i * 3]);
+		if (healths != nullptr)
+			healths[i] = skirmishAiCallback_Unit_getHealth(skirmishAIId, unitId);
+		if (teamIds != nullptr)
+			teamIds[i] = skirmishAiCallback_Unit_getTeam(skirmishAIId, unitId);
+	}
+
+	return numUnits;
+}
+
 EXPORT(int) skirmishAiCallback_getTeamUnits(int skirmishAIId, int* unitIds, int unitIdsMaxSize) {
 	int a = 0;
 
@@ -5334,6 +5385,7 @@ static void skirmishAiCallback_init(SSkirmishAICallback* callback) {
 	callback->getNeutralUnitsIn = &skirmishAiCallback_getNeutralUnitsIn;
 	callback->getTeamUnits = &skirmishAiCallback_getTeamUnits;
 	callback->getSelectedUnits = &skirmishAiCallback_getSelectedUnits;
+	callback->getUnitsSnapshot = &skirmishAiCallback_getUnitsSnapshot;
 	callback->Unit_getDef = &skirmishAiCallback_Unit_getDef;
 	callback->Unit_getRulesParamFloat = &skirmishAiCallback_Unit_getRulesParamFloat;
 	callback->Unit_getRulesParamString = &skirmishAiCallback_Unit_getRulesParamString;
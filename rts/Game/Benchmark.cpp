@@ -0,0 +1,62 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include <algorithm>
+#include <cstdio>
+
+#include "Benchmark.h"
+#include "Game/GameSetup.h"
+#include "System/TimeProfiler.h"
+#include "System/Platform/Misc.h"
+
+bool CBenchmark::enabled = false;
+bool CBenchmark::timing = false;
+
+int CBenchmark::startFrame = 0;
+spring_time CBenchmark::startTime = spring_notime;
+
+
+void CBenchmark::GameFrame(int frameNum)
+{
+	if (timing)
+		return;
+
+	timing = true;
+	startFrame = frameNum;
+	startTime = spring_gettime();
+
+	// per-timer totals only accumulate while the profiler is enabled
+	profiler.SetEnabled(true);
+}
+
+void CBenchmark::GameEnded(int frameNum)
+{
+	if (!timing)
+		return;
+
+	timing = false;
+
+	const int simFrames = frameNum - startFrame;
+	const double wallSecs = (spring_gettime() - startTime).toMilliSecsf() * 0.001;
+
+	// pick up the final profile records
+	profiler.Update();
+
+	// raw stdout on purpose; infolog lines carry frame-prefixes and
+	// sink decorations, the report has to stay machine-readable
+	printf("{\"benchmark\":{");
+	printf("\"demo\":\"%s\",", gameSetup->demoName.c_str());
+	printf("\"sim_frames\":%d,", simFrames);
+	printf("\"wall_secs\":%.3f,", wallSecs);
+	printf("\"sim_fps\":%.2f,", simFrames / std::max(wallSecs, 1e-6));
+	printf("\"peak_rss_mb\":%.1f,", Platform::GetPeakRSSMegs());
+	printf("\"profile\":[");
+
+	const auto& sortedProfiles = profiler.GetSortedProfiles();
+
+	for (size_t n = 0; n < sortedProfiles.size(); n++) {
+		printf("%s{\"name\":\"%s\",\"total_ms\":%.3f}", (n > 0)? ",": "", sortedProfiles[n].first.c_str(), sortedProfiles[n].second.total.toMilliSecsf());
+	}
+
+	printf("]}}\n");
+	fflush(stdout);
+}
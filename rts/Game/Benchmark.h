@@ -0,0 +1,31 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef _BENCHMARK_H
+#define _BENCHMARK_H
+
+#include "System/Misc/SpringTime.h"
+
+/**
+ * @brief demo-replay benchmark mode (--benchmark)
+ *
+ * Times the simulation while a demo is skipped through at maximum
+ * speed, then prints a machine-readable report (sim-frames/second,
+ * per-timer profile totals, peak RSS) once the recorded data runs
+ * out so engine builds can be compared on reference games.
+ */
+class CBenchmark
+{
+public:
+	static void GameFrame(int frameNum);
+	static void GameEnded(int frameNum);
+
+	static bool enabled;
+
+private:
+	static bool timing;
+
+	static int startFrame;
+	static spring_time startTime;
+};
+
+#endif // _BENCHMARK_H
@@ -2,6 +2,10 @@
 
 #include <cstring>
 
+#ifndef DEDICATED_NOSSE
+#include <xmmintrin.h>
+#endif
+
 #include "Camera.h"
 #include "CameraHandler.h"
 #include "UI/MouseHandler.h"
@@ -744,6 +748,72 @@ bool CCamera::Frustum::IntersectSphere(const float3& cp, const float4& sp) const
 	return !(vec.dot(planes[FRUSTUM_PLANE_BCK]) > (zwPlaneOffsets[1] + sp.w));
 }
 
+void CCamera::Frustum::IntersectSpheres(const float3& cp, int numSpheres, const float4* spheres, uint8_t* flags) const
+{
+	static_assert(FRUSTUM_PLANE_LFT == 0, "");
+	static_assert(FRUSTUM_PLANE_FRN == 4, "");
+
+	int i = 0;
+
+	#ifndef DEDICATED_NOSSE
+	// side-plane (LRTB) offsets followed by the far-plane offset; the
+	// near-plane is skipped as in IntersectSphere
+	const float3* testPlanes[5] = {&planes[0], &planes[1], &planes[2], &planes[3], &planes[FRUSTUM_PLANE_BCK]};
+	const float planeOffsets[5] = {scales.x, scales.x, scales.y, scales.y, scales.w};
+
+	__m128 plxs[5];
+	__m128 plys[5];
+	__m128 plzs[5];
+	__m128 offs[5];
+
+	for (int p = 0; p < 5; p++) {
+		plxs[p] = _mm_set1_ps(testPlanes[p]->x);
+		plys[p] = _mm_set1_ps(testPlanes[p]->y);
+		plzs[p] = _mm_set1_ps(testPlanes[p]->z);
+		offs[p] = _mm_set1_ps(planeOffsets[p]);
+	}
+
+	const __m128 cpxs = _mm_set1_ps(cp.x);
+	const __m128 cpys = _mm_set1_ps(cp.y);
+	const __m128 cpzs = _mm_set1_ps(cp.z);
+
+	for (; (i + 4) <= numSpheres; i += 4) {
+		// gather four {center, radius} spheres and transpose to SoA
+		__m128 xs = _mm_loadu_ps(&spheres[i + 0].x);
+		__m128 ys = _mm_loadu_ps(&spheres[i + 1].x);
+		__m128 zs = _mm_loadu_ps(&spheres[i + 2].x);
+		__m128 rs = _mm_loadu_ps(&spheres[i + 3].x);
+
+		_MM_TRANSPOSE4_PS(xs, ys, zs, rs);
+
+		xs = _mm_sub_ps(xs, cpxs);
+		ys = _mm_sub_ps(ys, cpys);
+		zs = _mm_sub_ps(zs, cpzs);
+
+		// all-ones mask; a sphere stays inside while it is not in
+		// front of any tested plane
+		__m128 inside = _mm_cmpeq_ps(xs, xs);
+
+		for (int p = 0; p < 5; p++) {
+			const __m128 dots = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xs, plxs[p]), _mm_mul_ps(ys, plys[p])), _mm_mul_ps(zs, plzs[p]));
+
+			inside = _mm_and_ps(inside, _mm_cmple_ps(dots, _mm_add_ps(offs[p], rs)));
+		}
+
+		const int mask = _mm_movemask_ps(inside);
+
+		flags[i + 0] = (mask >> 0) & 1;
+		flags[i + 1] = (mask >> 1) & 1;
+		flags[i + 2] = (mask >> 2) & 1;
+		flags[i + 3] = (mask >> 3) & 1;
+	}
+	#endif
+
+	for (; i < numSpheres; i++) {
+		flags[i] = IntersectSphere(cp, spheres[i]);
+	}
+}
+
 bool CCamera::Frustum::IntersectAABB(const AABB& b) const
 {
 	// edge axes and normals are identical for AABBs
@@ -3,6 +3,8 @@
 #ifndef _CAMERA_H
 #define _CAMERA_H
 
+#include <cstdint>
+
 #include "System/AABB.hpp"
 #include "System/float3.h"
 #include "System/Matrix44f.h"
@@ -54,6 +56,9 @@ public:
 	struct Frustum {
 	public:
 		bool IntersectSphere(const float3& cp, const float4& sp) const;
+		/// batched IntersectSphere; spheres are {center, radius}, flags
+		/// receive one (boolean) result each
+		void IntersectSpheres(const float3& cp, int numSpheres, const float4* spheres, uint8_t* flags) const;
 		bool IntersectAABB(const AABB& b) const;
 
 	public:
@@ -117,6 +122,9 @@ public:
 	float3 CalcWindowCoordinates(const float3& objPos) const;
 
 	bool InView(const float3& point, float radius = 0.0f) const { return (frustum.IntersectSphere(pos, {point, radius})); }
+	/// batched InView(point, radius) for flat object arrays; cheaper
+	/// than per-object calls since four spheres are tested at a time
+	void InView(int numSpheres, const float4* spheres, uint8_t* flags) const { frustum.IntersectSpheres(pos, numSpheres, spheres, flags); }
 	bool InView(const float3& mins, const float3& maxs) const { return (InView(AABB{mins, maxs})); }
 	bool InView(const AABB& aabb) const { return (InView(aabb.CalcCenter(), aabb.CalcRadius()) && frustum.IntersectAABB(aabb)); }
 
@@ -298,7 +298,8 @@ void CCameraHandler::UpdateTransition()
 		return;
 
 	const float timeRatio = (camTransState.timeEnd - transTime) / (camTransState.timeEnd - camTransState.timeStart);
-	const float tweenFact = 1.0f - math::pow(timeRatio, camTransState.timeExponent);
+	// unsynced, no need to ride streflop here
+	const float tweenFact = 1.0f - std::pow(timeRatio, camTransState.timeExponent);
 
 	camera->SetPos(mix(camTransState.startPos, camTransState.tweenPos, tweenFact));
 	camera->SetRot(mix(camTransState.startRot, camTransState.tweenRot, tweenFact));
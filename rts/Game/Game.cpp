@@ -3,6 +3,7 @@
 #include "Rendering/GL/myGL.h"
 
 #include "Game.h"
+#include "Benchmark.h"
 #include "Camera.h"
 #include "CameraHandler.h"
 #include "ChatMessage.h"
@@ -27,6 +28,7 @@
 #include "Game/UI/PlayerRoster.h"
 #include "Game/UI/PlayerRosterDrawer.h"
 #include "Game/UI/UnitTracker.h"
+#include "Game/UnitAttributeTracker.h"
 #include "ExternalAI/AILibraryManager.h"
 #include "ExternalAI/EngineOutHandler.h"
 #include "ExternalAI/SkirmishAIHandler.h"
@@ -78,6 +80,7 @@
 #include "Sim/Misc/Wind.h"
 #include "Sim/Misc/ResourceHandler.h"
 #include "Sim/MoveTypes/MoveDefHandler.h"
+#include "Sim/MoveTypes/MoveMath/MoveMath.h"
 #include "Sim/MoveTypes/MoveTypeFactory.h"
 #include "Sim/Path/IPathManager.h"
 #include "Sim/Projectiles/ExplosionGenerator.h"
@@ -106,10 +109,13 @@
 #include "System/Config/ConfigHandler.h"
 #include "System/EventHandler.h"
 #include "System/Exceptions.h"
+#include "System/FrameArena.h"
 #include "System/Sync/FPUCheck.h"
+#include "System/Sync/SHA512.hpp"
 #include "System/SafeUtil.h"
 #include "System/SpringExitCode.h"
 #include "System/SpringMath.h"
+#include "System/FileSystem/ArchiveScanner.h"
 #include "System/FileSystem/FileSystem.h"
 #include "System/LoadSave/LoadSaveHandler.h"
 #include "System/LoadSave/DemoRecorder.h"
@@ -119,12 +125,17 @@
 #include "System/Sound/ISound.h"
 #include "System/Sound/ISoundChannels.h"
 #include "System/Sync/DumpState.h"
+#include "System/Threading/ThreadPool.h"
 #include "System/TimeProfiler.h"
 
+#include <fstream>
+#include <future>
+
 
 #undef CreateDirectory
 
 CONFIG(bool, GameEndOnConnectionLoss).defaultValue(true);
+CONFIG(bool, CachedDefs).defaultValue(true).description("Snapshot the fully-parsed unit/feature/weapon definition tables to disk, reused while the game, map, and their options stay unchanged.");
 // CONFIG(bool, LuaCollectGarbageOnSimFrame).defaultValue(true);
 
 CONFIG(bool, WindowedEdgeMove).defaultValue(true).description("Sets whether moving the mouse cursor to the screen edge will move the camera across the map.");
@@ -363,8 +374,33 @@ void CGame::Load(const std::string& mapFileName)
 	try {
 		LOG("[Game::%s][1] globalQuit=%d threaded=%d", __func__, globalQuit.load(), !Threading::IsMainThread());
 
+		// defs parsing is pure Lua and VFS work and independent of map
+		// init, which keeps all GL access on this (the context-owning)
+		// thread, so the two longest pre-sim stages can overlap; radar
+		// icons and sound defs follow sequentially since the former
+		// create textures
+		std::exception_ptr defsError;
+		std::promise<void> defsDone;
+
+		// NB: the non-THREADPOOL Enqueue executes inline, making the
+		// wait below a no-op and the whole stage sequential as before
+		ThreadPool::Enqueue([this, defsParser, &defsError, &defsDone]() {
+			try {
+				LoadDefs(defsParser);
+			} catch (...) {
+				defsError = std::current_exception();
+			}
+
+			defsDone.set_value();
+		});
+
 		LoadMap(mapFileName);
-		LoadDefs(defsParser);
+		defsDone.get_future().wait();
+
+		if (defsError != nullptr)
+			std::rethrow_exception(defsError);
+
+		PostLoadDefs();
 	} catch (const content_error& e) {
 		LOG_L(L_WARNING, "[Game::%s][1] forced quit with exception \"%s\"", __func__, e.what());
 
@@ -476,10 +512,102 @@ void CGame::LoadMap(const std::string& mapFileName)
 }
 
 
-void CGame::LoadDefs(LuaParser* defsParser)
+static std::string GetCachedDefsFile()
 {
-	ENTER_SYNCED_CODE();
+	return (FileSystem::EnsurePathSepAtEnd(FileSystem::GetCacheDir()) + "CachedDefs.bin");
+}
+
+static void CalcCachedDefsKey(sha512::raw_digest& key)
+{
+	std::string keyData;
+
+	// any change to the game, the map, their options, or the engine
+	// itself invalidates a cached snapshot of the definition tables
+	const sha512::raw_digest& modChecksum = archiveScanner->GetArchiveCompleteChecksumBytes(gameSetup->modName);
+	const sha512::raw_digest& mapChecksum = archiveScanner->GetArchiveCompleteChecksumBytes(gameSetup->mapName);
+
+	keyData.append(reinterpret_cast<const char*>(modChecksum.data()), modChecksum.size());
+	keyData.append(reinterpret_cast<const char*>(mapChecksum.data()), mapChecksum.size());
+
+	const auto appendOpts = [&keyData](const spring::unordered_map<std::string, std::string>& opts) {
+		std::vector<std::pair<std::string, std::string>> sortedOpts{opts.begin(), opts.end()};
+		std::sort(sortedOpts.begin(), sortedOpts.end());
+
+		for (const auto& opt: sortedOpts) {
+			keyData.append(opt.first).append(1, '=').append(opt.second).append(1, ';');
+		}
+	};
+
+	appendOpts(gameSetup->GetModOptionsCont());
+	appendOpts(gameSetup->GetMapOptionsCont());
+
+	keyData.append(SpringVersion::GetSync());
+
+	sha512::calc_digest(reinterpret_cast<const uint8_t*>(keyData.data()), keyData.size(), key.data());
+}
+
+static bool LoadCachedDefs(LuaParser* defsParser)
+{
+	const std::string& cacheFile = GetCachedDefsFile();
+
+	std::ifstream ifs(cacheFile.c_str(), std::ios::in | std::ios::binary);
+
+	if (!ifs.is_open())
+		return false;
+
+	sha512::raw_digest curKey;
+	sha512::raw_digest oldKey;
+
+	CalcCachedDefsKey(curKey);
+
+	if (!ifs.read(reinterpret_cast<char*>(oldKey.data()), oldKey.size()) || oldKey != curKey)
+		return false;
+
+	const std::string dump{std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
+
+	if (!defsParser->LoadDump(dump)) {
+		LOG_L(L_WARNING, "[Game::LoadDefs] discarding unreadable defs-cache \"%s\"", cacheFile.c_str());
+		return false;
+	}
+
+	LOG("[Game::LoadDefs] loaded definitions from cache \"%s\"", cacheFile.c_str());
+	return true;
+}
+
+static void SaveCachedDefs(LuaParser* defsParser)
+{
+	std::string dump;
+
+	// defs containing functions etc. can not be snapshotted
+	if (!defsParser->DumpRoot(dump))
+		return;
+
+	sha512::raw_digest key;
+	CalcCachedDefsKey(key);
+
+	const std::string& cacheFile = GetCachedDefsFile();
+
+	std::ofstream ofs(cacheFile.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+
+	if (!ofs.is_open()) {
+		LOG_L(L_ERROR, "[Game::LoadDefs] failed to write defs-cache \"%s\"", cacheFile.c_str());
+		return;
+	}
 
+	ofs.write(reinterpret_cast<const char*>(key.data()), key.size());
+	ofs.write(dump.data(), dump.size());
+
+	LOG("[Game::LoadDefs] wrote defs-cache \"%s\" (" _STPF_ " bytes)", cacheFile.c_str(), dump.size());
+}
+
+
+void CGame::LoadDefs(LuaParser* defsParser)
+{
+	// NOTE:
+	//   runs on a pool worker overlapped with LoadMap, so it must not
+	//   touch GL state and can not bracket itself with {ENTER,LEAVE}_
+	//   SYNCED_CODE (the counter is not thread-safe and no synced vars
+	//   are assigned here anyway)
 	{
 		ScopedOnceTimer timer("Game::LoadDefs (GameData)");
 		loadscreen->SetLoadMessage("Loading GameData Definitions");
@@ -491,8 +619,11 @@ void CGame::LoadDefs(LuaParser* defsParser)
 		defsParser->AddFunc("GetMapOptions", LuaSyncedRead::GetMapOptions);
 		defsParser->EndTable();
 
-		// run the parser
-		if (!defsParser->Execute())
+		const bool useCachedDefs = configHandler->GetBool("CachedDefs");
+		const bool haveCachedDefs = useCachedDefs && LoadCachedDefs(defsParser);
+
+		// run the parser, unless a snapshot of its output is available
+		if (!haveCachedDefs && !defsParser->Execute())
 			throw content_error("Defs-Parser: " + defsParser->GetErrorLog());
 
 		const LuaTable& root = defsParser->GetRoot();
@@ -517,8 +648,13 @@ void CGame::LoadDefs(LuaParser* defsParser)
 		if (!root.SubTable("MoveDefs").IsValid())
 			throw content_error("Error loading MoveDefs");
 
+		if (useCachedDefs && !haveCachedDefs)
+			SaveCachedDefs(defsParser);
 	}
+}
 
+void CGame::PostLoadDefs()
+{
 	{
 		loadscreen->SetLoadMessage("Loading Radar Icons");
 		icon::iconHandler.Init();
@@ -536,8 +672,6 @@ void CGame::LoadDefs(LuaParser* defsParser)
 		sound->LoadSoundDefs(&soundDefsParser);
 		chatSound = sound->GetDefSoundId("IncomingChat");
 	}
-
-	LEAVE_SYNCED_CODE();
 }
 
 
@@ -612,6 +746,23 @@ void CGame::PostLoadSimulation(LuaParser* defsParser)
 	// load map-specific features
 	loadscreen->SetLoadMessage("Initializing Map Features");
 	featureDefHandler->LoadFeatureDefsFromMap();
+
+	{
+		ScopedOnceTimer timer("Game::PostLoadSim (PreloadModels)");
+		loadscreen->SetLoadMessage("Preloading Models");
+
+		// warm the model cache on the pool; workers parse concurrently
+		// with the remaining load stages and repeated requests for one
+		// model are deduplicated by CModelLoader
+		for (const UnitDef& ud: unitDefHandler->GetUnitDefsVec()) {
+			ud.PreloadModel();
+		}
+		for (const FeatureDef& fd: featureDefHandler->GetFeatureDefsVec()) {
+			fd.PreloadModel();
+		}
+	}
+
+
 	if (saveFileHandler == nullptr)
 		featureHandler.LoadFeaturesFromMap();
 
@@ -908,6 +1059,7 @@ void CGame::KillSimulation()
 	}
 
 	LOG("[Game::%s][2]", __func__);
+	unitAttrTracker.Clear();
 	unitHandler.DeleteScripts();
 
 	featureHandler.Kill(); // depends on unitHandler (via ~CFeature)
@@ -926,6 +1078,7 @@ void CGame::KillSimulation()
 
 	CLosHandler::KillStatic(gu->globalReload);
 	quadField.Kill();
+	CMoveMath::KillSpeedModCaches();
 	moveDefHandler.Kill();
 	unitDefHandler->Kill();
 	featureDefHandler->Kill();
@@ -1069,6 +1222,13 @@ bool CGame::Update()
 	jobDispatcher.Update();
 	clientNet->Update();
 
+	// the recorded data has run out; report and quit before the local
+	// server keeps simulating past the end of the demo
+	if (CBenchmark::enabled && playing && gameSetup->hostDemo && gameServer != nullptr && gameServer->GetDemoReader() == nullptr) {
+		CBenchmark::GameEnded(gs->frameNum);
+		gu->globalQuit = true;
+	}
+
 	// When video recording do step by step simulation, so each simframe gets a corresponding videoframe
 	// FIXME: SERVER ALREADY DOES THIS BY ITSELF
 	if (playing && gameServer != nullptr && videoCapturing->AllowRecord())
@@ -1109,6 +1269,44 @@ bool CGame::Update()
 }
 
 
+static std::string BuildClientTelemetry()
+{
+	char buf[512];
+
+	SNPRINTF(buf, sizeof(buf),
+			"\"game_frame\":%d,\"sim_fps\":%.1f,\"draw_fps\":%.1f,\"units\":%u,\"projectiles\":%u,\"particles\":%d,\"peak_rss_mb\":%.1f,\"profile\":{",
+			gs->frameNum,
+			gu->simFPS,
+			globalRendering->FPS,
+			unsigned(unitHandler.GetActiveUnits().size()),
+			unsigned(projectileHandler.projectileContainers[true].size() + projectileHandler.projectileContainers[false].size()),
+			projectileHandler.GetCurrentParticles(),
+			Platform::GetPeakRSSMegs());
+
+	std::string json(buf);
+
+	// per-timer load percentages, refreshed at 1Hz by the Profiler::Update job
+	const auto& sortedProfiles = profiler.GetSortedProfiles();
+
+	for (size_t n = 0, e = 0; n < sortedProfiles.size(); n++) {
+		const CTimeProfiler::TimeRecord& tr = sortedProfiles[n].second;
+
+		// skip timers that do not even register
+		if (tr.stats.y < 0.005f)
+			continue;
+
+		if (e++ > 0)
+			json += ",";
+
+		SNPRINTF(buf, sizeof(buf), "\"%s\":%.3f", sortedProfiles[n].first.c_str(), tr.stats.y);
+		json += buf;
+	}
+
+	json += "}";
+	return json;
+}
+
+
 bool CGame::UpdateUnsynced(const spring_time currentTime)
 {
 	SCOPED_TIMER("Update");
@@ -1149,6 +1347,19 @@ bool CGame::UpdateUnsynced(const spring_time currentTime)
 		}
 	}
 
+	{
+		// hand engine-side performance stats to the (local) server at the
+		// telemetry interval; it merges and relays them to the autohost
+		// as SERVER_TELEMETRY events
+		static const int telemetryInterval = configHandler->GetInt("ServerTelemetryInterval");
+		static spring_time lastTelemetryTime = currentTime;
+
+		if (gameServer != nullptr && telemetryInterval > 0 && (currentTime - lastTelemetryTime).toSecsf() >= telemetryInterval) {
+			lastTelemetryTime = currentTime;
+			gameServer->SetClientTelemetry(BuildClientTelemetry());
+		}
+	}
+
 	if (skipping) {
 		// when fast-forwarding, maintain a draw-rate of 2Hz
 		if (spring_tomsecs(currentTime - skipLastDrawTime) < 500.0f)
@@ -1235,6 +1446,7 @@ bool CGame::UpdateUnsynced(const spring_time currentTime)
 
 	mouse->Update();
 	mouse->UpdateCursors();
+	inMapDrawer->FlushStrokes();
 	guihandler->Update();
 	commandDrawer->Update();
 
@@ -1466,6 +1678,13 @@ void CGame::StartPlaying()
 
 	if (saveFileHandler == nullptr)
 		eventHandler.GameStart();
+
+	if (CBenchmark::enabled) {
+		// replay the entire demo at maximum speed through the regular
+		// skip machinery; the server stops at the end of the recording
+		CommandMessage pckt(Action("skip f2000000000"), gu->myPlayerNum);
+		clientNet->Send(pckt.Pack());
+	}
 }
 
 
@@ -1480,6 +1699,9 @@ void CGame::SimFrame() {
 	gs->frameNum += 1;
 	lastFrameTime = spring_gettime();
 
+	if (CBenchmark::enabled)
+		CBenchmark::GameFrame(gs->frameNum);
+
 	// clear allocator statistics periodically
 	// note: allocator itself should do this (so that
 	// stats are reliable when paused) but see LuaUser
@@ -1501,6 +1723,7 @@ void CGame::SimFrame() {
 		c.SendStateUpdate(/*camera->GetMovState(), mouse->buttons*/);
 
 		CTeamHighlight::Update(gs->frameNum);
+		ILoadSaveHandler::ScheduleAutoSave(gs->frameNum);
 	}
 
 	// everything from here is simulation
@@ -1538,6 +1761,12 @@ void CGame::SimFrame() {
 
 		teamHandler.GameFrame(gs->frameNum);
 		playerHandler.GameFrame(gs->frameNum);
+
+		// deliver attribute changes after all sim mutations of this frame
+		unitAttrTracker.Update();
+
+		// last so units spawned anywhere this frame are included
+		unitDrawer->PublishSimFrameSnapshot();
 	}
 
 	lastSimFrameTime = spring_gettime();
@@ -1562,6 +1791,9 @@ void CGame::SimFrame() {
 	// useful for desync-debugging (enter instead of -1 start & end frame of the range you want to debug)
 	DumpState(-1, -1, 1);
 
+	// all sim-frame scratch allocations die here
+	simFrameArena.Reset();
+
 	ASSERT_SYNCED(gsRNG.GetGenState());
 	LEAVE_SYNCED_CODE();
 }
@@ -50,6 +50,7 @@ private:
 
 	void LoadMap(const std::string& mapName);
 	void LoadDefs(LuaParser* defsParser);
+	void PostLoadDefs();
 	void PreLoadSimulation(LuaParser* defsParser);
 	void PostLoadSimulation(LuaParser* defsParser);
 	void PreLoadRendering();
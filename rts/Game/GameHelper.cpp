@@ -36,6 +36,7 @@
 #include "Sim/Weapons/WeaponDefHandler.h"
 #include "Sim/Weapons/Weapon.h"
 #include "System/EventHandler.h"
+#include "System/FrameArena.h"
 #include "System/SpringMath.h"
 #include "System/Sound/ISoundChannels.h"
 
@@ -50,6 +51,9 @@ void CGameHelper::Init()
 		wdVec.clear();
 		wdVec.reserve(32);
 	}
+
+	visibleEnemies.clear();
+	visibleEnemies.resize(teamHandler.ActiveAllyTeams());
 }
 
 void CGameHelper::Update()
@@ -73,6 +77,8 @@ void CGameHelper::Update()
 	}
 
 	waitingDamages[wdIdx].clear();
+
+	FlushBuggerOffRequests();
 }
 
 
@@ -201,6 +207,15 @@ void CGameHelper::DamageObjectsInExplosionRadius(
 	static std::vector<CUnit*> unitCache;
 	static std::vector<CFeature*> featureCache;
 
+	// per-victim distances, falloff factors and impulses; kept in
+	// lockstep with the object caches (negative distance means the
+	// victim is skipped by the application pass); these live on the
+	// frame arena so each (recursive) invocation gets fresh vectors
+	// and needs no end-marker bookkeeping of its own
+	FrameVector<float> objectDists;
+	FrameVector<float> objectMods;
+	FrameVector<float3> objectImpulses;
+
 	const unsigned int oldNumUnits = unitCache.size();
 	const unsigned int oldNumFeatures = featureCache.size();
 
@@ -209,20 +224,112 @@ void CGameHelper::DamageObjectsInExplosionRadius(
 	const unsigned int newNumUnits = unitCache.size();
 	const unsigned int newNumFeatures = featureCache.size();
 
-	// damage all units within the explosion radius
+	const unsigned int numObjects = (newNumUnits - oldNumUnits) + (newNumFeatures - oldNumFeatures);
+
+	objectDists.resize(numObjects, -1.0f);
+	objectMods.resize(numObjects, 0.0f);
+	objectImpulses.resize(numObjects, ZeroVector);
+
+	// first batch all (expensive, but side-effect free) collision-volume
+	// distance queries, then apply the damage; recursively triggered
+	// explosions during the DoDamage cascade below can not interleave
+	// with them that way
 	// NOTE:
-	//   this can recursively trigger ::Explosion() again
-	//   which would overwrite our object cache if we did
-	//   not keep track of end-markers --> certain objects
-	//   would not be damaged AT ALL (!)
-	for (unsigned int n = oldNumUnits; n < newNumUnits; n++)
-		DoExplosionDamage(unitCache[n], params.owner, params.pos, expRad, params.explosionSpeed, params.edgeEffectiveness, params.ignoreOwner, params.damages, weaponDefID, params.projectileID);
+	//   the recursion can also overwrite our object caches, so
+	//   we need to keep track of end-markers --> certain objects
+	//   would not be damaged AT ALL otherwise (!)
+	const auto BatchObject = [&](const auto* obj, const LocalModelPiece* lhp, const LocalModelPiece* distLhp, unsigned int objIdx) {
+		const CollisionVolume* vol = obj->GetCollisionVolume(lhp);
+
+		const float3& lhpPos = (lhp != nullptr && vol == lhp->GetCollisionVolume())? lhp->GetAbsolutePos(): ZeroVector;
+		const float3& volPos = vol->GetWorldSpacePos(obj, lhpPos);
+
+		// linear damage falloff with distance
+		const float expDist = (expRad != 0.0f) ? vol->GetPointSurfaceDistance(obj, distLhp, params.pos) : 0.0f;
+		const float expRim = expDist * params.edgeEffectiveness;
+
+		if (expDist > expRad)
+			return;
+
+		// edgeEffectiveness should be in [0, 1], so expRad >= expDist >= expDist*edgeEffectiveness
+		assert(expRad >= expRim);
+
+		// expMod will also be in [0, 1], no negatives
+		// TODO: damage attenuation for underwater units from surface explosions?
+		const float expDistanceMod = (expRad + 0.001f - expDist) / (expRad + 0.001f - expRim);
+		const float modImpulseScale = CalcImpulseScale(params.damages, expDistanceMod);
+
+		objectDists[objIdx] = expDist;
+		objectMods[objIdx] = expDistanceMod;
+		objectImpulses[objIdx] = (volPos - params.pos).SafeNormalize() * modImpulseScale;
+	};
+
+	for (unsigned int n = oldNumUnits; n < newNumUnits; n++) {
+		const CUnit* unit = unitCache[n];
+
+		if (params.ignoreOwner && (unit == params.owner))
+			continue;
+
+		const LocalModelPiece* lhp = unit->GetLastHitPiece(gs->frameNum);
+
+		BatchObject(unit, lhp, lhp, n - oldNumUnits);
+	}
+
+	for (unsigned int n = oldNumFeatures; n < newNumFeatures; n++) {
+		const CFeature* feature = featureCache[n];
+
+		BatchObject(feature, feature->GetLastHitPiece(gs->frameNum), nullptr, (newNumUnits - oldNumUnits) + (n - oldNumFeatures));
+	}
+
+	// reused across victims; repeated assignment retains the capacity
+	// of the per-type vector, unlike a DamageArray::operator* copy per
+	// victim (stack-local so the recursion can not clobber it while a
+	// DoDamage callee still reads it)
+	DamageArray expDamages = params.damages;
+
+	// damage all units within the explosion radius
+	for (unsigned int n = oldNumUnits; n < newNumUnits; n++) {
+		const unsigned int objIdx = n - oldNumUnits;
+		const float expDist = objectDists[objIdx];
+
+		if (expDist < 0.0f)
+			continue;
+
+		CUnit* unit = unitCache[n];
+
+		expDamages = params.damages;
+		expDamages *= objectMods[objIdx];
+
+		// NOTE: if an explosion occurs right underneath a
+		// unit's map footprint, it might cause damage even
+		// if the unit's collision volume is greatly offset
+		// (because CQuadField coverage is based exclusively
+		// on unit->radius, so the DoDamage() iteration will
+		// include units that should not be touched)
+
+		if (expDist < (params.explosionSpeed * DIRECT_EXPLOSION_DAMAGE_SPEED_SCALE)) {
+			// damage directly
+			unit->DoDamage(expDamages, objectImpulses[objIdx], params.owner, weaponDefID, params.projectileID);
+		} else {
+			// damage later
+			waitingDamages[(gs->frameNum + int(expDist / params.explosionSpeed) - (DIRECT_EXPLOSION_DAMAGE_SPEED_SCALE - 1)) & (waitingDamages.size() - 1)].emplace_back(expDamages, objectImpulses[objIdx], ((params.owner != nullptr)? params.owner->id: -1), unit->id, weaponDefID, params.projectileID);
+		}
+	}
 
 	unitCache.resize(oldNumUnits);
 
 	// damage all features within the explosion radius
-	for (unsigned int n = oldNumFeatures; n < newNumFeatures; n++)
-		DoExplosionDamage(featureCache[n], params.owner, params.pos, expRad, params.edgeEffectiveness, params.damages, weaponDefID, params.projectileID);
+	for (unsigned int n = oldNumFeatures; n < newNumFeatures; n++) {
+		const unsigned int objIdx = (newNumUnits - oldNumUnits) + (n - oldNumFeatures);
+
+		if (objectDists[objIdx] < 0.0f)
+			continue;
+
+		expDamages = params.damages;
+		expDamages *= objectMods[objIdx];
+
+		featureCache[n]->DoDamage(expDamages, objectImpulses[objIdx], params.owner, weaponDefID, params.projectileID);
+	}
 
 	featureCache.resize(oldNumFeatures);
 }
@@ -670,6 +777,21 @@ size_t CGameHelper::GenerateWeaponTargets(const CWeapon* weapon, const CUnit* av
 
 	const int tempNum = gs->GetTempNum();
 
+	// filtered candidates with their per-unit scoring inputs, gathered
+	// into a flat array so the (cheap, branchy) rejection tests do not
+	// interleave with the arithmetic and the Lua / synced-RNG calls
+	struct TargetCandidate {
+		CUnit* unit;
+		float priority; // includes the avoidee / radar-only multipliers
+		float dist2D;
+		float modRange;
+		unsigned short losState;
+	};
+
+	FrameVector<TargetCandidate> candidates;
+
+	candidates.reserve(32);
+
 	for (int t = 0; t < teamHandler.ActiveAllyTeams(); ++t) {
 		if (teamHandler.Ally(weaponOwner->allyteam, t))
 			continue;
@@ -683,9 +805,6 @@ size_t CGameHelper::GenerateWeaponTargets(const CWeapon* weapon, const CUnit* av
 
 				targetUnit->tempNum = tempNum;
 
-				if (!weapon->TestTarget(testPos, SWeaponTarget(targetUnit)))
-					continue;
-
 				const unsigned short targetLOSState = targetUnit->losStatus[weaponOwner->allyteam];
 
 				float targetPriority = tgtPriorityMults[(targetUnit == avoidUnit) * 1];
@@ -703,47 +822,67 @@ size_t CGameHelper::GenerateWeaponTargets(const CWeapon* weapon, const CUnit* av
 				const float modRange = weapon->GetRange2D(rangeBoost, (targetPos.y - aimPosHeight) * heightMod);
 				const float sqDist2D = ownerPos.SqDistance2D(targetPos);
 
+				// reject on range before invoking the (virtual, and far
+				// costlier) category / neutrality / water tests; neither
+				// has side-effects so the surviving set is unchanged
 				if (sqDist2D > Square(modRange))
 					continue;
 
-				const float dist2D = math::sqrt(sqDist2D);
-				const float rangeMul = (dist2D * weaponDef->proximityPriority + modRange * 0.4f + 100.0f);
-				const float damageMul = weaponDmg->Get(targetUnit->armorType) * targetUnit->curArmorMultiple;
+				// category compatibility is fully determined at load (unit
+				// categories and targeting masks both come straight from the
+				// defs), so one mask probe settles it without the virtual call
+				if ((targetUnit->category & weapon->onlyTargetCategory) == 0)
+					continue;
+
+				if (!weapon->TestTarget(testPos, SWeaponTarget(targetUnit)))
+					continue;
 
-				targetPriority *= rangeMul;
-				targetPriority *= tgtPriorityMults[(dist2D > baseRange) * 6];
+				candidates.push_back({targetUnit, targetPriority, math::sqrt(sqDist2D), modRange, targetLOSState});
+			}
+		}
+	}
 
-				if (targetLOSState & LOS_INLOS) {
-					targetPriority *= (secDamage + targetUnit->health);
+	// score the gathered candidates; they are in quad-traversal order,
+	// so the RNG draws and events below happen exactly as they used to
+	for (const TargetCandidate& tc: candidates) {
+		CUnit* targetUnit = tc.unit;
 
-					if (paralyzer && targetUnit->paralyzeDamage > (modInfo.paralyzeOnMaxHealth? targetUnit->maxHealth: targetUnit->health))
-						targetPriority *= tgtPriorityMults[5];
+		const unsigned short targetLOSState = tc.losState;
 
-					if (weapon->hasTargetWeight)
-						targetPriority *= weapon->TargetWeight(targetUnit);
+		const float dist2D = tc.dist2D;
+		const float rangeMul = (dist2D * weaponDef->proximityPriority + tc.modRange * 0.4f + 100.0f);
+		const float damageMul = weaponDmg->Get(targetUnit->armorType) * targetUnit->curArmorMultiple;
 
-				} else {
-					targetPriority *= (secDamage + 10000.0f);
-				}
+		float targetPriority = tc.priority;
+		targetPriority *= rangeMul;
+		targetPriority *= tgtPriorityMults[(dist2D > baseRange) * 6];
 
-				if (targetLOSState & LOS_PREVLOS) {
-					targetPriority /= (damageMul * targetUnit->power * (0.7f + gsRNG.NextFloat() * 0.6f));
-					targetPriority *= tgtPriorityMults[((targetUnit->category & weapon->badTargetCategory) != 0) * 2];
-					targetPriority *= tgtPriorityMults[(targetUnit->IsCrashing()) * 3];
-					targetPriority *= tgtPriorityMults[(targetUnit == lastAttacker) * 4];
-				}
+		if (targetLOSState & LOS_INLOS) {
+			targetPriority *= (secDamage + targetUnit->health);
 
-				const bool allowTarget = eventHandler.AllowWeaponTarget(weaponOwner->id, targetUnit->id, weapon->weaponNum, weaponDef->id, &targetPriority);
+			if (paralyzer && targetUnit->paralyzeDamage > (modInfo.paralyzeOnMaxHealth? targetUnit->maxHealth: targetUnit->health))
+				targetPriority *= tgtPriorityMults[5];
 
-				// Lua call may have changed tempNum, so needs to be set again
-				targetUnit->tempNum = tempNum;
+			if (weapon->hasTargetWeight)
+				targetPriority *= weapon->TargetWeight(targetUnit);
 
-				if (!allowTarget)
-					continue;
+		} else {
+			targetPriority *= (secDamage + 10000.0f);
+		}
 
-				targets.emplace_back(targetPriority, targetUnit);
-			}
+		if (targetLOSState & LOS_PREVLOS) {
+			targetPriority /= (damageMul * targetUnit->power * (0.7f + gsRNG.NextFloat() * 0.6f));
+			targetPriority *= tgtPriorityMults[((targetUnit->category & weapon->badTargetCategory) != 0) * 2];
+			targetPriority *= tgtPriorityMults[(targetUnit->IsCrashing()) * 3];
+			targetPriority *= tgtPriorityMults[(targetUnit == lastAttacker) * 4];
 		}
+
+		// note: the dedup pass above has finished, so the tempNums
+		// this Lua call can change are no longer read by anything
+		if (eventHandler.HasAllowWeaponTargetClients() && !eventHandler.AllowWeaponTarget(weaponOwner->id, targetUnit->id, weapon->weaponNum, weaponDef->id, &targetPriority))
+			continue;
+
+		targets.emplace_back(targetPriority, targetUnit);
 	}
 
 	std::stable_sort(targets.begin(), targets.end(), [](const std::pair<float, CUnit*>& a, const std::pair<float, CUnit*>& b) { return (a.first < b.first); });
@@ -766,10 +905,47 @@ CUnit* CGameHelper::GetClosestEnemyUnit(const CUnit* excludeUnit, const float3&
 	return q.GetClosestUnit();
 }
 
+const std::vector<CUnit*>& CGameHelper::GetVisibleEnemies(int allyTeam)
+{
+	if (size_t(allyTeam) >= visibleEnemies.size())
+		visibleEnemies.resize(teamHandler.ActiveAllyTeams());
+
+	VisibleEnemyCache& cache = visibleEnemies[allyTeam];
+
+	if (cache.frameNum != gs->frameNum) {
+		cache.frameNum = gs->frameNum;
+		cache.units.clear();
+
+		for (CUnit* u: unitHandler.GetActiveUnits()) {
+			if (teamHandler.Ally(u->allyteam, allyTeam))
+				continue;
+			if ((u->losStatus[allyTeam] & (LOS_INLOS | LOS_INRADAR)) == 0)
+				continue;
+
+			cache.units.push_back(u);
+		}
+	}
+
+	return cache.units;
+}
+
 CUnit* CGameHelper::GetClosestValidTarget(const float3& pos, float searchRadius, int searchAllyteam, const CMobileCAI* cai)
 {
 	Query::ClosestUnit q(pos, searchRadius);
-	QueryUnits(Filter::Enemy_InLos_ValidTarget(searchAllyteam, cai), q);
+	Filter::Enemy_InLos_ValidTarget filter(searchAllyteam, cai);
+
+	// iterate the shared per-allyteam candidate list instead of doing a
+	// QuadField sweep per caller; the cheap distance reject runs before
+	// the per-CAI validity tests (TestTarget over every weapon)
+	for (CUnit* u: helper->GetVisibleEnemies(searchAllyteam)) {
+		if ((pos - u->midPos).SqLength2D() > q.sqRadius)
+			continue;
+
+		if (!filter.Unit(u))
+			continue;
+
+		q.AddUnit(u);
+	}
 	return q.GetClosestUnit();
 }
 
@@ -841,22 +1017,52 @@ size_t CGameHelper::GetEnemyUnitsNoLosTest(const float3& pos, float searchRadius
 
 void CGameHelper::BuggerOff(float3 pos, float radius, bool spherical, bool forced, int teamId, CUnit* excludeUnit)
 {
-	// copy on purpose since BuggerOff can call risky stuff
-	QuadFieldQuery qfQuery;
-	quadField.GetUnitsExact(qfQuery, pos, radius + SQUARE_SIZE, spherical);
-	const int allyTeamId = teamHandler.AllyTeam(teamId);
-
-	for (CUnit* u: *qfQuery.units) {
-		if (u == excludeUnit)
+	const int excludeUnitID = (excludeUnit != nullptr)? excludeUnit->id: -1;
+
+	// factories and builders call in with the same region every (slow-)
+	// update; coalesce repeats so each unique region costs one QuadField
+	// query per frame instead of one per call, all queued regions are
+	// resolved by FlushBuggerOffRequests
+	for (BuggerOffRequest& br: helper->buggerOffRequests) {
+		if (br.teamId != teamId || br.excludeUnitID != excludeUnitID)
 			continue;
-		// don't send BuggerOff commands to enemy units
-		if (!teamHandler.Ally(u->allyteam, allyTeamId) && !teamHandler.Ally(allyTeamId, u->allyteam))
+		if (br.spherical != spherical || br.forced != forced)
 			continue;
-		if (!forced && (u->moveType->IsPushResistant() || u->UsingScriptMoveType()))
+		if (br.pos.SqDistance(pos) > Square(SQUARE_SIZE))
 			continue;
 
-		u->commandAI->BuggerOff(pos, radius + SQUARE_SIZE);
+		br.radius = std::max(br.radius, radius);
+		return;
 	}
+
+	helper->buggerOffRequests.push_back({pos, radius, teamId, excludeUnitID, spherical, forced});
+}
+
+void CGameHelper::FlushBuggerOffRequests()
+{
+	for (const BuggerOffRequest& br: buggerOffRequests) {
+		// copy on purpose since BuggerOff can call risky stuff
+		QuadFieldQuery qfQuery;
+		quadField.GetUnitsExact(qfQuery, br.pos, br.radius + SQUARE_SIZE, br.spherical);
+		const int allyTeamId = teamHandler.AllyTeam(br.teamId);
+
+		for (CUnit* u: *qfQuery.units) {
+			if (u->id == br.excludeUnitID)
+				continue;
+			// don't send BuggerOff commands to enemy units
+			if (!teamHandler.Ally(u->allyteam, allyTeamId) && !teamHandler.Ally(allyTeamId, u->allyteam))
+				continue;
+			if (!br.forced && (u->moveType->IsPushResistant() || u->UsingScriptMoveType()))
+				continue;
+
+			// cheap, just updates the displacement goal; MobileCAI acts
+			// on it during its own SlowUpdate (overlapping regions leave
+			// the last goal standing, same as with unbatched calls)
+			u->commandAI->BuggerOff(br.pos, br.radius + SQUARE_SIZE);
+		}
+	}
+
+	buggerOffRequests.clear();
 }
 
 
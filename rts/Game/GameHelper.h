@@ -182,7 +182,37 @@ private:
 	// note: size must be a power of two
 	std::array<std::vector<WaitingDamage>, 128> waitingDamages;
 
+	struct BuggerOffRequest {
+		float3 pos;
+		float radius;
+
+		int teamId;
+		int excludeUnitID;
+
+		bool spherical;
+		bool forced;
+	};
+
+	// displacement regions queued by BuggerOff; duplicates coalesce
+	// and all are resolved in one pass at the start of the sim frame
+	std::vector<BuggerOffRequest> buggerOffRequests;
+
+	void FlushBuggerOffRequests();
+
+	// per-allyteam list of enemy units in LOS or radar, rebuilt lazily
+	// once per sim frame; fight-mode target scans all pull from it, so
+	// an army of chasers costs one enemy sweep per frame instead of one
+	// QuadField query per unit
+	struct VisibleEnemyCache {
+		int frameNum = -1;
+		std::vector<CUnit*> units;
+	};
+
+	std::vector<VisibleEnemyCache> visibleEnemies;
+
 public:
+	const std::vector<CUnit*>& GetVisibleEnemies(int allyTeam);
+
 	std::vector<int> targetUnitIDs; // GetEnemyUnits{NoLosTest}
 	std::vector<std::pair<float, CUnit*>> targetPairs; // GenerateWeaponTargets
 };
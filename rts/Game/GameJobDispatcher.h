@@ -5,6 +5,7 @@
 
 #include <functional>
 #include <queue>
+#include <vector>
 
 #include "System/Misc/SpringTime.h"
 
@@ -39,8 +40,23 @@ public:
 		const char* name;
 	};
 
+	// cooperative tasklet; its step function does a bounded amount of
+	// work per call and returns true while more remains, so it can be
+	// resumed across frames until completion and long computations do
+	// not each need a hand-rolled SlowUpdate state machine
+	struct Tasklet {
+	public:
+		Tasklet(const char* n = ""): name(n) {}
+
+		std::function<bool()> f;
+
+		const char* name;
+	};
+
 public:
 	void AddTimedJob(const Job& j) { jobs.push(j); }
+	void AddTasklet(const Tasklet& t) { tasklets.push_back(t); }
+
 	void Update() {
 		const spring_time now = spring_gettime();
 
@@ -58,11 +74,45 @@ public:
 			j.UpdateTime(now.toMilliSecsf());
 			AddTimedJob(j);
 		}
+
+		UpdateTasklets();
 	}
 
 private:
+	void UpdateTasklets() {
+		if (tasklets.empty())
+			return;
+
+		const spring_time drainEnd = spring_gettime() + spring_time::fromMilliSecs(TASKLET_BUDGET_MSECS);
+
+		// round-robin, resuming where the previous frame left off so
+		// one long tasklet can not starve the others when the budget
+		// expires; individual steps should stay well below the budget
+		size_t n = taskletPos;
+
+		do {
+			n %= tasklets.size();
+
+			if (!tasklets[n].f()) {
+				tasklets[n] = std::move(tasklets.back());
+				tasklets.pop_back();
+			} else {
+				n += 1;
+			}
+		} while (!tasklets.empty() && spring_gettime() < drainEnd);
+
+		taskletPos = n;
+	}
+
+private:
+	static constexpr float TASKLET_BUDGET_MSECS = 2.0f;
+
 	// job with smallest next-to-execute time goes at the top
 	std::priority_queue<Job, std::vector<Job>, std::greater<Job>> jobs;
+
+	std::vector<Tasklet> tasklets;
+
+	size_t taskletPos = 0;
 };
 
 #endif
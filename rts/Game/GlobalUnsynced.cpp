@@ -31,6 +31,23 @@ CGlobalUnsyncedRNG guRNG;
 CGlobalUnsynced* gu = &guOBJ;
 
 
+CGlobalUnsyncedRNG& guThreadRNG()
+{
+	// seeded lazily per thread; each instance's address doubles as its
+	// stream-id (see CGlobalRNG::SetSeed), so threads draw from fully
+	// independent sequences without ever touching shared state
+	static thread_local CGlobalUnsyncedRNG rng;
+	static thread_local bool seeded = false;
+
+	if (!seeded) {
+		rng.Seed(time(nullptr) % ((spring_gettime().toNanoSecsi() + 1) * 9007));
+		seeded = true;
+	}
+
+	return rng;
+}
+
+
 CR_BIND(CGlobalUnsynced, )
 
 CR_REG_METADATA(CGlobalUnsynced, (
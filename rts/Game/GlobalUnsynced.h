@@ -176,4 +176,9 @@ public:
 extern CGlobalUnsynced* gu;
 extern CGlobalUnsyncedRNG guRNG;
 
+// per-thread unsynced stream; prefer this over guRNG in code that can
+// run off the main thread (audio, for_mt workers) so generator state
+// is never shared between threads
+CGlobalUnsyncedRNG& guThreadRNG();
+
 #endif /* _GLOBAL_UNSYNCED_H */
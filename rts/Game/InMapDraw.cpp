@@ -172,6 +172,21 @@ int CInMapDraw::GotNetMsg(std::shared_ptr<const netcode::RawPacket>& packet)
 				if (!fromLua || allowLuaMapDrawing)
 					inMapDrawerModel->AddLine(pos1, pos2, playerID);
 			} break;
+			case MAPDRAW_STROKE: {
+				unsigned char fromLua;
+				unsigned char numSegments;
+				pckt >> fromLua;
+				pckt >> numSegments;
+
+				std::vector<int16_t> coords(numSegments * 4);
+				pckt >> coords;
+
+				if (!fromLua || allowLuaMapDrawing) {
+					for (size_t i = 0; i < coords.size(); i += 4) {
+						inMapDrawerModel->AddLine(float3(coords[i], 0, coords[i + 1]), float3(coords[i + 2], 0, coords[i + 3]), playerID);
+					}
+				}
+			} break;
 			case MAPDRAW_ERASE: {
 				short int x, z;
 				pckt >> x;
@@ -216,8 +231,43 @@ void CInMapDraw::SendPoint(const float3& pos, const std::string& label, bool fro
 
 void CInMapDraw::SendLine(const float3& pos, const float3& pos2, bool fromLua)
 {
-	if (!gu->spectating || allowSpecMapDrawing)
-		clientNet->Send(CBaseNetProtocol::Get().SendMapDrawLine(gu->myPlayerNum, (short)pos.x, (short)pos.z, (short)pos2.x, (short)pos2.z, fromLua));
+	if (gu->spectating && !allowSpecMapDrawing)
+		return;
+
+	// queued until FlushStrokes; Lua can emit bursts of many segments per
+	// frame which would otherwise each occupy a net-message of their own
+	std::vector<int16_t>& coords = pendingStrokes[fromLua];
+
+	coords.push_back((short)pos.x);
+	coords.push_back((short)pos.z);
+	coords.push_back((short)pos2.x);
+	coords.push_back((short)pos2.z);
+}
+
+void CInMapDraw::FlushStrokes()
+{
+	for (unsigned int fromLua = 0; fromLua < 2; fromLua++) {
+		std::vector<int16_t>& coords = pendingStrokes[fromLua];
+
+		if (coords.empty())
+			continue;
+
+		if (coords.size() == 4) {
+			// single segment, keep using the old per-line message
+			clientNet->Send(CBaseNetProtocol::Get().SendMapDrawLine(gu->myPlayerNum, coords[0], coords[1], coords[2], coords[3], fromLua));
+		} else {
+			// the uint8_t packet size-field limits strokes to 31 segments
+			constexpr size_t maxCoordsPerPacket = 31 * 4;
+
+			for (size_t i = 0, n = coords.size(); i < n; i += maxCoordsPerPacket) {
+				const std::vector<int16_t> stroke(coords.begin() + i, coords.begin() + std::min(n, i + maxCoordsPerPacket));
+
+				clientNet->Send(CBaseNetProtocol::Get().SendMapDrawStroke(gu->myPlayerNum, stroke, fromLua));
+			}
+		}
+
+		coords.clear();
+	}
 }
 
 void CInMapDraw::SendWaitingInput(const std::string& label)
@@ -38,6 +38,9 @@ public:
 	void SendErase(const float3& pos);
 	void SendWaitingInput(const std::string& label);
 
+	/// flushes line segments queued by SendLine, called once per draw-frame
+	void FlushStrokes();
+
 	void PromptLabel(const float3& pos);
 
 	void GetPoints(std::vector<PointMarker>& points, size_t maxPoints, const std::array<int, MAX_TEAMS>& teamIDs);
@@ -63,6 +66,10 @@ private:
 	float3 lastPos = OnesVector;
 	float3 waitingPoint;
 
+	/// line segments ({x1, z1, x2, z2} quadruplets) queued until the next
+	/// FlushStrokes; [0] holds player-drawn and [1] holds Lua-drawn lines
+	std::vector<int16_t> pendingStrokes[2];
+
 	/**
 	 * Whether we are in draw mode.
 	 * This is true for example, when the draw-mode-key is currently held down.
@@ -92,6 +92,11 @@ CPreGame::CPreGame(std::shared_ptr<ClientSetup> setup)
 
 CPreGame::~CPreGame()
 {
+	// abort paths can reach this with the validation job still running;
+	// it only touches globals that outlive us, but let it finish anyway
+	if (checksumJob.valid())
+		checksumJob.wait();
+
 	#ifndef HEADLESS
 	// delete leftover aGUI elements but not infoconsole, it is reused by CGame
 	agui::gui->Clean();
@@ -397,6 +402,12 @@ void CPreGame::UpdateClientNet()
 				clientNet->Send(CBaseNetProtocol::Get().SendClientData(playerNum, ClientData::GetCompressed()));
 
 				LOG("[PreGame::%s] received local player number %i (team %i, allyteam %i), creating LoadScreen", __func__, gu->myPlayerNum, gu->myTeam, gu->myAllyTeam);
+
+				// validation ran overlapped since GameDataReceived; join
+				// it before reporting so the message buffers are final
+				if (checksumJob.valid())
+					checksumJob.get();
+
 				CLIENT_NETLOG(gu->myPlayerNum, LOG_LEVEL_INFO, mapChecksumMsgBuf);
 				CLIENT_NETLOG(gu->myPlayerNum, LOG_LEVEL_INFO, modChecksumMsgBuf);
 
@@ -542,48 +553,15 @@ void CPreGame::GameDataReceived(std::shared_ptr<const netcode::RawPacket> packet
 	AddMapArchivesToVFS(gameSetup);
 	AddModArchivesToVFS(gameSetup);
 
-	{
-		// check checksums of map & game
-		// mismatches happen on dedicated servers between host and clients
-		// we want to know whether the *locally calculated* checksums also
-		// differ among clients so use the opportunity
-		// NOTE: gu->myPlayerNum is not valid yet, GameData arrives first
-		sha512::raw_digest gdMapChecksum;
-		sha512::raw_digest asMapChecksum;
-		sha512::raw_digest gdModChecksum;
-		sha512::raw_digest asModChecksum;
-		sha512::hex_digest gdMapChecksumHex;
-		sha512::hex_digest asMapChecksumHex;
-		sha512::hex_digest gdModChecksumHex;
-		sha512::hex_digest asModChecksumHex;
-
-		std::copy(gameData->GetMapChecksum(), gameData->GetMapChecksum() + sha512::SHA_LEN, gdMapChecksum.begin());
-		std::copy(gameData->GetModChecksum(), gameData->GetModChecksum() + sha512::SHA_LEN, gdModChecksum.begin());
-		std::fill(asMapChecksum.begin(), asMapChecksum.end(), 0);
-		std::fill(asModChecksum.begin(), asModChecksum.end(), 0);
-
-		try {
-			// gameSetup->MapFileName()
-			archiveScanner->CheckArchive(gameSetup->mapName, gdMapChecksum, asMapChecksum);
-		} catch (const content_error& ex) {
-			LOG_L(L_WARNING, "[PreGame::%s] %s", __func__, ex.what());
-		}
-		try {
-			archiveScanner->CheckArchive(modFileName, gdModChecksum, asModChecksum);
-		} catch (const content_error& ex) {
-			LOG_L(L_WARNING, "[PreGame::%s] %s", __func__, ex.what());
-		}
-
-		sha512::dump_digest(gdMapChecksum, gdMapChecksumHex);
-		sha512::dump_digest(gdModChecksum, gdModChecksumHex);
-		sha512::dump_digest(asMapChecksum, asMapChecksumHex);
-		sha512::dump_digest(asModChecksum, asModChecksumHex);
+	// if enabled, start pulling the full mod and map contents into memory
+	// on the prefetch worker while checksumming and loading proceed
+	vfsHandler->RamLoadArchives();
 
-		std::memset(mapChecksumMsgBuf, 0, sizeof(mapChecksumMsgBuf));
-		std::memset(modChecksumMsgBuf, 0, sizeof(modChecksumMsgBuf));
-		std::snprintf(mapChecksumMsgBuf, sizeof(mapChecksumMsgBuf), "[PreGame::%s][map-checksums]\n\tserver=%s\n\tclient=%s", __func__, gdMapChecksumHex.data(), asMapChecksumHex.data());
-		std::snprintf(modChecksumMsgBuf, sizeof(modChecksumMsgBuf), "[PreGame::%s][mod-checksums]\n\tserver=%s\n\tclient=%s", __func__, gdModChecksumHex.data(), asModChecksumHex.data());
-	}
+	// validate map & game checksums in the background; the per-file
+	// hashing inside ArchiveScanner is for_mt-parallel (and usually a
+	// cache hit), but a first-time hash of a big map still blocks for
+	// seconds which would freeze the join path right here
+	checksumJob = std::async(std::launch::async, [this]() { CheckContentChecksums(); });
 
 	// script.txt allows to disable demo file recording (host only, used for menu)
 	if (clientSetup->isHost && !gameSetup->recordDemo)
@@ -603,3 +581,48 @@ void CPreGame::GameDataReceived(std::shared_ptr<const netcode::RawPacket> packet
 	}
 }
 
+
+void CPreGame::CheckContentChecksums()
+{
+	// check checksums of map & game
+	// mismatches happen on dedicated servers between host and clients
+	// we want to know whether the *locally calculated* checksums also
+	// differ among clients so use the opportunity
+	// NOTE: gu->myPlayerNum is not valid yet, GameData arrives first
+	sha512::raw_digest gdMapChecksum;
+	sha512::raw_digest asMapChecksum;
+	sha512::raw_digest gdModChecksum;
+	sha512::raw_digest asModChecksum;
+	sha512::hex_digest gdMapChecksumHex;
+	sha512::hex_digest asMapChecksumHex;
+	sha512::hex_digest gdModChecksumHex;
+	sha512::hex_digest asModChecksumHex;
+
+	std::copy(gameData->GetMapChecksum(), gameData->GetMapChecksum() + sha512::SHA_LEN, gdMapChecksum.begin());
+	std::copy(gameData->GetModChecksum(), gameData->GetModChecksum() + sha512::SHA_LEN, gdModChecksum.begin());
+	std::fill(asMapChecksum.begin(), asMapChecksum.end(), 0);
+	std::fill(asModChecksum.begin(), asModChecksum.end(), 0);
+
+	try {
+		// gameSetup->MapFileName()
+		archiveScanner->CheckArchive(gameSetup->mapName, gdMapChecksum, asMapChecksum);
+	} catch (const content_error& ex) {
+		LOG_L(L_WARNING, "[PreGame::%s] %s", __func__, ex.what());
+	}
+	try {
+		archiveScanner->CheckArchive(modFileName, gdModChecksum, asModChecksum);
+	} catch (const content_error& ex) {
+		LOG_L(L_WARNING, "[PreGame::%s] %s", __func__, ex.what());
+	}
+
+	sha512::dump_digest(gdMapChecksum, gdMapChecksumHex);
+	sha512::dump_digest(gdModChecksum, gdModChecksumHex);
+	sha512::dump_digest(asMapChecksum, asMapChecksumHex);
+	sha512::dump_digest(asModChecksum, asModChecksumHex);
+
+	std::memset(mapChecksumMsgBuf, 0, sizeof(mapChecksumMsgBuf));
+	std::memset(modChecksumMsgBuf, 0, sizeof(modChecksumMsgBuf));
+	std::snprintf(mapChecksumMsgBuf, sizeof(mapChecksumMsgBuf), "[PreGame::%s][map-checksums]\n\tserver=%s\n\tclient=%s", __func__, gdMapChecksumHex.data(), asMapChecksumHex.data());
+	std::snprintf(modChecksumMsgBuf, sizeof(modChecksumMsgBuf), "[PreGame::%s][mod-checksums]\n\tserver=%s\n\tclient=%s", __func__, gdModChecksumHex.data(), asModChecksumHex.data());
+}
+
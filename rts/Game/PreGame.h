@@ -3,6 +3,7 @@
 #ifndef PREGAME_H
 #define PREGAME_H
 
+#include <future>
 #include <string>
 #include <memory>
 
@@ -64,6 +65,9 @@ private:
 
 	void GameDataReceived(std::shared_ptr<const netcode::RawPacket> packet);
 
+	/// compare our map and mod checksums against the server's (throws)
+	void CheckContentChecksums();
+
 private:
 	/**
 	@brief GameData we received from server
@@ -76,6 +80,10 @@ private:
 	std::string modFileName;
 	ILoadSaveHandler* saveFileHandler;
 
+	// runs CheckContentChecksums, overlapped with the prefetch and the
+	// remaining handshake round-trips; joined before LoadScreen creation
+	std::future<void> checksumJob;
+
 	spring_time connectTimer;
 
 	bool wantDemo;
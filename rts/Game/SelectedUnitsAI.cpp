@@ -391,9 +391,11 @@ void CSelectedUnitsHandlerAI::MakeFormationFrontOrder(Command* c, int playerNum)
 		}
 
 		mixedUnitIDs.clear();
-		mixedUnitIDs.reserve(frontMoveCommands.size());
+		mixedUnitIDs.resize(frontMoveCommands.size(), 0);
 		mixedGroupSizes.clear();
 		mixedGroupSizes.resize(sortedUnitGroups.size(), 0);
+		slotGroupNums.clear();
+		slotGroupNums.resize(frontMoveCommands.size(), 0);
 
 
 		// mix units in each row to avoid weak flanks consisting solely of e.g. artillery
@@ -419,12 +421,42 @@ void CSelectedUnitsHandlerAI::MakeFormationFrontOrder(Command* c, int playerNum)
 
 			// for each processed command, increase the count by 1 s.t.
 			// (at most) groupSize units are shuffled around per group
-			const size_t unitIndex = mixedGroupSizes[bestGroupNum]++;
+			mixedGroupSizes[bestGroupNum]++;
 
-			const auto& groupPair = sortedUnitGroups[bestGroupNum];
-			const auto& groupUnitIDs = groupPair.second;
+			// only the group is fixed per slot here; which of its units
+			// fills the slot is decided by the spatial pass below
+			slotGroupNums[j] = bestGroupNum;
+		}
+
+		// per group, match its units to its slots rank-by-rank along the
+		// front axis; slot positions grow toward <formationCenterPos>, so
+		// sorting the units by the same projection and pairing in order
+		// is the linear greedy assignment that minimizes lane crossings
+		// (the type layout across the row chosen above stays untouched)
+		const float3 frontAxis = (formationCenterPos - formationRightPos) * XZVector;
+
+		for (size_t groupNum = 0; groupNum < sortedUnitGroups.size(); ++groupNum) {
+			const auto& groupUnitIDs = sortedUnitGroups[groupNum].second;
+
+			groupSlotIdcs.clear();
+			groupUnitProjs.clear();
+
+			for (size_t j = 0; j < slotGroupNums.size(); j++) {
+				if (slotGroupNums[j] == groupNum)
+					groupSlotIdcs.push_back(j);
+			}
 
-			mixedUnitIDs.push_back(groupUnitIDs[unitIndex]);
+			for (size_t i = 0; i < groupSlotIdcs.size(); i++) {
+				const CUnit* unit = unitHandler.GetUnit(groupUnitIDs[i]);
+
+				groupUnitProjs.emplace_back(frontAxis.dot2D(unit->midPos), groupUnitIDs[i]);
+			}
+
+			std::stable_sort(groupUnitProjs.begin(), groupUnitProjs.end(), idPairComp);
+
+			for (size_t i = 0; i < groupSlotIdcs.size(); i++) {
+				mixedUnitIDs[groupSlotIdcs[i]] = groupUnitProjs[i].second;
+			}
 		}
 
 		for (size_t i = 0; i < frontMoveCommands.size(); i++) {
@@ -53,6 +53,10 @@ private:
 	std::vector<size_t> mixedUnitIDs;
 	std::vector<size_t> mixedGroupSizes;
 
+	std::vector<size_t> slotGroupNums; // per formation-slot, index into sortedUnitGroups
+	std::vector<size_t> groupSlotIdcs;
+	std::vector< std::pair<float, int> > groupUnitProjs; // <front-axis projection, unitID>
+
 
 	std::vector<int> targetUnitIDs;
 };
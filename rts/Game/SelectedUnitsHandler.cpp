@@ -27,6 +27,7 @@
 #include "Sim/Units/UnitToolTipMap.hpp"
 #include "Sim/Units/CommandAI/BuilderCAI.h"
 #include "Sim/Units/CommandAI/CommandAI.h"
+#include "Sim/Units/CommandAI/CommandDescription.h"
 #include "Game/UI/Groups/GroupHandler.h"
 #include "Game/UI/Groups/Group.h"
 #include "System/Config/ConfigHandler.h"
@@ -34,6 +35,7 @@
 #include "System/EventHandler.h"
 #include "System/Log/ILog.h"
 #include "System/StringUtil.h"
+#include "System/Sync/HsiehHash.h"
 #include "Net/Protocol/NetProtocol.h"
 #include "System/Net/PackPacket.h"
 #include "System/FileSystem/SimpleParser.h"
@@ -41,6 +43,8 @@
 #include "System/Sound/ISound.h"
 #include "System/Sound/ISoundChannels.h"
 
+#include <algorithm>
+
 #include <SDL_mouse.h>
 #include <SDL_keycode.h>
 
@@ -67,7 +71,7 @@ void CSelectedUnitsHandler::Init(unsigned numPlayers)
 
 bool CSelectedUnitsHandler::IsUnitSelected(const CUnit* unit) const
 {
-	return (unit != nullptr && selectedUnits.find(unit->id) != selectedUnits.end());
+	return (unit != nullptr && size_t(unit->id) < selectedUnitsBitmap.size() && selectedUnitsBitmap[unit->id] != 0);
 }
 
 bool CSelectedUnitsHandler::IsUnitSelected(const int unitID) const
@@ -91,16 +95,35 @@ CSelectedUnitsHandler::AvailableCommandsStruct CSelectedUnitsHandler::GetAvailab
 	int foundGroup = -2;
 	int foundGroup2 = -2;
 
-	spring::unordered_map<int, int> states;
-	std::vector<SCommandDescription> commands;
+	// large selections usually collapse to a handful of distinct command
+	// description lists (one per unitdef and command-state); merging one
+	// representative unit per distinct list yields the same icon set at a
+	// fraction of the cost, and if the set of lists matches the previous
+	// call the merged result can be reused wholesale
+	spring::unordered_map<const SCommandDescription*, uint32_t> descHashes;
+	spring::unordered_set<uint32_t> seenCmdListHashes;
+	std::vector<const CCommandAI*> repCAIs;
+	std::vector<uint32_t> selectionKey;
 
 	for (const int unitID: selectedUnits) {
 		const CUnit* u = unitHandler.GetUnit(unitID);
 		const CCommandAI* cai = u->commandAI;
 		const CGroup* group = u->GetGroup();
 
+		uint32_t cmdListHash = 0;
+
 		for (const SCommandDescription* cmdDesc: cai->GetPossibleCommands()) {
-			states[cmdDesc->id] = cmdDesc->disabled ? 2 : 1;
+			// descriptions are interned, so hash each distinct one just once;
+			// content (not pointer) hashes also key reused cache-slots safely
+			const auto it = descHashes.find(cmdDesc);
+			const uint32_t descHash = (it != descHashes.end())? it->second: (descHashes[cmdDesc] = commandDescriptionCache.CalcHash(*cmdDesc));
+
+			cmdListHash = HsiehHash(&descHash, sizeof(descHash), cmdListHash);
+		}
+
+		if (seenCmdListHashes.insert(cmdListHash).second) {
+			repCAIs.push_back(cai);
+			selectionKey.push_back(cmdListHash);
 		}
 
 		if (cai->lastSelectedCommandPage < commandPage)
@@ -119,11 +142,29 @@ CSelectedUnitsHandler::AvailableCommandsStruct CSelectedUnitsHandler::GetAvailab
 			foundGroup2 = -1;
 	}
 
-	// load the first set (separating build and non-build commands)
-	for (const int unitID: selectedUnits) {
-		const CUnit* u = unitHandler.GetUnit(unitID);
-		const CCommandAI* cai = u->commandAI;
+	// the merge below only depends on the distinct lists and these two flags
+	std::sort(selectionKey.begin(), selectionKey.end());
+	selectionKey.push_back(uint32_t(buildIconsFirst));
+	selectionKey.push_back(uint32_t(selectedUnits.size() > 1));
+
+	if (selectionKey == cachedSelectionKey) {
+		AvailableCommandsStruct ac;
+		ac.commandPage = commandPage;
+		ac.commands = cachedCommands;
+		return ac;
+	}
+
+	spring::unordered_map<int, int> states;
+	std::vector<SCommandDescription> commands;
+
+	for (const CCommandAI* cai: repCAIs) {
+		for (const SCommandDescription* cmdDesc: cai->GetPossibleCommands()) {
+			states[cmdDesc->id] = cmdDesc->disabled ? 2 : 1;
+		}
+	}
 
+	// load the first set (separating build and non-build commands)
+	for (const CCommandAI* cai: repCAIs) {
 		for (const SCommandDescription* cmdDesc: cai->GetPossibleCommands()) {
 			if (buildIconsFirst) {
 				if (cmdDesc->id >= 0)
@@ -144,10 +185,7 @@ CSelectedUnitsHandler::AvailableCommandsStruct CSelectedUnitsHandler::GetAvailab
 	}
 
 	// load the second set (all those that have not already been included)
-	for (const int unitID: selectedUnits) {
-		const CUnit* u = unitHandler.GetUnit(unitID);
-		const CCommandAI* cai = u->commandAI;
-
+	for (const CCommandAI* cai: repCAIs) {
 		for (const SCommandDescription* cmdDesc: cai->GetPossibleCommands()) {
 			if (buildIconsFirst) {
 				if (cmdDesc->id < 0)
@@ -167,9 +205,12 @@ CSelectedUnitsHandler::AvailableCommandsStruct CSelectedUnitsHandler::GetAvailab
 		}
 	}
 
+	cachedSelectionKey = std::move(selectionKey);
+	cachedCommands = commands;
+
 	AvailableCommandsStruct ac;
 	ac.commandPage = commandPage;
-	ac.commands = commands;
+	ac.commands = std::move(commands);
 	return ac;
 }
 
@@ -316,7 +357,7 @@ void CSelectedUnitsHandler::HandleUnitBoxSelection(const float4& planeRight, con
 			if (vec.dot4(planeBottom) >= 0.0f)
 				continue;
 
-			if (KeyInput::GetKeyModState(KMOD_CTRL) && (selectedUnits.find(u->id) != selectedUnits.end())) {
+			if (KeyInput::GetKeyModState(KMOD_CTRL) && IsUnitSelected(u)) {
 				RemoveUnit(u);
 				continue;
 			}
@@ -348,7 +389,7 @@ void CSelectedUnitsHandler::HandleSingleUnitClickSelection(CUnit* unit, bool doI
 		return;
 
 	if (!selectType) {
-		if (KeyInput::GetKeyModState(KMOD_CTRL) && (selectedUnits.find(unit->id) != selectedUnits.end())) {
+		if (KeyInput::GetKeyModState(KMOD_CTRL) && IsUnitSelected(unit)) {
 			RemoveUnit(unit);
 		} else {
 			AddUnit(unit);
@@ -395,7 +436,7 @@ void CSelectedUnitsHandler::AddUnit(CUnit* unit)
 	if (unit->noSelect)
 		return;
 
-	if (selectedUnits.insert(unit->id).second)
+	if (InsertSelectedUnit(unit->id))
 		AddDeathDependence(unit, DEPENDENCE_SELECTED);
 
 	selectionChanged = true;
@@ -412,7 +453,7 @@ void CSelectedUnitsHandler::AddUnit(CUnit* unit)
 
 void CSelectedUnitsHandler::RemoveUnit(CUnit* unit)
 {
-	if (selectedUnits.erase(unit->id))
+	if (EraseSelectedUnit(unit->id))
 		DeleteDeathDependence(unit, DEPENDENCE_SELECTED);
 
 	selectionChanged = true;
@@ -438,12 +479,37 @@ void CSelectedUnitsHandler::ClearSelected()
 	}
 
 	selectedUnits.clear();
+	std::fill(selectedUnitsBitmap.begin(), selectedUnitsBitmap.end(), 0);
 	selectionChanged = true;
 	possibleCommandsChanged = true;
 	selectedGroup = -1;
 }
 
 
+bool CSelectedUnitsHandler::InsertSelectedUnit(int unitID)
+{
+	if (size_t(unitID) >= selectedUnitsBitmap.size())
+		selectedUnitsBitmap.resize(unitHandler.MaxUnits(), 0);
+
+	if (selectedUnitsBitmap[unitID] != 0)
+		return false;
+
+	selectedUnitsBitmap[unitID] = 1;
+	selectedUnits.insert(std::lower_bound(selectedUnits.begin(), selectedUnits.end(), unitID), unitID);
+	return true;
+}
+
+bool CSelectedUnitsHandler::EraseSelectedUnit(int unitID)
+{
+	if (size_t(unitID) >= selectedUnitsBitmap.size() || selectedUnitsBitmap[unitID] == 0)
+		return false;
+
+	selectedUnitsBitmap[unitID] = 0;
+	selectedUnits.erase(std::lower_bound(selectedUnits.begin(), selectedUnits.end(), unitID));
+	return true;
+}
+
+
 void CSelectedUnitsHandler::SelectGroup(int num)
 {
 	ClearSelected();
@@ -455,7 +521,7 @@ void CSelectedUnitsHandler::SelectGroup(int num)
 
 		if (!u->noSelect) {
 			u->isSelected = true;
-			selectedUnits.insert(u->id);
+			InsertSelectedUnit(u->id);
 			AddDeathDependence(u, DEPENDENCE_SELECTED);
 		}
 	}
@@ -698,7 +764,7 @@ void CSelectedUnitsHandler::Draw()
 
 void CSelectedUnitsHandler::DependentDied(CObject* o)
 {
-	selectedUnits.erase(static_cast<CUnit*>(o)->id);
+	EraseSelectedUnit(static_cast<CUnit*>(o)->id);
 
 	selectionChanged = true;
 	possibleCommandsChanged = true;
@@ -871,7 +937,7 @@ int CSelectedUnitsHandler::GetDefaultCmd(const CUnit* unit, const CFeature* feat
 
 void CSelectedUnitsHandler::PossibleCommandChange(CUnit* sender)
 {
-	possibleCommandsChanged |= (sender == nullptr || selectedUnits.find(sender->id) != selectedUnits.end());
+	possibleCommandsChanged |= (sender == nullptr || IsUnitSelected(sender));
 }
 
 // CALLINFO:
@@ -933,7 +999,7 @@ std::string CSelectedUnitsHandler::GetTooltip()
 			team = teamHandler.Team(unit->team);
 			s = team->GetControllerName();
 		} else {
-			s = unitToolTipMap.Get(unit->id);
+			s = unitToolTipMap.Get(unit);
 		}
 	}
 
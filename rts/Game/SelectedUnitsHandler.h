@@ -76,12 +76,25 @@ public:
 	bool selectionChanged = false;
 	bool possibleCommandsChanged = true;
 
-	spring::unordered_set<int> selectedUnits;
+	/// sorted by unit id, mirrored by selectedUnitsBitmap
+	std::vector<int> selectedUnits;
 	std::vector< std::vector<int> > netSelected;
 
 private:
-	// buffer for SendCommand unordered_set->vector conversion
+	bool InsertSelectedUnit(int unitID);
+	bool EraseSelectedUnit(int unitID);
+
+private:
+	// buffer for SendCommand set->vector conversion
 	std::vector<int16_t> selectedUnitIDs;
+
+	// per-unit membership flags for selectedUnits, indexed by unit id
+	std::vector<uint8_t> selectedUnitsBitmap;
+
+	// GetAvailableCommands result cache, keyed by the sorted distinct
+	// command-description-list hashes of the current selection
+	std::vector<uint32_t> cachedSelectionKey;
+	std::vector<SCommandDescription> cachedCommands;
 };
 
 extern CSelectedUnitsHandler selectedUnitsHandler;
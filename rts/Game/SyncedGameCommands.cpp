@@ -16,18 +16,26 @@
 #include "Lua/LuaGaia.h"
 #include "Lua/LuaRules.h"
 #include "Lua/LuaUI.h"
+#include "Map/Ground.h"
+#include "Map/ReadMap.h"
 #include "Sim/Misc/GlobalSynced.h"
 #include "Sim/Misc/LosHandler.h"
+#include "Sim/Misc/Team.h"
 #include "Sim/Misc/TeamHandler.h"
 #include "Sim/Misc/ModInfo.h"
 #include "Sim/Projectiles/ExplosionGenerator.h"
+#include "Sim/Units/UnitDef.h"
 #include "Sim/Units/UnitDefHandler.h"
 #include "Sim/Units/UnitHandler.h"
 #include "Sim/Units/UnitLoader.h"
 #include "Sim/Units/Unit.h"
+#include "Sim/Units/CommandAI/Command.h"
+#include "Sim/Units/CommandAI/CommandAI.h"
 #include "System/EventHandler.h"
 #include "System/FileSystem/SimpleParser.h"
+#include "System/GlobalRNG.h"
 #include "System/Log/ILog.h"
+#include "System/Platform/Watchdog.h"
 #include "System/SafeUtil.h"
 
 #include <string>
@@ -224,6 +232,118 @@ public:
 };
 
 
+class BattleTestActionExecutor : public ISyncedActionExecutor {
+public:
+	BattleTestActionExecutor() : ISyncedActionExecutor(
+		"BattleTest",
+		"Spawns an identical army for every active team from a seed and "
+		"orders it to fight through the map center; produces deterministic "
+		"large-scale sim workloads for profiling, also in headless builds "
+		"(\"/battletest <defName[,defName2,...]> [amount] [seed] [spacing] [noorders]\")",
+		true
+	) {
+	}
+
+	bool Execute(const SyncedAction& action) const final override {
+		const std::vector<std::string> args = CSimpleParser::Tokenize(action.GetArgs(), 0);
+
+		if (args.empty()) {
+			LOG_L(L_WARNING, "[BattleTestAction] missing unit-def argument (\"/battletest <defName[,defName2,...]> [amount] [seed] [spacing] [noorders]\")");
+			return false;
+		}
+
+		std::vector<const UnitDef*> unitDefs;
+
+		for (const std::string& defName: CSimpleParser::Split(args[0], ",")) {
+			const UnitDef* ud = unitDefHandler->GetUnitDefByName(defName);
+
+			if (ud == nullptr) {
+				LOG_L(L_WARNING, "[BattleTestAction] %s is not a valid unit-def name", defName.c_str());
+				return false;
+			}
+
+			unitDefs.push_back(ud);
+		}
+
+		const int numUnits = (args.size() > 1)? std::max(1, atoi(args[1].c_str())): 500;
+		const unsigned int seed = (args.size() > 2)? (unsigned int) strtoul(args[2].c_str(), nullptr, 10): 1234567u;
+		const float spacing = (args.size() > 3)? std::max(1.0f * SQUARE_SIZE, (float) atof(args[3].c_str())): (10.0f * SQUARE_SIZE);
+		const bool giveOrders = (args.size() <= 4 || args[4] != "noorders");
+
+		// private generator so the layout is a pure function of the seed
+		// and repeat invocations do not disturb the gsRNG stream further
+		CGlobalSyncedRNG rng;
+		rng.SetSeed(seed, true);
+
+		const float3 mapCenter = {mapDims.mapx * SQUARE_SIZE * 0.5f, 0.0f, mapDims.mapy * SQUARE_SIZE * 0.5f};
+		const float circleRadius = 0.7f * std::min(mapCenter.x, mapCenter.z);
+
+		const int numTeams = teamHandler.ActiveTeams() - (teamHandler.GaiaTeamID() >= 0);
+		const int gridSize = math::ceil(math::sqrt((float) numUnits));
+
+		if (numTeams <= 0)
+			return false;
+
+		int numSpawned = 0;
+		int teamsDone = 0;
+
+		for (int team = 0; team < teamHandler.ActiveTeams(); team++) {
+			if (team == teamHandler.GaiaTeamID())
+				continue;
+
+			// armies start evenly spaced on a circle around the map
+			// center and fight toward the diametrically opposite point
+			const float angle = (math::TWOPI * teamsDone++) / numTeams;
+			const float3 teamCenter = mapCenter + float3(math::cos(angle), 0.0f, math::sin(angle)) * circleRadius;
+
+			const CTeam* spawnTeam = teamHandler.Team(team);
+			const int maxSpawn = std::min(numUnits, int(spawnTeam->GetMaxUnits() - spawnTeam->GetNumUnits()));
+
+			float3 goalPos = mapCenter * 2.0f - teamCenter;
+			goalPos.y = CGround::GetHeightReal(goalPos.x, goalPos.z);
+
+			for (int i = 0; i < maxSpawn; i++) {
+				Watchdog::ClearTimers(false, true);
+
+				float px = teamCenter.x + (i % gridSize - gridSize / 2) * spacing + (rng.NextFloat() - 0.5f) * spacing * 0.5f;
+				float pz = teamCenter.z + (i / gridSize - gridSize / 2) * spacing + (rng.NextFloat() - 0.5f) * spacing * 0.5f;
+
+				px = Clamp(px, 0.0f, float3::maxxpos - 1.0f);
+				pz = Clamp(pz, 0.0f, float3::maxzpos - 1.0f);
+
+				const UnitLoadParams unitParams = {
+					unitDefs[i % unitDefs.size()],
+					nullptr,
+
+					float3(px, CGround::GetHeightReal(px, pz), pz),
+					ZeroVector,
+
+					-1,
+					team,
+					FACING_SOUTH,
+
+					false,
+					false,
+				};
+
+				CUnit* unit = unitLoader->LoadUnit(unitParams);
+
+				if (unit == nullptr)
+					break;
+
+				if (giveOrders)
+					unit->commandAI->GiveCommand(Command(CMD_FIGHT, 0, goalPos), -1, true, true);
+
+				numSpawned++;
+			}
+		}
+
+		LOG("[BattleTestAction] spawned %d units across %d teams (seed %u) in frame %d", numSpawned, teamsDone, seed, gs->frameNum);
+		return true;
+	}
+};
+
+
 class NoSpectatorChatActionExecutor : public ISyncedActionExecutor {
 public:
 	NoSpectatorChatActionExecutor() : ISyncedActionExecutor("NoSpectatorChat", "Enables/Disables spectators to use the chat") {
@@ -573,6 +693,7 @@ void SyncedGameCommands::AddDefaultActionExecutors()
 	AddActionExecutor(AllocActionExecutor<NoCostActionExecutor>());
 	AddActionExecutor(AllocActionExecutor<GiveActionExecutor>());
 	AddActionExecutor(AllocActionExecutor<DestroyActionExecutor>());
+	AddActionExecutor(AllocActionExecutor<BattleTestActionExecutor>());
 	AddActionExecutor(AllocActionExecutor<NoSpectatorChatActionExecutor>());
 	AddActionExecutor(AllocActionExecutor<ReloadCobActionExecutor>());
 	AddActionExecutor(AllocActionExecutor<ReloadCegsActionExecutor>());
@@ -27,6 +27,20 @@
 // Local/Helper functions
 //////////////////////////////////////////////////////////////////////
 
+// per-thread quad list reused by every trace; beam weapons ray-trace
+// each frame on the sim thread while GuiTraceRay and AI callbacks can
+// do so from others, so give each thread its own list (sized once and
+// recycled) instead of going through QuadField's shared query-vector
+// cache, which tolerates neither concurrency nor deep recursion
+static const std::vector<int>& TraceQuadsOnRay(const float3& start, const float3& dir, float length)
+{
+	static thread_local std::vector<int> queryQuads;
+
+	queryQuads.clear();
+	quadField.GetQuadsOnRay(queryQuads, start, dir, length);
+	return queryQuads;
+}
+
 /**
  * helper for TestCone
  * @return true if object <o> is in the firing cone, false otherwise
@@ -165,21 +179,63 @@ inline static bool TestTrajectoryConeHelper(
 namespace TraceRay {
 
 // called by {CRifle, CBeamLaser, CLightningCannon}::Fire(), CWeapon::HaveFreeLineOfFire(), and Skirmish AIs
+// shield scan over a pre-gathered quad list; kept separate so the
+// combined beam traces can reuse the quads of the unit/feature scan
+static void ScanShieldQuads(
+	const CWeapon* emitter,
+	const std::vector<int>& rayQuads,
+	const float3& start,
+	const float3& dir,
+	float length,
+	std::vector<SShieldDist>& hitShields
+) {
+	CollisionQuery cq;
+
+	for (const int quadIdx: rayQuads) {
+		const CQuadField::Quad& quad = quadField.GetQuad(quadIdx);
+
+		for (CPlasmaRepulser* r: quad.repulsers) {
+			if (!r->CanIntercept(emitter->weaponDef->interceptedByShieldType, emitter->owner->allyteam))
+				continue;
+
+			if (CCollisionHandler::DetectHit(r->owner, &r->collisionVolume, r->owner->GetTransformMatrix(true), start, start + dir * length, &cq, true)) {
+				if (cq.InsideHit() && r->weaponDef->exteriorShield)
+					continue;
+
+				const float len = cq.GetHitPosDist(start, dir);
+
+				if (len <= 0.0f)
+					continue;
+
+				const auto hitCmp = [](const float a, const SShieldDist& b) { return (a < b.dist); };
+				const auto insPos = std::upper_bound(hitShields.begin(), hitShields.end(), len, hitCmp);
+
+				hitShields.insert(insPos, {r, len});
+			}
+		}
+	}
+}
+
+
 float TraceRay(const float3& p, const float3& d, float l, int f, const CUnit* o, CUnit*& hu, CFeature*& hf, CollisionQuery* cq)
 {
 	assert(o != nullptr);
 	return (TraceRay(p, d, l, f, o->allyteam, o, hu, hf, cq));
 }
 
-float TraceRay(
+// single implementation behind TraceRay and TraceRayAndShields; when
+// <hitShields> is non-null the shield scan piggybacks on the quad walk
+// of the unit/feature scan instead of re-tracing the same ray
+static float TraceRayIntern(
 	const float3& pos,
 	const float3& dir,
 	float traceLength,
 	int traceFlags,
-	int allyTeam,
 	const CUnit* owner,
+	const CWeapon* emitter,
 	CUnit*& hitUnit,
 	CFeature*& hitFeature,
+	std::vector<SShieldDist>* hitShields,
 	CollisionQuery* hitColQuery
 ) {
 	// NOTE:
@@ -202,20 +258,58 @@ float TraceRay(
 	if (dir == ZeroVector)
 		return -1.0f;
 
-	if (scanForFeatures || scanForAnyUnits) {
+	if (scanForFeatures || scanForAnyUnits || hitShields != nullptr) {
 		CollisionQuery cq;
 
-		QuadFieldQuery qfQuery;
-		quadField.GetQuadsOnRay(qfQuery, pos, dir, traceLength);
+		const std::vector<int>& rayQuads = TraceQuadsOnRay(pos, dir, traceLength);
+
+		// scan shields along the full-length ray while the quads are hot;
+		// callers filter the (sorted) hits against their own beam length
+		if (hitShields != nullptr)
+			ScanShieldQuads(emitter, rayQuads, pos, dir, traceLength, *hitShields);
 
 		// locally point somewhere non-NULL; we cannot pass hitColQuery
 		// to DetectHit directly because each call resets it internally
 		if (hitColQuery == nullptr)
 			hitColQuery = &cq;
 
+		// candidates are gathered into SoA bounding-sphere batches first;
+		// FilterSphereBatch rejects the ones the ray cannot touch so only
+		// survivors pay for the full (matrix-transforming) DetectHit
+		CCollisionHandler::SphereBatch sphereBatch;
+		unsigned char sphereHits[CCollisionHandler::SPHERE_BATCH_SIZE];
+
 		// feature intersection
 		if (scanForFeatures) {
-			for (const int quadIdx: *qfQuery.quads) {
+			CFeature* featureBatch[CCollisionHandler::SPHERE_BATCH_SIZE];
+
+			const auto FlushFeatureBatch = [&]() {
+				if (CCollisionHandler::FilterSphereBatch(sphereBatch, pos, dir, traceLength, sphereHits) != 0) {
+					for (unsigned int i = 0; i < sphereBatch.count; i++) {
+						if (!sphereHits[i])
+							continue;
+
+						CFeature* f = featureBatch[i];
+
+						if (CCollisionHandler::DetectHit(f, f->GetTransformMatrix(true), pos, pos + dir * traceLength, &cq, true)) {
+							const float len = cq.GetHitPosDist(pos, dir);
+
+							// we want the closest feature (intersection point) on the ray
+							if (len >= traceLength)
+								continue;
+
+							traceLength = len;
+
+							hitFeature = f;
+							*hitColQuery = cq;
+						}
+					}
+				}
+
+				sphereBatch.Clear();
+			};
+
+			for (const int quadIdx: rayQuads) {
 				const CQuadField::Quad& quad = quadField.GetQuad(quadIdx);
 
 				for (CFeature* f: quad.features) {
@@ -225,25 +319,48 @@ float TraceRay(
 					if (!f->HasCollidableStateBit(CSolidObject::CSTATE_BIT_QUADMAPRAYS))
 						continue;
 
-					if (CCollisionHandler::DetectHit(f, f->GetTransformMatrix(true), pos, pos + dir * traceLength, &cq, true)) {
-						const float len = cq.GetHitPosDist(pos, dir);
-
-						// we want the closest feature (intersection point) on the ray
-						if (len >= traceLength)
-							continue;
+					featureBatch[sphereBatch.count] = f;
+					sphereBatch.Push(f->collisionVolume.GetWorldSpacePos(f), f->collisionVolume.GetBoundingRadius());
 
-						traceLength = len;
-
-						hitFeature = f;
-						*hitColQuery = cq;
-					}
+					if (sphereBatch.Full())
+						FlushFeatureBatch();
 				}
 			}
+
+			FlushFeatureBatch();
 		}
 
 		// unit intersection
 		if (scanForAnyUnits) {
-			for (const int quadIdx: *qfQuery.quads) {
+			CUnit* unitBatch[CCollisionHandler::SPHERE_BATCH_SIZE];
+
+			const auto FlushUnitBatch = [&]() {
+				if (CCollisionHandler::FilterSphereBatch(sphereBatch, pos, dir, traceLength, sphereHits) != 0) {
+					for (unsigned int i = 0; i < sphereBatch.count; i++) {
+						if (!sphereHits[i])
+							continue;
+
+						CUnit* u = unitBatch[i];
+
+						if (CCollisionHandler::DetectHit(u, u->GetTransformMatrix(true), pos, pos + dir * traceLength, &cq, true)) {
+							const float len = cq.GetHitPosDist(pos, dir);
+
+							// we want the closest unit (intersection point) on the ray
+							if (len >= traceLength)
+								continue;
+
+							traceLength = len;
+
+							hitUnit = u;
+							*hitColQuery = cq;
+						}
+					}
+				}
+
+				sphereBatch.Clear();
+			};
+
+			for (const int quadIdx: rayQuads) {
 				const CQuadField::Quad& quad = quadField.GetQuad(quadIdx);
 
 				for (CUnit* u: quad.units) {
@@ -263,21 +380,16 @@ float TraceRay(
 					if (!doHitTest)
 						continue;
 
-					if (CCollisionHandler::DetectHit(u, u->GetTransformMatrix(true), pos, pos + dir * traceLength, &cq, true)) {
-						const float len = cq.GetHitPosDist(pos, dir);
-
-						// we want the closest unit (intersection point) on the ray
-						if (len >= traceLength)
-							continue;
-
-						traceLength = len;
+					unitBatch[sphereBatch.count] = u;
+					sphereBatch.Push(u->collisionVolume.GetWorldSpacePos(u), u->collisionVolume.GetBoundingRadius());
 
-						hitUnit = u;
-						*hitColQuery = cq;
-					}
+					if (sphereBatch.Full())
+						FlushUnitBatch();
 				}
 			}
 
+			FlushUnitBatch();
+
 			// units override features, so feature != null implies no unit was hit
 			if (hitUnit != nullptr)
 				hitFeature = nullptr;
@@ -301,6 +413,35 @@ float TraceRay(
 	return traceLength;
 }
 
+float TraceRay(
+	const float3& pos,
+	const float3& dir,
+	float traceLength,
+	int traceFlags,
+	int allyTeam,
+	const CUnit* owner,
+	CUnit*& hitUnit,
+	CFeature*& hitFeature,
+	CollisionQuery* hitColQuery
+) {
+	return (TraceRayIntern(pos, dir, traceLength, traceFlags, owner, nullptr, hitUnit, hitFeature, nullptr, hitColQuery));
+}
+
+float TraceRayAndShields(
+	const CWeapon* emitter,
+	const float3& pos,
+	const float3& dir,
+	float traceLength,
+	int traceFlags,
+	CUnit*& hitUnit,
+	CFeature*& hitFeature,
+	std::vector<SShieldDist>& hitShields,
+	CollisionQuery* hitColQuery
+) {
+	assert(emitter != nullptr && emitter->owner != nullptr);
+	return (TraceRayIntern(pos, dir, traceLength, traceFlags, emitter->owner, emitter, hitUnit, hitFeature, &hitShields, hitColQuery));
+}
+
 
 void TraceRayShields(
 	const CWeapon* emitter,
@@ -309,34 +450,7 @@ void TraceRayShields(
 	float length,
 	std::vector<SShieldDist>& hitShields
 ) {
-	CollisionQuery cq;
-
-	QuadFieldQuery qfQuery;
-	quadField.GetQuadsOnRay(qfQuery, start, dir, length);
-
-	for (const int quadIdx: *qfQuery.quads) {
-		const CQuadField::Quad& quad = quadField.GetQuad(quadIdx);
-
-		for (CPlasmaRepulser* r: quad.repulsers) {
-			if (!r->CanIntercept(emitter->weaponDef->interceptedByShieldType, emitter->owner->allyteam))
-				continue;
-
-			if (CCollisionHandler::DetectHit(r->owner, &r->collisionVolume, r->owner->GetTransformMatrix(true), start, start + dir * length, &cq, true)) {
-				if (cq.InsideHit() && r->weaponDef->exteriorShield)
-					continue;
-
-				const float len = cq.GetHitPosDist(start, dir);
-
-				if (len <= 0.0f)
-					continue;
-
-				const auto hitCmp = [](const float a, const SShieldDist& b) { return (a < b.dist); };
-				const auto insPos = std::upper_bound(hitShields.begin(), hitShields.end(), len, hitCmp);
-
-				hitShields.insert(insPos, {r, len});
-			}
-		}
-	}
+	ScanShieldQuads(emitter, TraceQuadsOnRay(start, dir, length), start, dir, length, hitShields);
 }
 
 
@@ -377,10 +491,9 @@ float GuiTraceRay(
 
 	CollisionQuery cq;
 
-	QuadFieldQuery qfQuery;
-	quadField.GetQuadsOnRay(qfQuery, start, dir, length);
+	const std::vector<int>& rayQuads = TraceQuadsOnRay(start, dir, length);
 
-	for (const int quadIdx: *qfQuery.quads) {
+	for (const int quadIdx: rayQuads) {
 		const CQuadField::Quad& quad = quadField.GetQuad(quadIdx);
 
 		// Unit Intersection
@@ -485,17 +598,16 @@ bool TestCone(
 	int traceFlags,
 	CUnit* owner
 ) {
-	QuadFieldQuery qfQuery;
-	quadField.GetQuadsOnRay(qfQuery, from, dir, length);
+	const std::vector<int>& rayQuads = TraceQuadsOnRay(from, dir, length);
 
-	if (qfQuery.quads->empty())
+	if (rayQuads.empty())
 		return true;
 
 	const bool scanForAllies   = ((traceFlags & Collision::NOFRIENDLIES) == 0);
 	const bool scanForNeutrals = ((traceFlags & Collision::NONEUTRALS  ) == 0);
 	const bool scanForFeatures = ((traceFlags & Collision::NOFEATURES  ) == 0);
 
-	for (const int quadIdx: *qfQuery.quads) {
+	for (const int quadIdx: rayQuads) {
 		const CQuadField::Quad& quad = quadField.GetQuad(quadIdx);
 
 		if (scanForAllies) {
@@ -551,17 +663,16 @@ bool TestTrajectoryCone(
 	int traceFlags,
 	CUnit* owner
 ) {
-	QuadFieldQuery qfQuery;
-	quadField.GetQuadsOnRay(qfQuery, from, dir, length);
+	const std::vector<int>& rayQuads = TraceQuadsOnRay(from, dir, length);
 
-	if (qfQuery.quads->empty())
+	if (rayQuads.empty())
 		return true;
 
 	const bool scanForAllies   = ((traceFlags & Collision::NOFRIENDLIES) == 0);
 	const bool scanForNeutrals = ((traceFlags & Collision::NONEUTRALS  ) == 0);
 	const bool scanForFeatures = ((traceFlags & Collision::NOFEATURES  ) == 0);
 
-	for (const int quadIdx: *qfQuery.quads) {
+	for (const int quadIdx: rayQuads) {
 		const CQuadField::Quad& quad = quadField.GetQuad(quadIdx);
 
 		// friendly units in this quad
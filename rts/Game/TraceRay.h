@@ -55,6 +55,20 @@ namespace TraceRay {
 		CollisionQuery* hitColQuery
 	);
 
+	/// unit/feature and shield scan sharing a single quad walk; shield
+	/// hits are gathered over the full trace length, sorted by distance
+	float TraceRayAndShields(
+		const CWeapon* emitter,
+		const float3& pos,
+		const float3& dir,
+		float traceLength,
+		int traceFlags,
+		CUnit*& hitUnit,
+		CFeature*& hitFeature,
+		std::vector<SShieldDist>& hitShields,
+		CollisionQuery* hitColQuery = nullptr
+	);
+
 	void TraceRayShields(
 		const CWeapon* emitter,
 		const float3& start,
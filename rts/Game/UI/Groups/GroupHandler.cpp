@@ -127,7 +127,7 @@ bool CGroupHandler::GroupCommand(int num, const std::string& cmd)
 			for (const int unitID: group->units) {
 				CUnit* unit = unitHandler.GetUnit(unitID);
 
-				if (selUnits.find(unitID) == selUnits.end()) {
+				if (!selectedUnitsHandler.IsUnitSelected(unitID)) {
 					selectedUnitsHandler.AddUnit(unit);
 				} else {
 					selectedUnitsHandler.RemoveUnit(unit);
@@ -3501,9 +3501,9 @@ static inline void DrawUnitWeaponAngleCones(const CUnit* unit, GL::RenderDataBuf
 		if (w->weaponDef->projectileType == WEAPON_BASE_PROJECTILE)
 			continue;
 
-		const float hrads   = math::acos(w->maxForwardAngleDif);
-		const float heading = math::atan2(-w->wantedDir.z, w->wantedDir.x);
-		const float pitch   = math::asin(w->wantedDir.y);
+		const float hrads   = std::acos(w->maxForwardAngleDif);
+		const float heading = std::atan2(-w->wantedDir.z, w->wantedDir.x);
+		const float pitch   = std::asin(w->wantedDir.y);
 
 		// note: cone visualization is invalid for ballistic weapons
 		DrawWeaponAngleCone(rdb, ipo, w->weaponMuzzlePos, {w->range, hrads}, {heading, pitch});
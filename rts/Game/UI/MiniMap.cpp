@@ -163,6 +163,7 @@ CMiniMap::~CMiniMap()
 {
 	glDeleteTextures(1, &buttonsTextureID);
 	glDeleteTextures(1, &minimapTextureID);
+	glDeleteTextures(1, &backgroundTextureID);
 
 	miniMap.Kill();
 }
@@ -467,8 +468,8 @@ void CMiniMap::UpdateGeometry()
 	const float h = float(curDim.y);
 	const float mapx = float(mapDims.mapx * SQUARE_SIZE);
 	const float mapy = float(mapDims.mapy * SQUARE_SIZE);
-	const float ref  = unitBaseSize / math::pow((200.0f * 200.0f), unitExponent);
-	const float dpr  = ref * math::pow((w * h), unitExponent);
+	const float ref  = unitBaseSize / std::pow((200.0f * 200.0f), unitExponent);
+	const float dpr  = ref * std::pow((w * h), unitExponent);
 
 	unitSizeX = dpr * (mapx / w);
 	unitSizeY = dpr * (mapy / h);
@@ -997,6 +998,31 @@ void CMiniMap::ResizeTextureCache()
 
 	minimapTexSize = curDim;
 
+	{
+		// the background layer renders into a plain texture that gets
+		// composited as a single quad, multisampling buys nothing here
+		glDeleteTextures(1, &backgroundTextureID);
+		glGenTextures(1, &backgroundTextureID);
+
+		glBindTexture(GL_TEXTURE_2D, backgroundTextureID);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, minimapTexSize.x, minimapTexSize.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+		fboBackground.Bind();
+		fboBackground.AttachTexture(backgroundTextureID);
+
+		if (!fboBackground.CheckStatus("MINIMAP-BACKGROUND"))
+			throw opengl_error("[MiniMap::ResizeTextureCache] bad background framebuffer");
+
+		bgLayerDirty = true;
+
+		// {Detach,CreateRenderBuffer*} below operate on the bound FBO
+		fbo.Bind();
+	}
+
 	if ((multisampledFBO = (fbo.GetMaxSamples() > 1))) {
 		fbo.Detach(GL_COLOR_ATTACHMENT0); // delete old RBO
 		fbo.CreateRenderBufferMultisample(GL_COLOR_ATTACHMENT0, GL_RGBA8, minimapTexSize.x, minimapTexSize.y, 4);
@@ -1038,11 +1064,47 @@ void CMiniMap::ResizeTextureCache()
 }
 
 
+void CMiniMap::UpdateBackgroundLayer()
+{
+	// infotexture overlays (LOS, metal, ...) animate every frame; the
+	// periodic refresh picks up the slow-changing inputs (terrain and
+	// shading-texture updates) that have no invalidation signal
+	static spring_time nextBgDrawTime = spring_gettime();
+
+	if (spring_gettime() > nextBgDrawTime) {
+		nextBgDrawTime = spring_gettime() + spring_msecs(1000.0f);
+		bgLayerDirty = true;
+	}
+
+	bgLayerDirty |= infoTextureHandler->IsEnabled();
+	bgLayerDirty |= (bgLayerGamma != globalRendering->gammaExponent);
+
+	if (!bgLayerDirty)
+		return;
+
+	bgLayerDirty = false;
+	bgLayerGamma = globalRendering->gammaExponent;
+
+	fboBackground.Bind();
+
+	glAttribStatePtr->ViewPort(0, 0, minimapTexSize.x, minimapTexSize.y);
+	glAttribStatePtr->ClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+	glAttribStatePtr->Clear(GL_COLOR_BUFFER_BIT);
+
+	DrawBackground();
+
+	fbo.Bind();
+}
+
+
 void CMiniMap::UpdateTextureCache()
 {
 	{
 		curPos = {0, 0};
 
+		if (!minimized)
+			UpdateBackgroundLayer();
+
 		// draw minimap into FBO
 		glAttribStatePtr->ViewPort(0, 0, minimapTexSize.x, minimapTexSize.y);
 		glAttribStatePtr->ClearColor(0.0f, 0.0f, 0.0f, 1.0f);
@@ -1128,7 +1190,7 @@ void CMiniMap::DrawForReal()
 		// no real need for this: most objects are on the map
 		// most of the time, texture scissor handles the rest
 		// SetClipPlanes(false);
-		DrawBackground();
+		DrawCachedBackground();
 	}
 
 	{
@@ -1581,6 +1643,35 @@ void CMiniMap::DrawBackground()
 }
 
 
+// composites the cached background layer into the minimap FBO
+void CMiniMap::DrawCachedBackground()
+{
+	GL::RenderDataBufferTC* buffer = GL::GetRenderBufferTC();
+	Shader::IProgramObject* shader = buffer->GetShader();
+
+	glAttribStatePtr->DisableBlendMask();
+	glBindTexture(GL_TEXTURE_2D, backgroundTextureID);
+
+	shader->Enable();
+	shader->SetUniformMatrix4x4<float>("u_movi_mat", false, CMatrix44f::Identity());
+	shader->SetUniformMatrix4x4<float>("u_proj_mat", false, projMats[0]);
+
+	buffer->SafeAppend({{0.0f, 0.0f, 0.0f}, 0.0f, 0.0f, {1.0f, 1.0f, 1.0f, 1.0f}}); // tl
+	buffer->SafeAppend({{1.0f, 0.0f, 0.0f}, 1.0f, 0.0f, {1.0f, 1.0f, 1.0f, 1.0f}}); // tr
+	buffer->SafeAppend({{1.0f, 1.0f, 0.0f}, 1.0f, 1.0f, {1.0f, 1.0f, 1.0f, 1.0f}}); // br
+
+	buffer->SafeAppend({{1.0f, 1.0f, 0.0f}, 1.0f, 1.0f, {1.0f, 1.0f, 1.0f, 1.0f}}); // br
+	buffer->SafeAppend({{0.0f, 1.0f, 0.0f}, 0.0f, 1.0f, {1.0f, 1.0f, 1.0f, 1.0f}}); // bl
+	buffer->SafeAppend({{0.0f, 0.0f, 0.0f}, 0.0f, 0.0f, {1.0f, 1.0f, 1.0f, 1.0f}}); // tl
+	buffer->Submit(GL_TRIANGLES);
+
+	shader->Disable();
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glAttribStatePtr->EnableBlendMask();
+}
+
+
 void CMiniMap::DrawUnitIcons() const
 {
 	GL::RenderDataBufferTC* buffer = GL::GetRenderBufferTC();
@@ -97,6 +97,8 @@ protected:
 	void ProxyMouseRelease(int x, int y, int button);
 
 	void DrawBackground();
+	void DrawCachedBackground();
+	void UpdateBackgroundLayer();
 	void DrawUnitIcons() const;
 	void DrawUnitRanges() const;
 	void DrawWorldStuff() const;
@@ -207,6 +209,7 @@ protected:
 
 	FBO fbo;
 	FBO fboResolve;
+	FBO fboBackground;
 
 	GL::RenderDataBuffer miniMap;
 
@@ -214,6 +217,12 @@ protected:
 	GLuint minimapTextureID = 0;
 	GLuint buttonsTextureID = 0;
 
+	// cached background layer; only re-rendered when its inputs change
+	GLuint backgroundTextureID = 0;
+
+	float bgLayerGamma = 0.0f;
+	bool bgLayerDirty = true;
+
 	struct MiniMapVertType {
 		float2 xy;
 		float2 tc;
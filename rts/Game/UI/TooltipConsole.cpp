@@ -154,7 +154,7 @@ std::string CTooltipConsole::MakeUnitString(const CUnit* unit)
 	if (effectiveDef->showPlayerName) {
 		s = team->GetControllerName();
 	} else {
-		s = unitToolTipMap.Get(unit->id);
+		s = unitToolTipMap.Get(unit);
 
 		if (decoyDef != nullptr)
 			s = decoyDef->humanName + " - " + decoyDef->tooltip;
@@ -254,8 +254,8 @@ void CUnitTracker::SetCam()
 
 		modPlanePos.y = std::max(modPlanePos.y, CGround::GetHeightReal(modPlanePos.x, modPlanePos.z, false) + (u->radius * 2.0f));
 
-		trackPos += (modPlanePos - trackPos) * (1 - math::pow(0.95f, deltaTime));
-		trackDir += (u->frontdir - trackDir) * (1 - math::pow(0.90f, deltaTime));
+		trackPos += (modPlanePos - trackPos) * (1 - std::pow(0.95f, deltaTime));
+		trackDir += (u->frontdir - trackDir) * (1 - std::pow(0.90f, deltaTime));
 		smoothedRight = mix<float3>(smoothedRight, mixRightDir, deltaTime * 0.05f).SafeANormalize();
 
 		const float3 wantedDir = (u->drawMidPos - camera->GetPos()).SafeANormalize();
@@ -0,0 +1,106 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "UnitAttributeTracker.h"
+
+#include "Sim/Units/Unit.h"
+#include "Sim/Units/UnitHandler.h"
+#include "Sim/Units/CommandAI/CommandAI.h"
+#include "System/EventHandler.h"
+
+UnitAttributeTracker unitAttrTracker;
+
+
+static std::uint32_t PackStateBits(const CUnit* unit)
+{
+	std::uint32_t bits = 0;
+
+	bits |= (unit->activated               << 0);
+	bits |= (unit->wantCloak               << 1);
+	bits |= (unit->isCloaked               << 2);
+	bits |= (unit->commandAI->repeatOrders << 3);
+	bits |= (unit->useHighTrajectory       << 4);
+	bits |= (unit->beingBuilt              << 5);
+	bits |= (unit->IsStunned()             << 6);
+	bits |= (unit->fireState               << 8);
+	bits |= (unit->moveState               << 16);
+
+	return bits;
+}
+
+
+void UnitAttributeTracker::Subscribe(int unitID, int attrMask)
+{
+	if (attrMask == 0) {
+		trackedUnits.erase(unitID);
+		return;
+	}
+
+	const CUnit* unit = unitHandler.GetUnit(unitID);
+
+	if (unit == nullptr)
+		return;
+
+	TrackedUnit& tu = trackedUnits[unitID];
+
+	tu.attrMask = attrMask;
+
+	// snapshot now, only changes after the subscription are reported
+	tu.health = unit->health;
+	tu.maxHealth = unit->maxHealth;
+	tu.buildProgress = unit->buildProgress;
+	tu.stateBits = PackStateBits(unit);
+}
+
+void UnitAttributeTracker::Update()
+{
+	if (trackedUnits.empty())
+		return;
+
+	changedUnitIDs.clear();
+	changedAttrMasks.clear();
+
+	for (auto it = trackedUnits.begin(); it != trackedUnits.end(); ) {
+		const CUnit* unit = unitHandler.GetUnit(it->first);
+
+		// dead units are dropped silently, scripts get UnitDestroyed anyway
+		if (unit == nullptr) {
+			it = trackedUnits.erase(it);
+			continue;
+		}
+
+		TrackedUnit& tu = it->second;
+
+		int changedMask = 0;
+
+		if ((tu.attrMask & ATTR_HEALTH) != 0) {
+			if (tu.health != unit->health || tu.maxHealth != unit->maxHealth || tu.buildProgress != unit->buildProgress) {
+				changedMask |= ATTR_HEALTH;
+
+				tu.health = unit->health;
+				tu.maxHealth = unit->maxHealth;
+				tu.buildProgress = unit->buildProgress;
+			}
+		}
+
+		if ((tu.attrMask & ATTR_STATES) != 0) {
+			const std::uint32_t stateBits = PackStateBits(unit);
+
+			if (tu.stateBits != stateBits) {
+				changedMask |= ATTR_STATES;
+				tu.stateBits = stateBits;
+			}
+		}
+
+		if (changedMask != 0) {
+			changedUnitIDs.push_back(it->first);
+			changedAttrMasks.push_back(changedMask);
+		}
+
+		++it;
+	}
+
+	if (changedUnitIDs.empty())
+		return;
+
+	eventHandler.UnitAttributesChanged(changedUnitIDs, changedAttrMasks);
+}
@@ -0,0 +1,52 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef UNIT_ATTRIBUTE_TRACKER_H
+#define UNIT_ATTRIBUTE_TRACKER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "System/UnorderedMap.hpp"
+
+/**
+ * @brief Change-tracking for unit attributes polled by Lua
+ *
+ * Scripts subscribe a set of units with an attribute mask and receive
+ * the (unsynced) UnitAttributesChanged call-in after each sim frame,
+ * listing only the units whose subscribed attributes actually changed.
+ * This replaces per-frame polling of every visible unit.
+ */
+class UnitAttributeTracker
+{
+public:
+	enum {
+		ATTR_HEALTH = (1 << 0), ///< health, maxHealth, buildProgress
+		ATTR_STATES = (1 << 1), ///< fire/move-state, repeat, cloak, active, trajectory, stunned
+	};
+
+	/// a zero mask unsubscribes the unit
+	void Subscribe(int unitID, int attrMask);
+	/// scan subscribed units and fire the call-in, runs after each sim frame
+	void Update();
+	void Clear() { trackedUnits.clear(); }
+
+private:
+	struct TrackedUnit {
+		int attrMask;
+
+		float health;
+		float maxHealth;
+		float buildProgress;
+
+		std::uint32_t stateBits;
+	};
+
+	spring::unordered_map<int, TrackedUnit> trackedUnits;
+
+	std::vector<int> changedUnitIDs;
+	std::vector<int> changedAttrMasks;
+};
+
+extern UnitAttributeTracker unitAttrTracker;
+
+#endif // UNIT_ATTRIBUTE_TRACKER_H
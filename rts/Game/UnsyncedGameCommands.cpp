@@ -80,11 +80,16 @@
 #include "Rendering/Map/InfoTexture/Modern/Path.h"
 #include "Rendering/Shaders/ShaderHandler.h"
 
+#include "Sim/Features/FeatureMemPool.h"
 #include "Sim/MoveTypes/MoveDefHandler.h"
 #include "Sim/Misc/TeamHandler.h"
 #include "Sim/Misc/ModInfo.h"
+#include "Sim/Path/Default/PathMemPool.h"
 #include "Sim/Projectiles/ProjectileHandler.h"
+#include "Sim/Projectiles/ProjectileMemPool.h"
 #include "Sim/Units/UnitDef.h"
+#include "Sim/Units/UnitMemPool.h"
+#include "Sim/Weapons/WeaponMemPool.h"
 #include "Sim/Units/UnitDefHandler.h"
 #include "Sim/Units/UnitHandler.h"
 #include "Sim/Units/CommandAI/CommandDescription.h"
@@ -3025,6 +3030,20 @@ public:
 };
 
 
+class DumpProfileTraceActionExecutor: public IUnsyncedActionExecutor {
+public:
+	DumpProfileTraceActionExecutor(): IUnsyncedActionExecutor("DumpProfileTrace", "dump buffered profiler scope-events to a flame-graph trace file") {
+	}
+
+	bool Execute(const UnsyncedAction& action) const final override {
+		const std::string& args = action.GetArgs();
+
+		profiler.DumpTraceFile(args.empty() ? "profile-trace.json" : args.c_str());
+		return true;
+	}
+};
+
+
 
 /// /save [-y ]<savename>
 class SaveActionExecutor : public IUnsyncedActionExecutor {
@@ -3085,7 +3104,7 @@ class DebugInfoActionExecutor : public IUnsyncedActionExecutor {
 public:
 	DebugInfoActionExecutor() : IUnsyncedActionExecutor(
 		"DebugInfo",
-		"Print debug info to the chat/log-file about either sound, profiling, or command-descriptions"
+		"Print debug info to the chat/log-file about either sound, profiling, command-descriptions, or memory pools"
 	) {
 	}
 
@@ -3102,8 +3121,26 @@ public:
 			case hashString("cmddescrs"): {
 				commandDescriptionCache.Dump(true);
 			} break;
+			case hashString("mempools"): {
+				const auto LogPoolStats = [](const char* tag, const SMemPoolStats& s) {
+					LOG(
+						"[DbgInfoAction] %-10s allocs=%u frees=%u fails=%u inUse=%u highWater=%u",
+						tag,
+						unsigned(s.numAllocs), unsigned(s.numFrees), unsigned(s.numFails),
+						unsigned(s.numInUse), unsigned(s.maxInUse)
+					);
+				};
+
+				LogPoolStats("units"     ,    unitMemPool.get_stats());
+				LogPoolStats("features"  , featureMemPool.get_stats());
+				LogPoolStats("projs"     ,    projMemPool.get_stats());
+				LogPoolStats("weapons"   ,  weaponMemPool.get_stats());
+				LogPoolStats("pathCaches",      pcMemPool.get_stats());
+				LogPoolStats("pathEstims",      peMemPool.get_stats());
+				LogPoolStats("pathFinder",      pfMemPool.get_stats());
+			} break;
 			default: {
-				LOG_L(L_WARNING, "[DbgInfoAction::%s] unknown argument \"%s\" (use \"sound\", \"profiling\", or \"cmddescrs\")", __func__, args.c_str());
+				LOG_L(L_WARNING, "[DbgInfoAction::%s] unknown argument \"%s\" (use \"sound\", \"profiling\", \"cmddescrs\", or \"mempools\")", __func__, args.c_str());
 			} break;
 		}
 
@@ -3461,6 +3498,7 @@ void UnsyncedGameCommands::AddDefaultActionExecutors()
 	AddActionExecutor(AllocActionExecutor<DestroyActionExecutor>());
 	AddActionExecutor(AllocActionExecutor<SendActionExecutor>());
 	AddActionExecutor(AllocActionExecutor<DumpStateActionExecutor>());
+	AddActionExecutor(AllocActionExecutor<DumpProfileTraceActionExecutor>());
 	AddActionExecutor(AllocActionExecutor<SaveActionExecutor>(true));
 	AddActionExecutor(AllocActionExecutor<SaveActionExecutor>(false));
 	AddActionExecutor(AllocActionExecutor<ReloadGameActionExecutor>());
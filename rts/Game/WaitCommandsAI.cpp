@@ -6,6 +6,7 @@
 #include "GameHelper.h"
 #include "GlobalUnsynced.h"
 #include "UI/CommandColors.h"
+#include "Rendering/GlobalRendering.h"
 #include "Rendering/LineDrawer.h"
 #include "Sim/Misc/QuadField.h"
 #include "Sim/Misc/GlobalConstants.h"
@@ -36,7 +37,8 @@ static const int updatePeriod = 3;  // in GAME_SPEED, 100 ms
 CR_BIND(CWaitCommandsAI, )
 CR_REG_METADATA(CWaitCommandsAI, (
 	CR_MEMBER(waitMap),
-	CR_MEMBER(unackedMap)
+	CR_MEMBER(unackedMap),
+	CR_IGNORED(wakeupHeap) // rebuilt by Wait::PostLoad
 ))
 
 CR_BIND_DERIVED_INTERFACE(CWaitCommandsAI::Wait, CObject)
@@ -45,6 +47,7 @@ CR_REG_METADATA_SUB(CWaitCommandsAI,Wait, (
 	CR_MEMBER(key),
 	CR_MEMBER(valid),
 	CR_MEMBER(deadTime),
+	CR_MEMBER(wakeupFrame),
 	CR_POSTLOAD(PostLoad)
 ))
 
@@ -61,7 +64,8 @@ CR_BIND_DERIVED(CWaitCommandsAI::DeathWait, CWaitCommandsAI::Wait, (Command()))
 CR_REG_METADATA_SUB(CWaitCommandsAI,DeathWait , (
 	CR_MEMBER(waitUnits),
 	CR_MEMBER(deathUnits),
-	CR_MEMBER(unitPos)
+	CR_MEMBER(unitPos),
+	CR_IGNORED(posDrawFrame)
 ))
 
 CR_BIND_DERIVED(CWaitCommandsAI::SquadWait, CWaitCommandsAI::Wait, (Command()))
@@ -107,19 +111,26 @@ void CWaitCommandsAI::Update()
 		return;
 	}
 
-	// update the waits
-	WaitMap::iterator it;
-	it = waitMap.begin();
-	while (it != waitMap.end()) {
-		// grab an incremented iterator in case the active iterator deletes itself
-		WaitMap::iterator tmp = it;
-		++tmp;
-		it->second->Update();
-		it = tmp;
+	// wake only the waits whose scheduled frame has come up; each wait
+	// either re-schedules itself (polling), sleeps until one of its event
+	// triggers re-schedules it, or deletes itself
+	while (!wakeupHeap.empty() && wakeupHeap.top().first <= gs->frameNum) {
+		const WakeupEntry entry = wakeupHeap.top();
+		wakeupHeap.pop();
+
+		WaitMap::iterator wit = waitMap.find(entry.second);
+
+		// drop lazily invalidated entries: the wait died, was never
+		// acknowledged, or has been re-scheduled since this was pushed
+		if (wit == waitMap.end() || wit->second->GetWakeupFrame() != entry.first)
+			continue;
+
+		wit->second->Update();
 	}
 
 	// delete old unacknowledged waits
 	const spring_time nowTime = spring_gettime();
+	WaitMap::iterator it;
 	it = unackedMap.begin();
 	while (it != unackedMap.end()) {
 		WaitMap::iterator tmp = it;
@@ -195,6 +206,7 @@ void CWaitCommandsAI::AcknowledgeCommand(const Command& cmd)
 		// move into the acknowledged pool
 		unackedMap.erase(key);
 		waitMap[key] = wait;
+		ScheduleWakeup(wait, gs->frameNum);
 	}
 }
 
@@ -236,6 +248,7 @@ void CWaitCommandsAI::AddLocalUnit(CUnit* unit, const CUnit* builder)
 					delete tw;
 				} else {
 					waitMap[tw->GetKey()] = tw;
+					ScheduleWakeup(tw, gs->frameNum);
 					// should not affect the sync state
 					const_cast<Command&>(cmd).SetParam(1, Wait::GetFloatFromKey(tw->GetKey()));
 				}
@@ -301,6 +314,14 @@ void CWaitCommandsAI::RemoveWaitObject(Wait* wait)
 }
 
 
+void CWaitCommandsAI::ScheduleWakeup(Wait* wait, int frame)
+{
+	// the old heap entry (if any) turns stale and gets dropped in Update
+	wait->SetWakeupFrame(frame);
+	wakeupHeap.emplace(frame, wait->GetKey());
+}
+
+
 void CWaitCommandsAI::AddIcon(const Command& cmd, const float3& pos) const
 {
 	if (cmd.GetNumParams() != 2) {
@@ -366,6 +387,8 @@ CWaitCommandsAI::KeyType CWaitCommandsAI::Wait::GetKeyFromFloat(float f)
 void CWaitCommandsAI::Wait::PostLoad()
 {
 	deadTime = spring_gettime() + spring_secs(maxNetDelay);
+	// wakeupHeap is not serialized, re-insert ourselves
+	waitCommandsAI.ScheduleWakeup(this, wakeupFrame);
 }
 
 // static
@@ -379,7 +402,8 @@ CWaitCommandsAI::Wait::Wait(float _code)
 	: code(_code),
 	key(0),
 	valid(false),
-	deadTime(spring_gettime() + spring_secs(maxNetDelay))
+	deadTime(spring_gettime() + spring_secs(maxNetDelay)),
+	wakeupFrame(0)
 {
 }
 
@@ -438,7 +462,13 @@ void CWaitCommandsAI::Wait::SendCommand(const Command& cmd, const CUnitSet& unit
 
 	const auto& selUnits = selectedUnitsHandler.selectedUnits;
 
-	if (unitSet == selUnits) {
+	bool sameSet = (unitSet.size() == selUnits.size());
+
+	for (auto it = selUnits.begin(); sameSet && it != selUnits.end(); ++it) {
+		sameSet = (unitSet.find(*it) != unitSet.end());
+	}
+
+	if (sameSet) {
 		selectedUnitsHandler.GiveCommand(cmd, false);
 		return;
 	}
@@ -547,6 +577,8 @@ CWaitCommandsAI::TimeWait::~TimeWait() = default; // do nothing
 void CWaitCommandsAI::TimeWait::DependentDied(CObject* object)
 {
 	unit = nullptr;
+	// let the next Update clean us up
+	waitCommandsAI.ScheduleWakeup(this, gs->frameNum + 1);
 }
 
 
@@ -578,6 +610,8 @@ void CWaitCommandsAI::TimeWait::Update()
 		if (!enabled) {
 			enabled = true;
 			endFrame = (gs->frameNum + duration);
+			// sleep in the heap until the timer runs out
+			waitCommandsAI.ScheduleWakeup(this, endFrame);
 			return;
 		}
 
@@ -590,18 +624,25 @@ void CWaitCommandsAI::TimeWait::Update()
 			}
 
 			enabled = false;
+			waitCommandsAI.ScheduleWakeup(this, gs->frameNum + updatePeriod);
+			return;
 		}
 
+		// woken up early (by an event), the timer is still running
+		waitCommandsAI.ScheduleWakeup(this, endFrame);
 		return;
 	}
-	if (state == Queued)
+	if (state == Queued) {
+		waitCommandsAI.ScheduleWakeup(this, gs->frameNum + updatePeriod);
 		return;
+	}
 
 	if (state == Missing) {
 		if (!factory) { // FIXME
 			delete this;
 			return;
 		}
+		waitCommandsAI.ScheduleWakeup(this, gs->frameNum + updatePeriod);
 	}
 }
 
@@ -645,6 +686,7 @@ CWaitCommandsAI::DeathWait*
 
 CWaitCommandsAI::DeathWait::DeathWait(const Command& cmd)
 : Wait(CMD_WAITCODE_DEATHWAIT)
+, posDrawFrame(0)
 {
 	const auto& selUnits = selectedUnitsHandler.selectedUnits;
 
@@ -656,7 +698,7 @@ CWaitCommandsAI::DeathWait::DeathWait(const Command& cmd)
 		if (unit == nullptr)
 			return;
 
-		if (selUnits.find(unitID) != selUnits.end())
+		if (selectedUnitsHandler.IsUnitSelected(unitID))
 			return;
 
 		deathUnits.insert(unitID);
@@ -669,7 +711,7 @@ CWaitCommandsAI::DeathWait::DeathWait(const Command& cmd)
 		SelectAreaUnits(pos0, pos1, tmpSet, false);
 
 		for (const int unitID: tmpSet) {
-			if (selUnits.find(unitID) == selUnits.end()) {
+			if (!selectedUnitsHandler.IsUnitSelected(unitID)) {
 				deathUnits.insert(unitID);
 			}
 		}
@@ -705,6 +747,8 @@ void CWaitCommandsAI::DeathWait::DependentDied(CObject* object)
 {
 	waitUnits.erase(static_cast<CUnit*>(object)->id);
 
+	waitCommandsAI.ScheduleWakeup(this, gs->frameNum + 1);
+
 	if (waitUnits.empty())
 		return;
 
@@ -716,13 +760,17 @@ void CWaitCommandsAI::DeathWait::AddUnit(CUnit* unit)
 {
 	if (waitUnits.insert(unit->id).second)
 		AddDeathDependence(unit, DEPENDENCE_WAITCMD);
+
+	waitCommandsAI.ScheduleWakeup(this, gs->frameNum + 1);
 }
 
 
 void CWaitCommandsAI::DeathWait::RemoveUnit(CUnit* unit)
 {
-	if (waitUnits.erase(unit->id))
+	if (waitUnits.erase(unit->id)) {
 		DeleteDeathDependence(unit, DEPENDENCE_WAITCMD);
+		waitCommandsAI.ScheduleWakeup(this, gs->frameNum + 1);
+	}
 }
 
 
@@ -733,10 +781,8 @@ void CWaitCommandsAI::DeathWait::Update()
 		return;
 	}
 
-	unitPos.clear();
-
 	if (!deathUnits.empty())
-		return; // more must die
+		return; // more must die, DependentDied re-schedules us
 
 	spring::unordered_set<int> unblockSet;
 	std::vector<int> voidWaitUnitIDs;
@@ -766,6 +812,10 @@ void CWaitCommandsAI::DeathWait::Update()
 		delete this;
 		return;
 	}
+
+	// some units still have the wait queued behind other commands,
+	// poll until they reach it
+	waitCommandsAI.ScheduleWakeup(this, gs->frameNum + updatePeriod);
 }
 
 
@@ -774,6 +824,11 @@ void CWaitCommandsAI::DeathWait::Draw() const
 	if (unitPos.empty())
 		return;
 
+	// only draw positions added this draw-frame (or the previous one,
+	// AddIcon and Draw order within a frame is not guaranteed)
+	if ((globalRendering->drawFrame - posDrawFrame) > 1)
+		return;
+
 	float3 midPos;
 	for (const auto& pos: unitPos) {
 		midPos += pos;
@@ -801,6 +856,13 @@ void CWaitCommandsAI::DeathWait::Draw() const
 
 void CWaitCommandsAI::DeathWait::AddUnitPosition(const float3& pos)
 {
+	// Update may leave us dormant for many frames now, flush the
+	// previous draw-frame's positions here instead of there
+	if (posDrawFrame != globalRendering->drawFrame) {
+		posDrawFrame = globalRendering->drawFrame;
+		unitPos.clear();
+	}
+
 	unitPos.push_back(pos);
 }
 
@@ -897,6 +959,8 @@ void CWaitCommandsAI::SquadWait::DependentDied(CObject* object)
 {
 	buildUnits.erase(static_cast<CUnit*>(object)->id);
 	waitUnits.erase(static_cast<CUnit*>(object)->id);
+
+	waitCommandsAI.ScheduleWakeup(this, gs->frameNum + 1);
 }
 
 
@@ -904,6 +968,9 @@ void CWaitCommandsAI::SquadWait::AddUnit(CUnit* unit)
 {
 	if (waitUnits.insert(unit->id).second)
 		AddDeathDependence(unit, DEPENDENCE_WAITCMD);
+
+	// a freshly built unit might complete the squad
+	waitCommandsAI.ScheduleWakeup(this, gs->frameNum + 1);
 }
 
 
@@ -913,6 +980,8 @@ void CWaitCommandsAI::SquadWait::RemoveUnit(CUnit* unit)
 		DeleteDeathDependence(unit, DEPENDENCE_WAITCMD);
 	if (waitUnits.erase(unit->id))
 		DeleteDeathDependence(unit, DEPENDENCE_WAITCMD);
+
+	waitCommandsAI.ScheduleWakeup(this, gs->frameNum + 1);
 }
 
 
@@ -924,7 +993,14 @@ void CWaitCommandsAI::SquadWait::Update()
 		return;
 	}
 
-	if ((int)waitUnits.size() >= squadCount) {
+	if ((int)waitUnits.size() < squadCount) {
+		// below strength, sleep until a death/finish event (AddUnit,
+		// RemoveUnit, DependentDied) re-schedules us
+		UpdateText();
+		return;
+	}
+
+	{
 		spring::unordered_set<int> unblockSet;
 		std::vector<int> voidWaitUnitIDs;
 
@@ -960,6 +1036,10 @@ void CWaitCommandsAI::SquadWait::Update()
 		}
 	}
 
+	// at (or above) strength but not enough units have reached their
+	// wait yet, poll since that generates no event
+	waitCommandsAI.ScheduleWakeup(this, gs->frameNum + updatePeriod);
+
 	UpdateText();
 	// FIXME -- clean builders
 }
@@ -1035,6 +1115,8 @@ CWaitCommandsAI::GatherWait::~GatherWait() = default; // do nothing
 void CWaitCommandsAI::GatherWait::DependentDied(CObject* object)
 {
 	waitUnits.erase(static_cast<CUnit*>(object)->id);
+
+	waitCommandsAI.ScheduleWakeup(this, gs->frameNum + 1);
 }
 
 
@@ -1046,8 +1128,10 @@ void CWaitCommandsAI::GatherWait::AddUnit(CUnit* unit)
 
 void CWaitCommandsAI::GatherWait::RemoveUnit(CUnit* unit)
 {
-	if (waitUnits.erase(unit->id))
+	if (waitUnits.erase(unit->id)) {
 		DeleteDeathDependence(unit, DEPENDENCE_WAITCMD);
+		waitCommandsAI.ScheduleWakeup(this, gs->frameNum + 1);
+	}
 }
 
 
@@ -1069,6 +1153,8 @@ void CWaitCommandsAI::GatherWait::Update()
 			for (const int unitID: voidWaitUnitIDs) {
 				waitUnits.erase(unitID);
 			}
+			// poll, units reach their waits without generating events
+			waitCommandsAI.ScheduleWakeup(this, gs->frameNum + updatePeriod);
 			return;
 		}
 		else if (state == Missing) {
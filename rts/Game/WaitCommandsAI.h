@@ -4,7 +4,9 @@
 #define WAIT_COMMANDS_AI_H
 
 #include <deque>
+#include <queue>
 #include <string>
+#include <vector>
 
 #include "System/Object.h"
 #include "System/Misc/SpringTime.h"
@@ -55,6 +57,7 @@ class CWaitCommandsAI {
 		class Wait;
 		bool InsertWaitObject(Wait* wait);
 		void RemoveWaitObject(Wait* wait);
+		void ScheduleWakeup(Wait* wait, int frame);
 
 	private:
 		typedef int KeyType;
@@ -62,6 +65,12 @@ class CWaitCommandsAI {
 		WaitMap waitMap;
 		WaitMap unackedMap;
 
+		// wakeup min-heap of (frame, key) pairs; entries are invalidated
+		// lazily, a wait's own wakeupFrame is authoritative so Update only
+		// touches the waits whose scheduled frame has come up
+		typedef std::pair<int, KeyType> WakeupEntry;
+		std::priority_queue<WakeupEntry, std::vector<WakeupEntry>, std::greater<WakeupEntry>> wakeupHeap;
+
 	private:
 		// Wait Base Class
 		class Wait : public CObject {
@@ -79,6 +88,8 @@ class CWaitCommandsAI {
 				spring_time GetDeadTime() const { return deadTime; }
 				float GetCode() const { return code; }
 				KeyType GetKey() const { return key; }
+				int GetWakeupFrame() const { return wakeupFrame; }
+				void SetWakeupFrame(int frame) { wakeupFrame = frame; }
 			public:
 				static KeyType GetKeyFromFloat(float f);
 				static float GetFloatFromKey(KeyType k);
@@ -97,6 +108,8 @@ class CWaitCommandsAI {
 				KeyType key;
 				bool valid;
 				spring_time deadTime;
+				/// frame at which Update is next due, see ScheduleWakeup
+				int wakeupFrame;
 			protected:
 				static KeyType GetNewKey();
 			private:
@@ -150,6 +163,7 @@ class CWaitCommandsAI {
 				CUnitSet waitUnits;
 				CUnitSet deathUnits;
 				std::vector<float3> unitPos;
+				unsigned int posDrawFrame;
 		};
 
 		// SquadWait
@@ -0,0 +1,148 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "LuaBytecodeCache.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include "LuaInclude.h"
+
+#include "System/MainDefines.h"
+#include "System/Config/ConfigHandler.h"
+#include "System/FileSystem/DataDirsAccess.h"
+#include "System/FileSystem/FileQueryFlags.h"
+#include "System/FileSystem/FileSystem.h"
+#include "System/Sync/HsiehHash.h"
+#include "System/Threading/SpringThreading.h"
+
+CONFIG(bool, LuaBytecodeCache)
+	.defaultValue(true)
+	.description("Cache compiled Lua chunks (def files, gadget and widget sources) on disk so later game starts can skip the Lua parser.");
+
+
+// empty while the cache is disabled or cannot be located yet
+static std::string bcCacheDir;
+static bool bcCacheDirInited = false;
+
+// LuaParser::Execute can be called concurrently by the game-load and
+// (e.g.) assimp model preloading threads; guards dir-init and writes
+static spring::mutex bcCacheMutex;
+
+
+static const std::string& GetBytecodeCacheDir()
+{
+	std::lock_guard<spring::mutex> lock(bcCacheMutex);
+
+	if (bcCacheDirInited)
+		return bcCacheDir;
+
+	bcCacheDirInited = true;
+
+	// parsers can run before the config-handler exists (e.g. in unitsync
+	// prior to initialization), just pass sources through in that case
+	if (configHandler == nullptr || !configHandler->GetBool("LuaBytecodeCache"))
+		return bcCacheDir;
+
+	bcCacheDir = dataDirsAccess.LocateDir(FileSystem::EnsurePathSepAtEnd(FileSystem::GetCacheDir()) + "lua", FileQueryFlags::WRITE | FileQueryFlags::CREATE_DIRS);
+	FileSystem::EnsurePathSepAtEnd(bcCacheDir);
+	return bcCacheDir;
+}
+
+
+static bool ReadCacheEntry(const std::string& path, std::string& data)
+{
+	FILE* file = ::fopen(path.c_str(), "rb");
+
+	if (file == nullptr)
+		return false;
+
+	::fseek(file, 0, SEEK_END);
+	const long size = ::ftell(file);
+	::fseek(file, 0, SEEK_SET);
+
+	bool read = false;
+
+	if (size > 0) {
+		data.resize(size);
+		read = (::fread(&data[0], 1, size, file) == size_t(size));
+	}
+
+	::fclose(file);
+	return read;
+}
+
+static void WriteCacheEntry(const std::string& path, const std::string& data)
+{
+	// two threads compiling the same chunk write identical bytes, but
+	// must not interleave; write to a temp file under the mutex and
+	// atomically move it into place
+	std::lock_guard<spring::mutex> lock(bcCacheMutex);
+
+	const std::string tmpPath = path + ".tmp";
+
+	FILE* file = ::fopen(tmpPath.c_str(), "wb");
+
+	if (file == nullptr)
+		return;
+
+	const bool written = (::fwrite(data.data(), 1, data.size(), file) == data.size());
+
+	::fclose(file);
+
+	if (written) {
+		::rename(tmpPath.c_str(), path.c_str());
+	} else {
+		::remove(tmpPath.c_str());
+	}
+}
+
+
+static int AppendDumpWriter(lua_State* L, const void* chunk, size_t size, void* data)
+{
+	static_cast<std::string*>(data)->append(static_cast<const char*>(chunk), size);
+	return 0;
+}
+
+
+int LuaBytecodeCache::LoadBuffer(lua_State* L, const std::string& code, const std::string& label)
+{
+	const std::string& cacheDir = GetBytecodeCacheDir();
+
+	if (cacheDir.empty())
+		return luaL_loadbuffer(L, code.c_str(), code.size(), label.c_str());
+
+	// the label (chunk name) participates since lua_dump embeds it in
+	// the debug info; identical sources included under different names
+	// should not share an entry
+	const uint32_t codeHash = HsiehHash(code.data(), code.size(), 0);
+	const uint32_t nameHash = HsiehHash(label.data(), label.size(), codeHash);
+
+	char entryName[64];
+	SNPRINTF(entryName, sizeof(entryName), "%08x%08x.luac", codeHash, nameHash);
+
+	const std::string entryPath = cacheDir + entryName;
+
+	std::string dump;
+
+	if (ReadCacheEntry(entryPath, dump) && dump.size() > sizeof(LUA_SIGNATURE) && std::memcmp(dump.data(), LUA_SIGNATURE, sizeof(LUA_SIGNATURE) - 1) == 0) {
+		if (luaL_loadbuffer(L, dump.data(), dump.size(), label.c_str()) == 0)
+			return 0;
+
+		// written by another engine version or truncated; lundump
+		// rejected it, drop the entry and recompile from source
+		lua_pop(L, 1);
+		::remove(entryPath.c_str());
+	}
+
+	const int error = luaL_loadbuffer(L, code.c_str(), code.size(), label.c_str());
+
+	if (error != 0)
+		return error;
+
+	dump.clear();
+
+	if (lua_dump(L, AppendDumpWriter, &dump) == 0 && !dump.empty())
+		WriteCacheEntry(entryPath, dump);
+
+	return 0;
+}
@@ -0,0 +1,26 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef LUA_BYTECODE_CACHE_H
+#define LUA_BYTECODE_CACHE_H
+
+#include <string>
+
+struct lua_State;
+
+/**
+ * On-disk cache of precompiled Lua chunks, keyed by a hash of chunk
+ * name and source text. Every game start compiles the same def files
+ * and gadget/widget sources out of the VFS anew; keeping the lua_dump
+ * output around in the cache dir lets later starts skip the parser
+ * entirely. Entries written by an older engine (the bytecode format
+ * is not stable across Lua upgrades) fail lundump's header check and
+ * fall back to a plain source compile, which then refreshes them.
+ */
+class LuaBytecodeCache {
+	public:
+		// drop-in replacement for luaL_loadbuffer, returns the same codes
+		// and like it leaves either the chunk or an error message on top
+		static int LoadBuffer(lua_State* L, const std::string& code, const std::string& label);
+};
+
+#endif /* LUA_BYTECODE_CACHE_H */
@@ -6,6 +6,7 @@
 #include "LuaRules.h"
 #include "LuaUI.h"
 
+#include "LuaBytecodeCache.h"
 #include "LuaCallInCheck.h"
 #include "LuaConfig.h"
 #include "LuaHashString.h"
@@ -108,6 +109,13 @@ CLuaHandle::CLuaHandle(const string& _name, int _order, bool _userMode, bool _sy
 	D.gcCtrl.baseMemLoadMult = configHandler->GetFloat("LuaGarbageCollectionMemLoadMult");
 	D.gcCtrl.baseRunTimeMult = configHandler->GetFloat("LuaGarbageCollectionRunTimeMult");
 
+	// unsynced handles are collected on the same schedule as the synced
+	// ones but get a smaller per-loop budget by default, such that e.g.
+	// LuaUI can never monopolize the frame; still Lua-overridable via
+	// Spring.GarbageCollectCtrl
+	if (!_synced)
+		D.gcCtrl.maxLoopRunTime *= 0.25f;
+
 	L = LUA_OPEN(&D);
 	L_GC = lua_newthread(L);
 
@@ -449,7 +457,7 @@ bool CLuaHandle::LoadCode(lua_State* L, const string& code, const string& debug)
 
 	const LuaUtils::ScopedDebugTraceBack traceBack(L);
 
-	const int error = luaL_loadbuffer(L, code.c_str(), code.size(), debug.c_str());
+	const int error = LuaBytecodeCache::LoadBuffer(L, code, debug);
 
 	if (error != 0) {
 		LOG_L(L_ERROR, "[%s::%s] error=%i (%s) debug=%s msg=%s", name.c_str(), __func__, error, LuaErrorString(error), debug.c_str(), lua_tostring(L, -1));
@@ -549,9 +557,39 @@ bool CLuaHandle::HasCallIn(lua_State* L, const string& name) const
 }
 
 
+// resolves a callin handler, preferring the registry copy made by
+// UpdateCallInCache over a probe of the globals table
+static inline bool PushCallInFunc(lua_State* L, const LuaHashString& hs)
+{
+	return (hs.GetRegistryFunc(L) || hs.GetGlobalFunc(L));
+}
+
+// keeps a copy of the handler function in the registry, from where the
+// high-frequency callins resolve it without probing the (mod-sized)
+// globals table; WantsEvent and UpdateCallIn are the only registration
+// paths so the copy stays current for scripts that swap handlers the
+// sanctioned way, while a reload builds a fresh state and with it a
+// fresh set of copies
+bool CLuaHandle::UpdateCallInCache(lua_State* L, const string& name)
+{
+	const bool found = HasCallIn(L, name);
+
+	lua_pushsstring(L, name);
+
+	if (found) {
+		lua_pushsstring(L, name);
+		lua_rawget(L, LUA_GLOBALSINDEX);
+	} else {
+		lua_pushnil(L);
+	}
+
+	lua_rawset(L, LUA_REGISTRYINDEX);
+	return found;
+}
+
 bool CLuaHandle::UpdateCallIn(lua_State* L, const string& name)
 {
-	if (HasCallIn(L, name)) {
+	if (UpdateCallInCache(L, name)) {
 		eventHandler.InsertEvent(this, name);
 	} else {
 		eventHandler.RemoveEvent(this, name);
@@ -648,7 +686,7 @@ void CLuaHandle::GameFrame(int frameNum)
 
 	static const LuaHashString cmdStr(__func__);
 
-	if (!cmdStr.GetGlobalFunc(L))
+	if (!PushCallInFunc(L, cmdStr))
 		return;
 
 	lua_pushnumber(L, frameNum);
@@ -664,7 +702,7 @@ void CLuaHandle::GameID(const unsigned char* gameID, unsigned int numBytes)
 	luaL_checkstack(L, 4, __func__);
 	const LuaUtils::ScopedDebugTraceBack traceBack(L);
 
-	const LuaHashString cmdStr(__func__);
+	static const LuaHashString cmdStr(__func__);
 	if (!cmdStr.GetGlobalFunc(L))
 		return;
 
@@ -797,7 +835,7 @@ inline void CLuaHandle::UnitCallIn(const LuaHashString& hs, const CUnit* unit)
 	luaL_checkstack(L, 6, __func__);
 	const LuaUtils::ScopedDebugTraceBack traceBack(L);
 
-	if (!hs.GetGlobalFunc(L))
+	if (!PushCallInFunc(L, hs))
 		return;
 
 	lua_pushnumber(L, unit->id);
@@ -1269,7 +1307,7 @@ bool CLuaHandle::UnitUnitCollision(const CUnit* collider, const CUnit* collidee)
 	static const LuaHashString cmdStr(__func__);
 	const LuaUtils::ScopedDebugTraceBack traceBack(L);
 
-	if (!cmdStr.GetGlobalFunc(L))
+	if (!PushCallInFunc(L, cmdStr))
 		return false;
 
 	lua_pushnumber(L, collider->id);
@@ -1301,7 +1339,7 @@ bool CLuaHandle::UnitFeatureCollision(const CUnit* collider, const CFeature* col
 	static const LuaHashString cmdStr(__func__);
 	const LuaUtils::ScopedDebugTraceBack traceBack(L);
 
-	if (!cmdStr.GetGlobalFunc(L))
+	if (!PushCallInFunc(L, cmdStr))
 		return false;
 
 	lua_pushnumber(L, collider->id);
@@ -1673,6 +1711,33 @@ void CLuaHandle::Save(zipFile archive)
 }
 
 
+void CLuaHandle::UnitAttributesChanged(const std::vector<int>& unitIDs, const std::vector<int>& attrMasks)
+{
+	LUA_CALL_IN_CHECK(L);
+	luaL_checkstack(L, 5, __func__);
+	static const LuaHashString cmdStr(__func__);
+	if (!cmdStr.GetGlobalFunc(L))
+		return;
+
+	lua_createtable(L, unitIDs.size(), 0);
+
+	for (size_t i = 0; i < unitIDs.size(); i++) {
+		lua_pushnumber(L, unitIDs[i]);
+		lua_rawseti(L, -2, i + 1);
+	}
+
+	lua_createtable(L, attrMasks.size(), 0);
+
+	for (size_t i = 0; i < attrMasks.size(); i++) {
+		lua_pushnumber(L, attrMasks[i]);
+		lua_rawseti(L, -2, i + 1);
+	}
+
+	// call the routine
+	RunCallIn(L, cmdStr, 2, 0);
+}
+
+
 void CLuaHandle::UnsyncedHeightMapUpdate(const SRectangle& rect)
 {
 	LUA_CALL_IN_CHECK(L);
@@ -1696,7 +1761,7 @@ void CLuaHandle::Update()
 	LUA_CALL_IN_CHECK(L);
 	luaL_checkstack(L, 2, __func__);
 	static const LuaHashString cmdStr(__func__);
-	if (!cmdStr.GetGlobalFunc(L))
+	if (!PushCallInFunc(L, cmdStr))
 		return;
 
 	// call the routine
@@ -1800,7 +1865,7 @@ void CLuaHandle::RunDrawCallIn(const LuaHashString& hs)
 {
 	LUA_CALL_IN_CHECK(L);
 	luaL_checkstack(L, 2, __func__);
-	if (!hs.GetGlobalFunc(L))
+	if (!PushCallInFunc(L, hs))
 		return;
 
 	LuaOpenGL::SetDrawingEnabled(L, true);
@@ -1840,7 +1905,7 @@ DRAW_CALLIN(DrawFeaturesPostDeferred)
 
 inline void CLuaHandle::DrawScreenCommon(const LuaHashString& cmdStr)
 {
-	if (!cmdStr.GetGlobalFunc(L))
+	if (!PushCallInFunc(L, cmdStr))
 		return;
 
 	lua_pushnumber(L, globalRendering->viewSizeX);
@@ -1888,7 +1953,7 @@ void CLuaHandle::DrawInMiniMap()
 	LUA_CALL_IN_CHECK(L);
 	luaL_checkstack(L, 4, __func__);
 	static const LuaHashString cmdStr(__func__);
-	if (!cmdStr.GetGlobalFunc(L))
+	if (!PushCallInFunc(L, cmdStr))
 		return;
 
 	lua_pushnumber(L, minimap->GetSizeX());
@@ -1909,7 +1974,7 @@ void CLuaHandle::DrawInMiniMapBackground()
 	LUA_CALL_IN_CHECK(L);
 	luaL_checkstack(L, 4, __func__);
 	static const LuaHashString cmdStr(__func__);
-	if (!cmdStr.GetGlobalFunc(L))
+	if (!PushCallInFunc(L, cmdStr))
 		return;
 
 	lua_pushnumber(L, minimap->GetSizeX());
@@ -2531,7 +2596,10 @@ void CLuaHandle::CollectGarbage(bool forced)
 	const float gcMemLoadMult = D.gcCtrl.baseMemLoadMult;
 	const float gcRunTimeMult = D.gcCtrl.baseRunTimeMult;
 
-	if (!forced && spring_lua_alloc_skip_gc(gcMemLoadMult))
+	// skip-probability is weighted by this handle's own heap size; a
+	// widget hoarding memory should not raise the collection rate (or
+	// the frame-time cost) of the synced states and vice versa
+	if (!forced && spring_lua_alloc_skip_gc(&D.allocState, gcMemLoadMult))
 		return;
 
 	LUA_CALL_IN_CHECK_NAMED(L, (GetLuaContextData(L)->synced)? "Lua::CollectGarbage::Synced": "Lua::CollectGarbage::Unsynced");
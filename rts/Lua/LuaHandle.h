@@ -96,9 +96,10 @@ class CLuaHandle : public CEventClient
 #endif
 
 	public: // call-ins
-		bool WantsEvent(const std::string& name) override { return HasCallIn(L, name); }
+		bool WantsEvent(const std::string& name) override { return UpdateCallInCache(L, name); }
 		virtual bool HasCallIn(lua_State* L, const std::string& name) const;
 		virtual bool UpdateCallIn(lua_State* L, const std::string& name);
+		bool UpdateCallInCache(lua_State* L, const std::string& name);
 
 		void Load(IArchive* archive) override;
 
@@ -184,6 +185,7 @@ class CLuaHandle : public CEventClient
 		void Save(zipFile archive) override;
 
 		void UnsyncedHeightMapUpdate(const SRectangle& rect) override;
+		void UnitAttributesChanged(const std::vector<int>& unitIDs, const std::vector<int>& attrMasks) override;
 		void Update() override;
 
 		bool KeyPress(int key, bool isRepeat) override;
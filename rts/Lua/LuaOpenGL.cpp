@@ -5,6 +5,8 @@
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <cstring> // memcpy
+#include <deque>
 
 #include "LuaOpenGL.h"
 
@@ -187,8 +189,12 @@ void LuaOpenGL::Init()
 	RevertScreenMatrices();
 }
 
+static void FreeAsyncPixelsRequests();
+
 void LuaOpenGL::Free()
 {
+	FreeAsyncPixelsRequests();
+
 	for (GL::RenderDataBufferL& wb: luaRenderBuffers) {
 		GL::RenderDataBuffer* rb = wb.GetBuffer();
 
@@ -350,6 +356,8 @@ bool LuaOpenGL::PushEntries(lua_State* L)
 	REGISTER_LUA_CFUNC(Finish);
 
 	REGISTER_LUA_CFUNC(ReadPixels);
+	REGISTER_LUA_CFUNC(ReadPixelsAsync);
+	REGISTER_LUA_CFUNC(ReadPixelsResult);
 	REGISTER_LUA_CFUNC(SaveImage);
 
 	REGISTER_LUA_CFUNC(CreateQuery);
@@ -2860,14 +2868,26 @@ int LuaOpenGL::RenderVertexArray(lua_State* L)
 
 	const unsigned int dataIndx = luaL_optint(L, 3,       0);
 	const unsigned int dataSize = luaL_optint(L, 4, 1 << 20); // arbitrary
+	const unsigned int numInsts = luaL_optint(L, 5,       0);
 
 	const unsigned int numElems = rb->GetNumElems<VA_TYPE_L>();
 	const unsigned int numIndcs = rb->GetNumIndcs<uint32_t>();
 
+	// with numInsts > 0 the array is drawn instanced; the bound shader
+	// distinguishes copies by gl_InstanceID (e.g. indexing a transform
+	// uniform), one call then redraws any number of identical meshes
 	if (numIndcs > 0) {
-		rb->SubmitIndexed(primType, dataIndx, std::min(dataSize, numIndcs));
+		if (numInsts > 0) {
+			rb->SubmitIndexedInstanced(primType, dataIndx, std::min(dataSize, numIndcs), numInsts);
+		} else {
+			rb->SubmitIndexed(primType, dataIndx, std::min(dataSize, numIndcs));
+		}
 	} else {
-		rb->Submit(primType, dataIndx, std::min(dataSize, numElems));
+		if (numInsts > 0) {
+			rb->SubmitInstanced(primType, dataIndx, std::min(dataSize, numElems), numInsts);
+		} else {
+			rb->Submit(primType, dataIndx, std::min(dataSize, numElems));
+		}
 	}
 
 	if (rb->IsPinned())
@@ -3314,25 +3334,8 @@ static void PushPixelData(lua_State* L, int fSize, const float*& data)
 }
 
 
-int LuaOpenGL::ReadPixels(lua_State* L)
+static int PushReadPixelsResult(lua_State* L, const float* data, int w, int h, int fSize)
 {
-	const GLint x = luaL_checkint(L, 1);
-	const GLint y = luaL_checkint(L, 2);
-	const GLint w = luaL_checkint(L, 3);
-	const GLint h = luaL_checkint(L, 4);
-	const GLenum format = luaL_optint(L, 5, GL_RGBA);
-	if ((w <= 0) || (h <= 0))
-		return 0;
-
-	int fSize = PixelFormatSize(format);
-	if (fSize < 0)
-		fSize = 4; // good enough?
-
-	CBitmap bmp;
-	bmp.Alloc(w, h, fSize * sizeof(float));
-	glReadPixels(x, y, w, h, format, GL_FLOAT, reinterpret_cast<float*>(bmp.GetRawMem()));
-
-	const float* data = reinterpret_cast<const float*>(bmp.GetRawMem());
 	const float* d = data;
 
 	if ((w == 1) && (h == 1)) {
@@ -3383,6 +3386,144 @@ int LuaOpenGL::ReadPixels(lua_State* L)
 }
 
 
+int LuaOpenGL::ReadPixels(lua_State* L)
+{
+	const GLint x = luaL_checkint(L, 1);
+	const GLint y = luaL_checkint(L, 2);
+	const GLint w = luaL_checkint(L, 3);
+	const GLint h = luaL_checkint(L, 4);
+	const GLenum format = luaL_optint(L, 5, GL_RGBA);
+	if ((w <= 0) || (h <= 0))
+		return 0;
+
+	int fSize = PixelFormatSize(format);
+	if (fSize < 0)
+		fSize = 4; // good enough?
+
+	CBitmap bmp;
+	bmp.Alloc(w, h, fSize * sizeof(float));
+	glReadPixels(x, y, w, h, format, GL_FLOAT, reinterpret_cast<float*>(bmp.GetRawMem()));
+
+	return PushReadPixelsResult(L, reinterpret_cast<const float*>(bmp.GetRawMem()), w, h, fSize);
+}
+
+
+// readbacks whose transfer is still in flight on the GPU; same
+// request -> fence -> poll scheme as the screenshot queue
+struct AsyncPixelsRequest {
+	VBO pbo{GL_PIXEL_PACK_BUFFER};
+	GLsync fence = 0;
+
+	uint32_t reqID = 0;
+
+	int w = 0;
+	int h = 0;
+	int fSize = 0;
+};
+
+static std::deque<AsyncPixelsRequest> asyncPixelsRequests;
+static uint32_t asyncPixelsRequestID = 0;
+
+
+static void FreeAsyncPixelsRequests()
+{
+	for (AsyncPixelsRequest& req: asyncPixelsRequests) {
+		#ifndef HEADLESS
+		glDeleteSync(req.fence);
+		#endif
+		req.pbo.Release();
+	}
+
+	asyncPixelsRequests.clear();
+}
+
+
+int LuaOpenGL::ReadPixelsAsync(lua_State* L)
+{
+	const GLint x = luaL_checkint(L, 1);
+	const GLint y = luaL_checkint(L, 2);
+	const GLint w = luaL_checkint(L, 3);
+	const GLint h = luaL_checkint(L, 4);
+	const GLenum format = luaL_optint(L, 5, GL_RGBA);
+	if ((w <= 0) || (h <= 0))
+		return 0;
+
+	int fSize = PixelFormatSize(format);
+	if (fSize < 0)
+		fSize = 4; // good enough?
+
+	asyncPixelsRequests.emplace_back();
+	AsyncPixelsRequest& req = asyncPixelsRequests.back();
+
+	req.reqID = ++asyncPixelsRequestID;
+	req.w = w;
+	req.h = h;
+	req.fSize = fSize;
+
+	// read back into a PACK buffer; this returns without draining the
+	// pipeline, the fence tells ReadPixelsResult when the transfer has
+	// actually finished
+	req.pbo.Bind(GL_PIXEL_PACK_BUFFER);
+	req.pbo.New(w * h * fSize * sizeof(float), GL_STREAM_READ);
+	glReadPixels(x, y, w, h, format, GL_FLOAT, nullptr);
+	req.pbo.Unbind();
+
+	#ifndef HEADLESS
+	req.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	#endif
+
+	lua_pushnumber(L, req.reqID);
+	return 1;
+}
+
+
+int LuaOpenGL::ReadPixelsResult(lua_State* L)
+{
+	const uint32_t reqID = (uint32_t)luaL_checkint(L, 1);
+
+	const auto pred = [&](const AsyncPixelsRequest& req) { return (req.reqID == reqID); };
+	const auto iter = std::find_if(asyncPixelsRequests.begin(), asyncPixelsRequests.end(), pred);
+
+	// unknown (or already delivered) request, returns nil
+	if (iter == asyncPixelsRequests.end())
+		return 0;
+
+	AsyncPixelsRequest& req = *iter;
+
+	#ifndef HEADLESS
+	// transfer still in flight, poll again next frame
+	if (glClientWaitSync(req.fence, 0, 0) == GL_TIMEOUT_EXPIRED) {
+		lua_pushboolean(L, false);
+		return 1;
+	}
+
+	glDeleteSync(req.fence);
+	#endif
+
+	std::vector<float> pixels(req.w * req.h * req.fSize, 0.0f);
+
+	req.pbo.Bind(GL_PIXEL_PACK_BUFFER);
+	// plain READ_BIT; the GL_READ_ONLY conversion adds the (here
+	// illegal) unsynchronized flag
+	const GLubyte* mem = req.pbo.MapBuffer(0, pixels.size() * sizeof(float), GL_MAP_READ_BIT);
+
+	if (mem != nullptr)
+		std::memcpy(pixels.data(), mem, pixels.size() * sizeof(float));
+
+	req.pbo.UnmapBuffer();
+	req.pbo.Unbind();
+	req.pbo.Release();
+
+	const int w = req.w;
+	const int h = req.h;
+	const int fSize = req.fSize;
+
+	asyncPixelsRequests.erase(iter);
+
+	return PushReadPixelsResult(L, pixels.data(), w, h, fSize);
+}
+
+
 int LuaOpenGL::SaveImage(lua_State* L)
 {
 	const GLint x = (GLint)luaL_checknumber(L, 1);
@@ -278,6 +278,8 @@ class LuaOpenGL {
 		static int Finish(lua_State* L);
 
 		static int ReadPixels(lua_State* L);
+		static int ReadPixelsAsync(lua_State* L);
+		static int ReadPixelsResult(lua_State* L);
 		static int SaveImage(lua_State* L);
 
 		// occlusion queries
@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <climits>
+#include <cstring>
 
 #include "lib/streflop/streflop_cond.h"
 
@@ -12,6 +13,7 @@
 #include "System/float4.h"
 #include "LuaInclude.h"
 
+#include "LuaBytecodeCache.h"
 #include "LuaConstGame.h"
 #include "LuaConstEngine.h"
 #include "LuaIO.h"
@@ -233,7 +235,8 @@ bool LuaParser::Execute()
 	char errorBuf[4096] = {0};
 	int errorNum = 0;
 
-	if ((errorNum = luaL_loadbuffer(L, code.c_str(), code.size(), codeLabel.c_str())) != 0) {
+	// only chunks read from the VFS go through the bytecode cache
+	if ((errorNum = (textChunk.empty())? LuaBytecodeCache::LoadBuffer(L, code, codeLabel): luaL_loadbuffer(L, code.c_str(), code.size(), codeLabel.c_str())) != 0) {
 		SNPRINTF(errorBuf, sizeof(errorBuf), "[loadbuf] error %d (\"%s\") in %s", errorNum, lua_tostring(L, -1), codeLabel.c_str());
 		LUA_CLOSE(&L);
 
@@ -288,6 +291,216 @@ bool LuaParser::Execute()
 }
 
 
+/******************************************************************************/
+//
+//  root-table snapshots
+//
+
+namespace {
+	enum: uint8_t {
+		DUMP_TAG_BOOLEAN = 0,
+		DUMP_TAG_NUMBER  = 1,
+		DUMP_TAG_STRING  = 2,
+		DUMP_TAG_TABLE   = 3,
+	};
+
+	constexpr uint32_t DUMP_MAGIC = 0x4C504430; // "LPD0"
+	constexpr uint8_t DUMP_VERSION = 1;
+	constexpr int DUMP_MAX_DEPTH = 64;
+
+	template<typename T> void DumpRaw(std::string& data, const T& val)
+	{
+		data.append(reinterpret_cast<const char*>(&val), sizeof(T));
+	}
+
+	template<typename T> bool LoadRaw(const std::string& data, size_t& pos, T& val)
+	{
+		if ((pos + sizeof(T)) > data.size())
+			return false;
+
+		memcpy(&val, data.data() + pos, sizeof(T));
+		pos += sizeof(T);
+		return true;
+	}
+
+	bool DumpLuaValue(lua_State* L, int idx, std::string& data, int depth)
+	{
+		// tables in defs never nest this deep, assume a cycle
+		if (depth > DUMP_MAX_DEPTH)
+			return false;
+
+		switch (lua_type(L, idx)) {
+			case LUA_TBOOLEAN: {
+				DumpRaw(data, uint8_t(DUMP_TAG_BOOLEAN));
+				DumpRaw(data, uint8_t(lua_toboolean(L, idx)));
+			} break;
+			case LUA_TNUMBER: {
+				DumpRaw(data, uint8_t(DUMP_TAG_NUMBER));
+				DumpRaw(data, lua_tonumber(L, idx));
+			} break;
+			case LUA_TSTRING: {
+				size_t len = 0;
+				const char* str = lua_tolstring(L, idx, &len);
+
+				DumpRaw(data, uint8_t(DUMP_TAG_STRING));
+				DumpRaw(data, uint32_t(len));
+				data.append(str, len);
+			} break;
+			case LUA_TTABLE: {
+				DumpRaw(data, uint8_t(DUMP_TAG_TABLE));
+
+				// pair-count is only known after the walk, patch it in
+				const size_t countPos = data.size();
+				uint32_t numPairs = 0;
+
+				DumpRaw(data, numPairs);
+
+				if (!lua_checkstack(L, 3))
+					return false;
+
+				const int table = (idx > 0)? idx : (lua_gettop(L) + idx + 1);
+
+				for (lua_pushnil(L); lua_next(L, table) != 0; lua_pop(L, 1)) {
+					if (!DumpLuaValue(L, -2, data, depth + 1) || !DumpLuaValue(L, -1, data, depth + 1)) {
+						lua_pop(L, 2);
+						return false;
+					}
+
+					numPairs++;
+				}
+
+				memcpy(&data[countPos], &numPairs, sizeof(numPairs));
+			} break;
+			default: {
+				// functions, userdata, etc. can not be snapshotted
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool LoadLuaValue(lua_State* L, const std::string& data, size_t& pos, int depth)
+	{
+		uint8_t tag = 0;
+
+		if (depth > DUMP_MAX_DEPTH || !LoadRaw(data, pos, tag) || !lua_checkstack(L, 3))
+			return false;
+
+		switch (tag) {
+			case DUMP_TAG_BOOLEAN: {
+				uint8_t val = 0;
+
+				if (!LoadRaw(data, pos, val))
+					return false;
+
+				lua_pushboolean(L, val);
+			} break;
+			case DUMP_TAG_NUMBER: {
+				lua_Number val = 0;
+
+				if (!LoadRaw(data, pos, val))
+					return false;
+
+				lua_pushnumber(L, val);
+			} break;
+			case DUMP_TAG_STRING: {
+				uint32_t len = 0;
+
+				if (!LoadRaw(data, pos, len) || (pos + len) > data.size())
+					return false;
+
+				lua_pushlstring(L, data.data() + pos, len);
+				pos += len;
+			} break;
+			case DUMP_TAG_TABLE: {
+				uint32_t numPairs = 0;
+
+				if (!LoadRaw(data, pos, numPairs))
+					return false;
+
+				lua_createtable(L, 0, numPairs);
+
+				for (uint32_t i = 0; i < numPairs; i++) {
+					if (!LoadLuaValue(L, data, pos, depth + 1)) {
+						lua_pop(L, 1);
+						return false;
+					}
+					if (!LoadLuaValue(L, data, pos, depth + 1)) {
+						lua_pop(L, 2);
+						return false;
+					}
+
+					lua_rawset(L, -3);
+				}
+			} break;
+			default: {
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+
+bool LuaParser::DumpRoot(std::string& data)
+{
+	if (!IsValid() || rootRef == LUA_NOREF)
+		return false;
+
+	data.clear();
+
+	DumpRaw(data, DUMP_MAGIC);
+	DumpRaw(data, DUMP_VERSION);
+	DumpRaw(data, uint8_t(sizeof(lua_Number)));
+
+	lua_rawgeti(L, LUA_REGISTRYINDEX, rootRef);
+
+	const bool success = DumpLuaValue(L, -1, data, 0);
+
+	lua_pop(L, 1);
+	return success;
+}
+
+bool LuaParser::LoadDump(const std::string& data)
+{
+	if (!IsValid())
+		return false;
+
+	assert(rootRef == LUA_NOREF);
+	assert(initDepth == 0);
+
+	uint32_t magic = 0;
+	uint8_t version = 0;
+	uint8_t numberSize = 0;
+
+	size_t pos = 0;
+
+	if (!LoadRaw(data, pos, magic) || magic != DUMP_MAGIC)
+		return false;
+	if (!LoadRaw(data, pos, version) || version != DUMP_VERSION)
+		return false;
+	// snapshots do not transfer between builds with different lua_Number's
+	if (!LoadRaw(data, pos, numberSize) || numberSize != sizeof(lua_Number))
+		return false;
+
+	if (!LoadLuaValue(L, data, pos, 0) || !lua_istable(L, -1)) {
+		// leave the parser executable on a broken snapshot
+		lua_settop(L, 0);
+		return false;
+	}
+
+	initDepth = -1;
+	rootRef = luaL_ref(L, LUA_REGISTRYINDEX);
+	lua_settop(L, 0);
+
+	return (valid = true);
+}
+
+
+/******************************************************************************/
+
 void LuaParser::AddTable(LuaTable* tbl) { spring::VectorInsertUnique(tables, tbl); }
 void LuaParser::RemoveTable(LuaTable* tbl) { spring::VectorErase(tables, tbl); }
 
@@ -597,7 +810,7 @@ int LuaParser::Include(lua_State* L)
  		lua_error(L);
 	}
 
-	int error = luaL_loadbuffer(L, code.c_str(), code.size(), filename.c_str());
+	int error = LuaBytecodeCache::LoadBuffer(L, code, filename);
 	if (error != 0) {
 		char buf[1024];
 		SNPRINTF(buf, sizeof(buf), "error = %i, %s, %s\n", error, filename.c_str(), lua_tostring(L, -1));
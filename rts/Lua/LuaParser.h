@@ -135,6 +135,12 @@ public:
 	bool IsValid() const { return (L != nullptr); } // true if nothing failed during Execute
 	bool NoTable() const { return (errorLog.find("no return table") == 0); } // parser is still valid if true
 
+	/// serializes the root table into a binary blob; fails if it holds
+	/// values (functions, userdata, ...) that can not be snapshotted
+	bool DumpRoot(std::string& data);
+	/// restores a root table serialized by DumpRoot in place of Execute
+	bool LoadDump(const std::string& data);
+
 	LuaTable GetRoot();
 	LuaTable SubTableExpr(const std::string& expr) {
 		return GetRoot().SubTableExpr(expr);
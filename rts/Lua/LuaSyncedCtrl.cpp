@@ -45,6 +45,7 @@
 #include "Sim/Misc/QuadField.h"
 #include "Sim/Misc/Wind.h"
 #include "Sim/MoveTypes/AAirMoveType.h"
+#include "Sim/MoveTypes/MoveMath/MoveMath.h"
 #include "Sim/Path/IPathManager.h"
 #include "Sim/Projectiles/ExplosionGenerator.h"
 #include "Sim/Projectiles/Projectile.h"
@@ -167,7 +168,9 @@ bool LuaSyncedCtrl::PushEntries(lua_State* L)
 	REGISTER_LUA_CFUNC(SetUnitResourcing);
 	REGISTER_LUA_CFUNC(SetUnitTooltip);
 	REGISTER_LUA_CFUNC(SetUnitHealth);
+	REGISTER_LUA_CFUNC(SetUnitHealthArray);
 	REGISTER_LUA_CFUNC(SetUnitMaxHealth);
+	REGISTER_LUA_CFUNC(SetUnitMaxHealthArray);
 	REGISTER_LUA_CFUNC(SetUnitStockpile);
 	REGISTER_LUA_CFUNC(SetUnitUseWeapons);
 	REGISTER_LUA_CFUNC(SetUnitWeaponState);
@@ -211,6 +214,7 @@ bool LuaSyncedCtrl::PushEntries(lua_State* L)
 	REGISTER_LUA_CFUNC(SetUnitPhysics);
 	REGISTER_LUA_CFUNC(SetUnitMass);
 	REGISTER_LUA_CFUNC(SetUnitPosition);
+	REGISTER_LUA_CFUNC(SetUnitPositionArray);
 	REGISTER_LUA_CFUNC(SetUnitVelocity);
 	REGISTER_LUA_CFUNC(SetUnitRotation);
 	REGISTER_LUA_CFUNC(SetUnitDirection);
@@ -320,6 +324,7 @@ bool LuaSyncedCtrl::PushEntries(lua_State* L)
 	REGISTER_LUA_CFUNC(DeleteProjectile);
 	REGISTER_LUA_CFUNC(SpawnExplosion);
 	REGISTER_LUA_CFUNC(SpawnCEG);
+	REGISTER_LUA_CFUNC(SpawnCEGArray);
 	REGISTER_LUA_CFUNC(SpawnSFX);
 
 	REGISTER_LUA_CFUNC(EditUnitCmdDesc);
@@ -394,6 +399,62 @@ static inline CProjectile* ParseProjectile(lua_State* L, const char* caller, int
 	return p;
 }
 
+
+// parses a unitID array plus either a parallel value array (same length,
+// validated up front) or a single number shared by the whole batch; pairs
+// whose unit can not be controlled are skipped, the rest are returned in
+// array order so every client applies them in the same sequence
+static void ParseUnitValueArrays(
+	lua_State* L,
+	const char* caller,
+	int idTableIdx,
+	int valTableIdx,
+	std::vector<CUnit*>& units,
+	std::vector<float>& values
+) {
+	if (!lua_istable(L, idTableIdx))
+		luaL_error(L, "%s(): expected an array of unitIDs", caller);
+
+	const int numIDs = lua_objlen(L, idTableIdx);
+	const bool sharedValue = lua_isnumber(L, valTableIdx);
+
+	if (!sharedValue) {
+		if (!lua_istable(L, valTableIdx))
+			luaL_error(L, "%s(): expected a value or an array of values", caller);
+
+		if (int(lua_objlen(L, valTableIdx)) != numIDs)
+			luaL_error(L, "%s(): unitID and value arrays differ in length", caller);
+	}
+
+	units.reserve(numIDs);
+	values.reserve(numIDs);
+
+	for (int i = 1; i <= numIDs; i++) {
+		lua_rawgeti(L, idTableIdx, i);
+
+		CUnit* unit = lua_isnumber(L, -1)? ParseUnit(L, caller, -1): nullptr;
+		lua_pop(L, 1);
+
+		if (unit == nullptr)
+			continue;
+
+		if (sharedValue) {
+			units.push_back(unit);
+			values.push_back(lua_tofloat(L, valTableIdx));
+			continue;
+		}
+
+		lua_rawgeti(L, valTableIdx, i);
+
+		if (lua_isnumber(L, -1)) {
+			units.push_back(unit);
+			values.push_back(lua_tofloat(L, -1));
+		}
+
+		lua_pop(L, 1);
+	}
+}
+
 static bool ParseProjectileParams(lua_State* L, ProjectileParams& params, const int tblIdx, const char* caller)
 {
 	if (!lua_istable(L, tblIdx)) {
@@ -1579,6 +1640,24 @@ int LuaSyncedCtrl::SetUnitHealth(lua_State* L)
 }
 
 
+// bulk variant of SetUnitHealth; only covers the plain health value
+// since that is what gadgets retuning many units per frame hammer,
+// the key-table extras (capture/paralyze/build) stay per-unit calls
+int LuaSyncedCtrl::SetUnitHealthArray(lua_State* L)
+{
+	std::vector<CUnit*> units;
+	std::vector<float> values;
+
+	ParseUnitValueArrays(L, __func__, 1, 2, units, values);
+
+	for (size_t i = 0; i < units.size(); i++) {
+		units[i]->health = std::min(units[i]->maxHealth, values[i]);
+	}
+
+	return 0;
+}
+
+
 int LuaSyncedCtrl::SetUnitMaxHealth(lua_State* L)
 {
 	CUnit* unit = ParseUnit(L, __func__, 1);
@@ -1592,6 +1671,24 @@ int LuaSyncedCtrl::SetUnitMaxHealth(lua_State* L)
 }
 
 
+int LuaSyncedCtrl::SetUnitMaxHealthArray(lua_State* L)
+{
+	std::vector<CUnit*> units;
+	std::vector<float> values;
+
+	ParseUnitValueArrays(L, __func__, 1, 2, units, values);
+
+	for (size_t i = 0; i < units.size(); i++) {
+		CUnit* unit = units[i];
+
+		unit->maxHealth = std::max(0.1f, values[i]);
+		unit->health = std::min(unit->maxHealth, unit->health);
+	}
+
+	return 0;
+}
+
+
 int LuaSyncedCtrl::SetUnitStockpile(lua_State* L)
 {
 	CUnit* unit = ParseUnit(L, __func__, 1);
@@ -2652,6 +2749,62 @@ int LuaSyncedCtrl::SetUnitPosition(lua_State* L)
 }
 
 
+// bulk variant of SetUnitPosition; takes a unitID array plus a flat
+// coordinate array holding either {x1,z1, x2,z2, ...} (heights snapped
+// to the ground as above) or {x1,y1,z1, x2,y2,z2, ...}
+int LuaSyncedCtrl::SetUnitPositionArray(lua_State* L)
+{
+	constexpr int idTableIdx = 1;
+	constexpr int posTableIdx = 2;
+
+	if (!lua_istable(L, idTableIdx) || !lua_istable(L, posTableIdx))
+		luaL_error(L, "%s(): expected parallel unitID and position arrays", __func__);
+
+	const int numIDs = lua_objlen(L, idTableIdx);
+	const int numCoords = lua_objlen(L, posTableIdx);
+
+	const bool hasHeights = (numCoords == (numIDs * 3));
+
+	if (!hasHeights && numCoords != (numIDs * 2))
+		luaL_error(L, "%s(): position array must hold two or three coordinates per unitID", __func__);
+
+	const bool aboveWater = luaL_optboolean(L, 3, false);
+
+	for (int i = 0; i < numIDs; i++) {
+		lua_rawgeti(L, idTableIdx, i + 1);
+
+		CUnit* unit = lua_isnumber(L, -1)? ParseUnit(L, __func__, -1): nullptr;
+		lua_pop(L, 1);
+
+		if (unit == nullptr)
+			continue;
+
+		float3 pos;
+
+		if (hasHeights) {
+			lua_rawgeti(L, posTableIdx, i * 3 + 1);
+			lua_rawgeti(L, posTableIdx, i * 3 + 2);
+			lua_rawgeti(L, posTableIdx, i * 3 + 3);
+
+			pos = {lua_tofloat(L, -3), lua_tofloat(L, -2), lua_tofloat(L, -1)};
+			lua_pop(L, 3);
+		} else {
+			lua_rawgeti(L, posTableIdx, i * 2 + 1);
+			lua_rawgeti(L, posTableIdx, i * 2 + 2);
+
+			pos.x = lua_tofloat(L, -2);
+			pos.z = lua_tofloat(L, -1);
+			pos.y = aboveWater? CGround::GetHeightAboveWater(pos.x, pos.z): CGround::GetHeightReal(pos.x, pos.z);
+			lua_pop(L, 2);
+		}
+
+		unit->ForcedMove(pos);
+	}
+
+	return 0;
+}
+
+
 int LuaSyncedCtrl::SetUnitRotation(lua_State* L)
 {
 	return (SetSolidObjectRotation(L, ParseUnit(L, __func__, 1), false));
@@ -4178,6 +4331,7 @@ int LuaSyncedCtrl::SetMapSquareTerrainType(lua_State* L)
 	const int ntt = luaL_checkint(L, 3);
 
 	readMap->GetTypeMapSynced()[tz * mapDims.hmapx + tx] = std::max(0, std::min(ntt, (CMapInfo::NUM_TERRAIN_TYPES - 1)));
+	CMoveMath::TerrainChange(hx, hz,  hx + 1, hz + 1);
 	pathManager->TerrainChange(hx, hz,  hx + 1, hz + 1,  TERRAINCHANGE_SQUARE_TYPEMAP_INDEX);
 
 	lua_pushnumber(L, ott);
@@ -4598,6 +4752,47 @@ int LuaSyncedCtrl::SpawnCEG(lua_State* L)
 	return 2;
 }
 
+// bulk variant of SpawnCEG; resolves the generator once and fires it at
+// every {x,y,z} triple of a flat position array, direction and scaling
+// parameters are shared by the whole batch
+int LuaSyncedCtrl::SpawnCEGArray(lua_State* L)
+{
+	const unsigned int cegID = lua_isstring(L, 1)? explGenHandler.LoadCustomGeneratorID(lua_tostring(L, 1)): luaL_checkint(L, 1);
+
+	constexpr int posTableIdx = 2;
+
+	if (!lua_istable(L, posTableIdx))
+		luaL_error(L, "%s(): expected an array of {x,y,z} position triples", __func__);
+
+	const int numCoords = lua_objlen(L, posTableIdx);
+
+	if ((numCoords % 3) != 0)
+		luaL_error(L, "%s(): position array length must be a multiple of three", __func__);
+
+	const float3 dir = {luaL_optfloat(L, 3, 0.0f), luaL_optfloat(L, 4, 0.0f), luaL_optfloat(L, 5, 0.0f)};
+
+	const float radius = luaL_optfloat(L, 6, 0.0f);
+	const float damage = luaL_optfloat(L, 7, 0.0f);
+	const float dmgMod = luaL_optfloat(L, 8, 1.0f);
+
+	unsigned int count = 0;
+
+	for (int i = 0; i < numCoords; i += 3) {
+		lua_rawgeti(L, posTableIdx, i + 1);
+		lua_rawgeti(L, posTableIdx, i + 2);
+		lua_rawgeti(L, posTableIdx, i + 3);
+
+		const float3 pos = {lua_tofloat(L, -3), lua_tofloat(L, -2), lua_tofloat(L, -1)};
+		lua_pop(L, 3);
+
+		count += explGenHandler.GenExplosion(cegID, pos, dir, damage, radius, dmgMod, nullptr, nullptr);
+	}
+
+	lua_pushnumber(L, count);
+	lua_pushnumber(L, cegID);
+	return 2;
+}
+
 int LuaSyncedCtrl::SpawnSFX(lua_State* L)
 {
 	CUnit* unit = ParseUnit(L, __func__, 1);
@@ -61,7 +61,9 @@ class LuaSyncedCtrl
 		static int SetUnitCosts(lua_State* L);
 		static int SetUnitTooltip(lua_State* L);
 		static int SetUnitHealth(lua_State* L);
+		static int SetUnitHealthArray(lua_State* L);
 		static int SetUnitMaxHealth(lua_State* L);
+		static int SetUnitMaxHealthArray(lua_State* L);
 		static int SetUnitStockpile(lua_State* L);
 		static int SetUnitUseWeapons(lua_State* L);
 		static int SetUnitWeaponState(lua_State* L);
@@ -105,6 +107,7 @@ class LuaSyncedCtrl
 		static int SetUnitPhysics(lua_State* L);
 		static int SetUnitMass(lua_State* L);
 		static int SetUnitPosition(lua_State* L);
+		static int SetUnitPositionArray(lua_State* L);
 		static int SetUnitRotation(lua_State* L);
 		static int SetUnitDirection(lua_State* L);
 		static int SetUnitVelocity(lua_State* L);
@@ -199,6 +202,7 @@ class LuaSyncedCtrl
 		static int DeleteProjectile(lua_State* L);
 		static int SpawnExplosion(lua_State* L);
 		static int SpawnCEG(lua_State* L);
+		static int SpawnCEGArray(lua_State* L);
 		static int SpawnSFX(lua_State* L);
 
 		// LuaRules  (fullCtrl)
@@ -209,11 +209,13 @@ bool LuaSyncedRead::PushEntries(lua_State* L)
 	REGISTER_LUA_CFUNC(GetUnitMass);
 	REGISTER_LUA_CFUNC(GetUnitPosition);
 	REGISTER_LUA_CFUNC(GetUnitBasePosition);
+	REGISTER_LUA_CFUNC(GetUnitArrayPositions);
 	REGISTER_LUA_CFUNC(GetUnitVectors);
 	REGISTER_LUA_CFUNC(GetUnitRotation);
 	REGISTER_LUA_CFUNC(GetUnitDirection);
 	REGISTER_LUA_CFUNC(GetUnitHeading);
 	REGISTER_LUA_CFUNC(GetUnitVelocity);
+	REGISTER_LUA_CFUNC(GetUnitArrayVelocities);
 	REGISTER_LUA_CFUNC(GetUnitBuildFacing);
 	REGISTER_LUA_CFUNC(GetUnitIsBuilding);
 	REGISTER_LUA_CFUNC(GetUnitCurrentBuildPower);
@@ -2917,7 +2919,7 @@ int LuaSyncedRead::GetUnitTooltip(lua_State* L)
 		}
 	} else {
 		if (decoyDef == nullptr) {
-			tooltip = unitToolTipMap.Get(unit->id);
+			tooltip = unitToolTipMap.Get(unit);
 		} else {
 			tooltip = decoyDef->humanName + " - " + decoyDef->tooltip;
 		}
@@ -3109,6 +3111,61 @@ int LuaSyncedRead::GetUnitBasePosition(lua_State* L)
 	return (GetUnitPosition(L));
 }
 
+int LuaSyncedRead::GetUnitArrayPositions(lua_State* L)
+{
+	// batched variant of GetUnitPosition; takes an array of unitID's and
+	// returns their base positions as a flat array {x1,y1,z1, x2,y2,z2, ...}
+	// so per-frame callers iterating thousands of units pay the Lua call
+	// and argument-checking overhead once instead of per unit
+	//
+	// an existing table can be passed as second argument and is then
+	// filled and returned instead of allocating a new one; the triplet
+	// of an invalid or invisible unitID is set to false
+	if (!lua_istable(L, 1))
+		luaL_error(L, "[%s] unitIDs (arg #1) not a table", __func__);
+
+	const int numUnitIDs = lua_objlen(L, 1);
+
+	if (lua_istable(L, 2)) {
+		lua_pushvalue(L, 2);
+	} else {
+		lua_createtable(L, numUnitIDs * 3, 0);
+	}
+
+	const int outTableIdx = lua_gettop(L);
+	const int readAllyTeam = CLuaHandle::GetHandleReadAllyTeam(L);
+	const bool fullRead = CLuaHandle::GetHandleFullRead(L);
+
+	for (int i = 1; i <= numUnitIDs; i++) {
+		lua_rawgeti(L, 1, i);
+
+		const CUnit* unit = lua_isnumber(L, -1)? unitHandler.GetUnit(lua_toint(L, -1)): nullptr;
+
+		lua_pop(L, 1);
+
+		if (unit != nullptr && !IsUnitVisible(L, unit))
+			unit = nullptr;
+
+		if (unit == nullptr) {
+			lua_pushboolean(L, false); lua_rawseti(L, outTableIdx, i * 3 - 2);
+			lua_pushboolean(L, false); lua_rawseti(L, outTableIdx, i * 3 - 1);
+			lua_pushboolean(L, false); lua_rawseti(L, outTableIdx, i * 3    );
+			continue;
+		}
+
+		float3 pos = unit->pos;
+
+		if (!IsAllyUnit(L, unit))
+			pos += unit->GetLuaErrorVector(readAllyTeam, fullRead);
+
+		lua_pushnumber(L, pos.x); lua_rawseti(L, outTableIdx, i * 3 - 2);
+		lua_pushnumber(L, pos.y); lua_rawseti(L, outTableIdx, i * 3 - 1);
+		lua_pushnumber(L, pos.z); lua_rawseti(L, outTableIdx, i * 3    );
+	}
+
+	return 1;
+}
+
 int LuaSyncedRead::GetUnitVectors(lua_State* L)
 {
 	const CUnit* unit = ParseInLosUnit(L, __func__, 1);
@@ -3164,6 +3221,51 @@ int LuaSyncedRead::GetUnitVelocity(lua_State* L)
 	return (GetWorldObjectVelocity(L, ParseInLosUnit(L, __func__, 1)));
 }
 
+int LuaSyncedRead::GetUnitArrayVelocities(lua_State* L)
+{
+	// batched variant of GetUnitVelocity, see GetUnitArrayPositions; the
+	// output is a flat array of {vx,vy,vz,|v|} quadruplets, with all four
+	// components of an invalid or radar-invisible unitID set to false
+	if (!lua_istable(L, 1))
+		luaL_error(L, "[%s] unitIDs (arg #1) not a table", __func__);
+
+	const int numUnitIDs = lua_objlen(L, 1);
+
+	if (lua_istable(L, 2)) {
+		lua_pushvalue(L, 2);
+	} else {
+		lua_createtable(L, numUnitIDs * 4, 0);
+	}
+
+	const int outTableIdx = lua_gettop(L);
+
+	for (int i = 1; i <= numUnitIDs; i++) {
+		lua_rawgeti(L, 1, i);
+
+		const CUnit* unit = lua_isnumber(L, -1)? unitHandler.GetUnit(lua_toint(L, -1)): nullptr;
+
+		lua_pop(L, 1);
+
+		if (unit != nullptr && !IsUnitInLos(L, unit))
+			unit = nullptr;
+
+		if (unit == nullptr) {
+			lua_pushboolean(L, false); lua_rawseti(L, outTableIdx, i * 4 - 3);
+			lua_pushboolean(L, false); lua_rawseti(L, outTableIdx, i * 4 - 2);
+			lua_pushboolean(L, false); lua_rawseti(L, outTableIdx, i * 4 - 1);
+			lua_pushboolean(L, false); lua_rawseti(L, outTableIdx, i * 4    );
+			continue;
+		}
+
+		lua_pushnumber(L, unit->speed.x); lua_rawseti(L, outTableIdx, i * 4 - 3);
+		lua_pushnumber(L, unit->speed.y); lua_rawseti(L, outTableIdx, i * 4 - 2);
+		lua_pushnumber(L, unit->speed.z); lua_rawseti(L, outTableIdx, i * 4 - 1);
+		lua_pushnumber(L, unit->speed.w); lua_rawseti(L, outTableIdx, i * 4    );
+	}
+
+	return 1;
+}
+
 
 int LuaSyncedRead::GetUnitBuildFacing(lua_State* L)
 {
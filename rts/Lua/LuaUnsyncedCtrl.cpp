@@ -21,6 +21,7 @@
 #include "Game/GlobalUnsynced.h"
 #include "Game/IVideoCapturing.h"
 #include "Game/SelectedUnitsHandler.h"
+#include "Game/UnitAttributeTracker.h"
 #include "Game/Players/Player.h"
 #include "Game/Players/PlayerHandler.h"
 #include "Game/InMapDraw.h"
@@ -168,6 +169,7 @@ bool LuaUnsyncedCtrl::PushEntries(lua_State* L)
 	REGISTER_LUA_CFUNC(SetMapShadingTexture);
 	REGISTER_LUA_CFUNC(SetSkyBoxTexture);
 
+	REGISTER_LUA_CFUNC(SubscribeUnitAttributes);
 	REGISTER_LUA_CFUNC(SetUnitNoDraw);
 	REGISTER_LUA_CFUNC(SetUnitNoMinimap);
 	REGISTER_LUA_CFUNC(SetUnitNoSelect);
@@ -1664,6 +1666,32 @@ int LuaUnsyncedCtrl::SetSkyBoxTexture(lua_State* L)
 
 /******************************************************************************/
 
+int LuaUnsyncedCtrl::SubscribeUnitAttributes(lua_State* L)
+{
+	// register a unit (or an array of units) for the UnitAttributesChanged
+	// call-in; mask bits are UnitAttributeTracker::ATTR_* (1 = health and
+	// build progress, 2 = binary and fire/move states), 0 unsubscribes
+	const int attrMask = luaL_checkint(L, 2);
+
+	if (lua_isnumber(L, 1)) {
+		unitAttrTracker.Subscribe(lua_toint(L, 1), attrMask);
+		return 0;
+	}
+
+	if (!lua_istable(L, 1))
+		luaL_error(L, "[%s] unitIDs (arg #1) not a number or table", __func__);
+
+	for (lua_pushnil(L); lua_next(L, 1) != 0; lua_pop(L, 1)) {
+		if (!lua_isnumber(L, -1))
+			continue;
+
+		unitAttrTracker.Subscribe(lua_toint(L, -1), attrMask);
+	}
+
+	return 0;
+}
+
+
 int LuaUnsyncedCtrl::SetUnitNoDraw(lua_State* L)
 {
 	CUnit* unit = ParseCtrlUnit(L, __func__, 1);
@@ -1699,9 +1727,7 @@ int LuaUnsyncedCtrl::SetUnitNoSelect(lua_State* L)
 
 	// deselect the unit if it's selected and shouldn't be
 	if (unit->noSelect) {
-		const auto& selUnits = selectedUnitsHandler.selectedUnits;
-
-		if (selUnits.find(unit->id) != selUnits.end()) {
+		if (selectedUnitsHandler.IsUnitSelected(unit)) {
 			selectedUnitsHandler.RemoveUnit(unit);
 		}
 	}
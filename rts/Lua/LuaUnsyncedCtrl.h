@@ -72,6 +72,7 @@ class LuaUnsyncedCtrl {
 		static int SetMapShadingTexture(lua_State* L);
 		static int SetSkyBoxTexture(lua_State* L);
 
+		static int SubscribeUnitAttributes(lua_State* L);
 		static int SetUnitNoDraw(lua_State* L);
 		static int SetUnitNoMinimap(lua_State* L);
 		static int SetUnitNoSelect(lua_State* L);
@@ -44,6 +44,11 @@
 #include "Sim/Features/Feature.h"
 #include "Sim/Features/FeatureDef.h"
 #include "Sim/Features/FeatureHandler.h"
+#include "Sim/Features/FeatureMemPool.h"
+#include "Sim/Path/Default/PathMemPool.h"
+#include "Sim/Projectiles/ProjectileMemPool.h"
+#include "Sim/Units/UnitMemPool.h"
+#include "Sim/Weapons/WeaponMemPool.h"
 #include "Sim/Misc/LosHandler.h"
 #include "Sim/Misc/ModInfo.h"
 #include "Sim/Misc/TeamHandler.h"
@@ -94,6 +99,7 @@ bool LuaUnsyncedRead::PushEntries(lua_State* L)
 
 	REGISTER_LUA_CFUNC(GetLuaMemUsage);
 	REGISTER_LUA_CFUNC(GetVidMemUsage);
+	REGISTER_LUA_CFUNC(GetMemPoolStats);
 
 	REGISTER_LUA_CFUNC(GetDrawFrame);
 	REGISTER_LUA_CFUNC(GetFrameTimeOffset);
@@ -455,6 +461,32 @@ int LuaUnsyncedRead::GetVidMemUsage(lua_State* L)
 }
 
 
+static void PushNamedPoolStats(lua_State* L, const char* tag, const SMemPoolStats& s)
+{
+	lua_pushstring(L, tag);
+	lua_createtable(L, 0, 5);
+	LuaPushNamedNumber(L, "allocs"   , s.numAllocs);
+	LuaPushNamedNumber(L, "frees"    , s.numFrees);
+	LuaPushNamedNumber(L, "fails"    , s.numFails);
+	LuaPushNamedNumber(L, "inUse"    , s.numInUse);
+	LuaPushNamedNumber(L, "highWater", s.maxInUse);
+	lua_rawset(L, -3);
+}
+
+int LuaUnsyncedRead::GetMemPoolStats(lua_State* L)
+{
+	lua_createtable(L, 0, 7);
+	PushNamedPoolStats(L, "units"     ,    unitMemPool.get_stats());
+	PushNamedPoolStats(L, "features"  , featureMemPool.get_stats());
+	PushNamedPoolStats(L, "projs"     ,    projMemPool.get_stats());
+	PushNamedPoolStats(L, "weapons"   ,  weaponMemPool.get_stats());
+	PushNamedPoolStats(L, "pathCaches",      pcMemPool.get_stats());
+	PushNamedPoolStats(L, "pathEstims",      peMemPool.get_stats());
+	PushNamedPoolStats(L, "pathFinder",      pfMemPool.get_stats());
+	return 1;
+}
+
+
 /******************************************************************************/
 
 int LuaUnsyncedRead::GetViewGeometry(lua_State* L)
@@ -685,8 +717,7 @@ int LuaUnsyncedRead::IsUnitSelected(lua_State* L)
 	if (unit == nullptr)
 		return 0;
 
-	const auto& selUnits = selectedUnitsHandler.selectedUnits;
-	lua_pushboolean(L, selUnits.find(unit->id) != selUnits.end());
+	lua_pushboolean(L, selectedUnitsHandler.IsUnitSelected(unit));
 	return 1;
 }
 
@@ -24,6 +24,7 @@ class LuaUnsyncedRead {
 
 		static int GetLuaMemUsage(lua_State* L);
 		static int GetVidMemUsage(lua_State* L);
+		static int GetMemPoolStats(lua_State* L);
 
 		static int GetDrawFrame(lua_State* L);
 		static int GetFrameTimeOffset(lua_State* L);
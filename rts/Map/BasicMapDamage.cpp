@@ -8,6 +8,8 @@
 #include "Sim/Misc/GroundBlockingObjectMap.h"
 #include "Sim/Misc/LosHandler.h"
 #include "Sim/Misc/QuadField.h"
+#include "Sim/Misc/SmoothHeightMesh.h"
+#include "Sim/MoveTypes/MoveMath/MoveMath.h"
 #include "Sim/Units/Unit.h"
 #include "Sim/Units/UnitHandler.h"
 #include "Sim/Path/IPathManager.h"
@@ -73,6 +75,7 @@ void CBasicMapDamage::TerrainTypeSpeedModChanged(int ttIndex)
 			if (typeMap[tz * mapDims.hmapx + tx] != ttIndex)
 				continue;
 
+			CMoveMath::TerrainChange((tx << 1), (tz << 1),  (tx << 1) + 1, (tz << 1) + 1);
 			pathManager->TerrainChange((tx << 1), (tz << 1),  (tx << 1) + 1, (tz << 1) + 1,  TERRAINCHANGE_TYPEMAP_SPEED_VALUES);
 		}
 	}
@@ -216,12 +219,15 @@ void CBasicMapDamage::RecalcArea(int x1, int x2, int y1, int y2)
 {
 	readMap->UpdateHeightMapSynced(SRectangle(x1, y1, x2, y2));
 	featureHandler.TerrainChanged(x1, y1, x2, y2);
+	smoothGround.MapChanged(x1, y1, x2, y2);
 	{
 		SCOPED_TIMER("Sim::BasicMapDamage::Los");
 		losHandler->UpdateHeightMapSynced(SRectangle(x1, y1, x2, y2));
 	}
 	{
 		SCOPED_TIMER("Sim::BasicMapDamage::Path");
+		// speed-mod caches must be patched before the PFS re-reads them
+		CMoveMath::TerrainChange(x1, y1, x2, y2);
 		pathManager->TerrainChange(x1, y1, x2, y2, TERRAINCHANGE_DAMAGE_RECALCULATION);
 	}
 }
@@ -266,9 +272,40 @@ void CBasicMapDamage::Update()
 		if (e.ttl != 0)
 			continue;
 
-		RecalcArea(e.x1 - 1, e.x2 + 1, e.y1 - 1, e.y2 + 1);
+		recalcAreaQueue.emplace_back(e.x1 - 1, e.y1 - 1, e.x2 + 1, e.y2 + 1);
 	}
 
+	// craters from a volley usually overlap; merge their rectangles and
+	// run the readmap/LOS/PFS updates once per merged region rather than
+	// once per explosion
+	for (size_t i = 0; i < recalcAreaQueue.size(); i++) {
+		for (size_t j = i + 1; j < recalcAreaQueue.size(); ) {
+			SRectangle& a = recalcAreaQueue[i];
+			const SRectangle& b = recalcAreaQueue[j];
+
+			if (a.x1 > b.x2 || a.x2 < b.x1 || a.z1 > b.z2 || a.z2 < b.z1) {
+				j++;
+				continue;
+			}
+
+			a.x1 = std::min(a.x1, b.x1);
+			a.z1 = std::min(a.z1, b.z1);
+			a.x2 = std::max(a.x2, b.x2);
+			a.z2 = std::max(a.z2, b.z2);
+
+			recalcAreaQueue[j] = recalcAreaQueue.back();
+			recalcAreaQueue.pop_back();
+			// grown rectangle can overlap entries checked before j
+			j = i + 1;
+		}
+	}
+
+	for (const SRectangle& r: recalcAreaQueue) {
+		RecalcArea(r.x1, r.x2, r.z1, r.z2);
+	}
+
+	recalcAreaQueue.clear();
+
 
 	// pop explosions that are no longer being processed
 	while (explUpdateQueueIdx < explosionUpdateQueue.size()) {
@@ -4,6 +4,7 @@
 #define _BASIC_MAP_DAMAGE_H
 
 #include "MapDamage.h"
+#include "System/Rectangle.h"
 
 #include <vector>
 
@@ -61,6 +62,10 @@ private:
 	std::vector<float> explosionSquaresPool;
 	std::vector<Explo> explosionUpdateQueue;
 
+	// dirty rectangles of explosions expiring this Update; overlapping
+	// entries are merged so each area is only recalculated once
+	std::vector<SRectangle> recalcAreaQueue;
+
 	static constexpr unsigned int CRATER_TABLE_SIZE = 200;
 	static constexpr unsigned int EXPLOSION_LIFETIME = 10;
 
@@ -10,6 +10,7 @@
 #include "System/Exceptions.h"
 #include "System/StringUtil.h"
 #include "System/FileSystem/VFSHandler.h"
+#include "System/Threading/ThreadPool.h"
 
 #include <cstring> // strcpy,memset
 #include <sstream>
@@ -123,9 +124,15 @@ void CMapGenerator::GenerateSMF(CVirtualFile* fileSMF)
 	const float heightMax = smfHeader.maxHeight;
 	const float heightMul = 65535.0f / (smfHeader.maxHeight - smfHeader.minHeight);
 
-	for (int x = 0; x < heightmapDimensions; x++) {
-		heightmapPtr[x] = int16_t(Clamp(heightMap[x], heightMin, heightMax) - heightMin) * heightMul;
-	}
+	// rows are independent; this is the only O(mapx * mapy) kernel
+	// between GenerateMap() and the archive scan, so run it tiled on
+	// the pool while players sit in the lobby
+	for_mt(0, smfHeader.mapy + 1, [&](const int y) {
+		for (int x = 0; x <= smfHeader.mapx; x++) {
+			const int i = y * (smfHeader.mapx + 1) + x;
+			heightmapPtr[i] = int16_t(Clamp(heightMap[i], heightMin, heightMax) - heightMin) * heightMul;
+		}
+	});
 
 	std::memset(typemapPtr.data(), 0, typemapSize);
 
@@ -139,6 +146,10 @@ void CMapGenerator::GenerateSMF(CVirtualFile* fileSMF)
 	std::memset(metalmapPtr.data(), 0, metalmapSize);
 
 	//--- Write to final buffer ---
+	// reserve the full file upfront so the appends below do not copy
+	// the (multi-MB) heightmap around on every vector regrowth
+	fileSMF->buffer.reserve(smfHeader.featurePtr + sizeof(smfFeature));
+
 	AppendToBuffer(fileSMF, smfHeader);
 
 	AppendToBuffer(fileSMF, vegHeader);
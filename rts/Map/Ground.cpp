@@ -208,6 +208,87 @@ inline static bool ClampInMapHeight(float3& from, float3& to)
 }
 
 
+// hierarchical variant of the general-case march in LineGroundCol();
+// descends the synced max-height mip pyramid and only runs triangle
+// tests in squares where the ray can actually dip below the terrain,
+// making long traces take O(log n) rather than O(n) samples
+static float TraceGroundRayMips(const float* hm, const float3* nm, const float3& from, const float3& to)
+{
+	const float dx = to.x - from.x;
+	const float dz = to.z - from.z;
+	const float dy = to.y - from.y;
+
+	const int dirx = (dx > 0.0f) ? 1 : -1;
+	const int dirz = (dz > 0.0f) ? 1 : -1;
+
+	const float rdx = 1.0f / dx;
+	const float rdz = 1.0f / dz;
+
+	int sx = Clamp(int(from.x / SQUARE_SIZE), 0, mapDims.mapxm1);
+	int sz = Clamp(int(from.z / SQUARE_SIZE), 0, mapDims.mapym1);
+
+	// level 0 is a single square, level L covers (1 << L) squares
+	int level = CReadMap::numMaxHgtMipMaps;
+
+	float t = 0.0f;
+
+	// every iteration either advances the ray past a tile (or square)
+	// or descends one level, so the step count stays bounded
+	for (int i = 0, n = (mapDims.mapx + mapDims.mapy + CReadMap::numMaxHgtMipMaps) * 2; i < n; i++) {
+		const int tx = sx >> level;
+		const int tz = sz >> level;
+
+		// parametric exits of the current tile along x and z
+		const float tex = ((((tx + (dirx > 0)) << level) * SQUARE_SIZE) - from.x) * rdx;
+		const float tez = ((((tz + (dirz > 0)) << level) * SQUARE_SIZE) - from.z) * rdz;
+		const float texit = std::min(tex, tez);
+
+		if (level > 0) {
+			// the ray is linear in y over [t, texit]; if even its lowest
+			// point clears the tile maximum nothing inside can be hit
+			const float rayMinHgt = std::min(from.y + dy * t, from.y + dy * std::min(texit, 1.0f));
+			const float* maxHgtMipMap = readMap->GetMaxHeightMipMapSynced(level - 1);
+
+			if (rayMinHgt <= maxHgtMipMap[tz * (mapDims.mapx >> level) + tx]) {
+				level--;
+				continue;
+			}
+		} else {
+			const float ret = LineGroundSquareCol(hm, nm,  from, to,  sx, sz);
+
+			if (ret >= 0.0f)
+				return ret;
+		}
+
+		if (texit >= 1.0f)
+			break;
+
+		// step into the neighbor tile(s) sharing the crossed edge(s);
+		// the non-crossed coordinate is re-derived from the exit point
+		// since the ray may have moved several squares inside the tile
+		if (tex <= texit) {
+			sx = (dirx > 0) ? ((tx + 1) << level) : ((tx << level) - 1);
+		} else {
+			sx = Clamp(int((from.x + dx * texit) / SQUARE_SIZE), 0, mapDims.mapxm1);
+		}
+		if (tez <= texit) {
+			sz = (dirz > 0) ? ((tz + 1) << level) : ((tz << level) - 1);
+		} else {
+			sz = Clamp(int((from.z + dz * texit) / SQUARE_SIZE), 0, mapDims.mapym1);
+		}
+
+		if (sx < 0 || sz < 0 || sx >= mapDims.mapx || sz >= mapDims.mapy)
+			break;
+
+		t = texit;
+		// climb again after clearing a tile; the next one is often as empty
+		level = std::min(level + 1, int(CReadMap::numMaxHgtMipMaps));
+	}
+
+	return -1.0f;
+}
+
+
 float CGround::LineGroundCol(float3 from, float3 to, bool synced)
 {
 	const float* hm  = readMap->GetSharedCornerHeightMap(synced);
@@ -303,6 +384,18 @@ float CGround::LineGroundCol(float3 from, float3 to, bool synced)
 		return -1.0f;
 	}
 
+	if (synced) {
+		// general case; the max-height pyramid only tracks the synced
+		// heightmap (the unsynced one can locally rise above it outside
+		// LOS), so unsynced traces keep the plain square march below
+		const float ret = TraceGroundRayMips(hm, nm, from, to);
+
+		if (ret >= 0.0f)
+			return (ret + skippedDist);
+
+		return -1.0f;
+	}
+
 	{
 		// general case
 		const float rdsx = SQUARE_SIZE / dx; // := 1 / (dx / SQUARE_SIZE)
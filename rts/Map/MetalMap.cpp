@@ -14,9 +14,13 @@ CR_REG_METADATA(CMetalMap,(
 	CR_MEMBER(sizeX),
 	CR_MEMBER(sizeZ),
 
+	CR_MEMBER(tilesX),
+	CR_MEMBER(tilesZ),
+
 	CR_IGNORED(texturePalette),
 	CR_MEMBER(distributionMap),
-	CR_MEMBER(extractionMap)
+	CR_MEMBER(extractionMap),
+	CR_MEMBER(tileMaxMetal)
 ))
 
 
@@ -41,6 +45,18 @@ void CMetalMap::Init(const unsigned char* map, int _sizeX, int _sizeZ, float _me
 		metalScale = 1.0f;
 	}
 
+	tilesX = (sizeX + METAL_MAP_TILE_SIZE - 1) / METAL_MAP_TILE_SIZE;
+	tilesZ = (sizeZ + METAL_MAP_TILE_SIZE - 1) / METAL_MAP_TILE_SIZE;
+
+	tileMaxMetal.clear();
+	tileMaxMetal.resize(tilesX * tilesZ, 0);
+
+	for (int tz = 0; tz < tilesZ; tz++) {
+		for (int tx = 0; tx < tilesX; tx++) {
+			UpdateTileMaxMetal(tx, tz);
+		}
+	}
+
 	for (int a = 0; a < 256; ++a) {
 		texturePalette[a * 3 + 0] = a;
 		texturePalette[a * 3 + 1] = std::min(255, a * 2      );
@@ -50,6 +66,25 @@ void CMetalMap::Init(const unsigned char* map, int _sizeX, int _sizeZ, float _me
 
 
 
+void CMetalMap::UpdateTileMaxMetal(int tx, int tz)
+{
+	const int x1 = tx * METAL_MAP_TILE_SIZE;
+	const int z1 = tz * METAL_MAP_TILE_SIZE;
+	const int x2 = std::min(x1 + METAL_MAP_TILE_SIZE, sizeX);
+	const int z2 = std::min(z1 + METAL_MAP_TILE_SIZE, sizeZ);
+
+	unsigned char maxMetal = 0;
+
+	for (int z = z1; z < z2; z++) {
+		for (int x = x1; x < x2; x++) {
+			maxMetal = std::max(maxMetal, distributionMap[(z * sizeX) + x]);
+		}
+	}
+
+	tileMaxMetal[(tz * tilesX) + tx] = maxMetal;
+}
+
+
 float CMetalMap::GetMetalAmount(int x1, int z1, int x2, int z2) const
 {
 	x1 = Clamp(x1, 0, sizeX - 1);
@@ -59,9 +94,22 @@ float CMetalMap::GetMetalAmount(int x1, int z1, int x2, int z2) const
 
 	float metal = 0.0f;
 
+	// skipped squares contribute exactly 0.0f, so jumping over empty
+	// tiles leaves the sum bit-identical to the full scalar loop
 	for (int z = z1; z < z2; z++) {
-		for (int x = x1; x < x2; x++) {
-			metal += GetMetalAmount(x, z);
+		const unsigned char* tileMaxRow = &tileMaxMetal[(z / METAL_MAP_TILE_SIZE) * tilesX];
+
+		for (int x = x1; x < x2; ) {
+			if (tileMaxRow[x / METAL_MAP_TILE_SIZE] == 0) {
+				x = (x / METAL_MAP_TILE_SIZE + 1) * METAL_MAP_TILE_SIZE;
+				continue;
+			}
+
+			const int xe = std::min(x2, (x / METAL_MAP_TILE_SIZE + 1) * METAL_MAP_TILE_SIZE);
+
+			for (; x < xe; x++) {
+				metal += distributionMap[(z * sizeX) + x] * metalScale;
+			}
 		}
 	}
 
@@ -85,6 +133,8 @@ void CMetalMap::SetMetalAmount(int x, int z, float m)
 
 	distributionMap[(z * sizeX) + x] = (metalScale == 0.0f) ? 0 : Clamp((int)(m / metalScale), 0, 255);
 
+	UpdateTileMaxMetal(x / METAL_MAP_TILE_SIZE, z / METAL_MAP_TILE_SIZE);
+
 	eventHandler.MetalMapChanged(x, z);
 }
 
@@ -129,6 +179,7 @@ int CMetalMap::GetMetalExtraction(int x, int z) const
 
 
 void CMetalMap::Init(const unsigned char* map, int _sizeX, int _sizeZ, float _metalScale) {}
+void CMetalMap::UpdateTileMaxMetal(int tx, int tz) {}
 
 float CMetalMap::GetMetalAmount(int x1, int z1, int x2, int z2) const { return 0.0f; }
 float CMetalMap::GetMetalAmount(int x, int z) const { return 0.0f; }
@@ -12,6 +12,10 @@
 // each metalmap square covers 2x2 normal squares
 static constexpr float METAL_MAP_SQUARE_SIZE = SQUARE_SIZE * 2;
 
+// edge length (in metalmap squares) of the tiles used to classify
+// constant-zero regions; most maps are >95% empty at this granularity
+static constexpr int METAL_MAP_TILE_SIZE = 16;
+
 
 class CMetalMap
 {
@@ -23,6 +27,7 @@ public:
 	void Kill() {
 		distributionMap.clear();
 		extractionMap.clear();
+		tileMaxMetal.clear();
 	}
 
 	/** Returns the amount of metal over an area. */
@@ -57,15 +62,23 @@ public:
 	const         float* GetExtractionMap  () const { return   extractionMap.data(); }
 
 private:
+	void UpdateTileMaxMetal(int tx, int tz);
+
 	std::array<unsigned char, 256 * 3> texturePalette;
 
 	std::vector<unsigned char> distributionMap;
 	std::vector<        float> extractionMap;
 
+	// per-tile maximum of distributionMap; lets area sums skip the
+	// (typically vast) all-zero regions without touching them
+	std::vector<unsigned char> tileMaxMetal;
+
 	float metalScale = 0.0f;
 
 	int sizeX = 0;
 	int sizeZ = 0;
+	int tilesX = 0;
+	int tilesZ = 0;
 };
 
 extern CMetalMap metalMap;
@@ -30,6 +30,8 @@
 #endif
 
 #define MAX_UHM_RECTS_PER_FRAME static_cast<size_t>(128)
+// minimum number of dirty rows before heightmap-derivative updates fork
+#define MIN_MT_UPDATE_ROWS 32
 
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
@@ -90,6 +92,7 @@ CR_REG_METADATA(CReadMap, (
 
 	CR_IGNORED(unsyncedHeightMapUpdates),
 	CR_IGNORED(unsyncedHeightMapUpdatesTemp),
+	CR_IGNORED(unsyncedUpdateCount),
 
 	/*
 	#ifdef USE_UNSYNCED_HEIGHTMAP
@@ -112,6 +115,7 @@ MapDimensions mapDims;
 std::vector<float> CReadMap::originalHeightMap;
 std::vector<float> CReadMap::centerHeightMap;
 std::array<std::vector<float>, CReadMap::numHeightMipMaps - 1> CReadMap::mipCenterHeightMaps;
+std::array<std::vector<float>, CReadMap::numMaxHgtMipMaps> CReadMap::maxHgtMipMaps;
 
 std::vector<float3> CReadMap::visVertexNormals;
 std::vector<float3> CReadMap::faceNormalsSynced;
@@ -327,6 +331,11 @@ void CReadMap::Initialize()
 		mipPointerHeightMaps[i] = &mipCenterHeightMaps[i - 1][0];
 	}
 
+	for (int i = 0; i < numMaxHgtMipMaps; i++) {
+		maxHgtMipMaps[i].clear();
+		maxHgtMipMaps[i].resize((mapDims.mapx >> (i + 1)) * (mapDims.mapy >> (i + 1)));
+	}
+
 	slopeMap.clear();
 	slopeMap.resize(mapDims.hmapx * mapDims.hmapy);
 
@@ -469,6 +478,8 @@ void CReadMap::UpdateDraw(bool firstCall)
 	#else
 
 	// TODO: quadtree or whatever
+	unsyncedUpdateCount += std::min(MAX_UHM_RECTS_PER_FRAME, unsyncedHeightMapUpdates.size());
+
 	for (size_t i = 0, n = std::min(MAX_UHM_RECTS_PER_FRAME, unsyncedHeightMapUpdates.size()); i < n; i++) {
 		UpdateHeightMapUnsynced(*(unsyncedHeightMapUpdates.begin() + i));
 	}
@@ -503,6 +514,7 @@ void CReadMap::UpdateHeightMapSynced(const SRectangle& hgtMapRect, bool initiali
 
 	UpdateCenterHeightmap(centerRect, initialize);
 	UpdateMipHeightmaps(centerRect, initialize);
+	UpdateMaxHeightMipMaps(cornerRect, initialize);
 	UpdateFaceNormals(centerRect, initialize);
 	UpdateSlopemap(centerRect, initialize); // must happen after UpdateFaceNormals()!
 
@@ -540,20 +552,26 @@ void CReadMap::UpdateCenterHeightmap(const SRectangle& rect, bool initialize)
 {
 	const float* heightmapSynced = GetCornerHeightMapSynced();
 
-	for (int y = rect.z1; y <= rect.z2; y++) {
+	const auto UpdateRow = [&](const int y) {
+		const float* hgtMapRowT = &heightmapSynced[(y    ) * mapDims.mapxp1];
+		const float* hgtMapRowB = &heightmapSynced[(y + 1) * mapDims.mapxp1];
+		      float* ctrMapRow  = &centerHeightMap[(y    ) * mapDims.mapx  ];
+
+		// rows are contiguous, 2x2 box-filter auto-vectorizes
 		for (int x = rect.x1; x <= rect.x2; x++) {
-			const int idxTL = (y    ) * mapDims.mapxp1 + x;
-			const int idxTR = (y    ) * mapDims.mapxp1 + x + 1;
-			const int idxBL = (y + 1) * mapDims.mapxp1 + x;
-			const int idxBR = (y + 1) * mapDims.mapxp1 + x + 1;
-
-			const float height =
-				heightmapSynced[idxTL] +
-				heightmapSynced[idxTR] +
-				heightmapSynced[idxBL] +
-				heightmapSynced[idxBR];
-			centerHeightMap[y * mapDims.mapx + x] = height * 0.25f;
+			ctrMapRow[x] = (hgtMapRowT[x] + hgtMapRowT[x + 1] + hgtMapRowB[x] + hgtMapRowB[x + 1]) * 0.25f;
 		}
+	};
+
+	// rows are independent; only fork for terraform-sized rects,
+	// typical explosion craters are too small to pay the overhead
+	if ((rect.z2 - rect.z1) >= MIN_MT_UPDATE_ROWS) {
+		for_mt(rect.z1, rect.z2 + 1, UpdateRow);
+		return;
+	}
+
+	for (int y = rect.z1; y <= rect.z2; y++) {
+		UpdateRow(y);
 	}
 }
 
@@ -585,6 +603,64 @@ void CReadMap::UpdateMipHeightmaps(const SRectangle& rect, bool initialize)
 }
 
 
+void CReadMap::UpdateMaxHeightMipMaps(const SRectangle& rect, bool initialize)
+{
+	const float* heightmapSynced = GetCornerHeightMapSynced();
+
+	// level 0; maxima are taken over the (ts + 1) * (ts + 1) corners of
+	// each tile s.t. the squares along shared tile edges stay covered
+	{
+		constexpr int ts = 2;
+		const int tilesX = mapDims.mapx / ts;
+
+		const int tx1 = std::max(rect.x1 / ts,                       0);
+		const int tx2 = std::min(rect.x2 / ts,              tilesX - 1);
+		const int tz1 = std::max(rect.z1 / ts,                       0);
+		const int tz2 = std::min(rect.z2 / ts, (mapDims.mapy / ts) - 1);
+
+		for (int tz = tz1; tz <= tz2; tz++) {
+			for (int tx = tx1; tx <= tx2; tx++) {
+				float maxHgt = -std::numeric_limits<float>::max();
+
+				for (int z = tz * ts; z <= (tz * ts + ts); z++) {
+					for (int x = tx * ts; x <= (tx * ts + ts); x++) {
+						maxHgt = std::max(maxHgt, heightmapSynced[z * mapDims.mapxp1 + x]);
+					}
+				}
+
+				maxHgtMipMaps[0][tz * tilesX + tx] = maxHgt;
+			}
+		}
+	}
+
+	// coarser levels; children overlap along their shared edges, so the
+	// maximum of the four children covers the parent tile inclusively
+	for (int i = 1; i < numMaxHgtMipMaps; i++) {
+		const int ts = 2 << i;
+		const int tilesX = mapDims.mapx >> (i + 1);
+		const int subTilesX = mapDims.mapx >> i;
+
+		const int tx1 = std::max(rect.x1 / ts,                          0);
+		const int tx2 = std::min(rect.x2 / ts,                 tilesX - 1);
+		const int tz1 = std::max(rect.z1 / ts,                          0);
+		const int tz2 = std::min(rect.z2 / ts, (mapDims.mapy >> (i + 1)) - 1);
+
+		const float* subMipMap = &maxHgtMipMaps[i - 1][0];
+
+		for (int tz = tz1; tz <= tz2; tz++) {
+			for (int tx = tx1; tx <= tx2; tx++) {
+				const float maxHgt = std::max(
+					std::max(subMipMap[(tz * 2    ) * subTilesX + tx * 2], subMipMap[(tz * 2    ) * subTilesX + tx * 2 + 1]),
+					std::max(subMipMap[(tz * 2 + 1) * subTilesX + tx * 2], subMipMap[(tz * 2 + 1) * subTilesX + tx * 2 + 1])
+				);
+
+				maxHgtMipMaps[i][tz * tilesX + tx] = maxHgt;
+			}
+		}
+	}
+}
+
+
 void CReadMap::UpdateFaceNormals(const SRectangle& rect, bool initialize)
 {
 	const float* heightmapSynced = GetCornerHeightMapSynced();
@@ -662,7 +738,7 @@ void CReadMap::UpdateSlopemap(const SRectangle& rect, bool initialize)
 	const int sy = std::max(0,                 (rect.z1 / 2) - 1);
 	const int ey = std::min(mapDims.hmapy - 1, (rect.z2 / 2) + 1);
 
-	for (int y = sy; y <= ey; y++) {
+	const auto UpdateRow = [&](const int y) {
 		for (int x = sx; x <= ex; x++) {
 			const int idx0 = (y*2    ) * (mapDims.mapx) + x*2;
 			const int idx1 = (y*2 + 1) * (mapDims.mapx) + x*2;
@@ -693,6 +769,16 @@ void CReadMap::UpdateSlopemap(const SRectangle& rect, bool initialize)
 
 			slopeMap[y * mapDims.hmapx + x] = 1.0f - slope;
 		}
+	};
+
+	// each half-res row only reads face-normal rows 2y and 2y+1
+	if ((ey - sy) >= MIN_MT_UPDATE_ROWS) {
+		for_mt(sy, ey + 1, UpdateRow);
+		return;
+	}
+
+	for (int y = sy; y <= ey; y++) {
+		UpdateRow(y);
 	}
 }
 
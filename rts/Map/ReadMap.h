@@ -158,6 +158,7 @@ public:
 	const float* GetOriginalHeightMapSynced() const { return &originalHeightMap[0]; }
 	const float* GetCenterHeightMapSynced() const { return &centerHeightMap[0]; }
 	const float* GetMIPHeightMapSynced(unsigned int mip) const { return mipPointerHeightMaps[mip]; }
+	const float* GetMaxHeightMipMapSynced(unsigned int mip) const { return &maxHgtMipMaps[mip][0]; }
 	const float* GetSlopeMapSynced() const { return &slopeMap[0]; }
 	const uint8_t* GetTypeMapSynced() const { return &typeMap[0]; }
 	      uint8_t* GetTypeMapSynced()       { return &typeMap[0]; }
@@ -203,12 +204,16 @@ public:
 	bool HasOnlyVoidWater() const;
 
 	unsigned int GetMapChecksum() const { return mapChecksum; }
+	/// bumped whenever unsynced heightmap rectangles get flushed in
+	/// UpdateDraw; lets renderers detect visible terrain changes cheaply
+	unsigned int GetUnsyncedUpdateCount() const { return unsyncedUpdateCount; }
 	unsigned int CalcHeightmapChecksum();
 	unsigned int CalcTypemapChecksum();
 
 private:
 	void UpdateCenterHeightmap(const SRectangle& rect, bool initialize);
 	void UpdateMipHeightmaps(const SRectangle& rect, bool initialize);
+	void UpdateMaxHeightMipMaps(const SRectangle& rect, bool initialize);
 	void UpdateFaceNormals(const SRectangle& rect, bool initialize);
 	void UpdateSlopemap(const SRectangle& rect, bool initialize);
 
@@ -218,6 +223,8 @@ private:
 public:
 	/// number of heightmap mipmaps, including full resolution
 	static constexpr int numHeightMipMaps = 7;
+	/// number of max-height mipmaps; level i covers (2 << i) squares
+	static constexpr int numMaxHgtMipMaps = 5;
 
 protected:
 	// these point to the actual heightmap data
@@ -232,6 +239,13 @@ protected:
 	static std::vector<float> centerHeightMap;          //< size: (mapx  )*(mapy  ) (per face) [SYNCED, updates on terrain deformation]
 	static std::array<std::vector<float>, numHeightMipMaps - 1> mipCenterHeightMaps;
 
+	/**
+	 * conservative per-tile maxima over the synced corner heightmap
+	 * (tile edges included), used by CGround::LineGroundCol to skip
+	 * empty space during ray traces [SYNCED]
+	 */
+	static std::array<std::vector<float>, numMaxHgtMipMaps> maxHgtMipMaps;
+
 	/**
 	 * array of pointers to heightmaps in different resolutions
 	 * mipPointerHeightMaps[0  ] is full resolution (centerHeightMap)
@@ -253,6 +267,8 @@ protected:
 	CRectangleOverlapHandler unsyncedHeightMapUpdates;
 	CRectangleOverlapHandler unsyncedHeightMapUpdatesTemp;
 
+	unsigned int unsyncedUpdateCount = 0;
+
 private:
 	// these combine the various synced and unsynced arrays
 	// for branch-less access: [0] = !synced, [1] = synced
@@ -172,6 +172,12 @@ void CBasicMeshDrawer::UploadPatchSquareGeometry(uint32_t n, uint32_t px, uint32
 	VAO& squareVAO = meshPatch.squareVertexBuffers[n].vao;
 	VBO& squareVBO = meshPatch.squareVertexBuffers[n].vbo;
 
+	// with GPU displacement the square geometry is only built once; height
+	// changes reach the vertex shaders through HeightMapTexture instead of
+	// (synchronous) re-uploads, border skirts are still refreshed here
+	if (smfGroundDrawer->UseGPUDisplacement() && squareVBO.vboId != 0)
+		return;
+
 	meshPatch.uhmUpdateFrames[0] = globalRendering->drawFrame;
 
 	const uint32_t lodStep  = 1 << n;
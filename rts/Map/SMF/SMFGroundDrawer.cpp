@@ -5,6 +5,7 @@
 #include "SMFGroundTextures.h"
 #include "SMFRenderState.h"
 #include "Game/Camera.h"
+#include "Map/HeightMapTexture.h"
 #include "Map/MapInfo.h"
 #include "Map/ReadMap.h"
 #include "Map/SMF/Basic/BasicMeshDrawer.h"
@@ -52,6 +53,11 @@ CONFIG(int, ROAM)
 	.maximumValue(1)
 	.description("Use ROAM for terrain mesh rendering: 0 to disable, 1 to enable.");
 
+CONFIG(bool, GroundGPUDisplacement)
+	.defaultValue(false)
+	.safemodeValue(false)
+	.description("Displace terrain vertices from the heightmap texture in the vertex shader, so patch meshes stay static after map deformation.");
+
 
 CSMFGroundDrawer::CSMFGroundDrawer(CSMFReadMap* rm)
 	: smfMap(rm)
@@ -60,6 +66,7 @@ CSMFGroundDrawer::CSMFGroundDrawer(CSMFReadMap* rm)
 {
 	drawerMode = (configHandler->GetInt("ROAM") != 0)? SMF_MESHDRAWER_ROAM: SMF_MESHDRAWER_BASIC;
 	groundDetail = configHandler->GetInt("GroundDetail");
+	gpuDisplacement = configHandler->GetBool("GroundGPUDisplacement");
 
 	groundTextures = new CSMFGroundTextures(smfMap);
 	meshDrawer = SwitchMeshDrawer(drawerMode);
@@ -514,7 +521,20 @@ void CSMFGroundDrawer::DrawShadowPass()
 		po->Enable();
 		po->SetUniformMatrix4fv(1, false, shadowHandler.GetShadowViewMatrix());
 		po->SetUniformMatrix4fv(2, false, shadowHandler.GetShadowProjMatrix());
+
+		if (gpuDisplacement) {
+			// pull current heights from the heightmap texture; the border
+			// mesh has to stay undisplaced or its skirt would collapse
+			glBindTexture(GL_TEXTURE_2D, heightMapTexture->GetTextureID());
+			po->SetUniform1i(3, 0); // heightMapTex
+			po->SetUniform1f(4, 1.0f); // heightMapDisplace
+		}
+
 			meshDrawer->DrawMesh(DrawPass::Shadow);
+
+		if (gpuDisplacement)
+			po->SetUniform1f(4, 0.0f);
+
 			meshDrawer->DrawBorderMesh(DrawPass::Shadow);
 		po->Disable();
 
@@ -56,6 +56,8 @@ public:
 	void SetDetail(int newGroundDetail) override;
 	int GetGroundDetail(const DrawPass::e& drawPass = DrawPass::Normal) const override;
 
+	bool UseGPUDisplacement() const { return gpuDisplacement; }
+
 	const CSMFReadMap* GetReadMap() const { return smfMap; }
 	      CSMFReadMap* GetReadMap()       { return smfMap; }
 	const GL::LightHandler* GetLightHandler() const override { return &lightHandler; }
@@ -86,6 +88,10 @@ protected:
 	int drawerMode;
 	int groundDetail;
 
+	// if true, mesh drawers may keep their patch geometry static and
+	// let the vertex shaders displace it from the heightmap texture
+	bool gpuDisplacement;
+
 	// [0] := no-op rendering path
 	// [1] := default shader-driven rendering path
 	// [2] := custom shader-driven rendering path (via Lua)
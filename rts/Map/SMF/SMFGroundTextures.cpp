@@ -16,12 +16,14 @@
 #include "Game/Game.h"
 #include "Game/GameSetup.h"
 #include "Game/LoadScreen.h"
+#include "System/Config/ConfigHandler.h"
 #include "System/Exceptions.h"
 #include "System/FastMath.h"
 #include "System/Log/ILog.h"
 #include "System/TimeProfiler.h"
 #include "System/FileSystem/FileHandler.h"
 #include "System/FileSystem/FileSystem.h"
+#include "System/FileSystem/VFSHandler.h"
 #include "System/Platform/Watchdog.h"
 #include "System/Threading/ThreadPool.h" // for_mt
 
@@ -36,6 +38,10 @@ LOG_REGISTER_SECTION_GLOBAL(LOG_SECTION_SMF_GROUND_TEXTURES)
 #endif
 #define LOG_SECTION_CURRENT LOG_SECTION_SMF_GROUND_TEXTURES
 
+CONFIG(bool, SMFTexStreaming)
+	.defaultValue(true)
+	.description("Upload SMF square textures on demand as the view moves instead of all at load; uses sparse GPU storage when the driver supports it.");
+
 
 
 std::vector<CSMFGroundTextures::GroundSquare> CSMFGroundTextures::squares;
@@ -61,8 +67,18 @@ CSMFGroundTextures::GroundSquare::~GroundSquare()
 
 CSMFGroundTextures::CSMFGroundTextures(CSMFReadMap* rm): smfMap(rm)
 {
+	texStreaming = configHandler->GetBool("SMFTexStreaming");
+	sparseTexture = texStreaming && GLEW_ARB_sparse_texture;
+
 	LoadTiles(smfMap->GetMapFile());
-	LoadSquareTextures(0, 3); // preload all levels
+
+	if (texStreaming) {
+		// coarsest level only; DrawUpdate pages in the rest on demand
+		LoadSquareTextures(3, 3);
+	} else {
+		LoadSquareTextures(0, 3); // preload all levels
+	}
+
 	ConvolveHeightMap(mapDims.mapx, 1);
 }
 
@@ -114,15 +130,49 @@ void CSMFGroundTextures::LoadTiles(CSMFMapFile& file)
 		}
 	}
 
-	for (int a = 0, curTile = 0; a < tileHeader.numTileFiles; ++a) {
+	struct TileFile {
 		int numSmallTiles = 0;
+		std::string fileName;
+	};
+
+	std::vector<TileFile> tileFiles(tileHeader.numTileFiles);
+
+	for (TileFile& tf: tileFiles) {
 		char fileNameBuffer[256] = {0};
 
-		ifs->Read(&numSmallTiles, sizeof(int));
+		ifs->Read(&tf.numSmallTiles, sizeof(int));
 		ifs->ReadString(&fileNameBuffer[0], sizeof(char) * (sizeof(fileNameBuffer) - 1));
-		swabDWordInPlace(numSmallTiles);
+		swabDWordInPlace(tf.numSmallTiles);
+
+		tf.fileName = fileNameBuffer;
+	}
 
-		std::string smtFileName = fileNameBuffer;
+	{
+		// hand all tile-file names to the VFS up front, archived .smt data
+		// is then decompressed by a background worker while earlier files
+		// are being consumed below
+		std::vector<std::string> smtFilePaths;
+		smtFilePaths.reserve(tileFiles.size());
+
+		for (int a = 0; a < tileHeader.numTileFiles; ++a) {
+			const std::string& smtFileName = (!smtHeaderOverride)? tileFiles[a].fileName : smf.smtFileNames[a];
+			const std::string smtFilePath = smfDir + smtFileName;
+
+			// mirror the fallback order of the Open calls below
+			if (vfsHandler->FileExists(smtFilePath, CVFSHandler::Section::Map) == 1) {
+				smtFilePaths.push_back(smtFilePath);
+			} else {
+				smtFilePaths.push_back(smtFileName);
+			}
+		}
+
+		vfsHandler->PrefetchFiles(smtFilePaths, CVFSHandler::Section::Map);
+	}
+
+	for (int a = 0, curTile = 0; a < tileHeader.numTileFiles; ++a) {
+		const int numSmallTiles = tileFiles[a].numSmallTiles;
+
+		std::string smtFileName = tileFiles[a].fileName;
 		std::string smtFilePath = (!smtHeaderOverride)?
 			(smfDir + smtFileName):
 			(smfDir + smf.smtFileNames[a]);
@@ -187,6 +237,11 @@ void CSMFGroundTextures::LoadSquareTextures(const int minLevel, const int maxLev
 	const int ntx = smfMap->numBigTexX;
 	const int nty = smfMap->numBigTexY;
 
+	// sparse storage backs only committed pages with memory; the
+	// glTexStorage3D call below then just reserves address space
+	if (sparseTexture)
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SPARSE_ARB, GL_TRUE);
+
 	#if 0
 	glTexImage3D(
 		GL_TEXTURE_2D_ARRAY,
@@ -336,6 +391,11 @@ void CSMFGroundTextures::DrawUpdate()
 	const float vsySq = globalRendering->viewSizeY * globalRendering->viewSizeY;
 	const float vdiag = fastmath::apxsqrt(vsxSq + vsySq);
 
+	// do not stall the frame on more than a few on-demand tile uploads,
+	// squares past the cap temporarily render with a coarser mip instead
+	constexpr int maxUploads = 4;
+	int numUploads = 0;
+
 	for (int y = 0; y < smfMap->numBigTexY; ++y) {
 		float dz = camPos.z - (y * smfMap->bigSquareSize * SQUARE_SIZE);
 		dz -= (SQUARE_SIZE << 6);
@@ -353,6 +413,10 @@ void CSMFGroundTextures::DrawUpdate()
 					// `unload` texture (load lowest mip-map) if
 					// the square wasn't visible for 120 vframes
 					square->SetMipLevel(3);
+
+					// sparse storage can release the pages for real
+					if (sparseTexture)
+						EvictSquareTexture(x, y);
 				}
 
 				continue;
@@ -405,6 +469,20 @@ void CSMFGroundTextures::DrawUpdate()
 			if (stretchFactors[y * smfMap->numBigTexX + x] > 16000 && wantedLevel > 0)
 				wantedLevel--;
 
+			if (!square->HasLevelUploaded(wantedLevel)) {
+				if (numUploads < maxUploads) {
+					LoadSquareTexture(x, y, wantedLevel);
+					numUploads++;
+					continue;
+				}
+
+				// fall back to the finest resident level until the
+				// wanted one gets its turn (level 3 is always there)
+				while (!square->HasLevelUploaded(wantedLevel)) {
+					wantedLevel++;
+				}
+			}
+
 			square->SetMipLevel(wantedLevel);
 		}
 	}
@@ -521,8 +599,15 @@ void CSMFGroundTextures::LoadSquareTexture(int x, int y, int level)
 
 	GroundSquare* square = &squares[y * smfMap->numBigTexX + x];
 	square->SetMipLevel(level);
+	square->SetLevelUploaded(level);
 	assert(!square->HasLuaTexture());
 
+	// DrawUpdate calls in without a bound array texture
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(ttarget, tileArrayTex);
+
+	if (sparseTexture)
+		glTexPageCommitmentARB(ttarget, level, 0, 0, y * smfMap->numBigTexX + x, mipSqSize, mipSqSize, 1, GL_TRUE);
 
 	pbo.Bind();
 	pbo.New(numSqBytes);
@@ -543,6 +628,31 @@ void CSMFGroundTextures::LoadSquareTexture(int x, int y, int level)
 
 	pbo.Invalidate();
 	pbo.Unbind();
+
+	glBindTexture(ttarget, 0);
+}
+
+void CSMFGroundTextures::EvictSquareTexture(int x, int y)
+{
+	constexpr GLenum ttarget = GL_TEXTURE_2D_ARRAY;
+
+	GroundSquare* square = &squares[y * smfMap->numBigTexX + x];
+
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(ttarget, tileArrayTex);
+
+	// decommit every level except the always-resident coarsest one
+	for (int level = 0; level < 3; level++) {
+		if (!square->HasLevelUploaded(level))
+			continue;
+
+		const int mipSqSize = smfMap->bigTexSize >> level;
+
+		glTexPageCommitmentARB(ttarget, level, 0, 0, y * smfMap->numBigTexX + x, mipSqSize, mipSqSize, 1, GL_FALSE);
+	}
+
+	square->ClrLevelsUploaded((1 << 3) - 1);
+	glBindTexture(ttarget, 0);
 }
 
 void CSMFGroundTextures::BindSquareTextureArray() const { glActiveTexture(GL_TEXTURE0); glBindTexture(GL_TEXTURE_2D_ARRAY, tileArrayTex); }
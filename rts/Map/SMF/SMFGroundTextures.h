@@ -34,6 +34,7 @@ protected:
 	void ConvolveHeightMap(const int mapWidth, const int mipLevel);
 	void ExtractSquareTiles(const int texSquareX, const int texSquareY, const int mipLevel, GLint* tileBuf) const;
 	void LoadSquareTexture(int x, int y, int level);
+	void EvictSquareTexture(int x, int y);
 
 	inline bool TexSquareInView(int, int) const;
 
@@ -46,7 +47,7 @@ private:
 			LUA_TEX_IDX = 1,
 		};
 
-		GroundSquare(): textureIDs{0, 0}, texMipLevel(0), texDrawFrame(1) {}
+		GroundSquare(): textureIDs{0, 0}, texMipLevel(0), texDrawFrame(1), uploadedLevels(0) {}
 		~GroundSquare();
 
 		bool HasLuaTexture() const { return (textureIDs[LUA_TEX_IDX] != 0); }
@@ -55,6 +56,10 @@ private:
 		void SetLuaTexture(unsigned int id) { textureIDs[LUA_TEX_IDX] = id; }
 		void SetMipLevel(unsigned int l) { texMipLevel = l; }
 		void SetDrawFrame(unsigned int f) { texDrawFrame = f; }
+		void SetLevelUploaded(unsigned int l) { uploadedLevels |= (1 << l); }
+		void ClrLevelsUploaded(unsigned int m) { uploadedLevels &= ~m; }
+
+		bool HasLevelUploaded(unsigned int l) const { return ((uploadedLevels & (1 << l)) != 0); }
 
 		unsigned int* GetTextureIDPtr() { return &textureIDs[RAW_TEX_IDX]; }
 		unsigned int GetTextureID() const { return textureIDs[HasLuaTexture()]; }
@@ -65,6 +70,8 @@ private:
 		unsigned int textureIDs[2];
 		unsigned int texMipLevel;
 		unsigned int texDrawFrame;
+		// bitmask of mip levels with valid data in the array texture
+		unsigned int uploadedLevels;
 	};
 
 	// note: intentionally declared static (see ReadMap)
@@ -83,6 +90,12 @@ private:
 
 	unsigned int tileArrayTex = 0;
 	unsigned int tileTexFormat = 0;
+
+	// if true, square textures are uploaded on demand by DrawUpdate
+	// rather than all at load; with sparse storage the GPU footprint
+	// then also tracks the view instead of the map size
+	bool texStreaming = false;
+	bool sparseTexture = false;
 };
 
 #endif // _BF_GROUND_TEXTURES_H_
@@ -82,6 +82,7 @@ CSMFReadMap::CSMFReadMap(const std::string& mapName): CEventClient("[CSMFReadMap
 
 	ConfigureTexAnisotropyLevels();
 	InitializeWaterHeightColors();
+	UpdateLightValueTable();
 
 	CreateSpecularTex();
 	CreateSplatDetailTextures();
@@ -658,19 +659,33 @@ float CSMFReadMap::DiffuseSunCoeff(const int x, const int y) const
 
 float3 CSMFReadMap::GetLightValue(const int x, const int y) const
 {
-	float3 light =
-		sunLighting->groundAmbientColor +
-		sunLighting->groundDiffuseColor * DiffuseSunCoeff(x, y);
+	// quantizing the coefficient to 1/255 steps loses at most one LSB
+	// in the 8-bit shading texture, the table itself is exact
+	return lightValueTable[int(DiffuseSunCoeff(x, y) * (lightValueTable.size() - 1))];
+}
 
-	for (int a = 0; a < 3; ++a) {
-		light[a] = std::min(light[a] * CGlobalRendering::SMF_INTENSITY_MULT, 1.0f);
-	}
+void CSMFReadMap::UpdateLightValueTable()
+{
+	// ambient plus diffuse modulated by the clamped dot(L,N) is a pure
+	// function of that dot product, so tabulate it once per sun-/Lua-
+	// lighting change instead of re-deriving it for every shading texel
+	for (size_t i = 0; i < lightValueTable.size(); ++i) {
+		float3 light =
+			sunLighting->groundAmbientColor +
+			sunLighting->groundDiffuseColor * (i / (lightValueTable.size() - 1.0f));
+
+		for (int a = 0; a < 3; ++a) {
+			light[a] = std::min(light[a] * CGlobalRendering::SMF_INTENSITY_MULT, 1.0f);
+		}
 
-	return light;
+		lightValueTable[i] = light;
+	}
 }
 
 void CSMFReadMap::SunChanged()
 {
+	UpdateLightValueTable();
+
 	if (shadingTexUpdateProgress < 0) {
 		shadingTexUpdateProgress = 0;
 	} else {
@@ -8,6 +8,8 @@
 #include "System/EventClient.h"
 #include "System/type2.h"
 
+#include <array>
+
 
 class CSMFGroundDrawer;
 
@@ -165,6 +167,7 @@ private:
 
 	inline float DiffuseSunCoeff(const int x, const int y) const;
 	inline float3 GetLightValue(const int x, const int y) const;
+	void UpdateLightValueTable();
 	void ParseSMD(std::string filename);
 
 public:
@@ -221,6 +224,10 @@ private:
 	MapTexture parallaxHeightTex;
 
 private:
+	// GetLightValue tabulated over the quantized diffuse-sun coefficient;
+	// rebuilt on SunChanged instead of re-derived for every shading texel
+	std::array<float3, 256> lightValueTable;
+
 	int shadingTexUpdateProgress = -1;
 
 	float texAnisotropyLevels[2] = {0.0f, 0.0f};
@@ -4,6 +4,7 @@
 #include "SMFGroundDrawer.h"
 #include "SMFReadMap.h"
 #include "Game/Camera.h"
+#include "Map/HeightMapTexture.h"
 #include "Map/MapInfo.h"
 #include "Rendering/GlobalRendering.h"
 #include "Rendering/ShadowHandler.h"
@@ -36,12 +37,15 @@ ISMFRenderState* ISMFRenderState::GetInstance(bool nopState, bool luaShaders) {
 bool SMFRenderStateGLSL::Init(const CSMFGroundDrawer* smfGroundDrawer) {
 	const GL::LightHandler* lightHandler = smfGroundDrawer->GetLightHandler();
 
+	gpuDisplacement = smfGroundDrawer->UseGPUDisplacement();
+
 	const std::string names[GLSL_SHADER_COUNT - 1] = {
 		"SMFShaderGLSL-Standard",
 		"SMFShaderGLSL-Deferred",
 	};
 	const std::string defs =
 		("#define SMF_TEXSQUARE_SIZE "     + FloatToString(                  SMF_TEXSQUARE_SIZE) + "\n") +
+		("#define SMF_SQUARE_SIZE "        + FloatToString(                  SQUARE_SIZE * 1.0f) + "\n") +
 		("#define SMF_INTENSITY_MULT "     + FloatToString(CGlobalRendering::SMF_INTENSITY_MULT) + "\n") +
 		("#define SMF_CLIP_PLANE_IDX "     + IntToString(            IWater::ClipPlaneIndex()) + "\n") +
 		("#define SMF_FRAGDATA_COUNT "     + IntToString(GL::GeometryBuffer::ATTACHMENT_COUNT) + "\n") +
@@ -119,6 +123,7 @@ void SMFRenderStateGLSL::Update(
 			glslShaders[n]->SetFlag("SMF_BLEND_NORMALS",                   (smfMap->GetBlendNormalsTexture() != 0));
 			glslShaders[n]->SetFlag("SMF_LIGHT_EMISSION",                  (smfMap->GetLightEmissionTexture() != 0));
 			glslShaders[n]->SetFlag("SMF_PARALLAX_MAPPING",                (smfMap->GetParallaxHeightTexture() != 0));
+			glslShaders[n]->SetFlag("SMF_GPU_DISPLACEMENT",                 gpuDisplacement);
 
 			// both are runtime set in ::Enable, but ATI drivers need values from the beginning
 			glslShaders[n]->SetFlag("HAVE_SHADOWS", false);
@@ -138,6 +143,7 @@ void SMFRenderStateGLSL::Update(
 
 			// tex1 (shadingTex) is not used by SMFFragProg
 			glslShaders[n]->SetUniform("diffuseTex",             0);
+			glslShaders[n]->SetUniform("heightMapTex",           1);
 			glslShaders[n]->SetUniform("detailTex",              2);
 			glslShaders[n]->SetUniform("shadowTex",              4);
 			glslShaders[n]->SetUniform("normalsTex",             5);
@@ -260,8 +266,12 @@ void SMFRenderStateGLSL::Enable(const CSMFGroundDrawer* smfGroundDrawer, const D
 	shader->SetUniform<float>("gammaExponent", globalRendering->gammaExponent);
 
 	if (cLightHandler->NumConfigLights() > 0) {
+		// culls and compacts, only upload the slots that survived
 		mLightHandler->Update();
-		shader->SetUniform4v<float>("fwdDynLights", cLightHandler->NumUniformVecs(), cLightHandler->GetRawLightDataPtr());
+		shader->SetUniform("numDynLights", int(cLightHandler->NumVisLights()));
+
+		if (cLightHandler->NumVisLights() > 0)
+			shader->SetUniform4v<float>("fwdDynLights", cLightHandler->NumVisUniformVecs(), cLightHandler->GetRawLightDataPtr());
 	}
 
 	switch (drawPass) {
@@ -273,6 +283,10 @@ void SMFRenderStateGLSL::Enable(const CSMFGroundDrawer* smfGroundDrawer, const D
 	if (shadowHandler.ShadowsLoaded())
 		shadowHandler.SetupShadowTexSampler(GL_TEXTURE4);
 
+	if (gpuDisplacement) {
+		glActiveTexture(GL_TEXTURE1); glBindTexture(GL_TEXTURE_2D, heightMapTexture->GetTextureID());
+	}
+
 	glActiveTexture(GL_TEXTURE2); glBindTexture(GL_TEXTURE_2D, smfMap->GetDetailTexture());
 	glActiveTexture(GL_TEXTURE5); glBindTexture(GL_TEXTURE_2D, smfMap->GetNormalsTexture());
 	glActiveTexture(GL_TEXTURE6); glBindTexture(GL_TEXTURE_2D, smfMap->GetSpecularTexture());
@@ -117,6 +117,8 @@ private:
 
 	// if true, shader programs for this state are Lua-defined
 	bool useLuaShaders;
+	// if true, vertex heights are sampled from HeightMapTexture
+	bool gpuDisplacement = false;
 };
 
 #endif
@@ -48,6 +48,29 @@ enum EVENT
 	/// Server gave out a warning (string warningmessage)
 	SERVER_WARNING = 5,
 
+	/// Reply to a batch-mode handshake (uchar acceptedVersion)
+	SERVER_BATCHMODE = 6,
+
+	/**
+	 * @brief One datagram holding all events of a server tick
+	 *   ((uint16_t eventSize, event)* until end of datagram)
+	 *
+	 * Only sent after the autohost negotiated batch mode by sending
+	 * {0xFF, 'B', uchar wantedVersion}; the server replies with
+	 * SERVER_BATCHMODE and min(wantedVersion, supportedVersion), a
+	 * version of 0 keeps the one-datagram-per-event format.
+	 */
+	SERVER_EVENT_BATCH = 7,
+
+	/**
+	 * @brief Periodic engine-performance telemetry (string json)
+	 *
+	 * Sent every ServerTelemetryInterval seconds (0 disables); the
+	 * payload is a single flat JSON object, see
+	 * CGameServer::SendTelemetry for the emitted fields.
+	 */
+	SERVER_TELEMETRY = 8,
+
 	/// Player has joined the game (uchar playernumber, string name)
 	PLAYER_JOINED = 10,
 
@@ -94,6 +117,10 @@ enum EVENT
 	 */
 	GAME_TEAMSTAT = NETMSG_TEAMSTAT, // should be 60
 };
+
+// keep batch datagrams within a conservative single-datagram limit,
+// anything that would push past this flushes the running batch first
+static constexpr size_t maxBatchSize = 4096;
 }
 
 using namespace asio;
@@ -300,6 +327,18 @@ void AutohostInterface::Warning(const std::string& message)
 	}
 }
 
+void AutohostInterface::SendTelemetry(const std::string& json)
+{
+	if (autohost.is_open()) {
+		const unsigned msgsize = sizeof(uchar) + json.size();
+		std::vector<std::uint8_t> buffer(msgsize);
+		buffer[0] = SERVER_TELEMETRY;
+		strncpy((char*)(&buffer[1]), json.c_str(), json.size());
+
+		Send(asio::buffer(buffer));
+	}
+}
+
 void AutohostInterface::SendLuaMsg(const std::uint8_t* msg, size_t msgSize)
 {
 	if (autohost.is_open()) {
@@ -329,6 +368,18 @@ std::string AutohostInterface::GetChatMessage()
 		if ((bytes_avail = autohost.available()) > 0) {
 			std::vector<std::uint8_t> buffer(bytes_avail+1, 0);
 			/*const size_t bytesReceived = */autohost.receive(asio::buffer(buffer));
+
+			// batch-mode handshake, not chat (0xFF can never start plain text)
+			if (bytes_avail >= 3 && buffer[0] == 0xFF && buffer[1] == 'B') {
+				const uchar version = std::min<uchar>(buffer[2], GetEventBatchVersion());
+
+				uchar msg[2] = {SERVER_BATCHMODE, version};
+				SendDirect(asio::buffer(&msg, 2 * sizeof(uchar)));
+
+				batchMode = (version > 0);
+				return "";
+			}
+
 			return std::string((char*)(&buffer[0]));
 		}
 	}
@@ -337,6 +388,43 @@ std::string AutohostInterface::GetChatMessage()
 }
 
 void AutohostInterface::Send(asio::mutable_buffers_1 buffer)
+{
+	if (!autohost.is_open())
+		return;
+
+	const std::uint8_t* data = asio::buffer_cast<const std::uint8_t*>(buffer);
+	const size_t size = asio::buffer_size(buffer);
+
+	// events too large for a length prefix keep the legacy format, the
+	// leading event id makes these distinguishable from batch datagrams
+	if (!batchMode || size > std::numeric_limits<std::uint16_t>::max()) {
+		SendDirect(buffer);
+		return;
+	}
+
+	if ((batchBuffer.size() + sizeof(std::uint16_t) + size) > maxBatchSize)
+		Flush();
+
+	if (batchBuffer.empty())
+		batchBuffer.push_back(SERVER_EVENT_BATCH);
+
+	const std::uint16_t eventSize = size;
+	const std::uint8_t* eventSizePtr = reinterpret_cast<const std::uint8_t*>(&eventSize);
+
+	batchBuffer.insert(batchBuffer.end(), eventSizePtr, eventSizePtr + sizeof(eventSize));
+	batchBuffer.insert(batchBuffer.end(), data, data + size);
+}
+
+void AutohostInterface::Flush()
+{
+	if (batchBuffer.empty())
+		return;
+
+	SendDirect(asio::buffer(batchBuffer));
+	batchBuffer.clear();
+}
+
+void AutohostInterface::SendDirect(asio::mutable_buffers_1 buffer)
 {
 	if (autohost.is_open()) {
 		try {
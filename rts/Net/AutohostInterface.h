@@ -5,6 +5,7 @@
 
 #include <string>
 #include <cinttypes>
+#include <vector>
 #include <asio/ip/udp.hpp>
 
 /**
@@ -46,6 +47,9 @@ public:
 	void Message(const std::string& message);
 	void Warning(const std::string& message);
 
+	/// periodic performance telemetry, payload is one JSON object
+	void SendTelemetry(const std::string& json);
+
 	void SendLuaMsg(const std::uint8_t* msg, size_t msgSize);
 	void Send(const std::uint8_t* msg, size_t msgSize);
 
@@ -53,11 +57,23 @@ public:
 	 * @brief Receive a chat message from the autohost
 	 * There should be only 1 message per UDP-Packet, and it will use the hosts
 	 * playernumber to inject this message
+	 * Also handles the batch-mode handshake (see GetEventBatchVersion).
 	 */
 	std::string GetChatMessage();
 
+	/**
+	 * @brief Send out all events queued up in the current batch
+	 * No-op unless the autohost requested batch mode; call once per
+	 * server tick.
+	 */
+	void Flush();
+
+	/// highest batched-event protocol version this engine speaks
+	static constexpr uchar GetEventBatchVersion() { return 1; }
+
 private:
 	void Send(asio::mutable_buffers_1 sendBuffer);
+	void SendDirect(asio::mutable_buffers_1 sendBuffer);
 
 	/**
 	 * Tries to bind a socket for communication with a UDP server.
@@ -77,6 +93,11 @@ private:
 
 	asio::ip::udp::socket autohost;
 	bool initialized;
+
+	/// events go out length-prefixed in one datagram per tick if true
+	bool batchMode = false;
+
+	std::vector<std::uint8_t> batchBuffer;
 };
 
 #endif // AUTOHOST_INTERFACE_H
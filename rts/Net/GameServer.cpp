@@ -38,6 +38,7 @@
 #endif
 #include "System/CRC.h"
 #include "System/GlobalConfig.h"
+#include "System/MainDefines.h" // SNPRINTF
 #include "System/MsgStrings.h"
 #include "System/SpringMath.h"
 #include "System/SpringExitCode.h"
@@ -76,6 +77,7 @@ CONFIG(bool, ServerRecordDemos).defaultValue(false).dedicatedValue(true);
 CONFIG(bool, ServerLogInfoMessages).defaultValue(false);
 CONFIG(bool, ServerLogDebugMessages).defaultValue(false);
 CONFIG(std::string, AutohostIP).defaultValue("127.0.0.1");
+CONFIG(int, ServerTelemetryInterval).defaultValue(0).minimumValue(0).description("Seconds between performance-telemetry datagrams sent over the autohost interface, 0 disables them.");
 
 
 // use the specific section for all LOG*() calls in this source file
@@ -163,6 +165,7 @@ void CGameServer::Initialize()
 	whiteListAdditionalPlayers = configHandler->GetBool("WhiteListAdditionalPlayers");
 	logInfoMessages = configHandler->GetBool("ServerLogInfoMessages");
 	logDebugMessages = configHandler->GetBool("ServerLogDebugMessages");
+	telemetryInterval = configHandler->GetInt("ServerTelemetryInterval");
 
 	rng.Seed((myGameData->GetSetupText()).length());
 
@@ -578,11 +581,60 @@ void CGameServer::PrivateMessage(int playerNum, const std::string& message) {
 }
 
 
+void CGameServer::SetClientTelemetry(std::string&& blob)
+{
+	std::lock_guard<spring::recursive_mutex> scoped_lock(gameServerMutex);
+
+	clientTelemetry = std::move(blob);
+}
+
+void CGameServer::SendTelemetry()
+{
+	int numIngame = 0;
+
+	for (const GameParticipant& p: players) {
+		numIngame += (p.myState == GameParticipant::INGAME);
+	}
+
+	char buf[256];
+	SNPRINTF(buf, sizeof(buf),
+			"{\"frame\":%d,\"speed\":%.2f,\"wanted_speed\":%.2f,\"median_cpu\":%.2f,\"median_ping\":%d,\"players\":%d",
+			serverFrameNum, internalSpeed, userSpeedFactor, medianCpu, medianPing, numIngame);
+
+	std::string json(buf);
+
+	// engine-side stats get pushed in by the local client when one
+	// exists; spring-dedicated runs no simulation, so its datagrams
+	// only carry the server fields
+	if (!clientTelemetry.empty()) {
+		json += ",";
+		json += clientTelemetry;
+	}
+
+	json += "}";
+
+	hostif->SendTelemetry(json);
+}
+
+
+
+void CGameServer::GotSyncResponse(int playerNum, int frameNum, unsigned checkSum)
+{
+	GameParticipant& p = players[playerNum];
+
+	if (outstandingSyncFrames.find(frameNum) != outstandingSyncFrames.end())
+		p.syncResponse[frameNum] = checkSum;
+
+	// update player's ping (if !defined(SYNCCHECK) this is done in NETMSG_KEYFRAME)
+	if (frameNum <= serverFrameNum && frameNum > p.lastFrameResponse)
+		p.lastFrameResponse = frameNum;
+}
 
 void CGameServer::CheckSync()
 {
 #ifdef SYNCCHECK
 	std::vector< std::pair<unsigned, unsigned> > checksums; // <response checkum, #clients matching checksum>
+	std::vector<unsigned> echoedChecksums;
 	std::vector<int> noSyncResponsePlayers;
 
 	std::map<unsigned, std::vector<int> > desyncGroups; // <desync-checksum, [desynced players]>
@@ -750,6 +802,27 @@ void CGameServer::CheckSync()
 
 		// Remove complete sets (for which all player's checksums have been received).
 		if (completeResponseSet) {
+			// echo this frame's sync-responses back to everybody, so a client
+			// can detect if it is desynced wrt. a demo-stream; one response
+			// per distinct checksum suffices for that, echoing every player's
+			// copy just multiplies autohost egress
+			if ((outstandingSyncFrame % syncResponseEchoInterval) == 0) {
+				echoedChecksums.clear();
+
+				for (GameParticipant& p: players) {
+					const auto pChecksumIt = p.syncResponse.find(outstandingSyncFrame);
+
+					if (pChecksumIt == p.syncResponse.end())
+						continue;
+
+					if (std::find(echoedChecksums.begin(), echoedChecksums.end(), pChecksumIt->second) != echoedChecksums.end())
+						continue;
+
+					echoedChecksums.push_back(pChecksumIt->second);
+					Broadcast(CBaseNetProtocol::Get().SendSyncResponse(p.id, outstandingSyncFrame, pChecksumIt->second));
+				}
+			}
+
 			for (GameParticipant& p: players) {
 				if (p.myState < GameParticipant::DISCONNECTED)
 					p.syncResponse.erase(outstandingSyncFrame);
@@ -826,6 +899,11 @@ void CGameServer::Update()
 	else if (!PreSimFrame() || demoReader != nullptr)
 		CreateNewFrame(true, false);
 
+	if (hostif != nullptr && telemetryInterval > 0 && lastTelemetry < (spring_gettime() - spring_secs(telemetryInterval))) {
+		lastTelemetry = spring_gettime();
+		SendTelemetry();
+	}
+
 	if (hostif != nullptr) {
 		const std::string msg = hostif->GetChatMessage();
 
@@ -840,6 +918,9 @@ void CGameServer::Update()
 				PushAction(Action(msg.substr(1)), true);
 			}
 		}
+
+		// everything queued up this tick goes out in one datagram
+		hostif->Flush();
 	}
 
 	const bool pregameTimeoutReached = (spring_gettime() > (serverStartTime + spring_secs(globalConfig.initialNetworkTimeout)));
@@ -1330,20 +1411,33 @@ void CGameServer::ProcessPacket(const unsigned playerNum, std::shared_ptr<const
 			unsigned  int  checkSum; pckt >> checkSum;
 
 			assert(a == playerNum);
-			GameParticipant& p = players[a];
+			GotSyncResponse(a, frameNum, checkSum);
+#endif
+		} break;
+
+		case NETMSG_SYNCRESPONSES: {
+#ifdef SYNCCHECK
+			try {
+				netcode::UnpackPacket pckt(packet, 1);
+
+				uint16_t packetSize; pckt >> packetSize;
+				uint8_t   playerNum; pckt >> playerNum;
+				int32_t   baseFrame; pckt >> baseFrame;
 
-			if (outstandingSyncFrames.find(frameNum) != outstandingSyncFrames.end())
-				p.syncResponse[frameNum] = checkSum;
+				if (playerNum != a) {
+					Message(spring::format(WrongPlayer, msgCode, a, (unsigned)playerNum));
+					break;
+				}
 
-			// update player's ping (if !defined(SYNCCHECK) this is done in NETMSG_KEYFRAME)
-			if (frameNum <= serverFrameNum && frameNum > p.lastFrameResponse)
-				p.lastFrameResponse = frameNum;
+				const uint32_t headerSize = sizeof(uint8_t) + sizeof(packetSize) + sizeof(playerNum) + sizeof(baseFrame);
+				const uint32_t numChecksums = (packetSize - headerSize) / sizeof(uint32_t);
 
-			// send player <a>'s sync-response back to everybody
-			// (the only purpose of this is to allow a client to
-			// detect if it is desynced wrt. a demo-stream)
-			if ((frameNum % syncResponseEchoInterval) == 0) {
-				Broadcast((CBaseNetProtocol::Get()).SendSyncResponse(playerNum, frameNum, checkSum));
+				for (uint32_t i = 0; i < numChecksums; i++) {
+					uint32_t checkSum; pckt >> checkSum;
+					GotSyncResponse(a, baseFrame + i, checkSum);
+				}
+			} catch (const netcode::UnpackPacketException& ex) {
+				Message(spring::format("[GameServer::%s][NETMSG_SYNCRESPONSES] exception \"%s\" from player \"%s\"", __func__, ex.what(), players[a].name.c_str()));
 			}
 #endif
 		} break;
@@ -2003,7 +2097,7 @@ void CGameServer::ServerReadNet()
 				if (aiPacket == nullptr)
 					break;
 
-				const bool droppablePacket = (aiPacket->length <= 0 || (aiPacket->data[0] != NETMSG_SYNCRESPONSE && aiPacket->data[0] != NETMSG_KEYFRAME));
+				const bool droppablePacket = (aiPacket->length <= 0 || (aiPacket->data[0] != NETMSG_SYNCRESPONSE && aiPacket->data[0] != NETMSG_SYNCRESPONSES && aiPacket->data[0] != NETMSG_KEYFRAME));
 
 				if (forcedDropPacket && droppablePacket) {
 					++numPktsDropped;
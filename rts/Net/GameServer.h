@@ -89,6 +89,14 @@ public:
 
 	void CreateNewFrame(bool fromServerThread, bool fixedFrameTime);
 
+	/**
+	 * @brief hand over engine-side performance stats (thread-safe)
+	 * The blob is a fragment of JSON key-value pairs which gets merged
+	 * into the next telemetry datagram sent to the autohost; gathered
+	 * by the local client since the server itself runs no simulation.
+	 */
+	void SetClientTelemetry(std::string&& blob);
+
 	void SetGamePausable(const bool arg);
 	void SetReloading(const bool arg) { reloadingServer = arg; }
 
@@ -160,6 +168,8 @@ private:
 	void UpdateLoop();
 	void Update();
 	void ProcessPacket(const unsigned playerNum, std::shared_ptr<const netcode::RawPacket> packet);
+	/// record one frame's sync checksum from a client
+	void GotSyncResponse(int playerNum, int frameNum, unsigned checkSum);
 	void CheckSync();
 	void HandleConnectionAttempts();
 	void ServerReadNet();
@@ -186,6 +196,9 @@ private:
 	void Message(const std::string& message, bool broadcast = true, bool internal = false);
 	void PrivateMessage(int playerNum, const std::string& message);
 
+	/// emit one SERVER_TELEMETRY event over the autohost interface
+	void SendTelemetry();
+
 	float GetDemoTime() const;
 
 private:
@@ -221,6 +234,9 @@ private:
 
 	std::pair<std::string, std::string> refClientVersion;
 
+	/// latest engine-side stats fragment, see SetClientTelemetry
+	std::string clientTelemetry;
+
 	std::deque< std::shared_ptr<const netcode::RawPacket> > packetCache;
 
 	/////////////////// sync stuff ///////////////////
@@ -236,6 +252,7 @@ private:
 	spring_time lastPlayerInfo = spring_notime;
 	spring_time lastUpdate = spring_notime;
 	spring_time lastBandwidthUpdate = spring_notime;
+	spring_time lastTelemetry = spring_notime;
 
 	float modGameTime = 0.0f;
 	float gameTime = 0.0f;
@@ -258,6 +275,9 @@ private:
 
 	int linkMinPacketSize = 1;
 
+	/// seconds between telemetry datagrams, 0 disables
+	int telemetryInterval = 0;
+
 	unsigned localClientNumber = -1u;
 
 
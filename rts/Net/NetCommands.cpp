@@ -44,6 +44,15 @@ LOG_REGISTER_SECTION_GLOBAL(LOG_SECTION_NET)
 
 static spring::unordered_map<int32_t, uint32_t> localSyncChecksums;
 
+// number of per-frame sync checksums to accumulate before flushing them
+// to the server in one NETMSG_SYNCRESPONSES message; kept small because
+// the server derives player pings from the most recent response, which
+// can lag behind the client's sim by up to a full batch
+static constexpr size_t SYNC_RESPONSE_BATCH_SIZE = 4;
+
+static std::vector<uint32_t> pendingSyncChecksums;
+static int32_t pendingSyncBaseFrame = 0;
+
 
 void CGame::AddTraffic(int playerID, int packetCode, int length)
 {
@@ -171,7 +180,21 @@ void CGame::UpdateNumQueuedSimFrames()
 		// always stay a bit behind the actual server time
 		// at higher speeds we need to keep more distance!
 		// (because effect of network jitter is amplified)
-		consumeSpeedMult = GAME_SPEED * gs->speedFactor + lastNumQueuedSimFrames - (2 * gs->speedFactor);
+		float targetQueuedFrames = 2.0f * gs->speedFactor;
+
+		// grow the target backlog with the measured inter-arrival jitter
+		// of frame messages, so unstable (e.g. wireless) connections trail
+		// further behind rather than oscillating between draining and
+		// refilling the buffer, which shows up as sim-speed pumping
+		if (globalConfig.useAdaptiveNetMessageBuffer) {
+			const float frameIntervalMS = 1000.0f / (GAME_SPEED * gs->speedFactor);
+			const float jitterFrames = clientNet->GetServerConnection()->GetFramePacketJitter() / frameIntervalMS;
+
+			// cap the extra latency this can introduce at half a second
+			targetQueuedFrames += std::min(jitterFrames, GAME_SPEED * 0.5f);
+		}
+
+		consumeSpeedMult = GAME_SPEED * gs->speedFactor + lastNumQueuedSimFrames - targetQueuedFrames;
 	} else {
 		// Modified SPRING95 behaviour
 		// Aim at staying 2 sim frames behind.
@@ -562,10 +585,20 @@ void CGame::ClientReadNet()
 				SimFrame();
 
 #ifdef SYNCCHECK
-				// both NETMSG_SYNCRESPONSE and NETMSG_NEWFRAME are used for ping calculation by server
+				// both NETMSG_SYNCRESPONSES and NETMSG_NEWFRAME are used for ping calculation by server
 				ASSERT_SYNCED(gs->frameNum);
 				ASSERT_SYNCED(CSyncChecker::GetChecksum());
-				clientNet->Send(CBaseNetProtocol::Get().SendSyncResponse(gu->myPlayerNum, gs->frameNum, CSyncChecker::GetChecksum()));
+
+				// batch consecutive per-frame checksums into one message
+				if (pendingSyncChecksums.empty())
+					pendingSyncBaseFrame = gs->frameNum;
+
+				pendingSyncChecksums.push_back(CSyncChecker::GetChecksum());
+
+				if (pendingSyncChecksums.size() >= SYNC_RESPONSE_BATCH_SIZE) {
+					clientNet->Send(CBaseNetProtocol::Get().SendSyncResponses(gu->myPlayerNum, pendingSyncBaseFrame, pendingSyncChecksums));
+					pendingSyncChecksums.clear();
+				}
 
 				// buffer all checksums, so we can check sync later between demo & local
 				if (haveServerDemo)
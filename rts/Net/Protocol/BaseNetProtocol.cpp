@@ -375,6 +375,29 @@ PacketType CBaseNetProtocol::SendMapDrawLine(uint8_t playerNum, int16_t x1, int1
 	return PacketType(packet);
 }
 
+PacketType CBaseNetProtocol::SendMapDrawStroke(uint8_t playerNum, const std::vector<int16_t>& coords, bool fromLua)
+{
+	constexpr uint8_t drawType = MAPDRAW_STROKE;
+
+	// coords holds one {x1, z1, x2, z2} quadruplet per line segment; the
+	// uint8_t size-field limits strokes to 31 segments, callers must chunk
+	const uint8_t numSegments = coords.size() / 4;
+
+	const uint32_t payloadSize = sizeof(playerNum) + sizeof(drawType) + sizeof(uint8_t) + sizeof(numSegments) + coords.size() * sizeof(int16_t);
+	const uint32_t headerSize = sizeof(uint8_t) + sizeof(uint8_t);
+	const uint32_t packetSize = headerSize + payloadSize;
+
+	PackPacket* packet = new PackPacket(packetSize, NETMSG_MAPDRAW);
+	*packet <<
+		static_cast<uint8_t>(packetSize) <<
+		playerNum <<
+		drawType <<
+		static_cast<uint8_t>(fromLua) <<
+		numSegments <<
+		coords;
+	return PacketType(packet);
+}
+
 
 PacketType CBaseNetProtocol::SendSyncResponse(uint8_t playerNum, int32_t frameNum, uint32_t checksum)
 {
@@ -383,6 +406,15 @@ PacketType CBaseNetProtocol::SendSyncResponse(uint8_t playerNum, int32_t frameNu
 	return PacketType(packet);
 }
 
+PacketType CBaseNetProtocol::SendSyncResponses(uint8_t playerNum, int32_t baseFrame, const std::vector<uint32_t>& checksums)
+{
+	const uint16_t packetSize = sizeof(uint8_t) + sizeof(uint16_t) + sizeof(playerNum) + sizeof(baseFrame) + checksums.size() * sizeof(uint32_t);
+
+	PackPacket* packet = new PackPacket(packetSize, NETMSG_SYNCRESPONSES);
+	*packet << packetSize << playerNum << baseFrame << checksums;
+	return PacketType(packet);
+}
+
 PacketType CBaseNetProtocol::SendSystemMessage(uint8_t playerNum, std::string message)
 {
 	if (message.size() > 65000) {
@@ -646,6 +678,7 @@ CBaseNetProtocol::CBaseNetProtocol()
 	proto->AddType(NETMSG_GAMEOVER, -1);
 	proto->AddType(NETMSG_MAPDRAW, -1);
 	proto->AddType(NETMSG_SYNCRESPONSE, 10);
+	proto->AddType(NETMSG_SYNCRESPONSES, -2);
 	proto->AddType(NETMSG_SYSTEMMSG, -2);
 	proto->AddType(NETMSG_STARTPOS, 16);
 	proto->AddType(NETMSG_PLAYERINFO, 10);
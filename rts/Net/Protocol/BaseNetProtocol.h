@@ -72,8 +72,10 @@ public:
 	PacketType SendGameOver(uint8_t playerNum, const std::vector<uint8_t>& winningAllyTeams);
 	PacketType SendMapErase(uint8_t playerNum, int16_t x, int16_t z);
 	PacketType SendMapDrawLine(uint8_t playerNum, int16_t x1, int16_t z1, int16_t x2, int16_t z2, bool);
+	PacketType SendMapDrawStroke(uint8_t playerNum, const std::vector<int16_t>& coords, bool);
 	PacketType SendMapDrawPoint(uint8_t playerNum, int16_t x, int16_t z, const std::string& label, bool);
 	PacketType SendSyncResponse(uint8_t playerNum, int32_t frameNum, uint32_t checksum);
+	PacketType SendSyncResponses(uint8_t playerNum, int32_t baseFrame, const std::vector<uint32_t>& checksums);
 	PacketType SendSystemMessage(uint8_t playerNum, std::string message);
 	PacketType SendStartPos(uint8_t playerNum, uint8_t teamNum, uint8_t readyState, float x, float y, float z);
 	PacketType SendPlayerInfo(uint8_t playerNum, float cpuUsage, int32_t ping);
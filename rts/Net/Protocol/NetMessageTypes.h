@@ -53,6 +53,7 @@ enum NETMSG {
 	                              // uint8_t messageSize = 12, playerNum, command = MapDrawAction::NET_LINE; int16_t x1, z1, x2, z2;
 	                              // /*messageSize*/   uint8_t playerNum, command = MapDrawAction::NET_POINT; int16_t x, z; std::string label;
 	NETMSG_SYNCRESPONSE     = 33, // uint8_t playerNum; int32_t frameNum; uint32_t checksum;
+	NETMSG_SYNCRESPONSES    = 34, // uint16_t messageSize; uint8_t playerNum; int32_t baseFrame; std::vector<uint32_t> checksums, one per frame starting at baseFrame;
 	NETMSG_SYSTEMMSG        = 35, // uint8_t playerNum, std::string message;
 	NETMSG_STARTPOS         = 36, // uint8_t playerNum, uint8_t myTeam, ready /*0: not ready, 1: ready, 2: don't update readiness*/; float x, y, z;
 	NETMSG_PLAYERINFO       = 38, // uint8_t playerNum; float cpuUsage; int32_t ping /*in milliseconds*/;
@@ -112,7 +113,8 @@ enum TEAMMSG {
 enum MapDrawAction {
 	MAPDRAW_POINT,
 	MAPDRAW_ERASE,
-	MAPDRAW_LINE
+	MAPDRAW_LINE,
+	MAPDRAW_STROKE // multiple line segments batched into one packet
 };
 
 #endif
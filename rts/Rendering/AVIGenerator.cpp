@@ -133,6 +133,11 @@ CAVIGenerator::~CAVIGenerator()
 	}
 
 	spring::SafeDelete(readBuf);
+
+	// runs on the GL thread (via StopCapturing), context still alive
+	pixelBufs[0].Release();
+	pixelBufs[1].Release();
+
 	ReleaseAVICompressionEngine();
 	LOG("Finished writing avi file %s", fileName.c_str());
 
@@ -386,7 +391,29 @@ bool CAVIGenerator::readOpenglPixelDataThreaded()
 		}
 	}
 
-	glReadPixels(0, 0, bitmapInfo.biWidth, bitmapInfo.biHeight, GL_BGR, GL_UNSIGNED_BYTE, readBuf);
+	VBO& curPbo = pixelBufs[curPixelBuf    ];
+	VBO& prvPbo = pixelBufs[curPixelBuf ^ 1];
+
+	// kick this frame's transfer into one PACK buffer without waiting
+	curPbo.Bind(GL_PIXEL_PACK_BUFFER);
+	curPbo.New(bitmapInfo.biSizeImage, GL_STREAM_READ);
+	glReadPixels(0, 0, bitmapInfo.biWidth, bitmapInfo.biHeight, GL_BGR, GL_UNSIGNED_BYTE, nullptr);
+	curPbo.Unbind();
+
+	// drain the previous frame's (already finished) transfer into
+	// readBuf; the very first frame maps its own transfer and waits
+	VBO& srcPbo = (prvPbo.GetSize() != 0)? prvPbo: curPbo;
+
+	srcPbo.Bind(GL_PIXEL_PACK_BUFFER);
+	const GLubyte* mem = srcPbo.MapBuffer(0, bitmapInfo.biSizeImage, GL_MAP_READ_BIT);
+
+	if (mem != nullptr)
+		memcpy(readBuf, mem, bitmapInfo.biSizeImage);
+
+	srcPbo.UnmapBuffer();
+	srcPbo.Unbind();
+
+	curPixelBuf ^= 1;
 	return true;
 }
 
@@ -5,6 +5,7 @@
 
 #ifdef _WIN32
 
+#include "Rendering/GL/VBO.h"
 #include "System/Threading/SpringThreading.h"
 #include "System/Misc/NonCopyable.h"
 
@@ -66,6 +67,11 @@ private:
 
 	unsigned char* readBuf;
 
+	/// PACK buffers for pipelined readback; one transfer in flight
+	/// while the previous frame is drained into readBuf
+	VBO pixelBufs[2] = {VBO(GL_PIXEL_PACK_BUFFER), VBO(GL_PIXEL_PACK_BUFFER)};
+	int curPixelBuf = 0;
+
 
 	/// frame counter
 	long m_lFrame;
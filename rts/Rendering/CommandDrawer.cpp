@@ -21,6 +21,8 @@
 #include "Sim/Units/CommandAI/BuilderCAI.h"
 #include "Sim/Units/CommandAI/FactoryCAI.h"
 #include "Sim/Units/CommandAI/MobileCAI.h"
+#include "Sim/Misc/GlobalConstants.h"
+#include "Sim/Misc/GlobalSynced.h"
 #include "Sim/Units/Unit.h"
 #include "Sim/Units/UnitDef.h"
 #include "Sim/Units/UnitHandler.h"
@@ -52,23 +54,187 @@ void CommandDrawer::Draw(const CCommandAI* cai, bool onMiniMap) const {
 	const CMatrix44f& projMat = onMiniMap? minimap->GetProjMat(0): camera->GetProjectionMatrix();
 	const CMatrix44f& viewMat = onMiniMap? minimap->GetViewMat(0): camera->GetViewMatrix();
 
-	const auto& DrawBuffer = [&viewMat, &projMat](GL::RenderDataBufferC* rdb, Shader::IProgramObject* ipo) {
-		// hand off all surface circles
-		ipo->Enable();
-		ipo->SetUniformMatrix4x4<float>("u_movi_mat", false, viewMat);
-		ipo->SetUniformMatrix4x4<float>("u_proj_mat", false, projMat);
-		rdb->Submit(GL_LINES);
-		ipo->Disable();
-	};
-
-	// note: {Air,Builder}CAI inherit from MobileCAI, so test that last
-	if (dynamic_cast<const     CAirCAI*>(cai) != nullptr) {     DrawAirCAICommands(static_cast<const     CAirCAI*>(cai), buffer); DrawBuffer(buffer, shader); return; }
-	if (dynamic_cast<const CBuilderCAI*>(cai) != nullptr) { DrawBuilderCAICommands(static_cast<const CBuilderCAI*>(cai), buffer); DrawBuffer(buffer, shader); return; }
-	if (dynamic_cast<const CFactoryCAI*>(cai) != nullptr) { DrawFactoryCAICommands(static_cast<const CFactoryCAI*>(cai), buffer); DrawBuffer(buffer, shader); return; }
-	if (dynamic_cast<const  CMobileCAI*>(cai) != nullptr) {  DrawMobileCAICommands(static_cast<const  CMobileCAI*>(cai), buffer); DrawBuffer(buffer, shader); return; }
-
-	DrawCommands(cai, buffer);
-	DrawBuffer(buffer, shader);
+	const CFactoryCAI* fcai = dynamic_cast<const CFactoryCAI*>(cai);
+
+	const unsigned int cmdQueVersion = cai->commandQue.GetUpdateCounter();
+	const unsigned int nucQueVersion = (fcai != nullptr)? fcai->newUnitCommands.GetUpdateCounter(): -1u;
+
+	QueueDrawCache& cache = queueDrawCache[cai->owner->id];
+
+	// re-walk the queue only when it was mutated (or the entry expired);
+	// per-frame-varying positions stay symbolic inside the recorded ops
+	// and are resolved again on every execution
+	if (cache.cmdQueVersion != cmdQueVersion || cache.nucQueVersion != nucQueVersion || gs->frameNum >= cache.rebuildFrame) {
+		cache.drawOps.clear();
+
+		// note: {Air,Builder}CAI inherit from MobileCAI, so test that last
+		if (dynamic_cast<const CAirCAI*>(cai) != nullptr) {
+			BuildAirCAIDrawOps(static_cast<const CAirCAI*>(cai), cache.drawOps);
+		} else if (dynamic_cast<const CBuilderCAI*>(cai) != nullptr) {
+			BuildBuilderCAIDrawOps(static_cast<const CBuilderCAI*>(cai), cache.drawOps);
+		} else if (fcai != nullptr) {
+			BuildFactoryCAIDrawOps(fcai, cache.drawOps);
+		} else if (dynamic_cast<const CMobileCAI*>(cai) != nullptr) {
+			BuildMobileCAIDrawOps(static_cast<const CMobileCAI*>(cai), cache.drawOps);
+		} else {
+			BuildDrawOps(cai, cache.drawOps);
+		}
+
+		cache.cmdQueVersion = cmdQueVersion;
+		cache.nucQueVersion = nucQueVersion;
+		cache.rebuildFrame = gs->frameNum + (GAME_SPEED / 2);
+	}
+
+	ExecDrawOps(cache, cai->owner, buffer);
+
+	// hand off all surface circles
+	shader->Enable();
+	shader->SetUniformMatrix4x4<float>("u_movi_mat", false, viewMat);
+	shader->SetUniformMatrix4x4<float>("u_proj_mat", false, projMat);
+	buffer->Submit(GL_LINES);
+	shader->Disable();
+}
+
+
+CommandDrawer::QueuedCmdDrawOp CommandDrawer::LineIconOp(int cmdID, const float3& pos, const float* color)
+{
+	QueuedCmdDrawOp op;
+	op.opType = QueuedCmdDrawOp::OP_LINE_ICON;
+	op.cmdID = cmdID;
+	op.pos = pos;
+	op.color = color;
+	return op;
+}
+
+CommandDrawer::QueuedCmdDrawOp CommandDrawer::LineCircleOp(int cmdID, const float3& pos, const float* color, float radius, float circleRes)
+{
+	QueuedCmdDrawOp op;
+	op.opType = QueuedCmdDrawOp::OP_LINE_CIRCLE;
+	op.cmdID = cmdID;
+	op.pos = pos;
+	op.color = color;
+	op.radius = radius;
+	op.circleRes = circleRes;
+	return op;
+}
+
+CommandDrawer::QueuedCmdDrawOp CommandDrawer::IconLastOp(int cmdID)
+{
+	QueuedCmdDrawOp op;
+	op.opType = QueuedCmdDrawOp::OP_ICON_LAST;
+	op.cmdID = cmdID;
+	return op;
+}
+
+CommandDrawer::QueuedCmdDrawOp CommandDrawer::WaitIconOp(const Command& cmd)
+{
+	QueuedCmdDrawOp op;
+	op.opType = QueuedCmdDrawOp::OP_WAIT_ICON;
+	op.cmd = cmd;
+	return op;
+}
+
+CommandDrawer::QueuedCmdDrawOp CommandDrawer::BuildOp(int cmdID, const float3& pos, int facing, float extractRange)
+{
+	QueuedCmdDrawOp op;
+	op.opType = QueuedCmdDrawOp::OP_BUILD;
+	op.cmdID = cmdID;
+	op.pos = pos;
+	op.facing = facing;
+	op.radius = extractRange;
+	return op;
+}
+
+CommandDrawer::QueuedCmdDrawOp CommandDrawer::ObjLineOp(int opType, int cmdID, int objID, const float* color)
+{
+	QueuedCmdDrawOp op;
+	op.opType = opType;
+	op.cmdID = cmdID;
+	op.objID = objID;
+	op.color = color;
+	return op;
+}
+
+CommandDrawer::QueuedCmdDrawOp CommandDrawer::CustomCmdOp(const Command& cmd)
+{
+	QueuedCmdDrawOp op;
+	op.opType = QueuedCmdDrawOp::OP_CUSTOM;
+	op.cmd = cmd;
+	return op;
+}
+
+
+void CommandDrawer::ExecDrawOps(const QueueDrawCache& cache, const CUnit* owner, GL::RenderDataBufferC* rdb) const
+{
+	lineDrawer.StartPath(owner->GetObjDrawMidPos(), cmdColors.start);
+
+	if (owner->selfDCountdown != 0)
+		lineDrawer.DrawIconAtLastPos(CMD_SELFD);
+
+	for (const QueuedCmdDrawOp& op: cache.drawOps) {
+		switch (op.opType) {
+			case QueuedCmdDrawOp::OP_LINE_ICON: {
+				lineDrawer.DrawLineAndIcon(op.cmdID, op.pos, op.color);
+			} break;
+
+			case QueuedCmdDrawOp::OP_LINE_CIRCLE: {
+				lineDrawer.DrawLineAndIcon(op.cmdID, op.pos, op.color);
+				lineDrawer.Break(op.pos, op.color);
+				glSurfaceCircle(rdb, {op.pos, op.radius}, op.color, op.circleRes);
+				lineDrawer.RestartWithColor(op.color);
+			} break;
+
+			case QueuedCmdDrawOp::OP_ICON_LAST: {
+				lineDrawer.DrawIconAtLastPos(op.cmdID);
+			} break;
+
+			case QueuedCmdDrawOp::OP_WAIT_ICON: {
+				waitCommandsAI.AddIcon(op.cmd, lineDrawer.GetLastPos());
+			} break;
+
+			case QueuedCmdDrawOp::OP_BUILD: {
+				cursorIcons.AddBuildIcon(op.cmdID, op.pos, owner->team, op.facing);
+				lineDrawer.DrawLine(op.pos, cmdColors.build);
+
+				// draw metal extraction range
+				if (op.radius > 0.0f) {
+					lineDrawer.Break(op.pos, cmdColors.build);
+					glSurfaceCircle(rdb, {op.pos, op.radius}, cmdColors.rangeExtract, 40.0f);
+					lineDrawer.Restart();
+				}
+			} break;
+
+			case QueuedCmdDrawOp::OP_UNIT_LINE: {
+				const CUnit* unit = GetTrackableUnit(owner, unitHandler.GetUnit(op.objID));
+
+				if (unit != nullptr)
+					lineDrawer.DrawLineAndIcon(op.cmdID, unit->GetObjDrawErrorPos(owner->allyteam), op.color);
+
+			} break;
+
+			case QueuedCmdDrawOp::OP_UNIT_LINE_RAW: {
+				const CUnit* unit = unitHandler.GetUnitUnsafe(op.objID);
+
+				if (unit != nullptr)
+					lineDrawer.DrawLineAndIcon(op.cmdID, unit->pos, op.color);
+
+			} break;
+
+			case QueuedCmdDrawOp::OP_FEATURE_LINE: {
+				const CFeature* feature = featureHandler.GetFeature(op.objID);
+
+				if (feature != nullptr)
+					lineDrawer.DrawLineAndIcon(op.cmdID, feature->GetObjDrawMidPos(), op.color);
+
+			} break;
+
+			case QueuedCmdDrawOp::OP_CUSTOM: {
+				// colors and visibility of custom commands are Lua-mutable,
+				// so resolve their DrawData again on every execution
+				DrawDefaultCommand(op.cmd, owner, rdb);
+			} break;
+		}
+	}
 }
 
 
@@ -108,16 +274,10 @@ void CommandDrawer::DrawLuaQueuedUnitSetCommands(bool onMiniMap) const
 	glAttribStatePtr->EnableDepthTest();
 }
 
-void CommandDrawer::DrawCommands(const CCommandAI* cai, GL::RenderDataBufferC* rdb) const
+void CommandDrawer::BuildDrawOps(const CCommandAI* cai, std::vector<QueuedCmdDrawOp>& ops) const
 {
-	const CUnit* owner = cai->owner;
 	const CCommandQueue& commandQue = cai->commandQue;
 
-	lineDrawer.StartPath(owner->GetObjDrawMidPos(), cmdColors.start);
-
-	if (owner->selfDCountdown != 0)
-		lineDrawer.DrawIconAtLastPos(CMD_SELFD);
-
 	for (const auto& command: commandQue) {
 		const int cmdID = command.GetID();
 
@@ -125,11 +285,7 @@ void CommandDrawer::DrawCommands(const CCommandAI* cai, GL::RenderDataBufferC* r
 			case CMD_ATTACK:
 			case CMD_MANUALFIRE: {
 				if (command.GetNumParams() == 1) {
-					const CUnit* unit = GetTrackableUnit(owner, unitHandler.GetUnit(command.GetParam(0)));
-
-					if (unit != nullptr)
-						lineDrawer.DrawLineAndIcon(cmdID, unit->GetObjDrawErrorPos(owner->allyteam), cmdColors.attack);
-
+					ops.push_back(ObjLineOp(QueuedCmdDrawOp::OP_UNIT_LINE, cmdID, command.GetParam(0), cmdColors.attack));
 				} else {
 					assert(command.GetNumParams() >= 3);
 
@@ -137,19 +293,19 @@ void CommandDrawer::DrawCommands(const CCommandAI* cai, GL::RenderDataBufferC* r
 					const float z = command.GetParam(2);
 					const float y = CGround::GetHeightReal(x, z, false) + 3.0f;
 
-					lineDrawer.DrawLineAndIcon(cmdID, float3(x, y, z), cmdColors.attack);
+					ops.push_back(LineIconOp(cmdID, float3(x, y, z), cmdColors.attack));
 				}
 			} break;
 
 			case CMD_WAIT: {
-				DrawWaitIcon(command);
+				ops.push_back(WaitIconOp(command));
 			} break;
 			case CMD_SELFD: {
-				lineDrawer.DrawIconAtLastPos(cmdID);
+				ops.push_back(IconLastOp(cmdID));
 			} break;
 
 			default: {
-				DrawDefaultCommand(command, owner, rdb);
+				ops.push_back(CustomCmdOp(command));
 			} break;
 		}
 	}
@@ -157,37 +313,27 @@ void CommandDrawer::DrawCommands(const CCommandAI* cai, GL::RenderDataBufferC* r
 
 
 
-void CommandDrawer::DrawAirCAICommands(const CAirCAI* cai, GL::RenderDataBufferC* rdb) const
+void CommandDrawer::BuildAirCAIDrawOps(const CAirCAI* cai, std::vector<QueuedCmdDrawOp>& ops) const
 {
-	const CUnit* owner = cai->owner;
 	const CCommandQueue& commandQue = cai->commandQue;
 
-	lineDrawer.StartPath(owner->GetObjDrawMidPos(), cmdColors.start);
-
-	if (owner->selfDCountdown != 0)
-		lineDrawer.DrawIconAtLastPos(CMD_SELFD);
-
 	for (const auto& command: commandQue) {
 		const int cmdID = command.GetID();
 
 		switch (cmdID) {
 			case CMD_MOVE: {
-				lineDrawer.DrawLineAndIcon(cmdID, command.GetPos(0), cmdColors.move);
+				ops.push_back(LineIconOp(cmdID, command.GetPos(0), cmdColors.move));
 			} break;
 			case CMD_FIGHT: {
-				lineDrawer.DrawLineAndIcon(cmdID, command.GetPos(0), cmdColors.fight);
+				ops.push_back(LineIconOp(cmdID, command.GetPos(0), cmdColors.fight));
 			} break;
 			case CMD_PATROL: {
-				lineDrawer.DrawLineAndIcon(cmdID, command.GetPos(0), cmdColors.patrol);
+				ops.push_back(LineIconOp(cmdID, command.GetPos(0), cmdColors.patrol));
 			} break;
 
 			case CMD_ATTACK: {
 				if (command.GetNumParams() == 1) {
-					const CUnit* unit = GetTrackableUnit(owner, unitHandler.GetUnit(command.GetParam(0)));
-
-					if (unit != nullptr)
-						lineDrawer.DrawLineAndIcon(cmdID, unit->GetObjDrawErrorPos(owner->allyteam), cmdColors.attack);
-
+					ops.push_back(ObjLineOp(QueuedCmdDrawOp::OP_UNIT_LINE, cmdID, command.GetParam(0), cmdColors.attack));
 				} else {
 					assert(command.GetNumParams() >= 3);
 
@@ -195,36 +341,27 @@ void CommandDrawer::DrawAirCAICommands(const CAirCAI* cai, GL::RenderDataBufferC
 					const float z = command.GetParam(2);
 					const float y = CGround::GetHeightReal(x, z, false) + 3.0f;
 
-					lineDrawer.DrawLineAndIcon(cmdID, float3(x, y, z), cmdColors.attack);
+					ops.push_back(LineIconOp(cmdID, float3(x, y, z), cmdColors.attack));
 				}
 			} break;
 
 			case CMD_AREA_ATTACK: {
-				const float3& endPos = command.GetPos(0);
-
-				lineDrawer.DrawLineAndIcon(cmdID, endPos, cmdColors.attack);
-				lineDrawer.Break(endPos, cmdColors.attack);
-				glSurfaceCircle(rdb, {endPos, command.GetParam(3)}, cmdColors.attack, 20.0f);
-				lineDrawer.RestartWithColor(cmdColors.attack);
+				ops.push_back(LineCircleOp(cmdID, command.GetPos(0), cmdColors.attack, command.GetParam(3), 20.0f));
 			} break;
 
 			case CMD_GUARD: {
-				const CUnit* unit = GetTrackableUnit(owner, unitHandler.GetUnit(command.GetParam(0)));
-
-				if (unit != nullptr)
-					lineDrawer.DrawLineAndIcon(cmdID, unit->GetObjDrawErrorPos(owner->allyteam), cmdColors.guard);
-
+				ops.push_back(ObjLineOp(QueuedCmdDrawOp::OP_UNIT_LINE, cmdID, command.GetParam(0), cmdColors.guard));
 			} break;
 
 			case CMD_WAIT: {
-				DrawWaitIcon(command);
+				ops.push_back(WaitIconOp(command));
 			} break;
 			case CMD_SELFD: {
-				lineDrawer.DrawIconAtLastPos(cmdID);
+				ops.push_back(IconLastOp(cmdID));
 			} break;
 
 			default: {
-				DrawDefaultCommand(command, owner, rdb);
+				ops.push_back(CustomCmdOp(command));
 			} break;
 		}
 	}
@@ -232,16 +369,11 @@ void CommandDrawer::DrawAirCAICommands(const CAirCAI* cai, GL::RenderDataBufferC
 
 
 
-void CommandDrawer::DrawBuilderCAICommands(const CBuilderCAI* cai, GL::RenderDataBufferC* rdb) const
+void CommandDrawer::BuildBuilderCAIDrawOps(const CBuilderCAI* cai, std::vector<QueuedCmdDrawOp>& ops) const
 {
 	const CUnit* owner = cai->owner;
 	const CCommandQueue& commandQue = cai->commandQue;
 
-	lineDrawer.StartPath(owner->GetObjDrawMidPos(), cmdColors.start);
-
-	if (owner->selfDCountdown != 0)
-		lineDrawer.DrawIconAtLastPos(CMD_SELFD);
-
 	for (const Command& ci: commandQue) {
 		const int cmdID = ci.GetID();
 
@@ -252,55 +384,34 @@ void CommandDrawer::DrawBuilderCAICommands(const CBuilderCAI* cai, GL::RenderDat
 				if (!bi.Parse(ci))
 					continue;
 
-				cursorIcons.AddBuildIcon(cmdID, bi.pos, owner->team, bi.buildFacing);
-				lineDrawer.DrawLine(bi.pos, cmdColors.build);
-
-				// draw metal extraction range
-				if (bi.def->extractRange > 0.0f) {
-					lineDrawer.Break(bi.pos, cmdColors.build);
-					glSurfaceCircle(rdb, {bi.pos, bi.def->extractRange}, cmdColors.rangeExtract, 40.0f);
-					lineDrawer.Restart();
-				}
+				ops.push_back(BuildOp(cmdID, bi.pos, bi.buildFacing, bi.def->extractRange));
 			}
 			continue;
 		}
 
 		switch (cmdID) {
 			case CMD_MOVE: {
-				lineDrawer.DrawLineAndIcon(cmdID, ci.GetPos(0), cmdColors.move);
+				ops.push_back(LineIconOp(cmdID, ci.GetPos(0), cmdColors.move));
 			} break;
 			case CMD_FIGHT:{
-				lineDrawer.DrawLineAndIcon(cmdID, ci.GetPos(0), cmdColors.fight);
+				ops.push_back(LineIconOp(cmdID, ci.GetPos(0), cmdColors.fight));
 			} break;
 			case CMD_PATROL: {
-				lineDrawer.DrawLineAndIcon(cmdID, ci.GetPos(0), cmdColors.patrol);
+				ops.push_back(LineIconOp(cmdID, ci.GetPos(0), cmdColors.patrol));
 			} break;
 
 			case CMD_GUARD: {
-				const CUnit* unit = GetTrackableUnit(owner, unitHandler.GetUnit(ci.GetParam(0)));
-
-				if (unit != nullptr)
-					lineDrawer.DrawLineAndIcon(cmdID, unit->GetObjDrawErrorPos(owner->allyteam), cmdColors.guard);
-
+				ops.push_back(ObjLineOp(QueuedCmdDrawOp::OP_UNIT_LINE, cmdID, ci.GetParam(0), cmdColors.guard));
 			} break;
 
 			case CMD_RESTORE: {
-				const float3& endPos = ci.GetPos(0);
-
-				lineDrawer.DrawLineAndIcon(cmdID, endPos, cmdColors.restore);
-				lineDrawer.Break(endPos, cmdColors.restore);
-				glSurfaceCircle(rdb, {endPos, ci.GetParam(3)}, cmdColors.restore, 20.0f);
-				lineDrawer.RestartWithColor(cmdColors.restore);
+				ops.push_back(LineCircleOp(cmdID, ci.GetPos(0), cmdColors.restore, ci.GetParam(3), 20.0f));
 			} break;
 
 			case CMD_ATTACK:
 			case CMD_MANUALFIRE: {
 				if (ci.GetNumParams() == 1) {
-					const CUnit* unit = GetTrackableUnit(owner, unitHandler.GetUnit(ci.GetParam(0)));
-
-					if (unit != nullptr)
-						lineDrawer.DrawLineAndIcon(cmdID, unit->GetObjDrawErrorPos(owner->allyteam), cmdColors.attack);
-
+					ops.push_back(ObjLineOp(QueuedCmdDrawOp::OP_UNIT_LINE, cmdID, ci.GetParam(0), cmdColors.attack));
 				} else {
 					assert(ci.GetNumParams() >= 3);
 
@@ -308,7 +419,7 @@ void CommandDrawer::DrawBuilderCAICommands(const CBuilderCAI* cai, GL::RenderDat
 					const float z = ci.GetParam(2);
 					const float y = CGround::GetHeightReal(x, z, false) + 3.0f;
 
-					lineDrawer.DrawLineAndIcon(cmdID, float3(x, y, z), cmdColors.attack);
+					ops.push_back(LineIconOp(cmdID, float3(x, y, z), cmdColors.attack));
 				}
 			} break;
 
@@ -317,28 +428,17 @@ void CommandDrawer::DrawBuilderCAICommands(const CBuilderCAI* cai, GL::RenderDat
 				const float* color = (cmdID == CMD_RECLAIM) ? cmdColors.reclaim
 				                                             : cmdColors.resurrect;
 				if (ci.GetNumParams() == 4) {
-					const float3& endPos = ci.GetPos(0);
-
-					lineDrawer.DrawLineAndIcon(cmdID, endPos, color);
-					lineDrawer.Break(endPos, color);
-					glSurfaceCircle(rdb, {endPos, ci.GetParam(3)}, color, 20.0f);
-					lineDrawer.RestartWithColor(color);
+					ops.push_back(LineCircleOp(cmdID, ci.GetPos(0), color, ci.GetParam(3), 20.0f));
 				} else {
 					assert(ci.GetParam(0) >= 0.0f);
 
 					const unsigned int id = std::max(0.0f, ci.GetParam(0));
 
 					if (id >= unitHandler.MaxUnits()) {
-						const CFeature* feature = featureHandler.GetFeature(id - unitHandler.MaxUnits());
-
-						if (feature != nullptr)
-							lineDrawer.DrawLineAndIcon(cmdID, feature->GetObjDrawMidPos(), color);
-
+						ops.push_back(ObjLineOp(QueuedCmdDrawOp::OP_FEATURE_LINE, cmdID, id - unitHandler.MaxUnits(), color));
 					} else {
-						const CUnit* unit = GetTrackableUnit(owner, unitHandler.GetUnit(id));
-
-						if (unit != nullptr && unit != owner)
-							lineDrawer.DrawLineAndIcon(cmdID, unit->GetObjDrawErrorPos(owner->allyteam), color);
+						if (id != owner->id)
+							ops.push_back(ObjLineOp(QueuedCmdDrawOp::OP_UNIT_LINE, cmdID, id, color));
 
 					}
 				}
@@ -349,36 +449,26 @@ void CommandDrawer::DrawBuilderCAICommands(const CBuilderCAI* cai, GL::RenderDat
 				const float* color = (ci.GetID() == CMD_REPAIR) ? cmdColors.repair: cmdColors.capture;
 
 				if (ci.GetNumParams() == 4) {
-					const float3& endPos = ci.GetPos(0);
-
-					lineDrawer.DrawLineAndIcon(cmdID, endPos, color);
-					lineDrawer.Break(endPos, color);
-					glSurfaceCircle(rdb, {endPos, ci.GetParam(3)}, color, 20.0f);
-					lineDrawer.RestartWithColor(color);
+					ops.push_back(LineCircleOp(cmdID, ci.GetPos(0), color, ci.GetParam(3), 20.0f));
 				} else {
-					if (ci.GetNumParams() >= 1) {
-						const CUnit* unit = GetTrackableUnit(owner, unitHandler.GetUnit(ci.GetParam(0)));
-
-						if (unit != nullptr)
-							lineDrawer.DrawLineAndIcon(cmdID, unit->GetObjDrawErrorPos(owner->allyteam), color);
+					if (ci.GetNumParams() >= 1)
+						ops.push_back(ObjLineOp(QueuedCmdDrawOp::OP_UNIT_LINE, cmdID, ci.GetParam(0), color));
 
-					}
 				}
 			} break;
 
 			case CMD_LOAD_ONTO: {
-				const CUnit* unit = unitHandler.GetUnitUnsafe(ci.GetParam(0));
-				lineDrawer.DrawLineAndIcon(cmdID, unit->pos, cmdColors.load);
+				ops.push_back(ObjLineOp(QueuedCmdDrawOp::OP_UNIT_LINE_RAW, cmdID, ci.GetParam(0), cmdColors.load));
 			} break;
 			case CMD_WAIT: {
-				DrawWaitIcon(ci);
+				ops.push_back(WaitIconOp(ci));
 			} break;
 			case CMD_SELFD: {
-				lineDrawer.DrawIconAtLastPos(ci.GetID());
+				ops.push_back(IconLastOp(ci.GetID()));
 			} break;
 
 			default: {
-				DrawDefaultCommand(ci, owner, rdb);
+				ops.push_back(CustomCmdOp(ci));
 			} break;
 		}
 	}
@@ -386,41 +476,31 @@ void CommandDrawer::DrawBuilderCAICommands(const CBuilderCAI* cai, GL::RenderDat
 
 
 
-void CommandDrawer::DrawFactoryCAICommands(const CFactoryCAI* cai, GL::RenderDataBufferC* rdb) const
+void CommandDrawer::BuildFactoryCAIDrawOps(const CFactoryCAI* cai, std::vector<QueuedCmdDrawOp>& ops) const
 {
-	const CUnit* owner = cai->owner;
 	const CCommandQueue& commandQue = cai->commandQue;
 	const CCommandQueue& newUnitCommands = cai->newUnitCommands;
 
-	lineDrawer.StartPath(owner->GetObjDrawMidPos(), cmdColors.start);
-
-	if (owner->selfDCountdown != 0)
-		lineDrawer.DrawIconAtLastPos(CMD_SELFD);
-
 	if (!commandQue.empty() && (commandQue.front().GetID() == CMD_WAIT))
-		DrawWaitIcon(commandQue.front());
+		ops.push_back(WaitIconOp(commandQue.front()));
 
 	for (const Command& ci: newUnitCommands) {
 		const int cmdID = ci.GetID();
 
 		switch (cmdID) {
 			case CMD_MOVE: {
-				lineDrawer.DrawLineAndIcon(cmdID, ci.GetPos(0) + UpVector * 3.0f, cmdColors.move);
+				ops.push_back(LineIconOp(cmdID, ci.GetPos(0) + UpVector * 3.0f, cmdColors.move));
 			} break;
 			case CMD_FIGHT: {
-				lineDrawer.DrawLineAndIcon(cmdID, ci.GetPos(0) + UpVector * 3.0f, cmdColors.fight);
+				ops.push_back(LineIconOp(cmdID, ci.GetPos(0) + UpVector * 3.0f, cmdColors.fight));
 			} break;
 			case CMD_PATROL: {
-				lineDrawer.DrawLineAndIcon(cmdID, ci.GetPos(0) + UpVector * 3.0f, cmdColors.patrol);
+				ops.push_back(LineIconOp(cmdID, ci.GetPos(0) + UpVector * 3.0f, cmdColors.patrol));
 			} break;
 
 			case CMD_ATTACK: {
 				if (ci.GetNumParams() == 1) {
-					const CUnit* unit = GetTrackableUnit(owner, unitHandler.GetUnit(ci.GetParam(0)));
-
-					if (unit != nullptr)
-						lineDrawer.DrawLineAndIcon(cmdID, unit->GetObjDrawErrorPos(owner->allyteam), cmdColors.attack);
-
+					ops.push_back(ObjLineOp(QueuedCmdDrawOp::OP_UNIT_LINE, cmdID, ci.GetParam(0), cmdColors.attack));
 				} else {
 					assert(ci.GetNumParams() >= 3);
 
@@ -428,27 +508,23 @@ void CommandDrawer::DrawFactoryCAICommands(const CFactoryCAI* cai, GL::RenderDat
 					const float z = ci.GetParam(2);
 					const float y = CGround::GetHeightReal(x, z, false) + 3.0f;
 
-					lineDrawer.DrawLineAndIcon(cmdID, float3(x, y, z), cmdColors.attack);
+					ops.push_back(LineIconOp(cmdID, float3(x, y, z), cmdColors.attack));
 				}
 			} break;
 
 			case CMD_GUARD: {
-				const CUnit* unit = GetTrackableUnit(owner, unitHandler.GetUnit(ci.GetParam(0)));
-
-				if (unit != nullptr)
-					lineDrawer.DrawLineAndIcon(cmdID, unit->GetObjDrawErrorPos(owner->allyteam), cmdColors.guard);
-
+				ops.push_back(ObjLineOp(QueuedCmdDrawOp::OP_UNIT_LINE, cmdID, ci.GetParam(0), cmdColors.guard));
 			} break;
 
 			case CMD_WAIT: {
-				DrawWaitIcon(ci);
+				ops.push_back(WaitIconOp(ci));
 			} break;
 			case CMD_SELFD: {
-				lineDrawer.DrawIconAtLastPos(cmdID);
+				ops.push_back(IconLastOp(cmdID));
 			} break;
 
 			default: {
-				DrawDefaultCommand(ci, owner, rdb);
+				ops.push_back(CustomCmdOp(ci));
 			} break;
 		}
 
@@ -458,130 +534,86 @@ void CommandDrawer::DrawFactoryCAICommands(const CFactoryCAI* cai, GL::RenderDat
 			if (!bi.Parse(ci))
 				continue;
 
-			cursorIcons.AddBuildIcon(cmdID, bi.pos, owner->team, bi.buildFacing);
-			lineDrawer.DrawLine(bi.pos, cmdColors.build);
-
-			// draw metal extraction range
-			if (bi.def->extractRange > 0.0f) {
-				lineDrawer.Break(bi.pos, cmdColors.build);
-				glSurfaceCircle(rdb, {bi.pos, bi.def->extractRange}, cmdColors.rangeExtract, 40.0f);
-				lineDrawer.Restart();
-			}
+			ops.push_back(BuildOp(cmdID, bi.pos, bi.buildFacing, bi.def->extractRange));
 		}
 	}
 }
 
 
 
-void CommandDrawer::DrawMobileCAICommands(const CMobileCAI* cai, GL::RenderDataBufferC* rdb) const
+void CommandDrawer::BuildMobileCAIDrawOps(const CMobileCAI* cai, std::vector<QueuedCmdDrawOp>& ops) const
 {
-	const CUnit* owner = cai->owner;
 	const CCommandQueue& commandQue = cai->commandQue;
 
-	lineDrawer.StartPath(owner->GetObjDrawMidPos(), cmdColors.start);
-
-	if (owner->selfDCountdown != 0)
-		lineDrawer.DrawIconAtLastPos(CMD_SELFD);
-
 	for (const auto& command: commandQue) {
 		const int cmdID = command.GetID();
 
 		switch (cmdID) {
 			case CMD_MOVE: {
-				lineDrawer.DrawLineAndIcon(cmdID, command.GetPos(0), cmdColors.move);
+				ops.push_back(LineIconOp(cmdID, command.GetPos(0), cmdColors.move));
 			} break;
 			case CMD_PATROL: {
-				lineDrawer.DrawLineAndIcon(cmdID, command.GetPos(0), cmdColors.patrol);
+				ops.push_back(LineIconOp(cmdID, command.GetPos(0), cmdColors.patrol));
 			} break;
 			case CMD_FIGHT: {
 				if (command.GetNumParams() >= 3)
-					lineDrawer.DrawLineAndIcon(cmdID, command.GetPos(0), cmdColors.fight);
+					ops.push_back(LineIconOp(cmdID, command.GetPos(0), cmdColors.fight));
 
 			} break;
 
 			case CMD_ATTACK:
 			case CMD_MANUALFIRE: {
-				if (command.GetNumParams() == 1) {
-					const CUnit* unit = GetTrackableUnit(owner, unitHandler.GetUnit(command.GetParam(0)));
-
-					if (unit != nullptr)
-						lineDrawer.DrawLineAndIcon(cmdID, unit->GetObjDrawErrorPos(owner->allyteam), cmdColors.attack);
-
-				}
+				if (command.GetNumParams() == 1)
+					ops.push_back(ObjLineOp(QueuedCmdDrawOp::OP_UNIT_LINE, cmdID, command.GetParam(0), cmdColors.attack));
 
 				if (command.GetNumParams() >= 3) {
 					const float x = command.GetParam(0);
 					const float z = command.GetParam(2);
 					const float y = CGround::GetHeightReal(x, z, false) + 3.0f;
 
-					lineDrawer.DrawLineAndIcon(cmdID, float3(x, y, z), cmdColors.attack);
+					ops.push_back(LineIconOp(cmdID, float3(x, y, z), cmdColors.attack));
 				}
 			} break;
 
 			case CMD_GUARD: {
-				const CUnit* unit = GetTrackableUnit(owner, unitHandler.GetUnit(command.GetParam(0)));
-
-				if (unit != nullptr)
-					lineDrawer.DrawLineAndIcon(cmdID, unit->GetObjDrawErrorPos(owner->allyteam), cmdColors.guard);
-
+				ops.push_back(ObjLineOp(QueuedCmdDrawOp::OP_UNIT_LINE, cmdID, command.GetParam(0), cmdColors.guard));
 			} break;
 
 			case CMD_LOAD_ONTO: {
-				const CUnit* unit = unitHandler.GetUnitUnsafe(command.GetParam(0));
-				lineDrawer.DrawLineAndIcon(cmdID, unit->pos, cmdColors.load);
+				ops.push_back(ObjLineOp(QueuedCmdDrawOp::OP_UNIT_LINE_RAW, cmdID, command.GetParam(0), cmdColors.load));
 			} break;
 
 			case CMD_LOAD_UNITS: {
 				if (command.GetNumParams() == 4) {
-					const float3& endPos = command.GetPos(0);
-
-					lineDrawer.DrawLineAndIcon(cmdID, endPos, cmdColors.load);
-					lineDrawer.Break(endPos, cmdColors.load);
-					glSurfaceCircle(rdb, {endPos, command.GetParam(3)}, cmdColors.load, 20.0f);
-					lineDrawer.RestartWithColor(cmdColors.load);
+					ops.push_back(LineCircleOp(cmdID, command.GetPos(0), cmdColors.load, command.GetParam(3), 20.0f));
 				} else {
-					const CUnit* unit = GetTrackableUnit(owner, unitHandler.GetUnit(command.GetParam(0)));
-
-					if (unit != nullptr)
-						lineDrawer.DrawLineAndIcon(cmdID, unit->GetObjDrawErrorPos(owner->allyteam), cmdColors.load);
-
+					ops.push_back(ObjLineOp(QueuedCmdDrawOp::OP_UNIT_LINE, cmdID, command.GetParam(0), cmdColors.load));
 				}
 			} break;
 
 			case CMD_UNLOAD_UNITS: {
-				if (command.GetNumParams() == 5) {
-					const float3& endPos = command.GetPos(0);
+				if (command.GetNumParams() == 5)
+					ops.push_back(LineCircleOp(cmdID, command.GetPos(0), cmdColors.unload, command.GetParam(3), 20.0f));
 
-					lineDrawer.DrawLineAndIcon(cmdID, endPos, cmdColors.unload);
-					lineDrawer.Break(endPos, cmdColors.unload);
-					glSurfaceCircle(rdb, {endPos, command.GetParam(3)}, cmdColors.unload, 20.0f);
-					lineDrawer.RestartWithColor(cmdColors.unload);
-				}
 			} break;
 
 			case CMD_UNLOAD_UNIT: {
-				lineDrawer.DrawLineAndIcon(cmdID, command.GetPos(0), cmdColors.unload);
+				ops.push_back(LineIconOp(cmdID, command.GetPos(0), cmdColors.unload));
 			} break;
 			case CMD_WAIT: {
-				DrawWaitIcon(command);
+				ops.push_back(WaitIconOp(command));
 			} break;
 			case CMD_SELFD: {
-				lineDrawer.DrawIconAtLastPos(cmdID);
+				ops.push_back(IconLastOp(cmdID));
 			} break;
 
 			default: {
-				DrawDefaultCommand(command, owner, rdb);
+				ops.push_back(CustomCmdOp(command));
 			} break;
 		}
 	}
 }
 
-
-void CommandDrawer::DrawWaitIcon(const Command& cmd) const
-{
-	waitCommandsAI.AddIcon(cmd, lineDrawer.GetLastPos());
-}
-
 void CommandDrawer::DrawDefaultCommand(const Command& c, const CUnit* owner, GL::RenderDataBufferC* rdb) const
 {
 	// TODO add Lua callin perhaps, for more elaborate needs?
@@ -3,10 +3,14 @@
 #ifndef COMMAND_DRAWER_H
 #define COMMAND_DRAWER_H
 
+#include <vector>
+
 #include "Rendering/GL/RenderDataBufferFwd.hpp"
+#include "Sim/Units/CommandAI/Command.h"
+#include "System/float3.h"
+#include "System/UnorderedMap.hpp"
 #include "System/UnorderedSet.hpp"
 
-struct Command;
 class CCommandAI;
 class CAirCAI;
 class CBuilderCAI;
@@ -19,7 +23,14 @@ public:
 	static CommandDrawer* GetInstance();
 
 	// clear the set after WorldDrawer and MiniMap have both used it
-	void Update() { luaQueuedUnitSet.clear(); }
+	void Update() {
+		luaQueuedUnitSet.clear();
+
+		// deselected and dead units leave stale entries behind; just
+		// start over once the cache outgrows any plausible selection
+		if (queueDrawCache.size() > 4096)
+			queueDrawCache.clear();
+	}
 
 	void Draw(const CCommandAI*, bool onMiniMap) const;
 	void DrawLuaQueuedUnitSetCommands(bool onMiniMap) const;
@@ -30,13 +41,65 @@ public:
 	void SetBuildQueueSquareColor(const float* color) { buildQueueSquareColor = color; }
 
 private:
-	void DrawCommands(const CCommandAI*, GL::RenderDataBufferC* rdb) const;
-	void DrawAirCAICommands(const CAirCAI*, GL::RenderDataBufferC* rdb) const;
-	void DrawBuilderCAICommands(const CBuilderCAI*, GL::RenderDataBufferC* rdb) const;
-	void DrawFactoryCAICommands(const CFactoryCAI*, GL::RenderDataBufferC* rdb) const;
-	void DrawMobileCAICommands(const CMobileCAI*, GL::RenderDataBufferC* rdb) const;
+	// a recorded lineDrawer/cursorIcons call; positions that can change
+	// between frames (trackable targets, custom commands) stay symbolic
+	// and are resolved again on every execution
+	struct QueuedCmdDrawOp {
+		enum {
+			OP_LINE_ICON    = 0, // line + cursor-icon to an absolute position
+			OP_LINE_CIRCLE  = 1, // as OP_LINE_ICON, plus a surface circle
+			OP_ICON_LAST    = 2, // cursor-icon at the current path position
+			OP_WAIT_ICON    = 3, // wait-state icon at the current path position
+			OP_BUILD        = 4, // queued-build icon + line (+ extraction range)
+			OP_UNIT_LINE    = 5, // line + icon to a trackable unit, if visible
+			OP_UNIT_LINE_RAW= 6, // line + icon to a unit, no visibility check
+			OP_FEATURE_LINE = 7, // line + icon to a feature, if it still exists
+			OP_CUSTOM       = 8, // custom command, handled by DrawDefaultCommand
+		};
+
+		int opType = 0;
+		int cmdID = 0;
+		int objID = 0; // unit- or feature-id for the OP_*_LINE types
+		int facing = 0; // OP_BUILD only
+
+		float radius = 0.0f; // circle (or extraction-range) radius
+		float circleRes = 0.0f;
+
+		float3 pos;
+
+		const float* color = nullptr; // points into cmdColors, stable
+
+		Command cmd; // OP_WAIT_ICON and OP_CUSTOM only
+	};
+
+	struct QueueDrawCache {
+		unsigned int cmdQueVersion = -1u;
+		unsigned int nucQueVersion = -1u; // factories only
+
+		// ground heights sampled at build time can go stale through
+		// terrain deformation, so entries also expire periodically
+		int rebuildFrame = 0;
+
+		std::vector<QueuedCmdDrawOp> drawOps;
+	};
+
+private:
+	static QueuedCmdDrawOp LineIconOp(int cmdID, const float3& pos, const float* color);
+	static QueuedCmdDrawOp LineCircleOp(int cmdID, const float3& pos, const float* color, float radius, float circleRes);
+	static QueuedCmdDrawOp IconLastOp(int cmdID);
+	static QueuedCmdDrawOp WaitIconOp(const Command& cmd);
+	static QueuedCmdDrawOp BuildOp(int cmdID, const float3& pos, int facing, float extractRange);
+	static QueuedCmdDrawOp ObjLineOp(int opType, int cmdID, int objID, const float* color);
+	static QueuedCmdDrawOp CustomCmdOp(const Command& cmd);
+
+	void BuildDrawOps(const CCommandAI*, std::vector<QueuedCmdDrawOp>& ops) const;
+	void BuildAirCAIDrawOps(const CAirCAI*, std::vector<QueuedCmdDrawOp>& ops) const;
+	void BuildBuilderCAIDrawOps(const CBuilderCAI*, std::vector<QueuedCmdDrawOp>& ops) const;
+	void BuildFactoryCAIDrawOps(const CFactoryCAI*, std::vector<QueuedCmdDrawOp>& ops) const;
+	void BuildMobileCAIDrawOps(const CMobileCAI*, std::vector<QueuedCmdDrawOp>& ops) const;
+
+	void ExecDrawOps(const QueueDrawCache& cache, const CUnit* owner, GL::RenderDataBufferC* rdb) const;
 
-	void DrawWaitIcon(const Command&) const;
 	void DrawDefaultCommand(const Command&, const CUnit*, GL::RenderDataBufferC* rdb) const;
 
 	void DrawQueuedBuildingSquaresAW(const CBuilderCAI* cai) const;
@@ -45,6 +108,9 @@ private:
 private:
 	spring::unordered_set<int> luaQueuedUnitSet;
 
+	// per-unit recorded command visualizations, rebuilt on queue mutation
+	mutable spring::unordered_map<int, QueueDrawCache> queueDrawCache;
+
 	// used by DrawQueuedBuildingSquares
 	const float* buildQueueSquareColor = nullptr;
 };
@@ -155,7 +155,17 @@ void DebugDrawerAI::Graph::AddPoint(int lineNum, float x, float y) {
 
 	Graph::GraphLine& line = lines[lineNum];
 
-	line.lineData.emplace_back(x, y, 0.0f);
+	line.lineData[(line.dataHead + line.dataCount) % GraphLine::MAX_LINE_POINTS] = float3(x, y, 0.0f);
+
+	if (line.dataCount < GraphLine::MAX_LINE_POINTS) {
+		line.dataCount += 1;
+	} else {
+		// ring is full and the oldest point was just overwritten; its
+		// extremes can no longer be trusted, recompute before drawing
+		line.dataHead = (line.dataHead + 1) % GraphLine::MAX_LINE_POINTS;
+		scalesDirty = true;
+	}
+
 	line.lineMin.x = std::min(line.lineMin.x, x);
 	line.lineMin.y = std::min(line.lineMin.y, y);
 	line.lineMax.x = std::max(line.lineMax.x, x);
@@ -177,34 +187,45 @@ void DebugDrawerAI::Graph::DelPoints(int lineNum, int numPoints) {
 
 	Graph::GraphLine& line = lit->second;
 
-	line.lineMin = GRAPH_MIN_SCALE;
-	line.lineMax = GRAPH_MAX_SCALE;
+	numPoints = std::min(numPoints, int(line.dataCount));
+
+	line.dataHead = (line.dataHead + numPoints) % GraphLine::MAX_LINE_POINTS;
+	line.dataCount -= numPoints;
 
+	RecalcScales();
+}
+
+void DebugDrawerAI::Graph::RecalcScales() {
 	minScale = GRAPH_MIN_SCALE;
 	maxScale = GRAPH_MAX_SCALE;
 
-	for (int i = 0; (i < numPoints && !line.lineData.empty()); i++) {
-		line.lineData.pop_front();
-	}
+	for (auto& pair: lines) {
+		Graph::GraphLine& line = pair.second;
 
-	// recalculate the line scales
-	for (const float3& coor: line.lineData) {
-		line.lineMin.x = std::min(line.lineMin.x, coor.x);
-		line.lineMin.y = std::min(line.lineMin.y, coor.y);
-		line.lineMax.x = std::max(line.lineMax.x, coor.x);
-		line.lineMax.y = std::max(line.lineMax.y, coor.y);
-	}
+		line.lineMin = GRAPH_MIN_SCALE;
+		line.lineMax = GRAPH_MAX_SCALE;
+
+		// recalculate the line scales
+		for (unsigned int i = 0; i < line.dataCount; i++) {
+			const float3& coor = line.PointAt(i);
+
+			line.lineMin.x = std::min(line.lineMin.x, coor.x);
+			line.lineMin.y = std::min(line.lineMin.y, coor.y);
+			line.lineMax.x = std::max(line.lineMax.x, coor.x);
+			line.lineMax.y = std::max(line.lineMax.y, coor.y);
+		}
 
-	// recalculate the graph scales
-	for (const auto& pair: lines) {
-		minScale.x = std::min((pair.second).lineMin.x, minScale.x);
-		minScale.y = std::min((pair.second).lineMin.y, minScale.y);
-		maxScale.x = std::max((pair.second).lineMax.x, maxScale.x);
-		maxScale.y = std::max((pair.second).lineMax.y, maxScale.y);
+		// recalculate the graph scales
+		minScale.x = std::min(line.lineMin.x, minScale.x);
+		minScale.y = std::min(line.lineMin.y, minScale.y);
+		maxScale.x = std::max(line.lineMax.x, maxScale.x);
+		maxScale.y = std::max(line.lineMax.y, maxScale.y);
 	}
 
 	scale.x = maxScale.x - minScale.x;
 	scale.y = maxScale.y - minScale.y;
+
+	scalesDirty = false;
 }
 
 void DebugDrawerAI::Graph::SetColor(int lineNum, const float3& c) {
@@ -233,13 +254,17 @@ void DebugDrawerAI::Graph::SetLabel(int lineNum, const std::string& s) {
 
 void DebugDrawerAI::Graph::Clear() {
 	for (auto& pair: lines) {
-		(pair.second).lineData.clear();
+		(pair.second).dataHead = 0;
+		(pair.second).dataCount = 0;
 	}
 }
 
 
 
 void DebugDrawerAI::Graph::Draw(GL::RenderDataBufferC* buffer, Shader::IProgramObject* shader) {
+	if (scalesDirty)
+		RecalcScales();
+
 	shader->Enable();
 	shader->SetUniformMatrix4x4<float>("u_movi_mat", false, CMatrix44f::Identity());
 	shader->SetUniformMatrix4x4<float>("u_proj_mat", false, CMatrix44f::ClipOrthoProj01(globalRendering->supportClipSpaceControl * 1.0f));
@@ -298,9 +323,8 @@ void DebugDrawerAI::Graph::Draw(GL::RenderDataBufferC* buffer, Shader::IProgramO
 
 			for (const auto& pair: lines) {
 				const Graph::GraphLine& line = pair.second;
-				const std::deque<float3>& data = line.lineData;
 
-				if (data.empty())
+				if (line.dataCount == 0)
 					continue;
 
 				// right-outline the labels
@@ -318,13 +342,49 @@ void DebugDrawerAI::Graph::Draw(GL::RenderDataBufferC* buffer, Shader::IProgramO
 
 				wla->SetWidth(line.lineWidth);
 
-				for (auto pit = data.begin(); pit != data.end(); ++pit) {
-					auto npit = pit; ++npit;
+				// decimate long histories to the on-screen width of the
+				// graph; only the min/max envelope per column of points
+				// survives, so draw cost stays bounded by resolution no
+				// matter how many points an AI has streamed in
+				static std::vector<unsigned int> indices;
+
+				const unsigned int numPoints = line.dataCount;
+				const unsigned int numCols = std::max(int(size.x * globalRendering->viewSizeX), 1);
+
+				indices.clear();
+
+				if (numPoints > (numCols * 2)) {
+					for (unsigned int n = 0; n < numCols; n++) {
+						const unsigned int i0 = (n * numPoints) / numCols;
+						const unsigned int i1 = std::max(((n + 1) * numPoints) / numCols, i0 + 1);
+
+						unsigned int minIdx = i0;
+						unsigned int maxIdx = i0;
+
+						for (unsigned int i = i0 + 1; i < i1; i++) {
+							minIdx = (line.PointAt(i).y < line.PointAt(minIdx).y)? i: minIdx;
+							maxIdx = (line.PointAt(i).y > line.PointAt(maxIdx).y)? i: maxIdx;
+						}
+
+						indices.push_back(std::min(minIdx, maxIdx));
+
+						if (minIdx != maxIdx)
+							indices.push_back(std::max(minIdx, maxIdx));
+					}
+				} else {
+					for (unsigned int i = 0; i < numPoints; i++) {
+						indices.push_back(i);
+					}
+				}
+
+				for (size_t n = 0; n < indices.size(); n++) {
+					const float3&  p = line.PointAt(indices[n]);
+					const float3& np = ((n + 1) == indices.size())? p: line.PointAt(indices[n + 1]);
 
-					const float px1 = ((pit->x - minScale.x) / scale.x) * size.x;
-					const float py1 = ((pit->y - minScale.y) / scale.y) * size.y;
-					const float px2 = (npit == data.end()) ? px1 : ((npit->x - minScale.x) / scale.x) * size.x;
-					const float py2 = (npit == data.end()) ? py1 : ((npit->y - minScale.y) / scale.y) * size.y;
+					const float px1 = (( p.x - minScale.x) / scale.x) * size.x;
+					const float py1 = (( p.y - minScale.y) / scale.y) * size.y;
+					const float px2 = ((np.x - minScale.x) / scale.x) * size.x;
+					const float py2 = ((np.y - minScale.y) / scale.y) * size.y;
 
 					wla->SafeAppend({pos + float3(px1, py1, 0.0f), {color}});
 					wla->SafeAppend({pos + float3(px2, py2, 0.0f), {color}});
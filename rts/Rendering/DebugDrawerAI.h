@@ -3,7 +3,6 @@
 #ifndef DEBUG_DRAWER_AI_HDR
 #define DEBUG_DRAWER_AI_HDR
 
-#include <deque>
 #include <vector>
 
 #include "Rendering/GL/RenderDataBufferFwd.hpp"
@@ -57,18 +56,32 @@ private:
 		void SetColor(int, const float3&);
 		void SetLabel(int, const std::string&);
 
+	private:
+		void RecalcScales();
+
 	private:
 		struct GraphLine {
 		public:
+			// bounds the per-line memory and draw cost; AIs can keep
+			// streaming points forever without tanking the framerate
+			static constexpr unsigned int MAX_LINE_POINTS = 4096;
+
 			GraphLine(const float3& mins = ZeroVector, const float3& maxs = ZeroVector):
 				lineMin(mins), lineMax(maxs),
 				lineWidth(2.0f),
 				lineLabelSize(0),
 				lineLabelWidth(0.0f),
 				lineLabelHeight(0.0f) {
+				lineData.resize(MAX_LINE_POINTS);
 			}
 
-			std::deque<float3> lineData;
+			const float3& PointAt(unsigned int i) const { return lineData[(dataHead + i) % MAX_LINE_POINTS]; }
+
+			// fixed-size ring; oldest points get overwritten when full
+			std::vector<float3> lineData;
+
+			unsigned int dataHead = 0;
+			unsigned int dataCount = 0;
 
 			float3 lineMin;
 			float3 lineMax;
@@ -92,6 +105,9 @@ private:
 
 		int minLabelSize; float minLabelWidth;
 		int maxLabelSize; float maxLabelWidth;
+
+		// set when ring overwrites invalidate the cached extremes
+		bool scalesDirty = false;
 	};
 
 	struct TexSet {
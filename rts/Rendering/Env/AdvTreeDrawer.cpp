@@ -106,7 +106,7 @@ void CAdvTreeDrawer::LoadTreeShaders() {
 		"groundShadowDensity", // FP, idx 12 (unused when TREE_SHADOW=0)
 		"gammaExponent",       // FP, idx 13
 
-		"treeMat",             // VP, idx TREE_MAT_IDX
+		"treeMats[0]",         // VP, idx TREE_MAT_IDX
 		"viewMat",             // VP, idx VIEW_MAT_IDX
 		"projMat",             // VP, idx PROJ_MAT_IDX
 	};
@@ -205,28 +205,6 @@ void CAdvTreeDrawer::Update()
 
 
 
-void CAdvTreeDrawer::DrawTree(const TreeStruct& ts, int treeMatIdx)
-{
-	const CFeature* f = featureHandler.GetFeature(ts.id);
-
-	if (f == nullptr)
-		return;
-	if (!f->IsInLosForAllyTeam(gu->myAllyTeam))
-		return;
-
-	#if 0
-	// assume all trees in a draw-quad are visible
-	if (!cam->InView(pos + (UpVector * (MAX_TREE_HEIGHT * 0.5f)), MAX_TREE_HEIGHT * 0.5f))
-		return;
-	#endif
-
-	treeShaders[TREE_PROGRAM_ACTIVE]->SetUniformMatrix4fv(treeMatIdx, false, ts.mat);
-
-	// done by DrawQuad
-	// BindTreeGeometry(ts.type);
-	DrawTreeGeometry(ts.type);
-}
-
 // only called from ITreeDrawer; no in-view test
 void CAdvTreeDrawer::DrawTree(const float3& pos, int treeType, int treeMatIdx)
 {
@@ -241,6 +219,29 @@ void CAdvTreeDrawer::BindTreeGeometry(int treeType) const { treeGen.BindTreeBuff
 void CAdvTreeDrawer::DrawTreeGeometry(int treeType) const { treeGen.DrawTreeBuffer(treeType); }
 
 
+void CAdvTreeDrawer::DrawTreeMatBatches(Shader::IProgramObject* ipo, int treeMatIdx)
+{
+	for (unsigned int treeType = 0; treeType < treeMatBatches.size(); treeType++) {
+		std::vector<CMatrix44f>& batch = treeMatBatches[treeType];
+
+		if (batch.empty())
+			continue;
+
+		BindTreeGeometry(treeType);
+
+		for (size_t n = 0; n < batch.size(); n += TREE_MAT_BATCH_SIZE) {
+			const size_t numTrees = std::min(batch.size() - n, TREE_MAT_BATCH_SIZE);
+
+			// negative count, skip the uniform-state comparison
+			ipo->SetUniformMatrix4fv(treeMatIdx, -int(numTrees), false, batch[n].m);
+			treeGen.DrawTreeBufferInstanced(treeType, numTrees);
+		}
+
+		batch.clear();
+	}
+}
+
+
 
 
 void CAdvTreeDrawer::SetupDrawState() { SetupDrawState(CCameraHandler::GetCamera(CCamera::CAMTYPE_PLAYER), treeShaders[shadowHandler.ShadowsLoaded()]); }
@@ -363,31 +364,40 @@ void CAdvTreeDrawer::DrawTrees(const CCamera* cam, Shader::IProgramObject* ipo)
 				const auto& treeSquare = treeSquares[(idx.y * NumTreesX()) + idx.x];
 				const auto& treeStructs = treeSquare.trees[i];
 
-				if (treeStructs.empty())
-					continue;
-
-				// bind once per draw-quad per tree-type (bush, pine) batch
-				BindTreeGeometry(i * NUM_TREE_TYPES);
-
 				for (const ITreeDrawer::TreeStruct& ts: treeStructs) {
 					if (rng.NextFloat() > drawProb)
 						continue;
 
-					DrawTree(ts, matUniformIdx);
+					const CFeature* f = featureHandler.GetFeature(ts.id);
+
+					if (f == nullptr)
+						continue;
+					if (!f->IsInLosForAllyTeam(gu->myAllyTeam))
+						continue;
+
+					#if 0
+					// assume all trees in a draw-quad are visible
+					if (!cam->InView(pos + (UpVector * (MAX_TREE_HEIGHT * 0.5f)), MAX_TREE_HEIGHT * 0.5f))
+						continue;
+					#endif
+
+					treeMatBatches[ts.type].push_back(ts.mat);
 				}
 			}
 		}
 	}
+
+	// geometry is bound once per sub-type, each batch of up to
+	// TREE_MAT_BATCH_SIZE same-type trees goes out in one instanced call
+	DrawTreeMatBatches(ipo, matUniformIdx);
 }
 
-void CAdvTreeDrawer::DrawFallingTrees(const CCamera* cam, Shader::IProgramObject* ipo) const
+void CAdvTreeDrawer::DrawFallingTrees(const CCamera* cam, Shader::IProgramObject* ipo)
 {
 	const int matUniformIdx = mix(TREE_MAT_IDX, 3, shadowHandler.InShadowPass());
 
 	// draw trees that have been marked as falling
 	for (int i = 0; i < 2; i++) {
-		BindTreeGeometry(i * NUM_TREE_TYPES);
-
 		for (const FallingTree& ft: fallingTrees[i]) {
 			// const CFeature* f = featureHandler.GetFeature(ft.id);
 			const float3 fpos = ft.fallMat.GetPos() - (UpVector * ft.fallAngle * 20.0f);
@@ -400,10 +410,11 @@ void CAdvTreeDrawer::DrawFallingTrees(const CCamera* cam, Shader::IProgramObject
 			if (!cam->InView(fpos + (UpVector * (MAX_TREE_HEIGHT * 0.5f)), MAX_TREE_HEIGHT * 0.5f))
 				continue;
 
-			ipo->SetUniformMatrix4fv(matUniformIdx, false, ft.fallMat);
-			DrawTreeGeometry(ft.type);
+			treeMatBatches[ft.type].push_back(ft.fallMat);
 		}
 	}
+
+	DrawTreeMatBatches(ipo, matUniformIdx);
 }
 
 void CAdvTreeDrawer::DrawPass()
@@ -29,14 +29,14 @@ public:
 	void SetupShadowDrawState(const CCamera* cam, Shader::IProgramObject* ipo);
 	void ResetShadowDrawState();
 	void DrawTrees(const CCamera* cam, Shader::IProgramObject* ipo);
-	void DrawFallingTrees(const CCamera* cam, Shader::IProgramObject* ipo) const;
+	void DrawFallingTrees(const CCamera* cam, Shader::IProgramObject* ipo);
 
 	void Update() override;
 	void DrawPass() override;
 	void DrawShadowPass() override;
 
-	void DrawTree(const TreeStruct& ts, int treeMatIdx);
 	void DrawTree(const float3& pos, int treeType, int treeMatIdx);
+	void DrawTreeMatBatches(Shader::IProgramObject* ipo, int treeMatIdx);
 	void BindTreeGeometry(int treeType) const;
 	void DrawTreeGeometry(int treeType) const;
 
@@ -57,6 +57,9 @@ public:
 	static constexpr int VIEW_MAT_IDX = 15;
 	static constexpr int PROJ_MAT_IDX = 16;
 
+	// number of mat4 uniform-array slots in Tree{ShadowGen,}VertProg
+	static constexpr size_t TREE_MAT_BATCH_SIZE = 64;
+
 private:
 	enum TreeShaderProgram {
 		TREE_PROGRAM_BASIC  = 0, // shader (V) without self-shadowing
@@ -68,6 +71,9 @@ private:
 	std::array<Shader::IProgramObject*, TREE_PROGRAM_LAST> treeShaders;
 	std::vector<FallingTree> fallingTrees[2];
 
+	// visible trees gathered per sub-type, flushed via instanced draws
+	std::array<std::vector<CMatrix44f>, NUM_TREE_TYPES * 2> treeMatBatches;
+
 	CAdvTreeGenerator treeGen;
 
 	float3 prvUpdateCamPos;
@@ -247,6 +247,17 @@ void CAdvTreeGenerator::DrawTreeBuffer(unsigned int treeType) const {
 	glDrawArrays(primTypes[pineType], baseType * MAX_TREE_VERTS, numTreeVerts[treeType]);
 }
 
+void CAdvTreeGenerator::DrawTreeBufferInstanced(unsigned int treeType, unsigned int numInsts) const {
+	treeType = mix(treeType + NUM_TREE_TYPES, treeType - NUM_TREE_TYPES, treeType >= NUM_TREE_TYPES);
+
+	constexpr unsigned int primTypes[] = {GL_TRIANGLES, GL_TRIANGLES};
+
+	const unsigned int pineType = (treeType >= NUM_TREE_TYPES);
+	const unsigned int baseType = treeType - (NUM_TREE_TYPES * pineType);
+
+	glDrawArraysInstanced(primTypes[pineType], baseType * MAX_TREE_VERTS, numTreeVerts[treeType], numInsts);
+}
+
 
 
 void CAdvTreeGenerator::DrawBushTrunk(const float3& start, const float3& end, const float3& orto1, const float3& orto2, float size)
@@ -309,6 +309,9 @@ void CAdvWater::UpdateWater(CGame* game)
 {
 	if (!waterRendering->forceRendering && !readMap->HasVisibleWater())
 		return;
+	// no water pixels can be drawn this frame, skip the reflection pass
+	if (!waterRendering->forceRendering && !IsWaterPlaneInView())
+		return;
 
 	glAttribStatePtr->PushColorBufferBit();
 	glAttribStatePtr->EnableBlendMask();
@@ -700,6 +700,12 @@ void CBumpWater::UpdateWater(CGame* game)
 	if (!waterRendering->forceRendering && !readMap->HasVisibleWater())
 		return;
 
+	// cheap counterpart to the occlusion query below; unlike the query
+	// it can never stall or lag a frame behind, but only catches the
+	// case where the surface is entirely outside the view frustum
+	if (!waterRendering->forceRendering && !IsWaterPlaneInView())
+		return;
+
 
 	if (occlusionQuery != 0 && !wasVisibleLastFrame) {
 		glGetQueryObjectuiv(occlusionQuery, GL_QUERY_RESULT_AVAILABLE, &occlusionQueryResult);
@@ -13,9 +13,12 @@
 #include "Rendering/Env/SunLighting.h"
 #include "Rendering/Env/CubeMapHandler.h"
 #include "System/Config/ConfigHandler.h"
+#include "System/SpringMath.h"
 
 CONFIG(int, CubeTexSizeReflection).defaultValue(128).minimumValue(1);
 CONFIG(bool, CubeTexGenerateMipMaps).defaultValue(false);
+CONFIG(bool, CubeTexUpdateOnChange).defaultValue(true)
+		.description("Refresh env-reflection cubemap faces only when the sun, lighting, terrain, or camera position changed; when disabled one face is redrawn every frame as before.");
 
 CubeMapHandler cubeMapHandler;
 
@@ -28,6 +31,14 @@ bool CubeMapHandler::Init() {
 	currReflectionFace = 0;
 
 	generateMipMaps = configHandler->GetBool("CubeTexGenerateMipMaps");
+	updateOnChange = configHandler->GetBool("CubeTexUpdateOnChange");
+
+	faceRotationActive = false;
+
+	prvUpdateTerrainGen = 0;
+	// force the first rotation to start immediately
+	prvUpdateCamPos = -OnesVector * 1e6f;
+	prvUpdateSunDir = float4(ZeroVector, 0.0f);
 
 	{
 		glGenTextures(1, &envReflectionTexID);
@@ -94,8 +105,46 @@ void CubeMapHandler::Free() {
 
 
 
+bool CubeMapHandler::ReflectionUpdateNeeded() const
+{
+	if (!updateOnChange)
+		return true;
+
+	// Lua-drawn skies can change arbitrarily between frames
+	if (sky->IsDynamic() || globalRendering->drawDebugCubeMap)
+		return true;
+
+	// sun moved, or Lua changed the lighting parameters
+	if (float4(sky->GetLight()->GetLightDir()) != prvUpdateSunDir)
+		return true;
+	if ((*sunLighting) != prvUpdateSunLight)
+		return true;
+
+	// visible terrain deformed since the last completed rotation
+	if (readMap->GetUnsyncedUpdateCount() != prvUpdateTerrainGen)
+		return true;
+
+	// nearby terrain shifts with parallax, distant content is direction-only
+	constexpr float maxCamDrift = SQUARE_SIZE * 2.0f;
+	return ((CCameraHandler::GetActiveCamera())->GetPos().SqDistance(prvUpdateCamPos) > Square(maxCamDrift));
+}
+
 void CubeMapHandler::UpdateReflectionTexture()
 {
+	// change-driven scheduling; on static maps with a fixed sun and a
+	// stationary camera, redrawing reflection faces is pure overhead
+	if (!faceRotationActive) {
+		if (!ReflectionUpdateNeeded())
+			return;
+
+		prvUpdateSunDir = sky->GetLight()->GetLightDir();
+		prvUpdateSunLight = *sunLighting;
+		prvUpdateTerrainGen = readMap->GetUnsyncedUpdateCount();
+		prvUpdateCamPos = (CCameraHandler::GetActiveCamera())->GetPos();
+
+		faceRotationActive = true;
+	}
+
 	// NOTE:
 	//   we unbind later in WorldDrawer::GenerateIBLTextures() to save render
 	//   context switches (which are one of the slowest OpenGL operations!)
@@ -134,6 +183,9 @@ void CubeMapHandler::UpdateReflectionTexture()
 		currReflectionFace %= 6;
 	}
 
+	// rotation wrapped around, all faces are up to date
+	faceRotationActive = (currReflectionFace != 0);
+
 	if (generateMipMaps && currReflectionFace == 0) {
 		glBindTexture(GL_TEXTURE_CUBE_MAP, envReflectionTexID);
 		glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
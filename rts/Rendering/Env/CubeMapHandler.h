@@ -4,6 +4,7 @@
 #define CUBEMAP_HANDLER_HDR
 
 #include "Rendering/GL/FBO.h"
+#include "Rendering/Env/SunLighting.h"
 
 class CubeMapHandler {
 public:
@@ -20,6 +21,7 @@ public:
 
 private:
 	void CreateReflectionFace(unsigned int, bool);
+	bool ReflectionUpdateNeeded() const;
 
 	unsigned int envReflectionTexID; // sky and map
 	unsigned int skyReflectionTexID; // sky only
@@ -29,6 +31,17 @@ private:
 
 	bool mapSkyReflections;
 	bool generateMipMaps;
+	bool updateOnChange;
+
+	// true while a started face rotation has not yet wrapped around;
+	// the contributing state below is snapshotted at rotation start,
+	// so changes made while one is in flight queue up the next one
+	bool faceRotationActive;
+
+	unsigned int prvUpdateTerrainGen;
+	float3 prvUpdateCamPos;
+	float4 prvUpdateSunDir;
+	CSunLighting prvUpdateSunLight;
 
 	FBO reflectionCubeFBO;
 
@@ -304,6 +304,11 @@ inline void CGroundDecalHandler::DrawObjectDecal(SolidObjectGroundDecal* decal)
 		decal->bufIndx = curBufferPos - mapBufferPtr;
 		decal->bufSize = nverts * sizeof(VA_TYPE_TC);
 
+		// pos{x,y} are multiples of SQUARE_SIZE, but pos might not be; bake
+		// the offset aligning the decal with the object on top of it into
+		// the vertices so the quad-matrix can stay identity while drawing
+		const float ofsx = (int(decal->pos.x) % SQUARE_SIZE) * 1.0f;
+		const float ofsz = (int(decal->pos.z) % SQUARE_SIZE) * 1.0f;
 
 		for (int vx = 0; vx < cxsize; vx++) {
 			for (int vz = 0; vz < czsize; vz++) {
@@ -341,7 +346,7 @@ inline void CGroundDecalHandler::DrawObjectDecal(SolidObjectGroundDecal* decal)
 				}
 
 				#define HEIGHT2WORLD(x) ((x) << 3)
-				#define VERTEX(x, y, z) float3(HEIGHT2WORLD((x)), (y), HEIGHT2WORLD((z)))
+				#define VERTEX(x, y, z) float3(HEIGHT2WORLD((x)) + ofsx, (y), HEIGHT2WORLD((z)) + ofsz)
 				*(curBufferPos++) = { VERTEX(px    , yv[0], pz    ),  uv[0], uv[1],  color}; // tl
 				*(curBufferPos++) = { VERTEX(px + 1, yv[1], pz    ),  uv[2], uv[3],  color}; // tr
 				*(curBufferPos++) = { VERTEX(px + 1, yv[2], pz + 1),  uv[4], uv[5],  color}; // br
@@ -357,15 +362,21 @@ inline void CGroundDecalHandler::DrawObjectDecal(SolidObjectGroundDecal* decal)
 		return;
 	}
 
-	// pos{x,y} are multiples of SQUARE_SIZE, but pos might not be
-	// shift the decal visually in the latter case so it is aligned
-	// with the object on top of it
-	const float3 pos{(int(decal->pos.x) % SQUARE_SIZE) * 1.0f, 0.0f, (int(decal->pos.z) % SQUARE_SIZE) * 1.0f};
-	const CMatrix44f mat{pos};
+	// bake the current alpha into the vertex stream (the fragment shader
+	// multiplies by the per-vertex color); rewriting these bytes in-place
+	// is what allows all decals of a type to share one multi-draw
+	const uint8_t alpha = uint8_t(Clamp(decal->alpha, 0.0f, 1.0f) * 255.0f);
 
-	decalShaders[DECAL_SHADER_CURR]->SetUniform1f(12, decal->alpha);
-	decalShaders[DECAL_SHADER_CURR]->SetUniformMatrix4fv(8, false, mat);
-	decalBuffer.Submit(GL_TRIANGLES, decalIdx, numVerts);
+	if (alpha != decal->alphaBaked) {
+		for (unsigned int i = 0; i < numVerts; i++) {
+			mapBufferPtr[decalIdx + i].c.a = alpha;
+		}
+
+		decal->alphaBaked = alpha;
+	}
+
+	batchFirsts.push_back(decalIdx);
+	batchCounts.push_back(numVerts);
 
 	#undef HEIGHT
 	#endif
@@ -447,12 +458,20 @@ inline void CGroundDecalHandler::DrawGroundScar(CGroundDecalHandler::Scar& scar)
 
 	// update scars only every *sim*frame, faster is pointless
 	// scars younger than 10 simframes decay at different rate
-	if (gs->frameNum != scar.lastUpdateFrame)
+	if (gs->frameNum != scar.lastUpdateFrame) {
 		scar.fadedAlpha = scarAlphaDecayFuncs[ (scar.creationTime + 10) <= gs->frameNum ](scar, scar.lastUpdateFrame = gs->frameNum);
 
-	decalShaders[DECAL_SHADER_CURR]->SetUniform1f(12, scar.fadedAlpha);
-	decalShaders[DECAL_SHADER_CURR]->SetUniformMatrix4fv(8, false, CMatrix44f::Identity());
-	decalBuffer.Submit(GL_TRIANGLES, decalIdx, numVerts);
+		// bake the faded alpha into the vertex stream so all scars can
+		// share one multi-draw (cf. DrawObjectDecal)
+		const uint8_t alpha = uint8_t(Clamp(scar.fadedAlpha, 0.0f, 1.0f) * 255.0f);
+
+		for (unsigned int i = 0; i < numVerts; i++) {
+			mapBufferPtr[decalIdx + i].c.a = alpha;
+		}
+	}
+
+	batchFirsts.push_back(decalIdx);
+	batchCounts.push_back(numVerts);
 	#endif
 }
 
@@ -537,9 +556,16 @@ void CGroundDecalHandler::DrawObjectDecals() {
 		if (!decalsToDraw.empty()) {
 			glBindTexture(GL_TEXTURE_2D, decalType.texture);
 
+			batchFirsts.clear();
+			batchCounts.clear();
+
 			for (SolidObjectGroundDecal* decal: decalsToDraw) {
 				DrawObjectDecal(decal);
 			}
+
+			// decals of one type share all texture and uniform state
+			if (!batchFirsts.empty())
+				decalBuffer.SubmitMulti(GL_TRIANGLES, batchFirsts.data(), batchCounts.data(), batchFirsts.size());
 		}
 
 		// glBindTexture(GL_TEXTURE_2D, 0);
@@ -575,6 +601,9 @@ void CGroundDecalHandler::AddScars()
 }
 
 void CGroundDecalHandler::DrawScars() {
+	batchFirsts.clear();
+	batchCounts.clear();
+
 	// create and draw the 16x16 quads for each ground scar
 	for (size_t i = 0; i < usedScarIDs.size(); ) {
 		Scar& scar = scars[ usedScarIDs[i] ];
@@ -590,6 +619,9 @@ void CGroundDecalHandler::DrawScars() {
 
 		i++;
 	}
+
+	if (!batchFirsts.empty())
+		decalBuffer.SubmitMulti(GL_TRIANGLES, batchFirsts.data(), batchCounts.data(), batchFirsts.size());
 }
 
 
@@ -664,6 +696,12 @@ void CGroundDecalHandler::BindShader(const float3& ambientColor)
 
 void CGroundDecalHandler::DrawDecals()
 {
+	// per-decal alphas are baked into the vertex stream and alignment
+	// offsets into the positions, so both uniforms stay constant here
+	// (tracks are drawn before this and set their own)
+	decalShaders[DECAL_SHADER_CURR]->SetUniform1f(12, 1.0f);
+	decalShaders[DECAL_SHADER_CURR]->SetUniformMatrix4fv(8, false, CMatrix44f::Identity());
+
 	// draw building decals
 	glAttribStatePtr->PolygonOffset(-10.0f, -200.0f);
 	DrawObjectDecals();
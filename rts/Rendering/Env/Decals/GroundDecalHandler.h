@@ -50,6 +50,7 @@ public:
 
 		radius       = d.radius;
 		alpha        = d.alpha;
+		alphaBaked   = d.alphaBaked;
 		alphaFalloff = d.alphaFalloff;
 		return *this;
 	}
@@ -74,6 +75,9 @@ public:
 	float radius = 0.0f;
 	float alpha = 1.0f;
 	float alphaFalloff = 1.0f;
+
+	// alpha value currently baked into the vertex stream
+	uint8_t alphaBaked = 255;
 };
 
 
@@ -245,6 +249,10 @@ private:
 	std::array<Shader::IProgramObject*, DECAL_SHADER_LAST> decalShaders;
 	std::vector<SolidObjectGroundDecal*> decalsToDraw;
 
+	// first/count vertex ranges into <decalBuffer> for the current batch
+	std::vector<int32_t> batchFirsts;
+	std::vector<int32_t> batchCounts;
+
 	std::vector<int> addedScars;
 
 	// stores indices into <scars> of reserved slots, per quad
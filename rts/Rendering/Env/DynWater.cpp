@@ -1275,7 +1275,20 @@ void CDynWater::DrawOuterSurface()
 
 #else
 
-CDynWater::CDynWater() = default;
+#include "System/Log/ILog.h"
+
+CDynWater::CDynWater()
+{
+	// NOTE:
+	//   the simulation in the disabled block above already ran fully on
+	//   the GPU (ping-pong FBO height-field passes, wakes and explosion
+	//   impulses injected as textured splat quads), but it was written
+	//   against ARB programs and CVertexArray and has not been ported
+	//   to the current pipeline; keep the mode selectable so configs do
+	//   not break, but make it obvious nothing will be drawn
+	LOG_L(L_WARNING, "[CDynWater] dynamic water is not implemented in this build, water will be invisible");
+}
+
 CDynWater::~CDynWater() = default;
 
 void CDynWater::Draw() {}
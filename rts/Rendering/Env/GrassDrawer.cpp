@@ -6,6 +6,7 @@
 #include "Game/Camera.h"
 #include "Game/CameraHandler.h"
 #include "Map/Ground.h"
+#include "Map/HeightMapTexture.h"
 #include "Map/MapInfo.h"
 #include "Map/ReadMap.h"
 #include "Rendering/GlobalRendering.h"
@@ -25,6 +26,7 @@
 #include "System/Config/ConfigHandler.h"
 #include "System/Color.h"
 #include "System/Exceptions.h"
+#include "System/float4.h"
 #include "System/StringUtil.h"
 #include "System/TimeProfiler.h"
 #include "System/Log/ILog.h"
@@ -33,9 +35,10 @@
 CONFIG(int, GrassDetail).defaultValue(7).headlessValue(0).minimumValue(0).description("Sets how detailed the engine rendered grass will be on any given map.");
 
 
-// uses a 'synced' RNG s.t. grass turfs generated from the same
-// seed also share identical sequences, otherwise an unpleasant
-// shimmering effect occurs when zooming
+// uses a 'synced' RNG s.t. turf geometry generated from the same
+// seed is identical across detail changes; placement randomness
+// lives in the vertex shader (hashed from gl_InstanceID) so turfs
+// do not shimmer when zooming either
 #if 0
 typedef CGlobalRNG<LCG16, true> GrassRNG;
 #else
@@ -67,10 +70,11 @@ static constexpr int   blockMapSize    = grassSquareSize * grassBlockSize;
 static constexpr int   GSSSQ = SQUARE_SIZE * grassSquareSize;
 static constexpr int   BMSSQ = SQUARE_SIZE * blockMapSize;
 
-static GrassRNG drawRNG;
 static GrassRNG turfRNG;
 
-static std::array<CMatrix44f, 128> turfMatrices;
+// per-block placement parameters consumed by the vertex shader,
+// which derives turf positions and density from gl_InstanceID
+static std::array<float4, 128> blockParams;
 
 static CGrassBlockDrawer blockDrawer;
 
@@ -165,7 +169,7 @@ void CGrassDrawer::ChangeDetail(int detail) {
 	grassDrawDist = std::sqrt(detail * 1.0f) * 100.0f;
 
 	// turfs per block
-	turfDetail.x = std::min(3 + int(minDetail * 0.5f), int(turfMatrices.size()));
+	turfDetail.x = std::min(3 + int(minDetail * 0.5f), 128);
 	// straws per turf
 	turfDetail.y = std::min(50 + int(std::sqrt(minDetail * 1.0f) * 10), mapInfo->grass.maxStrawsPerTurf);
 
@@ -199,7 +203,7 @@ bool CGrassDrawer::LoadGrassShaders() {
 
 		// idx 0, not settable as an array via name-based API
 		// needs to be named "[0]" or state-copying will fail
-		grassShaders[i]->SetUniformLocation("turfMatrices[0]");
+		grassShaders[i]->SetUniformLocation("blockParams[0]");
 
 		grassShaders[i]->Enable();
 		grassShaders[i]->SetUniform("mapSizePO2", 1.0f / (mapDims.pwr2mapx * SQUARE_SIZE), 1.0f / (mapDims.pwr2mapy * SQUARE_SIZE));
@@ -209,6 +213,7 @@ bool CGrassDrawer::LoadGrassShaders() {
 		grassShaders[i]->SetUniform("shadingTex",      2);
 		grassShaders[i]->SetUniform("infoMap",         3);
 		grassShaders[i]->SetUniform("shadowMap",       4);
+		grassShaders[i]->SetUniform("heightMapTex",    5);
 		grassShaders[i]->SetUniform("infoTexIntensityMul", 1.0f);
 		grassShaders[i]->SetUniform("specularExponent", sunLighting->specularExponent);
 		grassShaders[i]->SetUniform("groundShadowDensity", sunLighting->groundShadowDensity);
@@ -340,6 +345,7 @@ void CGrassDrawer::EnableShader(const GrassShaderProgram type) {
 	ipo->Enable();
 
 	ipo->SetUniform("frame", gs->frameNum + globalRendering->timeOffset);
+	ipo->SetUniform("turfsPerBlock", turfDetail.x);
 	ipo->SetUniform3v("windSpeed", &windSpeed.x);
 	ipo->SetUniform3v("camPos",    &camera->GetPos().x);
 	ipo->SetUniform3v("camDir",    &camera->GetDir().x);
@@ -376,16 +382,6 @@ void CGrassDrawer::EnableShader(const GrassShaderProgram type) {
 
 //////////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////////////////
-//
-// NB: has to use another RNG so density reduction is not influenced
-static float3 GetRandomTurfParams(const int2& blockPos)
-{
-	float3 p;
-	p.x = (blockPos.x + turfRNG.NextFloat()) * GSSSQ;
-	p.y = (blockPos.y + turfRNG.NextFloat()) * GSSSQ;
-	p.z = (turfRNG.NextFloat() * 360.0f) * math::DEG_TO_RAD; // rotation
-	return p;
-}
 
 static float GetGrassBlockCamDistSq(const float3& pos, const int2 coors)
 {
@@ -400,43 +396,21 @@ static float GetGrassBlockCamDistSq(const float3& pos, const int2 coors)
 
 
 
-unsigned int CGrassDrawer::DrawBlock(const float3& camPos, const int2& blockPos, unsigned int turfMatIndex)
+void CGrassDrawer::DrawBlocks(const CCamera* cam)
 {
-	const float blockDist = GetGrassBlockCamDistSq(camPos, blockPos);
-	const float drawProb = std::min(1.0f, Square(grassDrawDist) / blockDist);
-
-	if (drawProb < 0.001f)
-		return 0;
-
-	drawRNG.Seed(blockPos.y * (mapDims.mapx / grassSquareSize) + blockPos.x);
-	turfRNG.Seed(blockPos.y * (mapDims.mapx / grassSquareSize) + blockPos.x);
-
-	unsigned int numVisibleTurfs = 0;
-
-	// TODO: LODs?
-	for (int a = 0; a < turfDetail.x; a++) {
-		if (drawRNG.NextFloat() > drawProb)
-			continue;
-
-		const float3& rtp = GetRandomTurfParams(blockPos);
-		const float3  pos = {rtp.x, CGround::GetHeightReal(rtp.x, rtp.y, false) - CGround::GetSlope(rtp.x, rtp.y, false) * 30.0f, rtp.y};
-
-		turfMatrices[turfMatIndex + numVisibleTurfs].LoadIdentity();
-		turfMatrices[turfMatIndex + numVisibleTurfs].Translate(pos);
-		turfMatrices[turfMatIndex + numVisibleTurfs].RotateY(-rtp.z);
+	Shader::IProgramObject* grassShader = grassShaders[GRASS_PROGRAM_CURR];
 
-		numVisibleTurfs += 1;
-	}
+	const float3& camPos = cam->GetPos();
 
-	return numVisibleTurfs;
-}
+	const unsigned int maxBatchBlocks = blockParams.size();
+	      unsigned int numBatchBlocks = 0;
 
-void CGrassDrawer::DrawBlocks(const CCamera* cam)
-{
-	Shader::IProgramObject* grassShader = grassShaders[GRASS_PROGRAM_CURR];
+	const auto FlushBlocks = [&]() {
+		grassShader->SetUniform4fv(0, -int(numBatchBlocks), &blockParams[0].x);
+		grassBuffer.SubmitIndexedInstanced(GL_TRIANGLES, 0, grassBuffer.GetNumIndcs<uint32_t>(), numBatchBlocks * turfDetail.x);
 
-	const unsigned int maxTurfsPerBatch = turfMatrices.size() - turfDetail.x + 1;
-	      unsigned int numInstanceTurfs = 0;
+		numBatchBlocks = 0;
+	};
 
 	for (const int2 idx: blockDrawer.inViewQuads) {
 		for (int y = idx.y * grassBlockSize; y < (idx.y + 1) * grassBlockSize; ++y) {
@@ -444,23 +418,31 @@ void CGrassDrawer::DrawBlocks(const CCamera* cam)
 				if (grassMap[y * (mapDims.mapx / grassSquareSize) + x] == 0)
 					continue;
 
-				if ((numInstanceTurfs += DrawBlock(cam->GetPos(), {x, y}, numInstanceTurfs)) < maxTurfsPerBatch)
+				const float blockDist = GetGrassBlockCamDistSq(camPos, {x, y});
+				const float drawProb = std::min(1.0f, Square(grassDrawDist) / blockDist);
+
+				if (drawProb < 0.001f)
 					continue;
 
-				grassShader->SetUniformMatrix4fv(0, -int(numInstanceTurfs), false, &turfMatrices[0].m[0]);
-				grassBuffer.SubmitIndexedInstanced(GL_TRIANGLES, 0, grassBuffer.GetNumIndcs<uint32_t>(), numInstanceTurfs);
+				// turf positions, rotations and density thinning are all
+				// derived in the vertex shader from gl_InstanceID and the
+				// heightmap texture; the CPU only supplies these per-block
+				// parameters
+				blockParams[numBatchBlocks] = float4(x * 1.0f, y * 1.0f, drawProb, 0.0f);
 
-				numInstanceTurfs = 0;
+				if ((numBatchBlocks += 1) < maxBatchBlocks)
+					continue;
+
+				FlushBlocks();
 			}
 		}
 	}
 
-	if (numInstanceTurfs == 0)
+	if (numBatchBlocks == 0)
 		return;
 
 	// draw any leftovers
-	grassShader->SetUniformMatrix4fv(0, -int(numInstanceTurfs), false, &turfMatrices[0].m[0]);
-	grassBuffer.SubmitIndexedInstanced(GL_TRIANGLES, 0, grassBuffer.GetNumIndcs<uint32_t>(), numInstanceTurfs);
+	FlushBlocks();
 }
 
 
@@ -491,6 +473,10 @@ void CGrassDrawer::SetupStateShadow()
 {
 	EnableShader(GRASS_PROGRAM_SHADOW);
 
+	// vertex shader reads turf heights from the heightmap texture
+	glActiveTexture(GL_TEXTURE5);
+	glBindTexture(GL_TEXTURE_2D, heightMapTexture->GetTextureID());
+
 	glActiveTexture(GL_TEXTURE0);
 
 	glAttribStatePtr->DisableCullFace();
@@ -542,6 +528,8 @@ void CGrassDrawer::SetupStateOpaque()
 			glBindTexture(GL_TEXTURE_2D, readMap->GetShadingTexture());
 		glActiveTexture(GL_TEXTURE3);
 			glBindTexture(GL_TEXTURE_2D, infoTextureHandler->GetCurrentInfoTexture());
+		glActiveTexture(GL_TEXTURE5);
+			glBindTexture(GL_TEXTURE_2D, heightMapTexture->GetTextureID());
 	}
 
 	// bind shader
@@ -71,7 +71,6 @@ protected:
 	void SetupStateShadow();
 	void ResetStateShadow();
 
-	unsigned int DrawBlock(const float3& camPos, const int2& blockPos, unsigned int turfMatIndex);
 	void DrawBlocks(const CCamera* cam);
 
 protected:
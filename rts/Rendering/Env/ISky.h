@@ -24,6 +24,10 @@ public:
 
 	virtual void SetLuaTexture(const MapTextureData& td) {}
 
+	/// whether sky content can change from one frame to the next
+	/// without the engine knowing (e.g. Lua-drawn skies)
+	virtual bool IsDynamic() const { return false; }
+
 	const ISkyLight* GetLight() const { return &skyLight; }
 	      ISkyLight* GetLight()       { return &skyLight; }
 
@@ -6,6 +6,8 @@
 #include "AdvWater.h"
 #include "BumpWater.h"
 #include "DynWater.h"
+#include "Game/Camera.h"
+#include "Game/CameraHandler.h"
 #include "Game/Game.h"
 #include "Game/GameHelper.h"
 #include "Map/ReadMap.h"
@@ -149,6 +151,17 @@ void IWater::ExplosionOccurred(const CExplosionParams& event) {
 }
 
 
+bool IWater::IsWaterPlaneInView()
+{
+	const CCamera* cam = CCameraHandler::GetCamera(CCamera::CAMTYPE_PLAYER);
+
+	const float3 mins = {                             0.0f, std::min(readMap->GetCurrMinHeight(), 0.0f),                              0.0f};
+	const float3 maxs = {mapDims.mapx * SQUARE_SIZE * 1.0f,                                        0.0f, mapDims.mapy * SQUARE_SIZE * 1.0f};
+
+	return (cam->InView(mins, maxs));
+}
+
+
 void IWater::DrawReflections(bool drawGround, bool drawSky) {
 	game->SetDrawMode(Game::ReflectionDraw);
 
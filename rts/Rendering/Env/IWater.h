@@ -39,6 +39,12 @@ public:
 	bool BlockWakeProjectiles() const { return (GetID() == WATER_RENDERER_DYNAMIC); }
 	bool& WireFrameModeRef() { return wireFrameMode; }
 
+	// true if any part of the water surface (which extends from the
+	// lowest point of the map up to y=0) can appear inside the view
+	// frustum; the reflection and refraction passes redraw most of
+	// the scene and can be skipped entirely when it can not
+	static bool IsWaterPlaneInView();
+
 	static IWater* GetWater(IWater* curRenderer, int nxtRendererMode);
 
 	static void ApplyPushedChanges(CGame* game);
@@ -14,6 +14,9 @@ public:
 
 	void UpdateSunDir() override {}
 	void UpdateSkyTexture() override {}
+
+	// DrawSky callins can render anything
+	bool IsDynamic() const override { return true; }
 };
 
 #endif
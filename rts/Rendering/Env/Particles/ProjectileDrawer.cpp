@@ -39,6 +39,7 @@
 #include "System/Log/ILog.h"
 #include "System/SafeUtil.h"
 #include "System/StringUtil.h"
+#include "System/Threading/ThreadPool.h"
 
 
 CProjectileDrawer* projectileDrawer = nullptr;
@@ -49,6 +50,80 @@ CProjectileDrawer* projectileDrawer = nullptr;
 static uint8_t projectileDrawerMem[sizeof(CProjectileDrawer)];
 
 
+typedef std::pair<uint32_t, CProjectile*> ProjectileSortPair;
+
+// double-buffered between radix passes
+static std::vector<ProjectileSortPair> projectileSortPairs[2];
+
+// maps the IEEE bit-pattern of a (sort-)distance to an unsigned integer
+// with the same ordering, inverted s.t. ascending keys run back-to-front
+static uint32_t ProjectileSortKey(const CProjectile* p)
+{
+	union { float f; uint32_t u; } cvt = {p->GetSortDist()};
+
+	cvt.u ^= ((0u - (cvt.u >> 31)) | 0x80000000u);
+	return (~cvt.u);
+}
+
+// back-to-front LSD radix sort over depth keys; unlike the comparison
+// sort this stays linear when endgame battles push the particle count
+// into the tens of thousands
+static void SortProjectiles(std::vector<CProjectile*>& projectiles)
+{
+	constexpr uint32_t RADIX_BITS = 11;
+	constexpr uint32_t RADIX_SIZE = 1 << RADIX_BITS;
+	constexpr uint32_t NUM_PASSES = (32 + RADIX_BITS - 1) / RADIX_BITS;
+
+	// constant factors favor the comparison sort for small batches
+	if (projectiles.size() < 256) {
+		std::sort(projectiles.begin(), projectiles.end(), ProjectileDistanceComparator());
+		return;
+	}
+
+	std::vector<ProjectileSortPair>& src = projectileSortPairs[0];
+	std::vector<ProjectileSortPair>& dst = projectileSortPairs[1];
+
+	src.resize(projectiles.size());
+	dst.resize(projectiles.size());
+
+	for_mt(0, int(projectiles.size()), [&](const int i) {
+		src[i] = {ProjectileSortKey(projectiles[i]), projectiles[i]};
+	});
+
+	uint32_t counts[NUM_PASSES][RADIX_SIZE] = {{0}};
+
+	// build the histograms for all passes in a single sweep
+	for (const ProjectileSortPair& psp: src) {
+		for (uint32_t n = 0; n < NUM_PASSES; n++) {
+			counts[n][(psp.first >> (n * RADIX_BITS)) & (RADIX_SIZE - 1)] += 1;
+		}
+	}
+
+	for (uint32_t n = 0; n < NUM_PASSES; n++) {
+		uint32_t sum = 0;
+
+		for (uint32_t b = 0; b < RADIX_SIZE; b++) {
+			const uint32_t cnt = counts[n][b];
+
+			counts[n][b] = sum;
+			sum += cnt;
+		}
+	}
+
+	for (uint32_t n = 0; n < NUM_PASSES; n++) {
+		for (const ProjectileSortPair& psp: src) {
+			dst[counts[n][(psp.first >> (n * RADIX_BITS)) & (RADIX_SIZE - 1)]++] = psp;
+		}
+
+		src.swap(dst);
+	}
+
+	for (size_t i = 0, n = src.size(); i < n; i++) {
+		projectiles[i] = src[i].second;
+	}
+}
+
+
 void CProjectileDrawer::InitStatic() {
 	if (projectileDrawer == nullptr)
 		projectileDrawer = new (projectileDrawerMem) CProjectileDrawer();
@@ -279,8 +354,7 @@ void CProjectileDrawer::Kill() {
 	smokeTextures.clear();
 
 	renderProjectiles.clear();
-	sortedProjectiles[0].clear();
-	sortedProjectiles[1].clear();
+	sortedProjectiles.clear();
 
 	perlinNoiseFBO.Kill();
 	flyingPieceVAO.Delete();
@@ -441,8 +515,29 @@ void CProjectileDrawer::DrawProjectiles(int modelType, bool drawReflection, bool
 
 void CProjectileDrawer::DrawProjectilesSet(const std::vector<CProjectile*>& projectiles, bool drawReflection, bool drawRefraction)
 {
+	// interpolated positions and radii, SIMD-batched through the frustum
+	// so the per-projectile LOS and reflection tests only run for what is
+	// actually on screen
+	static std::vector<float4> drawSpheres;
+	static std::vector<uint8_t> inViewFlags;
+
+	drawSpheres.clear();
+	drawSpheres.reserve(projectiles.size());
+	inViewFlags.clear();
+	inViewFlags.resize(projectiles.size(), 0);
+
 	for (CProjectile* p: projectiles) {
-		DrawProjectileNow(p, drawReflection, drawRefraction);
+		p->drawPos = p->GetDrawPos(globalRendering->timeOffset);
+		drawSpheres.emplace_back(p->drawPos, p->GetDrawRadius());
+	}
+
+	camera->InView(int(projectiles.size()), drawSpheres.data(), inViewFlags.data());
+
+	for (size_t i = 0, n = projectiles.size(); i < n; i++) {
+		if (!inViewFlags[i])
+			continue;
+
+		DrawProjectileNow(projectiles[i], drawReflection, drawRefraction);
 	}
 }
 
@@ -455,8 +550,7 @@ bool CProjectileDrawer::CanDrawProjectile(const CProjectile* pro, const CSolidOb
 
 void CProjectileDrawer::DrawProjectileNow(CProjectile* pro, bool drawReflection, bool drawRefraction)
 {
-	pro->drawPos = pro->GetDrawPos(globalRendering->timeOffset);
-
+	// drawPos was set and frustum-tested by DrawProjectilesSet
 	if (!CanDrawProjectile(pro, pro->owner()))
 		return;
 
@@ -466,14 +560,20 @@ void CProjectileDrawer::DrawProjectileNow(CProjectile* pro, bool drawReflection,
 	if (drawReflection && !CUnitDrawer::ObjectVisibleReflection(pro->drawPos, camera->GetPos(), pro->GetDrawRadius()))
 		return;
 
-	if (!camera->InView(pro->drawPos, pro->GetDrawRadius()))
-		return;
-
 	// no-op if no model
 	DrawProjectileModel(pro);
 
-	pro->SetSortDist(camera->ProjectedDistance(pro->pos));
-	sortedProjectiles[drawSorted && pro->drawSorted].push_back(pro);
+	// order-independent particles can be appended right away; only the
+	// depth-sorted subset has to be collected (and drawn post-sort), so
+	// the common case skips the bin fill and a second pointer-chasing
+	// pass over all visible projectiles
+	if (drawSorted && pro->drawSorted) {
+		pro->SetSortDist(camera->ProjectedDistance(pro->pos));
+		sortedProjectiles.push_back(pro);
+		return;
+	}
+
+	pro->Draw(fxBuffer);
 }
 
 
@@ -547,6 +647,14 @@ void CProjectileDrawer::DrawProjectilesMiniMap()
 		p->DrawOnMinimap(buffer);
 	}
 
+	for (const NanoParticle& np: projectileHandler.nanoParticles) {
+		if (!gu->spectatingFullView && !losHandler->InLos(np.pos, gu->myAllyTeam))
+			continue;
+
+		buffer->SafeAppend({np.pos           , np.color});
+		buffer->SafeAppend({np.pos + np.speed, np.color});
+	}
+
 	shader->Enable();
 	shader->SetUniformMatrix4x4<float>("u_movi_mat", false, minimap->GetViewMat(0));
 	shader->SetUniformMatrix4x4<float>("u_proj_mat", false, minimap->GetProjMat(0));
@@ -604,20 +712,60 @@ void CProjectileDrawer::DrawProjectilePass(Shader::IProgramObject*, bool drawRef
 
 	unitDrawer->ResetOpaqueDrawing(false);
 
-	// note: model-less projectiles are NOT drawn by this call but
-	// only z-sorted (if the projectiles indicate they want to be)
+	// model-less projectiles; order-independent particle effects are
+	// appended to fxBuffer immediately, the rest is only collected here
 	DrawProjectilesSet(renderProjectiles, drawReflection, drawRefraction);
 
-	// empty if !drawSorted
-	std::sort(sortedProjectiles[1].begin(), sortedProjectiles[1].end(), zSortCmp);
+	// empty if !drawSorted; projectiles that flag themselves as
+	// order-independent skip the sort (and the bin) entirely
+	SortProjectiles(sortedProjectiles);
 
-
-	// collect the alpha-translucent particle effects in fxBuffer
-	for (CProjectile* p: sortedProjectiles[1]) {
+	// append the depth-sorted alpha-translucent particle effects
+	for (CProjectile* p: sortedProjectiles) {
 		p->Draw(fxBuffer);
 	}
-	for (CProjectile* p: sortedProjectiles[0]) {
-		p->Draw(fxBuffer);
+
+	// nano sprays are order-independent, append them as one batch
+	DrawNanoParticles(drawReflection, drawRefraction);
+}
+
+void CProjectileDrawer::DrawNanoParticles(bool drawReflection, bool drawRefraction)
+{
+	const NanoParticleContainer& container = projectileHandler.nanoParticles;
+
+	if (container.empty())
+		return;
+
+	// the shared state (atlas coordinates, camera axes) is hoisted out
+	// of the loop, so each spray particle costs only the visibility
+	// tests and six vertex appends
+	constexpr float drawRadius = 3.0f; // same as CNanoProjectile
+
+	const float3 camRgt = camera->GetRight() * drawRadius;
+	const float3 camUp  = camera->GetUp()    * drawRadius;
+
+	const AtlasedTexture* gfxt = gfxtex;
+
+	for (const NanoParticle& np: container) {
+		if (!gu->spectatingFullView && !losHandler->InLos(np.pos, gu->myAllyTeam))
+			continue;
+
+		const float3 drawPos = np.pos + np.speed * globalRendering->timeOffset;
+
+		if (drawRefraction && (drawPos.y > drawRadius))
+			continue;
+		if (drawReflection && !CUnitDrawer::ObjectVisibleReflection(drawPos, camera->GetPos(), drawRadius))
+			continue;
+		if (!camera->InView(drawPos, drawRadius))
+			continue;
+
+		fxBuffer->SafeAppend({drawPos - camRgt - camUp, gfxt->xstart, gfxt->ystart, np.color});
+		fxBuffer->SafeAppend({drawPos + camRgt - camUp, gfxt->xend,   gfxt->ystart, np.color});
+		fxBuffer->SafeAppend({drawPos + camRgt + camUp, gfxt->xend,   gfxt->yend,   np.color});
+
+		fxBuffer->SafeAppend({drawPos + camRgt + camUp, gfxt->xend,   gfxt->yend,   np.color});
+		fxBuffer->SafeAppend({drawPos - camRgt + camUp, gfxt->xstart, gfxt->yend,   np.color});
+		fxBuffer->SafeAppend({drawPos - camRgt - camUp, gfxt->xstart, gfxt->ystart, np.color});
 	}
 }
 
@@ -652,8 +800,7 @@ void CProjectileDrawer::Draw(bool drawReflection, bool drawRefraction) {
 	glAttribStatePtr->DisableBlendMask();
 	glAttribStatePtr->EnableDepthMask();
 
-	sortedProjectiles[0].clear();
-	sortedProjectiles[1].clear();
+	sortedProjectiles.clear();
 
 
 	fxBuffer = GL::GetRenderBufferTC();
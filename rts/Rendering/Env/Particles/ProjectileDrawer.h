@@ -123,6 +123,7 @@ private:
 	void DrawProjectiles(int modelType, bool drawReflection, bool drawRefraction);
 	void DrawProjectilesShadow(int modelType);
 	void DrawFlyingPieces(int modelType);
+	void DrawNanoParticles(bool drawReflection, bool drawRefraction);
 
 	void DrawProjectilesSet(const std::vector<CProjectile*>& projectiles, bool drawReflection, bool drawRefraction);
 	void DrawProjectilesSetShadow(const std::vector<CProjectile*>& projectiles);
@@ -154,9 +155,6 @@ private:
 
 	VAO flyingPieceVAO;
 
-	ProjectileDistanceComparator zSortCmp;
-
-
 	std::vector<const AtlasedTexture*> smokeTextures;
 
 	/// projectiles without a model, e.g. nano-particles
@@ -164,9 +162,10 @@ private:
 	/// projectiles with a model
 	std::array<ModelRenderContainer<CProjectile>, MODELTYPE_OTHER> modelRenderers;
 
-	/// {[0] := unsorted, [1] := distance-sorted} projectiles;
-	/// used to render particle effects in back-to-front order
-	std::vector<CProjectile*> sortedProjectiles[2];
+	/// distance-sorted projectiles, used to render the depth-sorted
+	/// subset of particle effects in back-to-front order; projectiles
+	/// that flag themselves order-independent are drawn directly
+	std::vector<CProjectile*> sortedProjectiles;
 
 	bool drawSorted = true;
 };
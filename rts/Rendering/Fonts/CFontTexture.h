@@ -93,6 +93,9 @@ public:
 	float GetDescender() const { return fontDescender; }
 	int GetTexture() const { return glyphAtlasTextureID; }
 
+	// bumped whenever new glyphs are loaded into the atlas
+	int GetTextureUpdateNum() const { return curTextureUpdate; }
+
 	const std::string& GetFamily() const { return fontFamily; }
 	const std::string& GetStyle() const { return fontStyle; }
 
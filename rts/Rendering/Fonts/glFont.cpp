@@ -4,6 +4,7 @@
 #include "FontLogSection.h"
 
 #include <cstdarg>
+#include <cstring>
 #include <stdexcept>
 
 #include "Game/Camera.h"
@@ -15,6 +16,7 @@
 #include "System/StringUtil.h"
 #include "System/Config/ConfigHandler.h"
 #include "System/Log/ILog.h"
+#include "System/Sync/HsiehHash.h"
 
 #undef GetCharWidth // winapi.h
 
@@ -240,6 +242,12 @@ std::deque<std::string> CglFont::SplitIntoLines(const std::u8string& text) { ret
 
 
 
+// scratch destination for shaping uncached runs; the mapped render
+// buffers are write-only, so freshly laid-out glyph data can not be
+// read back out of them into the run-cache
+static std::vector<VA_TYPE_TC> shapeScratchBufs[2];
+
+
 // helper for GetText{Width,Height}
 template <typename T>
 static inline T SkipColorCodes(const std::u8string& text, T idx)
@@ -583,6 +591,11 @@ void CglFont::SwapBuffers() {
 	lastPrintFrame = globalRendering->drawFrame;
 	currBufferIndx = (currBufferIndx + 1) & 1;
 
+	// crude bound; runs are re-shaped on demand so a periodic
+	// wipe only costs dynamic labels one frame of layout work
+	if (shapedRuns.size() > 4096)
+		shapedRuns.clear();
+
 	ResetBuffers();
 }
 
@@ -1135,13 +1148,85 @@ void CglFont::glPrint(float x, float y, float s, const int options, const std::s
 			bufferMutex.lock();
 	}
 
-	// select correct decoration RenderString function
-	if ((options & FONT_OUTLINE) != 0) {
-		RenderStringOutlined(x, y, sizeX, sizeY, text, cccb);
-	} else if ((options & FONT_SHADOW) != 0) {
-		RenderStringShadow(x, y, sizeX, sizeY, text, cccb);
-	} else {
-		RenderString(x, y, sizeX, sizeY, text, cccb);
+	if (runCacheTextureUpdateNum != GetTextureUpdateNum()) {
+		// atlas changed, any cached texture-coordinates went stale
+		runCacheTextureUpdateNum = GetTextureUpdateNum();
+		shapedRuns.clear();
+	}
+
+	uint32_t runKey = HsiehHash(text.data(), text.size(), 0);
+
+	const float4 runCoors = {x, y, sizeX, sizeY};
+
+	runKey = HsiehHash(&runCoors.x, sizeof(runCoors), runKey);
+	runKey = HsiehHash(&textColor.x, sizeof(textColor), runKey);
+	runKey = HsiehHash(&outlineColor.x, sizeof(outlineColor), runKey);
+	runKey = HsiehHash(&textDepth.x, sizeof(textDepth), runKey);
+	runKey = HsiehHash(&options, sizeof(options), runKey);
+
+	ShapedRun& run = shapedRuns[runKey];
+
+	const unsigned int pbi = GetBufferIdx(PRIMARY_BUFFER);
+	const unsigned int obi = GetBufferIdx(OUTLINE_BUFFER);
+
+	// verify the stored key material on every hit; a collision of the
+	// 32-bit key then degrades to a re-shape instead of blitting some
+	// other run's vertices
+	const bool runMatches =
+		(run.text == text) &&
+		(memcmp(&run.coors.x, &runCoors.x, sizeof(runCoors)) == 0) &&
+		(memcmp(&run.textColor.x, &textColor.x, sizeof(textColor)) == 0) &&
+		(memcmp(&run.outlineColor.x, &outlineColor.x, sizeof(outlineColor)) == 0) &&
+		(memcmp(&run.textDepth.x, &textDepth.x, sizeof(textDepth)) == 0) &&
+		(run.options == options);
+
+	if (!runMatches) {
+		run.text = text;
+		run.coors = runCoors;
+		run.textColor = textColor;
+		run.outlineColor = outlineColor;
+		run.textDepth = textDepth;
+		run.options = options;
+
+		// shape the string into scratch memory, then capture it; each
+		// glyph emits at most six vertices per buffer so byte-length is
+		// a safe upper bound
+		shapeScratchBufs[PRIMARY_BUFFER].resize(text.size() * 6);
+		shapeScratchBufs[OUTLINE_BUFFER].resize(text.size() * 6);
+
+		VA_TYPE_TC* const bufMapPtrs[2] = {mapBufferPtr[pbi], mapBufferPtr[obi]};
+		VA_TYPE_TC* const bufCurPtrs[2] = {curBufferPos[pbi], curBufferPos[obi]};
+
+		mapBufferPtr[pbi] = curBufferPos[pbi] = shapeScratchBufs[PRIMARY_BUFFER].data();
+		mapBufferPtr[obi] = curBufferPos[obi] = shapeScratchBufs[OUTLINE_BUFFER].data();
+
+		// select correct decoration RenderString function
+		if ((options & FONT_OUTLINE) != 0) {
+			RenderStringOutlined(x, y, sizeX, sizeY, text, cccb);
+		} else if ((options & FONT_SHADOW) != 0) {
+			RenderStringShadow(x, y, sizeX, sizeY, text, cccb);
+		} else {
+			RenderString(x, y, sizeX, sizeY, text, cccb);
+		}
+
+		run.primaryData.assign(mapBufferPtr[pbi], curBufferPos[pbi]);
+		run.outlineData.assign(mapBufferPtr[obi], curBufferPos[obi]);
+
+		mapBufferPtr[pbi] = bufMapPtrs[0]; curBufferPos[pbi] = bufCurPtrs[0];
+		mapBufferPtr[obi] = bufMapPtrs[1]; curBufferPos[obi] = bufCurPtrs[1];
+	}
+
+	// blit the run into the frame's buffers
+	primaryBufferTC[currBufferIndx].Wait();
+	outlineBufferTC[currBufferIndx].Wait();
+
+	if (!run.outlineData.empty() && ((curBufferPos[obi] - mapBufferPtr[obi]) + run.outlineData.size()) <= (NUM_BUFFER_TRIS * 6)) {
+		memcpy(curBufferPos[obi], run.outlineData.data(), run.outlineData.size() * ELEM_BUFFER_SIZE);
+		curBufferPos[obi] += run.outlineData.size();
+	}
+	if (!run.primaryData.empty() && ((curBufferPos[pbi] - mapBufferPtr[pbi]) + run.primaryData.size()) <= (NUM_BUFFER_TRIS * 6)) {
+		memcpy(curBufferPos[pbi], run.primaryData.data(), run.primaryData.size() * ELEM_BUFFER_SIZE);
+		curBufferPos[pbi] += run.primaryData.size();
 	}
 
 	if (immediate) {
@@ -12,6 +12,7 @@
 #include "Rendering/GL/RenderDataBuffer.hpp"
 #include "System/float4.h"
 #include "System/Threading/SpringThreading.h"
+#include "System/UnorderedMap.hpp"
 
 #undef GetCharWidth // winapi.h
 
@@ -145,6 +146,24 @@ private:
 private:
 	unsigned int GetBufferIdx(bool outline) const { return (currBufferIndx * 2 + outline); }
 
+	// shaped glyph-run; vertex data produced by one glPrint call,
+	// cached s.t. repeated (mostly static) labels cost one memcpy
+	// instead of per-glyph layout
+	struct ShapedRun {
+		// full key material; the map key is only a 32-bit hash of
+		// this, so every hit is verified against it before reuse
+		std::string text;
+
+		float4 coors; // {x, y, sizeX, sizeY}
+		float4 textColor;
+		float4 outlineColor;
+		float2 textDepth;
+		int options = 0;
+
+		std::vector<VA_TYPE_TC> primaryData;
+		std::vector<VA_TYPE_TC> outlineData;
+	};
+
 	enum {
 		PRIMARY_BUFFER = 0,
 		OUTLINE_BUFFER = 1,
@@ -173,6 +192,12 @@ private:
 	unsigned int currBufferIndx = 0;
 	unsigned int lastPrintFrame = 0;
 
+	// maps hashes of (text, position, size, colors, options) to runs;
+	// cleared whenever the glyph-atlas changes
+	spring::unordered_map<uint32_t, ShapedRun> shapedRuns;
+
+	int runCacheTextureUpdateNum = 0;
+
 	bool useDefaultProjMatrix = true;
 	bool inBeginEndBlock = false; // implies bufferMutex is locked
 	bool autoOutlineColor = false; // auto-select outline color for in-text-colorcodes
@@ -362,47 +362,91 @@ void GL::AttribState::PopDepthRange() {
 }
 
 
+// filtered state-change helpers for the boolean toggles; during Init
+// the pushed values are read back from GL itself, so skipping the call
+// when the tracked value matches is safe from the very first push
+void GL::AttribState::SetStateFlag(ArrayStack<bool, 64>& stack, uint32_t attrib, bool enable) {
+	if (stack.Top() != enable)
+		glSetStateFuncs[stack.Top() = enable](attrib);
+}
+void GL::AttribState::PushStateFlag(ArrayStack<bool, 64>& stack, uint32_t attrib, bool enable) {
+	const bool changed = (stack.Top() != enable);
+
+	stack.Push(enable);
+
+	if (changed)
+		glSetStateFuncs[enable](attrib);
+}
+void GL::AttribState::PopStateFlag(ArrayStack<bool, 64>& stack, uint32_t attrib) {
+	const bool oldVal = stack.Top();
+	const bool newVal = stack.Pop(true);
+
+	if (newVal != oldVal)
+		glSetStateFuncs[newVal](attrib);
+}
+
+
 void GL::AttribState::DepthClamp(bool enable) {
-	glSetStateFuncs[depthClampStack.Top() = enable](GL_DEPTH_CLAMP);
+	SetStateFlag(depthClampStack, GL_DEPTH_CLAMP, enable);
 }
 void GL::AttribState::PushDepthClamp(bool enable) {
-	glSetStateFuncs[depthClampStack.Push(enable)](GL_DEPTH_CLAMP);
+	PushStateFlag(depthClampStack, GL_DEPTH_CLAMP, enable);
 }
 void GL::AttribState::PopDepthClamp() {
-	glSetStateFuncs[depthClampStack.Pop(true)](GL_DEPTH_CLAMP);
+	PopStateFlag(depthClampStack, GL_DEPTH_CLAMP);
 }
 
 
 void GL::AttribState::DepthTest(bool enable) {
-	glSetStateFuncs[depthTestStack.Top() = enable](GL_DEPTH_TEST);
+	SetStateFlag(depthTestStack, GL_DEPTH_TEST, enable);
 }
 void GL::AttribState::PushDepthTest(bool enable) {
-	glSetStateFuncs[depthTestStack.Push(enable)](GL_DEPTH_TEST);
+	PushStateFlag(depthTestStack, GL_DEPTH_TEST, enable);
 }
 void GL::AttribState::PopDepthTest() {
-	glSetStateFuncs[depthTestStack.Pop(true)](GL_DEPTH_TEST);
+	PopStateFlag(depthTestStack, GL_DEPTH_TEST);
 }
 
 
 void GL::AttribState::DepthMask(bool enable) {
-	glDepthMask(depthMaskStack.Top() = enable);
+	if (depthMaskStack.Top() != enable)
+		glDepthMask(depthMaskStack.Top() = enable);
 }
 void GL::AttribState::PushDepthMask(bool enable) {
-	glDepthMask(depthMaskStack.Push(enable));
+	const bool changed = (depthMaskStack.Top() != enable);
+
+	depthMaskStack.Push(enable);
+
+	if (changed)
+		glDepthMask(enable);
 }
 void GL::AttribState::PopDepthMask() {
-	glDepthMask(depthMaskStack.Pop(true));
+	const bool oldVal = depthMaskStack.Top();
+	const bool newVal = depthMaskStack.Pop(true);
+
+	if (newVal != oldVal)
+		glDepthMask(newVal);
 }
 
 
 void GL::AttribState::DepthFunc(uint32_t func) {
-	glDepthFunc(depthFuncStack.Top() = func);
+	if (depthFuncStack.Top() != func)
+		glDepthFunc(depthFuncStack.Top() = func);
 }
 void GL::AttribState::PushDepthFunc(uint32_t func) {
-	glDepthFunc(depthFuncStack.Push(func));
+	const bool changed = (depthFuncStack.Top() != func);
+
+	depthFuncStack.Push(func);
+
+	if (changed)
+		glDepthFunc(func);
 }
 void GL::AttribState::PopDepthFunc() {
-	glDepthFunc(depthFuncStack.Pop(true));
+	const uint32_t oldFunc = depthFuncStack.Top();
+	const uint32_t newFunc = depthFuncStack.Pop(true);
+
+	if (newFunc != oldFunc)
+		glDepthFunc(newFunc);
 }
 
 
@@ -438,49 +482,60 @@ void GL::AttribState::PopAlphaFunc() {
 
 
 void GL::AttribState::BlendFunc(uint32_t srcFac, uint32_t dstFac) {
-	glBlendFunc(
-		(blendFuncStack.Top()).srcFac = srcFac,
-		(blendFuncStack.Top()).dstFac = dstFac
-	);
+	BlendFuncState& bfs = blendFuncStack.Top();
+
+	if (bfs.srcFac == srcFac && bfs.dstFac == dstFac)
+		return;
+
+	glBlendFunc(bfs.srcFac = srcFac, bfs.dstFac = dstFac);
 }
 void GL::AttribState::PushBlendFunc(uint32_t srcFac, uint32_t dstFac) {
-	BlendFunc(blendFuncStack.Push({srcFac, dstFac}));
+	const BlendFuncState bfs = blendFuncStack.Top();
+
+	blendFuncStack.Push({srcFac, dstFac});
+
+	if (bfs.srcFac != srcFac || bfs.dstFac != dstFac)
+		glBlendFunc(srcFac, dstFac);
 }
 void GL::AttribState::PopBlendFunc() {
-	BlendFunc(blendFuncStack.Pop(true));
+	const BlendFuncState oldState = blendFuncStack.Top();
+	const BlendFuncState newState = blendFuncStack.Pop(true);
+
+	if (newState.srcFac != oldState.srcFac || newState.dstFac != oldState.dstFac)
+		glBlendFunc(newState.srcFac, newState.dstFac);
 }
 
 
 void GL::AttribState::BlendMask(bool enable) {
-	glSetStateFuncs[blendMaskStack.Top() = enable](GL_BLEND);
+	SetStateFlag(blendMaskStack, GL_BLEND, enable);
 }
 void GL::AttribState::PushBlendMask(bool enable) {
-	glSetStateFuncs[blendMaskStack.Push(enable)](GL_BLEND);
+	PushStateFlag(blendMaskStack, GL_BLEND, enable);
 }
 void GL::AttribState::PopBlendMask() {
-	glSetStateFuncs[blendMaskStack.Pop(true)](GL_BLEND);
+	PopStateFlag(blendMaskStack, GL_BLEND);
 }
 
 
 void GL::AttribState::ScissorTest(bool enable) {
-	glSetStateFuncs[scissorTestStack.Top() = enable](GL_SCISSOR_TEST);
+	SetStateFlag(scissorTestStack, GL_SCISSOR_TEST, enable);
 }
 void GL::AttribState::PushScissorTest(bool enable) {
-	glSetStateFuncs[scissorTestStack.Push(enable)](GL_SCISSOR_TEST);
+	PushStateFlag(scissorTestStack, GL_SCISSOR_TEST, enable);
 }
 void GL::AttribState::PopScissorTest() {
-	glSetStateFuncs[scissorTestStack.Pop(true)](GL_SCISSOR_TEST);
+	PopStateFlag(scissorTestStack, GL_SCISSOR_TEST);
 }
 
 
 void GL::AttribState::StencilTest(bool enable) {
-	glSetStateFuncs[stencilTestStack.Top() = enable](GL_STENCIL_TEST);
+	SetStateFlag(stencilTestStack, GL_STENCIL_TEST, enable);
 }
 void GL::AttribState::PushStencilTest(bool enable) {
-	glSetStateFuncs[stencilTestStack.Push(enable)](GL_STENCIL_TEST);
+	PushStateFlag(stencilTestStack, GL_STENCIL_TEST, enable);
 }
 void GL::AttribState::PopStencilTest() {
-	glSetStateFuncs[stencilTestStack.Pop(true)](GL_STENCIL_TEST);
+	PopStateFlag(stencilTestStack, GL_STENCIL_TEST);
 }
 
 
@@ -553,33 +608,33 @@ void GL::AttribState::PopPolygonOffset() {
 
 
 void GL::AttribState::PolygonOffsetFill(bool enable) {
-	glSetStateFuncs[pofsFlagStack[0].Top() = enable](GL_POLYGON_OFFSET_FILL);
+	SetStateFlag(pofsFlagStack[0], GL_POLYGON_OFFSET_FILL, enable);
 }
 void GL::AttribState::PushPolygonOffsetFill(bool enable) {
-	glSetStateFuncs[pofsFlagStack[0].Push(enable)](GL_POLYGON_OFFSET_FILL);
+	PushStateFlag(pofsFlagStack[0], GL_POLYGON_OFFSET_FILL, enable);
 }
 void GL::AttribState::PopPolygonOffsetFill() {
-	glSetStateFuncs[pofsFlagStack[0].Pop(true)](GL_POLYGON_OFFSET_FILL);
+	PopStateFlag(pofsFlagStack[0], GL_POLYGON_OFFSET_FILL);
 }
 
 void GL::AttribState::PolygonOffsetPoint(bool enable) {
-	glSetStateFuncs[pofsFlagStack[1].Top() = enable](GL_POLYGON_OFFSET_POINT);
+	SetStateFlag(pofsFlagStack[1], GL_POLYGON_OFFSET_POINT, enable);
 }
 void GL::AttribState::PushPolygonOffsetPoint(bool enable) {
-	glSetStateFuncs[pofsFlagStack[1].Push(enable)](GL_POLYGON_OFFSET_POINT);
+	PushStateFlag(pofsFlagStack[1], GL_POLYGON_OFFSET_POINT, enable);
 }
 void GL::AttribState::PopPolygonOffsetPoint() {
-	glSetStateFuncs[pofsFlagStack[1].Pop(true)](GL_POLYGON_OFFSET_POINT);
+	PopStateFlag(pofsFlagStack[1], GL_POLYGON_OFFSET_POINT);
 }
 
 void GL::AttribState::PolygonOffsetLine(bool enable) {
-	glSetStateFuncs[pofsFlagStack[2].Top() = enable](GL_POLYGON_OFFSET_LINE);
+	SetStateFlag(pofsFlagStack[2], GL_POLYGON_OFFSET_LINE, enable);
 }
 void GL::AttribState::PushPolygonOffsetLine(bool enable) {
-	glSetStateFuncs[pofsFlagStack[2].Push(enable)](GL_POLYGON_OFFSET_LINE);
+	PushStateFlag(pofsFlagStack[2], GL_POLYGON_OFFSET_LINE, enable);
 }
 void GL::AttribState::PopPolygonOffsetLine() {
-	glSetStateFuncs[pofsFlagStack[2].Pop(true)](GL_POLYGON_OFFSET_LINE);
+	PopStateFlag(pofsFlagStack[2], GL_POLYGON_OFFSET_LINE);
 }
 
 
@@ -618,35 +673,55 @@ void GL::AttribState::PopScissor() {
 
 
 void GL::AttribState::FrontFace(uint32_t face) {
-	glFrontFace(frontFaceStack.Top() = face);
+	if (frontFaceStack.Top() != face)
+		glFrontFace(frontFaceStack.Top() = face);
 }
 void GL::AttribState::PushFrontFace(uint32_t face) {
-	glFrontFace(frontFaceStack.Push(face));
+	const bool changed = (frontFaceStack.Top() != face);
+
+	frontFaceStack.Push(face);
+
+	if (changed)
+		glFrontFace(face);
 }
 void GL::AttribState::PopFrontFace() {
-	glFrontFace(frontFaceStack.Pop(true));
+	const uint32_t oldFace = frontFaceStack.Top();
+	const uint32_t newFace = frontFaceStack.Pop(true);
+
+	if (newFace != oldFace)
+		glFrontFace(newFace);
 }
 
 
 void GL::AttribState::CullFace(uint32_t face) {
-	glCullFace(cullFaceStack.Top() = face);
+	if (cullFaceStack.Top() != face)
+		glCullFace(cullFaceStack.Top() = face);
 }
 void GL::AttribState::PushCullFace(uint32_t face) {
-	glCullFace(cullFaceStack.Push(face));
+	const bool changed = (cullFaceStack.Top() != face);
+
+	cullFaceStack.Push(face);
+
+	if (changed)
+		glCullFace(face);
 }
 void GL::AttribState::PopCullFace() {
-	glCullFace(cullFaceStack.Pop(true));
+	const uint32_t oldFace = cullFaceStack.Top();
+	const uint32_t newFace = cullFaceStack.Pop(true);
+
+	if (newFace != oldFace)
+		glCullFace(newFace);
 }
 
 
 void GL::AttribState::CullFlag(bool enable) {
-	glSetStateFuncs[cullFlagStack.Top() = enable](GL_CULL_FACE);
+	SetStateFlag(cullFlagStack, GL_CULL_FACE, enable);
 }
 void GL::AttribState::PushCullFlag(bool enable) {
-	glSetStateFuncs[cullFlagStack.Push(enable)](GL_CULL_FACE);
+	PushStateFlag(cullFlagStack, GL_CULL_FACE, enable);
 }
 void GL::AttribState::PopCullFlag() {
-	glSetStateFuncs[cullFlagStack.Pop(true)](GL_CULL_FACE);
+	PopStateFlag(cullFlagStack, GL_CULL_FACE);
 }
 
 
@@ -344,6 +344,12 @@ namespace GL {
 			uint8_t size = 0;
 		};
 
+		// issue the GL call only when the tracked value actually changes;
+		// consecutive world-draw passes largely request identical state
+		void SetStateFlag(ArrayStack<bool, 64>& stack, uint32_t attrib, bool enable);
+		void PushStateFlag(ArrayStack<bool, 64>& stack, uint32_t attrib, bool enable);
+		void PopStateFlag(ArrayStack<bool, 64>& stack, uint32_t attrib);
+
 		ArrayStack<uint32_t        , 64>  attribBitsStack;
 		ArrayStack<DepthRangeState , 64>  depthRangeStack;
 		ArrayStack<bool            , 64>  depthClampStack;
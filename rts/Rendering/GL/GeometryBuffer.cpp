@@ -8,6 +8,8 @@
 #include <algorithm>
 #include <cstring> // memset
 
+CONFIG(int, GeometryBufferScale).defaultValue(100).minimumValue(25).maximumValue(100).description("Percentage of screen resolution at which the deferred geometry buffers are rendered; lower values trade sharpness for bandwidth, results are upsampled when composited.");
+
 void GL::GeometryBuffer::Init(bool ctor) {
 	// if dead, this must be a non-ctor reload
 	assert(!dead || !ctor);
@@ -15,6 +17,9 @@ void GL::GeometryBuffer::Init(bool ctor) {
 	memset(&bufferTextureIDs[0], 0, sizeof(bufferTextureIDs));
 	memset(&bufferAttachments[0], 0, sizeof(bufferAttachments));
 
+	// set before the GetWantedSize calls below
+	bufferScale = configHandler->GetInt("GeometryBufferScale");
+
 	// NOTE:
 	//   initial buffer size must be 0 s.t. prevSize != currSize when !init
 	//   (Lua can toggle drawDeferred and might be the first to cause a call
@@ -186,7 +191,34 @@ bool GL::GeometryBuffer::Update(const bool init) {
 	return (Create(prevBufferSize = currBufferSize));
 }
 
+void GL::GeometryBuffer::Bind() {
+	assert(!dead && !bound);
+
+	buffer.Bind();
+
+	// sub-native buffers need a matching viewport for the deferred
+	// passes; the same-size case keeps the caller's (which can be
+	// offset in dual-screen mode)
+	if (bufferScale != 100)
+		glAttribStatePtr->PushViewPort((globalRendering->viewPosX * bufferScale) / 100, 0, currBufferSize.x, currBufferSize.y);
+
+	bound = true;
+}
+
+void GL::GeometryBuffer::UnBind() {
+	assert(!dead && bound);
+
+	if (bufferScale != 100)
+		glAttribStatePtr->PopViewPort();
+
+	buffer.Unbind();
+	bound = false;
+}
+
 int2 GL::GeometryBuffer::GetWantedSize(bool allowed) const {
-	return {globalRendering->viewSizeX * allowed, globalRendering->viewSizeY * allowed};
+	// consumers sample the attachments with normalized coordinates and
+	// linear filtering, so a scaled-down buffer upsamples on composite
+	// without their involvement
+	return {((globalRendering->viewSizeX * bufferScale) / 100) * allowed, ((globalRendering->viewSizeY * bufferScale) / 100) * allowed};
 }
 
@@ -42,8 +42,8 @@ namespace GL {
 		const FBO& GetObject() const { return buffer; }
 		      FBO& GetObject()       { return buffer; }
 
-		void Bind() { assert(!dead && !bound); buffer.Bind(); bound = true; }
-		void UnBind() { assert(!dead && bound); buffer.Unbind(); bound = false; }
+		void Bind();
+		void UnBind();
 
 		void SetDepthRange(float nearDepth, float farDepth) const;
 
@@ -61,6 +61,9 @@ namespace GL {
 		int2 prevBufferSize;
 		int2 currBufferSize;
 
+		// percentage of screen resolution to allocate and render at
+		int bufferScale = 100;
+
 		const char* name = "";
 
 		bool dead = false;
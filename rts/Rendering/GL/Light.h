@@ -51,11 +51,9 @@ namespace GL {
 		}
 
 		void ClearDeathDependencies() {
-			// modified by DeleteDeathDependence
-			const auto& listeningObjs = GetListening(DEPENDENCE_LIGHT);
-
-			while (!listeningObjs.empty()) {
-				DeleteDeathDependence(listeningObjs.back(), DEPENDENCE_LIGHT);
+			// the head link is unhooked by DeleteDeathDependence
+			while (GetListeningLinks() != nullptr) {
+				DeleteDeathDependence(GetListeningLinks()->target, DEPENDENCE_LIGHT);
 			}
 		}
 
@@ -2,6 +2,7 @@
 
 #include "myGL.h"
 #include "LightHandler.h"
+#include "Game/Camera.h"
 #include "Game/GlobalUnsynced.h"
 #include "Rendering/Shaders/Shader.h"
 #include "Sim/Misc/GlobalSynced.h"
@@ -61,8 +62,6 @@ unsigned int GL::LightHandler::SetLight(unsigned int lgtIndex, const GL::Light&
 	glLights[lgtIndex].SetRelativeTime(0);
 	glLights[lgtIndex].SetAbsoluteTime(gs->frameNum);
 
-	memset(GetRawLightDataPtr(lgtIndex), 0, sizeof(RawLight));
-
 	return (glLights[lgtIndex].GetUID());
 }
 
@@ -91,14 +90,17 @@ void GL::LightHandler::Update() {
 		maxWeight = float3::max(maxWeight, light.GetIntensityWeight());
 	}
 
+	// cull dead, out-of-LOS and off-screen lights, compacting survivors
+	// to the front of rawLights; shaders iterate only over the first
+	// NumVisLights() entries so culled lights cost nothing per-fragment
+	numVisLights = 0;
+
 	for (unsigned int i = 0; i < maxLights; i++) {
 		GL::Light& light = glLights[i];
 
-		// dead light, ignore (but kill its contribution)
-		if (light.GetTTL() == 0) {
-			memset(GetRawLightDataPtr(i), 0, sizeof(RawLight));
+		// dead light, ignore
+		if (light.GetTTL() == 0)
 			continue;
-		}
 
 		if (light.GetAbsoluteTime() != gs->frameNum) {
 			light.SetRelativeTime(light.GetRelativeTime() + 1);
@@ -155,25 +157,27 @@ void GL::LightHandler::Update() {
 			continue;
 		}
 
-		rawLights[i].worldPos = lightPos;
-		rawLights[i].worldDir = lightDir;
-
-		if (gu->spectatingFullView || light.IgnoreLOS() || losHandler->InLos(lightPos, gu->myAllyTeam)) {
-			// light is visible
-			rawLights[i].diffColor = weightedDiffuseCol;
-			rawLights[i].specColor = weightedSpecularCol;
-			rawLights[i].ambiColor = weightedAmbientCol;
-		} else {
-			// zero contribution from this light if not in LOS
-			// (whether or not camera can see it is irrelevant
-			// since the light always takes up a slot anyway)
-			memset(GetRawLightDataPtr(i), 0, sizeof(RawLight));
-		}
+		// zero contribution from this light if not in LOS
+		if (!gu->spectatingFullView && !light.IgnoreLOS() && !losHandler->InLos(lightPos, gu->myAllyTeam))
+			continue;
+
+		// cull against the active camera; rechecked on every Enable since
+		// the reflection and refraction passes each use their own camera
+		if (!camera->InView(lightPos, light.GetRadius()))
+			continue;
+
+		RawLight& rawLight = rawLights[numVisLights++];
+
+		rawLight.worldPos = lightPos;
+		rawLight.worldDir = lightDir;
+		rawLight.diffColor = weightedDiffuseCol;
+		rawLight.specColor = weightedSpecularCol;
+		rawLight.ambiColor = weightedAmbientCol;
 
 		#if (OGL_SPEC_ATTENUATION == 1)
-		rawLights[i].fovRadius = {light.GetFOV(), light.GetAttenuation()};
+		rawLight.fovRadius = {light.GetFOV(), light.GetAttenuation()};
 		#else
-		rawLights[i].fovRadius = {light.GetFOV(), light.GetRadius(), light.GetRadius(), light.GetRadius()};
+		rawLight.fovRadius = {light.GetFOV(), light.GetRadius(), light.GetRadius(), light.GetRadius()};
 		#endif
 	}
 }
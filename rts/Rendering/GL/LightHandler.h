@@ -31,6 +31,11 @@ namespace GL {
 		static constexpr unsigned int MaxUniformVecs()       { return (MaxConfigLights() * (sizeof(RawLight) / sizeof(float4))); }
 		                 unsigned int NumUniformVecs() const { return (NumConfigLights() * (sizeof(RawLight) / sizeof(float4))); }
 
+		// number of lights that passed culling during the last Update; only
+		// this many RawLight entries (from index 0) contain valid data
+		unsigned int NumVisLights() const { return numVisLights; }
+		unsigned int NumVisUniformVecs() const { return (NumVisLights() * (sizeof(RawLight) / sizeof(float4))); }
+
 	private:
 		static constexpr unsigned int MAX_LIGHTS = 32;
 
@@ -47,6 +52,7 @@ namespace GL {
 		std::array<RawLight, MAX_LIGHTS> rawLights;
 
 		unsigned int maxLights = 0;
+		unsigned int numVisLights = 0;
 		unsigned int lightHandle = 0;
 	};
 }
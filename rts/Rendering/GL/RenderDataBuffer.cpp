@@ -440,6 +440,17 @@ void GL::RenderDataBuffer::SubmitInstanced(uint32_t primType, uint32_t dataIndx,
 	array.Unbind();
 }
 
+void GL::RenderDataBuffer::SubmitMulti(uint32_t primType, const int32_t* dataIndcs, const int32_t* dataSizes, uint32_t numRanges) const {
+	assert(elems.GetSize() != 0);
+
+	array.Bind();
+
+	// dataIndcs := first elems, dataSizes := numElems per range
+	glMultiDrawArrays(primType, dataIndcs, dataSizes, numRanges);
+
+	array.Unbind();
+}
+
 
 void GL::RenderDataBuffer::SubmitIndexed(uint32_t primType, uint32_t dataIndx, uint32_t dataSize) const {
 	assert(elems.GetSize() != 0);
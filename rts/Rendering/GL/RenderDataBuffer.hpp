@@ -325,6 +325,7 @@ namespace GL {
 
 		void Submit(uint32_t primType, uint32_t dataIndx, uint32_t dataSize) const;
 		void SubmitInstanced(uint32_t primType, uint32_t dataIndx, uint32_t dataSize, uint32_t numInsts) const;
+		void SubmitMulti(uint32_t primType, const int32_t* dataIndcs, const int32_t* dataSizes, uint32_t numRanges) const;
 		void SubmitIndexed(uint32_t primType, uint32_t dataIndx, uint32_t dataSize) const;
 		void SubmitIndexedInstanced(uint32_t primType, uint32_t dataIndx, uint32_t dataSize, uint32_t numInsts) const;
 		void Upload(
@@ -598,9 +599,10 @@ namespace GL {
 			}
 
 			glDeleteSync(syncObj);
-			return {0};
 			#endif
 			#endif
+
+			return {0};
 		}
 
 
@@ -21,7 +21,9 @@ CR_REG_METADATA(CGroundFlash, (
 		CR_MEMBER(size),
 		CR_MEMBER(depthTest),
 		CR_MEMBER(depthMask),
-	CR_MEMBER_ENDFLAG(CM_Config)
+	CR_MEMBER_ENDFLAG(CM_Config),
+
+	CR_MEMBER(mergeable)
 ))
 
 CR_BIND_DERIVED(CStandardGroundFlash, CGroundFlash, )
@@ -78,6 +80,7 @@ CGroundFlash::CGroundFlash()
 	depthTest = true;
 	depthMask = false;
 	alwaysVisible = false;
+	mergeable = false;
 }
 
 CGroundFlash::CGroundFlash(const float3& _pos)
@@ -86,6 +89,7 @@ CGroundFlash::CGroundFlash(const float3& _pos)
 	depthTest = true;
 	depthMask = false;
 	alwaysVisible = false;
+	mergeable = false;
 	pos = _pos;
 }
 
@@ -197,6 +201,7 @@ void CStandardGroundFlash::InitCommon(const float3& _pos, const float3& _color)
 
 	// flashSize is just backward compability
 	size = flashSize;
+	mergeable = true;
 
 	const float3 normal = CalcNormal(_pos, camera->GetDir() * -1000.0f, flashSize);
 
@@ -213,6 +218,52 @@ bool CStandardGroundFlash::Update()
 	return (std::max(--ttl, 0) > 0);
 }
 
+bool CStandardGroundFlash::TryMerge(CGroundFlash* gf)
+{
+	if (!gf->mergeable)
+		return false;
+
+	// only mergeable flashes are CStandardGroundFlash'es
+	CStandardGroundFlash* sgf = static_cast<CStandardGroundFlash*>(gf);
+
+	// only brighten flashes that are still young, an almost
+	// faded flash suddenly regaining strength would pop
+	if (flashAge > 0.25f)
+		return false;
+
+	// co-location radius scales with the larger of the two
+	const float mergeDist = 0.5f * std::max(size, sgf->size);
+
+	if (pos.SqDistance2D(sgf->pos) > (mergeDist * mergeDist))
+		return false;
+
+	// absorb; grow to the larger extents and stack up brightness
+	ttl = std::max(ttl, sgf->ttl);
+
+	size         = std::max(size,         sgf->size        );
+	flashSize    = std::max(flashSize,    sgf->flashSize   );
+	circleSize   = std::max(circleSize,   sgf->circleSize  );
+	circleGrowth = std::max(circleGrowth, sgf->circleGrowth);
+
+	circleAlpha = std::min(circleAlpha + sgf->circleAlpha * 0.5f, 1.0f);
+	flashAlpha  = std::min(flashAlpha  + sgf->flashAlpha  * 0.5f, 1.0f);
+
+	color.r = std::max(color.r, sgf->color.r);
+	color.g = std::max(color.g, sgf->color.g);
+	color.b = std::max(color.b, sgf->color.b);
+
+	flashAgeSpeed  = (ttl > 0)? 1.0f / ttl       : 0.0f;
+	circleAlphaDec = (ttl > 0)? circleAlpha / ttl: 0.0f;
+
+	// neutralize the absorbed flash, it removes itself on its next
+	// Update (Draw emits nothing since both its alpha terms are 0)
+	sgf->ttl = 0;
+	sgf->circleAlpha = 0.0f;
+	sgf->flashAge = 1.0f;
+
+	return true;
+}
+
 void CStandardGroundFlash::Draw(GL::RenderDataBufferTC* va) const
 {
 	float iAlpha = Clamp(circleAlpha - (circleAlphaDec * globalRendering->timeOffset), 0.0f, 1.0f);
@@ -24,6 +24,9 @@ public:
 	virtual void Draw(GL::RenderDataBufferTC* va) const {}
 	/// @return false when it should be deleted
 	virtual bool Update() { return false; }
+	/// absorb a newly spawned co-located flash into this one,
+	/// @return true when <gf> was consumed (it neutralizes itself)
+	virtual bool TryMerge(CGroundFlash* gf) { return false; }
 	virtual void Init(const CUnit* owner, const float3& offset) override {}
 
 	float3 CalcNormal(const float3 midPos, const float3 camDir, float quadSize) const;
@@ -35,6 +38,8 @@ public:
 	float size;
 	bool depthTest;
 	bool depthMask;
+	// set by types that implement TryMerge for themselves
+	bool mergeable;
 };
 
 
@@ -60,6 +65,7 @@ public:
 
 	void Draw(GL::RenderDataBufferTC* va) const override;
 	bool Update() override;
+	bool TryMerge(CGroundFlash* gf) override;
 
 	static bool GetMemberInfo(SExpGenSpawnableMemberInfo& memberInfo);
 
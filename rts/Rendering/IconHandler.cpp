@@ -12,7 +12,9 @@
 #include "System/Log/ILog.h"
 #include "Lua/LuaParser.h"
 #include "Textures/Bitmap.h"
+#include "Textures/TextureAtlas.h"
 #include "System/Exceptions.h"
+#include "System/SafeUtil.h"
 
 namespace icon {
 
@@ -29,9 +31,11 @@ static CIconData dummyIconData[CIconHandler::ICON_DATA_OFFSET];
 void CIconHandler::Kill()
 {
 	glDeleteTextures(1, &defTexID);
+	spring::SafeDelete(iconAtlas);
 
 	defTexID = 0;
 	numIcons = 0;
+	atlasValid = false;
 
 	dummyIconData[ SAFETY_DATA_IDX] = {};
 	dummyIconData[DEFAULT_DATA_IDX] = {};
@@ -59,6 +63,11 @@ bool CIconHandler::LoadIcons(const std::string& filename)
 	dummyIconData[ SAFETY_DATA_IDX] = {};
 	dummyIconData[DEFAULT_DATA_IDX] = {"default", GetDefaultTexture(), 1.0f, 1.0f, false, false, DEFAULT_TEX_SIZE_X, DEFAULT_TEX_SIZE_Y};
 
+	// AddIcon feeds each bitmap into the pending atlas as a side-effect
+	assert(iconAtlas == nullptr);
+	iconAtlas = new CTextureAtlas(CTextureAtlas::ATLAS_ALLOC_QUADTREE);
+	iconAtlas->SetName("ICONHANDLER-ATLAS");
+
 	for (const std::string& iconName : iconNames) {
 		const LuaTable iconTable = iconTypes.SubTable(iconName);
 
@@ -71,6 +80,8 @@ bool CIconHandler::LoadIcons(const std::string& filename)
 		);
 	}
 
+	FinalizeAtlas();
+
 	const auto it = iconMap.find("default");
 
 	if (it != iconMap.end()) {
@@ -96,6 +107,11 @@ bool CIconHandler::AddIcon(
 		return false;
 	}
 
+	// icons added after load (Spring.AddUnitIcon) are not in the atlas,
+	// fall back to the per-texture draw path for the rest of the game
+	if (atlasValid)
+		InvalidateAtlas();
+
 	unsigned int texID = 0;
 	unsigned int xsize = 0;
 	unsigned int ysize = 0;
@@ -107,12 +123,21 @@ bool CIconHandler::AddIcon(
 
 		if ((ownTexture = !texName.empty() && bitmap.Load(texName))) {
 			texID = bitmap.CreateMipMapTexture();
-			
+
 			glBindTexture(GL_TEXTURE_2D, texID);
 			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 			xsize = bitmap.xsize;
 			ysize = bitmap.ysize;
+
+			if (iconAtlas != nullptr) {
+				if (bitmap.channels == 4 && !bitmap.compressed) {
+					iconAtlas->AddTexFromMem(iconName, bitmap.xsize, bitmap.ysize, CTextureAtlas::RGBA32, bitmap.GetRawMem());
+				} else {
+					// can not leave a hole, every icon must be present
+					InvalidateAtlas();
+				}
+			}
 		} else {
 			texID = GetDefaultTexture();
 			xsize = DEFAULT_TEX_SIZE_X;
@@ -174,14 +199,63 @@ const CIconData* CIconHandler::GetSafetyIconData() { return &dummyIconData[SAFET
 const CIconData* CIconHandler::GetDefaultIconData() { return &dummyIconData[DEFAULT_DATA_IDX]; }
 
 
-unsigned int CIconHandler::GetDefaultTexture()
+void CIconHandler::FinalizeAtlas()
 {
-	// FIXME: just use a PNG ?
+	if (iconAtlas == nullptr)
+		return;
 
-	if (defTexID != 0)
-		return defTexID;
+	{
+		// the shared fallback blob, used by every icon without a bitmap
+		std::vector<unsigned char> mem(DEFAULT_TEX_SIZE_X * DEFAULT_TEX_SIZE_Y * 4);
 
-	unsigned char si[DEFAULT_TEX_SIZE_X * DEFAULT_TEX_SIZE_Y * 4];
+		FillDefaultTexture(mem.data());
+		iconAtlas->AddTexFromMem("default-blob", DEFAULT_TEX_SIZE_X, DEFAULT_TEX_SIZE_Y, CTextureAtlas::RGBA32, mem.data());
+	}
+
+	if (!iconAtlas->Finalize()) {
+		LOG_L(L_WARNING, "[IconHandler::%s] could not atlas icon textures, using individual binds", __func__);
+		spring::SafeDelete(iconAtlas);
+		return;
+	}
+
+	const float4 blobCoords = iconAtlas->GetTexture("default-blob");
+
+	for (unsigned int i = 0; i < numIcons; i++) {
+		CIconData& data = iconData[i];
+
+		if (iconAtlas->TextureExists(data.GetName())) {
+			data.SetTexCoords(iconAtlas->GetTexture(data.GetName()));
+		} else {
+			data.SetTexCoords(blobCoords);
+		}
+	}
+
+	dummyIconData[DEFAULT_DATA_IDX].SetTexCoords(blobCoords);
+	atlasValid = true;
+}
+
+void CIconHandler::InvalidateAtlas()
+{
+	spring::SafeDelete(iconAtlas);
+	atlasValid = false;
+
+	// restore full-range coordinates for the per-texture path
+	for (CIconData& id: iconData) {
+		id.SetTexCoords({0.0f, 0.0f, 1.0f, 1.0f});
+	}
+
+	dummyIconData[ SAFETY_DATA_IDX].SetTexCoords({0.0f, 0.0f, 1.0f, 1.0f});
+	dummyIconData[DEFAULT_DATA_IDX].SetTexCoords({0.0f, 0.0f, 1.0f, 1.0f});
+}
+
+unsigned int CIconHandler::GetAtlasTexture() const
+{
+	return ((atlasValid)? iconAtlas->GetTexID(): 0);
+}
+
+
+void CIconHandler::FillDefaultTexture(unsigned char* si)
+{
 	for (int y = 0; y < DEFAULT_TEX_SIZE_Y; ++y) {
 		for (int x = 0; x < DEFAULT_TEX_SIZE_X; ++x) {
 			const int index = ((y * DEFAULT_TEX_SIZE_X) + x) * 4;
@@ -202,6 +276,17 @@ unsigned int CIconHandler::GetDefaultTexture()
 			}
 		}
 	}
+}
+
+unsigned int CIconHandler::GetDefaultTexture()
+{
+	// FIXME: just use a PNG ?
+
+	if (defTexID != 0)
+		return defTexID;
+
+	unsigned char si[DEFAULT_TEX_SIZE_X * DEFAULT_TEX_SIZE_Y * 4];
+	FillDefaultTexture(si);
 
 	CBitmap bitmap(si, DEFAULT_TEX_SIZE_X, DEFAULT_TEX_SIZE_Y);
 
@@ -331,6 +416,7 @@ void CIconData::CopyData(const CIconData* iconData)
 	size         = iconData->size;
 	distance     = iconData->distance;
 	distSqr      = iconData->distSqr;
+	texCoords    = iconData->texCoords;
 	radiusAdjust = iconData->radiusAdjust;
 	xsize        = iconData->xsize;
 	ysize        = iconData->ysize;
@@ -8,8 +8,11 @@
 
 #include "Icon.h"
 #include "System/float3.h"
+#include "System/float4.h"
 #include "System/UnorderedMap.hpp"
 
+class CTextureAtlas;
+
 namespace icon {
 	class CIconData {
 		public:
@@ -42,6 +45,7 @@ namespace icon {
 
 				std::swap(ownTexture, id.ownTexture);
 
+				texCoords = id.texCoords;
 				radiusAdjust = id.radiusAdjust;
 				return *this;
 			}
@@ -64,6 +68,9 @@ namespace icon {
 			void BindTexture() const;
 
 			const std::string& GetName()   const { return name;         }
+			const float4& GetTexCoords()   const { return texCoords;    }
+
+			void SetTexCoords(const float4& tc) { texCoords = tc; }
 
 			unsigned int GetTextureID()    const { return texID;        }
 			int          GetSizeX()        const { return xsize;        }
@@ -88,6 +95,10 @@ namespace icon {
 			float distance = 1.0f;
 			float distSqr = 1.0f;
 
+			// sub-rect ({xstart, ystart, xend, yend}) within the shared
+			// icon atlas, spans the full [0,1] range when not atlased
+			float4 texCoords = {0.0f, 0.0f, 1.0f, 1.0f};
+
 			bool ownTexture = false;
 			bool radiusAdjust = false;
 	};
@@ -120,6 +131,9 @@ namespace icon {
 			static const CIconData* GetSafetyIconData();
 			static const CIconData* GetDefaultIconData();
 
+			// 0 if icons could not be (or are no longer) atlased
+			unsigned int GetAtlasTexture() const;
+
 		private:
 			CIconData* GetIconDataMut(unsigned int idx) { return (const_cast<CIconData*>(GetIconData(idx))); }
 
@@ -134,8 +148,12 @@ namespace icon {
 			}
 
 			bool LoadIcons(const std::string& filename);
+			void FinalizeAtlas();
+			void InvalidateAtlas();
 			unsigned int GetDefaultTexture();
 
+			static void FillDefaultTexture(unsigned char* mem);
+
 		public:
 			static constexpr unsigned int  SAFETY_DATA_IDX = 0;
 			static constexpr unsigned int DEFAULT_DATA_IDX = 1;
@@ -148,6 +166,10 @@ namespace icon {
 			unsigned int defTexID = 0;
 			unsigned int numIcons = 0;
 
+			// built during LoadIcons, dropped again if Lua adds icons later
+			CTextureAtlas* iconAtlas = nullptr;
+			bool atlasValid = false;
+
 			spring::unordered_map<std::string, CIcon> iconMap;
 			std::array<CIconData, 2048> iconData;
 	};
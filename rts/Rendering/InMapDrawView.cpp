@@ -194,6 +194,10 @@ void InMapDraw_QuadDrawer::DrawQuad(int x, int y)
 
 void CInMapDrawView::Draw()
 {
+	// the common case on most maps
+	if ((inMapDrawerModel->GetNumPoints() == 0) && (inMapDrawerModel->GetNumLines() == 0))
+		return;
+
 	GL::RenderDataBufferTC* pointBuffer = GL::GetRenderBufferTC();
 	GL::RenderDataBufferC* linesBuffer = GL::GetRenderBufferC();
 	GL::WideLineAdapterC* wla = GL::GetWideLineAdapterC();
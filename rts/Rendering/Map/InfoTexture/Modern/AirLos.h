@@ -29,6 +29,10 @@ private:
 	FBO fbo;
 	GLuint uploadTex;
 	Shader::IProgramObject* shader;
+
+	// forces a whole-map refresh (startup, globalLOS or ally-team switch)
+	bool fullUpdate;
+	int lastAllyTeam;
 };
 
 #endif // _AIRLOS_TEXTURE_H
@@ -74,7 +74,6 @@ void CInfoTextureCombiner::SwitchMode(const std::string& name)
 		return;
 	}
 
-	// WTF? fully reloaded from disk on every switch?
 	// TODO: allow "info:myluainfotex"
 	switch (hashString(name.c_str())) {
 		case hashString("los"   ): { disabled = !CreateShader("shaders/GLSL/infoLOS.lua"   , true, float4(0.5f, 0.5f, 0.5f, 1.0f)); } break;
@@ -106,8 +105,23 @@ bool CInfoTextureCombiner::CreateShader(const std::string& filename, const bool
 	if (filename.empty())
 		return false;
 
-	shader->Release();
-	return shader->LoadFromLua(filename);
+	// cache compiled programs per mode; reloading and recompiling them
+	// from disk on every switch caused a visible hitch when toggling an
+	// overlay on larger maps
+	Shader::IProgramObject*& po = modeShaders[filename];
+
+	if (po == nullptr)
+		po = shaderHandler->CreateProgramObject("[CInfoTextureCombiner]", filename);
+
+	if (!po->IsValid()) {
+		po->Release();
+
+		if (!po->LoadFromLua(filename))
+			return false;
+	}
+
+	shader = po;
+	return true;
 }
 
 
@@ -6,6 +6,7 @@
 #include "PboInfoTexture.h"
 #include "Rendering/GL/FBO.h"
 #include "System/float4.h"
+#include "System/UnorderedMap.hpp"
 #include <string>
 
 
@@ -35,6 +36,9 @@ private:
 	FBO fbo;
 	Shader::IProgramObject* shader;
 	std::string curMode;
+
+	// compiled per-mode programs, kept across SwitchMode calls
+	spring::unordered_map<std::string, Shader::IProgramObject*> modeShaders;
 };
 
 #endif // _INFO_TEXTURE_COMBINER_H
@@ -24,6 +24,8 @@ constexpr VA_TYPE_0 VERTS[] = {
 CLosTexture::CLosTexture()
 : CPboInfoTexture("los")
 , uploadTex(0)
+, fullUpdate(true)
+, lastAllyTeam(-1)
 {
 	texSize = losHandler->los.size;
 	texChannels = 1;
@@ -149,6 +151,9 @@ void CLosTexture::Update()
 	if (!fbo.IsValid() || !shader->IsValid() || uploadTex == 0)
 		return UpdateCPU();
 
+	fullUpdate |= (gu->myAllyTeam != lastAllyTeam);
+	lastAllyTeam = gu->myAllyTeam;
+
 	if (losHandler->globalLOS[gu->myAllyTeam]) {
 		fbo.Bind();
 		glAttribStatePtr->ViewPort(0, 0, texSize.x, texSize.y);
@@ -159,16 +164,34 @@ void CLosTexture::Update()
 
 		glBindTexture(GL_TEXTURE_2D, texture);
 		glGenerateMipmap(GL_TEXTURE_2D);
+
+		// counts keep changing while the overlay is all-white
+		fullUpdate = true;
+		return;
+	}
+
+	int2 dirtyMins;
+	int2 dirtyMaxs;
+
+	if (!losHandler->los.losMaps[gu->myAllyTeam].ConsumeDirtyRect(dirtyMins, dirtyMaxs) && !fullUpdate)
 		return;
+
+	if (fullUpdate) {
+		dirtyMins = int2(0, 0);
+		dirtyMaxs = int2(texSize.x - 1, texSize.y - 1);
+		fullUpdate = false;
 	}
 
+	// upload only the modified rows; full-width bands keep the PBO tightly packed
+	const int numRows = dirtyMaxs.y - dirtyMins.y + 1;
+	const size_t offset = dirtyMins.y * texSize.x;
 
 	infoTexPBO.Bind();
 
-	      uint8_t* infoTexMem = reinterpret_cast<uint8_t*>(infoTexPBO.MapBuffer());
+	      uint8_t* infoTexMem = reinterpret_cast<uint8_t*>(infoTexPBO.MapBuffer(offset * sizeof(uint16_t), numRows * texSize.x * sizeof(uint16_t)));
 	const uint16_t* myLos = &losHandler->los.losMaps[gu->myAllyTeam].front();
 
-	memcpy(infoTexMem, myLos, texSize.x * texSize.y * texChannels * sizeof(uint16_t));
+	memcpy(infoTexMem, myLos + offset, numRows * texSize.x * sizeof(uint16_t));
 	infoTexPBO.UnmapBuffer();
 
 
@@ -176,8 +199,7 @@ void CLosTexture::Update()
 	// Faster than doing it on the CPU! And uploading it as shorts would be slow, cause the GPU
 	// has no native support for them and so the transformation would happen on the CPU, too.
 	glBindTexture(GL_TEXTURE_2D, uploadTex);
-	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, texSize.x, texSize.y, GL_RG, GL_UNSIGNED_BYTE, infoTexPBO.GetPtr());
-	infoTexPBO.Invalidate();
+	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, dirtyMins.y, texSize.x, numRows, GL_RG, GL_UNSIGNED_BYTE, infoTexPBO.GetPtr(offset * sizeof(uint16_t)));
 	infoTexPBO.Unbind();
 
 	// do post-processing on the gpu (los-checking & scaling)
@@ -10,6 +10,8 @@ CMetalTexture::CMetalTexture()
 : CPboInfoTexture("metal")
 , CEventClient("[CMetalTexture]", 271990, false)
 , metalMapChanged(true)
+, dirtyRowMins(0)
+, dirtyRowMaxs(mapDims.hmapy - 1)
 {
 	eventHandler.AddClient(this);
 	texSize = int2(mapDims.hmapx, mapDims.hmapy);
@@ -29,9 +31,19 @@ void CMetalTexture::Update()
 {
 	assert(metalMap.GetSizeX() == texSize.x && metalMap.GetSizeZ() == texSize.y);
 
-	glBindTexture(GL_TEXTURE_2D, texture);
-	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, texSize.x, texSize.y, GL_RED, GL_UNSIGNED_BYTE, metalMap.GetDistributionMap());
+	// upload only the rows touched since the last update; the
+	// distribution map is tightly packed so full-width bands
+	// need no unpack-state changes
+	const int mins = std::max(dirtyRowMins, 0);
+	const int maxs = std::min(dirtyRowMaxs, texSize.y - 1);
+
+	if (maxs >= mins) {
+		glBindTexture(GL_TEXTURE_2D, texture);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, mins, texSize.x, maxs - mins + 1, GL_RED, GL_UNSIGNED_BYTE, metalMap.GetDistributionMap() + mins * texSize.x);
+	}
 
+	dirtyRowMins = texSize.y;
+	dirtyRowMaxs = -1;
 	metalMapChanged = false;
 }
 
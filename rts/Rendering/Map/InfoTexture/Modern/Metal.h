@@ -3,6 +3,8 @@
 #ifndef _METAL_TEXTURE_H
 #define _METAL_TEXTURE_H
 
+#include <algorithm>
+
 #include "PboInfoTexture.h"
 #include "System/EventHandler.h"
 
@@ -20,7 +22,11 @@ public:
 	bool GetFullRead() const override { return true; }
 	int  GetReadAllyTeam() const override { return AllAccessTeam; }
 
-	void MetalMapChanged(const int x, const int z) override { metalMapChanged = true; }
+	void MetalMapChanged(const int x, const int z) override {
+		dirtyRowMins = std::min(dirtyRowMins, z);
+		dirtyRowMaxs = std::max(dirtyRowMaxs, z);
+		metalMapChanged = true;
+	}
 
 public:
 	// IInfoTexture interface
@@ -29,6 +35,10 @@ public:
 
 private:
 	bool metalMapChanged;
+
+	// row-span touched by MetalMapChanged events since the last upload
+	int dirtyRowMins;
+	int dirtyRowMaxs;
 };
 
 #endif // _METAL_TEXTURE_H
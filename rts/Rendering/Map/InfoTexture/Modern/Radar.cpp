@@ -27,6 +27,8 @@ CRadarTexture::CRadarTexture()
 : CPboInfoTexture("radar")
 , uploadTexRadar(0)
 , uploadTexJammer(0)
+, fullUpdate(true)
+, lastAllyTeam(-1)
 {
 	texSize = losHandler->radar.size;
 	texChannels = 2;
@@ -181,6 +183,9 @@ void CRadarTexture::Update()
 	if (!fbo.IsValid() || !shader->IsValid() || uploadTexRadar == 0 || uploadTexJammer == 0)
 		return UpdateCPU();
 
+	fullUpdate |= (gu->myAllyTeam != lastAllyTeam);
+	lastAllyTeam = gu->myAllyTeam;
+
 	if (losHandler->globalLOS[gu->myAllyTeam]) {
 		fbo.Bind();
 		glAttribStatePtr->ViewPort(0,0, texSize.x, texSize.y);
@@ -191,38 +196,67 @@ void CRadarTexture::Update()
 
 		glBindTexture(GL_TEXTURE_2D, texture);
 		glGenerateMipmap(GL_TEXTURE_2D);
+
+		// counts keep changing while the overlay is all-white
+		fullUpdate = true;
 		return;
 	}
 
 	const int jammerAllyTeam = modInfo.separateJammers ? gu->myAllyTeam : 0;
 
+	int2 radarMins, radarMaxs;
+	int2 jammerMins, jammerMaxs;
 
-	infoTexPBO.Bind();
+	bool radarDirty  = losHandler->radar.losMaps[gu->myAllyTeam].ConsumeDirtyRect(radarMins, radarMaxs);
+	bool jammerDirty = losHandler->jammer.losMaps[jammerAllyTeam].ConsumeDirtyRect(jammerMins, jammerMaxs);
 
-	const size_t arraySize = texSize.x * texSize.y * sizeof(uint16_t);
-	      uint8_t* infoTexMem = reinterpret_cast<uint8_t*>(infoTexPBO.MapBuffer());
-	const uint16_t* myRadar  = &losHandler->radar.losMaps[gu->myAllyTeam].front();
-	const uint16_t* myJammer = &losHandler->jammer.losMaps[jammerAllyTeam].front();
+	if (fullUpdate) {
+		radarMins = jammerMins = int2(0, 0);
+		radarMaxs = jammerMaxs = int2(texSize.x - 1, texSize.y - 1);
+		radarDirty = jammerDirty = true;
+		fullUpdate = false;
+	}
 
-	memcpy(infoTexMem, myRadar , arraySize); infoTexMem += arraySize;
-	memcpy(infoTexMem, myJammer, arraySize);
+	if (radarDirty || jammerDirty) {
+		// upload only the modified rows of each map; full-width
+		// bands keep the PBO tightly packed
+		infoTexPBO.Bind();
 
-	infoTexPBO.UnmapBuffer();
+		const size_t arraySize = texSize.x * texSize.y * sizeof(uint16_t);
+		      uint8_t* infoTexMem = reinterpret_cast<uint8_t*>(infoTexPBO.MapBuffer());
+		const uint16_t* myRadar  = &losHandler->radar.losMaps[gu->myAllyTeam].front();
+		const uint16_t* myJammer = &losHandler->jammer.losMaps[jammerAllyTeam].front();
 
+		const size_t radarOffset  =  radarMins.y * texSize.x;
+		const size_t jammerOffset = jammerMins.y * texSize.x;
 
-	//Trick: Upload the ushort as 2 ubytes, and then check both for `!=0` in the shader.
-	// Faster than doing it on the CPU! And uploading it as shorts would be slow, cause the GPU
-	// has no native support for them and so the transformation would happen on the CPU, too.
-	glActiveTexture(GL_TEXTURE1);
-	glBindTexture(GL_TEXTURE_2D, uploadTexRadar);
-	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, texSize.x, texSize.y, GL_RG, GL_UNSIGNED_BYTE, infoTexPBO.GetPtr());
+		if (radarDirty)
+			memcpy(infoTexMem + radarOffset * sizeof(uint16_t), myRadar + radarOffset, (radarMaxs.y - radarMins.y + 1) * texSize.x * sizeof(uint16_t));
+		if (jammerDirty)
+			memcpy(infoTexMem + arraySize + jammerOffset * sizeof(uint16_t), myJammer + jammerOffset, (jammerMaxs.y - jammerMins.y + 1) * texSize.x * sizeof(uint16_t));
 
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, uploadTexJammer);
-	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, texSize.x, texSize.y, GL_RG, GL_UNSIGNED_BYTE, infoTexPBO.GetPtr(arraySize));
+		infoTexPBO.UnmapBuffer();
 
-	infoTexPBO.Invalidate();
-	infoTexPBO.Unbind();
+
+		//Trick: Upload the ushort as 2 ubytes, and then check both for `!=0` in the shader.
+		// Faster than doing it on the CPU! And uploading it as shorts would be slow, cause the GPU
+		// has no native support for them and so the transformation would happen on the CPU, too.
+		if (radarDirty) {
+			glBindTexture(GL_TEXTURE_2D, uploadTexRadar);
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, radarMins.y, texSize.x, radarMaxs.y - radarMins.y + 1, GL_RG, GL_UNSIGNED_BYTE, infoTexPBO.GetPtr(radarOffset * sizeof(uint16_t)));
+		}
+		if (jammerDirty) {
+			glBindTexture(GL_TEXTURE_2D, uploadTexJammer);
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, jammerMins.y, texSize.x, jammerMaxs.y - jammerMins.y + 1, GL_RG, GL_UNSIGNED_BYTE, infoTexPBO.GetPtr(arraySize + jammerOffset * sizeof(uint16_t)));
+		}
+
+		infoTexPBO.Unbind();
+	}
+
+	// NOTE:
+	//   the combine pass below still runs every frame; its output also
+	//   depends on the LOS texture (jammers are only drawn inside LOS)
+	//   which is updated independently of the radar and jammer maps
 
 	// do post-processing on the gpu (los-checking & scaling)
 	fbo.Bind();
@@ -231,6 +265,10 @@ void CRadarTexture::Update()
 
 	glActiveTexture(GL_TEXTURE2);
 	glBindTexture(GL_TEXTURE_2D, infoTextureHandler->GetInfoTexture("los")->GetTexture());
+	glActiveTexture(GL_TEXTURE1);
+	glBindTexture(GL_TEXTURE_2D, uploadTexRadar);
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, uploadTexJammer);
 
 	GL::RenderDataBuffer0* rdb = GL::GetRenderBuffer0();
 
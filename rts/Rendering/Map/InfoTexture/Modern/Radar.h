@@ -31,6 +31,10 @@ private:
 	GLuint uploadTexRadar;
 	GLuint uploadTexJammer;
 	Shader::IProgramObject* shader;
+
+	// forces a whole-map refresh (startup, globalLOS or ally-team switch)
+	bool fullUpdate;
+	int lastAllyTeam;
 };
 
 #endif // _RADAR_TEXTURE_H
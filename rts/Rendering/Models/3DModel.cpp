@@ -10,6 +10,8 @@
 #include "Sim/Projectiles/ProjectileHandler.h"
 #include "System/Exceptions.h"
 #include "System/SafeUtil.h"
+#include "System/SimdMath.h"
+#include "System/UnorderedMap.hpp"
 
 #include <algorithm>
 #include <cctype>
@@ -51,13 +53,53 @@ CR_REG_METADATA(LocalModel, (
 	CR_IGNORED(elemsBuffer),
 	CR_IGNORED(indcsBuffer),
 	CR_IGNORED(vboNumVerts),
-	CR_IGNORED(vboNumIndcs)
+	CR_IGNORED(vboNumIndcs),
+	CR_IGNORED(vboNumLodIndcs)
 ))
 
 
 /** ****************************************************************************************************
  * S3DModel
  */
+
+// reduce a piece to a low-detail proxy by clustering its vertices on a
+// uniform grid; every cell keeps one representative vertex, triangles
+// whose corners collapse into the same cell drop out
+static void AppendLowDetailIndices(const S3DModelPiece* omp, float cellSize, std::vector<unsigned int>& lodIndcs)
+{
+	const std::vector<unsigned int>& indcs = omp->GetVertexIndices();
+
+	spring::unordered_map<uint64_t, unsigned int> cellReps;
+	std::vector<unsigned int> vertReps(omp->GetVertexCount());
+
+	cellReps.reserve(omp->GetVertexCount());
+
+	const float invCellSize = 1.0f / std::max(cellSize, 0.01f);
+
+	for (unsigned int i = 0, n = omp->GetVertexCount(); i < n; i++) {
+		// cell coordinates are non-negative relative to the piece minima
+		const float3 p = (omp->GetVertexPos(i) - omp->mins) * invCellSize;
+		const uint64_t key = (uint64_t(p.x) << 42) | (uint64_t(p.y) << 21) | uint64_t(p.z);
+
+		vertReps[i] = (cellReps.try_emplace(key, i).first)->second;
+	}
+
+	for (size_t i = 0, n = indcs.size(); (i + 2) < n; i += 3) {
+		const unsigned int v0 = vertReps[ indcs[i + 0] ];
+		const unsigned int v1 = vertReps[ indcs[i + 1] ];
+		const unsigned int v2 = vertReps[ indcs[i + 2] ];
+
+		if (v0 == v1 || v1 == v2 || v2 == v0)
+			continue;
+
+		// shift to the packed model-buffer like the full-detail indices
+		lodIndcs.push_back(v0 + omp->vboStartElem);
+		lodIndcs.push_back(v1 + omp->vboStartElem);
+		lodIndcs.push_back(v2 + omp->vboStartElem);
+	}
+}
+
+
 void S3DModel::DeleteBuffers()
 {
 	if (vertexArray != 0)
@@ -129,10 +171,26 @@ void S3DModel::UploadBuffers()
 		}
 	}
 	{
-		// indices
+		// indices; the tail of the buffer holds a vertex-clustered
+		// low-detail proxy of the entire model (cf. DrawLowDetail)
+		std::vector<unsigned int> lodIndcs;
+
+		for (const S3DModelPiece* omp: pieceObjects) {
+			if (!omp->HasGeometryData())
+				continue;
+
+			AppendLowDetailIndices(omp, CalcDrawRadius() * (1.0f / 24.0f), lodIndcs);
+		}
+
+		// not worth a separate tier if clustering barely reduced the count
+		if ((lodIndcs.size() * 3) > (vboNumIndcs * 2))
+			lodIndcs.clear();
+
+		vboNumLodIndcs = lodIndcs.size();
+
 		glGenBuffers(1, &indcsBuffer);
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indcsBuffer);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, vboNumIndcs * sizeof(uint32_t), nullptr, GL_STATIC_DRAW);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, (vboNumIndcs + vboNumLodIndcs) * sizeof(uint32_t), nullptr, GL_STATIC_DRAW);
 
 		for (const S3DModelPiece* omp : pieceObjects) {
 
@@ -147,6 +205,9 @@ void S3DModel::UploadBuffers()
 			assert(!indcs.empty());
 			glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, omp->vboStartIndx * sizeof(uint32_t), indcs.size() * sizeof(uint32_t), indcs.data());
 		}
+
+		if (vboNumLodIndcs != 0)
+			glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, vboNumIndcs * sizeof(uint32_t), vboNumLodIndcs * sizeof(uint32_t), lodIndcs.data());
 	}
 
 	EnableAttribs();
@@ -209,6 +270,40 @@ void S3DModel::Draw() const
 	glBindVertexArray(0);
 }
 
+void S3DModel::DrawLowDetail() const
+{
+	// as Draw, but over the vertex-clustered index range
+	if (vboNumLodIndcs == 0) {
+		Draw();
+		return;
+	}
+
+	glBindVertexArray(vertexArray);
+	glDrawElements(GL_TRIANGLES, vboNumLodIndcs, GL_UNSIGNED_INT, VA_TYPE_OFFSET(uint32_t, vboNumIndcs));
+	glBindVertexArray(0);
+}
+
+void S3DModel::DrawInstanced(unsigned int numInstances) const
+{
+	// caller is responsible for supplying per-instance transforms
+	// (via UnitDrawerStateGLSL's instanceMats buffer-texture path)
+	glBindVertexArray(vertexArray);
+	glDrawElementsInstanced(GL_TRIANGLES, vboNumIndcs, GL_UNSIGNED_INT, nullptr, numInstances);
+	glBindVertexArray(0);
+}
+
+void S3DModel::DrawInstancedLowDetail(unsigned int numInstances) const
+{
+	if (vboNumLodIndcs == 0) {
+		DrawInstanced(numInstances);
+		return;
+	}
+
+	glBindVertexArray(vertexArray);
+	glDrawElementsInstanced(GL_TRIANGLES, vboNumLodIndcs, GL_UNSIGNED_INT, VA_TYPE_OFFSET(uint32_t, vboNumIndcs), numInstances);
+	glBindVertexArray(0);
+}
+
 void S3DModel::DrawPiece(const S3DModelPiece* omp) const
 {
 	assert(std::find_if(pieceObjects.cbegin(), pieceObjects.cend(), [&](const S3DModelPiece* p) { return (p == omp); }) != pieceObjects.cend());
@@ -448,15 +543,22 @@ void LocalModel::UpdatePieceMatrices(unsigned int gsFrameNum)
 	if (gsFrameNum == pmuFrameNum)
 		return;
 
+	// only ever called from the main thread, shared scratch is fine
+	static std::vector<float> pieceWeights;
+
+	pieceWeights.resize(pieces.size());
+
 	// could be combined with UpdateChildMatricesRec, but KISS
 	for (size_t i = 0, n = pieces.size(); i < n; i++) {
 		const LocalModelPiece& lmp = pieces[i];
 
-		// set a null-matrix for invisible pieces; empty pieces are not uploaded
 		matrices[i] = lmp.GetModelSpaceMatrix();
-		matrices[i] *= float(lmp.scriptSetVisible);
+		pieceWeights[i] = float(lmp.scriptSetVisible);
 	}
 
+	// set null-matrices for invisible pieces; empty pieces are not uploaded
+	simdmath::ScaleMatrices(matrices.data(), pieceWeights.data(), pieces.size());
+
 	pmuFrameNum = gsFrameNum;
 }
 
@@ -480,7 +582,19 @@ void LocalModel::Draw() const
 	glBindVertexArray(0);
 }
 
-void LocalModel::DrawPiece(const LocalModelPiece* lmp) const 
+void LocalModel::DrawLowDetail() const
+{
+	if (vboNumLodIndcs == 0) {
+		Draw();
+		return;
+	}
+
+	glBindVertexArray(vertexArray);
+	glDrawElements(GL_TRIANGLES, vboNumLodIndcs, GL_UNSIGNED_INT, VA_TYPE_OFFSET(uint32_t, vboNumIndcs));
+	glBindVertexArray(0);
+}
+
+void LocalModel::DrawPiece(const LocalModelPiece* lmp) const
 {
 	assert((lmp - &pieces[0]) < pieces.size());
 
@@ -508,6 +622,7 @@ void LocalModel::SetModel(const S3DModel* model, bool initialize)
 	indcsBuffer = model->indcsBuffer;
 	vboNumVerts = model->vboNumVerts;
 	vboNumIndcs = model->vboNumIndcs;
+	vboNumLodIndcs = model->vboNumLodIndcs;
 
 	if (!initialize) {
 		assert(pieces.size() == model->numPieces);
@@ -258,6 +258,7 @@ struct S3DModel
 		indcsBuffer = m.indcsBuffer; m.indcsBuffer = 0;
 		vboNumVerts = m.vboNumVerts;
 		vboNumIndcs = m.vboNumIndcs;
+		vboNumLodIndcs = m.vboNumLodIndcs;
 
 		type = m.type;
 
@@ -285,6 +286,9 @@ struct S3DModel
 	}
 
 	void Draw() const;
+	void DrawLowDetail() const;
+	void DrawInstanced(unsigned int numInstances) const;
+	void DrawInstancedLowDetail(unsigned int numInstances) const;
 	void DrawPiece(const S3DModelPiece* omp) const;
 	void DrawPieceRec(const S3DModelPiece* omp) const;
 
@@ -337,6 +341,8 @@ public:
 	unsigned int indcsBuffer = 0;
 	unsigned int vboNumVerts = 0;
 	unsigned int vboNumIndcs = 0;
+	// vertex-clustered low-detail proxy, stored in the tail of indcsBuffer
+	unsigned int vboNumLodIndcs = 0;
 
 	ModelType type;
 
@@ -478,6 +484,7 @@ struct LocalModel
 
 
 	void Draw() const;
+	void DrawLowDetail() const;
 	void DrawPiece(const LocalModelPiece* lmp) const;
 
 	void SetModel(const S3DModel* model, bool initialize = true);
@@ -539,6 +546,7 @@ private:
 	unsigned int indcsBuffer = 0;
 	unsigned int vboNumVerts = 0;
 	unsigned int vboNumIndcs = 0;
+	unsigned int vboNumLodIndcs = 0;
 };
 
 #endif /* _3DMODEL_H */
@@ -12,9 +12,14 @@
 #include "System/StringUtil.h"
 #include "System/Log/ILog.h"
 #include "System/Exceptions.h"
+#include "System/MainDefines.h" // SNPRINTF
 #include "System/ScopedFPUSettings.h"
+#include "System/Config/ConfigHandler.h"
+#include "System/FileSystem/DataDirsAccess.h"
 #include "System/FileSystem/FileHandler.h"
+#include "System/FileSystem/FileQueryFlags.h"
 #include "System/FileSystem/FileSystem.h"
+#include "System/Sync/HsiehHash.h"
 
 #include "lib/assimp/include/assimp/config.h"
 #include "lib/assimp/include/assimp/defs.h"
@@ -24,7 +29,10 @@
 #include "lib/assimp/include/assimp/Importer.hpp"
 #include "lib/assimp/include/assimp/DefaultLogger.hpp"
 
+#include <cstdio>
+#include <cstring>
 #include <regex>
+#include <type_traits>
 
 
 #define IS_QNAN(f) (f != f)
@@ -151,6 +159,326 @@ void CAssParser::Kill()
 }
 
 
+// -------------------------------------------------------------------------
+// binary cache for post-processed models; Assimp imports (Collada, Blender,
+// etc) are by far the slowest parsers so the flattened piece trees are kept
+// on disk and a re-import only happens when model or metafile content (or
+// the importer configuration) changes
+// -------------------------------------------------------------------------
+
+CONFIG(bool, AssimpModelCache)
+	.defaultValue(true)
+	.description("Cache Assimp-imported models in binary form so they are only re-imported when their content changes.");
+
+static constexpr uint32_t ASS_CACHE_VERSION = 1;
+static constexpr char ASS_CACHE_MAGIC[4] = {'S', 'A', 'M', 'C'};
+
+static std::string assCacheDir;
+static bool assCacheDirInited = false;
+static spring::mutex assCacheMutex;
+
+static const std::string& GetModelCacheDir()
+{
+	std::lock_guard<spring::mutex> lock(assCacheMutex);
+
+	if (!assCacheDirInited) {
+		assCacheDirInited = true;
+
+		// remains empty (i.e. caching stays disabled) without a config
+		if (configHandler != nullptr && configHandler->GetBool("AssimpModelCache"))
+			assCacheDir = dataDirsAccess.LocateDir(FileSystem::GetCacheDir() + "/models/", FileQueryFlags::WRITE | FileQueryFlags::CREATE_DIRS);
+	}
+
+	return assCacheDir;
+}
+
+
+template<typename T>
+static void CacheWrite(std::vector<uint8_t>& buf, const T& val)
+{
+	static_assert(std::is_trivially_copyable<T>::value, "cached values must be raw-copyable");
+
+	const uint8_t* ptr = reinterpret_cast<const uint8_t*>(&val);
+	buf.insert(buf.end(), ptr, ptr + sizeof(T));
+}
+
+static void CacheWriteString(std::vector<uint8_t>& buf, const std::string& str)
+{
+	CacheWrite(buf, static_cast<uint32_t>(str.size()));
+	buf.insert(buf.end(), str.begin(), str.end());
+}
+
+struct CacheReader {
+	const uint8_t* data;
+	size_t size;
+	size_t pos = 0;
+	bool fail = false;
+
+	bool ReadRaw(void* dst, size_t numBytes) {
+		if ((pos + numBytes) > size)
+			return !(fail = true);
+
+		memcpy(dst, data + pos, numBytes);
+		pos += numBytes;
+		return true;
+	}
+
+	template<typename T>
+	bool Read(T& val) {
+		static_assert(std::is_trivially_copyable<T>::value, "cached values must be raw-copyable");
+		return ReadRaw(&val, sizeof(T));
+	}
+
+	bool ReadString(std::string& str) {
+		uint32_t len = 0;
+
+		if (!Read(len) || (pos + len) > size)
+			return !(fail = true);
+
+		str.assign(reinterpret_cast<const char*>(data + pos), len);
+		pos += len;
+		return true;
+	}
+
+	template<typename T>
+	bool ReadVec(std::vector<T>& vec) {
+		uint32_t cnt = 0;
+
+		if (!Read(cnt) || (pos + cnt * sizeof(T)) > size)
+			return !(fail = true);
+
+		vec.resize(cnt);
+		return ReadRaw(vec.data(), cnt * sizeof(T));
+	}
+};
+
+
+std::string CAssParser::GetCacheEntryName(
+	const std::string& modelFilePath,
+	const std::string& metaFileName,
+	const std::vector<unsigned char>& fileBuf
+) const {
+	const std::string& cacheDir = GetModelCacheDir();
+
+	if (cacheDir.empty() || fileBuf.empty())
+		return "";
+
+	// key on model + metafile content and the importer limits (these
+	// control Assimp's mesh splitting), so stale entries self-expire
+	uint32_t hash = HsiehHash(fileBuf.data(), fileBuf.size(), ASS_CACHE_VERSION);
+
+	CFileHandler metaFile(metaFileName, SPRING_VFS_ZIP);
+
+	if (metaFile.FileExists()) {
+		std::vector<unsigned char> metaBuf;
+
+		if (metaFile.IsBuffered()) {
+			metaBuf = std::move(metaFile.GetBuffer());
+		} else {
+			metaBuf.resize(metaFile.FileSize(), 0);
+			metaFile.Read(metaBuf.data(), metaBuf.size());
+		}
+
+		if (!metaBuf.empty())
+			hash = HsiehHash(metaBuf.data(), metaBuf.size(), hash);
+	}
+
+	hash = HsiehHash(&maxVertices, sizeof(maxVertices), hash);
+	hash = HsiehHash(&maxIndices, sizeof(maxIndices), hash);
+
+	char nameBuf[64];
+	SNPRINTF(nameBuf, sizeof(nameBuf), "%08x%08x.assmdl", HsiehHash(modelFilePath.data(), modelFilePath.size(), hash), hash);
+
+	return (cacheDir + nameBuf);
+}
+
+
+void CAssParser::SaveToCache(const S3DModel& model, const std::string& entryName, bool flipTextures, bool invertTeamColor) const
+{
+	std::vector<uint8_t> buf;
+	buf.reserve(1024 * 1024);
+
+	buf.insert(buf.end(), ASS_CACHE_MAGIC, ASS_CACHE_MAGIC + sizeof(ASS_CACHE_MAGIC));
+	CacheWrite(buf, ASS_CACHE_VERSION);
+
+	CacheWrite(buf, static_cast<uint8_t>(flipTextures));
+	CacheWrite(buf, static_cast<uint8_t>(invertTeamColor));
+	CacheWriteString(buf, model.texs[0]);
+	CacheWriteString(buf, model.texs[1]);
+
+	CacheWrite(buf, model.radius);
+	CacheWrite(buf, model.height);
+	CacheWrite(buf, model.mins);
+	CacheWrite(buf, model.maxs);
+	CacheWrite(buf, model.relMidPos);
+
+	// pieceObjects is already in flattened (depth-first) order; parents
+	// always precede their children so indices into it suffice to store
+	// the hierarchy
+	CacheWrite(buf, static_cast<uint32_t>(model.pieceObjects.size()));
+
+	for (const S3DModelPiece* rawPiece: model.pieceObjects) {
+		const SAssPiece* piece = static_cast<const SAssPiece*>(rawPiece);
+
+		int32_t parentIdx = -1;
+
+		for (size_t i = 0; i < model.pieceObjects.size(); i++) {
+			if (model.pieceObjects[i] == piece->parent)
+				parentIdx = static_cast<int32_t>(i);
+		}
+
+		CacheWriteString(buf, piece->name);
+		CacheWrite(buf, parentIdx);
+		CacheWrite(buf, piece->offset);
+		CacheWrite(buf, piece->goffset);
+		CacheWrite(buf, piece->scales);
+		CacheWrite(buf, piece->mins);
+		CacheWrite(buf, piece->maxs);
+		CacheWrite(buf, piece->bakedMatrix);
+		CacheWrite(buf, piece->GetNumTexCoorChannels());
+
+		CacheWrite(buf, static_cast<uint32_t>(piece->vertices.size()));
+		const uint8_t* vertPtr = reinterpret_cast<const uint8_t*>(piece->vertices.data());
+		buf.insert(buf.end(), vertPtr, vertPtr + piece->vertices.size() * sizeof(SAssVertex));
+
+		CacheWrite(buf, static_cast<uint32_t>(piece->indices.size()));
+		const uint8_t* indxPtr = reinterpret_cast<const uint8_t*>(piece->indices.data());
+		buf.insert(buf.end(), indxPtr, indxPtr + piece->indices.size() * sizeof(unsigned int));
+	}
+
+	// write via temp + rename so concurrent preload workers never see
+	// a half-written entry
+	std::lock_guard<spring::mutex> lock(assCacheMutex);
+
+	const std::string tmpName = entryName + ".tmp";
+
+	FILE* file = fopen(tmpName.c_str(), "wb");
+
+	if (file == nullptr)
+		return;
+
+	const bool written = (fwrite(buf.data(), 1, buf.size(), file) == buf.size());
+	fclose(file);
+
+	if (written) {
+		::rename(tmpName.c_str(), entryName.c_str());
+	} else {
+		::remove(tmpName.c_str());
+	}
+}
+
+
+bool CAssParser::LoadFromCache(S3DModel& model, const std::string& modelFilePath, const std::string& entryName)
+{
+	std::vector<uint8_t> buf;
+
+	{
+		std::lock_guard<spring::mutex> lock(assCacheMutex);
+
+		FILE* file = fopen(entryName.c_str(), "rb");
+
+		if (file == nullptr)
+			return false;
+
+		fseek(file, 0, SEEK_END);
+		buf.resize(std::max(0L, ftell(file)));
+		fseek(file, 0, SEEK_SET);
+
+		const bool read = (fread(buf.data(), 1, buf.size(), file) == buf.size());
+		fclose(file);
+
+		if (!read)
+			return false;
+	}
+
+	CacheReader reader = {buf.data(), buf.size()};
+
+	char magic[4] = {0, 0, 0, 0};
+	uint32_t version = 0;
+
+	reader.ReadRaw(magic, sizeof(magic));
+	reader.Read(version);
+
+	if (reader.fail || memcmp(magic, ASS_CACHE_MAGIC, sizeof(magic)) != 0 || version != ASS_CACHE_VERSION) {
+		// e.g. written by an older engine; evict and re-import
+		::remove(entryName.c_str());
+		return false;
+	}
+
+	uint8_t flipTextures = 0;
+	uint8_t invertTeamColor = 0;
+	uint32_t numPieces = 0;
+
+	reader.Read(flipTextures);
+	reader.Read(invertTeamColor);
+	reader.ReadString(model.texs[0]);
+	reader.ReadString(model.texs[1]);
+
+	reader.Read(model.radius);
+	reader.Read(model.height);
+	reader.Read(model.mins);
+	reader.Read(model.maxs);
+	reader.Read(model.relMidPos);
+
+	reader.Read(numPieces);
+
+	if (reader.fail || numPieces == 0 || numPieces > (MAX_MODEL_OBJECTS * 16)) {
+		::remove(entryName.c_str());
+		return false;
+	}
+
+	model.name = modelFilePath;
+	model.type = MODELTYPE_ASS;
+	model.numPieces = numPieces;
+
+	for (uint32_t n = 0; n < numPieces; n++) {
+		SAssPiece* piece = AllocPiece();
+
+		int32_t parentIdx = -1;
+		uint32_t numTexCoorChannels = 0;
+		CMatrix44f bakedMatrix;
+
+		reader.ReadString(piece->name);
+		reader.Read(parentIdx);
+		reader.Read(piece->offset);
+		reader.Read(piece->goffset);
+		reader.Read(piece->scales);
+		reader.Read(piece->mins);
+		reader.Read(piece->maxs);
+		reader.Read(bakedMatrix);
+		reader.Read(numTexCoorChannels);
+		reader.ReadVec(piece->vertices);
+		reader.ReadVec(piece->indices);
+
+		// root first, parents strictly before children
+		if (reader.fail || (n == 0) != (parentIdx < 0) || parentIdx >= static_cast<int32_t>(n)) {
+			// entry is truncated or corrupt; the pool slots grabbed so
+			// far stay allocated (rare enough not to matter) and the
+			// caller falls back to a full import
+			::remove(entryName.c_str());
+			return false;
+		}
+
+		piece->SetBakedMatrix(bakedMatrix);
+		piece->SetNumTexCoorChannels(numTexCoorChannels);
+		// same axis-aligned box CalculateModelDimensions() derives
+		piece->SetCollisionVolume(CollisionVolume('b', 'z', piece->maxs - piece->mins, (piece->maxs + piece->mins) * 0.5f));
+
+		if (parentIdx >= 0) {
+			piece->parent = model.pieceObjects[parentIdx];
+			piece->parent->children.push_back(piece);
+		}
+
+		model.AddPiece(piece);
+	}
+
+	textureHandlerS3O.PreloadTexture(&model, flipTextures != 0, invertTeamColor != 0);
+
+	LOG_SL(LOG_SECTION_MODEL, L_INFO, "Model %s loaded from cache.", model.name.c_str());
+	return true;
+}
+
+
 S3DModel CAssParser::Load(const std::string& modelFilePath)
 {
 	LOG_SL(LOG_SECTION_MODEL, L_INFO, "Loading model: %s", modelFilePath.c_str());
@@ -170,6 +498,23 @@ S3DModel CAssParser::Load(const std::string& modelFilePath)
 	if (!CFileHandler::FileExists(metaFileName, SPRING_VFS_ZIP))
 		LOG_SL(LOG_SECTION_MODEL, L_INFO, "No meta-file '%s'. Using defaults.", metaFileName.c_str());
 
+	if (!file.IsBuffered()) {
+		fileBuf.resize(file.FileSize(), 0);
+		file.Read(fileBuf.data(), fileBuf.size());
+	} else {
+		fileBuf = std::move(file.GetBuffer());
+	}
+
+	// check the binary cache before running the metafile or Assimp
+	const std::string& cacheEntryName = GetCacheEntryName(modelFilePath, metaFileName, fileBuf);
+
+	if (!cacheEntryName.empty()) {
+		S3DModel model;
+
+		if (LoadFromCache(model, modelFilePath, cacheEntryName))
+			return model;
+	}
+
 	LuaParser metaFileParser(metaFileName, SPRING_VFS_ZIP, SPRING_VFS_ZIP);
 
 	if (!metaFileParser.Execute())
@@ -189,13 +534,6 @@ S3DModel CAssParser::Load(const std::string& modelFilePath)
 	importer.SetPropertyInteger(AI_CONFIG_PP_SLM_VERTEX_LIMIT,   maxVertices);
 	importer.SetPropertyInteger(AI_CONFIG_PP_SLM_TRIANGLE_LIMIT, maxIndices / 3);
 
-	if (!file.IsBuffered()) {
-		fileBuf.resize(file.FileSize(), 0);
-		file.Read(fileBuf.data(), fileBuf.size());
-	} else {
-		fileBuf = std::move(file.GetBuffer());
-	}
-
 	if (modelTable.GetBool("nodenamesfromids", false)) {
 		assert(FileSystem::GetExtension(modelFilePath) == "dae");
 		PreProcessFileBuffer(fileBuf);
@@ -233,7 +571,10 @@ S3DModel CAssParser::Load(const std::string& modelFilePath)
 	FindTextures(&model, scene, modelTable, modelPath, modelName);
 	LOG_SL(LOG_SECTION_MODEL, L_INFO, "Loading textures. Tex1: '%s' Tex2: '%s'", model.texs[0].c_str(), model.texs[1].c_str());
 
-	textureHandlerS3O.PreloadTexture(&model, modelTable.GetBool("fliptextures", true), modelTable.GetBool("invertteamcolor", true));
+	const bool flipTextures = modelTable.GetBool("fliptextures", true);
+	const bool invertTeamColor = modelTable.GetBool("invertteamcolor", true);
+
+	textureHandlerS3O.PreloadTexture(&model, flipTextures, invertTeamColor);
 
 	// Load all pieces in the model
 	LOG_SL(LOG_SECTION_MODEL, L_INFO, "Loading pieces from root node '%s'", scene->mRootNode->mName.data);
@@ -251,6 +592,10 @@ S3DModel CAssParser::Load(const std::string& modelFilePath)
 	LOG_SL(LOG_SECTION_MODEL, L_DEBUG, "model->mins: (%f,%f,%f)", model.mins[0], model.mins[1], model.mins[2]);
 	LOG_SL(LOG_SECTION_MODEL, L_DEBUG, "model->maxs: (%f,%f,%f)", model.maxs[0], model.maxs[1], model.maxs[2]);
 	LOG_SL(LOG_SECTION_MODEL, L_INFO, "Model %s Imported.", model.name.c_str());
+
+	if (!cacheEntryName.empty())
+		SaveToCache(model, cacheEntryName, flipTextures, invertTeamColor);
+
 	return model;
 }
 
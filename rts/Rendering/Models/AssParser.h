@@ -125,6 +125,15 @@ private:
 		const std::string& modelName
 	);
 
+	std::string GetCacheEntryName(
+		const std::string& modelFilePath,
+		const std::string& metaFileName,
+		const std::vector<unsigned char>& fileBuf
+	) const;
+
+	bool LoadFromCache(S3DModel& model, const std::string& modelFilePath, const std::string& entryName);
+	void SaveToCache(const S3DModel& model, const std::string& entryName, bool flipTextures, bool invertTeamColor) const;
+
 private:
 	unsigned int maxIndices = 0;
 	unsigned int maxVertices = 0;
@@ -15,6 +15,7 @@
 #include "System/Exceptions.h"
 #include "System/MainDefines.h" // SNPRINTF
 #include "System/SafeUtil.h"
+#include "System/StringHash.h"
 #include "System/Threading/ThreadPool.h"
 #include "lib/assimp/include/assimp/Importer.hpp"
 
@@ -219,7 +220,9 @@ void CModelLoader::PreloadModel(const std::string& modelName)
 	// requires locking around cache.find(...) since some other
 	// preload worker might be down in CreateModel modifying it
 	// at the same time
-	ThreadPool::Enqueue([modelName]() {
+	// key on the name, repeat preloads of one model then hit the
+	// worker that already parsed (or is still parsing) it
+	ThreadPool::EnqueueWithAffinity(hashString(modelName.c_str()), [modelName]() {
 		modelLoader.LoadModel(modelName, true);
 	});
 }
@@ -2,9 +2,12 @@
 
 #include "Screenshot.h"
 
+#include <cstring> // memcpy
+#include <deque>
 #include <vector>
 
 #include "Rendering/GL/myGL.h"
+#include "Rendering/GL/VBO.h"
 #include "Rendering/GlobalRendering.h"
 #include "Rendering/Textures/Bitmap.h"
 #include "System/StringUtil.h"
@@ -26,6 +29,20 @@ struct FunctionArgs
 	int y;
 };
 
+// screenshots whose readback is still in flight on the GPU; drained in
+// submission order by DumpScreenshotQueue once their fences signal
+struct PendingShot
+{
+	VBO pbo{GL_PIXEL_PACK_BUFFER};
+	GLsync fence = 0;
+
+	std::string filename;
+	int x = 0;
+	int y = 0;
+};
+
+static std::deque<PendingShot> pendingShots;
+
 void TakeScreenshot(std::string type)
 {
 	if (type.empty())
@@ -34,25 +51,72 @@ void TakeScreenshot(std::string type)
 	if (!FileSystem::CreateDirectory("screenshots"))
 		return;
 
-	FunctionArgs args;
-	args.x  = globalRendering->dualScreenMode? globalRendering->viewSizeX << 1: globalRendering->viewSizeX;
-	args.y  = globalRendering->viewSizeY;
-	args.x += ((4 - (args.x % 4)) * int((args.x % 4) != 0));
+	pendingShots.emplace_back();
+	PendingShot& shot = pendingShots.back();
+
+	shot.x  = globalRendering->dualScreenMode? globalRendering->viewSizeX << 1: globalRendering->viewSizeX;
+	shot.y  = globalRendering->viewSizeY;
+	shot.x += ((4 - (shot.x % 4)) * int((shot.x % 4) != 0));
 
 	const int shotCounter = configHandler->GetInt("ScreenshotCounter");
 
 	// note: we no longer increment the counter until a "file not found" occurs
 	// since that stalls the thread and might run concurrently with an IL write
-	args.filename.assign("screenshots/screen" + IntToString(shotCounter, "%05d") + "." + type);
-	args.pixelbuf.resize(args.x * args.y * 4);
+	shot.filename.assign("screenshots/screen" + IntToString(shotCounter, "%05d") + "." + type);
 
 	configHandler->Set("ScreenshotCounter", shotCounter + 1);
 
-	glReadPixels(0, 0, args.x, args.y, GL_RGBA, GL_UNSIGNED_BYTE, &args.pixelbuf[0]);
+	// read back into a PACK buffer; this returns without draining the
+	// pipeline, the fence tells DumpScreenshotQueue when the transfer
+	// has actually finished
+	shot.pbo.Bind(GL_PIXEL_PACK_BUFFER);
+	shot.pbo.New(shot.x * shot.y * 4, GL_STREAM_READ);
+	glReadPixels(0, 0, shot.x, shot.y, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	shot.pbo.Unbind();
+
+	#ifndef HEADLESS
+	shot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	#endif
+}
+
+void DumpScreenshotQueue(bool flush)
+{
+	while (!pendingShots.empty()) {
+		PendingShot& shot = pendingShots.front();
+
+		#ifndef HEADLESS
+		// transfers complete in submission order, no need to look further;
+		// when flushing (at shutdown) MapBuffer below waits for the GPU
+		if (!flush && glClientWaitSync(shot.fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+			break;
+
+		glDeleteSync(shot.fence);
+		#endif
+
+		FunctionArgs args;
+		args.filename = std::move(shot.filename);
+		args.x = shot.x;
+		args.y = shot.y;
+		args.pixelbuf.resize(args.x * args.y * 4, 0);
+
+		shot.pbo.Bind(GL_PIXEL_PACK_BUFFER);
+		// plain READ_BIT; the GL_READ_ONLY conversion adds the (here
+		// illegal) unsynchronized flag
+		const GLubyte* mem = shot.pbo.MapBuffer(0, args.pixelbuf.size(), GL_MAP_READ_BIT);
+
+		if (mem != nullptr)
+			std::memcpy(args.pixelbuf.data(), mem, args.pixelbuf.size());
+
+		shot.pbo.UnmapBuffer();
+		shot.pbo.Unbind();
+		shot.pbo.Release();
+
+		pendingShots.pop_front();
 
-	ThreadPool::Enqueue([](const FunctionArgs& args) {
-		CBitmap bmp(&args.pixelbuf[0], args.x, args.y);
-		bmp.ReverseYAxis();
-		bmp.Save(args.filename, true, true);
-	}, args);
+		ThreadPool::Enqueue([](const FunctionArgs& args) {
+			CBitmap bmp(&args.pixelbuf[0], args.x, args.y);
+			bmp.ReverseYAxis();
+			bmp.Save(args.filename, true, true);
+		}, args);
+	}
 }
@@ -6,5 +6,7 @@
 #include <string>
 
 void TakeScreenshot(std::string type);
+/// encodes finished readbacks; call once per frame, flush on shutdown
+void DumpScreenshotQueue(bool flush = false);
 
 #endif
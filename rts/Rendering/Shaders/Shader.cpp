@@ -1,6 +1,7 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
 #include "Rendering/Shaders/Shader.h"
+#include "Rendering/Shaders/ShaderBinaryCache.h"
 #include "Rendering/Shaders/ShaderHandler.h"
 #include "Rendering/Shaders/LuaShaderContainer.h"
 #include "Rendering/Shaders/GLSLCopyState.h"
@@ -263,6 +264,10 @@ namespace Shader {
 		if ((glid = glCreateProgram()) == 0)
 			return false;
 
+		// ask the driver to keep a retrievable binary around for the on-disk cache
+		if (GLEW_ARB_get_program_binary)
+			glProgramParameteri(glid, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
 		for (IShaderObject*& so: shaderObjs) {
 			// NOTE:
 			//   cso will call glDeleteShader when it goes out of scope
@@ -393,7 +398,20 @@ namespace Shader {
 		CShaderHandler::ShaderCache& shaderCache = shaderHandler->GetShaderCache();
 
 		const auto& CachedProg = [&](unsigned int hc) { return ((useCache)? shaderCache.Find(hc): 0); };
-		const auto& UpdateProg = [&](unsigned int hc) { return ((glid = CachedProg(hc)) != 0 || CreateAndLink()); };
+		const auto& UpdateProg = [&](unsigned int hc) {
+			if ((glid = CachedProg(hc)) != 0)
+				return true;
+
+			// unlike the id-cache, on-disk binaries survive across runs
+			if ((glid = BinaryCache::LoadProgram(hc)) != 0)
+				return true;
+
+			if (!CreateAndLink())
+				return false;
+
+			BinaryCache::SaveProgram(glid, hc);
+			return true;
+		};
 
 		// recompile if post-reload <hash> has no entry in cache (id 0), validate on success
 		// then add the pre-reload <_hash, _glid> program pair unless it already has an entry
@@ -0,0 +1,177 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "ShaderBinaryCache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Rendering/GL/myGL.h"
+#include "Rendering/GlobalRenderingInfo.h"
+#include "System/MainDefines.h"
+#include "System/Config/ConfigHandler.h"
+#include "System/FileSystem/DataDirsAccess.h"
+#include "System/FileSystem/FileQueryFlags.h"
+#include "System/FileSystem/FileSystem.h"
+#include "System/Sync/HsiehHash.h"
+
+CONFIG(bool, UseShaderBinaryCache)
+	.defaultValue(true)
+	.description("Cache linked GLSL program binaries on disk so later game starts can skip most shader compilation.");
+
+
+// empty while the cache is disabled or unsupported
+static std::string sbCacheDir;
+static bool sbCacheDirInited = false;
+
+
+static const std::string& GetBinaryCacheDir()
+{
+	if (sbCacheDirInited)
+		return sbCacheDir;
+
+	sbCacheDirInited = true;
+
+	if (!GLEW_ARB_get_program_binary || !configHandler->GetBool("UseShaderBinaryCache"))
+		return sbCacheDir;
+
+	// some drivers expose the extension but support no binary formats
+	GLint numFormats = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+
+	if (numFormats <= 0)
+		return sbCacheDir;
+
+	sbCacheDir = dataDirsAccess.LocateDir(FileSystem::EnsurePathSepAtEnd(FileSystem::GetCacheDir()) + "shaders", FileQueryFlags::WRITE | FileQueryFlags::CREATE_DIRS);
+	FileSystem::EnsurePathSepAtEnd(sbCacheDir);
+	return sbCacheDir;
+}
+
+static uint32_t GetDriverHash()
+{
+	// binaries are opaque driver blobs; vendor, renderer and version
+	// strings together change whenever they could become incompatible
+	static uint32_t driverHash = 0;
+
+	if (driverHash != 0)
+		return driverHash;
+
+	const char* strs[3] = {globalRenderingInfo.glVendor, globalRenderingInfo.glRenderer, globalRenderingInfo.glVersion};
+
+	driverHash = 127;
+
+	for (const char* str: strs) {
+		if (str == nullptr)
+			continue;
+
+		driverHash = HsiehHash(str, strlen(str), driverHash);
+	}
+
+	return driverHash;
+}
+
+static std::string GetEntryPath(unsigned int hash)
+{
+	char entryName[64];
+	SNPRINTF(entryName, sizeof(entryName), "%08x%08x.bin", GetDriverHash(), hash);
+
+	return (GetBinaryCacheDir() + entryName);
+}
+
+
+unsigned int Shader::BinaryCache::LoadProgram(unsigned int hash)
+{
+	if (GetBinaryCacheDir().empty())
+		return 0;
+
+	const std::string entryPath = GetEntryPath(hash);
+
+	FILE* file = ::fopen(entryPath.c_str(), "rb");
+
+	if (file == nullptr)
+		return 0;
+
+	::fseek(file, 0, SEEK_END);
+	const long size = ::ftell(file);
+	::fseek(file, 0, SEEK_SET);
+
+	// entries start with the GLenum binary-format the driver reported
+	std::vector<unsigned char> data;
+	bool read = false;
+
+	if (size > long(sizeof(GLenum))) {
+		data.resize(size);
+		read = (::fread(data.data(), 1, size, file) == size_t(size));
+	}
+
+	::fclose(file);
+
+	if (!read)
+		return 0;
+
+	GLenum format = 0;
+	memcpy(&format, data.data(), sizeof(GLenum));
+
+	const GLuint glid = glCreateProgram();
+
+	glProgramBinary(glid, format, data.data() + sizeof(GLenum), size - sizeof(GLenum));
+
+	GLint status = 0;
+	glGetProgramiv(glid, GL_LINK_STATUS, &status);
+
+	if (status != 0)
+		return glid;
+
+	// written by an older driver revision or truncated; drop the
+	// entry, the caller recompiles from source which refreshes it
+	glDeleteProgram(glid);
+	::remove(entryPath.c_str());
+	return 0;
+}
+
+
+void Shader::BinaryCache::SaveProgram(unsigned int glid, unsigned int hash)
+{
+	if (GetBinaryCacheDir().empty())
+		return;
+
+	GLint size = 0;
+	glGetProgramiv(glid, GL_PROGRAM_BINARY_LENGTH, &size);
+
+	if (size <= 0)
+		return;
+
+	std::vector<unsigned char> data(sizeof(GLenum) + size);
+
+	GLenum format = 0;
+	GLsizei length = 0;
+
+	glGetProgramBinary(glid, size, &length, &format, data.data() + sizeof(GLenum));
+
+	if (length <= 0)
+		return;
+
+	memcpy(data.data(), &format, sizeof(GLenum));
+
+	const std::string entryPath = GetEntryPath(hash);
+	const std::string tmpPath = entryPath + ".tmp";
+
+	// write to a temp file and atomically move it into place, so a
+	// crash mid-write can not leave a truncated entry behind
+	FILE* file = ::fopen(tmpPath.c_str(), "wb");
+
+	if (file == nullptr)
+		return;
+
+	const size_t numBytes = sizeof(GLenum) + length;
+	const bool written = (::fwrite(data.data(), 1, numBytes, file) == numBytes);
+
+	::fclose(file);
+
+	if (written) {
+		::rename(tmpPath.c_str(), entryPath.c_str());
+	} else {
+		::remove(tmpPath.c_str());
+	}
+}
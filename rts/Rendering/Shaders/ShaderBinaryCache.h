@@ -0,0 +1,24 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef SPRING_SHADER_BINARY_CACHE_HDR
+#define SPRING_SHADER_BINARY_CACHE_HDR
+
+namespace Shader {
+	/**
+	 * On-disk cache of linked program binaries (ARB_get_program_binary),
+	 * keyed by the driver identification strings and the program's own
+	 * source/flags hash. Every run otherwise recompiles the exact same
+	 * GLSL for water, shadows, models, infotex and Lua shaders; feeding
+	 * the driver its previous output via glProgramBinary skips that. A
+	 * driver or GPU change alters the key so stale binaries are simply
+	 * never found, and binaries the driver rejects anyway (format bump
+	 * after an update) are dropped and recompiled from source.
+	 */
+	namespace BinaryCache {
+		/// returns a freshly created and linked program on hit, 0 on miss
+		unsigned int LoadProgram(unsigned int hash);
+		void SaveProgram(unsigned int glid, unsigned int hash);
+	}
+}
+
+#endif
@@ -1,5 +1,6 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 #include <cfloat>
+#include <cstring> // memcmp
 
 #include "ShadowHandler.h"
 #include "Game/Camera.h"
@@ -13,6 +14,7 @@
 #include "Rendering/FeatureDrawer.h"
 #include "Rendering/Env/Particles/ProjectileDrawer.h"
 #include "Rendering/UnitDrawer.h"
+#include "Rendering/UnitDrawerState.hpp"
 #include "Rendering/Env/GrassDrawer.h"
 #include "Rendering/Env/ISky.h"
 #include "Rendering/Env/ITreeDrawer.h"
@@ -20,6 +22,7 @@
 #include "Rendering/GL/myGL.h"
 #include "Rendering/Shaders/ShaderHandler.h"
 #include "Rendering/Shaders/Shader.h"
+#include "Sim/Misc/GlobalSynced.h"
 #include "System/Config/ConfigHandler.h"
 #include "System/EventHandler.h"
 #include "System/Matrix44f.h"
@@ -68,6 +71,10 @@ void CShadowHandler::Init()
 	shadowsLoaded = false;
 	inShadowPass = false;
 
+	cachedFrameNum = -1;
+	cachedTimeOffset = -1.0f;
+	cachedDepthValid = false;
+
 	shadowTexture = 0;
 	dummyColorTexture = 0;
 
@@ -185,12 +192,13 @@ void CShadowHandler::LoadShadowGenShaders()
 		po->AttachShaderObject(sh->CreateShaderObject("GLSL/ModelShadowGenVertProg.glsl", versionDef + extraDefs, GL_VERTEX_SHADER));
 		po->AttachShaderObject(sh->CreateShaderObject("GLSL/ModelShadowGenFragProg.glsl", versionDef + extraDefs, GL_FRAGMENT_SHADER));
 		po->Link();
+		IUnitDrawerState::BindPieceMatrixUBO(po->GetObjID());
 
 		po->SetUniformLocation("shadowParams"  ); // idx 0
 		po->SetUniformLocation("shadowViewMat" ); // idx 1
 		po->SetUniformLocation("shadowProjMat" ); // idx 2
 		po->SetUniformLocation("modelMat"      ); // idx 3
-		po->SetUniformLocation("pieceMats"     ); // idx 4
+		po->SetUniformLocation("pieceMats"     ); // idx 4 (-1, UBO block member; entry kept for numbering)
 		po->SetUniformLocation("alphaMaskTex"  ); // idx 5
 		po->SetUniformLocation("alphaTestCtrl" ); // idx 6
 		po->SetUniformLocation("upperClipPlane"); // idx 7
@@ -205,19 +213,24 @@ void CShadowHandler::LoadShadowGenShaders()
 	{
 		Shader::IProgramObject* po = shadowGenProgs[SHADOWGEN_PROGRAM_MAP];
 
-		po->AttachShaderObject(sh->CreateShaderObject("GLSL/MapShadowGenVertProg.glsl", versionDef + extraDefs, GL_VERTEX_SHADER));
-		po->AttachShaderObject(sh->CreateShaderObject("GLSL/MapShadowGenFragProg.glsl", versionDef + extraDefs, GL_FRAGMENT_SHADER));
+		// maps only; for the GroundGPUDisplacement vertex path
+		const std::string mapDefs = "#define SMF_SQUARE_SIZE " + FloatToString(SQUARE_SIZE * 1.0f) + "\n";
+
+		po->AttachShaderObject(sh->CreateShaderObject("GLSL/MapShadowGenVertProg.glsl", versionDef + extraDefs + mapDefs, GL_VERTEX_SHADER));
+		po->AttachShaderObject(sh->CreateShaderObject("GLSL/MapShadowGenFragProg.glsl", versionDef + extraDefs + mapDefs, GL_FRAGMENT_SHADER));
 		po->Link();
 
-		po->SetUniformLocation("shadowParams" ); // idx 0
-		po->SetUniformLocation("shadowViewMat"); // idx 1
-		po->SetUniformLocation("shadowProjMat"); // idx 2
+		po->SetUniformLocation("shadowParams"      ); // idx 0
+		po->SetUniformLocation("shadowViewMat"     ); // idx 1
+		po->SetUniformLocation("shadowProjMat"     ); // idx 2
+		po->SetUniformLocation("heightMapTex"      ); // idx 3
+		po->SetUniformLocation("heightMapDisplace" ); // idx 4
 
 		#if 0
 		// TODO
 		po->Enable();
-		po->SetUniform1i(3, 0); // alphaMaskTex
-		po->SetUniform2f(4, mapInfo->map.voidAlphaMin, mapInfo->map.voidAlphaMax); // alphaTestCtrl
+		po->SetUniform1i(5, 0); // alphaMaskTex
+		po->SetUniform2f(6, mapInfo->map.voidAlphaMin, mapInfo->map.voidAlphaMax); // alphaTestCtrl
 		po->Disable();
 		#endif
 
@@ -233,7 +246,7 @@ void CShadowHandler::LoadShadowGenShaders()
 		po->SetUniformLocation("shadowParams" ); // idx 0
 		po->SetUniformLocation("shadowViewMat"); // idx 1
 		po->SetUniformLocation("shadowProjMat"); // idx 2
-		po->SetUniformLocation("treeMat"      ); // idx 3
+		po->SetUniformLocation("treeMats[0]"  ); // idx 3
 		po->SetUniformLocation("cameraDirX"   ); // idx 4
 		po->SetUniformLocation("cameraDirY"   ); // idx 5
 		po->SetUniformLocation("$dummy$"      ); // idx 6, unused
@@ -252,12 +265,13 @@ void CShadowHandler::LoadShadowGenShaders()
 		po->AttachShaderObject(sh->CreateShaderObject("GLSL/ProjectileShadowGenVertProg.glsl", versionDef + extraDefs, GL_VERTEX_SHADER));
 		po->AttachShaderObject(sh->CreateShaderObject("GLSL/ProjectileShadowGenFragProg.glsl", versionDef + extraDefs, GL_FRAGMENT_SHADER));
 		po->Link();
+		IUnitDrawerState::BindPieceMatrixUBO(po->GetObjID());
 
 		po->SetUniformLocation("shadowParams" ); // idx 0
 		po->SetUniformLocation("shadowViewMat"); // idx 1
 		po->SetUniformLocation("shadowProjMat"); // idx 2
 		po->SetUniformLocation("modelMat"     ); // idx 3
-		po->SetUniformLocation("pieceMats"    ); // idx 4
+		po->SetUniformLocation("pieceMats"    ); // idx 4 (-1, UBO block member; entry kept for numbering)
 		po->Validate();
 	}
 	{
@@ -569,6 +583,37 @@ void CShadowHandler::ResetShadowTexSamplerRaw() const
 
 void CShadowHandler::CreateShadows()
 {
+	CCamera* prvCam = CCameraHandler::GetSetActiveCamera(CCamera::CAMTYPE_SHADOW);
+	CCamera* curCam = CCameraHandler::GetActiveCamera();
+
+
+	SetShadowMatrix(prvCam);
+	SetShadowCamera(curCam);
+
+	// the depth texture is a pure function of the light-space transform
+	// (which bakes in sun direction, projection center and scales, i.e.
+	// any camera movement) and of the casters; those are drawn at the
+	// interpolated positions for <frameNum, timeOffset> so both values
+	// have to match for the cached map to be reusable, which in effect
+	// limits reuse to paused games and duplicate draws of one interp
+	// state (at high frame-rates timeOffset differs every draw and the
+	// map is regenerated, as it must be or the shadows of every moving
+	// object would freeze between sim-frames while the models glide)
+	const CMatrix44f& drawMatrix = viewMatrix[SHADOWMAT_TYPE_DRAWING];
+	const bool xformChanged = (memcmp(drawMatrix.m, cachedViewMatrix.m, sizeof(drawMatrix.m)) != 0);
+	const bool interpChanged = (cachedFrameNum != gs->frameNum || cachedTimeOffset != globalRendering->timeOffset);
+
+	if (cachedDepthValid && !xformChanged && !interpChanged) {
+		CCameraHandler::SetActiveCamera(prvCam->GetCamType());
+		prvCam->Update();
+		return;
+	}
+
+	cachedViewMatrix = drawMatrix;
+	cachedFrameNum = gs->frameNum;
+	cachedTimeOffset = globalRendering->timeOffset;
+	cachedDepthValid = true;
+
 	// NOTE:
 	//   we unbind later in WorldDrawer::GenerateIBLTextures() to save render
 	//   context switches (which are one of the slowest OpenGL operations!)
@@ -582,14 +627,6 @@ void CShadowHandler::CreateShadows()
 
 	glAttribStatePtr->Clear(GL_DEPTH_BUFFER_BIT);
 
-
-	CCamera* prvCam = CCameraHandler::GetSetActiveCamera(CCamera::CAMTYPE_SHADOW);
-	CCamera* curCam = CCameraHandler::GetActiveCamera();
-
-
-	SetShadowMatrix(prvCam);
-	SetShadowCamera(curCam);
-
 	if ((sky->GetLight())->GetLightIntensity() > 0.0f)
 		DrawShadowPasses();
 
@@ -126,6 +126,14 @@ private:
 	CMatrix44f viewMatrix[2];
 	CMatrix44f biasMatrix = {OnesVector * 0.5f,  RgtVector * 0.5f, UpVector * 0.5f, FwdVector * 0.5f};
 
+	// light-space transform and interpolation state (sim-frame plus
+	// intra-frame time-offset) the depth texture was last generated
+	// with; if all still match the map is reused unchanged
+	CMatrix44f cachedViewMatrix;
+	int cachedFrameNum = -1;
+	float cachedTimeOffset = -1.0f;
+	bool cachedDepthValid = false;
+
 	FBO shadowMapFBO;
 };
 
@@ -23,6 +23,7 @@ static spring::unsynced_map<int, int> oldColors;
 
 void CTeamHighlight::Enable(unsigned currentTime)
 {
+#ifndef HEADLESS
 	if (!highlight)
 		return;
 
@@ -44,10 +45,12 @@ void CTeamHighlight::Enable(unsigned currentTime)
 			t->color[n] = std::max(0, std::min(t->color[n] + c , 255));
 		}
 	}
+#endif
 }
 
 void CTeamHighlight::Disable()
 {
+#ifndef HEADLESS
 	if (oldColors.empty())
 		return;
 
@@ -57,14 +60,22 @@ void CTeamHighlight::Disable()
 	}
 
 	oldColors.clear();
+#endif
 }
 
 void CTeamHighlight::Update(int frameNum) {
+#ifndef HEADLESS
+	// purely visual, nothing on the autohost builds ever reads team colors
 	if ((frameNum % TEAM_SLOWUPDATE_RATE))
 		return;
 
 	bool hl = false;
 
+	if (globalConfig.teamHighlight == HIGHLIGHT_NONE) {
+		highlight = false;
+		return;
+	}
+
 	if ((globalConfig.teamHighlight == HIGHLIGHT_PLAYERS && !gu->spectatingFullView) || globalConfig.teamHighlight == HIGHLIGHT_ALL) {
 		const int maxhl = 1000 * (globalConfig.networkTimeout + 1);
 
@@ -114,5 +125,6 @@ void CTeamHighlight::Update(int frameNum) {
 	}
 
 	highlight = hl;
+#endif
 }
 
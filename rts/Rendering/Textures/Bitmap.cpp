@@ -9,6 +9,7 @@
 
 #ifndef BITMAP_NO_OPENGL
 	#include "Rendering/GL/myGL.h"
+	#include "Rendering/GL/PBO.h"
 	#include "System/TimeProfiler.h"
 #endif
 
@@ -835,14 +836,41 @@ unsigned int CBitmap::CreateTexture(float aniso, float lodBias, bool mipmaps) co
 	if (aniso > 0.0f)
 		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, aniso);
 
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, mipmaps? GL_LINEAR_MIPMAP_LINEAR: GL_LINEAR);
+
+	// stage the pixel data through a PBO such that the driver can DMA it
+	// to the texture asynchronously, instead of copying (and stalling on)
+	// client memory inside glTexImage; deletion of the buffer is likewise
+	// deferred until the transfer completes
+	PBO pbo;
+	pbo.Bind();
+	pbo.New(GetMemSize(), GL_STREAM_DRAW);
+
+	uint8_t* pboMem = pbo.MapBuffer(GL_WRITE_ONLY);
+
+	if (pboMem != nullptr) {
+		std::memcpy(pboMem, GetRawMem(), GetMemSize());
+		pbo.UnmapBuffer();
+	} else {
+		// fall back to a client-memory upload
+		pbo.Unbind();
+	}
+
+	const void* texMem = (pboMem != nullptr)? pbo.GetPtr(): GetRawMem();
+
 	if (mipmaps) {
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-		glBuildMipmaps(GL_TEXTURE_2D, intFormats[channels], xsize, ysize, extFormats[channels], GL_UNSIGNED_BYTE, GetRawMem());
+		glBuildMipmaps(GL_TEXTURE_2D, intFormats[channels], xsize, ysize, extFormats[channels], GL_UNSIGNED_BYTE, texMem);
 	} else {
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexImage2D(GL_TEXTURE_2D, 0, intFormats[channels], xsize, ysize, 0, extFormats[channels], GL_UNSIGNED_BYTE, GetRawMem());
+		glTexImage2D(GL_TEXTURE_2D, 0, intFormats[channels], xsize, ysize, 0, extFormats[channels], GL_UNSIGNED_BYTE, texMem);
 	}
 
+	if (pboMem != nullptr) {
+		pbo.Invalidate();
+		pbo.Unbind();
+	}
+
+	pbo.Release();
+
 	return texture;
 }
 
@@ -1,10 +1,12 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
 // must be included before streflop! else we get streflop/cmath resolve conflicts in its hash implementation files
+#include <cstring>
 #include <vector>
 #include "NamedTextures.h"
 
 #include "Rendering/GL/myGL.h"
+#include "Rendering/GL/PBO.h"
 #include "Bitmap.h"
 #include "Rendering/GlobalRendering.h"
 #include "System/bitops.h"
@@ -222,9 +224,25 @@ namespace CNamedTextures {
 			// const int xbits = count_bits_set(bitmap.xsize);
 			// const int ybits = count_bits_set(bitmap.ysize);
 
-			// make the texture
+			// make the texture; stage the pixel data through a PBO so the
+			// driver can transfer it asynchronously (cf. CBitmap::CreateTexture)
 			glBindTexture(GL_TEXTURE_2D, texID);
 
+			PBO pbo;
+			pbo.Bind();
+			pbo.New(bitmap.GetMemSize(), GL_STREAM_DRAW);
+
+			uint8_t* pboMem = pbo.MapBuffer(GL_WRITE_ONLY);
+
+			if (pboMem != nullptr) {
+				std::memcpy(pboMem, bitmap.GetRawMem(), bitmap.GetMemSize());
+				pbo.UnmapBuffer();
+			} else {
+				pbo.Unbind();
+			}
+
+			const void* texMem = (pboMem != nullptr)? pbo.GetPtr(): bitmap.GetRawMem();
+
 			if (clamped) {
 				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
 				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
@@ -244,15 +262,22 @@ namespace CNamedTextures {
 					glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 				}
 
-				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, bitmap.xsize, bitmap.ysize, int(border), GL_RGBA, GL_UNSIGNED_BYTE, bitmap.GetRawMem());
+				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, bitmap.xsize, bitmap.ysize, int(border), GL_RGBA, GL_UNSIGNED_BYTE, texMem);
 			} else {
 				// MIPMAPPING (default)
 				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
 
-				glBuildMipmaps(GL_TEXTURE_2D, GL_RGBA8, bitmap.xsize, bitmap.ysize, GL_RGBA, GL_UNSIGNED_BYTE, bitmap.GetRawMem());
+				glBuildMipmaps(GL_TEXTURE_2D, GL_RGBA8, bitmap.xsize, bitmap.ysize, GL_RGBA, GL_UNSIGNED_BYTE, texMem);
+			}
+
+			if (pboMem != nullptr) {
+				pbo.Invalidate();
+				pbo.Unbind();
 			}
 
+			pbo.Release();
+
 			if (aniso)
 				glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, globalRendering->maxTexAnisoLvl);
 		}
@@ -49,6 +49,7 @@
 
 
 CONFIG(int, UnitLodDist).defaultValue(1000).headlessValue(0);
+CONFIG(int, UnitLowDetailDist).defaultValue(350).headlessValue(0);
 CONFIG(int, UnitIconDist).defaultValue(200).headlessValue(0);
 CONFIG(float, UnitTransparency).defaultValue(0.7f);
 
@@ -260,6 +261,7 @@ void CUnitDrawer::Init() {
 
 	LuaObjectDrawer::ReadLODScales(LUAOBJ_UNIT);
 	SetUnitDrawDist((float)configHandler->GetInt("UnitLodDist"));
+	SetUnitLowDetailDist((float)configHandler->GetInt("UnitLowDetailDist"));
 	SetUnitIconDist((float)configHandler->GetInt("UnitIconDist"));
 
 	alphaValues.x = std::max(0.11f, std::min(1.0f, 1.0f - configHandler->GetFloat("UnitTransparency")));
@@ -283,6 +285,10 @@ void CUnitDrawer::Init() {
 	deadGhostBuildings.resize(teamHandler.ActiveAllyTeams());
 	liveGhostBuildings.resize(teamHandler.ActiveAllyTeams());
 
+	// backing storage for the opaque-pass instancing path
+	glGenBuffers(1, &instMatsBuffer);
+	glGenTextures(1, &instMatsTexture);
+
 	// LH must be initialized before drawer-state is initialized
 	lightHandler.Init(configHandler->GetInt("MaxDynamicModelLights"));
 
@@ -357,6 +363,11 @@ void CUnitDrawer::Kill()
 		alphaModelRenderers[modelType].Kill();
 	}
 
+	glDeleteBuffers(1, &instMatsBuffer);
+	glDeleteTextures(1, &instMatsTexture);
+	instMatsBuffer = 0;
+	instMatsTexture = 0;
+
 	unsortedUnits.clear();
 	unitsByIcon.clear();
 	unitIcons.clear();
@@ -445,15 +456,131 @@ void CUnitDrawer::DrawOpaqueUnits(int modelType, bool drawReflection, bool drawR
 	const auto& mdlRenderer = opaqueModelRenderers[modelType];
 	// const auto& unitBinKeys = mdlRenderer.GetObjectBinKeys();
 
+	const bool drawInstanced = unitDrawerStates[DRAWER_STATE_SEL]->CanDrawInstanced();
+
 	for (unsigned int i = 0, n = mdlRenderer.GetNumObjectBins(); i < n; i++) {
 		BindModelTypeTexture(modelType, mdlRenderer.GetObjectBinKey(i));
 
+		if (!drawInstanced) {
+			for (CUnit* unit: mdlRenderer.GetObjectBin(i)) {
+				DrawOpaqueUnit(unit, drawReflection, drawRefraction);
+			}
+
+			continue;
+		}
+
+		// instanced path; bins only guarantee a common texture so
+		// collect the drawable units first and batch them further
+		// by (model, team), turning the model and piece matrices
+		// into per-instance data and team-color into batch state
+		instDrawUnits.clear();
+
 		for (CUnit* unit: mdlRenderer.GetObjectBin(i)) {
-			DrawOpaqueUnit(unit, drawReflection, drawRefraction);
+			if (!CanDrawOpaqueUnit(unit, drawReflection, drawRefraction))
+				continue;
+
+			if ((unit->pos).SqDistance(camera->GetPos()) > (unit->sqRadius * unitDrawDistSqr)) {
+				farTextureHandler->Queue(unit);
+				continue;
+			}
+
+			if (LuaObjectDrawer::AddOpaqueMaterialObject(unit, LUAOBJ_UNIT))
+				continue;
+
+			if (!CanDrawInstancedUnit(unit)) {
+				// nano-frames and Lua-drawn units keep the solo path
+				SetTeamColour(unit->team);
+				DrawUnitDefTrans(unit, false, false);
+				continue;
+			}
+
+			instDrawUnits.push_back(unit);
+		}
+
+		// units covering only a few pixels still pay the full vertex cost,
+		// draw them with their low-detail proxy meshes (the tier between
+		// full models and far-texture billboards)
+		const auto unitLowDetail = [this](const CUnit* u) {
+			return ((u->pos).SqDistance(camera->GetPos()) > (u->sqRadius * unitLowDetailDistSqr));
+		};
+
+		std::sort(instDrawUnits.begin(), instDrawUnits.end(), [&](const CUnit* a, const CUnit* b) {
+			if (a->model->id != b->model->id) return (a->model->id < b->model->id);
+			if (a->team != b->team) return (a->team < b->team);
+			if (unitLowDetail(a) != unitLowDetail(b)) return (unitLowDetail(a) < unitLowDetail(b));
+			return (a->id < b->id);
+		});
+
+		for (size_t j = 0, k = 0, numUnits = instDrawUnits.size(); j < numUnits; j = k) {
+			const CUnit* unit = instDrawUnits[j];
+
+			for (k = j + 1; k < numUnits; k++) {
+				if (instDrawUnits[k]->model != unit->model || instDrawUnits[k]->team != unit->team)
+					break;
+				if (unitLowDetail(instDrawUnits[k]) != unitLowDetail(unit))
+					break;
+			}
+
+			DrawInstancedUnits(&instDrawUnits[j], k - j, unitLowDetail(unit));
 		}
 	}
 }
 
+bool CUnitDrawer::CanDrawInstancedUnit(const CUnit* unit) const
+{
+	// nano-frames need per-unit build-stage state (clip planes
+	// and nano-color), Lua-drawn units a DrawUnit callin; both
+	// must run the one-draw-per-unit path
+	if (unit->beingBuilt && unit->unitDef->showNanoFrame)
+		return false;
+
+	return (!unit->luaDraw);
+}
+
+void CUnitDrawer::DrawInstancedUnits(CUnit** units, size_t numUnits, bool lowDetail)
+{
+	const CUnit* unit = units[0];
+	const S3DModel* model = unit->model;
+
+	// each instance is one model matrix followed by its piece matrices
+	const size_t numInstMats = 1 + model->numPieces;
+
+	instDrawMats.clear();
+	instDrawMats.reserve(numUnits * numInstMats);
+
+	for (size_t i = 0; i < numUnits; i++) {
+		LocalModel* localModel = &units[i]->localModel;
+
+		localModel->UpdatePieceMatrices(gs->frameNum);
+		instDrawMats.push_back(units[i]->GetTransformMatrix());
+
+		const std::vector<CMatrix44f>& pieceMats = localModel->GetPieceMatrices();
+		instDrawMats.insert(instDrawMats.end(), pieceMats.begin(), pieceMats.end());
+	}
+
+	glBindBuffer(GL_TEXTURE_BUFFER, instMatsBuffer);
+	glBufferData(GL_TEXTURE_BUFFER, instDrawMats.size() * sizeof(CMatrix44f), instDrawMats.data(), GL_STREAM_DRAW);
+	glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+	glActiveTexture(GL_TEXTURE4);
+	glBindTexture(GL_TEXTURE_BUFFER, instMatsTexture);
+	glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, instMatsBuffer);
+	glActiveTexture(GL_TEXTURE0);
+
+	const IUnitDrawerState* state = GetDrawerState(DRAWER_STATE_SEL);
+
+	SetTeamColour(unit->team);
+	state->SetInstanceMatCount(numInstMats);
+
+	if (lowDetail) {
+		model->DrawInstancedLowDetail(numUnits);
+	} else {
+		model->DrawInstanced(numUnits);
+	}
+
+	state->SetInstanceMatCount(0);
+}
+
 inline void CUnitDrawer::DrawOpaqueUnit(CUnit* unit, bool drawReflection, bool drawRefraction)
 {
 	if (!CanDrawOpaqueUnit(unit, drawReflection, drawRefraction))
@@ -526,6 +653,12 @@ void CUnitDrawer::DrawUnitIcons()
 	shader->SetUniformMatrix4x4<float>("u_proj_mat", false, camera->GetProjectionMatrix());
 	shader->SetUniform("u_alpha_test_ctrl", 0.5f, 1.0f, 0.0f, 0.0f); // test > 0.5
 
+	// with a valid atlas every icon samples from the same texture, so
+	// all quads can go out in one submit instead of one per icon-type
+	const unsigned int atlasTex = icon::iconHandler.GetAtlasTexture();
+
+	if (atlasTex != 0)
+		glBindTexture(GL_TEXTURE_2D, atlasTex);
 
 	for (const auto& p: unitsByIcon) {
 		const icon::CIconData* icon = p.first;
@@ -536,7 +669,8 @@ void CUnitDrawer::DrawUnitIcons()
 		if (units.empty())
 			continue;
 
-		icon->BindTexture();
+		if (atlasTex == 0)
+			icon->BindTexture();
 
 		for (const CUnit* unit: units) {
 			assert(unitIcons[unit->id] == icon);
@@ -551,9 +685,13 @@ void CUnitDrawer::DrawUnitIcons()
 			DrawUnitIcon(const_cast<CUnit*>(unit), buffer, !gu->spectatingFullView && closBits == 0 && plosBits != (LOS_PREVLOS | LOS_CONTRADAR));
 		}
 
-		buffer->Submit(GL_TRIANGLES);
+		if (atlasTex == 0)
+			buffer->Submit(GL_TRIANGLES);
 	}
 
+	if (atlasTex != 0)
+		buffer->Submit(GL_TRIANGLES);
+
 
 	if (globalRendering->msaaLevel >= 4)
 		glDisable(GL_SAMPLE_ALPHA_TO_COVERAGE);
@@ -595,7 +733,27 @@ bool CUnitDrawer::CanDrawOpaqueUnit(
 	if (drawReflection && !ObjectVisibleReflection(unit->drawMidPos, cam->GetPos(), unit->GetDrawRadius()))
 		return false;
 
-	return (cam->InView(unit->drawMidPos, unit->GetDrawRadius()));
+	return (GetCamVisibleUnits(cam)[unit->id] != 0);
+}
+
+const std::vector<uint8_t>& CUnitDrawer::GetCamVisibleUnits(const CCamera* cam) const
+{
+	CamVisibleUnits& cvu = camVisibleUnits[cam->GetCamType()];
+
+	if (cvu.drawFrame != globalRendering->drawFrame) {
+		cvu.drawFrame = globalRendering->drawFrame;
+		cvu.flags.clear();
+		cvu.flags.resize(unitHandler.MaxUnits(), 0);
+
+		// test every unit against this camera's frustum once; the
+		// passes sharing the camera (forward and deferred opaque,
+		// alpha, etc) then cull with a plain table-load
+		for (const CUnit* u: unsortedUnits) {
+			cvu.flags[u->id] = cam->InView(u->drawMidPos, u->GetDrawRadius());
+		}
+	}
+
+	return cvu.flags;
 }
 
 bool CUnitDrawer::CanDrawOpaqueUnitShadow(const CUnit* unit) const
@@ -613,7 +771,7 @@ bool CUnitDrawer::CanDrawOpaqueUnitShadow(const CUnit* unit) const
 	const CCamera* cam = CCameraHandler::GetActiveCamera();
 
 	const bool unitInLOS = ((unit->losStatus[gu->myAllyTeam] & LOS_INLOS) || gu->spectatingFullView);
-	const bool unitInView = cam->InView(unit->drawMidPos, unit->GetDrawRadius());
+	const bool unitInView = (GetCamVisibleUnits(cam)[unit->id] != 0);
 
 	return (unitInLOS && unitInView);
 }
@@ -736,13 +894,16 @@ void CUnitDrawer::DrawUnitIcon(CUnit* unit, GL::RenderDataBufferTC* buffer, bool
 	const float3 tl = vn + dy; // top-left
 	const float3 tr = vp + dy; // top-right
 
-	buffer->SafeAppend({bl, 0.0f, 1.0f, color});
-	buffer->SafeAppend({br, 1.0f, 1.0f, color});
-	buffer->SafeAppend({tr, 1.0f, 0.0f, color});
+	// full [0,1] range when icons are not atlased
+	const float4& tc = iconData->GetTexCoords();
 
-	buffer->SafeAppend({tr, 1.0f, 0.0f, color});
-	buffer->SafeAppend({tl, 0.0f, 0.0f, color});
-	buffer->SafeAppend({bl, 0.0f, 1.0f, color});
+	buffer->SafeAppend({bl, tc.xstart, tc.yend  , color});
+	buffer->SafeAppend({br, tc.xend  , tc.yend  , color});
+	buffer->SafeAppend({tr, tc.xend  , tc.ystart, color});
+
+	buffer->SafeAppend({tr, tc.xend  , tc.ystart, color});
+	buffer->SafeAppend({tl, tc.xstart, tc.ystart, color});
+	buffer->SafeAppend({bl, tc.xstart, tc.yend  , color});
 }
 
 
@@ -824,7 +985,7 @@ void CUnitDrawer::DrawAlphaUnits(int modelType)
 }
 
 inline void CUnitDrawer::DrawAlphaUnit(CUnit* unit, int modelType, bool drawGhostBuildingsPass) {
-	if (!camera->InView(unit->drawMidPos, unit->GetDrawRadius()))
+	if (GetCamVisibleUnits(camera)[unit->id] == 0)
 		return;
 
 	if (LuaObjectDrawer::AddAlphaMaterialObject(unit, LUAOBJ_UNIT))
@@ -938,6 +1099,20 @@ void CUnitDrawer::UpdateGhostedBuildings()
 	}
 }
 
+void CUnitDrawer::PublishSimFrameSnapshot()
+{
+	auto& records = unitInterpSnapshot.GetWriteBuffer();
+
+	records.clear();
+	records.resize(unitHandler.MaxUnits());
+
+	for (const CUnit* u: unitHandler.GetActiveUnits()) {
+		records[u->id] = {u->preFramePos, u->pos - u->preFramePos};
+	}
+
+	unitInterpSnapshot.Publish();
+}
+
 void CUnitDrawer::DrawGhostedBuildings(int modelType)
 {
 	assert((unsigned) gu->myAllyTeam < deadGhostBuildings.size());
@@ -1428,6 +1603,13 @@ void CUnitDrawer::DrawUnitModel(const CUnit* unit, bool noLuaCall) {
 	if (!noLuaCall && unit->luaDraw && eventHandler.DrawUnit(unit))
 		return;
 
+	// distant units still cover only a few pixels; use the low-detail
+	// proxy mesh until they are far enough out for the far-textures
+	if ((unit->pos).SqDistance(camera->GetPos()) > (unit->sqRadius * unitDrawer->unitLowDetailDistSqr)) {
+		unit->localModel.DrawLowDetail();
+		return;
+	}
+
 	unit->localModel.Draw();
 }
 
@@ -1496,7 +1678,16 @@ inline void CUnitDrawer::UpdateUnitIconState(CUnit* unit) {
 inline void CUnitDrawer::UpdateUnitDrawPos(CUnit* u) {
 	const CUnit* t = u->GetTransporter();
 
-	if (t != nullptr) {
+	const auto& records = unitInterpSnapshot.GetReadBuffer();
+
+	if (size_t(u->id) < records.size()) {
+		// interpolate from the published snapshot; transportees move
+		// with their carrier's delta but from their own base position
+		const UnitInterpRecord& rec = records[((t != nullptr)? t: u)->id];
+
+		u->drawPos = records[u->id].preFramePos + rec.deltaPos * globalRendering->timeOffset;
+	} else if (t != nullptr) {
+		// no snapshot published yet (no sim frame has run)
 		u->drawPos = u->preFramePos + t->GetDrawDeltaPos(globalRendering->timeOffset);
 	} else {
 		u->drawPos = u->preFramePos + u->GetDrawDeltaPos(globalRendering->timeOffset);
@@ -1744,16 +1935,25 @@ void CUnitDrawer::DrawUnitMiniMapIcon(const CUnit* unit, GL::RenderDataBufferTC*
 	const float y0 = iconPos.z - iconSizeY;
 	const float y1 = iconPos.z + iconSizeY;
 
-	buffer->SafeAppend({{x0, y0, 0.0f}, 0.0f, 0.0f, color}); // tl
-	buffer->SafeAppend({{x1, y0, 0.0f}, 1.0f, 0.0f, color}); // tr
-	buffer->SafeAppend({{x1, y1, 0.0f}, 1.0f, 1.0f, color}); // br
+	// full [0,1] range when icons are not atlased
+	const float4& tc = (unitIcons[unit->id])->GetTexCoords();
 
-	buffer->SafeAppend({{x1, y1, 0.0f}, 1.0f, 1.0f, color}); // br
-	buffer->SafeAppend({{x0, y1, 0.0f}, 0.0f, 1.0f, color}); // bl
-	buffer->SafeAppend({{x0, y0, 0.0f}, 0.0f, 0.0f, color}); // tl
+	buffer->SafeAppend({{x0, y0, 0.0f}, tc.xstart, tc.ystart, color}); // tl
+	buffer->SafeAppend({{x1, y0, 0.0f}, tc.xend  , tc.ystart, color}); // tr
+	buffer->SafeAppend({{x1, y1, 0.0f}, tc.xend  , tc.yend  , color}); // br
+
+	buffer->SafeAppend({{x1, y1, 0.0f}, tc.xend  , tc.yend  , color}); // br
+	buffer->SafeAppend({{x0, y1, 0.0f}, tc.xstart, tc.yend  , color}); // bl
+	buffer->SafeAppend({{x0, y0, 0.0f}, tc.xstart, tc.ystart, color}); // tl
 }
 
 void CUnitDrawer::DrawUnitMiniMapIcons(GL::RenderDataBufferTC* buffer) const {
+	// single-bind single-submit path, see DrawUnitIcons
+	const unsigned int atlasTex = icon::iconHandler.GetAtlasTexture();
+
+	if (atlasTex != 0)
+		glBindTexture(GL_TEXTURE_2D, atlasTex);
+
 	for (const auto& iconPair: unitsByIcon) {
 		const icon::CIconData* icon = iconPair.first;
 		const std::vector<const CUnit*>& units = iconPair.second;
@@ -1763,15 +1963,20 @@ void CUnitDrawer::DrawUnitMiniMapIcons(GL::RenderDataBufferTC* buffer) const {
 		if (units.empty())
 			continue;
 
-		icon->BindTexture();
+		if (atlasTex == 0)
+			icon->BindTexture();
 
 		for (const CUnit* unit: units) {
 			assert(unitIcons[unit->id] == icon);
 			DrawUnitMiniMapIcon(unit, buffer);
 		}
 
-		buffer->Submit(GL_TRIANGLES);
+		if (atlasTex == 0)
+			buffer->Submit(GL_TRIANGLES);
 	}
+
+	if (atlasTex != 0)
+		buffer->Submit(GL_TRIANGLES);
 }
 
 void CUnitDrawer::UpdateUnitMiniMapIcon(const CUnit* unit, bool forced, bool killed) {
@@ -7,12 +7,14 @@
 #include <vector>
 #include <functional>
 
+#include "Game/Camera.h"
 #include "Rendering/GL/LightHandler.h"
 #include "Rendering/GL/RenderDataBufferFwd.hpp"
 #include "Rendering/Models/3DModel.h"
 #include "Rendering/Models/ModelRenderContainer.h"
 #include "Rendering/UnitDrawerState.hpp"
 #include "Rendering/UnitDefImage.h"
+#include "System/DoubleBuffer.h"
 #include "System/EventClient.h"
 #include "System/type2.h"
 #include "System/UnorderedMap.hpp"
@@ -99,6 +101,11 @@ public:
 
 	void UpdateGhostedBuildings();
 
+	/// called at the end of every sim frame; copies the interpolation
+	/// inputs of all active units into the back snapshot and flips it,
+	/// so draw-side position updates never touch synced sim state
+	void PublishSimFrameSnapshot();
+
 	void Draw();
 	void DrawOpaquePass(bool deferredPass);
 	void DrawShadowPass();
@@ -147,6 +154,10 @@ public:
 		unitDrawDist = dist;
 		unitDrawDistSqr = unitDrawDist * unitDrawDist;
 	}
+	void SetUnitLowDetailDist(float dist) {
+		unitLowDetailDist = dist;
+		unitLowDetailDistSqr = unitLowDetailDist * unitLowDetailDist;
+	}
 	void SetUnitIconDist(float dist) {
 		unitIconDist = dist;
 		iconLength = unitIconDist * unitIconDist * 750.0f;
@@ -211,8 +222,12 @@ private:
 
 	bool CanDrawOpaqueUnit(const CUnit* unit, bool drawReflection, bool drawRefraction) const;
 	bool CanDrawOpaqueUnitShadow(const CUnit* unit) const;
+	bool CanDrawInstancedUnit(const CUnit* unit) const;
+
+	const std::vector<uint8_t>& GetCamVisibleUnits(const CCamera* cam) const;
 
 	void DrawOpaqueUnit(CUnit* unit, bool drawReflection, bool drawRefraction);
+	void DrawInstancedUnits(CUnit** units, size_t numUnits, bool lowDetail);
 	void DrawOpaqueUnitShadow(CUnit* unit);
 	void DrawOpaqueUnitsShadow(int modelType);
 	void DrawOpaqueUnits(int modelType, bool drawReflection, bool drawRefraction);
@@ -284,6 +299,10 @@ public:
 public:
 	float unitDrawDist;
 	float unitDrawDistSqr;
+	// units past this distance (scaled by radius) are drawn with their
+	// low-detail proxy meshes, before switching to far-tex billboards
+	float unitLowDetailDist;
+	float unitLowDetailDistSqr;
 	float unitIconDist;
 	float iconLength;
 	float sqCamDistToGroundForIcons;
@@ -309,6 +328,32 @@ private:
 	/// unsorted set of 3DO, S3O, opaque, and cloaked models!)
 	std::vector<CUnit*> unsortedUnits;
 
+	/// per-unit interpolation inputs, indexed by unit id
+	struct UnitInterpRecord {
+		float3 preFramePos;
+		float3 deltaPos; ///< pos - preFramePos over the last sim frame
+	};
+
+	spring::double_buffer< std::vector<UnitInterpRecord> > unitInterpSnapshot;
+
+	/// opaque-pass instancing; per-instance (model + piece) matrices
+	/// are streamed into a buffer-texture read by the model shaders
+	unsigned int instMatsBuffer = 0;
+	unsigned int instMatsTexture = 0;
+
+	std::vector<CUnit*> instDrawUnits;
+	std::vector<CMatrix44f> instDrawMats;
+
+	/// per-camera unit frustum-visibility (indexed by unit id), built
+	/// lazily once per draw-frame and shared by every pass rendered
+	/// with that camera (forward, deferred, shadow, water reflection)
+	struct CamVisibleUnits {
+		int drawFrame = -1;
+		std::vector<uint8_t> flags;
+	};
+
+	mutable std::array<CamVisibleUnits, CCamera::CAMTYPE_ENVMAP> camVisibleUnits;
+
 	/// AI unit ghosts
 	std::array< std::vector<TempDrawUnit>, MODELTYPE_OTHER> tempOpaqueUnits;
 	std::array< std::vector<TempDrawUnit>, MODELTYPE_OTHER> tempAlphaUnits;
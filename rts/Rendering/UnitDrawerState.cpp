@@ -22,10 +22,46 @@
 
 static std::array<const CMatrix44f, 128> dummyPieceMatrices;
 
+static GLuint pieceMatrixUBO = 0;
+
 
 const CMatrix44f& IUnitDrawerState::GetDummyPieceMatrixRef(size_t idx) { return  dummyPieceMatrices[idx]; }
 const CMatrix44f* IUnitDrawerState::GetDummyPieceMatrixPtr(size_t idx) { return &dummyPieceMatrices[idx]; }
 
+
+void IUnitDrawerState::BindPieceMatrixUBO(unsigned int progID) {
+	if (pieceMatrixUBO == 0) {
+		glGenBuffers(1, &pieceMatrixUBO);
+		glBindBufferBase(GL_UNIFORM_BUFFER, PIECE_MATRIX_UBO_BINDING, pieceMatrixUBO);
+		glBufferData(GL_UNIFORM_BUFFER, dummyPieceMatrices.size() * sizeof(CMatrix44f), dummyPieceMatrices.data(), GL_STREAM_DRAW);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	}
+
+	const GLuint blockIndex = glGetUniformBlockIndex(progID, "PieceMatrices");
+
+	if (blockIndex == GL_INVALID_INDEX)
+		return;
+
+	glUniformBlockBinding(progID, blockIndex, PIECE_MATRIX_UBO_BINDING);
+}
+
+void IUnitDrawerState::UploadPieceMatrices(const CMatrix44f* pieceMats, size_t numPieceMats) {
+	glBindBufferBase(GL_UNIFORM_BUFFER, PIECE_MATRIX_UBO_BINDING, pieceMatrixUBO);
+	// orphan the previous contents, every draw rewrites the block from
+	// scratch and the driver should never have to stall on readers
+	glBufferData(GL_UNIFORM_BUFFER, dummyPieceMatrices.size() * sizeof(CMatrix44f), nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_UNIFORM_BUFFER, 0, std::min(numPieceMats, dummyPieceMatrices.size()) * sizeof(CMatrix44f), &pieceMats[0].m[0]);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void IUnitDrawerState::FreePieceMatrixUBO() {
+	if (pieceMatrixUBO == 0)
+		return;
+
+	glDeleteBuffers(1, &pieceMatrixUBO);
+	pieceMatrixUBO = 0;
+}
+
 float4 IUnitDrawerState::GetTeamColor(int team, float alpha) {
 	assert(teamHandler.IsValidTeam(team));
 
@@ -121,6 +157,8 @@ bool UnitDrawerStateGLSL::Init(const CUnitDrawer* ud) {
 		modelShaders[n]->SetFlag("GBUFFER_ZVALTEX_IDX", GL::GeometryBuffer::ATTACHMENT_ZVALTEX);
 
 		modelShaders[n]->Link();
+		BindPieceMatrixUBO(modelShaders[n]->GetObjID());
+
 		modelShaders[n]->SetUniformLocation("diffuseTex");        // idx  0 (t1: diffuse + team-color)
 		modelShaders[n]->SetUniformLocation("shadingTex");        // idx  1 (t2: spec/refl + self-illum)
 		modelShaders[n]->SetUniformLocation("shadowTex");         // idx  2
@@ -128,7 +166,7 @@ bool UnitDrawerStateGLSL::Init(const CUnitDrawer* ud) {
 
 		modelShaders[n]->SetUniformLocation("sunDir");            // idx  4
 
-		modelShaders[n]->SetUniformLocation("pieceMatrices[0]");  // idx  5
+		modelShaders[n]->SetUniformLocation("pieceMatrices[0]");  // idx  5 (resolves to -1, now a UBO block member; entry kept for numbering)
 		modelShaders[n]->SetUniformLocation("modelMatrix");       // idx  6
 		modelShaders[n]->SetUniformLocation("viewMatrix");        // idx  7
 		modelShaders[n]->SetUniformLocation("projMatrix");        // idx  8
@@ -151,12 +189,18 @@ bool UnitDrawerStateGLSL::Init(const CUnitDrawer* ud) {
 		modelShaders[n]->SetUniformLocation("alphaTestCtrl");     // idx 24
 		modelShaders[n]->SetUniformLocation("gammaExponent");     // idx 25
 		modelShaders[n]->SetUniformLocation("fwdDynLights");      // idx 26
+		modelShaders[n]->SetUniformLocation("instanceMats");      // idx 27
+		modelShaders[n]->SetUniformLocation("instanceMatCount");  // idx 28
+		modelShaders[n]->SetUniformLocation("numDynLights");      // idx 29
 
 		modelShaders[n]->Enable();
 		modelShaders[n]->SetUniform1i(0, 0); // diffuseTex  (idx 0, texunit 0)
 		modelShaders[n]->SetUniform1i(1, 1); // shadingTex  (idx 1, texunit 1)
 		modelShaders[n]->SetUniform1i(2, 2); // shadowTex   (idx 2, texunit 2)
 		modelShaders[n]->SetUniform1i(3, 3); // reflectTex  (idx 3, texunit 3)
+		modelShaders[n]->SetUniform1i(27, 4); // instanceMats (idx 27, texunit 4)
+		modelShaders[n]->SetUniform1i(28, 0); // start on the non-instanced path
+		modelShaders[n]->SetUniform1i(29, 0); // no visible lights until Update
 
 		modelShaders[n]->SetUniform3fv(4, sky->GetLight()->GetLightDir());
 		modelShaders[n]->SetUniform3fv(9, &fogParams.x);
@@ -193,6 +237,9 @@ bool UnitDrawerStateGLSL::Init(const CUnitDrawer* ud) {
 void UnitDrawerStateGLSL::Kill() {
 	modelShaders.fill(nullptr);
 	shaderHandler->ReleaseProgramObjects("[UnitDrawer]");
+
+	// shadow-gen programs sharing the UBO die with us; a reload binds it anew
+	FreePieceMatrixUBO();
 }
 
 void UnitDrawerStateGLSL::Enable(const CUnitDrawer* ud, bool deferredPass, bool alphaPass) {
@@ -207,8 +254,12 @@ void UnitDrawerStateGLSL::Enable(const CUnitDrawer* ud, bool deferredPass, bool
 	      GL::LightHandler* mLightHandler = const_cast<GL::LightHandler*>(cLightHandler); // XXX
 
 	if (cLightHandler->NumConfigLights() > 0) {
+		// culls and compacts, only upload the slots that survived
 		mLightHandler->Update();
-		shader->SetUniform4fv(26, cLightHandler->NumUniformVecs(), cLightHandler->GetRawLightDataPtr());
+		shader->SetUniform1i(29, cLightHandler->NumVisLights());
+
+		if (cLightHandler->NumVisLights() > 0)
+			shader->SetUniform4fv(26, cLightHandler->NumVisUniformVecs(), cLightHandler->GetRawLightDataPtr());
 	}
 
 	shader->SetUniform3fv(9, &fogParams.x);
@@ -266,15 +317,17 @@ void UnitDrawerStateGLSL::SetNanoColor(const float4& color) const {
 void UnitDrawerStateGLSL::SetMatrices(const CMatrix44f& modelMat, const CMatrix44f* pieceMats, size_t numPieceMats) const {
 	Shader::IProgramObject* po = nullptr;
 
+	// both the model and the shadow-gen shaders source their piece
+	// matrices from the shared PieceMatrices block, upload just once
+	if (numPieceMats > 0)
+		UploadPieceMatrices(pieceMats, numPieceMats);
+
 	if (!shadowHandler.InShadowPass()) {
 		po = modelShaders[MODEL_SHADER_ACTIVE];
 
 		assert(shadowHandler.GetCurrentPass() == CShadowHandler::SHADOWGEN_PROGRAM_LAST);
 		assert(po->IsBound());
 
-		if (numPieceMats > 0)
-			po->SetUniformMatrix4fv(5, -int(std::min(numPieceMats, dummyPieceMatrices.size())), false, &pieceMats[0].m[0]);
-
 		po->SetUniformMatrix4fv(6, false, modelMat);
 	} else {
 		po = shadowHandler.GetCurrentShadowGenProg();
@@ -282,15 +335,18 @@ void UnitDrawerStateGLSL::SetMatrices(const CMatrix44f& modelMat, const CMatrix4
 		assert(shadowHandler.GetCurrentPass() == CShadowHandler::SHADOWGEN_PROGRAM_MODEL || shadowHandler.GetCurrentPass() == CShadowHandler::SHADOWGEN_PROGRAM_PROJECTILE);
 		assert(po->IsBound());
 
-		if (numPieceMats > 0)
-			po->SetUniformMatrix4fv(4, -int(std::min(numPieceMats, dummyPieceMatrices.size())), false, &pieceMats[0].m[0]);
-
 		// {Unit,Projectile}Drawer::DrawShadowPass sets view and proj
 		po->SetUniformMatrix4fv(3, false, modelMat);
 	}
 }
 
 
+void UnitDrawerStateGLSL::SetInstanceMatCount(int numMats) const {
+	assert(modelShaders[MODEL_SHADER_ACTIVE]->IsBound());
+	modelShaders[MODEL_SHADER_ACTIVE]->SetUniform1i(28, numMats);
+}
+
+
 void UnitDrawerStateGLSL::SetWaterClipPlane(const DrawPass::e& drawPass) const {
 	assert(modelShaders[MODEL_SHADER_ACTIVE]->IsBound());
 
@@ -35,6 +35,16 @@ public:
 	static const CMatrix44f& GetDummyPieceMatrixRef(size_t idx = 0);
 	static const CMatrix44f* GetDummyPieceMatrixPtr(size_t idx = 0);
 
+	// shared GL_UNIFORM_BUFFER backing the PieceMatrices block in the
+	// model and {model,projectile} shadow-gen shaders; lazily created
+	// by the first BindPieceMatrixUBO call (note: DecalsDrawerGL4 owns
+	// binding points 3-5)
+	static constexpr unsigned int PIECE_MATRIX_UBO_BINDING = 6;
+
+	static void BindPieceMatrixUBO(unsigned int progID);
+	static void UploadPieceMatrices(const CMatrix44f* pieceMats, size_t numPieceMats);
+	static void FreePieceMatrixUBO();
+
 	static float4 GetTeamColor(int team, float alpha);
 
 	IUnitDrawerState() { modelShaders.fill(nullptr); }
@@ -46,6 +56,7 @@ public:
 	virtual bool CanEnable(const CUnitDrawer*) const { return false; }
 	virtual bool CanDrawAlpha() const { return false; }
 	virtual bool CanDrawDeferred() const { return false; }
+	virtual bool CanDrawInstanced() const { return false; }
 
 	virtual void Enable(const CUnitDrawer*, bool, bool) = 0;
 	virtual void Disable(const CUnitDrawer*, bool) = 0;
@@ -61,6 +72,7 @@ public:
 	virtual void SetNanoColor(const float4& color) const = 0;
 	virtual void SetMatrices(const CMatrix44f& modelMat, const std::vector<CMatrix44f>& pieceMats) const = 0;
 	virtual void SetMatrices(const CMatrix44f& modelMat, const CMatrix44f* pieceMats, size_t numPieceMats) const = 0;
+	virtual void SetInstanceMatCount(int numMats) const = 0; // instanced batches
 	virtual void SetWaterClipPlane(const DrawPass::e& drawPass) const = 0; // water
 	virtual void SetBuildClipPlanes(const float4&, const float4&) const = 0; // nano-frames
 
@@ -120,6 +132,7 @@ public:
 	void SetNanoColor(const float4& color) const override {}
 	void SetMatrices(const CMatrix44f& modelMat, const std::vector<CMatrix44f>& pieceMats) const override {}
 	void SetMatrices(const CMatrix44f& modelMat, const CMatrix44f* pieceMats, size_t numPieceMats) const override {}
+	void SetInstanceMatCount(int numMats) const override {}
 	void SetWaterClipPlane(const DrawPass::e& drawPass) const override {}
 	void SetBuildClipPlanes(const float4&, const float4&) const override {}
 };
@@ -144,6 +157,7 @@ public:
 	void SetNanoColor(const float4& color) const override {}
 	void SetMatrices(const CMatrix44f& modelMat, const std::vector<CMatrix44f>& pieceMats) const override { SetMatrices(modelMat, pieceMats.data(), pieceMats.size()); }
 	void SetMatrices(const CMatrix44f& modelMat, const CMatrix44f* pieceMats, size_t numPieceMats) const override {} // handled via LuaObjectDrawer::SetObjectMatrices
+	void SetInstanceMatCount(int numMats) const override {}
 	void SetWaterClipPlane(const DrawPass::e& drawPass) const override {}
 	void SetBuildClipPlanes(const float4&, const float4&) const override {}
 };
@@ -157,6 +171,7 @@ public:
 	bool CanEnable(const CUnitDrawer*) const override { return true; }
 	bool CanDrawAlpha() const override { return true; }
 	bool CanDrawDeferred() const  override { return true; }
+	bool CanDrawInstanced() const override { return true; }
 
 	void Enable(const CUnitDrawer*, bool, bool) override;
 	void Disable(const CUnitDrawer*, bool) override;
@@ -172,6 +187,7 @@ public:
 	void SetNanoColor(const float4& color) const override;
 	void SetMatrices(const CMatrix44f& modelMat, const std::vector<CMatrix44f>& pieceMats) const override { SetMatrices(modelMat, pieceMats.data(), pieceMats.size()); }
 	void SetMatrices(const CMatrix44f& modelMat, const CMatrix44f* pieceMats, size_t numPieceMats) const override;
+	void SetInstanceMatCount(int numMats) const override;
 	void SetWaterClipPlane(const DrawPass::e& drawPass) const override;
 	void SetBuildClipPlanes(const float4&, const float4&) const override;
 };
@@ -401,7 +401,7 @@ void CFeature::DoDamage(
 	float baseDamage = damages.GetDefault();
 	float impulseMult = float((def->drawType >= DRAWTYPE_TREE) || (udef != nullptr && !udef->IsImmobileUnit()));
 
-	if (eventHandler.FeaturePreDamaged(this, attacker, baseDamage, weaponDefID, projectileID, &baseDamage, &impulseMult))
+	if (eventHandler.HasFeaturePreDamagedClients() && eventHandler.FeaturePreDamaged(this, attacker, baseDamage, weaponDefID, projectileID, &baseDamage, &impulseMult))
 		return;
 
 	// NOTE:
@@ -414,6 +414,9 @@ void CFeature::DoDamage(
 	health -= baseDamage;
 	health = std::min(health, def->health);
 
+	// health changed in-place; let area-command pollers know
+	quadField.MarkQuadsChanged(pos, radius);
+
 	eventHandler.FeatureDamaged(this, attacker, baseDamage, weaponDefID, projectileID);
 
 	if (health <= 0.0f && def->destructable) {
@@ -176,6 +176,14 @@ CFeature* CFeatureHandler::CreateWreckage(const FeatureLoadParams& cparams)
 
 void CFeatureHandler::Update()
 {
+	// dormant features (the vast majority; rocks, trees, settled
+	// wrecks) live only in the feature map and cost nothing here,
+	// their Update() returning false drops them from the queue and
+	// explicit events (impulse from damage, fire, terrain changes,
+	// deletion) put them back via SetFeatureUpdateable
+	if (updateFeatures.empty() && deletedFeatureIDs.empty())
+		return;
+
 	SCOPED_TIMER("Sim::Features");
 
 	if ((gs->frameNum & 31) == 0) {
@@ -5,7 +5,8 @@ BuildingMaskMap buildingMaskMap;
 
 CR_BIND(BuildingMaskMap, ())
 CR_REG_METADATA(BuildingMaskMap, (
-	CR_MEMBER(maskMap)
+	CR_MEMBER(maskMap),
+	CR_MEMBER(maskBits)
 ))
 
 
@@ -20,7 +21,16 @@ bool BuildingMaskMap::SetTileMask(unsigned int x, unsigned int z, std::uint16_t
 	if (!CheckBounds(x, z))
 		return false;
 
-	maskMap[x + z * mapDims.hmapx] = value;
+	const unsigned int sqr = x + z * mapDims.hmapx;
+
+	maskMap[sqr] = value;
+
+	if (value != 1) {
+		maskBits[sqr >> 6] |= (1ull << (sqr & 63u));
+	} else {
+		maskBits[sqr >> 6] &= ~(1ull << (sqr & 63u));
+	}
+
 	return true;
 }
 
@@ -29,5 +39,12 @@ bool BuildingMaskMap::SetTileMask(unsigned int x, unsigned int z, std::uint16_t
 bool BuildingMaskMap::TestTileMaskUnsafe(unsigned int x, unsigned int z, std::uint16_t value) const
 {
 	assert(CheckBounds(x, z));
-	return (maskMap[x + z * mapDims.hmapx] & value) == value;
+
+	const unsigned int sqr = x + z * mapDims.hmapx;
+
+	// default tiles (mask 1) allow any value without the 2nd..16th bits
+	if ((maskBits[sqr >> 6] & (1ull << (sqr & 63u))) == 0)
+		return ((value & ~1u) == 0);
+
+	return (maskMap[sqr] & value) == value;
 }
@@ -15,9 +15,12 @@ public:
 	void Init(unsigned int numSquares) {
 		maskMap.clear();
 		maskMap.resize(numSquares, 1); // 1st bit set to 1 indicates a normal tile
+		maskBits.clear();
+		maskBits.resize((numSquares + 63) / 64, 0);
 	};
 	void Kill() {
 		maskMap.clear();
+		maskBits.clear();
 	}
 
 	bool SetTileMask(unsigned int x, unsigned int z, std::uint16_t value);
@@ -29,6 +32,10 @@ private:
 
 private:
 	std::vector<std::uint16_t> maskMap;
+	// packed per-tile flags marking tiles whose mask differs from the
+	// default; almost no tiles ever do, so one word covers queries on
+	// 64 of them without touching maskMap itself
+	std::vector<std::uint64_t> maskBits;
 };
 
 extern BuildingMaskMap buildingMaskMap;
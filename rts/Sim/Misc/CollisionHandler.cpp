@@ -22,6 +22,40 @@ void CCollisionHandler::PrintStats()
 
 
 
+unsigned int CCollisionHandler::FilterSphereBatch(
+	const SphereBatch& batch,
+	const float3& p0,
+	const float3& dir,
+	float length,
+	unsigned char* hits
+) {
+	unsigned int numHits = 0;
+
+	// closest point on the segment to each sphere center; kept free of
+	// branches (min/max compile to minss/maxss) so the loop vectorizes
+	// over the parallel arrays
+	for (unsigned int i = 0; i < batch.count; i++) {
+		const float dx = batch.xs[i] - p0.x;
+		const float dy = batch.ys[i] - p0.y;
+		const float dz = batch.zs[i] - p0.z;
+
+		const float t = std::max(0.0f, std::min(length, dx * dir.x + dy * dir.y + dz * dir.z));
+
+		const float qx = dx - dir.x * t;
+		const float qy = dy - dir.y * t;
+		const float qz = dz - dir.z * t;
+
+		const unsigned char hit = ((qx * qx + qy * qy + qz * qz) <= (batch.rs[i] * batch.rs[i]));
+
+		hits[i] = hit;
+		numHits += hit;
+	}
+
+	return numHits;
+}
+
+
+
 bool CCollisionHandler::DetectHit(
 	const CSolidObject* o,
 	const CMatrix44f& m,
@@ -142,7 +176,7 @@ bool CCollisionHandler::Collision(const CollisionVolume* v, const CMatrix44f& m,
 	// apply it to the projectile's position, then test
 	// if the transformed position lies within the axis-
 	// aligned collision volume
-	const CMatrix44f mInv = m.InvertAffine();
+	const CMatrix44f& mInv = v->GetInverseMatrix(m);
 	const float3 pi = mInv.Mul(p);
 
 	bool hit = false;
@@ -347,7 +381,7 @@ bool CCollisionHandler::Intersect(const CollisionVolume* v, const CMatrix44f& m,
 {
 	numContTests += 1;
 
-	const CMatrix44f mInv = m.InvertAffine();
+	const CMatrix44f& mInv = v->GetInverseMatrix(m);
 	const float3 pi0 = mInv.Mul(p0);
 	const float3 pi1 = mInv.Mul(p1);
 	bool intersect = false;
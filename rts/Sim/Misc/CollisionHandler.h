@@ -95,6 +95,46 @@ class CCollisionHandler {
 	public:
 		static void PrintStats();
 
+		// candidates per SphereBatch, also the flush threshold for callers
+		static constexpr unsigned int SPHERE_BATCH_SIZE = 64;
+
+		// SoA bounding-sphere data for a group of candidate volumes; laid
+		// out as parallel float arrays so FilterSphereBatch reduces to one
+		// tight branch-free loop the compiler can pack into SSE registers
+		struct SphereBatch {
+		public:
+			void Clear() { count = 0; }
+			bool Full() const { return (count == SPHERE_BATCH_SIZE); }
+
+			void Push(const float3& pos, float radius) {
+				xs[count] = pos.x;
+				ys[count] = pos.y;
+				zs[count] = pos.z;
+				rs[count] = radius;
+				count += 1;
+			}
+
+		public:
+			float xs[SPHERE_BATCH_SIZE];
+			float ys[SPHERE_BATCH_SIZE];
+			float zs[SPHERE_BATCH_SIZE];
+			float rs[SPHERE_BATCH_SIZE];
+
+			unsigned int count = 0;
+		};
+
+		// tests every sphere in <batch> against the segment from <p0>
+		// along <dir> over <length> elmos; hits[i] is non-zero iff the
+		// segment passes within sphere i, callers run the full DetectHit
+		// only for those survivors
+		static unsigned int FilterSphereBatch(
+			const SphereBatch& batch,
+			const float3& p0,
+			const float3& dir,
+			float length,
+			unsigned char* hits
+		);
+
 		static bool DetectHit(
 			const CSolidObject* o,
 			const CMatrix44f& m,
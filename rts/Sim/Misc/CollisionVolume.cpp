@@ -8,6 +8,8 @@
 #include "System/SpringMath.h"
 #include "System/StringUtil.h"
 
+#include <cstring> // memcmp
+
 CR_BIND(CollisionVolume, )
 CR_REG_METADATA(CollisionVolume, (
 	CR_MEMBER(fullAxisScales),
@@ -22,6 +24,10 @@ CR_REG_METADATA(CollisionVolume, (
 	CR_MEMBER(volumeType),
 	CR_MEMBER(volumeAxes),
 
+	CR_IGNORED(volMatCacheKey),
+	CR_IGNORED(volMatCacheInv),
+	CR_IGNORED(volMatCacheValid),
+
 	CR_MEMBER(ignoreHits),
 	CR_MEMBER(useContHitTest),
 	CR_MEMBER(defaultToFootPrint),
@@ -228,6 +234,21 @@ float3 CollisionVolume::GetWorldSpacePos(const CSolidObject* o, const float3& ex
 
 
 
+const CMatrix44f& CollisionVolume::GetInverseMatrix(const CMatrix44f& m) const {
+	// any movement or piece animation changes the composed transform
+	// and simply misses here; stationary objects (buildings, features,
+	// wrecks) tested by many rays per frame invert exactly once
+	if (!volMatCacheValid || memcmp(&m, &volMatCacheKey, sizeof(CMatrix44f)) != 0) {
+		volMatCacheKey = m;
+		volMatCacheInv = m.InvertAffine();
+		volMatCacheValid = true;
+	}
+
+	return volMatCacheInv;
+}
+
+
+
 float CollisionVolume::GetPointSurfaceDistance(const CUnit* u, const LocalModelPiece* lmp, const float3& pos) const {
 	return (GetPointSurfaceDistance(u, lmp, u->GetTransformMatrix(true), pos));
 }
@@ -4,6 +4,7 @@
 #define COLLISION_VOLUME_H
 
 #include "System/float4.h"
+#include "System/Matrix44f.h"
 #include "System/creg/creg_cond.h"
 
 // the positive x-axis points to the "left" in object-space and to the "right" in world-space
@@ -125,6 +126,14 @@ public:
 
 	float3 GetWorldSpacePos(const CSolidObject* o, const float3& extOffsets = ZeroVector) const;
 
+	/**
+	 * inverse of the composed world-space transform this volume is
+	 * being tested with; memoizes the last inversion keyed on the
+	 * (bitwise) transform itself, so repeat tests against stationary
+	 * objects skip it without any invalidation hooks in move/anim code
+	 */
+	const CMatrix44f& GetInverseMatrix(const CMatrix44f& m) const;
+
 	float GetPointSurfaceDistance(const CUnit* u, const LocalModelPiece* lmp, const float3& pos) const;
 	float GetPointSurfaceDistance(const CFeature* u, const LocalModelPiece* lmp, const float3& pos) const;
 
@@ -152,6 +161,13 @@ private:
 		COLVOL_AXIS_Y
 	};
 
+	// NOTE: the cache is valid independently of the volume parameters
+	// (the inverse only depends on the key), so assignment and rescale
+	// do not have to reset it
+	mutable CMatrix44f volMatCacheKey;             ///< composed transform the cached inverse was built from
+	mutable CMatrix44f volMatCacheInv;             ///< cached inverse of volMatCacheKey
+	mutable bool volMatCacheValid = false;
+
 	bool ignoreHits = false;                       /// if true, CollisionHandler does not check for hits against us
 	bool useContHitTest = true;                    /// if true, CollisionHandler does continuous instead of discrete hit-testing
 	bool defaultToFootPrint = false;               /// if true, volume becomes a box with dimensions equal to a SolidObject's {x,z}size
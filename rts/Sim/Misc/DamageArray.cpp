@@ -14,15 +14,26 @@ CR_REG_METADATA(DamageArray, (
 	CR_MEMBER(impulseBoost),
 	CR_MEMBER(craterMult),
 	CR_MEMBER(craterBoost),
+	CR_MEMBER(damageMult),
 	CR_MEMBER(damages)
 ))
 
 void DamageArray::SetDefaultDamage(float damage)
 {
+	damageMult = 1.0f;
+
 	damages.clear();
 	damages.resize(std::max(1, damageArrayHandler.GetNumTypes()), damage);
 }
 
+void DamageArray::Materialize()
+{
+	for (unsigned int a = 0; a < damages.size(); ++a)
+		damages[a] *= damageMult;
+
+	damageMult = 1.0f;
+}
+
 
 CR_BIND_DERIVED(DynDamageArray, DamageArray, )
 
@@ -84,14 +95,14 @@ DamageArray DynDamageArray::GetDynamicDamages(const float3& startPos, const floa
 
 	const float travDist  = std::min(dynDamageRange, curPos.distance2D(startPos));
 	const float damageMod = 1.0f - math::pow(1.0f / dynDamageRange * travDist, dynDamageExp);
-	const float ddmod     = dynDamageMin / damages[0]; // get damage mod from first damage type
+	const float ddmod     = dynDamageMin / GetDefault(); // get damage mod from first damage type
 
 	if (dynDamageInverted) {
 		for (int i = 0; i < damageArrayHandler.GetNumTypes(); ++i) {
-			float d = damages[i] - damageMod * damages[i];
+			float d = Get(i) - damageMod * Get(i);
 
 			if (dynDamageMin > 0.0f)
-				d = std::max(damages[i] * ddmod, d);
+				d = std::max(Get(i) * ddmod, d);
 
 			// to prevent div by 0
 			d = std::max(0.0001f, d);
@@ -99,10 +110,10 @@ DamageArray DynDamageArray::GetDynamicDamages(const float3& startPos, const floa
 		}
 	} else {
 		for (int i = 0; i < damageArrayHandler.GetNumTypes(); ++i) {
-			float d = damageMod * damages[i];
+			float d = damageMod * Get(i);
 
 			if (dynDamageMin > 0.0f)
-				d = std::max(damages[i] * ddmod, d);
+				d = std::max(Get(i) * ddmod, d);
 
 			// div by 0
 			d = std::max(0.0001f, d);
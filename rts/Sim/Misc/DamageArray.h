@@ -22,6 +22,8 @@ public:
 
 		, craterMult(1.0f)
 		, craterBoost(0.0f)
+
+		, damageMult(1.0f)
 	{
 		SetDefaultDamage(damage);
 	}
@@ -41,6 +43,7 @@ public:
 		craterMult = da.craterMult;
 		craterBoost = da.craterBoost;
 
+		damageMult = da.damageMult;
 		damages = da.damages;
 		return *this;
 	}
@@ -53,27 +56,40 @@ public:
 		craterMult = da.craterMult;
 		craterBoost = da.craterBoost;
 
+		damageMult = da.damageMult;
 		damages = std::move(da.damages);
 		return *this;
 	}
 
-	DamageArray operator * (float damageMult) const {
+	// scaling only touches the deferred multiplier, the per-type
+	// values (shared base-table data for weapondefs) stay untouched
+	DamageArray operator * (float mult) const {
 		DamageArray da(*this);
 
-		for (unsigned int a = 0; a < damages.size(); ++a)
-			da.damages[a] *= damageMult;
-
+		da.damageMult *= mult;
 		return da;
 	}
 
+	DamageArray& operator *= (float mult) {
+		damageMult *= mult;
+		return *this;
+	}
+
 
 	int GetNumTypes() const { return damages.size(); }
 
 	void SetDefaultDamage(float damage);
-	void Set(int typeIndex, float d) { damages[typeIndex] = d; }
+	void Set(int typeIndex, float d) {
+		// per-class overrides are rare, fold the multiplier first so
+		// absolute values keep their meaning
+		if (damageMult != 1.0f)
+			Materialize();
 
-	float Get(int typeIndex) const { return damages[typeIndex]; }
-	float GetDefault() const { return damages[0]; }
+		damages[typeIndex] = d;
+	}
+
+	float Get(int typeIndex) const { return damages[typeIndex] * damageMult; }
+	float GetDefault() const { return damages[0] * damageMult; }
 
 public:
 	int paralyzeDamageTime;
@@ -85,6 +101,12 @@ public:
 	float craterBoost;
 
 protected:
+	void Materialize();
+
+	/// uniform scale applied on Get(), so operator* need not write
+	/// (or copy-on-write) every per-type value
+	float damageMult;
+
 	std::vector<float> damages;
 };
 
@@ -22,7 +22,9 @@ CR_BIND(CGroundBlockingObjectMap, )
 CR_REG_METADATA(CGroundBlockingObjectMap, (
 	CR_MEMBER(arrCells),
 	CR_MEMBER(vecCells),
-	CR_MEMBER(vecIndcs)
+	CR_MEMBER(vecIndcs),
+	CR_MEMBER(cellBits),
+	CR_MEMBER(wordEpochs)
 ))
 
 
@@ -130,6 +132,9 @@ bool CGroundBlockingObjectMap::GroundBlocked(int x, int z, const CSolidObject* i
 	if (static_cast<unsigned int>(x) >= mapDims.mapx || static_cast<unsigned int>(z) >= mapDims.mapy)
 		return false;
 
+	if (!CellOccupied(z * mapDims.mapx + x))
+		return false;
+
 	const BlockingMapCell& cell = GetCellUnsafeConst(z * mapDims.mapx + x);
 
 	if (cell.empty())
@@ -198,7 +203,16 @@ bool CGroundBlockingObjectMap::CheckYard(const CSolidObject* yardUnit, const Yar
 	const int2 maxs = mins + int2(yardUnit->xsize, yardUnit->zsize);
 
 	for (int z = mins.y; z < maxs.y; ++z) {
+		// word-at-a-time occupancy probe; a fully empty footprint row can
+		// not contain a blocker whatever its yardmap cells say
+		if (CellRowRangeEmpty(z * mapDims.mapx + mins.x, z * mapDims.mapx + maxs.x))
+			continue;
+
 		for (int x = mins.x; x < maxs.x; ++x) {
+			// probe before evaluating the (virtual) yardmap lookup
+			if (!CellOccupied(z * mapDims.mapx + x))
+				continue;
+
 			if ((yardUnit->GetGroundBlockingMaskAtPos(float3(x * SQUARE_SIZE, 0.0f, z * SQUARE_SIZE)) & mask) == 0)
 				continue;
 
@@ -210,6 +224,34 @@ bool CGroundBlockingObjectMap::CheckYard(const CSolidObject* yardUnit, const Yar
 	return true;
 }
 
+// tests whether all cells in the row span [sqrMin, sqrMax) are empty,
+// touching only the packed occupancy words instead of the cells
+bool CGroundBlockingObjectMap::CellRowRangeEmpty(unsigned int sqrMin, unsigned int sqrMax) const
+{
+	assert(sqrMin < sqrMax);
+
+	const unsigned int wordMin = sqrMin >> 6;
+	const unsigned int wordMax = (sqrMax - 1) >> 6;
+
+	const uint64_t headMask = (~0ull) << (sqrMin & 63u);
+	const uint64_t tailMask = (~0ull) >> (63u - ((sqrMax - 1) & 63u));
+
+	if (wordMin == wordMax)
+		return ((cellBits[wordMin] & headMask & tailMask) == 0);
+
+	if ((cellBits[wordMin] & headMask) != 0)
+		return false;
+	if ((cellBits[wordMax] & tailMask) != 0)
+		return false;
+
+	for (unsigned int w = wordMin + 1; w < wordMax; w++) {
+		if (cellBits[w] != 0)
+			return false;
+	}
+
+	return true;
+}
+
 
 unsigned int CGroundBlockingObjectMap::CalcChecksum() const
 {
@@ -231,8 +273,11 @@ bool CGroundBlockingObjectMap::CellInsertUnique(unsigned int sqr, CSolidObject*
 
 	if (ac.Contains(o))
 		return false;
-	if (ac.Insert(o))
+	if (ac.Insert(o)) {
+		cellBits[sqr >> 6] |= (1ull << (sqr & 63u));
+		wordEpochs[sqr >> 6]++;
 		return true;
+	}
 
 	// array-cell is full, spill over
 	if ((vc = &GetVecCell(sqr)) == &vecCells[0]) {
@@ -240,13 +285,20 @@ bool CGroundBlockingObjectMap::CellInsertUnique(unsigned int sqr, CSolidObject*
 			assert(vecCells.size() > 0);
 			ac.SetVecIndx(vecCells.size());
 			vc = &spring::VectorEmplaceBack(vecCells);
+			// spare the append below (and the next few) a regrowth;
+			// recycled spill-cells keep their capacity via vecIndcs
+			vc->reserve(8);
 		} else {
 			ac.SetVecIndx(spring::VectorBackPop(vecIndcs));
 			vc = &vecCells[ac.GetVecIndx()];
 		}
 	}
 
-	return (spring::VectorInsertUnique(*vc, o, true));
+	if (!spring::VectorInsertUnique(*vc, o, true))
+		return false;
+
+	wordEpochs[sqr >> 6]++;
+	return true;
 }
 
 bool CGroundBlockingObjectMap::CellErase(unsigned int sqr, CSolidObject* o) {
@@ -254,8 +306,13 @@ bool CGroundBlockingObjectMap::CellErase(unsigned int sqr, CSolidObject* o) {
 	VecCell* vc = nullptr;
 
 	if (ac.Erase(o)) {
-		if (ac.GetVecIndx() == 0)
+		if (ac.GetVecIndx() == 0) {
+			if (ac.Empty())
+				cellBits[sqr >> 6] &= ~(1ull << (sqr & 63u));
+
+			wordEpochs[sqr >> 6]++;
 			return true;
+		}
 
 		// never allow a hole between array and vector parts
 		assert(!vecCells[ac.GetVecIndx()].empty());
@@ -284,6 +341,27 @@ CommonExit:
 		ac.SetVecIndx(0);
 	}
 
+	wordEpochs[sqr >> 6]++;
 	return true;
 }
 
+
+uint32_t CGroundBlockingObjectMap::CalcFootprintEpoch(const CSolidObject* object) const
+{
+	const int bx = object->mapPos.x, sx = object->xsize;
+	const int bz = object->mapPos.y, sz = object->zsize;
+
+	uint32_t epoch = 0;
+
+	for (int z = bz; z < bz + sz; z++) {
+		const unsigned int wordMin = (z * mapDims.mapx + bx) >> 6;
+		const unsigned int wordMax = (z * mapDims.mapx + bx + sx - 1) >> 6;
+
+		for (unsigned int w = wordMin; w <= wordMax; w++) {
+			epoch += wordEpochs[w];
+		}
+	}
+
+	return epoch;
+}
+
@@ -3,6 +3,7 @@
 #ifndef GROUNDBLOCKINGOBJECTMAP_H
 #define GROUNDBLOCKINGOBJECTMAP_H
 
+#include <algorithm>
 #include <array>
 #include <vector>
 
@@ -99,8 +100,15 @@ public:
 
 	void Init(unsigned int numSquares) {
 		arrCells.resize(numSquares);
-		vecCells.reserve(32);
-		vecIndcs.reserve(32);
+		cellBits.clear();
+		cellBits.resize((numSquares + 63) / 64, 0);
+		wordEpochs.clear();
+		wordEpochs.resize((numSquares + 63) / 64, 0);
+		// spill-cells are rare (only squares with >8 overlapping objects)
+		// but the pool vector must not regrow mid-game, large battles can
+		// exceed the old reserve of 32
+		vecCells.reserve(128);
+		vecIndcs.reserve(128);
 
 		// add dummy
 		if (vecCells.empty())
@@ -116,6 +124,9 @@ public:
 			v.clear();
 		}
 
+		std::fill(cellBits.begin(), cellBits.end(), 0);
+		std::fill(wordEpochs.begin(), wordEpochs.end(), 0);
+
 		vecIndcs.clear();
 	}
 
@@ -130,6 +141,10 @@ public:
 	bool CanOpenYard(const CSolidObject* object) const { return CheckYard(object, YARDMAP_YARDINV); }
 	bool CanCloseYard(const CSolidObject* object) const { return CheckYard(object, YARDMAP_YARD); }
 
+	// sum of the per-word change counters covering the object's footprint;
+	// a (failed) yard check can only turn out differently once this moves
+	uint32_t CalcFootprintEpoch(const CSolidObject* object) const;
+
 
 	// these retrieve either the first object in
 	// a given cell, or NULL if the cell is empty
@@ -138,6 +153,9 @@ public:
 
 	// same as GroundBlocked(), but does not bounds-check mapSquare
 	CSolidObject* GroundBlockedUnsafe(unsigned int mapSquare) const {
+		if (!CellOccupied(mapSquare))
+			return nullptr;
+
 		const BlockingMapCell& cell = GetCellUnsafeConst(mapSquare);
 
 		if (cell.empty())
@@ -146,6 +164,12 @@ public:
 		return cell[0];
 	}
 
+	// one packed-word probe instead of an array-cell load; most of the
+	// map is empty so rectangle scans touch far less memory this way
+	bool CellOccupied(unsigned int mapSquare) const {
+		return ((cellBits[mapSquare >> 6] & (1ull << (mapSquare & 63u))) != 0);
+	}
+
 
 	bool GroundBlocked(int x, int z, const CSolidObject* ignoreObj) const;
 	bool GroundBlocked(const float3& pos, const CSolidObject* ignoreObj) const;
@@ -173,6 +197,7 @@ public:
 
 private:
 	bool CheckYard(const CSolidObject* yardUnit, const YardMapStatus& mask) const;
+	bool CellRowRangeEmpty(unsigned int sqrMin, unsigned int sqrMax) const;
 
 	const ArrCell& GetArrCell(unsigned int mapSquare) const { return           arrCells[mapSquare]               ; }
 	      ArrCell& GetArrCell(unsigned int mapSquare)       { return           arrCells[mapSquare]               ; }
@@ -186,6 +211,10 @@ private:
 	std::vector<ArrCell> arrCells;
 	std::vector<VecCell> vecCells;
 	std::vector<uint32_t> vecIndcs;
+	// packed per-cell occupancy flags, mirrors arrCells[i].Empty()
+	std::vector<uint64_t> cellBits;
+	// per-word mutation counters, bumped on every cell insert/erase
+	std::vector<uint32_t> wordEpochs;
 };
 
 extern CGroundBlockingObjectMap groundBlockingObjectMap;
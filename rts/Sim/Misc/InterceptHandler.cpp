@@ -6,6 +6,7 @@
 #include "InterceptHandler.h"
 
 #include "Map/Ground.h"
+#include "Sim/Misc/GlobalConstants.h"
 #include "Sim/Misc/GlobalSynced.h"
 #include "Sim/Misc/TeamHandler.h"
 #include "Sim/Weapons/Weapon.h"
@@ -38,7 +39,26 @@ void CInterceptHandler::Update(bool forced) {
 
 		assert(wDef->interceptor || wDef->isShield);
 
+		// small slack so the quick rejection below stays conservative
+		// wrt the projected-impact test when a projectile never hits
+		// the ground (impactDist < 0 puts pImpactPos behind the ray)
+		const float sqCoverageDist = Square(wDef->coverageRange + SQUARE_SIZE);
+
 		for (CWeaponProjectile* p: interceptables) {
+			// quick rejection; none of the four acceptance cases below can
+			// hold unless p's target or its (2D-projected) flight path gets
+			// within coverage range of <w>, so spare the ground-intersection
+			// and event queries for the vast majority of pairs
+			const float3 pWeaponVec = p->pos - w->aimFromPos;
+
+			if (w->aimFromPos.SqDistance2D(p->GetTargetPos()) >= sqCoverageDist) {
+				const float dirSqLen2D = p->dir.SqLength2D();
+				const float minSepTime = (dirSqLen2D > 0.0f)? std::max(0.0f, -(pWeaponVec.dot2D(p->dir)) / dirSqLen2D): 0.0f;
+
+				if ((pWeaponVec + p->dir * minSepTime).SqLength2D() >= sqCoverageDist)
+					continue;
+			}
+
 			if (!p->CanBeInterceptedBy(wDef))
 				continue;
 			if (w->HasIncomingProjectile(p->id))
@@ -66,7 +86,6 @@ void CInterceptHandler::Update(bool forced) {
 
 			const float3& pImpactPos = p->pos + p->dir * impactDist;
 			const float3& pTargetPos = p->GetTargetPos();
-			const float3  pWeaponVec = p->pos - w->aimFromPos;
 
 			if (w->aimFromPos.SqDistance2D(pTargetPos) < Square(wDef->coverageRange)) {
 				w->AddDeathDependence(p, DEPENDENCE_INTERCEPT);
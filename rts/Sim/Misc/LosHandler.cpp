@@ -15,6 +15,9 @@
 #include "System/SafeUtil.h"
 #include "System/TimeProfiler.h"
 #include "System/Threading/ThreadPool.h"
+#ifdef USE_UNSYNCED_HEIGHTMAP
+	#include "Game/GlobalUnsynced.h" // for myAllyTeam
+#endif
 
 #define USE_STAGGERED_UPDATES 0
 
@@ -509,6 +512,12 @@ void ILosType::Update()
 		losRecalc.reserve(losUpdate.size());
 	}
 
+	losMoved.clear();
+
+	// indices (into losAdd/losRemove) of instances eligible for pairing
+	std::vector<size_t> newInstIdcs;
+	std::vector<size_t> remInstIdcs;
+
 	// filter the updates into their subparts
 	for (SLosInstance* li: losUpdate) {
 		const auto status = OptimizeInstanceUpdate(li);
@@ -517,6 +526,7 @@ void ILosType::Update()
 		switch (status) {
 			case SLosInstance::TLosStatus::NEW: {
 				if (algoType == LOS_ALGO_RAYCAST) losRecalc.push_back(li);
+				if (algoType == LOS_ALGO_RAYCAST) newInstIdcs.push_back(losAdd.size());
 				losAdd.push_back(li);
 			} break;
 			case SLosInstance::TLosStatus::REACTIVATE: {
@@ -528,6 +538,7 @@ void ILosType::Update()
 				losAdd.push_back(li);
 			} break;
 			case SLosInstance::TLosStatus::REMOVE: {
+				if (algoType == LOS_ALGO_RAYCAST) remInstIdcs.push_back(losRemove.size());
 				losRemove.push_back(li);
 				losDeleted.push_back(li);
 			} break;
@@ -545,12 +556,72 @@ void ILosType::Update()
 		}
 	}
 
-	// remove sight
-	//FIXME multithread?
-	for (SLosInstance* li: losRemove) {
-		LosRemove(li);
+	// pair each created instance with a removed one of the same ally-team
+	// and radius whose base square lies at most two squares away; these
+	// belong to units that moved, so almost all of their squares overlap
+	// and can keep their counts (the raycast from the new vantage point
+	// still runs, only the los-map application becomes a delta-update)
+	for (const size_t ai: newInstIdcs) {
+		SLosInstance* ali = losAdd[ai];
+
+		constexpr int maxPairDistSq = 2 * 2;
+
+		size_t bestIdx = size_t(-1);
+		int bestDistSq = maxPairDistSq + 1;
+
+		for (size_t k = 0; k < remInstIdcs.size(); ++k) {
+			const SLosInstance* rli = losRemove[remInstIdcs[k]];
+
+			if (rli == nullptr)
+				continue;
+			if (rli->allyteam != ali->allyteam || rli->radius != ali->radius)
+				continue;
+
+			const int2 d = rli->basePos - ali->basePos;
+			const int distSq = d.x * d.x + d.y * d.y;
+
+			if (distSq >= bestDistSq)
+				continue;
+
+			bestDistSq = distSq;
+			bestIdx = k;
+		}
+
+		if (bestIdx == size_t(-1))
+			continue;
+
+		losMoved.emplace_back(losRemove[remInstIdcs[bestIdx]], ali);
+		losRemove[remInstIdcs[bestIdx]] = nullptr;
+		losAdd[ai] = nullptr;
 	}
 
+	// every instance only writes the refcount grid of its own ally-team,
+	// so the map application can be sharded by team across the pool with
+	// bit-identical results (order within a team is preserved, and teams
+	// never share squares)
+	const int numAllyTeams = losMaps.size();
+
+	#ifdef USE_UNSYNCED_HEIGHTMAP
+	// teams visible to the local player can push unsynced-heightmap
+	// updates from inside AddRaycast; those must stay on the calling
+	// thread since ReadMap::UpdateLOS is not thread-safe
+	const auto TeamEmitsReadmapEvents = [&](const int at) {
+		return ((type == LOS_TYPE_LOS) && (at == gu->myAllyTeam || gu->spectatingFullView));
+	};
+	#else
+	const auto TeamEmitsReadmapEvents = [](const int at) { return false; };
+	#endif
+
+	// remove sight (never generates events)
+	for_mt(0, numAllyTeams, [&](const int at) {
+		for (SLosInstance* li: losRemove) {
+			if (li == nullptr || li->allyteam != at)
+				continue;
+
+			LosRemove(li);
+		}
+	});
+
 	// raycast terrain
 	if (algoType == LOS_ALGO_RAYCAST)  {
 		for_mt(0, losRecalc.size(), [&](const int idx) {
@@ -561,10 +632,37 @@ void ILosType::Update()
 		});
 	}
 
-	// add sight
-	for (SLosInstance* li: losAdd) {
-		assert(li->refCount > 0);
-		LosAdd(li);
+	// add sight, including the paired move deltas (these need the fresh
+	// raycast results)
+	const auto AddSightForAllyTeam = [&](const int at) {
+		for (SLosInstance* li: losAdd) {
+			if (li == nullptr || li->allyteam != at)
+				continue;
+
+			assert(li->refCount > 0);
+			LosAdd(li);
+		}
+
+		for (const auto& p: losMoved) {
+			if (p.second->allyteam != at)
+				continue;
+
+			losMaps[at].ApplyRaycastDelta(p.first, p.second);
+		}
+	};
+
+	for_mt(0, numAllyTeams, [&](const int at) {
+		if (TeamEmitsReadmapEvents(at))
+			return;
+
+		AddSightForAllyTeam(at);
+	});
+
+	for (int at = 0; at < numAllyTeams; ++at) {
+		if (!TeamEmitsReadmapEvents(at))
+			continue;
+
+		AddSightForAllyTeam(at);
 	}
 
 	// delete / move to cache unused instances
@@ -191,6 +191,8 @@ private:
 	std::vector<SLosInstance*> losAdd;
 	std::vector<SLosInstance*> losDeleted;
 	std::vector<SLosInstance*> losRecalc;
+	// (removed, created) pairs applied as incremental los-map deltas
+	std::vector<std::pair<SLosInstance*, SLosInstance*>> losMoved;
 
 	static constexpr int CACHE_SIZE = 4096;
 };
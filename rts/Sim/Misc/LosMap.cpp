@@ -6,6 +6,7 @@
 #include "LosMap.h"
 #include "LosHandler.h"
 #include "Map/ReadMap.h"
+#include "System/bitops.h"
 #include "System/SpringMath.h"
 #include "System/float3.h"
 #include "System/Log/ILog.h"
@@ -410,6 +411,8 @@ void CLosMap::AddCircle(SLosInstance* instance, int amount)
 	//only AddRaycast supports UnsyncedHeightMap updates
 #endif
 
+	ExpandDirtyRect(instance->basePos - int2(instance->radius, instance->radius), instance->basePos + int2(instance->radius, instance->radius));
+
 	MidpointCircleAlgoPerLine(instance->radius, [&](int width, int y) {
 		const unsigned y_ = instance->basePos.y + y;
 
@@ -432,6 +435,8 @@ void CLosMap::AddRaycast(SLosInstance* instance, int amount)
 	if (losSquares.empty() || losSquares[0].length == SLosInstance::EMPTY_RLE.length)
 		return;
 
+	ExpandDirtyRect(instance->basePos - int2(instance->radius, instance->radius), instance->basePos + int2(instance->radius, instance->radius));
+
 #ifdef USE_UNSYNCED_HEIGHTMAP
 	// inform ReadMap when squares enter LoS
 	const bool visibleInstanceSquares = (instance->allyteam >= 0 && (instance->allyteam == gu->myAllyTeam || gu->spectatingFullView));
@@ -467,6 +472,120 @@ void CLosMap::AddRaycast(SLosInstance* instance, int amount)
 }
 
 
+void CLosMap::ApplyRaycastDelta(const SLosInstance* oldInstance, const SLosInstance* newInstance)
+{
+	const auto& oldSquares = oldInstance->squares;
+	const auto& newSquares = newInstance->squares;
+
+	ExpandDirtyRect(oldInstance->basePos - int2(oldInstance->radius, oldInstance->radius), oldInstance->basePos + int2(oldInstance->radius, oldInstance->radius));
+	ExpandDirtyRect(newInstance->basePos - int2(newInstance->radius, newInstance->radius), newInstance->basePos + int2(newInstance->radius, newInstance->radius));
+
+#ifdef USE_UNSYNCED_HEIGHTMAP
+	const bool visibleInstanceSquares = (newInstance->allyteam >= 0 && (newInstance->allyteam == gu->myAllyTeam || gu->spectatingFullView));
+	const bool updateUnsyncedHeightMap = sendReadmapEvents && visibleInstanceSquares;
+#endif
+
+	const auto AddSpan = [&](int sIdx, int eIdx) {
+		for (int idx = sIdx; idx < eIdx; ++idx) {
+			losmap[idx] += 1;
+
+#ifdef USE_UNSYNCED_HEIGHTMAP
+			// skip if this los-square did not *enter* LOS
+			if (losmap[idx] != 1 || !updateUnsyncedHeightMap)
+				continue;
+
+			const int2 lm = IdxToCoord(idx, size.x);
+			const int2 p1 = (lm             ) * LOS2HEIGHT;
+			const int2 p2 = (lm + int2(1, 1)) * LOS2HEIGHT;
+			const int2 p3 = {std::min(p2.x, mapDims.mapxm1), std::min(p2.y, mapDims.mapym1)};
+
+			readMap->UpdateLOS(SRectangle(p1.x, p1.y,  p3.x, p3.y));
+#endif
+		}
+	};
+	const auto SubSpan = [&](int sIdx, int eIdx) {
+		for (int idx = sIdx; idx < eIdx; ++idx) {
+			losmap[idx] -= 1;
+		}
+	};
+
+	// both RLE lists are sorted by map index (built row by row), so the
+	// symmetric difference can be applied with a two-pointer merge; the
+	// squares in the intersection never change their count and generate
+	// no enter/leave-LOS events
+	size_t oldNum = 0;
+	size_t newNum = 0;
+
+	int oldBeg = 0, oldEnd = 0; // current old run, [oldBeg, oldEnd)
+	int newBeg = 0, newEnd = 0; // current new run, [newBeg, newEnd)
+
+	const auto NextOldRun = [&]() {
+		while (oldNum < oldSquares.size() && oldSquares[oldNum].length == 0) { ++oldNum; }
+		if (oldNum >= oldSquares.size())
+			return false;
+
+		oldBeg = oldSquares[oldNum].start;
+		oldEnd = oldBeg + oldSquares[oldNum].length;
+		++oldNum;
+		return true;
+	};
+	const auto NextNewRun = [&]() {
+		while (newNum < newSquares.size() && newSquares[newNum].length == 0) { ++newNum; }
+		if (newNum >= newSquares.size())
+			return false;
+
+		newBeg = newSquares[newNum].start;
+		newEnd = newBeg + newSquares[newNum].length;
+		++newNum;
+		return true;
+	};
+
+	bool haveOldRun = NextOldRun();
+	bool haveNewRun = NextNewRun();
+
+	while (haveOldRun && haveNewRun) {
+		if (oldEnd <= newBeg) {
+			SubSpan(oldBeg, oldEnd);
+			haveOldRun = NextOldRun();
+			continue;
+		}
+		if (newEnd <= oldBeg) {
+			AddSpan(newBeg, newEnd);
+			haveNewRun = NextNewRun();
+			continue;
+		}
+
+		// runs overlap; apply the non-shared prefix, skip the shared part
+		if (oldBeg < newBeg)
+			SubSpan(oldBeg, newBeg);
+		else if (newBeg < oldBeg)
+			AddSpan(newBeg, oldBeg);
+
+		const int ovlEnd = std::min(oldEnd, newEnd);
+
+		if (oldEnd <= ovlEnd) {
+			haveOldRun = NextOldRun();
+		} else {
+			oldBeg = ovlEnd;
+		}
+		if (newEnd <= ovlEnd) {
+			haveNewRun = NextNewRun();
+		} else {
+			newBeg = ovlEnd;
+		}
+	}
+
+	while (haveOldRun) {
+		SubSpan(oldBeg, oldEnd);
+		haveOldRun = NextOldRun();
+	}
+	while (haveNewRun) {
+		AddSpan(newBeg, newEnd);
+		haveNewRun = NextNewRun();
+	}
+}
+
+
 void CLosMap::PrepareRaycast(SLosInstance* instance) const
 {
 	if (!instance->squares.empty())
@@ -512,10 +631,36 @@ void CLosMap::LosAdd(SLosInstance* li) const
 }
 
 
+// spreads the lower 32 bits of v over the even bits of the result
+inline static constexpr size_t InterleaveBits(size_t v)
+{
+	v = (v | (v << 16)) & 0x0000FFFF0000FFFFull;
+	v = (v | (v <<  8)) & 0x00FF00FF00FF00FFull;
+	v = (v | (v <<  4)) & 0x0F0F0F0F0F0F0F0Full;
+	v = (v | (v <<  2)) & 0x3333333333333333ull;
+	v = (v | (v <<  1)) & 0x5555555555555555ull;
+	return v;
+}
+
+// The angle and visibility scratch buffers are stored in Z-order (Morton)
+// rather than row-major: CastLos walks them along rays in all directions,
+// so with row-major storage every vertical step lands a full row apart in
+// memory while Z-order keeps squares that are close in 2D close in the
+// buffer. These buffers are private to the raycaster, hence free to pick
+// whatever layout suits the access pattern; the losmap itself stays
+// row-major since its counts are only ever touched via RLE spans (and is
+// exposed raw to the ground drawer and the AI interface).
 inline static constexpr size_t ToAngleMapIdx(const int2 p, const int radius)
 {
-	// [-radius, +radius]^2 -> [0, +2*radius]^2 -> idx
-	return (p.y + radius) * (2 * radius + 1) + (p.x + radius);
+	// [-radius, +radius]^2 -> [0, +2*radius]^2 -> z-order idx
+	return InterleaveBits(p.x + radius) | (InterleaveBits(p.y + radius) << 1);
+}
+
+// Z-order needs pow2 dimensions, so the buffers are padded; the padding is
+// never indexed but has to exist since interleaved indices are not dense
+inline static size_t AngleMapSize(const int radius)
+{
+	return Square(next_power_of_2((2 * radius) + 1));
 }
 
 
@@ -555,15 +700,13 @@ void CLosMap::AddSquaresToInstance(SLosInstance* li, const std::vector<char>& lo
 	const int2 pos   = li->basePos;
 	const int radius = li->radius;
 
-	const char* ptr = &losRaySquares[0];
-
 	auto& losSquares = li->squares;
 
 	for (int y = -radius; y <= radius; ++y) {
 		SLosInstance::RLE rle = {MAP_SQUARE(pos + int2(-radius, y)), 0};
 
 		for (int x = -radius; x <= radius; ++x) {
-			if (*(ptr++)) {
+			if (losRaySquares[ToAngleMapIdx(int2(x, y), radius)]) {
 				++rle.length;
 			} else {
 				if (rle.length > 0)
@@ -608,9 +751,9 @@ void CLosMap::UnsafeLosAdd(SLosInstance* li) const
 	helper.GenerateForLosSize(radius);
 
 	losRaySquares.clear();
-	losRaySquares.resize(Square((2 * radius) + 1), false);
+	losRaySquares.resize(AngleMapSize(radius), false);
 	raycastAngles.clear();
-	raycastAngles.resize(Square((2 * radius) + 1), -1e8);
+	raycastAngles.resize(AngleMapSize(radius), -1e8);
 
 
 	isqrtTableExpand((radius + 1) * (radius + 1), threadNum);
@@ -625,28 +768,21 @@ void CLosMap::UnsafeLosAdd(SLosInstance* li) const
 		const unsigned sx = pos.x - width;
 		const unsigned ex = pos.x + width + 1;
 
-		const size_t oidx = ToAngleMapIdx(int2(sx - pos.x, y), radius);
-
-		float* raycastAnglesPtr = &raycastAngles[oidx];
-		char* losRaySquaresPtr = &losRaySquares[oidx];
-
 		int idx = MAP_SQUARE(int2(sx, y_));
 
-		for (unsigned x_ = sx; x_ < ex; ++x_) {
+		for (unsigned x_ = sx; x_ < ex; ++x_, ++idx) {
 			const int2 off(x_ - pos.x, y);
 
-			if (off == int2(0, 0)) {
-				++idx;
-				++raycastAnglesPtr;
-				++losRaySquaresPtr;
+			if (off == int2(0, 0))
 				continue;
-			}
 
 			const float invR = isqrtTableLookup(off.x*off.x + off.y*off.y, threadNum);
-			const float dh = std::max(0.0f, mipHeightMap[idx++]) - losHeight;
+			const float dh = std::max(0.0f, mipHeightMap[idx]) - losHeight;
+
+			const size_t oidx = ToAngleMapIdx(off, radius);
 
-			*(raycastAnglesPtr++) = (dh + LOS_BONUS_HEIGHT) * invR;
-			*(losRaySquaresPtr++) = true;
+			raycastAngles[oidx] = (dh + LOS_BONUS_HEIGHT) * invR;
+			losRaySquares[oidx] = true;
 		}
 	});
 
@@ -694,9 +830,9 @@ void CLosMap::SafeLosAdd(SLosInstance* li) const
 	helper.GenerateForLosSize(radius);
 
 	losRaySquares.clear();
-	losRaySquares.resize(Square((2 * radius) + 1), false);
+	losRaySquares.resize(AngleMapSize(radius), false);
 	raycastAngles.clear();
-	raycastAngles.resize(Square((2 * radius) + 1), -1e8);
+	raycastAngles.resize(AngleMapSize(radius), -1e8);
 
 
 	const SRectangle safeRect(0, 0, size.x, size.y);
@@ -711,28 +847,21 @@ void CLosMap::SafeLosAdd(SLosInstance* li) const
 			const unsigned sx = Clamp(pos.x - width,     0, size.x);
 			const unsigned ex = Clamp(pos.x + width + 1, 0, size.x);
 
-			const size_t oidx = ToAngleMapIdx(int2(sx - pos.x, y), radius);
-
-			float* raycastAnglesPtr = &raycastAngles[oidx];
-			char* losRaySquaresPtr = &losRaySquares[oidx];
-
 			int idx = MAP_SQUARE(int2(sx, y_));
 
-			for (unsigned x_ = sx; x_ < ex; ++x_) {
+			for (unsigned x_ = sx; x_ < ex; ++x_, ++idx) {
 				const int2 off(x_ - pos.x, y);
 
-				if (off == int2(0, 0)) {
-					++idx;
-					++raycastAnglesPtr;
-					++losRaySquaresPtr;
+				if (off == int2(0, 0))
 					continue;
-				}
 
 				const float invR = isqrtTableLookup(off.x*off.x + off.y*off.y, threadNum);
-				const float dh = std::max(0.0f, mipHeightMap[idx++]) - losHeight;
+				const float dh = std::max(0.0f, mipHeightMap[idx]) - losHeight;
+
+				const size_t oidx = ToAngleMapIdx(off, radius);
 
-				*(raycastAnglesPtr++) = (dh + LOS_BONUS_HEIGHT) * invR;
-				*(losRaySquaresPtr++) = true;
+				raycastAngles[oidx] = (dh + LOS_BONUS_HEIGHT) * invR;
+				losRaySquares[oidx] = true;
 			}
 		}
 	});
@@ -5,6 +5,7 @@
 #ifndef LOS_MAP_H
 #define LOS_MAP_H
 
+#include <algorithm>
 #include <vector>
 #include "System/type2.h"
 #include "System/SpringMath.h"
@@ -29,6 +30,9 @@ public:
 		mipHeightMap = mipHeightMap_;
 
 		sendReadmapEvents = sendReadmapEvents_;
+
+		dirtyMins = int2(0, 0);
+		dirtyMaxs = size - int2(1, 1);
 	}
 
 	void Kill() {}
@@ -40,6 +44,13 @@ public:
 	/// arbitrary area, for losMap, non-circular radar maps, ...
 	void AddRaycast(SLosInstance* instance, int amount);
 
+	/// applies AddRaycast(oldInstance, -1) plus AddRaycast(newInstance, 1)
+	/// in a single pass that skips the squares covered by both instances;
+	/// much cheaper when the instances belong to a unit that moved by only
+	/// a square or two, since then all but the leading/trailing crescents
+	/// keep their counts
+	void ApplyRaycastDelta(const SLosInstance* oldInstance, const SLosInstance* newInstance);
+
 	/// arbitrary area, for losMap, non-circular radar maps, ...
 	void PrepareRaycast(SLosInstance* instance) const;
 
@@ -53,6 +64,21 @@ public:
 	// FIXME temp fix for CBaseGroundDrawer and AI interface, which need raw data
 	const unsigned short& front() const { return (losmap.front()); }
 
+	/// bounding rectangle (in los-squares, inclusive) of every count that
+	/// changed since the last call; lets the info-texture renderer upload
+	/// only modified rows instead of the whole map each draw frame
+	bool ConsumeDirtyRect(int2& mins, int2& maxs) {
+		if (dirtyMaxs.x < dirtyMins.x || dirtyMaxs.y < dirtyMins.y)
+			return false;
+
+		mins = dirtyMins;
+		maxs = dirtyMaxs;
+
+		dirtyMins = size;
+		dirtyMaxs = int2(-1, -1);
+		return true;
+	}
+
 private:
 	void LosAdd(SLosInstance* instance) const;
 	void UnsafeLosAdd(SLosInstance* instance) const;
@@ -60,12 +86,25 @@ private:
 
 	void AddSquaresToInstance(SLosInstance* li, const std::vector<char>& losRaySquares) const;
 
+	// instances only ever touch squares inside their bounding box, which
+	// is much cheaper to accumulate than the exact set of changed squares
+	void ExpandDirtyRect(const int2 mins, const int2 maxs) {
+		dirtyMins.x = std::min(dirtyMins.x, std::max(mins.x, 0));
+		dirtyMins.y = std::min(dirtyMins.y, std::max(mins.y, 0));
+		dirtyMaxs.x = std::max(dirtyMaxs.x, std::min(maxs.x, size.x - 1));
+		dirtyMaxs.y = std::max(dirtyMaxs.y, std::min(maxs.y, size.y - 1));
+	}
+
 protected:
 	int2 size;
 	int2 LOS2HEIGHT;
 
 	std::vector<unsigned short> losmap;
 
+	// empty iff maxs < mins (per-component)
+	int2 dirtyMins;
+	int2 dirtyMaxs = int2(-1, -1);
+
 	const float* ctrHeightMap = nullptr;
 	const float* mipHeightMap = nullptr;
 
@@ -96,6 +96,8 @@ void CModInfo::ResetState()
 		pfRawDistMult    = 1.25f;
 		pfUpdateRate     = 0.007f;
 
+		pfDeferredRequests = false;
+
 		allowTake = true;
 	}
 }
@@ -134,6 +136,7 @@ void CModInfo::Init(const std::string& modFileName)
 		pathFinderSystem = Clamp(system.GetInt("pathFinderSystem", HAPFS_TYPE), int(NOPFS_TYPE), int(QTPFS_TYPE));
 		pfRawDistMult = system.GetFloat("pathFinderRawDistMult", pfRawDistMult);
 		pfUpdateRate = system.GetFloat("pathFinderUpdateRate", pfUpdateRate);
+		pfDeferredRequests = system.GetBool("pathFinderDeferredRequests", pfDeferredRequests);
 
 		allowTake = system.GetBool("allowTake", allowTake);
 	}
@@ -162,6 +162,10 @@ public:
 	float pfRawDistMult;
 	float pfUpdateRate;
 
+	/// whether synced HAPFS path-requests are queued and resolved at the
+	/// next PathManager::Update instead of synchronously at the callsite
+	bool pfDeferredRequests;
+
 	bool allowTake;
 };
 
@@ -20,8 +20,11 @@
 CR_BIND(CQuadField, )
 CR_REG_METADATA(CQuadField, (
 	CR_MEMBER(baseQuads),
+	CR_MEMBER(coarseObjectCounts),
 	CR_MEMBER(numQuadsX),
 	CR_MEMBER(numQuadsZ),
+	CR_MEMBER(numCoarseX),
+	CR_MEMBER(numCoarseZ),
 	CR_MEMBER(quadSizeX),
 	CR_MEMBER(quadSizeZ),
 	CR_MEMBER(invQuadSize),
@@ -40,6 +43,7 @@ CR_REG_METADATA_SUB(CQuadField, Quad, (
 	CR_MEMBER(features),
 	CR_MEMBER(projectiles),
 	CR_MEMBER(repulsers),
+	CR_MEMBER(changeCounter),
 
 	CR_POSTLOAD(PostLoad)
 ))
@@ -120,7 +124,12 @@ void CQuadField::Init(int2 mapDims, int quadSize)
 
 	invQuadSize = {1.0f / quadSizeX, 1.0f / quadSizeZ};
 
+	numCoarseX = ((numQuadsX + (1 << COARSE_QUAD_SHIFT) - 1) >> COARSE_QUAD_SHIFT);
+	numCoarseZ = ((numQuadsZ + (1 << COARSE_QUAD_SHIFT) - 1) >> COARSE_QUAD_SHIFT);
+
 	baseQuads.resize(numQuadsX * numQuadsZ);
+	coarseObjectCounts.clear();
+	coarseObjectCounts.resize(numCoarseX * numCoarseZ, 0);
 	tempQuads.ReserveAll(numQuadsX * numQuadsZ);
 	tempQuads.ReleaseAll();
 
@@ -139,6 +148,8 @@ void CQuadField::Kill()
 		quad.Clear();
 	}
 
+	std::fill(coarseObjectCounts.begin(), coarseObjectCounts.end(), 0);
+
 	tempUnits.ReleaseAll();
 	tempFeatures.ReleaseAll();
 	tempProjectiles.ReleaseAll();
@@ -220,12 +231,15 @@ void CQuadField::GetQuadsRectangle(QuadFieldQuery& qfq, const float3& mins, cons
 
 /// note: this function got an UnitTest, check the tests/ folder!
 void CQuadField::GetQuadsOnRay(QuadFieldQuery& qfq, const float3& start, const float3& dir, float length)
+{
+	GetQuadsOnRay(*(qfq.quads = tempQuads.ReserveVector()), start, dir, length);
+}
+
+void CQuadField::GetQuadsOnRay(std::vector<int>& queryQuads, const float3& start, const float3& dir, float length) const
 {
 	dir.AssertNaNs();
 	start.AssertNaNs();
 
-	auto& queryQuads = *(qfq.quads = tempQuads.ReserveVector());
-
 	const float3 to = start + (dir * length);
 
 	const bool noXdir = (math::floor(start.x * invQuadSize.x) == math::floor(to.x * invQuadSize.x));
@@ -324,6 +338,8 @@ bool CQuadField::InsertUnitIf(CUnit* unit, const float3& wpos)
 
 	spring::VectorInsertUnique(baseQuads[wposQuadIdx].units, unit, false);
 	spring::VectorInsertUnique(baseQuads[wposQuadIdx].teamUnits[unit->allyteam], unit, false);
+	baseQuads[wposQuadIdx].changeCounter += 1;
+	AddCoarseObject(wposQuadIdx);
 	return true;
 }
 
@@ -354,6 +370,8 @@ bool CQuadField::RemoveUnitIf(CUnit* unit, const float3& wpos)
 
 	spring::VectorErase(baseQuads[wposQuadIdx].units, unit);
 	spring::VectorErase(baseQuads[wposQuadIdx].teamUnits[unit->allyteam], unit);
+	baseQuads[wposQuadIdx].changeCounter += 1;
+	DelCoarseObject(wposQuadIdx);
 	return true;
 }
 #endif
@@ -363,6 +381,24 @@ bool CQuadField::RemoveUnitIf(CUnit* unit, const float3& wpos)
 #ifndef UNIT_TEST
 void CQuadField::MovedUnit(CUnit* unit)
 {
+	// decide the single-quad case (overwhelmingly common for units
+	// smaller than a quad) arithmetically, without touching the pool;
+	// a 1x1 rectangle always passes the distance filter in GetQuads
+	{
+		float3 pos = unit->pos;
+		pos.ClampInBounds();
+
+		const int2 qmin = WorldPosToQuadField(pos - unit->radius);
+		const int2 qmax = WorldPosToQuadField(pos + unit->radius);
+
+		if (qmin.x == qmax.x && qmin.y == qmax.y) {
+			const int qi = qmin.y * numQuadsX + qmin.x;
+
+			if (unit->quads.size() == 1 && unit->quads[0] == qi)
+				return;
+		}
+	}
+
 	QuadFieldQuery qfQuery;
 	GetQuads(qfQuery, unit->pos, unit->radius);
 
@@ -375,14 +411,20 @@ void CQuadField::MovedUnit(CUnit* unit)
 	for (const int qi: unit->quads) {
 		spring::VectorErase(baseQuads[qi].units, unit);
 		spring::VectorErase(baseQuads[qi].teamUnits[unit->allyteam], unit);
+		baseQuads[qi].changeCounter += 1;
+		DelCoarseObject(qi);
 	}
 
 	for (const int qi: *qfQuery.quads) {
 		spring::VectorInsertUnique(baseQuads[qi].units, unit, false);
 		spring::VectorInsertUnique(baseQuads[qi].teamUnits[unit->allyteam], unit, false);
+		baseQuads[qi].changeCounter += 1;
+		AddCoarseObject(qi);
 	}
 
-	unit->quads = std::move(*qfQuery.quads);
+	// swap rather than move so neither buffer is ever reallocated; the
+	// old quad-list goes back into the pool along with its capacity
+	unit->quads.swap(*qfQuery.quads);
 }
 
 void CQuadField::RemoveUnit(CUnit* unit)
@@ -390,6 +432,8 @@ void CQuadField::RemoveUnit(CUnit* unit)
 	for (const int qi: unit->quads) {
 		spring::VectorErase(baseQuads[qi].units, unit);
 		spring::VectorErase(baseQuads[qi].teamUnits[unit->allyteam], unit);
+		baseQuads[qi].changeCounter += 1;
+		DelCoarseObject(qi);
 	}
 
 	unit->quads.clear();
@@ -421,10 +465,12 @@ void CQuadField::MovedRepulser(CPlasmaRepulser* repulser)
 
 	for (const int qi: repulserQuads) {
 		spring::VectorErase(baseQuads[qi].repulsers, repulser);
+		DelCoarseObject(qi);
 	}
 
 	for (const int qi: *qfQuery.quads) {
 		spring::VectorInsertUnique(baseQuads[qi].repulsers, repulser, false);
+		AddCoarseObject(qi);
 	}
 
 	repulser->SetQuads(std::move(*qfQuery.quads));
@@ -434,6 +480,7 @@ void CQuadField::RemoveRepulser(CPlasmaRepulser* repulser)
 {
 	for (const int qi: repulser->GetQuads()) {
 		spring::VectorErase(baseQuads[qi].repulsers, repulser);
+		DelCoarseObject(qi);
 	}
 
 	repulser->ClearQuads();
@@ -455,6 +502,8 @@ void CQuadField::AddFeature(CFeature* feature)
 
 	for (const int qi: *qfQuery.quads) {
 		spring::VectorInsertUnique(baseQuads[qi].features, feature, false);
+		baseQuads[qi].changeCounter += 1;
+		AddCoarseObject(qi);
 	}
 }
 
@@ -464,7 +513,10 @@ void CQuadField::RemoveFeature(CFeature* feature)
 	GetQuads(qfQuery, feature->pos, feature->radius);
 
 	for (const int qi: *qfQuery.quads) {
-		spring::VectorErase(baseQuads[qi].features, feature);
+		if (spring::VectorErase(baseQuads[qi].features, feature)) {
+			baseQuads[qi].changeCounter += 1;
+			DelCoarseObject(qi);
+		}
 	}
 
 	#ifdef DEBUG_QUADFIELD
@@ -477,6 +529,38 @@ void CQuadField::RemoveFeature(CFeature* feature)
 }
 
 
+unsigned int CQuadField::GetQuadsChangeSum(const float3& pos, float radius)
+{
+	QuadFieldQuery qfQuery;
+	GetQuads(qfQuery, pos, radius);
+
+	unsigned int changeSum = 0;
+
+	for (const int qi: *qfQuery.quads) {
+		changeSum += baseQuads[qi].changeCounter;
+	}
+
+	return changeSum;
+}
+
+void CQuadField::MarkQuadsChanged(const CUnit* unit)
+{
+	for (const int qi: unit->quads) {
+		baseQuads[qi].changeCounter += 1;
+	}
+}
+
+void CQuadField::MarkQuadsChanged(const float3& pos, float radius)
+{
+	QuadFieldQuery qfQuery;
+	GetQuads(qfQuery, pos, radius);
+
+	for (const int qi: *qfQuery.quads) {
+		baseQuads[qi].changeCounter += 1;
+	}
+}
+
+
 
 void CQuadField::MovedProjectile(CProjectile* p)
 {
@@ -503,12 +587,15 @@ void CQuadField::AddProjectile(CProjectile* p)
 
 		for (const int qi: *qfQuery.quads) {
 			spring::VectorInsertUnique(baseQuads[qi].projectiles, p, false);
+			AddCoarseObject(qi);
 		}
 
-		p->quads = std::move(*qfQuery.quads);
+		// swap, same reason as in MovedUnit
+		p->quads.swap(*qfQuery.quads);
 	} else {
 		int newQuad = WorldPosToQuadFieldIdx(p->pos);
 		spring::VectorInsertUnique(baseQuads[newQuad].projectiles, p, false);
+		AddCoarseObject(newQuad);
 		p->quads.clear();
 		p->quads.push_back(newQuad);
 	}
@@ -520,6 +607,7 @@ void CQuadField::RemoveProjectile(CProjectile* p)
 
 	for (const int qi: p->quads) {
 		spring::VectorErase(baseQuads[qi].projectiles, p);
+		DelCoarseObject(qi);
 	}
 
 	p->quads.clear();
@@ -537,6 +625,10 @@ void CQuadField::GetUnits(QuadFieldQuery& qfq, const float3& pos, float radius)
 	qfq.units = tempUnits.ReserveVector();
 
 	for (const int qi: *qfQuery.quads) {
+		// skip whole empty 4x4 blocks without touching their quads
+		if (CoarseCellEmpty(qi))
+			continue;
+
 		for (CUnit* u: baseQuads[qi].units) {
 			if (u->tempNum == tempNum)
 				continue;
@@ -557,6 +649,9 @@ void CQuadField::GetUnitsExact(QuadFieldQuery& qfq, const float3& pos, float rad
 	qfq.units = tempUnits.ReserveVector();
 
 	for (const int qi: *qfQuery.quads) {
+		if (CoarseCellEmpty(qi))
+			continue;
+
 		for (CUnit* u: baseQuads[qi].units) {
 			if (u->tempNum == tempNum)
 				continue;
@@ -587,6 +682,9 @@ void CQuadField::GetUnitsExact(QuadFieldQuery& qfq, const float3& mins, const fl
 	qfq.units = tempUnits.ReserveVector();
 
 	for (const int qi: *qfQuery.quads) {
+		if (CoarseCellEmpty(qi))
+			continue;
+
 		for (CUnit* unit: baseQuads[qi].units) {
 
 			if (unit->tempNum == tempNum)
@@ -616,6 +714,9 @@ void CQuadField::GetFeaturesExact(QuadFieldQuery& qfq, const float3& pos, float
 	qfq.features = tempFeatures.ReserveVector();
 
 	for (const int qi: *qfQuery.quads) {
+		if (CoarseCellEmpty(qi))
+			continue;
+
 		for (CFeature* f: baseQuads[qi].features) {
 			if (f->tempNum == tempNum)
 				continue;
@@ -646,6 +747,9 @@ void CQuadField::GetFeaturesExact(QuadFieldQuery& qfq, const float3& mins, const
 	qfq.features = tempFeatures.ReserveVector();
 
 	for (const int qi: *qfQuery.quads) {
+		if (CoarseCellEmpty(qi))
+			continue;
+
 		for (CFeature* feature: baseQuads[qi].features) {
 			if (feature->tempNum == tempNum)
 				continue;
@@ -675,6 +779,9 @@ void CQuadField::GetProjectilesExact(QuadFieldQuery& qfq, const float3& pos, flo
 	qfq.projectiles = tempProjectiles.ReserveVector();
 
 	for (const int qi: *qfQuery.quads) {
+		if (CoarseCellEmpty(qi))
+			continue;
+
 		for (CProjectile* p: baseQuads[qi].projectiles) {
 			if (p->tempNum == tempNum)
 				continue;
@@ -699,6 +806,9 @@ void CQuadField::GetProjectilesExact(QuadFieldQuery& qfq, const float3& mins, co
 	qfq.projectiles = tempProjectiles.ReserveVector();
 
 	for (const int qi: *qfQuery.quads) {
+		if (CoarseCellEmpty(qi))
+			continue;
+
 		for (CProjectile* p: baseQuads[qi].projectiles) {
 			if (p->tempNum == tempNum)
 				continue;
@@ -733,6 +843,9 @@ void CQuadField::GetSolidsExact(
 	qfq.solids = tempSolids.ReserveVector();
 
 	for (const int qi: *qfQuery.quads) {
+		if (CoarseCellEmpty(qi))
+			continue;
+
 		for (CUnit* u: baseQuads[qi].units) {
 			if (u->tempNum == tempNum)
 				continue;
@@ -781,6 +894,9 @@ bool CQuadField::NoSolidsExact(
 	const int tempNum = gs->GetTempNum();
 
 	for (const int qi: *qfQuery.quads) {
+		if (CoarseCellEmpty(qi))
+			continue;
+
 		for (CUnit* u: baseQuads[qi].units) {
 			if (u->tempNum == tempNum)
 				continue;
@@ -833,6 +949,9 @@ void CQuadField::GetUnitsAndFeaturesColVol(
 	// start counting from the previous object-cache sizes
 
 	for (const int qi: *qfQuery.quads) {
+		if (CoarseCellEmpty(qi))
+			continue;
+
 		const Quad& quad = baseQuads[qi];
 
 		for (CUnit* u: quad.units) {
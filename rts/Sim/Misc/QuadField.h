@@ -95,6 +95,10 @@ public:
 	void GetQuads(QuadFieldQuery& qfq, float3 pos, float radius);
 	void GetQuadsRectangle(QuadFieldQuery& qfq, const float3& mins, const float3& maxs);
 	void GetQuadsOnRay(QuadFieldQuery& qfq, const float3& start, const float3& dir, float length);
+	// const cache-free variant; fills a caller-owned list so ray traces
+	// from multiple threads (e.g. unsynced GuiTraceRay or AI callbacks)
+	// never contend on the shared query-vector cache
+	void GetQuadsOnRay(std::vector<int>& queryQuads, const float3& start, const float3& dir, float length) const;
 
 	void GetUnitsAndFeaturesColVol(
 		const float3& pos,
@@ -167,6 +171,16 @@ public:
 	void MovedRepulser(CPlasmaRepulser* repulser);
 	void RemoveRepulser(CPlasmaRepulser* repulser);
 
+	// sum of per-quad change-counters inside the circle; pollers (e.g.
+	// builders holding area commands) can skip rescanning a region that
+	// reports the same sum as their previous, unsuccessful scan
+	unsigned int GetQuadsChangeSum(const float3& pos, float radius);
+
+	// tick the counters of all quads touched by <unit> resp. the circle;
+	// called for state changes (damage) that do not move any object
+	void MarkQuadsChanged(const CUnit* unit);
+	void MarkQuadsChanged(const float3& pos, float radius);
+
 	void ReleaseVector(std::vector<CUnit*>* v       ) { tempUnits.ReleaseVector(v); }
 	void ReleaseVector(std::vector<CFeature*>* v    ) { tempFeatures.ReleaseVector(v); }
 	void ReleaseVector(std::vector<CProjectile*>* v ) { tempProjectiles.ReleaseVector(v); }
@@ -188,6 +202,7 @@ public:
 			features = std::move(q.features);
 			projectiles = std::move(q.projectiles);
 			repulsers = std::move(q.repulsers);
+			changeCounter = q.changeCounter;
 			return *this;
 		}
 
@@ -203,6 +218,7 @@ public:
 			features.clear();
 			projectiles.clear();
 			repulsers.clear();
+			changeCounter = 0;
 		}
 
 	public:
@@ -211,6 +227,11 @@ public:
 		std::vector<CFeature*> features;
 		std::vector<CProjectile*> projectiles;
 		std::vector<CPlasmaRepulser*> repulsers;
+
+		// bumped whenever unit or feature content (incl. health, via
+		// MarkQuadsChanged) changes; projectiles do not tick it since
+		// no poller cares about them
+		unsigned int changeCounter = 0;
 	};
 
 	const Quad& GetQuad(unsigned i) const {
@@ -230,14 +251,36 @@ public:
 	int GetQuadSizeZ() const { return quadSizeZ; }
 
 	constexpr static unsigned int BASE_QUAD_SIZE = 128;
+	// each coarse cell covers a 4x4 block of base quads; object-count
+	// tracking at this level lets large-radius queries skip the empty
+	// parts of a map wholesale, so their cost scales with how densely
+	// objects cluster instead of with map area
+	constexpr static int COARSE_QUAD_SHIFT = 2;
 
 private:
 	int2 WorldPosToQuadField(const float3 p) const;
 	int WorldPosToQuadFieldIdx(const float3 p) const;
 
+	int QuadToCoarseIdx(int quadIdx) const {
+		const int x = quadIdx % numQuadsX;
+		const int z = quadIdx / numQuadsX;
+		return ((z >> COARSE_QUAD_SHIFT) * numCoarseX + (x >> COARSE_QUAD_SHIFT));
+	}
+
+	bool CoarseCellEmpty(int quadIdx) const { return (coarseObjectCounts[QuadToCoarseIdx(quadIdx)] == 0); }
+
+	void AddCoarseObject(int quadIdx) { ++coarseObjectCounts[QuadToCoarseIdx(quadIdx)]; }
+	void DelCoarseObject(int quadIdx) {
+		assert(coarseObjectCounts[QuadToCoarseIdx(quadIdx)] > 0);
+		--coarseObjectCounts[QuadToCoarseIdx(quadIdx)];
+	}
+
 private:
 	std::vector<Quad> baseQuads;
 
+	// number of objects (of any kind) in each 4x4 block of base quads
+	std::vector<int> coarseObjectCounts;
+
 	// preallocated vectors for Get*Exact functions
 	QueryVectorCache<CUnit*> tempUnits;
 	QueryVectorCache<CFeature*> tempFeatures;
@@ -250,6 +293,9 @@ private:
 	int numQuadsX;
 	int numQuadsZ;
 
+	int numCoarseX;
+	int numCoarseZ;
+
 	int quadSizeX;
 	int quadSizeZ;
 };
@@ -18,10 +18,13 @@ using std::fclose;
 #include "Game/GameSetup.h"
 #include "Map/MapInfo.h"
 #include "Map/MetalMap.h"
+#include "System/FileSystem/ArchiveScanner.h"
 #include "System/FileSystem/DataDirsAccess.h"
 #include "System/FileSystem/FileQueryFlags.h"
 #include "System/FileSystem/FileSystem.h"
 #include "System/Log/ILog.h"
+#include "System/MainDefines.h"
+#include "System/Threading/ThreadPool.h"
 
 #include <stdexcept>
 
@@ -171,77 +174,52 @@ void CResourceMapAnalyzer::GetResourcePoints() {
 
 	// Now work out how much resources each spot can make
 	// by adding up the resources from nearby spots
-	for (int y = 0; y < mapHeight; y++) {
-		for (int x = 0; x < mapWidth; x++) {
-			totalResources = 0;
-
-			// first spot needs full calculation
-			if (x == 0 && y == 0)
-				for (int sy = y - xtractorRadius, a = 0;  sy <= y + xtractorRadius;  sy++, a++) {
-					if (sy >= 0 && sy < mapHeight){
-						for (int sx = x - xend[a]; sx <= x + xend[a]; sx++) {
-							if (sx >= 0 && sx < mapWidth) {
-								// get the resources from all pixels around the extractor radius
-								totalResources += rexArrayA[sy * mapWidth + sx];
-							}
-						}
-					}
-				}
-
-			// quick calc test
-			if (x > 0) {
-				totalResources = tempAverage[y * mapWidth + x - 1];
-				for (int sy = y - xtractorRadius, a = 0;  sy <= y + xtractorRadius;  sy++, a++) {
-					if (sy >= 0 && sy < mapHeight) {
-						const int addX = x + xend[a];
-						const int remX = x - xend[a] - 1;
-
-						if (addX < mapWidth) {
-							totalResources += rexArrayA[sy * mapWidth + addX];
-						}
-						if (remX >= 0) {
-							totalResources -= rexArrayA[sy * mapWidth + remX];
-						}
-					}
-				}
-			} else if (y > 0) {
-				// x == 0 here
-				totalResources = tempAverage[(y - 1) * mapWidth];
-				// remove the top half
-				int a = xtractorRadius;
-
-				for (int sx = 0; sx <= xtractorRadius;  sx++, a++) {
-					if (sx < mapWidth) {
-						const int remY = y - xend[a] - 1;
-
-						if (remY >= 0) {
-							totalResources -= rexArrayA[remY * mapWidth + sx];
-						}
-					}
+	//
+	// a row only depends on rexArrayA and its own left neighbor once
+	// the x = 0 window is summed in full, so rows can be spread over
+	// the pool; every cell gets the exact integer window sum no matter
+	// which worker computes it, keeping the result (and with it the
+	// spot list) deterministic
+	for_mt(0, mapHeight, [&](const int y) {
+		int rowResources = 0;
+
+		// first spot of the row needs the full calculation
+		for (int sy = y - xtractorRadius, a = 0;  sy <= y + xtractorRadius;  sy++, a++) {
+			if (sy >= 0 && sy < mapHeight) {
+				for (int sx = 0; sx <= xend[a] && sx < mapWidth; sx++) {
+					// get the resources from all pixels around the extractor radius
+					rowResources += rexArrayA[sy * mapWidth + sx];
 				}
+			}
+		}
 
-				// add the bottom half
-				a = xtractorRadius;
+		tempAverage[y * mapWidth] = rowResources;
 
-				for (int sx = 0; sx <= xtractorRadius;  sx++, a++) {
-					if (sx < mapWidth) {
-						const int addY = y + xend[a];
+		// slide the window right over the remaining columns
+		for (int x = 1; x < mapWidth; x++) {
+			for (int sy = y - xtractorRadius, a = 0;  sy <= y + xtractorRadius;  sy++, a++) {
+				if (sy >= 0 && sy < mapHeight) {
+					const int addX = x + xend[a];
+					const int remX = x - xend[a] - 1;
 
-						if (addY < mapHeight) {
-							totalResources += rexArrayA[addY * mapWidth + sx];
-						}
+					if (addX < mapWidth) {
+						rowResources += rexArrayA[sy * mapWidth + addX];
+					}
+					if (remX >= 0) {
+						rowResources -= rexArrayA[sy * mapWidth + remX];
 					}
 				}
 			}
 
 			// set that spot's resource making ability
-			// (divide by cells to values are small)
-			tempAverage[y * mapWidth + x] = totalResources;
+			tempAverage[y * mapWidth + x] = rowResources;
+		}
+	});
 
-			if (maxResource < totalResources) {
-				// find the spot with the highest resource value to set as the map's max
-				maxResource = totalResources;
-			}
+	for (int i = 0; i < totalCells; i++) {
+		if (maxResource < tempAverage[i]) {
+			// find the spot with the highest resource value to set as the map's max
+			maxResource = tempAverage[i];
 		}
 	}
 
@@ -565,7 +543,14 @@ bool CResourceMapAnalyzer::LoadResourceMap() {
 std::string CResourceMapAnalyzer::GetCacheFileName() const {
 
 	const CResourceDescription* resource = resourceHandler->GetResource(resourceId);
-	std::string absFile = CACHE_BASE + gameSetup->mapName + resource->name;
+
+	// key on the map's content checksum (under just the name a stale
+	// analysis would survive map updates) and on the extractor radius
+	// the spots were found with, which differs between games
+	char keyBuf[32];
+	SNPRINTF(keyBuf, sizeof(keyBuf), "-%08x-%i", archiveScanner->GetArchiveCompleteChecksum(gameSetup->mapName), xtractorRadius);
+
+	std::string absFile = CACHE_BASE + gameSetup->mapName + resource->name + keyBuf;
 
 	return absFile;
 }
@@ -1,5 +1,7 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
+#include <algorithm>
+
 #include "SimObjectIDPool.h"
 #include "GlobalConstants.h"
 #include "GlobalSynced.h"
@@ -11,7 +13,10 @@ CR_BIND(SimObjectIDPool, )
 CR_REG_METADATA(SimObjectIDPool, (
 	CR_MEMBER(poolIDs),
 	CR_MEMBER(freeIDs),
-	CR_MEMBER(tempIDs)
+	CR_MEMBER(tempIDs),
+	CR_MEMBER(freeFlags),
+	CR_MEMBER(freeIDsHead),
+	CR_MEMBER(numFreeIDs)
 ))
 
 
@@ -32,20 +37,20 @@ void SimObjectIDPool::Expand(unsigned int baseID, unsigned int numIDs) {
 	baseID -= numIDs;
 
 	// NOTE:
-	//   any randomization would be undone by a sorted std::container
-	//   instead create a bi-directional mapping from indices to ID's
-	//   (where the ID's are a random permutation of the index range)
-	//   such that ID's can be assigned and returned to the pool with
-	//   their original index, e.g.
-	//
-	//     freeIDs<idx, uid> = {<0, 13>, < 1, 27>, < 2, 54>, < 3, 1>, ...}
-	//     poolIDs<uid, idx> = {<1,  3>, <13,  0>, <27,  1>, <54, 2>, ...}
-	//
+	//   ID's are assigned from the ring in FIFO order, i.e. as the random
+	//   permutation generated above; the uid --> idx map makes reservation
+	//   of specific ID's and availability checks constant-time
 	//   (the ID --> index map is never changed at runtime!)
+	freeIDs.reserve(freeIDs.size() + numIDs);
+	freeFlags.resize(std::max(freeFlags.size(), size_t(baseID + numIDs)), 0);
+
 	for (unsigned int offsetID = 0; offsetID < numIDs; offsetID++) {
-		freeIDs.insert(std::pair<unsigned int, unsigned int>(baseID + offsetID, newIDs[offsetID]));
 		poolIDs.insert(std::pair<unsigned int, unsigned int>(newIDs[offsetID], baseID + offsetID));
+		freeIDs.push_back(newIDs[offsetID]);
+		freeFlags[baseID + offsetID] = 1;
 	}
+
+	numFreeIDs += numIDs;
 }
 
 
@@ -59,21 +64,38 @@ void SimObjectIDPool::AssignID(CSolidObject* object) {
 }
 
 unsigned int SimObjectIDPool::ExtractID() {
-	// extract a random ID from the pool
+	// extract the next ID from the ring
 	//
 	// should be unreachable, UnitHandler
 	// and FeatureHandler have safeguards
 	assert(!IsEmpty());
 
-	const auto it = freeIDs.begin();
-	const unsigned int uid = it->second;
+	// drop the consumed prefix once it dominates the ring
+	if (freeIDsHead > 1024 && freeIDsHead * 2 >= freeIDs.size()) {
+		freeIDs.erase(freeIDs.begin(), freeIDs.begin() + freeIDsHead);
+		freeIDsHead = 0;
+	}
+
+	// skip entries invalidated by ReserveID; each stale entry
+	// is visited at most once over the lifetime of the ring so
+	// extraction stays amortized constant-time
+	while (true) {
+		assert(freeIDsHead < freeIDs.size());
 
-	freeIDs.erase(it);
+		const unsigned int uid = freeIDs[freeIDsHead++];
+		const unsigned int idx = poolIDs[uid];
 
-	if (IsEmpty())
-		RecycleIDs();
+		if (freeFlags[idx] == 0)
+			continue;
 
-	return uid;
+		freeFlags[idx] = 0;
+		numFreeIDs -= 1;
+
+		if (IsEmpty())
+			RecycleIDs();
+
+		return uid;
+	}
 }
 
 void SimObjectIDPool::ReserveID(unsigned int uid) {
@@ -82,9 +104,10 @@ void SimObjectIDPool::ReserveID(unsigned int uid) {
 	assert(!IsEmpty());
 
 	const auto it = poolIDs.find(uid);
-	const unsigned int idx = it->second;
 
-	freeIDs.erase(idx);
+	// lazily invalidate the ring entry
+	freeFlags[it->second] = 0;
+	numFreeIDs -= 1;
 
 	if (!IsEmpty())
 		return;
@@ -100,29 +123,37 @@ void SimObjectIDPool::FreeID(unsigned int uid, bool delayed) {
 	assert(!HasID(uid));
 
 	if (delayed) {
-		tempIDs.insert(std::pair<unsigned int, unsigned int>(poolIDs[uid], uid));
+		tempIDs.push_back(uid);
 	} else {
-		freeIDs.insert(std::pair<unsigned int, unsigned int>(poolIDs[uid], uid));
+		freeIDs.push_back(uid);
+		freeFlags[poolIDs[uid]] = 1;
+		numFreeIDs += 1;
 	}
 }
 
 bool SimObjectIDPool::RecycleID(unsigned int uid) {
 	assert(poolIDs.find(uid) != poolIDs.end());
 
-	const unsigned int idx = poolIDs[uid];
-	const auto it = tempIDs.find(idx);
+	const auto it = std::find(tempIDs.begin(), tempIDs.end(), uid);
 
 	if (it == tempIDs.end())
 		return false;
 
-	tempIDs.erase(idx);
-	freeIDs.insert(std::pair<unsigned int, unsigned int>(idx, uid));
+	tempIDs.erase(it);
+	freeIDs.push_back(uid);
+	freeFlags[poolIDs[uid]] = 1;
+	numFreeIDs += 1;
 	return true;
 }
 
 void SimObjectIDPool::RecycleIDs() {
-	// throw each ID recycled up until now back into the pool
-	freeIDs.insert(tempIDs.begin(), tempIDs.end());
+	// throw each ID recycled up until now back into the pool in one batch
+	for (const unsigned int uid: tempIDs) {
+		freeIDs.push_back(uid);
+		freeFlags[poolIDs[uid]] = 1;
+	}
+
+	numFreeIDs += tempIDs.size();
 	tempIDs.clear();
 }
 
@@ -132,8 +163,6 @@ bool SimObjectIDPool::HasID(unsigned int uid) const {
 
 	// check if given ID is available (to be assigned) in this pool
 	const auto it = poolIDs.find(uid);
-	const unsigned int idx = it->second;
 
-	return (freeIDs.find(idx) != freeIDs.end());
+	return (freeFlags[it->second] != 0);
 }
-
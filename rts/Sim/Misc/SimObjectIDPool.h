@@ -3,6 +3,8 @@
 #ifndef SIMOBJECT_IDPOOL_H
 #define SIMOBJECT_IDPOOL_H
 
+#include <vector>
+
 #include "System/creg/creg_cond.h"
 #include "System/UnorderedMap.hpp"
 
@@ -19,6 +21,7 @@ public:
 		poolIDs.reserve(maxObjects);
 		freeIDs.reserve(maxObjects);
 		tempIDs.reserve(maxObjects);
+		freeFlags.reserve(maxObjects);
 	}
 
 	void Expand(unsigned int baseID, unsigned int numIDs);
@@ -26,6 +29,9 @@ public:
 		freeIDs.clear();
 		poolIDs.clear();
 		tempIDs.clear();
+		freeFlags.clear();
+		freeIDsHead = 0;
+		numFreeIDs = 0;
 	}
 
 	void AssignID(CSolidObject* object);
@@ -33,9 +39,9 @@ public:
 
 	bool RecycleID(unsigned int uid);
 	bool HasID(unsigned int uid) const;
-	bool IsEmpty() const { return (freeIDs.empty()); }
+	bool IsEmpty() const { return (numFreeIDs == 0); }
 
-	unsigned int GetSize() const { return (freeIDs.size()); } // number of ID's still unused
+	unsigned int GetSize() const { return numFreeIDs; } // number of ID's still unused
 	unsigned int MaxSize() const { return (poolIDs.size()); } // number of ID's this pool owns
 
 private:
@@ -46,8 +52,18 @@ private:
 
 private:
 	spring::unordered_map<unsigned int, unsigned int> poolIDs; // uid to idx
-	spring::unordered_map<unsigned int, unsigned int> freeIDs; // idx to uid
-	spring::unordered_map<unsigned int, unsigned int> tempIDs; // idx to uid
+
+	// flat FIFO ring of assignable uid's, consumed from freeIDsHead; entries
+	// invalidated by ReserveID are filtered out lazily via freeFlags so both
+	// extraction and reservation run in (amortized) constant time
+	std::vector<unsigned int> freeIDs;
+	// uid's freed with delay, thrown back into the ring in one batch
+	std::vector<unsigned int> tempIDs;
+	// per-idx availability flags backing HasID
+	std::vector<uint8_t> freeFlags;
+
+	unsigned int freeIDsHead = 0;
+	unsigned int numFreeIDs = 0;
 };
 
 #endif
@@ -6,6 +6,7 @@
 
 #include "SmoothHeightMesh.h"
 
+#include "GlobalConstants.h"
 #include "Map/Ground.h"
 #include "Map/ReadMap.h"
 #include "System/float3.h"
@@ -49,6 +50,15 @@ void SmoothHeightMesh::Init(float mx, float my, float res, float smoothRad)
 	resolution = res;
 	smoothRadius = std::max(1.0f, smoothRad);
 
+	winSize = smoothRadius / resolution;
+
+	tilesX = (maxx / TILE_SIZE) + 1;
+	tilesY = (maxy / TILE_SIZE) + 1;
+	numDirtyTiles = 0;
+
+	dirtyTiles.clear();
+	dirtyTiles.resize(tilesX * tilesY, 0);
+
 	MakeSmoothMesh();
 }
 
@@ -56,6 +66,35 @@ void SmoothHeightMesh::Kill() {
 
 	mesh.clear();
 	origMesh.clear();
+
+	dirtyTiles.clear();
+	numDirtyTiles = 0;
+}
+
+
+
+void SmoothHeightMesh::MapChanged(int x1, int z1, int x2, int z2)
+{
+	if (mesh.empty())
+		return;
+
+	// every node whose maximum- or blur-window overlaps the deformed
+	// squares is stale, so expand the rectangle by both window radii
+	const int margin = winSize + numBlurPasses * blurSize;
+
+	const int nx1 = Clamp(int((x1 * SQUARE_SIZE) / resolution) - margin, 0, maxx);
+	const int ny1 = Clamp(int((z1 * SQUARE_SIZE) / resolution) - margin, 0, maxy);
+	const int nx2 = Clamp(int((x2 * SQUARE_SIZE) / resolution) + margin + 1, 0, maxx);
+	const int ny2 = Clamp(int((z2 * SQUARE_SIZE) / resolution) + margin + 1, 0, maxy);
+
+	for (int ty = ny1 / TILE_SIZE; ty <= ny2 / TILE_SIZE; ++ty) {
+		for (int tx = nx1 / TILE_SIZE; tx <= nx2 / TILE_SIZE; ++tx) {
+			unsigned char& tile = dirtyTiles[ty * tilesX + tx];
+
+			numDirtyTiles += (tile == 0);
+			tile = 1;
+		}
+	}
 }
 
 
@@ -63,16 +102,53 @@ void SmoothHeightMesh::Kill() {
 float SmoothHeightMesh::GetHeight(float x, float y)
 {
 	assert(!mesh.empty());
+
+	if (numDirtyTiles > 0)
+		EnsureTilesClean(x, y);
+
 	return Interpolate(x, y, maxx, maxy, resolution, &mesh[0]);
 }
 
 float SmoothHeightMesh::GetHeightAboveWater(float x, float y)
 {
 	assert(!mesh.empty());
+
+	if (numDirtyTiles > 0)
+		EnsureTilesClean(x, y);
+
 	return std::max(0.0f, Interpolate(x, y, maxx, maxy, resolution, &mesh[0]));
 }
 
 
+void SmoothHeightMesh::EnsureTilesClean(float x, float y)
+{
+	// mirror the index computations of Interpolate(); only the
+	// four nodes it actually reads need to be brought up to date
+	x = Clamp(x / resolution, 0.0f, maxx - 1.0f);
+	y = Clamp(y / resolution, 0.0f, maxy - 1.0f);
+
+	const int sx = x;
+	const int sy = y;
+	const int sxp1 = std::min(sx + 1, maxx - 1);
+	const int syp1 = std::min(sy + 1, maxy - 1);
+
+	const int idcs[] = {
+		sx   + sy   * maxx,
+		sxp1 + sy   * maxx,
+		sx   + syp1 * maxx,
+		sxp1 + syp1 * maxx,
+	};
+
+	for (const int idx: idcs) {
+		const int tx = (idx % (maxx + 1)) / TILE_SIZE;
+		const int ty = (idx / (maxx + 1)) / TILE_SIZE;
+
+		if (dirtyTiles[ty * tilesX + tx] != 0)
+			RecalcTile(tx, ty);
+	}
+}
+
+
 
 float SmoothHeightMesh::SetHeight(int index, float h)
 {
@@ -405,9 +481,6 @@ void SmoothHeightMesh::MakeSmoothMesh()
 	//   Nth row has indices [maxx*(N-1) + (N-1), maxx*(N) + (N-1)] inclusive
 	//
 	// use sliding window of maximums to reduce computational complexity
-	const     int winSize = smoothRadius / resolution;
-	constexpr int blurSize = 3;
-
 	assert(mesh.empty());
 	mesh.resize((maxx + 1) * (maxy + 1), 0.0f);
 	origMesh.resize((maxx + 1) * (maxy + 1), 0.0f);
@@ -430,7 +503,7 @@ void SmoothHeightMesh::MakeSmoothMesh()
 	}
 
 	// actually smooth with approximate Gaussian blur passes
-	for (int numBlurs = 3; numBlurs > 0; --numBlurs) {
+	for (int numBlurs = numBlurPasses; numBlurs > 0; --numBlurs) {
 		BlurHorizontal(maxx, maxy, blurSize, resolution, mesh, origMesh); mesh.swap(origMesh);
 		BlurVertical(maxx, maxy, blurSize, resolution, mesh, origMesh); mesh.swap(origMesh);
 	}
@@ -438,3 +511,130 @@ void SmoothHeightMesh::MakeSmoothMesh()
 	// <mesh> now contains the final smoothed heightmap, save it in origMesh
 	std::copy(mesh.begin(), mesh.end(), origMesh.begin());
 }
+
+
+
+void SmoothHeightMesh::RecalcTile(int tx, int ty)
+{
+	// number of nodes around the tile the blur passes leave exact when
+	// run over a region this much larger than the tile itself; beyond
+	// it region-border effects can not propagate inward (three passes
+	// per axis, each widening them by blurSize)
+	constexpr int blurMargin = numBlurPasses * blurSize;
+
+	const int lineSize = maxx + 1;
+
+	// node rectangle (inclusive) covered by the tile proper
+	const int x1 = tx * TILE_SIZE;
+	const int y1 = ty * TILE_SIZE;
+	const int x2 = std::min(x1 + TILE_SIZE - 1, maxx);
+	const int y2 = std::min(y1 + TILE_SIZE - 1, maxy);
+
+	// region the passes run over; only the tile is copied back
+	const int rx1 = std::max(x1 - blurMargin, 0);
+	const int ry1 = std::max(y1 - blurMargin, 0);
+	const int rx2 = std::min(x2 + blurMargin, maxx);
+	const int ry2 = std::min(y2 + blurMargin, maxy);
+
+	const int rw = rx2 - rx1 + 1;
+	const int rh = ry2 - ry1 + 1;
+
+	// the horizontal maximum pass additionally needs column
+	// maxima up to winSize beyond the region on either side
+	const int cx1 = std::max(rx1 - winSize, 0);
+	const int cx2 = std::min(rx2 + winSize, maxx);
+	const int cw = cx2 - cx1 + 1;
+
+	tileBufA.clear();
+	tileBufA.resize(cw * rh, -std::numeric_limits<float>::max());
+	tileBufB.clear();
+	tileBufB.resize(rw * rh, 0.0f);
+
+	// vertical sliding-window ground maxima (cf. FindMaximumColumnHeights)
+	for (int y = ry1; y <= ry2; ++y) {
+		const int wy1 = std::max(y - winSize, 0);
+		const int wy2 = std::min(y + winSize, maxy);
+
+		for (int x = cx1; x <= cx2; ++x) {
+			float colMax = -std::numeric_limits<float>::max();
+
+			for (int wy = wy1; wy <= wy2; ++wy) {
+				colMax = std::max(colMax, CGround::GetHeightAboveWater(x * resolution, wy * resolution));
+			}
+
+			tileBufA[(y - ry1) * cw + (x - cx1)] = colMax;
+		}
+	}
+
+	// horizontal maximum over the column maxima (cf. FindRadialMaximum)
+	for (int y = ry1; y <= ry2; ++y) {
+		for (int x = rx1; x <= rx2; ++x) {
+			const int wx1 = std::max(x - winSize, cx1);
+			const int wx2 = std::min(x + winSize, cx2);
+
+			float rowMax = -std::numeric_limits<float>::max();
+
+			for (int wx = wx1; wx <= wx2; ++wx) {
+				rowMax = std::max(rowMax, tileBufA[(y - ry1) * cw + (wx - cx1)]);
+			}
+
+			tileBufB[(y - ry1) * rw + (x - rx1)] = rowMax;
+		}
+	}
+
+	// clamp to the initial and not the current maximum height; tiles are
+	// refreshed whenever they happen to be sampled, and the current bound
+	// may differ between machines at that (unsynced) point in time
+	const float maxGroundHeight = readMap->GetInitMaxHeight();
+
+	const auto BlurPass = [&](const std::vector<float>& src, std::vector<float>& dst, bool horizontal) {
+		for (int y = 0; y < rh; ++y) {
+			for (int x = 0; x < rw; ++x) {
+				int w1 = 0;
+				int w2 = 0;
+				float sum = 0.0f;
+
+				if (horizontal) {
+					w1 = std::max(x - blurSize, 0);
+					w2 = std::min(x + blurSize, rw - 1);
+
+					for (int wx = w1; wx <= w2; ++wx) {
+						sum += src[y * rw + wx];
+					}
+				} else {
+					w1 = std::max(y - blurSize, 0);
+					w2 = std::min(y + blurSize, rh - 1);
+
+					for (int wy = w1; wy <= w2; ++wy) {
+						sum += src[wy * rw + x];
+					}
+				}
+
+				const float gh = CGround::GetHeightAboveWater((rx1 + x) * resolution, (ry1 + y) * resolution);
+				const float sh = sum / (w2 - w1 + 1);
+
+				dst[y * rw + x] = std::min(maxGroundHeight, std::max(gh, sh));
+			}
+		}
+	};
+
+	// region-sized from here on; fully rewritten by the first pass
+	tileBufA.resize(rw * rh);
+
+	// approximate Gaussian blur (cf. BlurHorizontal / BlurVertical)
+	for (int numBlurs = numBlurPasses; numBlurs > 0; --numBlurs) {
+		BlurPass(tileBufB, tileBufA,  true);
+		BlurPass(tileBufA, tileBufB, false);
+	}
+
+	for (int y = y1; y <= y2; ++y) {
+		for (int x = x1; x <= x2; ++x) {
+			mesh[y * lineSize + x] = tileBufB[(y - ry1) * rw + (x - rx1)];
+		}
+	}
+
+	dirtyTiles[ty * tilesX + tx] = 0;
+	numDirtyTiles -= 1;
+
+	assert(numDirtyTiles >= 0);
+}
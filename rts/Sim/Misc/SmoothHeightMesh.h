@@ -16,6 +16,11 @@ public:
 	void Init(float mx, float my, float res, float smoothRad);
 	void Kill();
 
+	/// terrain in the given (inclusive) heightmap-square rectangle was
+	/// deformed; marks all mesh tiles whose values depend on it dirty,
+	/// they get re-smoothed lazily when GetHeight* actually samples them
+	void MapChanged(int x1, int z1, int x2, int z2);
+
 	float GetHeight(float x, float y);
 	float GetHeightAboveWater(float x, float y);
 	float SetHeight(int index, float h);
@@ -34,6 +39,14 @@ public:
 private:
 	void MakeSmoothMesh();
 
+	void EnsureTilesClean(float x, float y);
+	void RecalcTile(int tx, int ty);
+
+	// mesh nodes per (square) dirty-tracking tile along each axis
+	static constexpr int TILE_SIZE = 32;
+	static constexpr int blurSize = 3;
+	static constexpr int numBlurPasses = 3;
+
 	int maxx = 0;
 	int maxy = 0;
 	float fmaxx = 0.0f;
@@ -41,11 +54,23 @@ private:
 	float resolution = 0.0f;
 	float smoothRadius = 0.0f;
 
+	int winSize = 0;
+
+	int tilesX = 0;
+	int tilesY = 0;
+	int numDirtyTiles = 0;
+
 	std::vector<float> mesh;
 	std::vector<float> origMesh;
 
 	std::vector<float> colsMaxima;
 	std::vector<int> maximaRows;
+
+	std::vector<unsigned char> dirtyTiles;
+
+	// scratch buffers for RecalcTile
+	std::vector<float> tileBufA;
+	std::vector<float> tileBufB;
 };
 
 extern SmoothHeightMesh smoothGround;
@@ -24,6 +24,7 @@
 #include "Sim/Units/CommandAI/MobileCAI.h"
 #include "Sim/Units/UnitDef.h"
 #include "Sim/Units/UnitHandler.h"
+#include "Sim/Units/UnitVectorStore.h"
 #include "Sim/Weapons/WeaponDefHandler.h"
 #include "Sim/Weapons/Weapon.h"
 #include "System/EventHandler.h"
@@ -165,6 +166,27 @@ static CGroundMoveType::MemberData gmtMemberData = {
 };
 
 
+// per-frame storage for batched obstacle-avoidance candidates; a flat
+// pool of avoidee pointers plus one {offset, count} span per unit id,
+// filled by GatherAvoidanceBatch so the QuadField queries all execute
+// back-to-back instead of being interleaved with steering math
+struct AvoidanceCandidates {
+	std::vector<CSolidObject*> pool;
+	std::vector<int2> spans;
+	std::vector<int> frames;
+
+	void Resize(unsigned int maxUnits) {
+		if (spans.size() >= maxUnits)
+			return;
+
+		spans.resize(maxUnits, int2(0, 0));
+		frames.resize(maxUnits, -1);
+	}
+};
+
+static AvoidanceCandidates avoidanceCandidates;
+
+
 
 
 namespace SAT {
@@ -1254,6 +1276,72 @@ void CGroundMoveType::CalcSkidRot()
 
 
 
+void CGroundMoveType::GatherAvoidanceBatch()
+{
+	#if (IGNORE_OBSTACLES == 1)
+	return;
+	#endif
+
+	avoidanceCandidates.pool.clear();
+	avoidanceCandidates.Resize(unitHandler.MaxUnits());
+
+	// batch the QuadField queries for every ground-mover that will run
+	// avoidance this frame; candidate positions are therefore sampled
+	// from the same start-of-phase snapshot for all units, independent
+	// of their update order
+	for (CUnit* unit: unitHandler.GetActiveUnits()) {
+		CGroundMoveType* moveType = dynamic_cast<CGroundMoveType*>(unit->moveType);
+
+		if (moveType == nullptr)
+			continue;
+
+		// mirror the cheap early-outs in GetObstacleAvoidanceDir
+		if (moveType->WantToStop())
+			continue;
+		if (gs->frameNum < moveType->nextObstacleAvoidanceFrame)
+			continue;
+
+		moveType->GatherAvoidees();
+	}
+}
+
+void CGroundMoveType::GatherAvoidees()
+{
+	avoidanceCandidates.Resize(unitHandler.MaxUnits());
+
+	CUnit* avoider = owner;
+	const MoveDef* avoiderMD = avoider->moveDef;
+
+	// note: should increase radius for smaller turnAccel values
+	const float avoidanceRadius = std::max(currentSpeed, 1.0f) * (avoider->radius * 2.0f);
+	const unsigned int poolOffset = avoidanceCandidates.pool.size();
+
+	QuadFieldQuery qfQuery;
+	quadField.GetSolidsExact(qfQuery, avoider->pos, avoidanceRadius, 0xFFFFFFFF, CSolidObject::CSTATE_BIT_SOLIDOBJECTS);
+
+	for (CSolidObject* avoidee: *qfQuery.solids) {
+		// cases in which there is no need to avoid this obstacle
+		if (avoidee == avoider)
+			continue;
+		// do not avoid statics (it interferes too much with PFS)
+		if (avoidee->moveDef == nullptr)
+			continue;
+		// ignore aircraft (or flying ground units)
+		if (avoidee->IsInAir() || avoidee->IsFlying())
+			continue;
+		if (CMoveMath::IsNonBlocking(*avoiderMD, avoidee, avoider))
+			continue;
+		if (!CMoveMath::CrushResistant(*avoiderMD, avoidee))
+			continue;
+
+		avoidanceCandidates.pool.push_back(avoidee);
+	}
+
+	avoidanceCandidates.spans[avoider->id] = int2(poolOffset, avoidanceCandidates.pool.size() - poolOffset);
+	avoidanceCandidates.frames[avoider->id] = gs->frameNum;
+}
+
+
 /*
  * Dynamic obstacle avoidance, helps the unit to
  * follow the path even when it's not perfect.
@@ -1296,35 +1384,35 @@ float3 CGroundMoveType::GetObstacleAvoidanceDir(const float3& desiredDir) {
 
 	// now we do the obstacle avoidance proper
 	// avoider always uses its never-rotated MoveDef footprint
-	// note: should increase radius for smaller turnAccel values
-	const float avoidanceRadius = std::max(currentSpeed, 1.0f) * (avoider->radius * 2.0f);
 	const float avoiderRadius = avoiderMD->CalcFootPrintMinExteriorRadius();
 
-	QuadFieldQuery qfQuery;
-	quadField.GetSolidsExact(qfQuery, avoider->pos, avoidanceRadius, 0xFFFFFFFF, CSolidObject::CSTATE_BIT_SOLIDOBJECTS);
+	// consume the candidate list gathered for us at the start of the
+	// move-type phase; units whose early-out gates flipped during an
+	// earlier update this frame gather their own list on demand
+	avoidanceCandidates.Resize(unitHandler.MaxUnits());
+
+	if (avoidanceCandidates.frames[avoider->id] != gs->frameNum)
+		GatherAvoidees();
 
-	for (const CSolidObject* avoidee: *qfQuery.solids) {
+	const int2 avoideeSpan = avoidanceCandidates.spans[avoider->id];
+
+	// statics, aircraft, non-blocking and crushable objects have
+	// already been filtered out of the pool by GatherAvoidees
+	for (int n = 0; n < avoideeSpan.y; n++) {
+		const CSolidObject* avoidee = avoidanceCandidates.pool[avoideeSpan.x + n];
 		const MoveDef* avoideeMD = avoidee->moveDef;
 		const UnitDef* avoideeUD = dynamic_cast<const UnitDef*>(avoidee->GetDef());
 
-		// cases in which there is no need to avoid this obstacle
-		if (avoidee == owner)
-			continue;
-		// do not avoid statics (it interferes too much with PFS)
-		if (avoideeMD == nullptr)
-			continue;
-		// ignore aircraft (or flying ground units)
-		if (avoidee->IsInAir() || avoidee->IsFlying())
-			continue;
-		if (CMoveMath::IsNonBlocking(*avoiderMD, avoidee, avoider))
-			continue;
-		if (!CMoveMath::CrushResistant(*avoiderMD, avoidee))
-			continue;
-
 		const bool avoideeMobile  = (avoideeMD != nullptr);
 		const bool avoideeMovable = (avoideeUD != nullptr && !static_cast<const CUnit*>(avoidee)->moveType->IsPushResistant());
 
-		const float3 avoideeVector = (avoider->pos + avoider->speed) - (avoidee->pos + avoidee->speed);
+		// every pooled avoidee has a MoveDef and hence is a unit, so
+		// stream its movement state from the SoA store; two contiguous
+		// arrays instead of a couple of CUnit cachelines per candidate
+		const float3& avoideePos = unitVectorStore.UnitPos(avoidee->id);
+		const float3& avoideeSpeed = unitVectorStore.UnitSpeed(avoidee->id);
+
+		const float3 avoideeVector = (avoider->pos + avoider->speed) - (avoideePos + avoideeSpeed);
 
 		// use the avoidee's MoveDef footprint as radius if it is mobile
 		// use the avoidee's Unit (not UnitDef) footprint as radius otherwise
@@ -1362,12 +1450,12 @@ float3 CGroundMoveType::GetObstacleAvoidanceDir(const float3& desiredDir) {
 		// (or not yet fully apart), then the object is on the path of the unit
 		// and they are not collided
 		if (DEBUG_DRAWING_ENABLED) {
-			if (selectedUnitsHandler.selectedUnits.find(owner->id) != selectedUnitsHandler.selectedUnits.end())
-				geometricObjects->AddLine(avoider->pos + (UpVector * 20.0f), avoidee->pos + (UpVector * 20.0f), 3, 1, 4);
+			if (selectedUnitsHandler.IsUnitSelected(owner))
+				geometricObjects->AddLine(avoider->pos + (UpVector * 20.0f), avoideePos + (UpVector * 20.0f), 3, 1, 4);
 		}
 
-		float avoiderTurnSign = -Sign(avoidee->pos.dot(avoider->rightdir) - avoider->pos.dot(avoider->rightdir));
-		float avoideeTurnSign = -Sign(avoider->pos.dot(avoidee->rightdir) - avoidee->pos.dot(avoidee->rightdir));
+		float avoiderTurnSign = -Sign(avoideePos.dot(avoider->rightdir) - avoider->pos.dot(avoider->rightdir));
+		float avoideeTurnSign = -Sign(avoider->pos.dot(avoidee->rightdir) - avoideePos.dot(avoidee->rightdir));
 
 		// for mobile units, avoidance-response is modulated by angle
 		// between avoidee's and avoider's frontdir such that maximal
@@ -1398,7 +1486,7 @@ float3 CGroundMoveType::GetObstacleAvoidanceDir(const float3& desiredDir) {
 	avoidanceDir = (mix(avoidanceDir, lastAvoidanceDir, LAST_DIR_MIX_ALPHA)).SafeNormalize();
 
 	if (DEBUG_DRAWING_ENABLED) {
-		if (selectedUnitsHandler.selectedUnits.find(owner->id) != selectedUnitsHandler.selectedUnits.end()) {
+		if (selectedUnitsHandler.IsUnitSelected(owner)) {
 			const float3 p0 = owner->pos + (    UpVector * 20.0f);
 			const float3 p1 =         p0 + (avoidanceVec * 40.0f);
 			const float3 p2 =         p0 + (avoidanceDir * 40.0f);
@@ -1523,7 +1611,7 @@ bool CGroundMoveType::CanSetNextWayPoint() {
 		}
 
 		if (DEBUG_DRAWING_ENABLED) {
-			if (selectedUnitsHandler.selectedUnits.find(owner->id) != selectedUnitsHandler.selectedUnits.end()) {
+			if (selectedUnitsHandler.IsUnitSelected(owner)) {
 				// plot the vectors to {curr, next}WayPoint
 				const int cwpFigGroupID = geometricObjects->AddLine(pos + (UpVector * 20.0f), cwp + (UpVector * (pos.y + 20.0f)), 8.0f, 1, 4);
 				const int nwpFigGroupID = geometricObjects->AddLine(pos + (UpVector * 20.0f), nwp + (UpVector * (pos.y + 20.0f)), 8.0f, 1, 4);
@@ -32,6 +32,11 @@ public:
 	bool Update() override;
 	void SlowUpdate() override;
 
+	// runs one spatial-query pass over all ground-movers that will
+	// evaluate obstacle avoidance this frame; called by CUnitHandler
+	// before the per-unit move-type updates
+	static void GatherAvoidanceBatch();
+
 	void StartMovingRaw(const float3 moveGoalPos, float moveGoalRadius) override;
 	void StartMoving(float3 pos, float moveGoalRadius) override;
 	void StartMoving(float3 pos, float moveGoalRadius, float speed) override { StartMoving(pos, moveGoalRadius); }
@@ -93,6 +98,7 @@ public:
 	float GetGroundHeight(const float3&) const;
 
 private:
+	void GatherAvoidees();
 	float3 GetObstacleAvoidanceDir(const float3& desiredDir);
 	float3 Here() const;
 
@@ -138,6 +138,9 @@ void MoveDefHandler::Init(LuaParser* defsParser)
 	crc << CMoveMath::noHoverWaterMove;
 
 	mdChecksum = crc.GetDigest();
+
+	// all MoveDefs (and the statics above) are now in place
+	CMoveMath::InitSpeedModCaches();
 }
 
 
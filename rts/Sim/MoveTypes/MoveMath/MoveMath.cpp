@@ -11,10 +11,13 @@
 #include "Sim/Objects/SolidObject.h"
 #include "Sim/Units/Unit.h"
 #include "System/Platform/Threading.h"
+#include "System/Threading/ThreadPool.h"
 
 bool CMoveMath::noHoverWaterMove = false;
 float CMoveMath::waterDamageCost = 0.0f;
 
+std::vector< std::vector<float> > CMoveMath::speedModCaches;
+
 static constexpr int FOOTPRINT_XSTEP = 2;
 static constexpr int FOOTPRINT_ZSTEP = 2;
 
@@ -46,16 +49,12 @@ float CMoveMath::yLevel(const MoveDef& moveDef, const float3& pos)
 
 
 /* calculate the local speed-modifier for this MoveDef */
-float CMoveMath::GetPosSpeedMod(const MoveDef& moveDef, unsigned xSquare, unsigned zSquare)
+float CMoveMath::CalcPosSpeedMod(const MoveDef& moveDef, unsigned hmSquare)
 {
-	if (xSquare >= mapDims.mapx || zSquare >= mapDims.mapy)
-		return 0.0f;
-
-	const int square = (xSquare >> 1) + ((zSquare >> 1) * mapDims.hmapx);
-	const int squareTerrType = readMap->GetTypeMapSynced()[square];
+	const int squareTerrType = readMap->GetTypeMapSynced()[hmSquare];
 
-	const float height  = readMap->GetMIPHeightMapSynced(1)[square];
-	const float slope   = readMap->GetSlopeMapSynced()[square];
+	const float height  = readMap->GetMIPHeightMapSynced(1)[hmSquare];
+	const float slope   = readMap->GetSlopeMapSynced()[hmSquare];
 
 	const CMapInfo::TerrainType& tt = mapInfo->terrainTypes[squareTerrType];
 
@@ -70,6 +69,73 @@ float CMoveMath::GetPosSpeedMod(const MoveDef& moveDef, unsigned xSquare, unsign
 	return 0.0f;
 }
 
+float CMoveMath::GetPosSpeedMod(const MoveDef& moveDef, unsigned xSquare, unsigned zSquare)
+{
+	if (xSquare >= mapDims.mapx || zSquare >= mapDims.mapy)
+		return 0.0f;
+
+	const int square = (xSquare >> 1) + ((zSquare >> 1) * mapDims.hmapx);
+
+	// a single array read once the per-MoveDef caches have been built
+	if (moveDef.pathType < speedModCaches.size())
+		return speedModCaches[moveDef.pathType][square];
+
+	return (CalcPosSpeedMod(moveDef, square));
+}
+
+
+void CMoveMath::InitSpeedModCaches()
+{
+	const unsigned int numMoveDefs = moveDefHandler.GetNumMoveDefs();
+	const unsigned int numSquares = mapDims.hmapx * mapDims.hmapy;
+
+	speedModCaches.clear();
+	speedModCaches.resize(numMoveDefs);
+
+	// grids depend only on synced map state, which TerrainChange tracks;
+	// each task writes only its own MoveDef's grid so results do not vary
+	// with scheduling
+	for_mt(0, numMoveDefs, [numSquares](const int pathType) {
+		const MoveDef& moveDef = *moveDefHandler.GetMoveDefByPathType(pathType);
+
+		std::vector<float>& cache = speedModCaches[pathType];
+		cache.resize(numSquares);
+
+		for (unsigned int hmSquare = 0; hmSquare < numSquares; hmSquare++) {
+			cache[hmSquare] = CalcPosSpeedMod(moveDef, hmSquare);
+		}
+	});
+}
+
+void CMoveMath::KillSpeedModCaches()
+{
+	speedModCaches.clear();
+}
+
+void CMoveMath::TerrainChange(unsigned int x1, unsigned int z1, unsigned int x2, unsigned int z2)
+{
+	if (speedModCaches.empty())
+		return;
+
+	// rect is given in map-squares, the caches live at half resolution
+	const unsigned int hx1 = std::min(x1 >> 1, unsigned(mapDims.hmapx) - 1);
+	const unsigned int hz1 = std::min(z1 >> 1, unsigned(mapDims.hmapy) - 1);
+	const unsigned int hx2 = std::min(x2 >> 1, unsigned(mapDims.hmapx) - 1);
+	const unsigned int hz2 = std::min(z2 >> 1, unsigned(mapDims.hmapy) - 1);
+
+	for (unsigned int pathType = 0; pathType < speedModCaches.size(); pathType++) {
+		const MoveDef& moveDef = *moveDefHandler.GetMoveDefByPathType(pathType);
+
+		std::vector<float>& cache = speedModCaches[pathType];
+
+		for (unsigned int hmz = hz1; hmz <= hz2; hmz++) {
+			for (unsigned int hmx = hx1; hmx <= hx2; hmx++) {
+				cache[hmz * mapDims.hmapx + hmx] = CalcPosSpeedMod(moveDef, hmz * mapDims.hmapx + hmx);
+			}
+		}
+	}
+}
+
 float CMoveMath::GetPosSpeedMod(const MoveDef& moveDef, unsigned xSquare, unsigned zSquare, float3 moveDir)
 {
 	if (xSquare >= mapDims.mapx || zSquare >= mapDims.mapy)
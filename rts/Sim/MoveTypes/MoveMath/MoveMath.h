@@ -3,6 +3,8 @@
 #ifndef MOVEMATH_H
 #define MOVEMATH_H
 
+#include <vector>
+
 #include "Map/ReadMap.h"
 #include "System/float3.h"
 #include "System/Misc/BitwiseEnum.h"
@@ -20,6 +22,9 @@ protected:
 	static float ShipSpeedMod(const MoveDef& moveDef, float height, float slope);
 	static float ShipSpeedMod(const MoveDef& moveDef, float height, float slope, float dirSlopeMod);
 
+	// {@param hmSquare} is an index into the heightmap-resolution grids
+	static float CalcPosSpeedMod(const MoveDef& moveDef, unsigned hmSquare);
+
 public:
 	// gives the y-coordinate the unit will "stand on"
 	static float yLevel(const MoveDef& moveDef, const float3& pos);
@@ -49,6 +54,15 @@ public:
 		return (GetPosSpeedMod(moveDef, pos.x / SQUARE_SIZE, pos.z / SQUARE_SIZE, moveDir));
 	}
 
+	// per-MoveDef speed-mod grids at heightmap resolution; built once
+	// after MoveDefHandler load so the directionless GetPosSpeedMod is
+	// a single array read, and patched in-place whenever map damage or
+	// Lua changes the terrain data it was derived from
+	static void InitSpeedModCaches();
+	static void KillSpeedModCaches();
+	// rect is given in map-square coords, as for IPathManager
+	static void TerrainChange(unsigned int x1, unsigned int z1, unsigned int x2, unsigned int z2);
+
 	// tells whether a position is blocked (inaccessable for a given object's MoveDef)
 	static inline BlockType IsBlocked(const MoveDef& moveDef, const float3& pos, const CSolidObject* collider);
 	static inline BlockType IsBlocked(const MoveDef& moveDef, int xSquare, int zSquare, const CSolidObject* collider);
@@ -76,6 +90,10 @@ public:
 public:
 	static bool noHoverWaterMove;
 	static float waterDamageCost;
+
+private:
+	// speedModCaches[pathType][hmSquare]
+	static std::vector< std::vector<float> > speedModCaches;
 };
 
 
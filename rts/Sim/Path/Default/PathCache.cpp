@@ -18,6 +18,7 @@ CPathCache::CPathCache(int blocksX, int blocksZ)
 
 	, maxCacheSize(0)
 	, numCacheHits(0)
+	, numSharedHits(0)
 	, numCacheMisses(0)
 	, numHashCollisions(0)
 {
@@ -31,12 +32,12 @@ CPathCache::~CPathCache()
 {
 	const char* fmt =
 #ifdef _WIN32
-		"[%s(%ux%u)] cacheHits=%u hitPercentage=%.0f%% numHashColls=%u maxCacheSize=%I64u";
+		"[%s(%ux%u)] cacheHits=%u (shared=%u) hitPercentage=%.0f%% numHashColls=%u maxCacheSize=%I64u";
 #else
-		"[%s(%ux%u)] cacheHits=%u hitPercentage=%.0f%% numHashColls=%u maxCacheSize=%lu";
+		"[%s(%ux%u)] cacheHits=%u (shared=%u) hitPercentage=%.0f%% numHashColls=%u maxCacheSize=%lu";
 #endif
 
-	LOG(fmt, __FUNCTION__, numBlocksX, numBlocksZ, numCacheHits, GetCacheHitPercentage(), numHashCollisions, maxCacheSize);
+	LOG(fmt, __FUNCTION__, numBlocksX, numBlocksZ, numCacheHits, numSharedHits, GetCacheHitPercentage(), numHashCollisions, maxCacheSize);
 }
 
 bool CPathCache::AddPath(
@@ -60,6 +61,23 @@ bool CPathCache::AddPath(
 
 	cachedPaths[hash] = CacheItem{result, *path, strtBlock, goalBlock, goalRadius, pathType};
 
+	// also register as the shared representative of its block pair so
+	// requests differing only in goal radius can join it; prefer the
+	// tightest radius since those paths satisfy all looser requests
+	if (result == IPath::Ok) {
+		const std::uint64_t sharedHash = GetHash(strtBlock, goalBlock, 0, pathType);
+		const auto sharedIter = sharedPaths.find(sharedHash);
+
+		if (sharedIter == sharedPaths.end()) {
+			sharedPaths[sharedHash] = hash;
+		} else {
+			const auto repIter = cachedPaths.find(sharedIter->second);
+
+			if (repIter == cachedPaths.end() || goalRadius < (repIter->second).goalRadius)
+				sharedIter->second = hash;
+		}
+	}
+
 	const int lifeTime = (result == IPath::Ok) ? GAME_SPEED * MAX_PATH_LIFETIME_SECS : GAME_SPEED * (MAX_PATH_LIFETIME_SECS / 2);
 
 	cacheQue.push_back({gs->frameNum + lifeTime, hash});
@@ -77,6 +95,25 @@ const CPathCache::CacheItem& CPathCache::GetCachedPath(
 	const auto iter = cachedPaths.find(hash);
 
 	if (iter == cachedPaths.end()) {
+		// exact miss; a path cached between the same block pair for a
+		// tighter goal radius is still a valid (if slightly overlong)
+		// answer, so let this request join it
+		const auto sharedIter = sharedPaths.find(GetHash(strtBlock, goalBlock, 0, pathType));
+
+		if (sharedIter != sharedPaths.end()) {
+			const auto repIter = cachedPaths.find(sharedIter->second);
+
+			if (repIter != cachedPaths.end()) {
+				const CacheItem& ci = repIter->second;
+
+				if (ci.strtBlock == strtBlock && ci.goalBlock == goalBlock && ci.pathType == pathType && ci.result == IPath::Ok && ci.goalRadius <= goalRadius) {
+					++numCacheHits;
+					++numSharedHits;
+					return ci;
+				}
+			}
+		}
+
 		++numCacheMisses; return dummyCacheItem;
 	}
 	if ((iter->second).strtBlock != strtBlock) {
@@ -104,6 +141,16 @@ void CPathCache::RemoveFrontQueItem()
 	const auto it = cachedPaths.find((cacheQue.front()).hash);
 
 	assert(it != cachedPaths.end());
+
+	// drop the shared representative if it references this entry
+	// (another radius-variant may still exist, it just can not be
+	// joined until re-registered by a new search)
+	const CacheItem& ci = it->second;
+	const auto sharedIter = sharedPaths.find(GetHash(ci.strtBlock, ci.goalBlock, 0, ci.pathType));
+
+	if (sharedIter != sharedPaths.end() && sharedIter->second == (cacheQue.front()).hash)
+		sharedPaths.erase(sharedIter);
+
 	cachedPaths.erase(it);
 	cacheQue.pop_front();
 }
@@ -78,12 +78,18 @@ private:
 	std::deque<CacheQueItem> cacheQue;
 	spring::unordered_map<std::uint64_t, CacheItem> cachedPaths; // ints are sync-safe keys
 
+	// per {strtBlock, goalBlock, pathType} representative (radius-less
+	// key, mapping to the tightest-radius entry in cachedPaths) shared
+	// by requests whose own goal radius is at least as large
+	spring::unordered_map<std::uint64_t, std::uint64_t> sharedPaths;
+
 	std::uint32_t numBlocksX;
 	std::uint32_t numBlocksZ;
 	std::uint64_t numBlocks;
 
 	std::uint64_t maxCacheSize;
 	std::uint32_t numCacheHits;
+	std::uint32_t numSharedHits;
 	std::uint32_t numCacheMisses;
 	std::uint32_t numHashCollisions;
 };
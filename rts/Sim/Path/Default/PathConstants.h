@@ -39,6 +39,12 @@ static constexpr unsigned int PATH_HEATMAP_ZSCALE =  1; // wrt. mapDims.hmapy
 static constexpr unsigned int PATH_FLOWMAP_XSCALE = 32; // wrt. mapDims.mapx
 static constexpr unsigned int PATH_FLOWMAP_ZSCALE = 32; // wrt. mapDims.mapy
 
+// med-res flow-fields shared by requests with a common goal-block
+static constexpr unsigned int MAX_PATH_FLOWFIELDS            = 8;
+static constexpr unsigned int PATH_FLOWFIELD_MIN_REQUESTS    = 4;               // per window, before a field is integrated
+static constexpr unsigned int PATH_FLOWFIELD_REQUEST_WINDOW  = GAME_SPEED;      // frames
+static constexpr unsigned int PATH_FLOWFIELD_MAX_AGE         = GAME_SPEED * 5;  // frames
+
 
 // PE-only flags (indices)
 static constexpr unsigned int PATHDIR_LEFT       = 0; // +x (LEFT *TO* RIGHT)
@@ -4,6 +4,8 @@
 
 #include "minizip/zip.h"
 
+#include <fstream>
+
 #include "PathEstimator.h"
 #include "PathFinder.h"
 #include "PathFinderDef.h"
@@ -47,6 +49,27 @@ static const std::string GetCacheFileName(const std::string& fileHashCode, const
 	return (GetPathCacheDir() + mapFileName + "." + peFileName + "-" + fileHashCode + ".zip");
 }
 
+static const std::string GetRawCacheFileName(const std::string& fileHashCode, const std::string& peFileName, const std::string& mapFileName) {
+	return (GetPathCacheDir() + mapFileName + "." + peFileName + "-" + fileHashCode + ".pathdata");
+}
+
+
+// uncompressed cache format; the data section starts page-aligned so
+// loaders are free to map the file instead of streaming it
+struct RawCacheHeader {
+	static constexpr unsigned int CURR_MAGIC = 0x30455073; // "sPE0"
+	static constexpr unsigned int CURR_VERSION = 1;
+	static constexpr unsigned int DATA_OFFSET = 4096;
+
+	unsigned int magic;
+	unsigned int version;
+	unsigned int hashCode;
+	unsigned int numPathTypes;
+	unsigned int numNodeOffsets; // per path-type
+	unsigned int numVertexCosts;
+	unsigned int dataOffset;
+};
+
 
 static size_t GetNumThreads() {
 	const size_t numThreads = std::max(0, configHandler->GetInt("PathingThreadCount"));
@@ -932,7 +955,115 @@ void CPathEstimator::FinishSearch(const MoveDef& moveDef, const CPathFinderDef&
 
 bool CPathEstimator::RemoveCacheFile(const std::string& peFileName, const std::string& mapFileName)
 {
-	return (FileSystem::Remove(GetCacheFileName(IntToString(fileHashCode, "%x"), peFileName, mapFileName)));
+	const std::string hashHexString = IntToString(fileHashCode, "%x");
+
+	const bool removedZip = FileSystem::Remove(GetCacheFileName(hashHexString, peFileName, mapFileName));
+	const bool removedRaw = FileSystem::Remove(GetRawCacheFileName(hashHexString, peFileName, mapFileName));
+
+	return (removedZip || removedRaw);
+}
+
+
+/**
+ * Try to read offset and vertex data from the uncompressed cache
+ * format; the tables are filled straight from the file without any
+ * decompression or staging buffer
+ */
+bool CPathEstimator::ReadRawFile(const std::string& cacheFileName)
+{
+	if (!FileSystem::FileExists(cacheFileName))
+		return false;
+
+	std::ifstream file(dataDirsAccess.LocateFile(cacheFileName).c_str(), std::ios::in | std::ios::binary);
+
+	if (!file.is_open()) {
+		FileSystem::Remove(cacheFileName);
+		return false;
+	}
+
+	RawCacheHeader header;
+	file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+	const unsigned int numPathTypes = moveDefHandler.GetNumMoveDefs();
+	const unsigned int numNodeOffsets = blockStates.GetSize();
+
+	const bool goodHeader = file.good()
+		&& (header.magic == RawCacheHeader::CURR_MAGIC)
+		&& (header.version == RawCacheHeader::CURR_VERSION)
+		&& (header.hashCode == fileHashCode)
+		&& (header.numPathTypes == numPathTypes)
+		&& (header.numNodeOffsets == numNodeOffsets)
+		&& (header.numVertexCosts == vertexCosts.size())
+		&& (header.dataOffset >= sizeof(RawCacheHeader));
+
+	if (!goodHeader) {
+		file.close();
+		FileSystem::Remove(cacheFileName);
+		return false;
+	}
+
+	file.seekg(header.dataOffset, std::ios::beg);
+
+	// read center-offset data
+	for (unsigned int pathType = 0; pathType < numPathTypes; ++pathType) {
+		file.read(reinterpret_cast<char*>(&blockStates.peNodeOffsets[pathType][0]), numNodeOffsets * sizeof(short2));
+	}
+
+	// read vertex-cost data
+	file.read(reinterpret_cast<char*>(&vertexCosts[0]), vertexCosts.size() * sizeof(float));
+
+	if (!file.good()) {
+		// caller regenerates or reads the legacy format, so partially
+		// overwritten tables do not matter here
+		file.close();
+		FileSystem::Remove(cacheFileName);
+		return false;
+	}
+
+	return true;
+}
+
+
+/**
+ * Try to write offset and vertex data in the uncompressed cache format.
+ */
+bool CPathEstimator::WriteRawFile(const std::string& cacheFileName)
+{
+	std::ofstream file(dataDirsAccess.LocateFile(cacheFileName, FileQueryFlags::WRITE).c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+
+	if (!file.is_open())
+		return false;
+
+	RawCacheHeader header;
+	header.magic = RawCacheHeader::CURR_MAGIC;
+	header.version = RawCacheHeader::CURR_VERSION;
+	header.hashCode = fileHashCode;
+	header.numPathTypes = moveDefHandler.GetNumMoveDefs();
+	header.numNodeOffsets = blockStates.GetSize();
+	header.numVertexCosts = vertexCosts.size();
+	header.dataOffset = RawCacheHeader::DATA_OFFSET;
+
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	// zero-fill up to the page-aligned data section
+	const std::vector<char> padding(RawCacheHeader::DATA_OFFSET - sizeof(header), 0);
+	file.write(padding.data(), padding.size());
+
+	// write center-offsets
+	for (unsigned int pathType = 0; pathType < header.numPathTypes; ++pathType) {
+		file.write(reinterpret_cast<const char*>(&blockStates.peNodeOffsets[pathType][0]), header.numNodeOffsets * sizeof(short2));
+	}
+
+	// write vertex-costs
+	file.write(reinterpret_cast<const char*>(vertexCosts.data()), vertexCosts.size() * sizeof(float));
+
+	if (!file.good()) {
+		file.close();
+		FileSystem::Remove(cacheFileName);
+		return false;
+	}
+
+	return true;
 }
 
 /**
@@ -943,6 +1074,11 @@ bool CPathEstimator::ReadFile(const std::string& peFileName, const std::string&
 	const std::string hashHexString = IntToString(fileHashCode, "%x");
 	const std::string cacheFileName = GetCacheFileName(hashHexString, peFileName, mapFileName);
 
+	// prefer the uncompressed format, decompressing and re-parsing the
+	// legacy archive dominates map-switch times on rotating autohosts
+	if (ReadRawFile(GetRawCacheFileName(hashHexString, peFileName, mapFileName)))
+		return true;
+
 	LOG("[PathEstimator::%s] hash=%s file=\"%s\" (exists=%d)", __func__, hashHexString.c_str(), cacheFileName.c_str(), FileSystem::FileExists(cacheFileName));
 
 	if (!FileSystem::FileExists(cacheFileName))
@@ -999,6 +1135,9 @@ bool CPathEstimator::ReadFile(const std::string& peFileName, const std::string&
 	}
 
 	std::memcpy(&vertexCosts[0], &buffer[pos], vertexCosts.size() * sizeof(float));
+
+	// upgrade legacy caches so the next load takes the fast path
+	WriteRawFile(GetRawCacheFileName(hashHexString, peFileName, mapFileName));
 	return true;
 }
 
@@ -1049,7 +1188,11 @@ bool CPathEstimator::WriteFile(const std::string& peFileName, const std::string&
 	}
 
 	assert(upfile->FindFile("pathinfo") < upfile->NumFiles());
-  return true;
+
+	// also write the uncompressed format read back by future loads; the
+	// archive stays around for engine versions sharing the cache dir
+	WriteRawFile(GetRawCacheFileName(hashHexString, peFileName, mapFileName));
+	return true;
 }
 
 
@@ -121,6 +121,9 @@ private:
 	bool ReadFile(const std::string& peFileName, const std::string& mapFileName);
 	bool WriteFile(const std::string& peFileName, const std::string& mapFileName);
 
+	bool ReadRawFile(const std::string& cacheFileName);
+	bool WriteRawFile(const std::string& cacheFileName);
+
 	std::uint32_t CalcChecksum() const;
 	std::uint32_t CalcHash(const char* caller) const;
 
@@ -0,0 +1,228 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include <algorithm>
+#include <queue>
+
+#include "PathFlowField.h"
+#include "PathConstants.h"
+#include "PathEstimator.h"
+#include "Sim/Misc/GlobalSynced.h"
+#include "Sim/MoveTypes/MoveDefHandler.h"
+#include "Sim/MoveTypes/MoveMath/MoveMath.h"
+
+
+void CPathFlowField::Init(const CPathEstimator* pe)
+{
+	blockGraph = pe;
+
+	fields.reserve(MAX_PATH_FLOWFIELDS);
+	requestCounts.reserve(32);
+}
+
+
+void CPathFlowField::Update()
+{
+	const int currFrame = gs->frameNum;
+
+	for (auto it = requestCounts.begin(); it != requestCounts.end(); ) {
+		if ((currFrame - it->second.y) > PATH_FLOWFIELD_REQUEST_WINDOW) {
+			it = requestCounts.erase(it);
+		} else {
+			++it;
+		}
+	}
+
+	for (auto it = fields.begin(); it != fields.end(); ) {
+		if ((currFrame - it->second.buildFrame) > PATH_FLOWFIELD_MAX_AGE) {
+			it = fields.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+
+unsigned int CPathFlowField::GetBlockIdx(const float3& pos) const
+{
+	const int blockSize = blockGraph->GetBlockSize();
+	const int2 blockPos = {int(pos.x / SQUARE_SIZE) / blockSize, int(pos.z / SQUARE_SIZE) / blockSize};
+
+	return (blockGraph->BlockPosToIdx(blockPos));
+}
+
+
+const CPathFlowField::FlowField* CPathFlowField::GetField(const float3& goalPos, unsigned int pathType)
+{
+	assert(blockGraph != nullptr);
+
+	const unsigned int goalBlockIdx = GetBlockIdx(goalPos);
+	const std::uint64_t fieldKey = GetFieldKey(goalBlockIdx, pathType);
+
+	const int currFrame = gs->frameNum;
+
+	const auto fieldsIt = fields.find(fieldKey);
+
+	if (fieldsIt != fields.end()) {
+		FlowField& field = fieldsIt->second;
+		field.touchFrame = currFrame;
+		return &field;
+	}
+
+	// no field yet; count the request and integrate one only when the
+	// goal is shared by enough of them (isolated orders resolve faster
+	// through a regular estimator search)
+	int2& reqCount = requestCounts[fieldKey];
+
+	if (reqCount.x == 0 || (currFrame - reqCount.y) > PATH_FLOWFIELD_REQUEST_WINDOW)
+		reqCount = {0, currFrame};
+
+	if ((reqCount.x += 1) < PATH_FLOWFIELD_MIN_REQUESTS)
+		return nullptr;
+
+	// make room before integrating; evict the least-recently read field
+	// (key is only a tie-breaker to keep the choice order-independent)
+	while (fields.size() >= MAX_PATH_FLOWFIELDS) {
+		auto lruIt = fields.begin();
+
+		for (auto it = fields.begin(); it != fields.end(); ++it) {
+			if (it->second.touchFrame > lruIt->second.touchFrame)
+				continue;
+			if (it->second.touchFrame == lruIt->second.touchFrame && it->first >= lruIt->first)
+				continue;
+
+			lruIt = it;
+		}
+
+		fields.erase(lruIt);
+	}
+
+	FlowField field;
+	field.goalBlockIdx = goalBlockIdx;
+	field.pathType = pathType;
+	field.buildFrame = currFrame;
+	field.touchFrame = currFrame;
+
+	// can fail if the goal-block itself is walled in; do not occupy a
+	// slot in that case, the per-unit searches will get as close as is
+	// possible on their own
+	if (!IntegrateField(field))
+		return nullptr;
+
+	return &(fields[fieldKey] = std::move(field));
+}
+
+
+bool CPathFlowField::IntegrateField(FlowField& field) const
+{
+	const int2 nbrOfBlocks = blockGraph->GetNumBlocks();
+	const unsigned int numBlocks = nbrOfBlocks.x * nbrOfBlocks.y;
+
+	const std::vector<float>& vertexCosts = blockGraph->GetVertexCosts();
+	const unsigned int vertexBaseIdx = field.pathType * numBlocks * PATH_DIRECTION_VERTICES;
+
+	field.blockDirs.clear();
+	field.blockDirs.resize(numBlocks, PATH_DIRECTIONS);
+	field.blockCosts.clear();
+	field.blockCosts.resize(numBlocks, PATHCOST_INFINITY);
+
+	// plain Dijkstra outward from the goal-block; transition costs are
+	// bi-directional (cf. GetBlockVertexOffset) so the same vertex-cost
+	// table serves the reversed expansion
+	typedef std::pair<float, unsigned int> QueuedBlock;
+
+	std::priority_queue<QueuedBlock, std::vector<QueuedBlock>, std::greater<QueuedBlock> > openBlocks;
+
+	unsigned int numReachedBlocks = 0;
+
+	field.blockCosts[field.goalBlockIdx] = 0.0f;
+	openBlocks.push({0.0f, field.goalBlockIdx});
+
+	while (!openBlocks.empty()) {
+		const QueuedBlock openBlock = openBlocks.top();
+
+		openBlocks.pop();
+
+		const unsigned int blockIdx = openBlock.second;
+
+		// skip stale queue entries
+		if (openBlock.first != field.blockCosts[blockIdx])
+			continue;
+
+		const int2 blockPos = blockGraph->BlockIdxToPos(blockIdx);
+
+		for (unsigned int pathDir = 0; pathDir < PATH_DIRECTIONS; pathDir++) {
+			const int2 testBlockPos = blockPos + PE_DIRECTION_VECTORS[pathDir];
+
+			if (testBlockPos.x < 0 || testBlockPos.x >= nbrOfBlocks.x)
+				continue;
+			if (testBlockPos.y < 0 || testBlockPos.y >= nbrOfBlocks.y)
+				continue;
+
+			const unsigned int testBlockIdx = blockGraph->BlockPosToIdx(testBlockPos);
+			const float vertexCost = vertexCosts[vertexBaseIdx + blockIdx * PATH_DIRECTION_VERTICES + GetBlockVertexOffset(pathDir, nbrOfBlocks.x)];
+
+			if (vertexCost >= PATHCOST_INFINITY)
+				continue;
+
+			const float testBlockCost = openBlock.first + vertexCost;
+
+			if (testBlockCost >= field.blockCosts[testBlockIdx])
+				continue;
+
+			numReachedBlocks += (field.blockCosts[testBlockIdx] == PATHCOST_INFINITY);
+
+			// the step from <testBlock> toward the goal reverses <pathDir>
+			field.blockCosts[testBlockIdx] = testBlockCost;
+			field.blockDirs[testBlockIdx] = (pathDir + (PATH_DIRECTIONS >> 1)) % PATH_DIRECTIONS;
+
+			openBlocks.push({testBlockCost, testBlockIdx});
+		}
+	}
+
+	return (numReachedBlocks > 0);
+}
+
+
+bool CPathFlowField::FollowField(const FlowField& field, const MoveDef& moveDef, const float3& startPos, IPath::Path& path) const
+{
+	unsigned int blockIdx = GetBlockIdx(startPos);
+
+	// start-block was never reached by the integration
+	if (field.blockCosts[blockIdx] == PATHCOST_INFINITY)
+		return false;
+
+	// nothing to gain over a direct max-res search
+	if (blockIdx == field.goalBlockIdx)
+		return false;
+
+	const std::vector<short2>& nodeOffsets = blockGraph->blockStates.peNodeOffsets[field.pathType];
+
+	path.path.clear();
+	path.squares.clear();
+
+	const float pathCost = field.blockCosts[blockIdx];
+
+	// walk the field down-cost (the stored directions form a DAG rooted
+	// at the goal-block, so this always terminates); use the same block
+	// offsets as FinishSearch so field- and search-paths line up
+	while (true) {
+		const int2 square = nodeOffsets[blockIdx];
+
+		path.path.emplace_back(square.x * SQUARE_SIZE, CMoveMath::yLevel(moveDef, square.x, square.y), square.y * SQUARE_SIZE);
+
+		if (blockIdx == field.goalBlockIdx)
+			break;
+
+		const unsigned int pathDir = field.blockDirs[blockIdx];
+
+		assert(pathDir < PATH_DIRECTIONS);
+		blockIdx = blockGraph->BlockPosToIdx(blockGraph->BlockIdxToPos(blockIdx) + PE_DIRECTION_VECTORS[pathDir]);
+	}
+
+	// emitted start-first, but consumers pop waypoints from the back
+	std::reverse(path.path.begin(), path.path.end());
+
+	path.pathGoal = path.path[0];
+	path.pathCost = pathCost;
+	return true;
+}
@@ -0,0 +1,95 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef PATH_FLOWFIELD_H
+#define PATH_FLOWFIELD_H
+
+#include <cinttypes>
+#include <vector>
+
+#include "IPath.h"
+#include "System/float3.h"
+#include "System/UnorderedMap.hpp"
+
+struct MoveDef;
+class CPathEstimator;
+
+/**
+ * Caches integration ("flow") fields over the med-res estimator block
+ * graph, one per {goal-block, path-type} pair; fields are built on
+ * demand when enough synced requests share a goal-block within a short
+ * window (mass attack- and fight-move orders) and are evicted LRU.
+ *
+ * A field stores for every block the direction of the cheapest step
+ * toward the goal, so any number of units can derive their med-res
+ * paths from it by a simple walk instead of each running a separate
+ * estimator search. Fields are integrated from the PE vertex-cost
+ * table and simply age out like regular cache items; any staleness
+ * in between is corrected by the max-res refinement searches, which
+ * always see the current blocking-map.
+ */
+class CPathFlowField {
+public:
+	struct FlowField {
+		// per block, the PATHDIR_* index of the cheapest step toward
+		// the goal-block (equal to PATH_DIRECTIONS if the block is the
+		// goal itself or was not reached by the integration)
+		std::vector<std::uint8_t> blockDirs;
+		// per block, the integrated cost of reaching the goal-block
+		std::vector<float> blockCosts;
+
+		unsigned int goalBlockIdx = 0;
+		unsigned int pathType = 0;
+
+		int buildFrame = -1; // sim-frame at which the field was integrated
+		int touchFrame = -1; // sim-frame at which the field was last read (LRU)
+	};
+
+	void Init(const CPathEstimator* pe);
+	void Kill() {
+		fields.clear();
+		requestCounts.clear();
+
+		blockGraph = nullptr;
+	}
+
+	// ages out expired fields and request-counters; called every frame
+	void Update();
+
+	/**
+	 * Registers a request toward <goalPos> and returns the field for its
+	 * goal-block if one exists or enough requests have accumulated to
+	 * justify integrating one, null otherwise (in which case the caller
+	 * searches as usual).
+	 */
+	const FlowField* GetField(const float3& goalPos, unsigned int pathType);
+
+	/**
+	 * Derives a med-res path from <startPos> by walking <field> down-cost;
+	 * mirrors the layout produced by CPathEstimator::FinishSearch (goal
+	 * point first, start point last). Fails if the start-block was not
+	 * reached by the integration.
+	 */
+	bool FollowField(const FlowField& field, const MoveDef& moveDef, const float3& startPos, IPath::Path& path) const;
+
+	unsigned int GetNumFields() const { return fields.size(); }
+
+private:
+	std::uint64_t GetFieldKey(unsigned int goalBlockIdx, unsigned int pathType) const {
+		return ((std::uint64_t(goalBlockIdx) << 32) | pathType);
+	}
+
+	unsigned int GetBlockIdx(const float3& pos) const;
+
+	bool IntegrateField(FlowField& field) const;
+
+	const CPathEstimator* blockGraph = nullptr;
+
+	// all built fields, keyed by {goal-block, path-type}
+	spring::unordered_map<std::uint64_t, FlowField> fields;
+
+	// x = number of requests per key since sim-frame y; detects goals
+	// shared by enough units that a field beats individual searches
+	spring::unordered_map<std::uint64_t, int2> requestCounts;
+};
+
+#endif
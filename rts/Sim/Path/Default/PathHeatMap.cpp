@@ -50,10 +50,11 @@ void PathHeatMap::AddHeat(const CSolidObject* owner, const CPathManager* pm, uns
 	if (!owner->moveDef->heatMapping)
 		return;
 
-	// internally clears and reserves squares
-	pm->GetDetailedPathSquares(pathID, pathSquares);
+	// grab the squares in-place; copying every live path once per frame
+	// made this scale with total path length rather than active traffic
+	const IPath::square_list_type* pathSquares = pm->GetDetailedPathSquareList(pathID);
 
-	if (pathSquares.empty())
+	if (pathSquares == nullptr || pathSquares->empty())
 		return;
 
 	// called every frame by PathManager::UpdatePath
@@ -76,13 +77,16 @@ void PathHeatMap::AddHeat(const CSolidObject* owner, const CPathManager* pm, uns
 	//   the heatmapped paths look like "breadcrumb" trails
 	//   this does not matter only because the default PFS
 	//   uses the same spacing-factor between waypoints
-	unsigned int i = pathSquares.size();
+	//
+	// squares are stored goal-first, so weights increase
+	// toward the start-side of the list
+	unsigned int i = 0;
 
-	const float scale = 1.0f / i;
+	const float scale = 1.0f / pathSquares->size();
 	const float value = scale * owner->moveDef->heatProduced;
 
-	for (const int2 sqr: pathSquares) {
-		UpdateHeatValue(sqr.x, sqr.y, (i--) * value, owner->id);
+	for (const int2 sqr: *pathSquares) {
+		UpdateHeatValue(sqr.x, sqr.y, (++i) * value, owner->id);
 	}
 }
 
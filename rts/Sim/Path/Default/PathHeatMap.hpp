@@ -22,9 +22,9 @@ public:
 	void Init(unsigned int sizex, unsigned int sizez);
 	void Kill() {
 		heatMap.clear();
-		pathSquares.clear();
 	}
 
+	// cells store values relative to the offset, so global decay is O(1)
 	void Update() { ++heatMapOffset; }
 
 
@@ -51,7 +51,6 @@ private:
 
 	// resolution is hmapx*hmapy
 	std::vector<HeatCell> heatMap;
-	std::vector<int2> pathSquares;
 
 	unsigned int xscale = 0, xsize = 0;
 	unsigned int zscale = 0, zsize = 0;
@@ -4,6 +4,7 @@
 #include "PathConstants.h"
 #include "PathFinder.h"
 #include "PathEstimator.h"
+#include "PathFlowField.h"
 #include "PathFlowMap.hpp"
 #include "PathHeatMap.hpp"
 #include "PathLog.h"
@@ -16,15 +17,17 @@
 #include "System/TimeProfiler.h"
 
 
-static CPathFinder    gMaxResPF;
-static CPathEstimator gMedResPE;
-static CPathEstimator gLowResPE;
+static CPathFinder     gMaxResPF;
+static CPathEstimator  gMedResPE;
+static CPathEstimator  gLowResPE;
+static CPathFlowField  gPathFlowField;
 
 
 CPathManager::CPathManager()
 : maxResPF(nullptr)
 , medResPE(nullptr)
 , lowResPE(nullptr)
+, pathFlowField(nullptr)
 , pathFlowMap(nullptr)
 , pathHeatMap(nullptr)
 , nextPathID(0)
@@ -46,10 +49,13 @@ CPathManager::~CPathManager()
 {
 	// Finalize is not called in case of forced exit
 	if (maxResPF != nullptr) {
+		pathFlowField->Kill();
 		lowResPE->Kill();
 		medResPE->Kill();
 		maxResPF->Kill();
 
+		pathFlowField = nullptr;
+
 		maxResPF = nullptr;
 		medResPE = nullptr;
 		lowResPE = nullptr;
@@ -85,6 +91,9 @@ std::int64_t CPathManager::Finalize() {
 		maxResPF->Init(false);
 		medResPE->Init(maxResPF, MEDRES_PE_BLOCKSIZE, "pe" , mapInfo->map.name);
 		lowResPE->Init(medResPE, LOWRES_PE_BLOCKSIZE, "pe2", mapInfo->map.name);
+
+		pathFlowField = &gPathFlowField;
+		pathFlowField->Init(medResPE);
 	}
 
 	const spring_time dt = spring_gettime() - t0;
@@ -377,18 +386,66 @@ unsigned int CPathManager::RequestPath(
 	newPath.caller = caller;
 	newPath.peDef.synced = synced;
 
+	// queue synced MoveType-driven requests if the mod asks for it;
+	// they are resolved in request-order during Update (identically
+	// on every machine) and callers receive temporary waypoints in
+	// the meantime, as with QTPFS
+	//
+	// unsynced and caller-less (Lua) requests read their result back
+	// immediately and always resolve in place
+	if (modInfo.pfDeferredRequests && synced && caller != nullptr) {
+		newPath.pending = true;
+
+		const unsigned int pathID = Store(newPath);
+		deferredRequestIDs.push_back(pathID);
+		return pathID;
+	}
+
+	if (ResolveRequest(newPath, caller, startPos, goalPos, synced) == IPath::Error)
+		return 0;
+
+	return (Store(newPath));
+}
+
+
+/*
+Run the actual searches for a request and finalize its path.
+*/
+IPath::SearchResult CPathManager::ResolveRequest(
+	MultiPath& path,
+	CSolidObject* caller,
+	const float3& startPos,
+	const float3& goalPos,
+	bool synced
+) {
 	if (caller != nullptr)
 		caller->UnBlock();
 
-	const IPath::SearchResult result = ArrangePath(&newPath, moveDef, startPos, goalPos, caller);
+	IPath::SearchResult result = IPath::Error;
+
+	// mass orders sharing a goal-block (attack- and fight-moves) resolve
+	// against one integrated flow-field over the med-res block graph, so
+	// a 300-unit move costs one integration plus cheap down-cost walks
+	// instead of 300 estimator searches; short-range requests skip this
+	// since they resolve through the max-res PF anyway
+	if (synced && caller != nullptr && startPos.SqDistance2D(goalPos) > Square(MAXRES_SEARCH_DISTANCE * SQUARE_SIZE)) {
+		const CPathFlowField::FlowField* field = pathFlowField->GetField(goalPos, path.moveDef->pathType);
+
+		// the walked path personalizes like any Ok med-res search result
+		// (MedRes2MaxRes runs a current-blocking max-res search over its
+		// head segment below, and again on each extension)
+		if (field != nullptr && pathFlowField->FollowField(*field, *path.moveDef, startPos, path.medResPath))
+			result = IPath::Ok;
+	}
 
-	unsigned int pathID = 0;
+	if (result != IPath::Ok)
+		result = ArrangePath(&path, path.moveDef, startPos, goalPos, caller);
 
 	if (result != IPath::Error) {
-		if (newPath.maxResPath.path.empty()) {
+		if (path.maxResPath.path.empty()) {
 			if (result != IPath::CantGetCloser) {
-				LowRes2MedRes(newPath, startPos, caller, synced);
-				MedRes2MaxRes(newPath, startPos, caller, synced);
+				LowRes2MedRes(path, startPos, caller, synced);
+				MedRes2MaxRes(path, startPos, caller, synced);
 			} else {
 				// add one dummy waypoint so that the calling MoveType
 				// does not consider this request a failure, which can
@@ -397,20 +454,44 @@ unsigned int CPathManager::RequestPath(
 				// otherwise, code relying on MoveType::progressState
 				// (eg. BuilderCAI::MoveInBuildRange) would misbehave
 				// (eg. reject build orders)
-				newPath.maxResPath.path.push_back(startPos);
-				newPath.maxResPath.squares.push_back(int2(startPos.x / SQUARE_SIZE, startPos.z / SQUARE_SIZE));
+				path.maxResPath.path.push_back(startPos);
+				path.maxResPath.squares.push_back(int2(startPos.x / SQUARE_SIZE, startPos.z / SQUARE_SIZE));
 			}
 		}
 
-		FinalizePath(&newPath, startPos, goalPos, result == IPath::CantGetCloser);
-		newPath.searchResult = result;
-		pathID = Store(newPath);
+		FinalizePath(&path, startPos, goalPos, result == IPath::CantGetCloser);
 	}
 
+	path.searchResult = result;
+
 	if (caller != nullptr)
 		caller->Block();
 
-	return pathID;
+	return result;
+}
+
+
+/*
+Resolve all requests queued by RequestPath since the previous Update.
+*/
+void CPathManager::ResolveDeferredRequests()
+{
+	for (const unsigned int pathID: deferredRequestIDs) {
+		MultiPath* path = GetMultiPath(pathID);
+
+		// request was deleted before it came up for resolution
+		if (path == nullptr)
+			continue;
+
+		path->pending = false;
+
+		// note: failed requests keep their pathID; NextWayPoint returns
+		// the error-vector for them so the owning MoveType stops (as it
+		// does for a dangling QTPFS id)
+		ResolveRequest(*path, path->caller, path->start, path->finalGoal, path->peDef.synced);
+	}
+
+	deferredRequestIDs.clear();
 }
 
 
@@ -528,6 +609,17 @@ float3 CPathManager::NextWayPoint(
 	if (numRetries > MAX_PATH_REFINEMENT_DEPTH)
 		return (multiPath->finalGoal);
 
+	if (multiPath->pending) {
+		// deferred request that has not been resolved yet; set the unit
+		// off toward its goal in small fixed steps to hide the latency
+		// and flag the waypoints as temporary (y = -1) so they are not
+		// followed religiously (cf. QTPFS)
+		const float3& sourcePoint = callerPos;
+		const float3& targetPoint = multiPath->finalGoal;
+		const float3  targetDirec = (targetPoint - sourcePoint).SafeNormalize() * SQUARE_SIZE;
+		return float3(sourcePoint.x + targetDirec.x, -1.0f, sourcePoint.z + targetDirec.z);
+	}
+
 	IPath::Path& maxResPath = multiPath->maxResPath;
 	IPath::Path& medResPath = multiPath->medResPath;
 	IPath::Path& lowResPath = multiPath->lowResPath;
@@ -594,7 +686,6 @@ float3 CPathManager::NextWayPoint(
 	} while ((callerPos.SqDistance2D(waypoint) < Square(radius)) && (waypoint != maxResPath.pathGoal));
 
 	// y=0 indicates this is not a temporary waypoint
-	// (the default PFS does not queue path-requests)
 	return (waypoint * XZVector);
 }
 
@@ -622,9 +713,13 @@ void CPathManager::Update()
 
 	pathFlowMap->Update();
 	pathHeatMap->Update();
+	pathFlowField->Update();
 
 	medResPE->Update();
 	lowResPE->Update();
+
+	// after the estimators, so resolved paths see refreshed costs
+	ResolveDeferredRequests();
 }
 
 // used to deposit heat on the heat-map as a unit moves along its path
@@ -679,6 +774,16 @@ void CPathManager::GetDetailedPathSquares(unsigned pathID, std::vector<int2>& sq
 	}
 }
 
+const IPath::square_list_type* CPathManager::GetDetailedPathSquareList(unsigned pathID) const
+{
+	const MultiPath* multiPath = GetMultiPathConst(pathID);
+
+	if (multiPath == nullptr)
+		return nullptr;
+
+	return &(multiPath->maxResPath.squares);
+}
+
 
 
 void CPathManager::GetPathWayPoints(
@@ -13,6 +13,7 @@
 class CSolidObject;
 class CPathFinder;
 class CPathEstimator;
+class CPathFlowField;
 class PathFlowMap;
 class PathHeatMap;
 class CPathFinderDef;
@@ -47,6 +48,7 @@ public:
 			peDef   = mp.peDef;
 			moveDef = mp.moveDef;
 			caller  = mp.caller;
+			pending = mp.pending;
 
 			mp.moveDef = nullptr;
 			mp.caller  = nullptr;
@@ -70,6 +72,9 @@ public:
 
 		// additional information
 		CSolidObject* caller;
+
+		// true until a deferred request has been resolved
+		bool pending = false;
 	};
 
 public:
@@ -134,6 +139,13 @@ public:
 	 */
 	void GetDetailedPathSquares(unsigned pathID, std::vector<int2>& points) const;
 
+	/**
+	 * Returns the max-resolution squares of a path without copying them
+	 * (stored goal-first), or null for an unknown path-id; used by the
+	 * heat-map which reads every live path once per frame.
+	 */
+	const IPath::square_list_type* GetDetailedPathSquareList(unsigned pathID) const;
+
 	void GetPathWayPoints(unsigned int pathID, std::vector<float3>& points, std::vector<int>& starts) const override;
 
 	void TerrainChange(unsigned int x1, unsigned int z1, unsigned int x2, unsigned int z2, unsigned int type) override;
@@ -164,6 +176,15 @@ private:
 		CSolidObject* caller
 	) const;
 
+	IPath::SearchResult ResolveRequest(
+		MultiPath& path,
+		CSolidObject* caller,
+		const float3& startPos,
+		const float3& goalPos,
+		bool synced
+	);
+	void ResolveDeferredRequests();
+
 	MultiPath* GetMultiPath(int pathID) { return (const_cast<MultiPath*>(GetMultiPathConst(pathID))); }
 
 	const MultiPath* GetMultiPathConst(int pathID) const {
@@ -191,11 +212,17 @@ private:
 	CPathEstimator* medResPE;
 	CPathEstimator* lowResPE;
 
+	// shared med-res goal-fields for mass orders
+	CPathFlowField* pathFlowField;
+
 	PathFlowMap* pathFlowMap;
 	PathHeatMap* pathHeatMap;
 
 	spring::unordered_map<unsigned int, MultiPath> pathMap;
 
+	// id's of requests waiting to be resolved during Update
+	std::vector<unsigned int> deferredRequestIDs;
+
 	unsigned int nextPathID;
 };
 
@@ -76,23 +76,48 @@ void QTPFS::NodeLayer::Clear() {
 
 #ifdef QTPFS_STAGGERED_LAYER_UPDATES
 void QTPFS::NodeLayer::QueueUpdate(const SRectangle& r, const MoveDef* md) {
+	SRectangle ur = r;
+
+	// coalesce with the most recently queued update whenever the
+	// union of both rectangles covers no more area than they do
+	// separately, s.t. repeated small craters in one region cost
+	// a single re-tesselation pass instead of N overlapping ones
+	//
+	// terrain inside the older rectangle can not have changed again
+	// since its snapshot was taken (such a change would have queued
+	// a later update), so re-snapshotting the union serves both
+	if (!layerUpdates.empty()) {
+		const SRectangle& pr = (layerUpdates.back()).rectangle;
+
+		ur.x1 = std::min(r.x1, pr.x1);
+		ur.z1 = std::min(r.z1, pr.z1);
+		ur.x2 = std::max(r.x2, pr.x2);
+		ur.z2 = std::max(r.z2, pr.z2);
+
+		if (ur.GetArea() <= (r.GetArea() + pr.GetArea())) {
+			layerUpdates.pop_back();
+		} else {
+			ur = r;
+		}
+	}
+
 	layerUpdates.emplace_back();
 	LayerUpdate& layerUpdate = layerUpdates.back();
 
 	// the first update MUST have a non-zero counter
 	// since all nodes are at 0 after initialization
-	layerUpdate.rectangle = r;
-	layerUpdate.speedMods.resize(r.GetArea());
-	layerUpdate.blockBits.resize(r.GetArea());
+	layerUpdate.rectangle = ur;
+	layerUpdate.speedMods.resize(ur.GetArea());
+	layerUpdate.blockBits.resize(ur.GetArea());
 	layerUpdate.counter = ++updateCounter;
 
-	// make a snapshot of the terrain-state within <r>
-	for (unsigned int hmz = r.z1; hmz < r.z2; hmz++) {
-		for (unsigned int hmx = r.x1; hmx < r.x2; hmx++) {
-			const unsigned int recIdx = (hmz - r.z1) * r.GetWidth() + (hmx - r.x1);
+	// make a snapshot of the terrain-state within <ur>
+	for (unsigned int hmz = ur.z1; hmz < ur.z2; hmz++) {
+		for (unsigned int hmx = ur.x1; hmx < ur.x2; hmx++) {
+			const unsigned int recIdx = (hmz - ur.z1) * ur.GetWidth() + (hmx - ur.x1);
 
-			const unsigned int chmx = Clamp(int(hmx), md->xsizeh, r.x2 - md->xsizeh - 1);
-			const unsigned int chmz = Clamp(int(hmz), md->zsizeh, r.z2 - md->zsizeh - 1);
+			const unsigned int chmx = Clamp(int(hmx), md->xsizeh, ur.x2 - md->xsizeh - 1);
+			const unsigned int chmz = Clamp(int(hmz), md->zsizeh, ur.z2 - md->zsizeh - 1);
 
 			layerUpdate.speedMods[recIdx] = CMoveMath::GetPosSpeedMod(*md, hmx, hmz);
 			layerUpdate.blockBits[recIdx] = CMoveMath::IsBlockedNoSpeedModCheck(*md, chmx, chmz, nullptr);
@@ -101,6 +126,22 @@ void QTPFS::NodeLayer::QueueUpdate(const SRectangle& r, const MoveDef* md) {
 	}
 }
 
+unsigned int QTPFS::NodeLayer::GetNumRequiredQueuedUpdates(const SRectangle& r) const {
+	// snapshots must be consumed in queue-order (a newer one can
+	// partially overlap an older), so every update up to and incl.
+	// the last one overlapping <r> is required before a search may
+	// enter that region
+	unsigned int numRequiredUpdates = 0;
+
+	for (unsigned int i = 0; i < layerUpdates.size(); i++) {
+		if ((layerUpdates[i].rectangle).CheckOverlap(r)) {
+			numRequiredUpdates = i + 1;
+		}
+	}
+
+	return numRequiredUpdates;
+}
+
 bool QTPFS::NodeLayer::ExecQueuedUpdate() {
 	const LayerUpdate& layerUpdate = layerUpdates.front();
 	const SRectangle& rectangle = layerUpdate.rectangle;
@@ -53,6 +53,7 @@ namespace QTPFS {
 		bool HaveQueuedUpdate() const { return (!layerUpdates.empty()); }
 		const LayerUpdate& GetQueuedUpdate() const { return (layerUpdates.front()); }
 		unsigned int NumQueuedUpdates() const { return (layerUpdates.size()); }
+		unsigned int GetNumRequiredQueuedUpdates(const SRectangle& r) const;
 		#endif
 
 		bool Update(
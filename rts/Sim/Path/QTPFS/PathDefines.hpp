@@ -18,12 +18,18 @@
 //
 // #define QTPFS_VIRTUAL_NODE_FUNCTIONS
 // #define QTPFS_ENABLE_THREADED_UPDATE
+#define QTPFS_THREADED_SEARCHES
 // #define QTPFS_AMORTIZED_NODE_NEIGHBOR_CACHE_UPDATES
 #define QTPFS_ENABLE_MICRO_OPTIMIZATION_HACKS
 // #define QTPFS_CONSERVATIVE_NEIGHBOR_CACHE_UPDATES
 
 #define QTPFS_MAX_SMOOTHING_ITERATIONS 8
 
+// padding (in heightmap squares) added around the bounding-box of
+// queued searches when deciding which staggered layer-updates must
+// be executed before those searches run
+#define QTPFS_STAGGERED_UPDATE_MARGIN 64
+
 #define QTPFS_MAX_NETPOINTS_PER_NODE_EDGE 3
 #define QTPFS_NETPOINT_EDGE_SPACING_SCALE (1.0f / (QTPFS_MAX_NETPOINTS_PER_NODE_EDGE + 1))
 
@@ -185,8 +185,10 @@ void QTPFS::PathManager::InitStatic() {
 }
 
 void QTPFS::PathManager::Load() {
-	// NOTE: offset *must* start at a non-zero value
-	searchStateOffset = NODE_STATE_OFFSET;
+	// NOTE: offsets *must* start at a non-zero value
+	searchStateOffsets.clear();
+	searchStateOffsets.resize(moveDefHandler.GetNumMoveDefs(), NODE_STATE_OFFSET);
+
 	numTerrainChanges = 0;
 	numPathRequests   = 0;
 	maxNumLeafNodes   = 0;
@@ -195,6 +197,12 @@ void QTPFS::PathManager::Load() {
 	nodeLayers.resize(moveDefHandler.GetNumMoveDefs());
 	pathCaches.resize(moveDefHandler.GetNumMoveDefs());
 	pathSearches.resize(moveDefHandler.GetNumMoveDefs());
+	sharedPaths.resize(moveDefHandler.GetNumMoveDefs());
+	failedPathSearches.resize(moveDefHandler.GetNumMoveDefs());
+
+	#ifdef QTPFS_TRACE_PATH_SEARCHES
+	pendingPathTraces.resize(moveDefHandler.GetNumMoveDefs());
+	#endif
 
 	// add one extra element for object-less requests
 	numCurrExecutedSearches.resize(teamHandler.ActiveTeams() + 1, 0);
@@ -486,10 +494,53 @@ void QTPFS::PathManager::QueueNodeLayerUpdates(const SRectangle& r) {
 	}
 }
 
+SRectangle QTPFS::PathManager::GetQueuedSearchRectangle(unsigned int pathType) const {
+	// bounding-box around the end-points of all still-queued
+	// searches for this layer, in heightmap coordinates
+	SRectangle r = SRectangle(mapDims.mapx, mapDims.mapy,  0, 0);
+
+	const PathCache& pathCache = pathCaches[pathType];
+
+	for (const IPathSearch* search: pathSearches[pathType]) {
+		const IPath* path = pathCache.GetTempPath(search->GetID());
+
+		// temp-path might have been removed already via DeletePath
+		if (path->GetID() == 0)
+			continue;
+
+		const float3& sourcePoint = path->GetSourcePoint();
+		const float3& targetPoint = path->GetTargetPoint();
+
+		r.x1 = std::min(r.x1, int(std::min(sourcePoint.x, targetPoint.x)) / SQUARE_SIZE);
+		r.z1 = std::min(r.z1, int(std::min(sourcePoint.z, targetPoint.z)) / SQUARE_SIZE);
+		r.x2 = std::max(r.x2, int(std::max(sourcePoint.x, targetPoint.x)) / SQUARE_SIZE + 1);
+		r.z2 = std::max(r.z2, int(std::max(sourcePoint.z, targetPoint.z)) / SQUARE_SIZE + 1);
+	}
+
+	if (r.x1 >= r.x2 || r.z1 >= r.z2)
+		return NUL_RECTANGLE;
+
+	// searches mostly stay near the straight line between their
+	// end-points but can deviate around obstacles, so pad the box
+	// generously; any that wander farther briefly run on a stale
+	// tesselation and get marked dead (hence re-requested) when a
+	// deferred update covering that region finally executes
+	r.x1 = std::max(r.x1 - QTPFS_STAGGERED_UPDATE_MARGIN,            0);
+	r.z1 = std::max(r.z1 - QTPFS_STAGGERED_UPDATE_MARGIN,            0);
+	r.x2 = std::min(r.x2 + QTPFS_STAGGERED_UPDATE_MARGIN, mapDims.mapx);
+	r.z2 = std::min(r.z2 + QTPFS_STAGGERED_UPDATE_MARGIN, mapDims.mapy);
+	return r;
+}
+
 void QTPFS::PathManager::ExecQueuedNodeLayerUpdates(unsigned int layerNum, bool flushQueue) {
-	// flush this layer's entire update-queue if necessary
-	// (otherwise eat through 5 percent of it s.t. updates
-	// do not pile up faster than we consume them)
+	// eat through 5 percent of this layer's update-queue s.t.
+	// updates do not pile up faster than we consume them; when
+	// searches are pending, also execute (in queue-order) every
+	// update overlapping the region those searches will enter,
+	// so they never run on a tesselation that is stale there
+	//
+	// all other updates stay queued, capping the per-frame split
+	// work even on frames with pending searches
 	//
 	// called at run-time only, not load-time so we always
 	// *want* (as opposed to need) a tesselation pass here
@@ -497,6 +548,9 @@ void QTPFS::PathManager::ExecQueuedNodeLayerUpdates(unsigned int layerNum, bool
 	unsigned int maxExecutedUpdates = nodeLayers[layerNum].NumQueuedUpdates() * 0.05f;
 	unsigned int numExecutedUpdates = 0;
 
+	if (flushQueue)
+		maxExecutedUpdates = std::max(maxExecutedUpdates, nodeLayers[layerNum].GetNumRequiredQueuedUpdates(GetQueuedSearchRectangle(layerNum)));
+
 	while (nodeLayers[layerNum].HaveQueuedUpdate()) {
 		const LayerUpdate& lu = nodeLayers[layerNum].GetQueuedUpdate();
 		const SRectangle& mr = lu.rectangle;
@@ -522,8 +576,8 @@ void QTPFS::PathManager::ExecQueuedNodeLayerUpdates(unsigned int layerNum, bool
 
 		nodeLayers[layerNum].PopQueuedUpdate();
 
-		if ((!flushQueue) && ((numExecutedUpdates += 1) >= maxExecutedUpdates)) {
-			// no pending searches this frame, stop flushing
+		if ((numExecutedUpdates += 1) >= maxExecutedUpdates) {
+			// no (more) required updates this frame, stop flushing
 			break;
 		}
 	}
@@ -710,8 +764,6 @@ void QTPFS::PathManager::ThreadUpdate() {
 		static unsigned int minPathTypeUpdate = 0;
 		static unsigned int maxPathTypeUpdate = numPathTypeUpdates;
 
-		sharedPaths.clear();
-
 		for (unsigned int pathTypeUpdate = minPathTypeUpdate; pathTypeUpdate < maxPathTypeUpdate; pathTypeUpdate++) {
 			#ifndef QTPFS_IGNORE_DEAD_PATHS
 			QueueDeadPathSearches(pathTypeUpdate);
@@ -722,8 +774,50 @@ void QTPFS::PathManager::ThreadUpdate() {
 			ExecQueuedNodeLayerUpdates(pathTypeUpdate, !pathSearches[pathTypeUpdate].empty());
 			#endif
 
+			#ifdef QTPFS_LIMIT_TEAM_SEARCHES
+			// per-team budgets are shared across layers, so this has to
+			// stay serial (and in layer-order) to remain deterministic
+			RateLimitQueuedSearches(pathTypeUpdate);
+			#endif
+		}
+
+		#ifdef QTPFS_THREADED_SEARCHES
+		{
+			// layers are disjoint and all cross-layer mutations are
+			// deferred to the post-pass below, so the searches of
+			// each layer can execute in a task of their own; the
+			// pool hands layers out to idle workers s.t. a single
+			// expensive layer does not serialize the rest
+			streflop::streflop_init<streflop::Simple>();
+
+			for_mt(minPathTypeUpdate, maxPathTypeUpdate, [this](const int pathTypeUpdate) {
+				ExecuteQueuedSearches(pathTypeUpdate);
+			});
+
+			streflop::streflop_init<streflop::Simple>();
+		}
+		#else
+		for (unsigned int pathTypeUpdate = minPathTypeUpdate; pathTypeUpdate < maxPathTypeUpdate; pathTypeUpdate++) {
 			ExecuteQueuedSearches(pathTypeUpdate);
 		}
+		#endif
+
+		for (unsigned int pathTypeUpdate = minPathTypeUpdate; pathTypeUpdate < maxPathTypeUpdate; pathTypeUpdate++) {
+			// deferred cross-layer table mutations, in layer-order
+			for (unsigned int pathID: failedPathSearches[pathTypeUpdate]) {
+				DeletePath(pathID);
+			}
+
+			failedPathSearches[pathTypeUpdate].clear();
+
+			#ifdef QTPFS_TRACE_PATH_SEARCHES
+			for (const auto& pathTrace: pendingPathTraces[pathTypeUpdate]) {
+				pathTraces[pathTrace.first] = pathTrace.second;
+			}
+
+			pendingPathTraces[pathTypeUpdate].clear();
+			#endif
+		}
 
 		std::copy(numCurrExecutedSearches.begin(), numCurrExecutedSearches.end(), numPrevExecutedSearches.begin());
 
@@ -751,6 +845,9 @@ void QTPFS::PathManager::ExecuteQueuedSearches(unsigned int pathType) {
 	NodeLayer& nodeLayer = nodeLayers[pathType];
 	PathCache& pathCache = pathCaches[pathType];
 
+	// results are only shared within one update
+	sharedPaths[pathType].clear();
+
 	std::vector<IPathSearch*>& searches = pathSearches[pathType];
 	std::vector<IPathSearch*>::iterator searchesIt = searches.begin();
 
@@ -759,7 +856,7 @@ void QTPFS::PathManager::ExecuteQueuedSearches(unsigned int pathType) {
 		// RequestPath and QueueDeadPathSearches
 		while (searchesIt != searches.end()) {
 			if (ExecuteSearch(searches, searchesIt, nodeLayer, pathCache, pathType)) {
-				searchStateOffset += NODE_STATE_OFFSET;
+				searchStateOffsets[pathType] += NODE_STATE_OFFSET;
 			}
 		}
 	}
@@ -800,9 +897,9 @@ bool QTPFS::PathManager::ExecuteSearch(
 
 	{
 		#ifdef QTPFS_SEARCH_SHARED_PATHS
-		SharedPathMap::const_iterator sharedPathsIt = sharedPaths.find(path->GetHash());
+		SharedPathMap::const_iterator sharedPathsIt = sharedPaths[pathType].find(path->GetHash());
 
-		if (sharedPathsIt != sharedPaths.end()) {
+		if (sharedPathsIt != sharedPaths[pathType].end()) {
 			if (search->SharedFinalize(sharedPathsIt->second, path)) {
 				DeleteSearch(search, searches, searchesIt);
 				return false;
@@ -811,36 +908,63 @@ bool QTPFS::PathManager::ExecuteSearch(
 		#endif
 
 		#ifdef QTPFS_LIMIT_TEAM_SEARCHES
-		const unsigned int numCurrSearches = numCurrExecutedSearches[search->GetTeam()];
-		const unsigned int numPrevSearches = numPrevExecutedSearches[search->GetTeam()];
-
-		if ((numCurrSearches - numPrevSearches) >= MAX_TEAM_SEARCHES) {
+		// budget was consumed (or exhausted) by RateLimitQueuedSearches
+		if (search->GetRateLimited()) {
 			++searchesIt; return false;
 		}
-
-		numCurrExecutedSearches[search->GetTeam()] += 1;
 		#endif
 	}
 
 	// removes path from temp-paths, adds it to live-paths
-	if (search->Execute(searchStateOffset, numTerrainChanges)) {
+	if (search->Execute(searchStateOffsets[pathType], numTerrainChanges)) {
 		search->Finalize(path);
 
 		#ifdef QTPFS_SEARCH_SHARED_PATHS
-		sharedPaths[path->GetHash()] = path;
+		sharedPaths[pathType][path->GetHash()] = path;
 		#endif
 
 		#ifdef QTPFS_TRACE_PATH_SEARCHES
-		pathTraces[path->GetID()] = search->GetExecutionTrace();
+		pendingPathTraces[pathType].emplace_back(path->GetID(), search->GetExecutionTrace());
 		#endif
 	} else {
-		DeletePath(path->GetID());
+		// DeletePath modifies tables shared across layers,
+		// defer it to the serial post-pass in ThreadUpdate
+		failedPathSearches[pathType].push_back(path->GetID());
 	}
 
 	DeleteSearch(search, searches, searchesIt);
 	return true;
 }
 
+#ifdef QTPFS_LIMIT_TEAM_SEARCHES
+void QTPFS::PathManager::RateLimitQueuedSearches(unsigned int pathType) {
+	const PathCache& pathCache = pathCaches[pathType];
+
+	// deterministic replacement for checking team-budgets inside
+	// ExecuteSearch: decide up-front which searches may run this
+	// frame, charging every live request against its team (note
+	// that a search which could shared-finalize used to be free,
+	// but whether it can is only known during execution; it will
+	// still be finalized when rate-limited, just billed)
+	for (IPathSearch* search: pathSearches[pathType]) {
+		// temp-path might have been removed already via DeletePath
+		if ((pathCache.GetTempPath(search->GetID()))->GetID() == 0)
+			continue;
+
+		const unsigned int numCurrSearches = numCurrExecutedSearches[search->GetTeam()];
+		const unsigned int numPrevSearches = numPrevExecutedSearches[search->GetTeam()];
+
+		if ((numCurrSearches - numPrevSearches) >= MAX_TEAM_SEARCHES) {
+			search->SetRateLimited(true);
+			continue;
+		}
+
+		search->SetRateLimited(false);
+		numCurrExecutedSearches[search->GetTeam()] += 1;
+	}
+}
+#endif
+
 void QTPFS::PathManager::QueueDeadPathSearches(unsigned int pathType) {
 	PathCache& pathCache = pathCaches[pathType];
 	PathCache::PathMap::const_iterator deadPathsIt;
@@ -119,11 +119,16 @@ namespace QTPFS {
 		#ifdef QTPFS_STAGGERED_LAYER_UPDATES
 		void QueueNodeLayerUpdates(const SRectangle& r);
 		void ExecQueuedNodeLayerUpdates(unsigned int layerNum, bool flushQueue);
+		SRectangle GetQueuedSearchRectangle(unsigned int pathType) const;
 		#endif
 
 		void ExecuteQueuedSearches(unsigned int pathType);
 		void QueueDeadPathSearches(unsigned int pathType);
 
+		#ifdef QTPFS_LIMIT_TEAM_SEARCHES
+		void RateLimitQueuedSearches(unsigned int pathType);
+		#endif
+
 		unsigned int QueueSearch(
 			const IPath* oldPath,
 			const CSolidObject* object,
@@ -156,8 +161,22 @@ namespace QTPFS {
 		spring::unordered_map<unsigned int, unsigned int> pathTypes;
 		spring::unordered_map<unsigned int, PathSearchTrace::Execution*> pathTraces;
 
-		// maps "hashes" of executed searches to the found paths
-		spring::unordered_map<std::uint64_t, IPath*> sharedPaths;
+		// maps "hashes" of executed searches to the found paths, one map
+		// per node-layer s.t. the threaded search pass stays lock-free
+		// (hits can only come from searches on the same layer since the
+		// pathType is folded into the hash)
+		std::vector<SharedPathMap> sharedPaths;
+
+		// path-IDs of searches that failed during the (threaded) search
+		// pass, collected per node-layer; DeletePath modifies the tables
+		// shared across layers and is deferred to a serial post-pass
+		std::vector< std::vector<unsigned int> > failedPathSearches;
+
+		#ifdef QTPFS_TRACE_PATH_SEARCHES
+		// execution-traces recorded during the (threaded) search pass,
+		// merged into pathTraces by the same serial post-pass
+		std::vector< std::vector< std::pair<unsigned int, PathSearchTrace::Execution*> > > pendingPathTraces;
+		#endif
 
 		std::vector<unsigned int> numCurrExecutedSearches;
 		std::vector<unsigned int> numPrevExecutedSearches;
@@ -165,7 +184,9 @@ namespace QTPFS {
 		static unsigned int LAYERS_PER_UPDATE;
 		static unsigned int MAX_TEAM_SEARCHES;
 
-		unsigned int searchStateOffset;
+		// per node-layer; node search-states never cross layers
+		std::vector<unsigned int> searchStateOffsets;
+
 		unsigned int numTerrainChanges;
 		unsigned int numPathRequests;
 		unsigned int maxNumLeafNodes;
@@ -14,8 +14,25 @@
 #endif
 
 #include "System/float3.h"
+#include "System/Threading/ThreadPool.h"
 
-QTPFS::binary_heap<QTPFS::INode*> QTPFS::PathSearch::openNodes;
+std::vector< QTPFS::binary_heap<QTPFS::INode*> > QTPFS::PathSearch::openNodeQueues;
+
+QTPFS::binary_heap<QTPFS::INode*>& QTPFS::PathSearch::GetOpenNodeQueue() {
+	return openNodeQueues[ThreadPool::GetThreadNum()];
+}
+
+void QTPFS::PathSearch::InitGlobalQueue(unsigned int n) {
+	openNodeQueues.resize(ThreadPool::GetMaxThreads());
+
+	for (binary_heap<INode*>& q: openNodeQueues) {
+		q.reserve(n);
+	}
+}
+
+void QTPFS::PathSearch::FreeGlobalQueue() {
+	openNodeQueues.clear();
+}
 
 
 
@@ -46,6 +63,8 @@ bool QTPFS::PathSearch::Execute(
 	unsigned int searchStateOffset,
 	unsigned int searchMagicNumber
 ) {
+	binary_heap<INode*>& openNodes = GetOpenNodeQueue();
+
 	searchState = searchStateOffset; // starts at NODE_STATE_OFFSET
 	searchMagic = searchMagicNumber; // starts at numTerrainChanges
 
@@ -119,6 +138,8 @@ bool QTPFS::PathSearch::Execute(
 
 
 void QTPFS::PathSearch::ResetState(INode* node) {
+	binary_heap<INode*>& openNodes = GetOpenNodeQueue();
+
 	// will be copied into srcNode by UpdateNode()
 	netPoints[0] = {srcPoint.x, srcPoint.z};
 
@@ -153,6 +174,8 @@ void QTPFS::PathSearch::UpdateNode(INode* nextNode, INode* prevNode, unsigned in
 }
 
 void QTPFS::PathSearch::IterateNodes(const std::vector<INode*>& allNodes) {
+	binary_heap<INode*>& openNodes = GetOpenNodeQueue();
+
 	curNode = openNodes.top();
 	curNode->SetSearchState(searchState | NODE_STATE_CLOSED);
 	#ifdef QTPFS_CONSERVATIVE_NEIGHBOR_CACHE_UPDATES
@@ -188,6 +211,8 @@ void QTPFS::PathSearch::IterateNodes(const std::vector<INode*>& allNodes) {
 }
 
 void QTPFS::PathSearch::IterateNodeNeighbors(const std::vector<INode*>& nxtNodes) {
+	binary_heap<INode*>& openNodes = GetOpenNodeQueue();
+
 	// if curNode equals srcNode, this is just the original srcPoint
 	const float2& curPoint2 = curNode->GetNeighborEdgeTransitionPoint(0);
 	const float3  curPoint  = {curPoint2.x, 0.0f, curPoint2.y};
@@ -81,6 +81,7 @@ namespace QTPFS {
 			, searchType(pathSearchType)
 			, searchState(0)
 			, searchMagic(0)
+			, rateLimited(false)
 			{}
 		virtual ~IPathSearch() {}
 
@@ -106,6 +107,9 @@ namespace QTPFS {
 		unsigned int GetID() const { return searchID; }
 		unsigned int GetTeam() const { return searchTeam; }
 
+		void SetRateLimited(bool b) { rateLimited = b; }
+		bool GetRateLimited() const { return rateLimited; }
+
 	protected:
 		unsigned int searchID;     // links us to the temp-path that this search will finalize
 		unsigned int searchTeam;   // which team queued this search
@@ -113,6 +117,8 @@ namespace QTPFS {
 		unsigned int searchType;   // indicates if Dijkstra (h==0) or A* (h!=0) search is employed
 		unsigned int searchState;  // offset that identifies nodes as part of current search
 		unsigned int searchMagic;  // used to signal nodes they should update their neighbor-set
+
+		bool rateLimited;          // true if execution was deferred a frame by the team search-limit
 	};
 
 
@@ -132,7 +138,7 @@ namespace QTPFS {
 			, haveFullPath(false)
 			, havePartPath(false)
 			{}
-		~PathSearch() { openNodes.reset(); }
+		~PathSearch() { GetOpenNodeQueue().reset(); }
 
 		void Initialize(
 			NodeLayer* layer,
@@ -151,8 +157,8 @@ namespace QTPFS {
 
 		const std::uint64_t GetHash(std::uint64_t N, std::uint32_t k) const override;
 
-		static void InitGlobalQueue(unsigned int n) { openNodes.reserve(n); }
-		static void FreeGlobalQueue() { openNodes.clear(); }
+		static void InitGlobalQueue(unsigned int n);
+		static void FreeGlobalQueue();
 
 	private:
 		void ResetState(INode* node);
@@ -165,9 +171,14 @@ namespace QTPFS {
 		void SmoothPath(IPath* path) const;
 		bool SmoothPathIter(IPath* path) const;
 
-		// global queue: allocated once, re-used by all searches without clear()'s
-		// this relies on INode::operator< to sort the INode*'s by increasing f-cost
-		static binary_heap<INode*> openNodes;
+		// global queues: allocated once, re-used by all searches without clear()'s
+		// one queue per ThreadPool worker since searches on different node-layers
+		// can execute concurrently (a search runs within a single task start-to-
+		// finish); this relies on INode::operator< to sort the INode*'s by
+		// increasing f-cost
+		static std::vector< binary_heap<INode*> > openNodeQueues;
+
+		static binary_heap<INode*>& GetOpenNodeQueue();
 
 		NodeLayer* nodeLayer;
 		PathCache* pathCache;
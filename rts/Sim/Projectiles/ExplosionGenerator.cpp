@@ -577,7 +577,67 @@ bool CStdExplosionGenerator::Explosion(
 
 
 
-void CCustomExplosionGenerator::ExecuteExplosionCode(const char* code, float damage, char* instance, int spawnIndex, const float3& dir)
+void CCustomExplosionGenerator::CompileExplosionCode(const std::vector<char>& code, std::vector<ExpGenCodeInstr>& program)
+{
+	program.clear();
+	program.reserve(code.size() / 5 + 1);
+
+	const char* c = code.data();
+
+	for (;;) {
+		ExpGenCodeInstr instr;
+
+		instr.op = *(c++);
+
+		switch (instr.op) {
+			case OP_END: {
+				program.push_back(instr);
+				return;
+			}
+			case OP_STOREI:
+			case OP_STOREF: {
+				instr.size = *(const std::uint8_t*) c; c += 1;
+				std::memcpy(&instr.offset, c, sizeof(instr.offset)); c += 2;
+			} break;
+			case OP_ADD:
+			case OP_RAND:
+			case OP_DAMAGE:
+			case OP_INDEX:
+			case OP_SAWTOOTH:
+			case OP_DISCRETE:
+			case OP_SINE:
+			case OP_POW: {
+				std::memcpy(&instr.fval, c, sizeof(instr.fval)); c += 4;
+			} break;
+			case OP_YANK:
+			case OP_MULTIPLY:
+			case OP_ADDBUFF:
+			case OP_POWBUFF: {
+				std::memcpy(&instr.ival, c, sizeof(instr.ival)); c += 4;
+			} break;
+			case OP_LOADP: {
+				std::memcpy(&instr.pval, c, sizeof(instr.pval)); c += sizeof(void*);
+			} break;
+			case OP_STOREP:
+			case OP_DIR: {
+				std::memcpy(&instr.offset, c, sizeof(instr.offset)); c += 2;
+			} break;
+			default: {
+				assert(false);
+			} break;
+		}
+
+		// fold runs of constant additions into a single instruction
+		if (instr.op == OP_ADD && !program.empty() && program.back().op == OP_ADD) {
+			program.back().fval += instr.fval;
+			continue;
+		}
+
+		program.push_back(instr);
+	}
+}
+
+void CCustomExplosionGenerator::ExecuteExplosionCode(const ExpGenCodeInstr* code, float damage, char* instance, int spawnIndex, const float3& dir)
 {
 	float val = 0.0f;
 	float buffer[16];
@@ -585,115 +645,94 @@ void CCustomExplosionGenerator::ExecuteExplosionCode(const char* code, float dam
 
 	std::memset(&buffer[0], 0, sizeof(buffer));
 
-	for (;;) {
-		switch (*(code++)) {
+	for (;; code++) {
+		switch (code->op) {
 			case OP_END: {
 				return;
 			}
 			case OP_STOREI: {
-				std::uint8_t  size   = *(std::uint8_t*)  code; code++;
-				std::uint16_t offset = *(std::uint16_t*) code; code += 2;
-				switch (size) {
-					case 1: { *(std::int8_t*)  (instance + offset) = (int) val; } break;
-					case 2: { *(std::int16_t*) (instance + offset) = (int) val; } break;
-					case 4: { *(std::int32_t*) (instance + offset) = (int) val; } break;
-					case 8: { *(std::int64_t*) (instance + offset) = (int) val; } break;
+				switch (code->size) {
+					case 1: { *(std::int8_t*)  (instance + code->offset) = (int) val; } break;
+					case 2: { *(std::int16_t*) (instance + code->offset) = (int) val; } break;
+					case 4: { *(std::int32_t*) (instance + code->offset) = (int) val; } break;
+					case 8: { *(std::int64_t*) (instance + code->offset) = (int) val; } break;
 					default: { /*no op*/ } break;
 				}
 				val = 0.0f;
 				break;
 			}
 			case OP_STOREF: {
-				std::uint8_t  size   = *(std::uint8_t*)  code; code++;
-				std::uint16_t offset = *(std::uint16_t*) code; code += 2;
-				switch (size) {
-					case 4: { *(float*)  (instance + offset) = val; } break;
-					case 8: { *(double*) (instance + offset) = val; } break;
+				switch (code->size) {
+					case 4: { *(float*)  (instance + code->offset) = val; } break;
+					case 8: { *(double*) (instance + code->offset) = val; } break;
 					default: { /*no op*/ } break;
 				}
 				val = 0.0f;
 				break;
 			}
 			case OP_ADD: {
-				val += *(float*) code;
-				code += 4;
+				val += code->fval;
 				break;
 			}
 			case OP_RAND: {
-				val += guRNG.NextFloat() * (*(float*) code);
-				code += 4;
+				val += guRNG.NextFloat() * code->fval;
 				break;
 			}
 			case OP_DAMAGE: {
-				val += damage * (*(float*) code);
-				code += 4;
+				val += damage * code->fval;
 				break;
 			}
 			case OP_INDEX: {
-				val += spawnIndex * (*(float*) code);
-				code += 4;
+				val += spawnIndex * code->fval;
 				break;
 			}
 
 			case OP_LOADP: {
-				ptr = *(void**) code;
-				code += sizeof(void*);
+				ptr = code->pval;
 				break;
 			}
 			case OP_STOREP: {
-				std::uint16_t offset = *(std::uint16_t*) code;
-				code += 2;
-				*(void**) (instance + offset) = ptr;
+				*(void**) (instance + code->offset) = ptr;
 				ptr = nullptr;
 				break;
 			}
 
 			case OP_DIR: {
-				std::uint16_t offset = *(std::uint16_t*) code;
-				code += 2;
-				*reinterpret_cast<float3*>(instance + offset) = dir;
+				*reinterpret_cast<float3*>(instance + code->offset) = dir;
 				break;
 			}
 			case OP_SAWTOOTH: {
 				// this translates to modulo except it works with floats
-				val -= (*(float*) code) * math::floor(val / (*(float*) code));
-				code += 4;
+				val -= code->fval * math::floor(val / code->fval);
 				break;
 			}
 			case OP_DISCRETE: {
-				val = (*(float*) code) * math::floor(spring::SafeDivide(val, (*(float*) code)));
-				code += 4;
+				val = code->fval * math::floor(spring::SafeDivide(val, code->fval));
 				break;
 			}
 			case OP_SINE: {
-				val = (*(float*) code) * math::sin(val);
-				code += 4;
+				val = code->fval * math::sin(val);
 				break;
 			}
 			case OP_YANK: {
-				buffer[(*(int*) code)] = val;
+				buffer[code->ival] = val;
 				val = 0;
-				code += 4;
 				break;
 			}
 			case OP_MULTIPLY: {
-				val *= buffer[(*(int*) code)];
-				code += 4;
+				val *= buffer[code->ival];
 				break;
 			}
 			case OP_ADDBUFF: {
-				val += buffer[(*(int*) code)];
-				code += 4;
+				val += buffer[code->ival];
 				break;
 			}
 			case OP_POW: {
-				val = math::pow(val, (*(float*) code));
-				code += 4;
+				val = math::pow(val, code->fval);
 				break;
 			}
 			case OP_POWBUFF: {
-				val = math::pow(val, buffer[(*(int*) code)]);
-				code += 4;
+				val = math::pow(val, buffer[code->ival]);
 				break;
 			}
 			default: {
@@ -899,6 +938,9 @@ bool CCustomExplosionGenerator::Load(CExplosionGeneratorHandler* handler, const
 		psi.code.resize(code.size());
 		copy(code.begin(), code.end(), psi.code.begin());
 
+		// lower the byte stream into a flat, aligned instruction array
+		CompileExplosionCode(psi.code, psi.program);
+
 		expGenParams.projectiles.push_back(psi);
 	}
 
@@ -964,7 +1006,7 @@ bool CCustomExplosionGenerator::Explosion(
 
 		for (unsigned int c = 0; c < psi.count; c++) {
 			CExpGenSpawnable* projectile = CExpGenSpawnable::CreateSpawnable(psi.spawnableID);
-			ExecuteExplosionCode(&psi.code[0], damage, (char*) projectile, c, dir);
+			ExecuteExplosionCode(psi.program.data(), damage, (char*) projectile, c, dir);
 			projectile->Init(owner, pos);
 		}
 	}
@@ -3,6 +3,7 @@
 #ifndef EXPLOSION_GENERATOR_H
 #define EXPLOSION_GENERATOR_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -139,6 +140,21 @@ public:
 class CCustomExplosionGenerator: public IExplosionGenerator
 {
 protected:
+	// one fixed-size decoded operation; the parsed byte streams are
+	// lowered into arrays of these at load so per-particle execution
+	// never has to decode unaligned operands
+	struct ExpGenCodeInstr {
+		std::uint8_t op = 0;
+		std::uint8_t size = 0;     // store width in bytes (OP_STOREI/OP_STOREF)
+		std::uint16_t offset = 0;  // destination offset into the spawnable
+
+		union {
+			float fval;
+			int ival;
+			void* pval = nullptr;
+		};
+	};
+
 	struct ProjectileSpawnInfo {
 		unsigned int spawnableID = 0;
 
@@ -148,6 +164,8 @@ protected:
 
 		/// parsed explosion script code
 		std::vector<char> code;
+		/// <code> compiled into flat instructions at load time
+		std::vector<ExpGenCodeInstr> program;
 	};
 
 	struct ExpGenParams {
@@ -205,7 +223,8 @@ public:
 
 private:
 	void ParseExplosionCode(ProjectileSpawnInfo* psi, const std::string& script, SExpGenSpawnableMemberInfo& memberInfo, std::string& code);
-	void ExecuteExplosionCode(const char* code, float damage, char* instance, int spawnIndex, const float3& dir);
+	static void CompileExplosionCode(const std::vector<char>& code, std::vector<ExpGenCodeInstr>& program);
+	static void ExecuteExplosionCode(const ExpGenCodeInstr* code, float damage, char* instance, int spawnIndex, const float3& dir);
 
 protected:
 	ExpGenParams expGenParams;
@@ -10,8 +10,10 @@
 #include "Map/Ground.h"
 #include "Rendering/GlobalRendering.h"
 #include "Rendering/GroundFlash.h"
+#include "Map/ReadMap.h"
 #include "Sim/Features/Feature.h"
 #include "Sim/Features/FeatureDef.h"
+#include "Sim/Features/FeatureHandler.h"
 #include "Sim/Misc/CollisionHandler.h"
 #include "Sim/Misc/CollisionVolume.h"
 #include "Sim/Misc/GlobalSynced.h"
@@ -29,6 +31,7 @@
 #include "System/EventHandler.h"
 #include "System/Log/ILog.h"
 #include "System/SpringMath.h"
+#include "System/Threading/ThreadPool.h" // for_mt
 #include "System/TimeProfiler.h"
 
 
@@ -41,11 +44,20 @@ CONFIG(int, MaxParticles).defaultValue(10000).headlessValue(0).minimumValue(0);
 CONFIG(int, MaxNanoParticles).defaultValue(2000).headlessValue(0).minimumValue(0);
 
 
+CR_BIND(NanoParticle, )
+CR_REG_METADATA(NanoParticle, (
+	CR_MEMBER(pos),
+	CR_MEMBER(speed),
+	CR_MEMBER(deathFrame),
+	CR_MEMBER(color)
+))
+
 CR_BIND(CProjectileHandler, )
 CR_REG_METADATA(CProjectileHandler, (
 	CR_MEMBER(projectileContainers),
 	CR_MEMBER_UN(flyingPieces),
 	CR_MEMBER_UN(groundFlashes),
+	CR_MEMBER_UN(nanoParticles),
 	CR_MEMBER_UN(resortFlyingPieces),
 
 	CR_MEMBER(maxParticles),
@@ -55,7 +67,8 @@ CR_REG_METADATA(CProjectileHandler, (
 	CR_MEMBER_UN(lastProjectileCounts),
 
 	CR_MEMBER(freeProjectileIDs),
-	CR_MEMBER(projectileMaps)
+	CR_MEMBER(projectileMaps),
+	CR_MEMBER(projectileGens)
 ))
 
 
@@ -87,9 +100,17 @@ void CProjectileHandler::Init()
 	projectileMaps[false].resize(8192, nullptr);
 #endif
 
+	projectileGens[ true].clear();
+	projectileGens[ true].resize(projectileMaps[ true].size(), 0);
+	projectileGens[false].clear();
+	projectileGens[false].resize(projectileMaps[false].size(), 0);
+
 	maxParticles     = configHandler->GetInt("MaxParticles");
 	maxNanoParticles = configHandler->GetInt("MaxNanoParticles");
 
+	nanoParticles.clear();
+	nanoParticles.reserve(maxNanoParticles);
+
 	projMemPool.clear();
 	projMemPool.reserve(1024);
 
@@ -151,6 +172,8 @@ void CProjectileHandler::Kill()
 		}
 	}
 
+	nanoParticles.clear();
+
 	freeProjectileIDs[ true].clear();
 	freeProjectileIDs[false].clear();
 
@@ -290,6 +313,52 @@ static void UPDATE_REF_CONTAINER(T& cont) {
 
 
 
+static int CountContainerParticlesMT(const ProjectileContainer& pc)
+{
+	// fixed-size id-range chunks; GetProjectilesCount is a pure read
+	// and the integer partial sums make the fold order-independent,
+	// so this stays deterministic regardless of worker scheduling
+	constexpr size_t CHUNK_SIZE = 1024;
+
+	const size_t numChunks = (pc.size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+	int count = 0;
+
+	if (numChunks < 2) {
+		for (const CProjectile* p: pc) {
+			count += p->GetProjectilesCount();
+		}
+
+		return count;
+	}
+
+	static std::vector<int> chunkCounts;
+
+	chunkCounts.clear();
+	chunkCounts.resize(numChunks, 0);
+
+	for_mt(0, int(numChunks), [&pc](const int chunk) {
+		const size_t beg = chunk * CHUNK_SIZE;
+		const size_t end = std::min(pc.size(), beg + CHUNK_SIZE);
+
+		int chunkCount = 0;
+
+		for (size_t i = beg; i < end; i++) {
+			chunkCount += pc[i]->GetProjectilesCount();
+		}
+
+		chunkCounts[chunk] = chunkCount;
+	});
+
+	for (const int chunkCount: chunkCounts) {
+		count += chunkCount;
+	}
+
+	return count;
+}
+
+
+
 void CProjectileHandler::CreateProjectile(CProjectile* p)
 {
 	p->createMe = false;
@@ -310,6 +379,7 @@ void CProjectileHandler::DestroyProjectile(CProjectile* p)
 		eventHandler.ProjectileDestroyed(p, p->GetAllyteamID());
 
 		projectileMaps[true][p->id] = nullptr;
+		projectileGens[true][p->id] += 1;
 		freeProjectileIDs[true].push_back(p->id);
 
 		ASSERT_SYNCED(p->pos);
@@ -319,6 +389,7 @@ void CProjectileHandler::DestroyProjectile(CProjectile* p)
 		eventHandler.ProjectileDestroyed(p, p->GetAllyteamID());
 
 		projectileMaps[false][p->id] = nullptr;
+		projectileGens[false][p->id] += 1;
 		freeProjectileIDs[false].push_back(p->id);
 	#endif
 	}
@@ -336,6 +407,7 @@ void CProjectileHandler::Update()
 		// check if any projectiles have collided since the previous update
 		CheckCollisions();
 		UpdateProjectiles();
+		UpdateNanoParticles();
 
 		UPDATE_PTR_CONTAINER(groundFlashes);
 
@@ -353,32 +425,77 @@ void CProjectileHandler::Update()
 
 	// precache part of particles count calculation that else becomes very heavy
 	lastCurrentParticles = 0;
-
-	for (const CProjectile* p: projectileContainers[true]) {
-		lastCurrentParticles += p->GetProjectilesCount();
-	}
-	for (const CProjectile* p: projectileContainers[false]) {
-		lastCurrentParticles += p->GetProjectilesCount();
-	}
+	lastCurrentParticles += CountContainerParticlesMT(projectileContainers[ true]);
+	lastCurrentParticles += CountContainerParticlesMT(projectileContainers[false]);
 
 	lastProjectileCounts[ true] = projectileContainers[true].size();
 	lastProjectileCounts[false] = projectileContainers[false].size();
 }
 
+void CProjectileHandler::UpdateNanoParticles()
+{
+	// bulk-update the plain-struct nano sprays; expiration order does
+	// not matter (unsynced, and drawn unsorted) so swap-and-pop works
+	for (size_t i = 0; i < nanoParticles.size(); /*no-op*/) {
+		NanoParticle& np = nanoParticles[i];
+
+		if (gs->frameNum >= np.deathFrame) {
+			np = nanoParticles.back();
+			nanoParticles.pop_back();
+
+			currentNanoParticles -= 1;
+			continue;
+		}
+
+		np.pos += np.speed;
+		i += 1;
+	}
+}
+
 
 
 
 static unsigned int UnsyncedRandInt(unsigned int N) { return (guRNG.NextInt(N)); }
 static unsigned int   SyncedRandInt(unsigned int N) { return (gsRNG.NextInt(N)); }
 
+static constexpr decltype(&UnsyncedRandInt) rngFuncs[] = {&UnsyncedRandInt, &SyncedRandInt};
+
+
+void CProjectileHandler::AllocFreeProjectileIDs(bool synced, size_t minFree)
+{
+	auto& freeIDs = freeProjectileIDs[synced];
+	auto& projMap =    projectileMaps[synced];
+	auto& rngFunc =          rngFuncs[synced];
+
+	while (freeIDs.size() < minFree) {
+		const size_t oldSize = projMap.size();
+		const size_t newSize = std::max(oldSize + 256, oldSize * 2);
+		const size_t numFree = freeIDs.size();
+
+		projMap.resize(newSize, nullptr);
+		projectileGens[synced].resize(newSize, 0);
+		freeIDs.resize(numFree + (newSize - oldSize));
+
+		// generate (newSize - oldSize) new id's starting from oldSize
+		std::for_each(freeIDs.begin() + numFree, freeIDs.end(), [k = oldSize](int& id) mutable { id = k++; });
+		std::random_shuffle(freeIDs.begin() + numFree, freeIDs.end(), rngFunc);
+	}
+}
+
+void CProjectileHandler::ReserveProjectiles(bool synced, unsigned int count)
+{
+	projectileContainers[synced].reserve(projectileContainers[synced].size() + count);
+
+	if (synced || PH_UNSYNCED_PROJECTILE_EVENTS == 1)
+		AllocFreeProjectileIDs(synced, count);
+}
+
 void CProjectileHandler::AddProjectile(CProjectile* p)
 {
 	// already initialized?
 	assert(p->id < 0);
 	assert(p->createMe);
 
-	static constexpr decltype(&UnsyncedRandInt) rngFuncs[] = {&UnsyncedRandInt, &SyncedRandInt};
-
 	auto& freeIDs = freeProjectileIDs[p->synced];
 	auto& projMap =    projectileMaps[p->synced];
 	auto& rngFunc =          rngFuncs[p->synced];
@@ -386,17 +503,7 @@ void CProjectileHandler::AddProjectile(CProjectile* p)
 	projectileContainers[p->synced].push_back(p);
 
 	if (p->synced || PH_UNSYNCED_PROJECTILE_EVENTS == 1) {
-		if (freeIDs.empty()) {
-			const size_t oldSize = projMap.size();
-			const size_t newSize = std::max(oldSize + 256, oldSize * 2);
-
-			projMap.resize(newSize, nullptr);
-			freeIDs.resize(newSize - oldSize);
-
-			// generate (newSize - oldSize) new id's starting from oldSize
-			std::for_each(freeIDs.begin(), freeIDs.end(), [k = oldSize](int& id) mutable { id = k++; });
-			std::random_shuffle(freeIDs.begin(), freeIDs.end(), rngFunc);
-		}
+		AllocFreeProjectileIDs(p->synced, 1);
 
 
 		#if 0
@@ -426,6 +533,178 @@ void CProjectileHandler::AddProjectile(CProjectile* p)
 
 
 
+// edge length of the broadphase cells in elmos (two QuadField quads)
+static constexpr float PROJECTILE_BROADPHASE_CELL_SIZE = 256.0f;
+
+// uniform-grid bins for one candidate type, rebuilt from scratch each
+// frame via counting sort so all per-cell index ranges are contiguous
+template<typename T> struct BroadphaseBins {
+	struct Entry {
+		float3 pos;
+		float radius;
+		T* obj;
+	};
+
+	std::vector<Entry> entries;
+
+	// entries of cell c occupy cellEntries[cellOffsets[c] .. cellOffsets[c + 1])
+	std::vector<unsigned int> cellOffsets;
+	std::vector<unsigned int> cellCursors;
+	std::vector<unsigned int> cellEntries;
+	// entries span multiple cells; prevents double-emitting candidates
+	std::vector<unsigned int> queryStamps;
+
+	unsigned int queryNum = 0;
+
+	static int2 CellCoors(float x, float z, int ncx, int ncz) {
+		const int cx = int(x * (1.0f / PROJECTILE_BROADPHASE_CELL_SIZE));
+		const int cz = int(z * (1.0f / PROJECTILE_BROADPHASE_CELL_SIZE));
+
+		return (int2(Clamp(cx, 0, ncx - 1), Clamp(cz, 0, ncz - 1)));
+	}
+
+	void Clear() { entries.clear(); }
+	void Add(const float3& pos, float radius, T* obj) { entries.push_back({pos, radius, obj}); }
+
+	void Build(int ncx, int ncz) {
+		cellOffsets.assign(ncx * ncz + 1, 0);
+
+		for (const Entry& e: entries) {
+			const int2 cMin = CellCoors(e.pos.x - e.radius, e.pos.z - e.radius, ncx, ncz);
+			const int2 cMax = CellCoors(e.pos.x + e.radius, e.pos.z + e.radius, ncx, ncz);
+
+			for (int cz = cMin.y; cz <= cMax.y; cz++) {
+				for (int cx = cMin.x; cx <= cMax.x; cx++) {
+					cellOffsets[cz * ncx + cx + 1] += 1;
+				}
+			}
+		}
+
+		for (size_t c = 1; c < cellOffsets.size(); c++) {
+			cellOffsets[c] += cellOffsets[c - 1];
+		}
+
+		cellEntries.resize(cellOffsets.back());
+		cellCursors.assign(cellOffsets.begin(), cellOffsets.end() - 1);
+
+		for (size_t n = 0; n < entries.size(); n++) {
+			const Entry& e = entries[n];
+
+			const int2 cMin = CellCoors(e.pos.x - e.radius, e.pos.z - e.radius, ncx, ncz);
+			const int2 cMax = CellCoors(e.pos.x + e.radius, e.pos.z + e.radius, ncx, ncz);
+
+			for (int cz = cMin.y; cz <= cMax.y; cz++) {
+				for (int cx = cMin.x; cx <= cMax.x; cx++) {
+					cellEntries[cellCursors[cz * ncx + cx]++] = n;
+				}
+			}
+		}
+
+		queryStamps.assign(entries.size(), 0);
+		queryNum = 0;
+	}
+
+	template<typename F>
+	void Query(const float3& pos, float radius, int ncx, int ncz, F&& onCandidate) {
+		queryNum += 1;
+
+		const int2 cMin = CellCoors(pos.x - radius, pos.z - radius, ncx, ncz);
+		const int2 cMax = CellCoors(pos.x + radius, pos.z + radius, ncx, ncz);
+
+		for (int cz = cMin.y; cz <= cMax.y; cz++) {
+			for (int cx = cMin.x; cx <= cMax.x; cx++) {
+				const unsigned int cell = cz * ncx + cx;
+
+				for (unsigned int n = cellOffsets[cell]; n < cellOffsets[cell + 1]; n++) {
+					const unsigned int ei = cellEntries[n];
+
+					// prevent double adding
+					if (queryStamps[ei] == queryNum)
+						continue;
+
+					queryStamps[ei] = queryNum;
+
+					const Entry& e = entries[ei];
+					const float totRad = radius + e.radius;
+
+					if (pos.SqDistance(e.pos) >= (totRad * totRad))
+						continue;
+
+					onCandidate(e.obj);
+				}
+			}
+		}
+	}
+};
+
+
+// frame-level broadphase for projectile collision testing; bins every
+// unit, feature and shield bounding sphere once per frame so the per-
+// projectile candidate queries walk flat arrays instead of QuadField
+struct ProjectileBroadphase {
+	int numCellsX = 0;
+	int numCellsZ = 0;
+
+	BroadphaseBins<CUnit> unitBins;
+	BroadphaseBins<CFeature> featureBins;
+	BroadphaseBins<CPlasmaRepulser> repulserBins;
+
+	void Rebuild() {
+		numCellsX = std::max(1, int((mapDims.mapx * SQUARE_SIZE) / PROJECTILE_BROADPHASE_CELL_SIZE));
+		numCellsZ = std::max(1, int((mapDims.mapy * SQUARE_SIZE) / PROJECTILE_BROADPHASE_CELL_SIZE));
+
+		unitBins.Clear();
+		featureBins.Clear();
+		repulserBins.Clear();
+
+		for (CUnit* u: unitHandler.GetActiveUnits()) {
+			const CollisionVolume* colvol = &u->collisionVolume;
+
+			unitBins.Add(colvol->GetWorldSpacePos(u), colvol->GetBoundingRadius(), u);
+		}
+
+		// power and enabled-state can not change during the collision
+		// phase, so shields that would fail CanIntercept anyway can be
+		// left out of the index entirely
+		for (CPlasmaRepulser* r: CPlasmaRepulser::GetAllRepulsers()) {
+			if (!r->IsActive())
+				continue;
+
+			repulserBins.Add(r->weaponMuzzlePos, r->collisionVolume.GetBoundingRadius(), r);
+		}
+
+		for (const int featureID: featureHandler.GetActiveFeatureIDs()) {
+			CFeature* f = featureHandler.GetFeature(featureID);
+
+			if (f == nullptr)
+				continue;
+
+			const CollisionVolume* colvol = &f->collisionVolume;
+
+			featureBins.Add(colvol->GetWorldSpacePos(f), colvol->GetBoundingRadius(), f);
+		}
+
+		unitBins.Build(numCellsX, numCellsZ);
+		featureBins.Build(numCellsX, numCellsZ);
+		repulserBins.Build(numCellsX, numCellsZ);
+	}
+
+	void GetUnitsAndFeaturesColVol(
+		const float3& pos,
+		const float radius,
+		std::vector<CUnit*>& units,
+		std::vector<CFeature*>& features,
+		std::vector<CPlasmaRepulser*>& repulsers
+	) {
+		unitBins.Query(pos, radius, numCellsX, numCellsZ, [&units](CUnit* u) { units.push_back(u); });
+		featureBins.Query(pos, radius, numCellsX, numCellsZ, [&features](CFeature* f) { features.push_back(f); });
+		repulserBins.Query(pos, radius, numCellsX, numCellsZ, [&repulsers](CPlasmaRepulser* r) { repulsers.push_back(r); });
+	}
+};
+
+static ProjectileBroadphase projectileBroadphase;
+
+
 static bool CheckProjectileCollisionFlags(const CProjectile* p, const CUnit* u)
 {
 	const unsigned int collFlags = p->GetCollisionFlags() * p->weapon;
@@ -616,7 +895,7 @@ void CProjectileHandler::CheckUnitFeatureCollisions(ProjectileContainer& pc)
 		const float3 ppos1 = p->pos + p->speed;
 		// const float3 ppos1 = p->pos + p->dir * (p->speed.w + p->radius);
 
-		quadField.GetUnitsAndFeaturesColVol(p->pos, p->speed.w + p->radius, tempUnits, tempFeatures, &tempRepulsers);
+		projectileBroadphase.GetUnitsAndFeaturesColVol(p->pos, p->speed.w + p->radius, tempUnits, tempFeatures, tempRepulsers);
 
 		CheckShieldCollisions(p, tempRepulsers, ppos0, ppos1); tempRepulsers.clear();
 		CheckUnitCollisions(p, tempUnits, ppos0, ppos1); tempUnits.clear();
@@ -669,6 +948,11 @@ void CProjectileHandler::CheckCollisions()
 {
 	SCOPED_TIMER("Sim::Projectiles::Collisions");
 
+	// bin all candidate bounding spheres once; the checks below then
+	// emit candidates from the shared grid instead of querying the
+	// QuadField per projectile
+	projectileBroadphase.Rebuild();
+
 	CheckUnitFeatureCollisions(projectileContainers[ true]); // changes simulation state
 	CheckUnitFeatureCollisions(projectileContainers[false]); // does not change simulation state
 
@@ -678,6 +962,28 @@ void CProjectileHandler::CheckCollisions()
 
 
 
+void CProjectileHandler::AddGroundFlash(CGroundFlash* flash)
+{
+	// bombardments spawn hundreds of co-located flashes per second;
+	// let a recent nearby flash absorb (brighten by) the new one so
+	// worst-case counts stay bounded. candidates cluster at the tail
+	// since salvo impacts spawn their flashes back-to-back, a small
+	// scan window is enough
+	constexpr size_t scanWindow = 32;
+
+	if (flash->mergeable) {
+		for (size_t i = groundFlashes.size(), n = scanWindow; (i > 0 && n > 0); i--, n--) {
+			if (groundFlashes[i - 1]->TryMerge(flash))
+				break;
+		}
+	}
+
+	// absorbed flashes are still pushed (neutralized) and clean
+	// themselves up on their first Update, ownership stays simple
+	groundFlashes.push_back(flash);
+}
+
+
 void CProjectileHandler::AddFlyingPiece(
 	const S3DModel* model,
 	const S3DModelPiece* piece,
@@ -724,7 +1030,8 @@ void CProjectileHandler::AddNanoParticle(
 		{tColor[0], tColor[1], tColor[2],  tAlpha},
 	};
 
-	projMemPool.alloc<CNanoProjectile>(startPos, dif, int(l), colors[globalRendering->teamNanospray]);
+	nanoParticles.push_back({startPos, dif, gs->frameNum + int(l), colors[globalRendering->teamNanospray]});
+	currentNanoParticles += 1;
 }
 
 void CProjectileHandler::AddNanoParticle(
@@ -762,10 +1069,12 @@ void CProjectileHandler::AddNanoParticle(
 	};
 
 	if (!inverse) {
-		projMemPool.alloc<CNanoProjectile>(startPos, dif * 3.0f, int(len / 3.0f), colors[globalRendering->teamNanospray]);
+		nanoParticles.push_back({startPos, dif * 3.0f, gs->frameNum + int(len / 3.0f), colors[globalRendering->teamNanospray]});
 	} else {
-		projMemPool.alloc<CNanoProjectile>(startPos + dif * len, -dif * 3.0f, int(len / 3.0f), colors[globalRendering->teamNanospray]);
+		nanoParticles.push_back({startPos + dif * len, -dif * 3.0f, gs->frameNum + int(len / 3.0f), colors[globalRendering->teamNanospray]});
 	}
+
+	currentNanoParticles += 1;
 }
 
 
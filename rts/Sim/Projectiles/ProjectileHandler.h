@@ -8,6 +8,7 @@
 
 #include "Rendering/Models/3DModel.h"
 #include "Sim/Projectiles/ProjectileFunctors.h"
+#include "System/Color.h"
 #include "System/float3.h"
 
 // bypass id and event handling for unsynced projectiles (faster)
@@ -22,9 +23,23 @@ struct UnitDef;
 struct FlyingPiece;
 
 
+// plain-struct nano spray particle (unsynced); sprays emitted through
+// AddNanoParticle are stored and updated in bulk instead of occupying
+// pool slots as CNanoProjectile's, and get drawn as a single batch by
+// ProjectileDrawer (CNanoProjectile remains for expgen-spawned cases)
+struct NanoParticle {
+	CR_DECLARE_STRUCT(NanoParticle)
+
+	float3 pos;
+	float3 speed;
+	int deathFrame;
+	SColor color;
+};
+
 typedef std::vector<CProjectile*> ProjectileContainer; // <unsorted>
 typedef std::vector<CGroundFlash*> GroundFlashContainer;
 typedef std::vector<FlyingPiece> FlyingPieceContainer;
+typedef std::vector<NanoParticle> NanoParticleContainer;
 
 
 class CProjectileHandler
@@ -41,6 +56,26 @@ public:
 	CProjectile* GetProjectileBySyncedID(int id);
 	CProjectile* GetProjectileByUnsyncedID(int id);
 
+	// O(1) validated handle lookup; null if <id> was freed (and possibly
+	// reused) since the generation was sampled, so callers holding stale
+	// (id, generation) pairs never see a different projectile
+	CProjectile* GetProjectileBySyncedID(int id, unsigned int gen) {
+		if (GetProjectileGeneration(true, id) != gen)
+			return nullptr;
+
+		return projectileMaps[true][id];
+	}
+
+	// generation counter of a projectile ID slot; bumped every time the
+	// ID is freed, so an (id, generation) pair uniquely names a single
+	// projectile for all time
+	unsigned int GetProjectileGeneration(bool synced, int id) const {
+		if ((size_t)id < projectileGens[synced].size())
+			return projectileGens[synced][id];
+
+		return -1u;
+	}
+
 	void CheckUnitCollisions(CProjectile*, std::vector<CUnit*>&, const float3, const float3);
 	void CheckFeatureCollisions(CProjectile*, std::vector<CFeature*>&, const float3, const float3);
 	void CheckShieldCollisions(CProjectile*, std::vector<CPlasmaRepulser*>&, const float3, const float3);
@@ -64,7 +99,11 @@ public:
 	int GetCurrentParticles() const;
 
 	void AddProjectile(CProjectile* p);
-	void AddGroundFlash(CGroundFlash* flash) { groundFlashes.push_back(flash); }
+	/// pre-grows the container and free-ID pool for <count> projectiles
+	/// at once; bulk-spawners (e.g. salvo weapons) call this so the per
+	/// projectile AddProjectile's never have to grow anything themselves
+	void ReserveProjectiles(bool synced, unsigned int count);
+	void AddGroundFlash(CGroundFlash* flash);
 	void AddFlyingPiece(
 		const S3DModel* model,
 		const S3DModelPiece* piece,
@@ -96,12 +135,16 @@ public:
 
 	// unsynced
 	GroundFlashContainer groundFlashes;
+	NanoParticleContainer nanoParticles;
 
 private:
 	// event-notifiers
 	void CreateProjectile(CProjectile*);
 	void DestroyProjectile(CProjectile*);
 
+	void AllocFreeProjectileIDs(bool synced, size_t minFree);
+
+	void UpdateNanoParticles();
 	void UpdateProjectiles(bool);
 	void UpdateProjectiles() {
 		UpdateProjectiles( true);
@@ -116,6 +159,10 @@ private:
 	// [0] := ID ==> projectile* map for living unsynced projectiles
 	// [1] := ID ==> projectile* map for living   synced projectiles
 	std::vector<CProjectile*> projectileMaps[2];
+
+	// per-slot generation counters parallel to projectileMaps; see
+	// GetProjectileGeneration
+	std::vector<unsigned int> projectileGens[2];
 };
 
 
@@ -93,11 +93,10 @@ CMissileProjectile::CMissileProjectile(const ProjectileParams& params): CWeaponP
 	drawRadius = radius + maxSpeed * 8.0f;
 	castShadow = true;
 
-	CUnit* u = dynamic_cast<CUnit*>(target);
-	if (u == nullptr)
+	if (unitTarget == nullptr)
 		return;
 
-	u->IncomingMissile(this);
+	unitTarget->IncomingMissile(this);
 }
 
 void CMissileProjectile::Collision()
@@ -237,18 +236,14 @@ float3 CMissileProjectile::UpdateTargeting() {
 	if (!weaponDef->tracks || target == nullptr)
 		return targetVel;
 
-	const CSolidObject* so = dynamic_cast<const CSolidObject*>(target);
-	const CUnit* u = nullptr;
-	const CWeaponProjectile* po = nullptr;
-
-	if (so != nullptr) {
+	if (solidTarget != nullptr) {
 		// track aim- or error-position for SolidObject's
-		targetPos = so->aimPos;
-		targetVel = so->speed;
+		targetPos = solidTarget->aimPos;
+		targetVel = solidTarget->speed;
 
 		if (allyteamID != -1 && !ignoreError) {
-			if ((u = dynamic_cast<const CUnit*>(so)) != nullptr)
-				targetPos = u->GetErrorPos(allyteamID, true);
+			if (unitTarget != nullptr)
+				targetPos = unitTarget->GetErrorPos(allyteamID, true);
 		}
 
 		targetPos.y = std::max(targetPos.y, targetPos.y * weaponDef->waterweapon);
@@ -258,10 +253,10 @@ float3 CMissileProjectile::UpdateTargeting() {
 	// track regular target base-position
 	targetPos = target->pos;
 
-	if ((po = dynamic_cast<const CWeaponProjectile*>(target)) == nullptr)
+	if (projTarget == nullptr)
 		return targetVel;
 
-	return po->speed;
+	return projTarget->speed;
 }
 
 void CMissileProjectile::UpdateWobble() {
@@ -159,18 +159,15 @@ void CStarburstProjectile::UpdateTargeting()
 	if (!weaponDef->tracks)
 		return;
 
-	const CSolidObject* so = dynamic_cast<const CSolidObject*>(target);
-	const CUnit* u = nullptr;
-
-	if (so == nullptr) {
+	if (solidTarget == nullptr) {
 		targetPos = target->pos + aimError;
 		return;
 	}
 
-	if (!ignoreError && allyteamID != -1 && (u = dynamic_cast<const CUnit*>(so)) != nullptr)
-		targetPos = u->GetErrorPos(allyteamID, true);
+	if (!ignoreError && allyteamID != -1 && unitTarget != nullptr)
+		targetPos = unitTarget->GetErrorPos(allyteamID, true);
 	else
-		targetPos = so->aimPos;
+		targetPos = solidTarget->aimPos;
 
 	targetPos.y = std::max(targetPos.y, targetPos.y * weaponDef->waterweapon);
 	targetPos += aimError;
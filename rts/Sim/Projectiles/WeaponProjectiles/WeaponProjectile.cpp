@@ -32,6 +32,9 @@ CR_REG_METADATA(CWeaponProjectile,(
 	CR_MEMBER(bounced),
 	CR_MEMBER(weaponDef),
 	CR_MEMBER(target),
+	CR_IGNORED(solidTarget),
+	CR_IGNORED(unitTarget),
+	CR_IGNORED(projTarget),
 	CR_MEMBER(targetPos),
 	CR_MEMBER(startPos),
 	CR_MEMBER(bounceHitPos),
@@ -102,15 +105,14 @@ CWeaponProjectile::CWeaponProjectile(const ProjectileParams& params)
 	}
 
 	{
-		CSolidObject* so = nullptr;
-		CWeaponProjectile* po = nullptr;
+		UpdateTargetCache();
 
-		if ((so = dynamic_cast<CSolidObject*>(target)) != nullptr)
-			AddDeathDependence(so, DEPENDENCE_WEAPONTARGET);
+		if (solidTarget != nullptr)
+			AddDeathDependence(solidTarget, DEPENDENCE_WEAPONTARGET);
 
-		if ((po = dynamic_cast<CWeaponProjectile*>(target)) != nullptr) {
-			po->SetBeingIntercepted(po->IsBeingIntercepted() || weaponDef->interceptSolo);
-			AddDeathDependence(po, DEPENDENCE_INTERCEPTTARGET);
+		if (projTarget != nullptr) {
+			projTarget->SetBeingIntercepted(projTarget->IsBeingIntercepted() || weaponDef->interceptSolo);
+			AddDeathDependence(projTarget, DEPENDENCE_INTERCEPTTARGET);
 		}
 	}
 
@@ -259,12 +261,23 @@ void CWeaponProjectile::Update()
 }
 
 
+// resolves the dynamic type of <target> once; guidance and interception
+// updates run every frame for every live projectile and should not have
+// to repeat these casts there
+void CWeaponProjectile::UpdateTargetCache()
+{
+	solidTarget = dynamic_cast<CSolidObject*>(target);
+	unitTarget = (solidTarget != nullptr)? dynamic_cast<CUnit*>(solidTarget): nullptr;
+	projTarget = (solidTarget == nullptr)? dynamic_cast<CWeaponProjectile*>(target): nullptr;
+}
+
+
 void CWeaponProjectile::UpdateInterception()
 {
 	if (target == nullptr)
 		return;
 
-	CWeaponProjectile* po = dynamic_cast<CWeaponProjectile*>(target);
+	CWeaponProjectile* po = projTarget;
 
 	if (po == nullptr)
 		return;
@@ -364,6 +377,8 @@ void CWeaponProjectile::DependentDied(CObject* o)
 		return;
 
 	target = nullptr;
+
+	UpdateTargetCache();
 }
 
 
@@ -371,4 +386,6 @@ void CWeaponProjectile::PostLoad()
 {
 	assert(weaponDef != nullptr);
 	model = weaponDef->LoadModel();
+
+	UpdateTargetCache();
 }
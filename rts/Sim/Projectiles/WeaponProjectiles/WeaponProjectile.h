@@ -10,6 +10,8 @@
 struct WeaponDef;
 struct ProjectileParams;
 class DynDamageArray;
+class CSolidObject;
+class CUnit;
 
 
 
@@ -42,6 +44,8 @@ public:
 			targetPos = newTarget->pos;
 
 		target = newTarget;
+
+		UpdateTargetCache();
 	}
 
 	const CWorldObject* GetTargetObject() const { return target; }
@@ -68,6 +72,7 @@ public:
 protected:
 	CWeaponProjectile() { }
 	void UpdateInterception();
+	void UpdateTargetCache();
 	virtual void UpdateGroundBounce();
 
 protected:
@@ -75,6 +80,12 @@ protected:
 
 	CWorldObject* target;
 
+	// RTTI-resolved views of <target>, refreshed whenever it is (re)set
+	// so guidance updates never have to dynamic_cast every single frame
+	CSolidObject* solidTarget = nullptr;
+	CUnit* unitTarget = nullptr;
+	CWeaponProjectile* projTarget = nullptr;
+
 	unsigned int weaponNum;
 
 	int ttl;
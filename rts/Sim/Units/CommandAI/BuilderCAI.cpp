@@ -49,6 +49,9 @@ CR_REG_METADATA(CBuilderCAI , (
 	CR_MEMBER(lastPC1),
 	CR_MEMBER(lastPC2),
 	CR_MEMBER(lastPC3),
+
+	CR_MEMBER(lastScanTag),
+	CR_MEMBER(lastScanSum),
 	CR_POSTLOAD(PostLoad)
 ))
 
@@ -90,6 +93,8 @@ CBuilderCAI::CBuilderCAI():
 	lastPC1(-1),
 	lastPC2(-1),
 	lastPC3(-1),
+	lastScanTag(0),
+	lastScanSum(0),
 	range3D(true)
 {}
 
@@ -103,6 +108,8 @@ CBuilderCAI::CBuilderCAI(CUnit* owner):
 	lastPC1(-1),
 	lastPC2(-1),
 	lastPC3(-1),
+	lastScanTag(0),
+	lastScanSum(0),
 	range3D(owner->unitDef->buildRange3D)
 {
 	ownerBuilder = static_cast<CBuilder*>(owner);
@@ -763,7 +770,8 @@ void CBuilderCAI::ExecuteRepair(Command& c)
 		const float radius = c.GetParam(3);
 
 		ownerBuilder->StopBuild();
-		if (FindRepairTargetAndRepair(pos, radius, c.GetOpts(), false, (c.GetOpts() & META_KEY))) {
+		if (AreaScanChanged(c, pos, radius) && FindRepairTargetAndRepair(pos, radius, c.GetOpts(), false, (c.GetOpts() & META_KEY))) {
+			InvalidateAreaScan();
 			inCommand = false;
 			SlowUpdate();
 			return;
@@ -818,7 +826,8 @@ void CBuilderCAI::ExecuteCapture(Command& c)
 
 		ownerBuilder->StopBuild();
 
-		if (FindCaptureTargetAndCapture(pos, radius, c.GetOpts(), (c.GetOpts() & META_KEY))) {
+		if (AreaScanChanged(c, pos, radius) && FindCaptureTargetAndCapture(pos, radius, c.GetOpts(), (c.GetOpts() & META_KEY))) {
+			InvalidateAreaScan();
 			inCommand = false;
 			SlowUpdate();
 			return;
@@ -1070,7 +1079,8 @@ void CBuilderCAI::ExecuteReclaim(Command& c)
 		if (recEnemyOnly) recopt |= REC_ENEMYONLY;
 		if (recSpecial)   recopt |= REC_SPECIAL;
 
-		if (FindReclaimTargetAndReclaim(pos, radius, c.GetOpts(), recopt)) {
+		if (AreaScanChanged(c, pos, radius) && FindReclaimTargetAndReclaim(pos, radius, c.GetOpts(), recopt)) {
+			InvalidateAreaScan();
 			inCommand = false;
 			SlowUpdate();
 			return;
@@ -1143,7 +1153,8 @@ void CBuilderCAI::ExecuteResurrect(Command& c)
 		const float3 pos = c.GetPos(0);
 		const float radius = c.GetParam(3);
 
-		if (FindResurrectableFeatureAndResurrect(pos, radius, c.GetOpts(), (c.GetOpts() & META_KEY))) {
+		if (AreaScanChanged(c, pos, radius) && FindResurrectableFeatureAndResurrect(pos, radius, c.GetOpts(), (c.GetOpts() & META_KEY))) {
+			InvalidateAreaScan();
 			inCommand = false;
 			SlowUpdate();
 			return;
@@ -1589,6 +1600,21 @@ int CBuilderCAI::FindReclaimTarget(const float3& pos, float radius, unsigned cha
 //  Area searches
 //
 
+bool CBuilderCAI::AreaScanChanged(const Command& c, const float3& pos, float radius)
+{
+	const unsigned int scanSum = quadField.GetQuadsChangeSum(pos, radius);
+
+	// nothing entered, left or was damaged inside the circle since the
+	// last scan for this command came up empty, so a rescan would too
+	if (c.GetTag() == lastScanTag && scanSum == lastScanSum)
+		return false;
+
+	lastScanTag = c.GetTag();
+	lastScanSum = scanSum;
+	return true;
+}
+
+
 bool CBuilderCAI::FindReclaimTargetAndReclaim(const float3& pos, float radius, unsigned char cmdopt, ReclaimOption recoptions)
 {
 	const int rid = FindReclaimTarget(pos, radius, cmdopt, recoptions);
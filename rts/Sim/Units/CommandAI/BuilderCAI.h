@@ -109,6 +109,12 @@ private:
 
 	int FindReclaimTarget(const float3& pos, float radius, unsigned char cmdopt, ReclaimOption recoptions, float bestStartDist = 1.0e30f) const;
 
+	/// true unless the area of <c> reports the same QuadField change-sum
+	/// as when its last (unsuccessful) Find*Target scan ran; lets idle
+	/// area commands skip the radius search until something changes
+	bool AreaScanChanged(const Command& c, const float3& pos, float radius);
+	void InvalidateAreaScan() { lastScanTag = 0; }
+
 	float GetBuildRange(const float targetRadius) const;
 	bool MoveInBuildRange(const CWorldObject* obj, const bool checkMoveTypeForFailed = false);
 	bool MoveInBuildRange(const float3& pos, float radius, const bool checkMoveTypeForFailed = false);
@@ -167,6 +173,9 @@ private:
 	int lastPC2;
 	int lastPC3;
 
+	unsigned int lastScanTag; ///< tag of the command whose area scan failed last
+	unsigned int lastScanSum; ///< QuadField change-sum of that scan
+
 	bool range3D;
 };
 
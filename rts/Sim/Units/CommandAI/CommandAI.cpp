@@ -53,7 +53,8 @@ CR_BIND(CCommandQueue, )
 CR_REG_METADATA(CCommandQueue, (
 	CR_MEMBER(queue),
 	CR_MEMBER(queueType),
-	CR_MEMBER(tagCounter)
+	CR_MEMBER(tagCounter),
+	CR_MEMBER(updateCounter)
 ))
 
 CR_BIND_DERIVED(CCommandAI, CObject, )
@@ -88,7 +88,6 @@ public:
 	void DecRef(std::vector<const SCommandDescription*>& cmdDescs);
 	void DecRef(const SCommandDescription& cd);
 
-private:
 	int CalcHash(const SCommandDescription& cd) const;
 
 private:
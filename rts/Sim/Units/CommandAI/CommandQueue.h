@@ -5,6 +5,7 @@
 
 #include <deque>
 #include "Command.h"
+#include "System/MemPoolTypes.h"
 
 /// A wrapper class for std::deque<Command> to keep track of commands
 class CCommandQueue {
@@ -28,7 +29,9 @@ class CCommandQueue {
 		/// limit to a float's integer range
 		static const int maxTagValue = (1 << 24); // 16777216
 
-		typedef std::deque<Command> basis;
+		// pooled allocator: deque node blocks are recycled across all
+		// queues, so queue churn stops allocating once warmed up
+		typedef std::deque<Command, RecyclingAllocator<Command>> basis;
 
 		typedef basis::size_type              size_type;
 		typedef basis::iterator               iterator;
@@ -40,6 +43,10 @@ class CCommandQueue {
 
 		inline size_type size() const { return queue.size(); }
 
+		// bumped on every mutation; lets (unsynced) consumers such as
+		// CommandDrawer detect queue changes without comparing contents
+		inline unsigned int GetUpdateCounter() const { return updateCounter; }
+
 		inline void push_back(const Command& cmd);
 		inline void push_front(const Command& cmd);
 
@@ -47,23 +54,28 @@ class CCommandQueue {
 
 		inline void pop_back()
 		{
+			updateCounter++;
 			queue.pop_back();
 		}
 		inline void pop_front()
 		{
+			updateCounter++;
 			queue.pop_front();
 		}
 
 		inline iterator erase(iterator pos)
 		{
+			updateCounter++;
 			return queue.erase(pos);
 		}
 		inline iterator erase(iterator first, iterator last)
 		{
+			updateCounter++;
 			return queue.erase(first, last);
 		}
 		inline void clear()
 		{
+			updateCounter++;
 			queue.clear();
 		}
 
@@ -89,7 +101,7 @@ class CCommandQueue {
 		inline const Command& operator[](size_type i) const { return queue[i]; }
 
 	private:
-		CCommandQueue() : queueType(CommandQueueType), tagCounter(0) {};
+		CCommandQueue() : queueType(CommandQueueType), tagCounter(0), updateCounter(0) {};
 		CCommandQueue(const CCommandQueue&);
 		CCommandQueue& operator=(const CCommandQueue&);
 
@@ -98,9 +110,10 @@ class CCommandQueue {
 		inline void SetQueueType(QueueType type) { queueType = type; }
 
 	private:
-		std::deque<Command> queue;
+		basis queue;
 		QueueType queueType;
 		int tagCounter;
+		unsigned int updateCounter;
 };
 
 
@@ -116,6 +129,7 @@ inline int CCommandQueue::GetNextTag()
 
 inline void CCommandQueue::push_back(const Command& cmd)
 {
+	updateCounter++;
 	queue.push_back(cmd);
 	queue.back().SetTag(GetNextTag());
 }
@@ -123,6 +137,7 @@ inline void CCommandQueue::push_back(const Command& cmd)
 
 inline void CCommandQueue::push_front(const Command& cmd)
 {
+	updateCounter++;
 	queue.push_front(cmd);
 	queue.front().SetTag(GetNextTag());
 }
@@ -132,6 +147,7 @@ inline CCommandQueue::iterator CCommandQueue::insert(iterator pos, const Command
 {
 	Command tmpCmd = cmd;
 	tmpCmd.SetTag(GetNextTag());
+	updateCounter++;
 	return queue.insert(pos, tmpCmd);
 }
 
@@ -577,14 +577,24 @@ bool CMobileCAI::IsValidTarget(const CUnit* enemy, CWeapon* weapon) const {
 
 	// test if given weapon belonging to owner can target
 	// the enemy unit; indicates an auto-targeting context
-	if (weapon != nullptr)
+	//
+	// category compatibility only depends on the defs, probe the masks
+	// here to reject mismatched weapons before the (virtual, and much
+	// costlier) TestTarget / TryTargetRotate chain runs
+	if (weapon != nullptr) {
+		if ((enemy->category & weapon->onlyTargetCategory) == 0)
+			return false;
+
 		return (weapon->TestTarget(enemy->pos, {enemy}) && (owner->moveState != MOVESTATE_HOLDPOS || weapon->TryTargetRotate(enemy, false, false)));
+	}
 
 	// test if any of owner's weapons can target the enemy unit
 	if (owner->weapons.empty())
 		return false;
 
 	for (CWeapon* w: owner->weapons) {
+		if ((enemy->category & w->onlyTargetCategory) == 0)
+			continue;
 		if (w->TestTarget(enemy->pos, SWeaponTarget(enemy)) && (owner->moveState != MOVESTATE_HOLDPOS || w->TryTargetRotate(enemy, false, false)))
 			return true;
 	}
@@ -1127,7 +1137,7 @@ bool CMobileCAI::GenerateAttackCmd()
 	int newAttackTargetId = -1;
 
 	// pass bogus target-id and weapon-number s.t. script knows context and can set radius
-	if (!eventHandler.AllowWeaponTarget(owner->id, -1, -1, 0, &searchRadius))
+	if (eventHandler.HasAllowWeaponTargetClients() && !eventHandler.AllowWeaponTarget(owner->id, -1, -1, 0, &searchRadius))
 		return false;
 
 	const SWeaponTarget& curTarget = owner->curTarget;
@@ -1141,14 +1151,14 @@ bool CMobileCAI::GenerateAttackCmd()
 		const float maxDistSq = Square(searchRadius);
 
 		if (tgtDistSq < maxDistSq)
-			if (eventHandler.AllowWeaponTarget(owner->id, tgt->id, wpn->weaponNum, wpn->weaponDef->id, nullptr))
+			if (!eventHandler.HasAllowWeaponTargetClients() || eventHandler.AllowWeaponTarget(owner->id, tgt->id, wpn->weaponNum, wpn->weaponDef->id, nullptr))
 				newAttackTargetId = tgt->id;
 	} else {
 		if ((tgt = owner->lastAttacker) != nullptr) {
 			if (owner->pos.SqDistance2D(tgt->pos) < Square(searchRadius)) {
 				const bool allowAttackerChase = !(owner->unitDef->noChaseCategory & tgt->category);
 				const bool  keepAttackingLast = (gs->frameNum < (owner->lastAttackFrame + GAME_SPEED * 7));
-				const bool allowAttackingLast = (allowAttackerChase && keepAttackingLast && eventHandler.AllowWeaponTarget(owner->id, tgt->id, wpn->weaponNum, wpn->weaponDef->id, nullptr));
+				const bool allowAttackingLast = (allowAttackerChase && keepAttackingLast && (!eventHandler.HasAllowWeaponTargetClients() || eventHandler.AllowWeaponTarget(owner->id, tgt->id, wpn->weaponNum, wpn->weaponDef->id, nullptr)));
 
 				if (allowAttackingLast)
 					newAttackTargetId = tgt->id;
@@ -1166,7 +1176,7 @@ bool CMobileCAI::GenerateAttackCmd()
 				// maybe a current target, but invalid type or category etc
 				if (wTgt.type != Target_Unit || !IsValidTarget(wTgt.unit, w))
 					continue;
-				if (!eventHandler.AllowWeaponTarget(owner->id, wTgt.unit->id, w->weaponNum, w->weaponDef->id, nullptr))
+				if (eventHandler.HasAllowWeaponTargetClients() && !eventHandler.AllowWeaponTarget(owner->id, wTgt.unit->id, w->weaponNum, w->weaponDef->id, nullptr))
 					continue;
 
 				newAttackTargetId = wTgt.unit->id;
@@ -1707,7 +1717,7 @@ bool CMobileCAI::SpotIsClearIgnoreSelf(float3 pos, CUnit* unloadee)
 }
 
 
-bool CMobileCAI::FindEmptyDropSpots(float3 startpos, float3 endpos, std::vector<float3>& dropSpots)
+bool CMobileCAI::FindEmptyDropSpots(float3 startpos, float3 endpos, FrameVector<float3>& dropSpots)
 {
 	if (dynamic_cast<CHoverAirMoveType*>(owner->moveType) == nullptr)
 		return false;
@@ -1781,7 +1791,7 @@ void CMobileCAI::UnloadUnits_Drop(Command& c)
 	const float3 startingDropPos = c.GetPos(0);
 	const float3 approachVector = (startingDropPos - owner->pos).Normalize();
 
-	std::vector<float3> dropSpots;
+	FrameVector<float3> dropSpots;
 
 	const bool canUnload = FindEmptyDropSpots(startingDropPos, startingDropPos + approachVector * std::max(16.0f, c.GetParam(3)), dropSpots);
 
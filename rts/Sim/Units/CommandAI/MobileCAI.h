@@ -6,6 +6,7 @@
 #include "CommandAI.h"
 #include "Sim/Misc/GlobalConstants.h" // for SQUARE_SIZE
 #include "System/float3.h"
+#include "System/FrameArena.h"
 
 #include <vector>
 
@@ -64,7 +65,7 @@ public:
 
 	void SetTransportee(CUnit* unit);
 	bool FindEmptySpot(const CUnit* unloadee, const float3& center, float radius, float spread, float3& found, bool fromSynced = true);
-	bool FindEmptyDropSpots(float3 startpos, float3 endpos, std::vector<float3>& dropSpots);
+	bool FindEmptyDropSpots(float3 startpos, float3 endpos, FrameVector<float3>& dropSpots);
 	CUnit* FindUnitToTransport(float3 center, float radius);
 	bool LoadStillValid(CUnit* unit);
 	bool SpotIsClear(float3 pos, CUnit* u);
@@ -3,6 +3,7 @@
 
 #include "Sim/Misc/GlobalConstants.h"
 #include "CobFile.h"
+#include "CobOpcodes.h"
 #include "System/FileSystem/FileHandler.h"
 #include "System/Log/ILog.h"
 #include "System/Sound/ISound.h"
@@ -196,6 +197,214 @@ CCobFile::CCobFile(CFileHandler& in, const std::string& scriptName)
 
 		scriptIndex[pair.second] = fn;
 	}
+
+	OptimizeCode();
+}
+
+
+// number of inline argument words following each opcode; mirrors the
+// GET_LONG_PC calls made per handler in CCobThread::Tick
+static int GetOpcodeNumArgs(int opcode)
+{
+	switch (opcode) {
+		case MOVE: case TURN: case SPIN: case STOP_SPIN:
+		case MOVE_NOW: case TURN_NOW:
+		case WAIT_TURN: case WAIT_MOVE:
+		case START: case CALL: case REAL_CALL: case LUA_CALL:
+			return 2;
+
+		case SHOW: case HIDE: case CACHE: case DONT_CACHE:
+		case SHADE: case DONT_SHADE: case EMIT_SFX:
+		case PUSH_CONSTANT: case PUSH_LOCAL_VAR: case PUSH_STATIC:
+		case POP_LOCAL_VAR: case POP_STATIC:
+		case JUMP: case JUMP_NOT_EQUAL:
+		case EXPLODE: case PLAY_SOUND:
+			return 1;
+
+		case SLEEP: case CREATE_LOCAL_VAR: case POP_STACK:
+		case ADD: case SUB: case MUL: case DIV: case MOD:
+		case BITWISE_AND: case BITWISE_OR: case BITWISE_XOR: case BITWISE_NOT:
+		case RAND: case GET_UNIT_VALUE: case GET:
+		case SET_LESS: case SET_LESS_OR_EQUAL:
+		case SET_GREATER: case SET_GREATER_OR_EQUAL:
+		case SET_EQUAL: case SET_NOT_EQUAL:
+		case LOGICAL_AND: case LOGICAL_OR: case LOGICAL_XOR: case LOGICAL_NOT:
+		case RETURN: case SIGNAL: case SET_SIGNAL_MASK:
+		case SET: case ATTACH: case DROP:
+			return 0;
+
+		default:
+			return -1;
+	}
+}
+
+
+// folds constant expressions at load time so CCobThread never has to
+// re-evaluate them; scripts from ancient compilers are full of these
+//
+// rewrites are strictly in-place so every code address (script entry
+// points, jump targets, return addresses) stays valid: a folded region
+// becomes PUSH_CONSTANT <result> plus a JUMP over its leftover words,
+// which the fold rules guarantee are never entered sideways
+void CCobFile::OptimizeCode()
+{
+	if (code.empty() || scriptOffsets.empty())
+		return;
+
+	std::vector<bool> insnStart(code.size(), false);
+	std::vector<bool> jumpTarget(code.size(), false);
+
+	// map out instruction boundaries and branch targets; bail out on
+	// anything undecodable rather than risk rewriting operand words
+	for (size_t i = 0; i < scriptOffsets.size(); ++i) {
+		const int beg = scriptOffsets[i];
+		const int end = beg + scriptLengths[i];
+
+		if (scriptLengths[i] <= 0)
+			continue;
+		if (beg < 0 || end > int(code.size()))
+			return;
+
+		for (int pc = beg; pc < end; ) {
+			const int numArgs = GetOpcodeNumArgs(code[pc]);
+
+			if (numArgs < 0 || (pc + 1 + numArgs) > end)
+				return;
+
+			insnStart[pc] = true;
+
+			if (code[pc] == JUMP || code[pc] == JUMP_NOT_EQUAL) {
+				const int target = code[pc + 1];
+
+				if (target < 0 || target >= int(code.size()))
+					return;
+
+				jumpTarget[target] = true;
+			}
+
+			pc += (1 + numArgs);
+		}
+	}
+
+	// every branch must land on an instruction boundary
+	for (size_t i = 0; i < code.size(); ++i) {
+		if (jumpTarget[i] && !insnStart[i])
+			return;
+	}
+
+	// tracked run of adjacent constant pushes; <pc> is where the run of
+	// instructions producing the value starts
+	struct ConstVal {
+		int value;
+		int pc;
+	};
+
+	std::vector<ConstVal> constStack;
+	constStack.reserve(16);
+
+	for (size_t i = 0; i < scriptOffsets.size(); ++i) {
+		const int beg = scriptOffsets[i];
+		const int end = beg + scriptLengths[i];
+
+		constStack.clear();
+
+		for (int pc = beg; pc < end; ) {
+			const int opcode = code[pc];
+			const int numArgs = GetOpcodeNumArgs(opcode);
+			const int nextPC = pc + 1 + numArgs;
+
+			// control can enter here with unknown stack contents, and no
+			// fold region may span a branch target
+			if (jumpTarget[pc])
+				constStack.clear();
+
+			bool folded = false;
+			int value = 0;
+
+			switch (opcode) {
+				case PUSH_CONSTANT: {
+					constStack.push_back({code[pc + 1], pc});
+					pc = nextPC;
+					continue;
+				} break;
+
+				// binary operators; evaluation matches the handlers in
+				// CCobThread::Tick exactly (a is the deeper operand)
+				case ADD: case SUB: case MUL: case DIV: case MOD:
+				case BITWISE_AND: case BITWISE_OR: case BITWISE_XOR:
+				case SET_LESS: case SET_LESS_OR_EQUAL:
+				case SET_GREATER: case SET_GREATER_OR_EQUAL:
+				case SET_EQUAL: case SET_NOT_EQUAL:
+				case LOGICAL_AND: case LOGICAL_OR: case LOGICAL_XOR: {
+					if (constStack.size() < 2)
+						break;
+
+					const int a = constStack[constStack.size() - 2].value;
+					const int b = constStack[constStack.size() - 1].value;
+
+					folded = true;
+
+					switch (opcode) {
+						case ADD: { value = a + b; } break;
+						case SUB: { value = a - b; } break;
+						case MUL: { value = a * b; } break;
+						// preserve the runtime error for constant zero divisors
+						case DIV: { if (b != 0) { value = a / b; } else { folded = false; } } break;
+						case MOD: { if (b != 0) { value = a % b; } else { folded = false; } } break;
+						case BITWISE_AND: { value = a & b; } break;
+						case BITWISE_OR : { value = a | b; } break;
+						case BITWISE_XOR: { value = a ^ b; } break;
+						case SET_LESS            : { value = int(a <  b); } break;
+						case SET_LESS_OR_EQUAL   : { value = int(a <= b); } break;
+						case SET_GREATER         : { value = int(a >  b); } break;
+						case SET_GREATER_OR_EQUAL: { value = int(a >= b); } break;
+						case SET_EQUAL           : { value = int(a == b); } break;
+						case SET_NOT_EQUAL       : { value = int(a != b); } break;
+						case LOGICAL_AND: { value = int(a && b); } break;
+						case LOGICAL_OR : { value = int(a || b); } break;
+						case LOGICAL_XOR: { value = int((!!a) ^ (!!b)); } break;
+					}
+
+					if (folded)
+						constStack.pop_back();
+				} break;
+
+				case BITWISE_NOT: case LOGICAL_NOT: {
+					if (constStack.empty())
+						break;
+
+					const int a = constStack.back().value;
+
+					folded = true;
+					value = (opcode == BITWISE_NOT)? ~a: int(a == 0);
+				} break;
+
+				default: {
+				} break;
+			}
+
+			if (!folded) {
+				// unhandled instruction, stack contents no longer constant
+				constStack.clear();
+				pc = nextPC;
+				continue;
+			}
+
+			ConstVal& cv = constStack.back();
+			cv.value = value;
+
+			// a plain PUSH_CONSTANT plus unary operator (three words) is
+			// too short to rewrite, just keep tracking its value
+			if ((nextPC - cv.pc) >= 4) {
+				code[cv.pc + 0] = PUSH_CONSTANT;
+				code[cv.pc + 1] = value;
+				code[cv.pc + 2] = JUMP;
+				code[cv.pc + 3] = nextPC;
+			}
+
+			pc = nextPC;
+		}
+	}
 }
 
 
@@ -39,6 +39,9 @@ public:
 
 	int GetFunctionId(const std::string& name);
 
+private:
+	void OptimizeCode();
+
 public:
 	int numStaticVars = 0;
 
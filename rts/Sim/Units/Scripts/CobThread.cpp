@@ -3,6 +3,7 @@
 
 #include "CobThread.h"
 #include "CobFile.h"
+#include "CobOpcodes.h"
 #include "CobInstance.h"
 #include "CobEngine.h"
 #include "Sim/Misc/GlobalConstants.h"
@@ -198,85 +199,8 @@ void CCobThread::InitStack(unsigned int n, CCobThread* t)
 
 
 
-// Command documentation from http://visualta.tauniverse.com/Downloads/cob-commands.txt
-// And some information from basm0.8 source (basm ops.txt)
-
-// Model interaction
-constexpr int MOVE       = 0x10001000;
-constexpr int TURN       = 0x10002000;
-constexpr int SPIN       = 0x10003000;
-constexpr int STOP_SPIN  = 0x10004000;
-constexpr int SHOW       = 0x10005000;
-constexpr int HIDE       = 0x10006000;
-constexpr int CACHE      = 0x10007000;
-constexpr int DONT_CACHE = 0x10008000;
-constexpr int MOVE_NOW   = 0x1000B000;
-constexpr int TURN_NOW   = 0x1000C000;
-constexpr int SHADE      = 0x1000D000;
-constexpr int DONT_SHADE = 0x1000E000;
-constexpr int EMIT_SFX   = 0x1000F000;
-
-// Blocking operations
-constexpr int WAIT_TURN  = 0x10011000;
-constexpr int WAIT_MOVE  = 0x10012000;
-constexpr int SLEEP      = 0x10013000;
-
-// Stack manipulation
-constexpr int PUSH_CONSTANT    = 0x10021001;
-constexpr int PUSH_LOCAL_VAR   = 0x10021002;
-constexpr int PUSH_STATIC      = 0x10021004;
-constexpr int CREATE_LOCAL_VAR = 0x10022000;
-constexpr int POP_LOCAL_VAR    = 0x10023002;
-constexpr int POP_STATIC       = 0x10023004;
-constexpr int POP_STACK        = 0x10024000; ///< Not sure what this is supposed to do
-
-// Arithmetic operations
-constexpr int ADD         = 0x10031000;
-constexpr int SUB         = 0x10032000;
-constexpr int MUL         = 0x10033000;
-constexpr int DIV         = 0x10034000;
-constexpr int MOD		  = 0x10034001; ///< spring specific
-constexpr int BITWISE_AND = 0x10035000;
-constexpr int BITWISE_OR  = 0x10036000;
-constexpr int BITWISE_XOR = 0x10037000;
-constexpr int BITWISE_NOT = 0x10038000;
-
-// Native function calls
-constexpr int RAND           = 0x10041000;
-constexpr int GET_UNIT_VALUE = 0x10042000;
-constexpr int GET            = 0x10043000;
-
-// Comparison
-constexpr int SET_LESS             = 0x10051000;
-constexpr int SET_LESS_OR_EQUAL    = 0x10052000;
-constexpr int SET_GREATER          = 0x10053000;
-constexpr int SET_GREATER_OR_EQUAL = 0x10054000;
-constexpr int SET_EQUAL            = 0x10055000;
-constexpr int SET_NOT_EQUAL        = 0x10056000;
-constexpr int LOGICAL_AND          = 0x10057000;
-constexpr int LOGICAL_OR           = 0x10058000;
-constexpr int LOGICAL_XOR          = 0x10059000;
-constexpr int LOGICAL_NOT          = 0x1005A000;
-
-// Flow control
-constexpr int START           = 0x10061000;
-constexpr int CALL            = 0x10062000; ///< converted when executed
-constexpr int REAL_CALL       = 0x10062001; ///< spring custom
-constexpr int LUA_CALL        = 0x10062002; ///< spring custom
-constexpr int JUMP            = 0x10064000;
-constexpr int RETURN          = 0x10065000;
-constexpr int JUMP_NOT_EQUAL  = 0x10066000;
-constexpr int SIGNAL          = 0x10067000;
-constexpr int SET_SIGNAL_MASK = 0x10068000;
-
-// Piece destruction
-constexpr int EXPLODE    = 0x10071000;
-constexpr int PLAY_SOUND = 0x10072000;
-
-// Special functions
-constexpr int SET    = 0x10082000;
-constexpr int ATTACH = 0x10083000;
-constexpr int DROP   = 0x10084000;
+// opcode constants live in CobOpcodes.h, shared with the
+// load-time bytecode optimizer in CobFile.cpp
 
 // Indices for SET, GET, and GET_UNIT_VALUE for LUA return values
 #define LUA0 110 // (LUA0 returns the lua call status, 0 or 1)
@@ -298,6 +222,46 @@ constexpr int DROP   = 0x10084000;
 #endif
 
 
+// token-threaded dispatch for the interpreter loop in Tick; computed
+// gotos are a GNU extension, other compilers get the plain switch
+#ifndef COB_TOKEN_DISPATCH
+	#ifdef __GNUC__
+	#define COB_TOKEN_DISPATCH 1
+	#else
+	#define COB_TOKEN_DISPATCH 0
+	#endif
+#endif
+
+#if (COB_TOKEN_DISPATCH == 1)
+// dense token from the sparse opcode constants above; bits 12-19 plus
+// the low nibble (which separates the DIV/MOD, CALL and PUSH/POP
+// variants) uniquely identify every opcode
+#define COB_TOKEN(op) ((((op) & 0x000FF000) >> 8) | ((op) & 0x0000000F))
+// every known opcode matches this pattern; pattern-valid but unknown
+// opcodes produce tokens < COB_NUM_TOKENS and land on the default
+// handler through the jump-table fill
+#define COB_OPCODE_MASK 0xFFF00FF0
+#define COB_OPCODE_BASE 0x10000000
+#define COB_NUM_TOKENS 0x1000
+
+#define COB_CASE(op) lbl_##op
+#define COB_DEFAULT() lbl_DEFAULT
+#define COB_BREAK()                                              \
+	do {                                                         \
+		if (state != Run)                                        \
+			goto lbl_EXIT;                                       \
+		opcode = GET_LONG_PC();                                  \
+		if ((opcode & COB_OPCODE_MASK) != COB_OPCODE_BASE)       \
+			goto lbl_DEFAULT;                                    \
+		goto *tokenJumpTable[COB_TOKEN(opcode)];                 \
+	} while (false)
+#else
+#define COB_CASE(op) case op
+#define COB_DEFAULT() default
+#define COB_BREAK() break
+#endif
+
+
 #if 0
 static const char* GetOpcodeName(int opcode)
 {
@@ -388,37 +352,115 @@ bool CCobThread::Tick()
 
 	int r1, r2, r3, r4, r5, r6;
 
+	#if (COB_TOKEN_DISPATCH == 1)
+	int opcode = 0;
+
+	static const void* tokenJumpTable[COB_NUM_TOKENS] = {nullptr};
+
+	if (tokenJumpTable[0] == nullptr) {
+		for (const void*& entry: tokenJumpTable) {
+			entry = &&lbl_DEFAULT;
+		}
+
+		#define COB_SET_TOKEN(op) tokenJumpTable[COB_TOKEN(op)] = &&lbl_##op
+		COB_SET_TOKEN(MOVE);
+		COB_SET_TOKEN(TURN);
+		COB_SET_TOKEN(SPIN);
+		COB_SET_TOKEN(STOP_SPIN);
+		COB_SET_TOKEN(SHOW);
+		COB_SET_TOKEN(HIDE);
+		COB_SET_TOKEN(CACHE);
+		COB_SET_TOKEN(DONT_CACHE);
+		COB_SET_TOKEN(MOVE_NOW);
+		COB_SET_TOKEN(TURN_NOW);
+		COB_SET_TOKEN(SHADE);
+		COB_SET_TOKEN(DONT_SHADE);
+		COB_SET_TOKEN(EMIT_SFX);
+		COB_SET_TOKEN(WAIT_TURN);
+		COB_SET_TOKEN(WAIT_MOVE);
+		COB_SET_TOKEN(SLEEP);
+		COB_SET_TOKEN(PUSH_CONSTANT);
+		COB_SET_TOKEN(PUSH_LOCAL_VAR);
+		COB_SET_TOKEN(PUSH_STATIC);
+		COB_SET_TOKEN(CREATE_LOCAL_VAR);
+		COB_SET_TOKEN(POP_LOCAL_VAR);
+		COB_SET_TOKEN(POP_STATIC);
+		COB_SET_TOKEN(POP_STACK);
+		COB_SET_TOKEN(ADD);
+		COB_SET_TOKEN(SUB);
+		COB_SET_TOKEN(MUL);
+		COB_SET_TOKEN(DIV);
+		COB_SET_TOKEN(MOD);
+		COB_SET_TOKEN(BITWISE_AND);
+		COB_SET_TOKEN(BITWISE_OR);
+		COB_SET_TOKEN(BITWISE_XOR);
+		COB_SET_TOKEN(BITWISE_NOT);
+		COB_SET_TOKEN(RAND);
+		COB_SET_TOKEN(GET_UNIT_VALUE);
+		COB_SET_TOKEN(GET);
+		COB_SET_TOKEN(SET_LESS);
+		COB_SET_TOKEN(SET_LESS_OR_EQUAL);
+		COB_SET_TOKEN(SET_GREATER);
+		COB_SET_TOKEN(SET_GREATER_OR_EQUAL);
+		COB_SET_TOKEN(SET_EQUAL);
+		COB_SET_TOKEN(SET_NOT_EQUAL);
+		COB_SET_TOKEN(LOGICAL_AND);
+		COB_SET_TOKEN(LOGICAL_OR);
+		COB_SET_TOKEN(LOGICAL_XOR);
+		COB_SET_TOKEN(LOGICAL_NOT);
+		COB_SET_TOKEN(START);
+		COB_SET_TOKEN(CALL);
+		COB_SET_TOKEN(REAL_CALL);
+		COB_SET_TOKEN(LUA_CALL);
+		COB_SET_TOKEN(JUMP);
+		COB_SET_TOKEN(RETURN);
+		COB_SET_TOKEN(JUMP_NOT_EQUAL);
+		COB_SET_TOKEN(SIGNAL);
+		COB_SET_TOKEN(SET_SIGNAL_MASK);
+		COB_SET_TOKEN(EXPLODE);
+		COB_SET_TOKEN(PLAY_SOUND);
+		COB_SET_TOKEN(SET);
+		COB_SET_TOKEN(ATTACH);
+		COB_SET_TOKEN(DROP);
+		#undef COB_SET_TOKEN
+	}
+
+	// jump to the first handler; every handler then re-dispatches
+	// through COB_BREAK until the thread leaves the Run state
+	COB_BREAK();
+	#else
 	while (state == Run) {
 		const int opcode = GET_LONG_PC();
 
 		switch (opcode) {
-			case PUSH_CONSTANT: {
+	#endif
+			COB_CASE(PUSH_CONSTANT): {
 				r1 = GET_LONG_PC();
 				PushDataStack(r1);
-			} break;
-			case SLEEP: {
+			} COB_BREAK();
+			COB_CASE(SLEEP): {
 				r1 = PopDataStack();
 				wakeTime = cobEngine->GetCurrentTime() + r1;
 				state = Sleep;
 
 				cobEngine->ScheduleThread(this);
 				return true;
-			} break;
-			case SPIN: {
+			} COB_BREAK();
+			COB_CASE(SPIN): {
 				r1 = GET_LONG_PC();
 				r2 = GET_LONG_PC();
 				r3 = PopDataStack();         // speed
 				r4 = PopDataStack();         // accel
 				cobInst->Spin(r1, r2, r3, r4);
-			} break;
-			case STOP_SPIN: {
+			} COB_BREAK();
+			COB_CASE(STOP_SPIN): {
 				r1 = GET_LONG_PC();
 				r2 = GET_LONG_PC();
 				r3 = PopDataStack();         // decel
 
 				cobInst->StopSpin(r1, r2, r3);
-			} break;
-			case RETURN: {
+			} COB_BREAK();
+			COB_CASE(RETURN): {
 				retCode = PopDataStack();
 
 				if (LocalReturnAddr() == -1) {
@@ -433,44 +475,44 @@ bool CCobThread::Tick()
 				pc = LocalReturnAddr();
 				dataStackSize = std::min(dataStackSize, LocalStackFrame());
 				callStackSize -= 1;
-			} break;
+			} COB_BREAK();
 
 
-			case SHADE: {
+			COB_CASE(SHADE): {
 				r1 = GET_LONG_PC();
-			} break;
-			case DONT_SHADE: {
+			} COB_BREAK();
+			COB_CASE(DONT_SHADE): {
 				r1 = GET_LONG_PC();
-			} break;
-			case CACHE: {
+			} COB_BREAK();
+			COB_CASE(CACHE): {
 				r1 = GET_LONG_PC();
-			} break;
-			case DONT_CACHE: {
+			} COB_BREAK();
+			COB_CASE(DONT_CACHE): {
 				r1 = GET_LONG_PC();
-			} break;
+			} COB_BREAK();
 
 
-			case CALL: {
+			COB_CASE(CALL): {
 				r1 = GET_LONG_PC();
 				pc--;
 
 				if (cobFile->scriptNames[r1].find("lua_") == 0) {
 					cobFile->code[pc - 1] = LUA_CALL;
 					LuaCall();
-					break;
+					COB_BREAK();
 				}
 
 				cobFile->code[pc - 1] = REAL_CALL;
 
 				// fall-through
 			}
-			case REAL_CALL: {
+			COB_CASE(REAL_CALL): {
 				r1 = GET_LONG_PC();
 				r2 = GET_LONG_PC();
 
 				// do not call zero-length functions
 				if (cobFile->scriptLengths[r1] == 0)
-					break;
+					COB_BREAK();
 
 				CallInfo& ci = PushCallStackRef();
 				ci.functionId = r1;
@@ -481,30 +523,30 @@ bool CCobThread::Tick()
 
 				// call cobFile->scriptNames[r1]
 				pc = cobFile->scriptOffsets[r1];
-			} break;
-			case LUA_CALL: {
+			} COB_BREAK();
+			COB_CASE(LUA_CALL): {
 				LuaCall();
-			} break;
+			} COB_BREAK();
 
 
-			case POP_STATIC: {
+			COB_CASE(POP_STATIC): {
 				r1 = GET_LONG_PC();
 				r2 = PopDataStack();
 
 				if (static_cast<size_t>(r1) < cobInst->staticVars.size())
 					cobInst->staticVars[r1] = r2;
-			} break;
-			case POP_STACK: {
+			} COB_BREAK();
+			COB_CASE(POP_STACK): {
 				PopDataStack();
-			} break;
+			} COB_BREAK();
 
 
-			case START: {
+			COB_CASE(START): {
 				r1 = GET_LONG_PC();
 				r2 = GET_LONG_PC();
 
 				if (cobFile->scriptLengths[r1] == 0)
-					break;
+					COB_BREAK();
 
 
 				CCobThread t(cobInst);
@@ -515,169 +557,169 @@ bool CCobThread::Tick()
 
 				// calling AddThread directly might move <this>, defer it
 				cobEngine->QueueAddThread(std::move(t));
-			} break;
+			} COB_BREAK();
 
-			case CREATE_LOCAL_VAR: {
+			COB_CASE(CREATE_LOCAL_VAR): {
 				if (paramCount == 0) {
 					PushDataStack(0);
 				} else {
 					paramCount--;
 				}
-			} break;
-			case GET_UNIT_VALUE: {
+			} COB_BREAK();
+			COB_CASE(GET_UNIT_VALUE): {
 				r1 = PopDataStack();
 				if ((r1 >= LUA0) && (r1 <= LUA9)) {
 					PushDataStack(luaArgs[r1 - LUA0]);
-					break;
+					COB_BREAK();
 				}
 				r1 = cobInst->GetUnitVal(r1, 0, 0, 0, 0);
 				PushDataStack(r1);
-			} break;
+			} COB_BREAK();
 
 
-			case JUMP_NOT_EQUAL: {
+			COB_CASE(JUMP_NOT_EQUAL): {
 				r1 = GET_LONG_PC();
 				r2 = PopDataStack();
 
 				if (r2 == 0)
 					pc = r1;
 
-			} break;
-			case JUMP: {
+			} COB_BREAK();
+			COB_CASE(JUMP): {
 				r1 = GET_LONG_PC();
 				// this seem to be an error in the docs..
 				//r2 = cobFile->scriptOffsets[LocalFunctionID()] + r1;
 				pc = r1;
-			} break;
+			} COB_BREAK();
 
 
-			case POP_LOCAL_VAR: {
+			COB_CASE(POP_LOCAL_VAR): {
 				r1 = GET_LONG_PC();
 				r2 = PopDataStack();
 				dataStack[LocalStackFrame() + r1] = r2;
-			} break;
-			case PUSH_LOCAL_VAR: {
+			} COB_BREAK();
+			COB_CASE(PUSH_LOCAL_VAR): {
 				r1 = GET_LONG_PC();
 				r2 = dataStack[LocalStackFrame() + r1];
 				PushDataStack(r2);
-			} break;
+			} COB_BREAK();
 
 
-			case BITWISE_AND: {
+			COB_CASE(BITWISE_AND): {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 				PushDataStack(r1 & r2);
-			} break;
-			case BITWISE_OR: {
+			} COB_BREAK();
+			COB_CASE(BITWISE_OR): {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 				PushDataStack(r1 | r2);
-			} break;
-			case BITWISE_XOR: {
+			} COB_BREAK();
+			COB_CASE(BITWISE_XOR): {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 				PushDataStack(r1 ^ r2);
-			} break;
-			case BITWISE_NOT: {
+			} COB_BREAK();
+			COB_CASE(BITWISE_NOT): {
 				r1 = PopDataStack();
 				PushDataStack(~r1);
-			} break;
+			} COB_BREAK();
 
-			case EXPLODE: {
+			COB_CASE(EXPLODE): {
 				r1 = GET_LONG_PC();
 				r2 = PopDataStack();
 				cobInst->Explode(r1, r2);
-			} break;
+			} COB_BREAK();
 
-			case PLAY_SOUND: {
+			COB_CASE(PLAY_SOUND): {
 				r1 = GET_LONG_PC();
 				r2 = PopDataStack();
 				cobInst->PlayUnitSound(r1, r2);
-			} break;
+			} COB_BREAK();
 
-			case PUSH_STATIC: {
+			COB_CASE(PUSH_STATIC): {
 				r1 = GET_LONG_PC();
 
 				if (static_cast<size_t>(r1) < cobInst->staticVars.size())
 					PushDataStack(cobInst->staticVars[r1]);
-			} break;
+			} COB_BREAK();
 
-			case SET_NOT_EQUAL: {
+			COB_CASE(SET_NOT_EQUAL): {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 
 				PushDataStack(int(r1 != r2));
-			} break;
-			case SET_EQUAL: {
+			} COB_BREAK();
+			COB_CASE(SET_EQUAL): {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 
 				PushDataStack(int(r1 == r2));
-			} break;
+			} COB_BREAK();
 
-			case SET_LESS: {
+			COB_CASE(SET_LESS): {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 
 				PushDataStack(int(r1 < r2));
-			} break;
-			case SET_LESS_OR_EQUAL: {
+			} COB_BREAK();
+			COB_CASE(SET_LESS_OR_EQUAL): {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 
 				PushDataStack(int(r1 <= r2));
-			} break;
+			} COB_BREAK();
 
-			case SET_GREATER: {
+			COB_CASE(SET_GREATER): {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 
 				PushDataStack(int(r1 > r2));
-			} break;
-			case SET_GREATER_OR_EQUAL: {
+			} COB_BREAK();
+			COB_CASE(SET_GREATER_OR_EQUAL): {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 
 				PushDataStack(int(r1 >= r2));
-			} break;
+			} COB_BREAK();
 
-			case RAND: {
+			COB_CASE(RAND): {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 				r3 = gsRNG.NextInt(r2 - r1 + 1) + r1;
 				PushDataStack(r3);
-			} break;
-			case EMIT_SFX: {
+			} COB_BREAK();
+			COB_CASE(EMIT_SFX): {
 				r1 = PopDataStack();
 				r2 = GET_LONG_PC();
 				cobInst->EmitSfx(r1, r2);
-			} break;
-			case MUL: {
+			} COB_BREAK();
+			COB_CASE(MUL): {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 				PushDataStack(r1 * r2);
-			} break;
+			} COB_BREAK();
 
 
-			case SIGNAL: {
+			COB_CASE(SIGNAL): {
 				r1 = PopDataStack();
 				cobInst->Signal(r1);
-			} break;
-			case SET_SIGNAL_MASK: {
+			} COB_BREAK();
+			COB_CASE(SET_SIGNAL_MASK): {
 				r1 = PopDataStack();
 				signalMask = r1;
-			} break;
+			} COB_BREAK();
 
 
-			case TURN: {
+			COB_CASE(TURN): {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 				r3 = GET_LONG_PC(); // piece
 				r4 = GET_LONG_PC(); // axis
 
 				cobInst->Turn(r3, r4, r1, r2);
-			} break;
-			case GET: {
+			} COB_BREAK();
+			COB_CASE(GET): {
 				r5 = PopDataStack();
 				r4 = PopDataStack();
 				r3 = PopDataStack();
@@ -685,24 +727,24 @@ bool CCobThread::Tick()
 				r1 = PopDataStack();
 				if ((r1 >= LUA0) && (r1 <= LUA9)) {
 					PushDataStack(luaArgs[r1 - LUA0]);
-					break;
+					COB_BREAK();
 				}
 				r6 = cobInst->GetUnitVal(r1, r2, r3, r4, r5);
 				PushDataStack(r6);
-			} break;
-			case ADD: {
+			} COB_BREAK();
+			COB_CASE(ADD): {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 				PushDataStack(r1 + r2);
-			} break;
-			case SUB: {
+			} COB_BREAK();
+			COB_CASE(SUB): {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 				r3 = r1 - r2;
 				PushDataStack(r3);
-			} break;
+			} COB_BREAK();
 
-			case DIV: {
+			COB_CASE(DIV): {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 
@@ -713,8 +755,8 @@ bool CCobThread::Tick()
 					ShowError("division by zero");
 				}
 				PushDataStack(r3);
-			} break;
-			case MOD: {
+			} COB_BREAK();
+			COB_CASE(MOD): {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 
@@ -724,31 +766,31 @@ bool CCobThread::Tick()
 					PushDataStack(0);
 					ShowError("modulo division by zero");
 				}
-			} break;
+			} COB_BREAK();
 
 
-			case MOVE: {
+			COB_CASE(MOVE): {
 				r1 = GET_LONG_PC();
 				r2 = GET_LONG_PC();
 				r4 = PopDataStack();
 				r3 = PopDataStack();
 				cobInst->Move(r1, r2, r3, r4);
-			} break;
-			case MOVE_NOW: {
+			} COB_BREAK();
+			COB_CASE(MOVE_NOW): {
 				r1 = GET_LONG_PC();
 				r2 = GET_LONG_PC();
 				r3 = PopDataStack();
 				cobInst->MoveNow(r1, r2, r3);
-			} break;
-			case TURN_NOW: {
+			} COB_BREAK();
+			COB_CASE(TURN_NOW): {
 				r1 = GET_LONG_PC();
 				r2 = GET_LONG_PC();
 				r3 = PopDataStack();
 				cobInst->TurnNow(r1, r2, r3);
-			} break;
+			} COB_BREAK();
 
 
-			case WAIT_TURN: {
+			COB_CASE(WAIT_TURN): {
 				r1 = GET_LONG_PC();
 				r2 = GET_LONG_PC();
 
@@ -758,8 +800,8 @@ bool CCobThread::Tick()
 					waitAxis = r2;
 					return true;
 				}
-			} break;
-			case WAIT_MOVE: {
+			} COB_BREAK();
+			COB_CASE(WAIT_MOVE): {
 				r1 = GET_LONG_PC();
 				r2 = GET_LONG_PC();
 
@@ -769,64 +811,65 @@ bool CCobThread::Tick()
 					waitAxis = r2;
 					return true;
 				}
-			} break;
+			} COB_BREAK();
 
 
-			case SET: {
+			COB_CASE(SET): {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 
 				if ((r1 >= LUA0) && (r1 <= LUA9)) {
 					luaArgs[r1 - LUA0] = r2;
-					break;
+					COB_BREAK();
 				}
 
 				cobInst->SetUnitVal(r1, r2);
-			} break;
+			} COB_BREAK();
 
 
-			case ATTACH: {
+			COB_CASE(ATTACH): {
 				r3 = PopDataStack();
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 				cobInst->AttachUnit(r2, r1);
-			} break;
-			case DROP: {
+			} COB_BREAK();
+			COB_CASE(DROP): {
 				r1 = PopDataStack();
 				cobInst->DropUnit(r1);
-			} break;
+			} COB_BREAK();
 
 			// like bitwise ops, but only on values 1 and 0
-			case LOGICAL_NOT: {
+			COB_CASE(LOGICAL_NOT): {
 				r1 = PopDataStack();
 				PushDataStack(int(r1 == 0));
-			} break;
-			case LOGICAL_AND: {
+			} COB_BREAK();
+			COB_CASE(LOGICAL_AND): {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 				PushDataStack(int(r1 && r2));
-			} break;
-			case LOGICAL_OR: {
+			} COB_BREAK();
+			COB_CASE(LOGICAL_OR): {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 				PushDataStack(int(r1 || r2));
-			} break;
-			case LOGICAL_XOR: {
+			} COB_BREAK();
+			COB_CASE(LOGICAL_XOR): {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 				PushDataStack(int((!!r1) ^ (!!r2)));
-			} break;
+			} COB_BREAK();
 
 
-			case HIDE: {
+			COB_CASE(HIDE): {
 				r1 = GET_LONG_PC();
 				cobInst->SetVisibility(r1, false);
-			} break;
+			} COB_BREAK();
 
-			case SHOW: {
+			COB_CASE(SHOW): {
 				r1 = GET_LONG_PC();
 
 				int i;
+				// NB: plain break, COB_BREAK() would re-dispatch mid-loop
 				for (i = 0; i < MAX_WEAPONS_PER_UNIT; ++i)
 					if (LocalFunctionID() == cobFile->scriptIndex[COBFN_FirePrimary + COBFN_Weapon_Funcs * i])
 						break;
@@ -837,9 +880,9 @@ bool CCobThread::Tick()
 				} else {
 					cobInst->SetVisibility(r1, true);
 				}
-			} break;
+			} COB_BREAK();
 
-			default: {
+			COB_DEFAULT(): {
 				const char* name = cobFile->name.c_str();
 				const char* func = cobFile->scriptNames[LocalFunctionID()].c_str();
 
@@ -855,9 +898,14 @@ bool CCobThread::Tick()
 
 				state = Dead;
 				return false;
-			} break;
+			} COB_BREAK();
+
+	#if (COB_TOKEN_DISPATCH == 0)
 		}
 	}
+	#else
+	lbl_EXIT:
+	#endif
 
 	// can arrive here as dead, through CCobInstance::Signal()
 	return (state != Dead);
@@ -47,6 +47,8 @@ void CLuaUnitScriptNames::InitScriptNames()
 
 	scriptNames[LUAFN_MoveFinished] = "MoveFinished";
 	scriptNames[LUAFN_TurnFinished] = "TurnFinished";
+	scriptNames[LUAFN_MovesFinished] = "MovesFinished";
+	scriptNames[LUAFN_TurnsFinished] = "TurnsFinished";
 
 	// Also add the weapon aiming stuff
 	scriptNames[LUAFN_QueryWeapon]   = "QueryWeapon";
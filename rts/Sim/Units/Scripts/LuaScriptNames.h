@@ -43,6 +43,8 @@ enum {
 	LUAFN_QueryBuildInfo,       // ( ) -> number piece
 	LUAFN_MoveFinished,         // ( piece, axis ) -> nil
 	LUAFN_TurnFinished,         // ( piece, axis ) -> nil
+	LUAFN_MovesFinished,        // ( pieces, axes ) -> nil; batched, tables are parallel arrays
+	LUAFN_TurnsFinished,        // ( pieces, axes ) -> nil; batched, tables are parallel arrays
 
 	// Weapon functions
 	LUAFN_QueryWeapon,   // ( ) -> number piece
@@ -146,6 +146,14 @@ MoveFinished(number piece, number axis)
 	Should resume coroutine of the particular thread which called the Lua
 	WaitForMove function (see below).
 
+TurnsFinished(table pieces, table axes)
+MovesFinished(table pieces, table axes)
+	Batched variants of TurnFinished/MoveFinished; if defined, they are
+	called once per sim frame with two parallel arrays holding every
+	piece/axis pair whose turn (resp. move) finished that frame, instead
+	of one TurnFinished/MoveFinished call per pair. Scripts with heavy
+	per-piece animation should prefer these to cut call overhead.
+
 
 docs for callouts defined in this file:
 
@@ -868,6 +876,40 @@ void CLuaUnitScript::AnimFinished(AnimType type, int piece, int axis)
 }
 
 
+void CLuaUnitScript::AnimsFinished(AnimType type, const AnimContainerType& doneAnims)
+{
+	const int fn = (type == AMove)? LUAFN_MovesFinished : LUAFN_TurnsFinished;
+
+	if (!HasFunction(fn)) {
+		// script defines only the per-event callins
+		CUnitScript::AnimsFinished(type, doneAnims);
+		return;
+	}
+
+	LUA_CALL_IN_CHECK(L);
+	lua_checkstack(L, 5);
+
+	PushFunction(fn);
+
+	// two parallel arrays, {pieces} and {axes}
+	lua_createtable(L, int(doneAnims.size()), 0);
+
+	for (size_t i = 0; i < doneAnims.size(); i++) {
+		lua_pushnumber(L, doneAnims[i].piece + 1);
+		lua_rawseti(L, -2, i + 1);
+	}
+
+	lua_createtable(L, int(doneAnims.size()), 0);
+
+	for (size_t i = 0; i < doneAnims.size(); i++) {
+		lua_pushnumber(L, doneAnims[i].axis + 1);
+		lua_rawseti(L, -2, i + 1);
+	}
+
+	RunCallIn(fn, 2, 0);
+}
+
+
 void CLuaUnitScript::RawCall(int functionId)
 {
 	if (functionId < 0)
@@ -134,6 +134,8 @@ public:
 
 	// special callin to allow Lua to resume threads blocking on this anim
 	void AnimFinished(AnimType type, int piece, int axis) override;
+	// batched variant; one call with packed piece/axis arrays per Tick
+	void AnimsFinished(AnimType type, const AnimContainerType& doneAnims) override;
 
 public:
 	static void HandleFreed(CLuaHandle* handle);
@@ -53,6 +53,7 @@ CR_REG_METADATA(CUnitScript, (
 	CR_MEMBER(unit),
 	CR_MEMBER(busy),
 	CR_MEMBER(anims),
+	CR_MEMBER(animatingIndex),
 
 	//Populated by children
 	CR_IGNORED(pieces),
@@ -77,6 +78,7 @@ CR_REG_METADATA_SUB(CUnitScript, AnimInfo,(
 CUnitScript::CUnitScript(CUnit* unit)
 	: unit(unit)
 	, busy(false)
+	, animatingIndex(-1)
 	, hasSetSFXOccupy(false)
 	, hasRockUnit(false)
 	, hasStartBuilding(false)
@@ -173,7 +175,8 @@ bool CUnitScript::DoSpin(float& cur, float dest, float& speed, float accel, int
 
 
 
-void CUnitScript::TickAnims(int tickRate, const TickAnimFunc& tickAnimFunc, AnimContainerType& liveAnims, AnimContainerType& doneAnims) {
+template<CUnitScript::TickAnimFunc tickAnimFunc>
+void CUnitScript::TickAnims(int tickRate, AnimContainerType& liveAnims, AnimContainerType& doneAnims) {
 	for (size_t i = 0; i < liveAnims.size(); ) {
 		AnimInfo& ai = liveAnims[i];
 		LocalModelPiece& lmp = *pieces[ai.piece];
@@ -202,25 +205,34 @@ bool CUnitScript::Tick(int deltaTime)
 	// vector of indexes of finished animations,
 	// so we can get rid of them in constant time
 	static AnimContainerType doneAnims[AMove + 1];
-	// tick-functions; these never change address
-	static constexpr TickAnimFunc tickAnimFuncs[AMove + 1] = {&CUnitScript::TickTurnAnim, &CUnitScript::TickSpinAnim, &CUnitScript::TickMoveAnim};
 
-	for (int animType = ATurn; animType <= AMove; animType++) {
-		TickAnims(1000 / deltaTime, tickAnimFuncs[animType], anims[animType], doneAnims[animType]);
-	}
+	const int tickRate = 1000 / deltaTime;
+
+	// one statically dispatched loop per anim-type, same order as before
+	TickAnims<&CUnitScript::TickTurnAnim>(tickRate, anims[ATurn], doneAnims[ATurn]);
+	TickAnims<&CUnitScript::TickSpinAnim>(tickRate, anims[ASpin], doneAnims[ASpin]);
+	TickAnims<&CUnitScript::TickMoveAnim>(tickRate, anims[AMove], doneAnims[AMove]);
 
 	// Tell listeners to unblock, and remove finished animations from the unit/script.
 	for (int animType = ATurn; animType <= AMove; animType++) {
-		for (AnimInfo& ai: doneAnims[animType]) {
-			AnimFinished((AnimType) animType, ai.piece, ai.axis);
-		}
+		if (doneAnims[animType].empty())
+			continue;
 
+		AnimsFinished((AnimType) animType, doneAnims[animType]);
 		doneAnims[animType].clear();
 	}
 
 	return (HaveAnimations());
 }
 
+void CUnitScript::AnimsFinished(AnimType type, const AnimContainerType& doneAnims)
+{
+	// per-event notification; overridden by scripts that batch
+	for (const AnimInfo& ai: doneAnims) {
+		AnimFinished(type, ai.piece, ai.axis);
+	}
+}
+
 
 
 CUnitScript::AnimContainerTypeIt CUnitScript::FindAnim(AnimType type, int piece, int axis)
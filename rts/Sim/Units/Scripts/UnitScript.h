@@ -44,6 +44,9 @@ protected:
 
 	AnimContainerType anims[AMove + 1];
 
+	// our slot in CUnitScriptEngine's animating-set, -1 while not registered
+	int animatingIndex;
+
 
 	bool hasSetSFXOccupy;
 	bool hasRockUnit;
@@ -106,12 +109,19 @@ public:
 	      CUnit* GetUnit()       { return unit; }
 	const CUnit* GetUnit() const { return unit; }
 
+	// maintained by CUnitScriptEngine
+	int GetAnimatingIndex() const { return animatingIndex; }
+	void SetAnimatingIndex(int idx) { animatingIndex = idx; }
+
 	bool Tick(int tickRate);
 	// note: must copy-and-set here (LMP dirty flag, etc)
 	bool TickMoveAnim(int tickRate, LocalModelPiece& lmp, AnimInfo& ai) { float3 pos = lmp.GetPosition(); const bool ret = MoveToward(pos[ai.axis], ai.dest, ai.speed / tickRate); lmp.SetPosition(pos); return ret; }
 	bool TickTurnAnim(int tickRate, LocalModelPiece& lmp, AnimInfo& ai) { float3 rot = lmp.GetRotation(); const bool ret = TurnToward(rot[ai.axis], ai.dest, ai.speed / tickRate); lmp.SetRotation(rot); return ret; }
 	bool TickSpinAnim(int tickRate, LocalModelPiece& lmp, AnimInfo& ai) { float3 rot = lmp.GetRotation(); const bool ret = DoSpin(rot[ai.axis], ai.dest, ai.speed, ai.accel, tickRate); lmp.SetRotation(rot); return ret; }
-	void TickAnims(int tickRate, const TickAnimFunc& tickAnimFunc, AnimContainerType& liveAnims, AnimContainerType& doneAnims);
+	// tick-function is bound statically so each anim-type gets its own
+	// specialized loop with the integration inlined (no per-anim indirect
+	// member-function call)
+	template<TickAnimFunc tickAnimFunc> void TickAnims(int tickRate, AnimContainerType& liveAnims, AnimContainerType& doneAnims);
 
 	// animation, used by CCobThread
 	void Spin(int piece, int axis, float speed, float accel);
@@ -204,6 +214,11 @@ public:
 	virtual bool  BlockShot(int weaponNum, const CUnit* targetUnit, bool userTarget) = 0; // returns whether shot should be blocked
 	virtual float TargetWeight(int weaponNum, const CUnit* targetUnit) = 0; // returns target weight
 	virtual void AnimFinished(AnimType type, int piece, int axis) = 0;
+	// batched variant, called once per Tick with every animation of
+	// <type> that finished; scripts that can consume packed arrays
+	// (CLuaUnitScript) override this to avoid crossing the script
+	// boundary once per event
+	virtual void AnimsFinished(AnimType type, const AnimContainerType& doneAnims);
 };
 
 #endif // UNIT_SCRIPT_H
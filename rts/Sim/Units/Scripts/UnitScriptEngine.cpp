@@ -11,7 +11,6 @@
 #include "Sim/Units/Unit.h"
 #include "Sim/Units/UnitDef.h"
 #include "Sim/Units/UnitHandler.h"
-#include "System/ContainerUtil.h"
 #include "System/SafeUtil.h"
 
 static CCobEngine gCobEngine;
@@ -101,8 +100,12 @@ void CUnitScriptEngine::AddInstance(CUnitScript* instance)
 {
 	if (instance == currentScript)
 		return;
+	// each instance remembers its own slot, no linear membership test
+	if (instance->GetAnimatingIndex() >= 0)
+		return;
 
-	spring::VectorInsertUnique(animating, instance/*, true*/);
+	instance->SetAnimatingIndex(animating.size());
+	animating.push_back(instance);
 }
 
 void CUnitScriptEngine::RemoveInstance(CUnitScript* instance)
@@ -110,7 +113,17 @@ void CUnitScriptEngine::RemoveInstance(CUnitScript* instance)
 	if (instance == currentScript)
 		return;
 
-	spring::VectorErase(animating, instance);
+	const int index = instance->GetAnimatingIndex();
+
+	if (index < 0)
+		return;
+
+	// swap-and-pop as VectorErase would, but without the find
+	animating[index] = animating.back();
+	animating[index]->SetAnimatingIndex(index);
+	animating.pop_back();
+
+	instance->SetAnimatingIndex(-1);
 }
 
 
@@ -123,7 +136,11 @@ void CUnitScriptEngine::Tick(int deltaTime)
 		currentScript = animating[i];
 
 		if (!currentScript->Tick(deltaTime)) {
-			animating[i] = animating.back();
+			currentScript->SetAnimatingIndex(-1);
+
+			if ((animating[i] = animating.back()) != currentScript)
+				animating[i]->SetAnimatingIndex(i);
+
 			animating.pop_back();
 			continue;
 		}
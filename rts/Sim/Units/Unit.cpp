@@ -134,6 +134,9 @@ CUnit::~CUnit()
 	// but we always want to call this for ourselves
 	UnBlock();
 
+	// drop any custom tooltip so a recycled id can not inherit it
+	unitToolTipMap.Drop(id);
+
 	// Remove us from our group, if we were in one
 	SetGroup(nullptr);
 
@@ -267,9 +270,6 @@ void CUnit::PreInit(const UnitLoadParams& params)
 	category = unitDef->category;
 	leaveTracks = unitDef->decalDef.leaveTrackDecals;
 
-	unitToolTipMap.Set(id, unitDef->humanName + " - " + unitDef->tooltip);
-
-
 	// sensor parameters
 	realLosRadius    = Clamp(int(unitDef->losRadius)    , 0, MAX_UNIT_SENSOR_RADIUS);
 	realAirLosRadius = Clamp(int(unitDef->airLosRadius) , 0, MAX_UNIT_SENSOR_RADIUS);
@@ -1260,13 +1260,16 @@ void CUnit::DoDamage(
 		restTime = 0; // bleeding != resting
 	}
 
-	if (eventHandler.UnitPreDamaged(this, attacker, baseDamage, weaponDefID, projectileID, isParalyzer, &baseDamage, &impulseMult))
+	if (eventHandler.HasUnitPreDamagedClients() && eventHandler.UnitPreDamaged(this, attacker, baseDamage, weaponDefID, projectileID, isParalyzer, &baseDamage, &impulseMult))
 		return;
 
 	script->WorldHitByWeapon(-(impulse * impulseMult).SafeNormalize2D(), weaponDefID, /*inout*/ baseDamage);
 	ApplyImpulse((impulse * impulseMult) / mass);
 	ApplyDamage(attacker, damages, baseDamage, experienceMod);
 
+	// health changed in-place; let area-command pollers know
+	quadField.MarkQuadsChanged(this);
+
 	{
 		eventHandler.UnitDamaged(this, attacker, baseDamage, weaponDefID, projectileID, isParalyzer);
 
@@ -1886,7 +1889,7 @@ bool CUnit::AddBuildPower(CUnit* builder, float amount)
 				return false;
 			}
 
-			if (!eventHandler.AllowUnitBuildStep(builder, this, step))
+			if (eventHandler.HasAllowUnitBuildStepClients() && !eventHandler.AllowUnitBuildStep(builder, this, step))
 				return false;
 
 			if (builder->UseMetal(metalCostStep)) {
@@ -1920,7 +1923,7 @@ bool CUnit::AddBuildPower(CUnit* builder, float amount)
 				return false;
 			}
 
-			if (!eventHandler.AllowUnitBuildStep(builder, this, step))
+			if (eventHandler.HasAllowUnitBuildStepClients() && !eventHandler.AllowUnitBuildStep(builder, this, step))
 				return false;
 
 	  		if (!builder->UseEnergy(energyUseScaled)) {
@@ -1950,7 +1953,7 @@ bool CUnit::AddBuildPower(CUnit* builder, float amount)
 		const float postHealth        = health + healthStep;
 		const float postBuildProgress = buildProgress + buildProgressStep;
 
-		if (!eventHandler.AllowUnitBuildStep(builder, this, step))
+		if (eventHandler.HasAllowUnitBuildStepClients() && !eventHandler.AllowUnitBuildStep(builder, this, step))
 			return false;
 
 		restTime = 0;
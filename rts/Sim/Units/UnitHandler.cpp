@@ -6,6 +6,7 @@
 #include "Unit.h"
 #include "UnitDefHandler.h"
 #include "UnitMemPool.h"
+#include "UnitVectorStore.h"
 #include "UnitTypes/Builder.h"
 #include "UnitTypes/ExtractorBuilding.h"
 #include "UnitTypes/Factory.h"
@@ -13,11 +14,13 @@
 #include "CommandAI/BuilderCAI.h"
 #include "Sim/Misc/GlobalSynced.h"
 #include "Sim/Misc/TeamHandler.h"
+#include "Sim/MoveTypes/GroundMoveType.h"
 #include "Sim/MoveTypes/MoveType.h"
 #include "Sim/Weapons/Weapon.h"
 #include "System/EventHandler.h"
 #include "System/Log/ILog.h"
 #include "System/SpringMath.h"
+#include "System/Threading/ThreadPool.h" // for_mt
 #include "System/TimeProfiler.h"
 #include "System/creg/STL_Deque.h"
 #include "System/creg/STL_Set.h"
@@ -102,6 +105,8 @@ void CUnitHandler::Init() {
 		units.resize(maxUnits, nullptr);
 		activeUnits.reserve(maxUnits);
 
+		unitVectorStore.Init(maxUnits);
+
 		unitMemPool.reserve(128);
 
 		// id's are used as indices, so they must lie in [0, units.size() - 1]
@@ -141,6 +146,8 @@ void CUnitHandler::Kill()
 		activeUnits.clear();
 		unitsToBeRemoved.clear();
 
+		unitVectorStore.Kill();
+
 		// only iterated by unsynced code, GetBuilderCAIs has no synced callers
 		builderCAIs.clear();
 	}
@@ -192,6 +199,8 @@ void CUnitHandler::InsertActiveUnit(CUnit* unit)
 	#endif
 
 	units[unit->id] = unit;
+
+	unitVectorStore.SyncUnit(unit);
 }
 
 
@@ -290,6 +299,7 @@ void CUnitHandler::DeleteUnit(CUnit* delUnit)
 	idPool.FreeID(delUnit->id, true);
 
 	units[delUnit->id] = nullptr;
+	unitVectorStore.ClearUnit(delUnit->id);
 
 	CSolidObject::SetDeletingRefID(delUnit->id);
 	unitMemPool.free(delUnit);
@@ -301,6 +311,11 @@ void CUnitHandler::UpdateUnitMoveTypes()
 {
 	SCOPED_TIMER("Sim::Unit::MoveType");
 
+	// collect obstacle-avoidance candidates for all ground-movers in
+	// one QuadField pass; the per-unit updates below then only run the
+	// steering math over their prefetched lists
+	CGroundMoveType::GatherAvoidanceBatch();
+
 	for (activeUpdateUnit = 0; activeUpdateUnit < activeUnits.size(); ++activeUpdateUnit) {
 		CUnit* unit = activeUnits[activeUpdateUnit];
 		AMoveType* moveType = unit->moveType;
@@ -318,6 +333,11 @@ void CUnitHandler::UpdateUnitMoveTypes()
 
 		unit->SanityCheck();
 		assert(activeUnits[activeUpdateUnit] == unit);
+
+		// write-back to the SoA mirror; movement integration is finished
+		// for this frame so consumers that only need vectors can stream
+		// the contiguous arrays instead of dereferencing fat objects
+		unitVectorStore.SyncUnit(unit);
 	}
 }
 
@@ -340,17 +360,27 @@ void CUnitHandler::SlowUpdateUnits()
 	if ((gs->frameNum % UNIT_SLOWUPDATE_RATE) == 0)
 		activeSlowUpdateUnit = 0;
 
-	// stagger the SlowUpdate's
-	for (size_t n = (activeUnits.size() / UNIT_SLOWUPDATE_RATE) + 1; (activeSlowUpdateUnit < activeUnits.size() && n != 0); ++activeSlowUpdateUnit) {
+	// stagger the SlowUpdate's; this frame's slice is [sliceBeg, sliceEnd)
+	const size_t sliceBeg = activeSlowUpdateUnit;
+	const size_t sliceEnd = std::min(sliceBeg + (activeUnits.size() / UNIT_SLOWUPDATE_RATE) + 1, activeUnits.size());
+
+	// bounding-volume updates only read and write their own unit's local
+	// model, so the slice can be sharded across the pool without touching
+	// synced state or affecting the order of any side effects
+	//
+	// SlowUpdate and SlowUpdateWeapons spawn projectiles, draw from gsRNG
+	// and mutate cross-unit state, those have to stay serial and ordered
+	for_mt(sliceBeg, sliceEnd, [this](const int i) {
+		activeUnits[i]->SlowUpdateLocalModel();
+	});
+
+	for (activeSlowUpdateUnit = sliceBeg; activeSlowUpdateUnit < sliceEnd; ++activeSlowUpdateUnit) {
 		CUnit* unit = activeUnits[activeSlowUpdateUnit];
 
 		unit->SanityCheck();
 		unit->SlowUpdate();
 		unit->SlowUpdateWeapons();
-		unit->SlowUpdateLocalModel();
 		unit->SanityCheck();
-
-		n--;
 	}
 }
 
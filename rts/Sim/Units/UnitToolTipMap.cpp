@@ -1,4 +1,27 @@
 #include "UnitToolTipMap.hpp"
+#include "Unit.h"
+#include "UnitDef.h"
 
 UnitToolTipMap unitToolTipMap;
 
+
+const std::string& UnitToolTipMap::Get(const CUnit* unit)
+{
+	const auto it = tooltips.find(unit->id);
+
+	if (it != tooltips.end())
+		return it->second;
+
+	// no custom tip; build the def's default text once on first
+	// hover instead of formatting it for every spawned unit
+	std::string& defTip = defTooltips[unit->unitDef->id];
+
+	if (defTip.empty()) {
+		defTip.reserve(unit->unitDef->humanName.size() + 3 + unit->unitDef->tooltip.size());
+		defTip.append(unit->unitDef->humanName);
+		defTip.append(" - ");
+		defTip.append(unit->unitDef->tooltip);
+	}
+
+	return defTip;
+}
@@ -5,21 +5,28 @@
 
 #include "System/UnorderedMap.hpp"
 
+class CUnit;
+
 struct UnitToolTipMap {
 public:
 	void Clear() {
 		tooltips.clear();
 		tooltips.reserve(256);
+		defTooltips.clear();
 	}
 
+	// only custom (Lua-set) tips are stored per unit; the default
+	// "humanName - tooltip" text is generated on the first query
 	void Set(int id, std::string&& tip) { tooltips[id] = std::move(tip); }
-	const std::string& Get(int id) { return tooltips[id]; }
+	void Drop(int id) { tooltips.erase(id); }
+	const std::string& Get(const CUnit* unit);
 
 private:
 	spring::unordered_map<int, std::string> tooltips;
+	// lazily built default tips, shared by all units of a def
+	spring::unordered_map<int, std::string> defTooltips;
 };
 
 extern UnitToolTipMap unitToolTipMap;
 
 #endif
-
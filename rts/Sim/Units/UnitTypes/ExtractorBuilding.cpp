@@ -48,10 +48,11 @@ void CExtractorBuilding::ResetExtraction()
 
 	metalAreaOfControl.clear();
 
-	// tell the neighbours (if any) to take it over
+	// tell the neighbours (if any) to take it over; only the squares
+	// inside our circle freed up, the rest of their areas is untouched
 	for (CExtractorBuilding* ngb: neighbours) {
 		ngb->RemoveNeighbour(this);
-		ngb->ReCalculateMetalExtraction();
+		ngb->ReCalculateMetalExtraction(this);
 	}
 	neighbours.clear();
 }
@@ -140,12 +141,30 @@ void CExtractorBuilding::RemoveNeighbour(CExtractorBuilding* neighbour)
 }
 
 
-/* recalculate metalExtract for this extractor (eg. when a neighbour dies) */
-void CExtractorBuilding::ReCalculateMetalExtraction()
+/*
+ * recalculate metalExtract for this extractor (eg. when a neighbour dies)
+ *
+ * if <changed> is given, only the squares inside its extraction circle are
+ * re-requested from the metal-map since shares elsewhere can not have moved;
+ * this keeps neighbour-death cascades proportional to the overlap areas
+ * instead of every neighbour's full area
+ */
+void CExtractorBuilding::ReCalculateMetalExtraction(const CExtractorBuilding* changed)
 {
 	metalExtract = 0;
 
 	for (MetalSquareOfControl& msqr: metalAreaOfControl) {
+		if (changed != nullptr) {
+			// same center-of-square criterion the area was built with
+			const float3 msqrPos((msqr.x + 0.5f) * METAL_MAP_SQUARE_SIZE, pos.y,
+			                     (msqr.z + 0.5f) * METAL_MAP_SQUARE_SIZE);
+
+			if (msqrPos.SqDistance2D(changed->pos) >= Square(changed->extractionRange)) {
+				metalExtract += (msqr.extractionDepth * metalMap.GetMetalAmount(msqr.x, msqr.z));
+				continue;
+			}
+		}
+
 		metalMap.RemoveExtraction(msqr.x, msqr.z, msqr.extractionDepth);
 
 		// extraction is done in a cylinder
@@ -20,7 +20,7 @@ public:
 
 	void ResetExtraction();
 	void SetExtractionRangeAndDepth(float range, float depth);
-	void ReCalculateMetalExtraction();
+	void ReCalculateMetalExtraction(const CExtractorBuilding* changed = nullptr);
 	bool IsNeighbour(CExtractorBuilding* neighbour);
 	void AddNeighbour(CExtractorBuilding* neighbour);
 	void RemoveNeighbour(CExtractorBuilding* neighbour);
@@ -31,6 +31,7 @@ CR_BIND_DERIVED(CFactory, CBuilding, )
 CR_REG_METADATA(CFactory, (
 	CR_MEMBER(buildSpeed),
 	CR_MEMBER(lastBuildUpdateFrame),
+	CR_IGNORED(yardCheckEpoch), // forces a fresh check after load
 	CR_MEMBER(curBuildDef),
 	CR_MEMBER(curBuild),
 	CR_MEMBER(finishedBuildCommand),
@@ -46,7 +47,8 @@ CFactory::CFactory():
 	buildSpeed(100.0f),
 	curBuild(nullptr),
 	curBuildDef(nullptr),
-	lastBuildUpdateFrame(-1)
+	lastBuildUpdateFrame(-1),
+	yardCheckEpoch(-1u)
 {
 }
 
@@ -109,7 +111,7 @@ void CFactory::Update()
 		if ((gs->frameNum & (UNIT_SLOWUPDATE_RATE >> 1)) == 0)
 			CGameHelper::BuggerOff(pos + frontdir * radius * 0.5f, radius * 0.5f, true, true, team, this);
 
-		if (!yardOpen && !IsStunned()) {
+		if (!yardOpen && !IsStunned() && YardCheckDue()) {
 			if (groundBlockingObjectMap.CanOpenYard(this)) {
 				groundBlockingObjectMap.OpenBlockingYard(this); // set yardOpen
 				script->Activate(); // set buildStance
@@ -131,7 +133,7 @@ void CFactory::Update()
 	}
 
 	const bool wantClose = (!IsStunned() && yardOpen && (gs->frameNum >= (lastBuildUpdateFrame + GAME_SPEED * (UNIT_SLOWUPDATE_RATE >> 1))));
-	const bool closeYard = (wantClose && curBuild == nullptr && groundBlockingObjectMap.CanCloseYard(this));
+	const bool closeYard = (wantClose && curBuild == nullptr && YardCheckDue() && groundBlockingObjectMap.CanCloseYard(this));
 
 	if (closeYard) {
 		// close the factory after inactivity
@@ -144,6 +146,23 @@ void CFactory::Update()
 
 
 
+bool CFactory::YardCheckDue()
+{
+	// the footprint scans behind Can{Open,Close}Yard are pure functions
+	// of the blocking-map contents under us, so a failed check can only
+	// turn out differently once something was inserted or erased there;
+	// successful checks always mutate the footprint themselves (through
+	// {Open,Close}BlockingYard) which re-arms this immediately
+	const uint32_t epoch = groundBlockingObjectMap.CalcFootprintEpoch(this);
+
+	if (epoch == yardCheckEpoch)
+		return false;
+
+	yardCheckEpoch = epoch;
+	return true;
+}
+
+
 void CFactory::StartBuild(const UnitDef* buildeeDef) {
 	if (isDead)
 		return;
@@ -44,6 +44,7 @@ public:
 private:
 	void SendToEmptySpot(CUnit* unit);
 	void AssignBuildeeOrders(CUnit* unit);
+	bool YardCheckDue();
 
 public:
 	float buildSpeed;
@@ -60,6 +61,10 @@ private:
 	const UnitDef* curBuildDef;
 	int lastBuildUpdateFrame;
 
+	/// blocking-map footprint epoch at the last failed yard check; the
+	/// footprint scan is skipped until the map changes underneath us
+	uint32_t yardCheckEpoch;
+
 	Command finishedBuildCommand;
 
 	NanoPieceCache nanoPieceCache;
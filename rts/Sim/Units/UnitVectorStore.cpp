@@ -0,0 +1,13 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "UnitVectorStore.h"
+#include "Unit.h"
+
+UnitVectorStore unitVectorStore;
+
+void UnitVectorStore::SyncUnit(const CUnit* unit)
+{
+	positions[unit->id] = unit->pos;
+	velocities[unit->id] = unit->speed;
+}
+
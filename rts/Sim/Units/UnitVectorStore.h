@@ -0,0 +1,53 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef UNIT_VECTOR_STORE_H
+#define UNIT_VECTOR_STORE_H
+
+#include <vector>
+
+#include "System/float3.h"
+
+class CUnit;
+
+// structure-of-arrays sidecar for the per-frame movement data of all
+// units, indexed by unit id; walking a candidate list for nothing but
+// position and velocity touches a full CUnit (several cachelines) per
+// object, so hot scans (e.g. the obstacle-avoidance loop) stream the
+// contiguous arrays instead
+//
+// the fat objects remain authoritative, entries here are written back
+// once per Update by CUnitHandler after move-types have run and stay
+// valid until the next sim-frame (SlowUpdate consumers keep reading
+// the CUnit members directly)
+class UnitVectorStore {
+public:
+	void Init(unsigned int numUnits) {
+		positions.clear();
+		positions.resize(numUnits, ZeroVector);
+		velocities.clear();
+		velocities.resize(numUnits, ZeroVector);
+	}
+
+	void Kill() {
+		positions.clear();
+		velocities.clear();
+	}
+
+	void SyncUnit(const CUnit* unit);
+	void ClearUnit(unsigned int unitID) {
+		positions[unitID] = ZeroVector;
+		velocities[unitID] = ZeroVector;
+	}
+
+	const float3& UnitPos(unsigned int unitID) const { return positions[unitID]; }
+	const float3& UnitSpeed(unsigned int unitID) const { return velocities[unitID]; }
+
+private:
+	std::vector<float3> positions;
+	std::vector<float3> velocities;
+};
+
+extern UnitVectorStore unitVectorStore;
+
+#endif
+
@@ -301,7 +301,12 @@ void CBeamLaser::FireInternal(float3 curDir)
 	}
 
 	for (int tries = 0; tries < 5 && tryAgain; ++tries) {
-		float beamLength = TraceRay::TraceRay(curPos, curDir, maxLength - curLength, collisionFlags, owner, hitUnit, hitFeature, &hitColQuery);
+		hitShields.clear();
+
+		// resolve the unit/feature and shield hits of this try in one
+		// shared quad walk; shield hits past the beam length are culled
+		// by the distance check below
+		float beamLength = TraceRay::TraceRayAndShields(this, curPos, curDir, maxLength - curLength, collisionFlags, hitUnit, hitFeature, hitShields, &hitColQuery);
 
 		if (hitUnit != nullptr && teamHandler.AlliedTeams(hitUnit->team, owner->team)) {
 			if (sweepFireState.IsSweepFiring() && !sweepFireState.DamageAllies()) {
@@ -323,9 +328,6 @@ void CBeamLaser::FireInternal(float3 curDir)
 		//
 		// we do more than one trace-iteration and set dir to
 		// newDir only in the case there is a shield in our way
-		hitShields.clear();
-		TraceRay::TraceRayShields(this, curPos, curDir, beamLength, hitShields);
-
 		for (const TraceRay::SShieldDist& sd: hitShields) {
 			if (sd.dist < beamLength && sd.rep->IncomingBeam(this, curPos, curPos + (curDir * sd.dist), salvoDamageMult)) {
 				beamLength = sd.dist;
@@ -62,7 +62,9 @@ bool CCannon::HaveFreeLineOfFire(const float3 srcPos, const float3 tgtPos, const
 	if (projectileSpeed == 0.0f)
 		return true;
 
-	float3 launchDir = CalcWantedDir(tgtPos - srcPos);
+	// share the memoized firing solution; targeting code probes
+	// the same (or a barely moved) position many times in a row
+	float3 launchDir = GetWantedDir(tgtPos - srcPos);
 	float3 targetVec = (tgtPos - srcPos) * XZVector;
 
 	if (launchDir.SqLength() == 0.0f)
@@ -132,14 +134,18 @@ void CCannon::FireImpl(const bool scriptCall)
 
 void CCannon::SlowUpdate()
 {
-	if (weaponDef->highTrajectory == 2 && owner->useHighTrajectory != highTrajectory)
+	if (weaponDef->highTrajectory == 2 && owner->useHighTrajectory != highTrajectory) {
 		highTrajectory = owner->useHighTrajectory;
 
+		// cached solution was solved for the other arc
+		lastTargetVec = -OnesVector * 1e6f;
+	}
+
 	CWeapon::SlowUpdate();
 }
 
 
-float3 CCannon::GetWantedDir(const float3& targetVec)
+float3 CCannon::GetWantedDir(const float3& targetVec) const
 {
 	const float3 tgtDif = targetVec - lastTargetVec;
 
@@ -11,10 +11,11 @@ class CCannon: public CWeapon
 	CR_DECLARE_DERIVED(CCannon)
 
 protected:
-	/// cached input for GetWantedDir
-	float3 lastTargetVec;
+	/// cached input for GetWantedDir (mutable so line-of-fire
+	/// tests can share the memoized solution)
+	mutable float3 lastTargetVec;
 	/// cached result for GetWantedDir
-	float3 lastLaunchDir = -UpVector;
+	mutable float3 lastLaunchDir = -UpVector;
 
 	/// this is used to keep range true to range tag
 	float rangeBoostFactor = 1.0f;
@@ -43,7 +44,7 @@ public:
 
 private:
 	/// tells where to point the gun to hit the point at pos+diff
-	float3 GetWantedDir(const float3& diff);
+	float3 GetWantedDir(const float3& diff) const;
 	float3 CalcWantedDir(const float3& diff) const;
 
 	const float3& GetAimFromPos(bool useMuzzle = false) const override { return weaponMuzzlePos; }
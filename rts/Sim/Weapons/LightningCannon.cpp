@@ -37,7 +37,11 @@ void CLightningCannon::FireImpl(const bool scriptCall)
 	CFeature* hitFeature = nullptr;
 	CollisionQuery hitColQuery;
 
-	float boltLength = TraceRay::TraceRay(curPos, curDir, range, collisionFlags, owner, hitUnit, hitFeature, &hitColQuery);
+	static std::vector<TraceRay::SShieldDist> hitShields;
+	hitShields.clear();
+
+	// resolve the unit/feature and shield hits in one shared quad walk
+	float boltLength = TraceRay::TraceRayAndShields(this, curPos, curDir, range, collisionFlags, hitUnit, hitFeature, hitShields, &hitColQuery);
 
 	if (!weaponDef->waterweapon) {
 		// terminate bolt at water surface if necessary
@@ -48,9 +52,6 @@ void CLightningCannon::FireImpl(const bool scriptCall)
 		}
 	}
 
-	static std::vector<TraceRay::SShieldDist> hitShields;
-	hitShields.clear();
-	TraceRay::TraceRayShields(this, curPos, curDir, range, hitShields);
 	for (const TraceRay::SShieldDist& sd: hitShields) {
 		if (sd.dist < boltLength && sd.rep->IncomingBeam(this, curPos, curPos + (curDir * sd.dist), 1.0f)) {
 			boltLength = sd.dist;
@@ -90,8 +90,20 @@ void CPlasmaRepulser::SerializeShieldSegmentCollectionPool(creg::ISerializer* s)
 
 
 
+// (de)registered from ctor and dtor (rather than Init) so the list
+// also mirrors the live instances after a creg load, which does not
+// re-run Init
+std::vector<CPlasmaRepulser*> CPlasmaRepulser::allRepulsers;
+
+CPlasmaRepulser::CPlasmaRepulser(CUnit* owner, const WeaponDef* def): CWeapon(owner, def)
+{
+	allRepulsers.push_back(this);
+}
+
 CPlasmaRepulser::~CPlasmaRepulser()
 {
+	spring::VectorErase(allRepulsers, this);
+
 	quadField.RemoveRepulser(this);
 	sscPool.RemoveCollection(this);
 }
@@ -13,7 +13,7 @@ class CPlasmaRepulser: public CWeapon
 	CR_DECLARE_DERIVED(CPlasmaRepulser)
 
 public:
-	CPlasmaRepulser(CUnit* owner = nullptr, const WeaponDef* def = nullptr): CWeapon(owner, def) {}
+	CPlasmaRepulser(CUnit* owner = nullptr, const WeaponDef* def = nullptr);
 	~CPlasmaRepulser();
 
 	void Init() override final;
@@ -50,9 +50,16 @@ public:
 
 	static void SerializeShieldSegmentCollectionPool(creg::ISerializer* s);
 
+	// every live shield; lets per-frame consumers (e.g. the projectile
+	// broadphase) iterate shields directly instead of scanning the
+	// weapon lists of all units
+	static const std::vector<CPlasmaRepulser*>& GetAllRepulsers() { return allRepulsers; }
+
 private:
 	void FireImpl(const bool scriptCall) override final {}
 
+	static std::vector<CPlasmaRepulser*> allRepulsers;
+
 private:
 	// these are strictly unsynced
 	std::vector<CWeaponProjectile*> repulsedProjectiles;
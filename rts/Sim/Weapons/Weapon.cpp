@@ -1,5 +1,7 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
+#include <algorithm>
+
 #include "Weapon.h"
 #include "WeaponDefHandler.h"
 #include "WeaponMemPool.h"
@@ -28,9 +30,15 @@
 #include "System/EventHandler.h"
 #include "System/SpringMath.h"
 #include "System/creg/DefTypes.h"
+#include "System/creg/STL_Pair.h"
 #include "System/Sound/ISoundChannels.h"
 #include "System/Log/ILog.h"
 
+// frames between periodic AutoTarget re-scans (about two seconds), and
+// the window over which those re-scans are jittered per unit
+static constexpr int TARGET_RETRY_PERIOD = 65;
+static constexpr int TARGET_RETRY_JITTER = 16;
+
 CR_BIND_DERIVED_POOL(CWeapon, CObject, , weaponMemPool.allocMem, weaponMemPool.freeMem)
 CR_REG_METADATA(CWeapon, (
 	CR_MEMBER(owner),
@@ -486,6 +494,10 @@ void CWeapon::UpdateSalvo()
 	if (owner->unitDef->decloakOnFire)
 		owner->ScriptDecloak(HaveUnitTarget()? currentTarget.unit: nullptr, this);
 
+	// grow the projectile container and id pool once for the
+	// whole shot instead of per spawned projectile
+	projectileHandler.ReserveProjectiles(true, projectilesPerShot);
+
 	for (int i = 0; i < projectilesPerShot; ++i) {
 		owner->script->Shot(weaponNum);
 		// Update Muzzle Piece/Pos
@@ -579,8 +591,12 @@ bool CWeapon::AllowWeaponAutoTarget() const
 	if (!owner->commandAI->CanWeaponAutoTarget(this))
 		return false;
 
-	if (!HaveTarget())
-		return true;
+	if (!HaveTarget()) {
+		// nothing to retain; still rate-limit scans that keep coming up
+		// empty so idle weapons do not pay for a full target-generation
+		// pass every single SlowUpdate
+		return (gs->frameNum > (lastTargetRetry + (TARGET_RETRY_PERIOD >> 2)));
+	}
 	if (avoidTarget)
 		return true;
 
@@ -609,7 +625,17 @@ bool CWeapon::AllowWeaponAutoTarget() const
 	if (currentTarget.isUserTarget)
 		return false;
 
-	return (gs->frameNum > (lastTargetRetry + 65));
+	// while we are actively engaging a valid good-category target there
+	// is no point in periodically scanning for a better one; all events
+	// that could invalidate it (death, leaving LOS, moving out of range)
+	// are caught by DependentDied and HoldIfTargetInvalid
+	if (reloadStatus > gs->frameNum)
+		return false;
+
+	// jitter the retry period by a per-unit constant so the full scans
+	// of units sharing a SlowUpdate slice do not all fall on the same
+	// frame
+	return (gs->frameNum > (lastTargetRetry + TARGET_RETRY_PERIOD + int((owner->id * 2654435761u) % TARGET_RETRY_JITTER)));
 }
 
 bool CWeapon::AutoTarget()
@@ -723,8 +749,12 @@ void CWeapon::DependentDied(CObject* o)
 	if (o == currentTarget.intercept) { DropCurrentTarget(); }
 
 	// NOTE: DependentDied is called from ~CObject-->Detach, object is just barely valid
+	// the generation counter was already bumped by DestroyProjectile at
+	// this point, so match handles on their id component alone
 	if (weaponDef->interceptor || weaponDef->isShield) {
-		spring::VectorErase(incomingProjectileIDs, static_cast<CWeaponProjectile*>(o)->id);
+		const int projID = static_cast<CWeaponProjectile*>(o)->id;
+
+		spring::VectorEraseIf(incomingProjectileIDs, [&](const std::pair<int, unsigned int>& h) { return (h.first == projID); });
 	}
 }
 
@@ -1078,6 +1108,20 @@ void CWeapon::Fire(bool scriptCall)
 }
 
 
+bool CWeapon::HasIncomingProjectile(int projID) const
+{
+	// compare full (id, generation) handles; a stale entry whose id has
+	// been reused must not mask the new projectile now carrying that id
+	const std::pair<int, unsigned int> handle(projID, projectileHandler.GetProjectileGeneration(true, projID));
+
+	return (std::find(incomingProjectileIDs.begin(), incomingProjectileIDs.end(), handle) != incomingProjectileIDs.end());
+}
+
+void CWeapon::AddIncomingProjectile(int projID)
+{
+	incomingProjectileIDs.emplace_back(projID, projectileHandler.GetProjectileGeneration(true, projID));
+}
+
 void CWeapon::UpdateInterceptTarget()
 {
 	CWeaponProjectile* newTarget = nullptr;
@@ -1086,10 +1130,15 @@ void CWeapon::UpdateInterceptTarget()
 	if (currentTarget.type == Target_Intercept)
 		minInterceptTargetDistSq = aimFromPos.SqDistance(currentTarget.intercept->pos);
 
-	for (const int projID: incomingProjectileIDs) {
-		CProjectile* p = projectileHandler.GetProjectileBySyncedID(projID);
+	for (const auto& handle: incomingProjectileIDs) {
+		// O(1) generation compare; null for stale handles instead of
+		// whatever projectile the id may have been recycled for since
+		CProjectile* p = projectileHandler.GetProjectileBySyncedID(handle.first, handle.second);
 		CWeaponProjectile* wp = static_cast<CWeaponProjectile*>(p);
 
+		if (wp == nullptr)
+			continue;
+
 		const float curInterceptTargetDistSq = aimFromPos.SqDistance(wp->pos);
 
 		// set by CWeaponProjectile's ctor when the interceptor fires
@@ -4,6 +4,7 @@
 #define WEAPON_H
 
 #include <functional>
+#include <utility>
 #include <vector>
 
 #include "System/Object.h"
@@ -46,8 +47,8 @@ public:
 
 	virtual const float3& GetAimFromPos(bool useMuzzle = false) const { return (useMuzzle? weaponMuzzlePos: aimFromPos); }
 
-	bool HasIncomingProjectile(int projID) const { return (std::find(incomingProjectileIDs.begin(), incomingProjectileIDs.end(), projID) != incomingProjectileIDs.end()); }
-	void AddIncomingProjectile(int projID) { incomingProjectileIDs.push_back(projID); }
+	bool HasIncomingProjectile(int projID) const;
+	void AddIncomingProjectile(int projID);
 
 public:
 	/// test if the weapon is able to attack an enemy/mapspot just by its properties (no range check, no FreeLineOfFire check, ...)
@@ -202,8 +203,10 @@ protected:
 	float3 currentTargetPos;
 
 	// projectiles that are on the way to our interception zone
-	// (eg. nuke toward a repulsor, or missile toward a shield)
-	std::vector<int> incomingProjectileIDs;
+	// (eg. nuke toward a repulsor, or missile toward a shield),
+	// stored as (id, generation) pairs so stale handles can never
+	// resolve to an unrelated projectile after their id is reused
+	std::vector<std::pair<int, unsigned int>> incomingProjectileIDs;
 };
 
 #endif /* WEAPON_H */
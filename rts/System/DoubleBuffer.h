@@ -0,0 +1,32 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef DOUBLE_BUFFER_H
+#define DOUBLE_BUFFER_H
+
+#include <atomic>
+
+namespace spring {
+	// single-producer single-consumer double buffer; the producer fills
+	// the back slot and makes it visible with one atomic flip, so the
+	// consumer always sees a complete snapshot and neither side blocks
+	// NOTE:
+	//   the producer may not start refilling until the consumer is done
+	//   reading the previous snapshot; the engine's frame loop provides
+	//   that fence (sim publishes, all draws of the interval then read)
+	template<typename T> class double_buffer {
+	public:
+		T& GetWriteBuffer() { return slots[readIdx.load(std::memory_order_relaxed) ^ 1]; }
+
+		const T& GetReadBuffer() const { return slots[readIdx.load(std::memory_order_acquire)]; }
+
+		void Publish() { readIdx.fetch_xor(1, std::memory_order_acq_rel); }
+
+	private:
+		T slots[2];
+
+		std::atomic<int> readIdx = {0};
+	};
+}
+
+#endif
+
@@ -48,6 +48,7 @@ void CEventClient::Save(zipFile archive) {}
 
 void CEventClient::Update() {}
 void CEventClient::UnsyncedHeightMapUpdate(const SRectangle& rect) {}
+void CEventClient::UnitAttributesChanged(const std::vector<int>& unitIDs, const std::vector<int>& attrMasks) {}
 
 void CEventClient::SunChanged() {}
 
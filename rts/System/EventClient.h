@@ -272,6 +272,8 @@ class CEventClient
 
 		virtual void Update();
 		virtual void UnsyncedHeightMapUpdate(const SRectangle& rect);
+		/// subscribed unit attributes changed this sim frame, see UnitAttributeTracker
+		virtual void UnitAttributesChanged(const std::vector<int>& unitIDs, const std::vector<int>& attrMasks);
 
 		virtual bool KeyPress(int key, bool isRepeat);
 		virtual bool KeyRelease(int key);
@@ -40,6 +40,15 @@ class CEventHandler
 		bool IsUnsynced(const std::string& ciName) const;
 		bool IsController(const std::string& ciName) const;
 
+		// generated per-event pre-checks, true when at least one client
+		// is subscribed; hot call-sites test these so dispatching a dead
+		// event costs a single branch instead of an out-of-line call
+	#define SETUP_EVENT(name, props) bool Has ## name ## Clients() const { return !(list ## name.empty()); }
+	#define SETUP_UNMANAGED_EVENT(name, props)
+		#include "Events.def"
+	#undef SETUP_EVENT
+	#undef SETUP_UNMANAGED_EVENT
+
 
 	public:
 		/**
@@ -210,6 +219,7 @@ class CEventHandler
 		void Save(zipFile archive);
 
 		void UnsyncedHeightMapUpdate(const SRectangle& rect);
+		void UnitAttributesChanged(const std::vector<int>& unitIDs, const std::vector<int>& attrMasks);
 		void Update();
 
 		bool KeyPress(int key, bool isRepeat);
@@ -672,6 +682,11 @@ inline void CEventHandler::UnsyncedHeightMapUpdate(const SRectangle& rect)
 	ITERATE_EVENTCLIENTLIST(UnsyncedHeightMapUpdate, rect)
 }
 
+inline void CEventHandler::UnitAttributesChanged(const std::vector<int>& unitIDs, const std::vector<int>& attrMasks)
+{
+	ITERATE_EVENTCLIENTLIST(UnitAttributesChanged, unitIDs, attrMasks)
+}
+
 
 
 
@@ -53,6 +53,10 @@ LOG_REGISTER_SECTION_GLOBAL(LOG_SECTION_ARCHIVESCANNER)
 
 constexpr static int INTERNAL_VER = 16;
 
+// number of freshly scanned archives after which ScanDirs dumps the
+// cache mid-scan, so aborting a long first-time scan does not lose it
+constexpr static size_t INCREMENTAL_FLUSH_COUNT = 32;
+
 
 /*
  * Engine known (and used?) tags in [map|mod]info.lua
@@ -499,11 +503,25 @@ void CArchiveScanner::ScanDirs(const std::vector<std::string>& scanDirs)
 	}*/
 
 	// Create archiveInfos etc. if not in cache already
+	//
+	// periodically dump the cache so an interrupted first-time scan of a
+	// large collection resumes where it left off instead of restarting;
+	// entries are only pruned by the final WriteCacheData since archives
+	// not yet revisited in this scan still carry updated=false
+	size_t numFlushedEntries = archiveInfos.size() + brokenArchives.size();
+
 	for (const std::string& archive: foundArchives) {
 		ScanArchive(archive, false);
 	#if !defined(DEDICATED) && !defined(UNITSYNC)
 		Watchdog::ClearTimer(WDT_MAIN);
 	#endif
+
+		const size_t numEntries = archiveInfos.size() + brokenArchives.size();
+
+		if ((numEntries - numFlushedEntries) >= INCREMENTAL_FLUSH_COUNT) {
+			WriteCacheFile(GetFilepath());
+			numFlushedEntries = numEntries;
+		}
 	}
 
 	// Now we'll have to parse the replaces-stuff found in the mods
@@ -1077,12 +1095,6 @@ void CArchiveScanner::WriteCacheData(const std::string& filename)
 	if (!isDirty)
 		return;
 
-	FILE* out = fopen(filename.c_str(), "wt");
-	if (out == nullptr) {
-		LOG_L(L_ERROR, "[AS::%s] failed to write to \"%s\"!", __func__, filename.c_str());
-		return;
-	}
-
 	// First delete all outdated information
 	{
 		std::stable_sort(archiveInfos.begin(), archiveInfos.end(), [](const ArchiveInfo& a, const ArchiveInfo& b) { return (a.origName < b.origName); });
@@ -1106,6 +1118,20 @@ void CArchiveScanner::WriteCacheData(const std::string& filename)
 		}
 	}
 
+	WriteCacheFile(filename);
+
+	isDirty = false;
+}
+
+void CArchiveScanner::WriteCacheFile(const std::string& filename)
+{
+	std::lock_guard<decltype(scannerMutex)> lck(scannerMutex);
+
+	FILE* out = fopen(filename.c_str(), "wt");
+	if (out == nullptr) {
+		LOG_L(L_ERROR, "[AS::%s] failed to write to \"%s\"!", __func__, filename.c_str());
+		return;
+	}
 
 	fprintf(out, "local archiveCache = {\n\n");
 	fprintf(out, "\tinternalver = %i,\n\n", INTERNAL_VER);
@@ -1181,8 +1207,6 @@ void CArchiveScanner::WriteCacheData(const std::string& filename)
 
 	if (fclose(out) == EOF)
 		LOG_L(L_ERROR, "[AS::%s] failed to write to \"%s\"!", __func__, filename.c_str());
-
-	isDirty = false;
 }
 
 
@@ -204,6 +204,8 @@ private:
 
 	void ReadCacheData(const std::string& filename);
 	void WriteCacheData(const std::string& filename);
+	/// dumps the current entries without pruning; safe to call mid-scan
+	void WriteCacheFile(const std::string& filename);
 
 	IFileFilter* CreateIgnoreFilter(IArchive* ar);
 
@@ -7,8 +7,6 @@
 
 #include <cassert>
 
-spring::mutex CBufferedArchive::archiveLock;
-
 
 CBufferedArchive::~CBufferedArchive()
 {
@@ -41,6 +39,23 @@ bool CBufferedArchive::GetFile(unsigned int fid, std::vector<std::uint8_t>& buff
 		return (ret == 1);
 	}
 
+	const FileBuffer& fb = GetCachedFileBuffer(fid, ret);
+
+	if (!fb.exists) {
+		LOG_L(L_WARNING, "[BufferedArchive::%s(fid=%u)][!fb.exists] name=%s ret=%d size=" _STPF_, __func__, fid, archiveFile.c_str(), ret, fb.data.size());
+		return false;
+	}
+
+	if (buffer.size() != fb.data.size())
+		buffer.resize(fb.data.size());
+
+	// NOTE: GetFileView offers zero-copy access to already-cached entries
+	std::copy(fb.data.begin(), fb.data.end(), buffer.begin());
+	return true;
+}
+
+CBufferedArchive::FileBuffer& CBufferedArchive::GetCachedFileBuffer(unsigned int fid, int& ret)
+{
 	// NumFiles is virtual, can't do this in ctor
 	if (fileCache.empty())
 		fileCache.resize(NumFiles());
@@ -55,15 +70,38 @@ bool CBufferedArchive::GetFile(unsigned int fid, std::vector<std::uint8_t>& buff
 		fileCount += fb.exists;
 	}
 
-	if (!fb.exists) {
-		LOG_L(L_WARNING, "[BufferedArchive::%s(fid=%u)][!fb.exists] name=%s ret=%d size=" _STPF_, __func__, fid, archiveFile.c_str(), ret, fb.data.size());
+	return fb;
+}
+
+void CBufferedArchive::PrefetchFile(unsigned int fid)
+{
+	std::lock_guard<spring::mutex> lck(archiveLock);
+	assert(IsFileId(fid));
+
+	// pointless without a cache for the data to land in
+	if (noCache || !globalConfig.vfsCacheArchiveFiles)
+		return;
+
+	int ret = 0;
+	GetCachedFileBuffer(fid, ret);
+}
+
+bool CBufferedArchive::GetFileView(unsigned int fid, const std::uint8_t*& data, unsigned int& size)
+{
+	std::lock_guard<spring::mutex> lck(archiveLock);
+	assert(IsFileId(fid));
+
+	// only serve entries that are already resident; decompressing just
+	// for a view would retain the data in the cache past the request
+	if (noCache || !globalConfig.vfsCacheArchiveFiles || fileCache.empty())
 		return false;
-	}
 
-	if (buffer.size() != fb.data.size())
-		buffer.resize(fb.data.size());
+	const FileBuffer& fb = fileCache.at(fid);
 
-	// TODO: zero-copy access
-	std::copy(fb.data.begin(), fb.data.end(), buffer.begin());
+	if (!fb.populated || !fb.exists)
+		return false;
+
+	data = fb.data.data();
+	size = fb.data.size();
 	return true;
 }
@@ -22,6 +22,10 @@ public:
 	virtual int GetType() const override { return ARCHIVE_TYPE_BUF; }
 
 	bool GetFile(unsigned int fid, std::vector<std::uint8_t>& buffer) override;
+	/// serves views into the cache for entries that are already resident
+	bool GetFileView(unsigned int fid, const std::uint8_t*& data, unsigned int& size) override;
+	/// synchronously decompresses an entry into the cache
+	void PrefetchFile(unsigned int fid) override;
 
 protected:
 	virtual int GetFileImpl(unsigned int fid, std::vector<std::uint8_t>& buffer) = 0;
@@ -40,13 +44,17 @@ protected:
 		std::vector<std::uint8_t> data;
 	};
 
+	/// populates (if needed) and returns the cache slot of a file; caller must hold archiveLock
+	FileBuffer& GetCachedFileBuffer(unsigned int fid, int& ret);
+
 	// indexed by file-id
 	std::vector<FileBuffer> fileCache;
-	// neither 7zip (.sd7) nor minizip (.sdz) are thread-safe
-	// zlib (used to extract pool archive .gz entries) should
-	// not need this, but currently each buffered GetFileImpl
-	// call is protected
-	static spring::mutex archiveLock;
+	// neither 7zip (.sd7) nor minizip (.sdz) handles are thread-safe,
+	// but each instance owns its own so distinct archives can extract
+	// concurrently; zlib (used for pool archive .gz entries) should
+	// not even need this, currently each buffered GetFileImpl call is
+	// still protected
+	spring::mutex archiveLock;
 
 private:
 	uint32_t cacheSize = 0;
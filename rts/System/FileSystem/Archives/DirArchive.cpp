@@ -6,6 +6,22 @@
 #include <assert.h>
 #include <fstream>
 
+#ifndef _WIN32
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#else
+	#include <windows.h>
+	// Win-API redefines these, which breaks things
+	#if defined(CreateDirectory)
+		#undef CreateDirectory
+	#endif
+	#if defined(DeleteFile)
+		#undef DeleteFile
+	#endif
+#endif
+
 #include "System/FileSystem/DataDirsAccess.h"
 #include "System/FileSystem/FileSystem.h"
 #include "System/FileSystem/FileQueryFlags.h"
@@ -42,6 +58,79 @@ CDirArchive::CDirArchive(const std::string& archiveName)
 }
 
 
+CDirArchive::~CDirArchive()
+{
+	for (MappedFile& mf: fileMaps) {
+		UnmapFile(mf);
+	}
+}
+
+
+void CDirArchive::MapFile(const std::string& rawPath, MappedFile& mf)
+{
+#ifndef _WIN32
+	const int fd = open(rawPath.c_str(), O_RDONLY);
+
+	if (fd < 0)
+		return;
+
+	struct stat sb;
+
+	if (fstat(fd, &sb) == 0 && sb.st_size > 0) {
+		void* addr = mmap(nullptr, sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+		if (addr != MAP_FAILED) {
+			mf.data = reinterpret_cast<const std::uint8_t*>(addr);
+			mf.size = sb.st_size;
+		}
+	}
+
+	// mapping (if any) stays valid after closing the descriptor
+	close(fd);
+#else
+	HANDLE file = CreateFile(rawPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+	if (file == INVALID_HANDLE_VALUE)
+		return;
+
+	LARGE_INTEGER fileSize;
+
+	if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+		HANDLE mapping = CreateFileMapping(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+		if (mapping != nullptr) {
+			void* addr = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+			if (addr != nullptr) {
+				mf.data = reinterpret_cast<const std::uint8_t*>(addr);
+				mf.size = fileSize.QuadPart;
+			}
+
+			// the view (if any) stays valid after closing both handles
+			CloseHandle(mapping);
+		}
+	}
+
+	CloseHandle(file);
+#endif
+}
+
+void CDirArchive::UnmapFile(MappedFile& mf)
+{
+	if (mf.data == nullptr)
+		return;
+
+#ifndef _WIN32
+	munmap(const_cast<std::uint8_t*>(mf.data), mf.size);
+#else
+	UnmapViewOfFile(mf.data);
+#endif
+
+	mf.data = nullptr;
+	mf.size = 0;
+}
+
+
 bool CDirArchive::GetFile(unsigned int fid, std::vector<std::uint8_t>& buffer)
 {
 	assert(IsFileId(fid));
@@ -63,6 +152,31 @@ bool CDirArchive::GetFile(unsigned int fid, std::vector<std::uint8_t>& buffer)
 	return true;
 }
 
+bool CDirArchive::GetFileView(unsigned int fid, const std::uint8_t*& data, unsigned int& size)
+{
+	assert(IsFileId(fid));
+
+	// GetFile is stateless but views are cached, CalcHash runs multi-threaded
+	std::lock_guard<spring::mutex> lck(mapsMutex);
+
+	if (fileMaps.empty())
+		fileMaps.resize(searchFiles.size());
+
+	MappedFile& mf = fileMaps[fid];
+
+	if (!mf.mapped) {
+		MapFile(dataDirsAccess.LocateFile(dirName + searchFiles[fid]), mf);
+		mf.mapped = true;
+	}
+
+	if (mf.data == nullptr)
+		return false;
+
+	data = mf.data;
+	size = mf.size;
+	return true;
+}
+
 void CDirArchive::FileInfo(unsigned int fid, std::string& name, int& size) const
 {
 	assert(IsFileId(fid));
@@ -7,6 +7,7 @@
 
 #include "IArchiveFactory.h"
 #include "IArchive.h"
+#include "System/Threading/SpringThreading.h"
 
 
 /**
@@ -30,6 +31,7 @@ class CDirArchive : public IArchive
 {
 public:
 	CDirArchive(const std::string& archiveName);
+	~CDirArchive();
 
 	int GetType() const override { return ARCHIVE_TYPE_SDD; }
 
@@ -37,14 +39,30 @@ public:
 
 	unsigned int NumFiles() const override { return (searchFiles.size()); }
 	bool GetFile(unsigned int fid, std::vector<std::uint8_t>& buffer) override;
+	/// memory-maps the loose file, i.e. contents are demand-paged
+	bool GetFileView(unsigned int fid, const std::uint8_t*& data, unsigned int& size) override;
 	void FileInfo(unsigned int fid, std::string& name, int& size) const override;
 	const std::string& GetOrigFileName(unsigned int fid) const { return searchFiles[fid]; }
 
 private:
+	struct MappedFile {
+		const std::uint8_t* data = nullptr;
+		size_t size = 0;
+		/// true if a mapping was attempted, successfully or not
+		bool mapped = false;
+	};
+
+	static void MapFile(const std::string& rawPath, MappedFile& mf);
+	static void UnmapFile(MappedFile& mf);
+
 	/// "ExampleArchive.sdd/"
 	const std::string dirName;
 
 	std::vector<std::string> searchFiles;
+
+	// lazily created by GetFileView, indexed by file-id
+	std::vector<MappedFile> fileMaps;
+	spring::mutex mapsMutex;
 };
 
 #endif // _DIR_ARCHIVE_H
@@ -2,6 +2,8 @@
 
 #include "IArchive.h"
 
+#include <algorithm>
+
 #include "System/StringUtil.h"
 
 unsigned int IArchive::FindFile(const std::string& filePath) const
@@ -15,9 +17,26 @@ unsigned int IArchive::FindFile(const std::string& filePath) const
 	return NumFiles();
 }
 
+void IArchive::SortBatchFetchOrder(std::vector<unsigned int>& fids) const
+{
+	std::sort(fids.begin(), fids.end());
+}
+
 bool IArchive::CalcHash(uint32_t fid, uint8_t hash[sha512::SHA_LEN], std::vector<std::uint8_t>& fb)
 {
-	// NOTE: should be possible to avoid a re-read for buffered archives
+	const std::uint8_t* viewData = nullptr;
+	unsigned int viewSize = 0;
+
+	// mapped (loose) and already-resident (buffered) entries can be
+	// hashed in place, anything else has to be extracted into fb
+	if (GetFileView(fid, viewData, viewSize)) {
+		if (viewSize == 0)
+			return false;
+
+		sha512::calc_digest(viewData, viewSize, hash);
+		return true;
+	}
+
 	if (!GetFile(fid, fb))
 		return false;
 
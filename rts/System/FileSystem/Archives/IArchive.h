@@ -82,6 +82,30 @@ public:
 	 */
 	bool GetFile(const std::string& name, std::vector<std::uint8_t>& buffer);
 
+	/**
+	 * Fetches a non-owning read-only view of a file by its ID, avoiding
+	 * the copy into a caller-side buffer. Only supported by archive types
+	 * whose entries are resident in memory or can be memory-mapped; the
+	 * view stays valid for the lifetime of the archive.
+	 * @return true if a view is available, false if the caller has to
+	 *   fall back to GetFile
+	 */
+	virtual bool GetFileView(unsigned int fid, const std::uint8_t*& data, unsigned int& size) { return false; }
+
+	/**
+	 * Hints that a file is about to be read, so archive types backed by
+	 * compressed data can extract it into their cache ahead of need; a
+	 * no-op for types whose reads are cheap.
+	 */
+	virtual void PrefetchFile(unsigned int fid) {}
+
+	/**
+	 * Reorders a batch of file IDs into the cheapest extraction order;
+	 * solid archives sort by (block, position within block) such that
+	 * no block has to be decompressed twice. Plain ID order otherwise.
+	 */
+	virtual void SortBatchFetchOrder(std::vector<unsigned int>& fids) const;
+
 	std::pair<std::string, int> FileInfo(unsigned int fid) const {
 		std::pair<std::string, int> info;
 		FileInfo(fid, info.first, info.second);
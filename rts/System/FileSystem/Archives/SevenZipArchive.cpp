@@ -207,6 +207,8 @@ CSevenZipArchive::CSevenZipArchive(const std::string& name): CBufferedArchive(na
 
 		const UInt32 folderIndex = db.FileIndexToFolderIndexMap[i];
 
+		fd.folderIndex = folderIndex;
+
 		if (folderIndex == ((UInt32)-1)) {
 			// file has no folder assigned
 			fd.unpackedSize = f->Size;
@@ -260,6 +262,19 @@ void CSevenZipArchive::FileInfo(unsigned int fid, std::string& name, int& size)
 }
 
 
+void CSevenZipArchive::SortBatchFetchOrder(std::vector<unsigned int>& fids) const
+{
+	// sort by (solid block, position within it); SzArEx_Extract keeps the
+	// most recently unpacked block cached in outBuffer, so visiting the
+	// entries in this order decompresses every block exactly once
+	const auto blockPos = [&](unsigned int fid) {
+		const FileEntry& fe = fileEntries[fid];
+		return std::make_pair(fe.folderIndex, fe.fp);
+	};
+
+	std::stable_sort(fids.begin(), fids.end(), [&](unsigned int a, unsigned int b) { return (blockPos(a) < blockPos(b)); });
+}
+
 bool CSevenZipArchive::HasLowReadingCost(unsigned int fid) const
 {
 	assert(IsFileId(fid));
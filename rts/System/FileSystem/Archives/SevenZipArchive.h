@@ -44,6 +44,7 @@ public:
 	unsigned int NumFiles() const override { return (fileEntries.size()); }
 	int GetFileImpl(unsigned int fid, std::vector<std::uint8_t>& buffer) override;
 	void FileInfo(unsigned int fid, std::string& name, int& size) const override;
+	void SortBatchFetchOrder(std::vector<unsigned int>& fids) const override;
 
 	#if 0
 	unsigned GetCrc32(unsigned int fid) {
@@ -100,6 +101,11 @@ private:
 		 * @see #unpackedSize
 		 */
 		int packedSize;
+		/**
+		 * Solid block ("folder" in 7zip terms) the data of this file
+		 * lives in, (UInt32)-1 if it has none assigned.
+		 */
+		UInt32 folderIndex;
 	};
 
 	std::vector<FileEntry> fileEntries;
@@ -4,11 +4,14 @@
 #include "VFSHandler.h"
 
 #include <algorithm>
+#include <cstdio>
 #include <cstring>
+#include <numeric>
 
 #include "ArchiveLoader.h"
 #include "ArchiveScanner.h"
 #include "FileSystem.h"
+#include "System/Config/ConfigHandler.h"
 #include "System/FileSystem/Archives/IArchive.h"
 #include "System/FileSystem/Archives/DirArchive.h"
 #include "System/Threading/SpringThreading.h"
@@ -28,6 +31,9 @@ LOG_REGISTER_SECTION_GLOBAL(LOG_SECTION_VFS)
 #define LOG_SECTION_CURRENT LOG_SECTION_VFS
 
 
+CONFIG(bool, VFSRamLoad).defaultValue(false).description("Eagerly load the full mod and map archive contents into memory at game start and serve all later file reads from RAM; trades memory for load time on hosts with slow disks.");
+
+
 // GetFileData can be called on a thread other than main (e.g. sound) via
 // FileHandler::Open, while {Add,Remove}Archive are reached from multiple
 // places including LuaVFS
@@ -227,6 +233,9 @@ bool CVFSHandler::RemoveArchive(const std::string& archiveName)
 {
 	std::lock_guard<decltype(vfsMutex)> lck(vfsMutex);
 
+	// the worker must not outlive any archive it may still touch
+	WaitForPrefetch();
+
 	if (!removeAllowed)
 		return false;
 
@@ -302,6 +311,9 @@ void CVFSHandler::DeleteArchives(Section section)
 
 	std::lock_guard<decltype(vfsMutex)> lck(vfsMutex);
 
+	// the worker must not outlive any archive it may still touch
+	WaitForPrefetch();
+
 	for (const auto& p: archives[section]) {
 		LOG_L(L_INFO, "\tarchive=%s (%p)", (p.first).c_str(), p.second);
 		delete p.second;
@@ -458,6 +470,128 @@ int CVFSHandler::LoadFile(const std::string& filePath, std::vector<std::uint8_t>
 	return (fileData.ar->GetFile(normalizedPath, buffer));
 }
 
+void CVFSHandler::PrefetchFiles(const std::vector<std::string>& filePaths, Section section)
+{
+	LOG_L(L_DEBUG, "[%s::%s<this=%p>(#filePaths=" _STPF_ ", section=%d)]", vfsName, __func__, this, filePaths.size(), section);
+
+	spring::unordered_map<IArchive*, std::vector<unsigned int>> groups;
+
+	for (const std::string& filePath: filePaths) {
+		const std::string& normalizedPath = GetNormalizedPath(filePath);
+		const FileData& fileData = GetFileData(normalizedPath, section);
+
+		if (fileData.ar == nullptr)
+			continue;
+
+		const unsigned int fid = fileData.ar->FindFile(normalizedPath);
+
+		if (!fileData.ar->IsFileId(fid))
+			continue;
+
+		groups[fileData.ar].push_back(fid);
+	}
+
+	if (groups.empty())
+		return;
+
+	std::vector<std::pair<IArchive*, std::vector<unsigned int>>> batch;
+	batch.reserve(groups.size());
+
+	for (auto& group: groups) {
+		// put solid-archive entries into (block, offset) order, any
+		// other order decompresses shared blocks once per member
+		(group.first)->SortBatchFetchOrder(group.second);
+		batch.emplace_back(group.first, std::move(group.second));
+	}
+
+	// chain batches onto a single worker; two would only contend for the
+	// per-archive locks since entries mostly come from the same archive
+	prefetchJob = std::async(std::launch::async, [prevJob = std::move(prefetchJob), batch = std::move(batch)]() mutable {
+		if (prevJob.valid())
+			prevJob.wait();
+
+		for (const auto& p: batch) {
+			for (const unsigned int fid: p.second) {
+				(p.first)->PrefetchFile(fid);
+			}
+		}
+	});
+}
+
+void CVFSHandler::RamLoadArchives()
+{
+	if (!configHandler->GetBool("VFSRamLoad"))
+		return;
+
+	std::vector<std::pair<std::string, IArchive*>> ramArchives;
+
+	{
+		std::lock_guard<decltype(vfsMutex)> lck(vfsMutex);
+
+		for (int section = Section::Mod; section <= Section::Map; section++) {
+			for (const auto& pair: archives[section]) {
+				if (pair.second == nullptr)
+					continue;
+
+				ramArchives.emplace_back(pair.first, pair.second);
+			}
+		}
+	}
+
+	LOG_L(L_INFO, "[%s::%s<this=%p>] #archives=" _STPF_ "", vfsName, __func__, this, ramArchives.size());
+
+	if (ramArchives.empty())
+		return;
+
+	// chain onto the prefetch worker (cf. PrefetchFiles) so loading can
+	// proceed in parallel; archives are never deleted from under it since
+	// {Remove,Delete}Archive(s) join first
+	prefetchJob = std::async(std::launch::async, [prevJob = std::move(prefetchJob), ramArchives = std::move(ramArchives)]() mutable {
+		if (prevJob.valid())
+			prevJob.wait();
+
+		std::vector<std::uint8_t> chunk(16 * 1024 * 1024);
+		std::vector<unsigned int> fids;
+
+		for (const auto& p: ramArchives) {
+			IArchive* ar = p.second;
+
+			// one large sequential sweep over the raw archive file; the
+			// page cache then absorbs the random reads issued while the
+			// entries are decompressed below
+			FILE* f = fopen((p.first).c_str(), "rb");
+
+			if (f != nullptr) {
+				while (fread(chunk.data(), 1, chunk.size(), f) == chunk.size());
+				fclose(f);
+			}
+
+			fids.clear();
+			fids.resize(ar->NumFiles());
+
+			std::iota(fids.begin(), fids.end(), 0);
+
+			// decompress every entry into the archive's cache in cheapest
+			// order; all later reads are then served from memory (no-op
+			// for directory archives, which have no cache to fill)
+			ar->SortBatchFetchOrder(fids);
+
+			for (const unsigned int fid: fids) {
+				ar->PrefetchFile(fid);
+			}
+		}
+	});
+}
+
+void CVFSHandler::WaitForPrefetch()
+{
+	if (!prefetchJob.valid())
+		return;
+
+	prefetchJob.wait();
+	prefetchJob = decltype(prefetchJob)();
+}
+
 int CVFSHandler::FileExists(const std::string& filePath, Section section)
 {
 	LOG_L(L_DEBUG, "[%s::%s<this=%p>(filePath=\"%s\", section=%d)]", vfsName, __func__, this, filePath.c_str(), section);
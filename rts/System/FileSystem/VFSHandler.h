@@ -4,6 +4,7 @@
 #define _VFS_HANDLER_H
 
 #include <array>
+#include <future>
 #include <string>
 #include <vector>
 #include <cinttypes>
@@ -104,6 +105,29 @@ public:
 	 */
 	int LoadFile(const std::string& filePath, std::vector<std::uint8_t>& buffer, Section section);
 
+	/**
+	 * Hands a batch of files to a background worker which decompresses
+	 * them into their archives' caches ahead of need, such that later
+	 * LoadFile calls return without paying the extraction cost. May
+	 * only be called from the main thread.
+	 * @param filePaths raw file paths, case-insensitive; entries that
+	 *   do not exist in the VFS are ignored
+	 */
+	void PrefetchFiles(const std::vector<std::string>& filePaths, Section section);
+
+	/// blocks until a pending PrefetchFiles batch (if any) has finished
+	void WaitForPrefetch();
+
+	/**
+	 * Eagerly reads every mod and map archive into memory: one large
+	 * sequential sweep over each raw archive file (the fastest possible
+	 * I/O pattern) followed by decompression of all entries into their
+	 * archives' caches, such that subsequent LoadFile calls never touch
+	 * the disk. Runs on the prefetch worker; gated behind the VFSRamLoad
+	 * config option. May only be called from the main thread.
+	 */
+	void RamLoadArchives();
+
 
 	/**
 	 * Returns all the files in the given (virtual) directory without the
@@ -174,6 +198,10 @@ private:
 
 	const char* vfsName = "";
 
+	// pending background decompression, if any; chained by PrefetchFiles
+	// and joined before archives can be deleted from under the worker
+	std::future<void> prefetchJob;
+
 	bool insertAllowed = true;
 	bool removeAllowed = true;
 };
@@ -0,0 +1,6 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "FrameArena.h"
+
+FrameArena simFrameArena;
+
@@ -0,0 +1,97 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+
+#include <vector>
+
+// bump allocator for temporaries whose lifetime never crosses a frame
+// boundary; Alloc is a pointer increment, individual frees are no-ops
+// and everything is reclaimed at once by Reset (called from the frame
+// loop). blocks that do not fit the buffer fall back to the CRT heap
+// and are released on Reset, which then grows the buffer so the next
+// frame stays on the fast path.
+class FrameArena {
+public:
+	explicit FrameArena(size_t numBytes = 1 << 20) { buffer.resize(numBytes); }
+
+	FrameArena(const FrameArena&) = delete;
+	FrameArena& operator = (const FrameArena&) = delete;
+
+	~FrameArena() { Reset(); }
+
+	void* Alloc(size_t numBytes, size_t alignment) {
+		assert((alignment & (alignment - 1)) == 0);
+
+		const size_t alignedOffset = (offset + (alignment - 1)) & ~(alignment - 1);
+
+		if ((alignedOffset + numBytes) > buffer.size()) {
+			// buffer exhausted; satisfy from the heap until Reset
+			overflowBytes += numBytes;
+			return (overflowBlocks.emplace_back(::operator new(numBytes)));
+		}
+
+		offset = alignedOffset + numBytes;
+		return (buffer.data() + alignedOffset);
+	}
+
+	// invalidates every block handed out since the previous Reset;
+	// callers must not keep arena-backed containers alive across it
+	void Reset() {
+		for (void* block: overflowBlocks) {
+			::operator delete(block);
+		}
+
+		if (!overflowBlocks.empty()) {
+			overflowBlocks.clear();
+
+			// no live blocks at this point, so growing is safe
+			buffer.resize(buffer.size() + overflowBytes);
+			overflowBytes = 0;
+		}
+
+		offset = 0;
+	}
+
+	size_t GetSize() const { return (buffer.size()); }
+	size_t GetUsedSize() const { return (offset + overflowBytes); }
+
+private:
+	std::vector<uint8_t> buffer;
+	std::vector<void*> overflowBlocks;
+
+	size_t offset = 0;
+	size_t overflowBytes = 0;
+};
+
+
+// arena handling per-frame scratch data of synced sim code; reset at
+// the end of CGame::SimFrame, so only usable from within the sim loop
+extern FrameArena simFrameArena;
+
+
+template<typename T> class FrameArenaAllocator {
+public:
+	using value_type = T;
+
+	FrameArenaAllocator() = default;
+	template<typename U> FrameArenaAllocator(const FrameArenaAllocator<U>&) {}
+
+	T* allocate(size_t n) { return (static_cast<T*>(simFrameArena.Alloc(n * sizeof(T), alignof(T)))); }
+	void deallocate(T*, size_t) {} // reclaimed wholesale by Reset
+
+	template<typename U> bool operator == (const FrameArenaAllocator<U>&) const { return true; }
+	template<typename U> bool operator != (const FrameArenaAllocator<U>&) const { return false; }
+};
+
+
+// drop-in for function-local scratch vectors in sim code; must never
+// be static or otherwise outlive the frame that allocated its storage
+template<typename T> using FrameVector = std::vector<T, FrameArenaAllocator<T>>;
+
+#endif
+
@@ -56,12 +56,51 @@ CONFIG(int, TeamHighlight)
 	.maximumValue(CTeamHighlight::HIGHLIGHT_LAST);
 
 CONFIG(bool, UseNetMessageSmoothingBuffer).defaultValue(true);
+CONFIG(bool, UseAdaptiveNetMessageBuffer).defaultValue(true);
 
 CONFIG(bool, LuaWritableConfigFile).defaultValue(true);
 CONFIG(bool, VFSCacheArchiveFiles).defaultValue(true);
 
 
 void GlobalConfig::Init()
+{
+	ReadConfigValues();
+
+	// subsystems read the plain members of this struct from their hot
+	// paths (net polling, draw loops) instead of querying the config
+	// table, so changed values have to be pushed to us
+	configHandler->NotifyOnChange(this, {
+		"NetworkLossFactor",
+		"InitialNetworkTimeout",
+		"NetworkTimeout",
+		"ReconnectTimeout",
+		"MaximumTransmissionUnit",
+		"LinkOutgoingBandwidth",
+		"LinkIncomingSustainedBandwidth",
+		"LinkIncomingPeakBandwidth",
+		"LinkIncomingMaxPacketRate",
+		"LinkIncomingMaxWaitingPackets",
+		"UseNetMessageSmoothingBuffer",
+		"UseAdaptiveNetMessageBuffer",
+		"LuaWritableConfigFile",
+		"VFSCacheArchiveFiles",
+		"TeamHighlight",
+	});
+}
+
+void GlobalConfig::Kill()
+{
+	configHandler->RemoveObserver(this);
+}
+
+void GlobalConfig::ConfigNotify(const std::string& key, const std::string& value)
+{
+	// cheaper to re-read the full snapshot than to dispatch on key;
+	// also keeps the bandwidth fixups below consistent
+	ReadConfigValues();
+}
+
+void GlobalConfig::ReadConfigValues()
 {
 	// Recommended semantics for "expert" type config values:
 	// <0 = disable (if applicable)
@@ -85,6 +124,7 @@ void GlobalConfig::Init()
 		linkIncomingSustainedBandwidth = linkIncomingPeakBandwidth = 1024 * 1024;
 
 	useNetMessageSmoothingBuffer = configHandler->GetBool("UseNetMessageSmoothingBuffer");
+	useAdaptiveNetMessageBuffer = configHandler->GetBool("UseAdaptiveNetMessageBuffer");
 	luaWritableConfigFile = configHandler->GetBool("LuaWritableConfigFile");
 	vfsCacheArchiveFiles = configHandler->GetBool("VFSCacheArchiveFiles");
 
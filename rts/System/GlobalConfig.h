@@ -3,10 +3,22 @@
 #ifndef _GLOBAL_CONFIG_H
 #define _GLOBAL_CONFIG_H
 
+#include <string>
+
 
 class GlobalConfig {
 public:
 	void Init();
+	void Kill();
+
+	// pushed by ConfigHandler whenever one of our keys changes; the
+	// cached members below are what subsystems read in their update
+	// and draw loops, so no string-keyed config lookup ever appears
+	// on a hot path
+	void ConfigNotify(const std::string& key, const std::string& value);
+
+private:
+	void ReadConfigValues();
 
 public:
 	/**
@@ -92,6 +104,16 @@ public:
 	 */
 	bool useNetMessageSmoothingBuffer = true;
 
+	/**
+	 * @brief useAdaptiveNetMessageBuffer
+	 *
+	 * Whether the smoothing buffer should additionally grow with the
+	 * measured inter-arrival jitter of frame messages, so unstable
+	 * (e.g. wireless) connections trail further behind the server
+	 * instead of oscillating between draining and refilling the buffer
+	 */
+	bool useAdaptiveNetMessageBuffer = true;
+
 	/**
 	 * @brief luaWritableConfigFile
 	 *
@@ -99,6 +99,25 @@ CDemoReader::CDemoReader(const std::string& filename, float curTime): playbackDe
 		// (if this had still used CFileHandler that would have been easier ;-))
 		bytesRemaining = playbackDemoSize - curPos;
 	}
+
+	// the seek index sits behind the statistics chunks; only trust its
+	// size field if the header is of the expected (minor) version, the
+	// demo was closed cleanly, and it fits the file
+	if (fileHeader.headerSize == sizeof(DemoFileHeader) && fileHeader.demoStreamSize != 0 && fileHeader.seekIndexSize > 0) {
+		const int seekIndexPos = fileHeader.headerSize + fileHeader.scriptSize + fileHeader.demoStreamSize + fileHeader.winningAllyTeamsSize + fileHeader.playerStatSize + fileHeader.teamStatSize;
+
+		if ((seekIndexPos + fileHeader.seekIndexSize) <= playbackDemoSize) {
+			seekIndex.resize(fileHeader.seekIndexSize / sizeof(DemoSeekIndexEntry));
+
+			playbackDemo->Seek(seekIndexPos);
+			playbackDemo->Read(reinterpret_cast<char*>(seekIndex.data()), seekIndex.size() * sizeof(DemoSeekIndexEntry));
+
+			for (DemoSeekIndexEntry& entry: seekIndex) {
+				entry.swab();
+			}
+		}
+	}
+
 	playbackDemo->Seek(curPos);
 }
 
@@ -153,6 +172,39 @@ bool CDemoReader::ReachedEnd()
 }
 
 
+bool CDemoReader::SeekToGameTime(float seekTime, float curTime)
+{
+	if (seekIndex.empty())
+		return false;
+
+	// last entry at or before seekTime (entries are in ascending order)
+	const DemoSeekIndexEntry* entry = &seekIndex.front();
+
+	for (const DemoSeekIndexEntry& e: seekIndex) {
+		if (e.modGameTime > seekTime)
+			break;
+
+		entry = &e;
+	}
+
+	playbackDemo->Seek(fileHeader.headerSize + fileHeader.scriptSize + entry->streamOffset);
+	bytesRemaining = fileHeader.demoStreamSize - entry->streamOffset;
+
+	// mirrors the ctor: read the chunk header the entry points at, the
+	// next GetData call then returns its payload
+	if (playbackDemo->Read((char*)&chunkHeader, sizeof(chunkHeader)) < sizeof(chunkHeader)) {
+		bytesRemaining = 0;
+		return false;
+	}
+
+	chunkHeader.swab();
+
+	demoTimeOffset = curTime - chunkHeader.modGameTime - 0.1f;
+	nextDemoReadTime = curTime - 0.01f;
+	return true;
+}
+
+
 void CDemoReader::LoadStats()
 {
 	// Stats are not available if Spring crashed while writing the demo.
@@ -55,6 +55,19 @@ public:
 	/// Not needed for normal demo watching
 	void LoadStats();
 
+	/// true if the demo carries a seek index (old or crashed demos do not)
+	bool HasSeekIndex() const { return !seekIndex.empty(); }
+	const std::vector<DemoSeekIndexEntry>& GetSeekIndex() const { return seekIndex; }
+
+	/**
+	@brief reposition the stream at the nearest indexed chunk at or before seekTime
+	Only moves the packet stream; the caller is responsible for bringing the
+	simulation to the matching state first (e.g. by restoring a savegame
+	snapshot taken at that game time).
+	@return false if the demo has no seek index or the chunk can not be read
+	*/
+	bool SeekToGameTime(float seekTime, float curTime);
+
 private:
 	CFileHandler* playbackDemo;
 
@@ -70,6 +83,7 @@ private:
 	std::vector<PlayerStatistics> playerStats; // one stat per player
 	std::vector< std::vector<TeamStatistics> > teamStats; // many stats per team
 	std::vector<unsigned char> winningAllyTeams;
+	std::vector<DemoSeekIndexEntry> seekIndex;
 };
 
 #endif
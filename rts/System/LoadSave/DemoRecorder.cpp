@@ -2,20 +2,30 @@
 
 #include <cassert>
 #include <cerrno>
+#include <chrono>
 #include <cstring>
 #include <memory>
 
+#include <zlib.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#else
+#include <io.h>
+#endif
+
 #include "DemoRecorder.h"
 #include "Game/GameVersion.h"
 #include "Sim/Misc/TeamStatistics.h"
 #include "System/TimeUtil.h"
 #include "System/StringUtil.h"
+#include "System/Config/ConfigHandler.h"
 #include "System/FileSystem/DataDirsAccess.h"
 #include "System/FileSystem/FileSystem.h"
 #include "System/FileSystem/FileQueryFlags.h"
 #include "System/FileSystem/FileHandler.h"
 #include "System/Log/ILog.h"
-#include "System/Threading/ThreadPool.h"
+#include "System/Threading/SpringThreading.h"
 
 #ifdef CreateDirectory
 #undef CreateDirectory
@@ -26,42 +36,329 @@
 #endif
 
 
-// server and client memory-streams
-static std::string demoStreams[2];
-static spring::mutex demoMutex;
+// seconds of game time between seek-index entries
+static constexpr int DEMO_SEEK_INDEX_PERIOD = 10;
 
+CONFIG(int, DemoWriteSync)
+	.defaultValue(0)
+	.minimumValue(0)
+	.maximumValue(2)
+	.description("0 = let the OS schedule demo writes, 1 = sync the demo to disk once when it is closed, 2 = additionally sync after every flushed block.");
 
-CDemoRecorder::CDemoRecorder(const std::string& mapName, const std::string& modName, bool serverDemo): isServerDemo(serverDemo)
+
+/**
+ * @brief background gzip writer for demo streams
+ *
+ * Packets are appended to a pending buffer on the receive path and get
+ * compressed + written out in large blocks by a dedicated thread, so
+ * neither compression nor disk latency feeds back into game latency.
+ * The demo header is put at the front of the gzip stream in a stored
+ * (uncompressed) deflate block; its position then does not depend on
+ * its contents, which lets the final statistics sizes be patched in
+ * when the demo is closed. The gzip trailer covers the uncompressed
+ * data, so it is fixed up as well (via crc32_combine).
+ */
+class CDemoStreamWriter {
+public:
+	CDemoStreamWriter(const std::string& fileName, const DemoFileHeader& initialHeader, int syncPolicy);
+
+	CDemoStreamWriter(const CDemoStreamWriter&) = delete;
+	CDemoStreamWriter& operator = (const CDemoStreamWriter&) = delete;
+
+	~CDemoStreamWriter() { Shutdown(nullptr); }
+
+	bool IsOpen() const { return (file != nullptr); }
+
+	void Append(const char* data, size_t len);
+	void Close(const DemoFileHeader& finalHeader) { Shutdown(&finalHeader); }
+
+	size_t GetStreamLen() const { return (sizeof(DemoFileHeader) + tailLen); }
+
+private:
+	void Shutdown(const DemoFileHeader* finalHeader);
+	void WriteBlock(const std::string& block, int flush);
+	void SyncFile();
+	void WriterLoop();
+
+private:
+	// drain early once this much data is pending
+	static constexpr size_t FLUSH_BLOCK_SIZE = 512 * 1024;
+
+	FILE* file = nullptr;
+	z_stream zStream;
+
+	spring::thread writeThread;
+	spring::mutex pendingMutex;
+	spring::condition_variable pendingCond;
+
+	// producer side, swapped out wholesale by the writer thread
+	std::string pendingData;
+	// deflate output staging area, only touched by the writer thread
+	std::vector<unsigned char> outBuf;
+
+	// file offset of the stored demo-header bytes, -1 if the deflate
+	// framing did not come out as expected (no statistics then, which
+	// readers already tolerate for demos of crashed games)
+	long headerOffset = -1;
+
+	// crc and length of all uncompressed data following the header
+	uLong tailCrc = 0;
+	size_t tailLen = 0;
+
+	int syncPolicy = 0;
+	bool stop = false;
+};
+
+
+CDemoStreamWriter::CDemoStreamWriter(const std::string& fileName, const DemoFileHeader& initialHeader, int syncPolicy): syncPolicy(syncPolicy)
+{
+	if ((file = fopen(fileName.c_str(), "wb")) == nullptr) {
+		LOG_L(L_ERROR, "[DemoStreamWriter::%s] could not open \"%s\" (%s)", __func__, fileName.c_str(), strerror(errno));
+		return;
+	}
+
+	memset(&zStream, 0, sizeof(zStream));
+
+	// gzip wrapper (windowBits + 16) so the output stays a regular .sdfz;
+	// start out with stored blocks for the header region, everything past
+	// it is compressed at the same level gzopen(..., "wb9") used to give
+	if (deflateInit2(&zStream, Z_NO_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+		LOG_L(L_ERROR, "[DemoStreamWriter::%s] deflateInit2 failed for \"%s\"", __func__, fileName.c_str());
+		fclose(file);
+		file = nullptr;
+		return;
+	}
+
+	outBuf.resize(256 * 1024);
+
+	unsigned char hdrBuf[sizeof(DemoFileHeader)];
+	memcpy(hdrBuf, &initialHeader, sizeof(hdrBuf));
+
+	zStream.next_in = hdrBuf;
+	zStream.avail_in = sizeof(hdrBuf);
+	zStream.next_out = outBuf.data();
+	zStream.avail_out = outBuf.size();
+
+	if (deflate(&zStream, Z_FULL_FLUSH) != Z_OK || zStream.avail_in != 0) {
+		LOG_L(L_ERROR, "[DemoStreamWriter::%s] could not write header of \"%s\"", __func__, fileName.c_str());
+		deflateEnd(&zStream);
+		fclose(file);
+		file = nullptr;
+		return;
+	}
+
+	const size_t numOut = outBuf.size() - zStream.avail_out;
+
+	// locate the raw header bytes inside the output (right behind the
+	// gzip wrapper and a 5-byte stored-block header, but do not rely on
+	// that) so they can be patched when the demo is closed
+	for (size_t i = 0; (i + sizeof(hdrBuf)) <= numOut; i++) {
+		if (memcmp(outBuf.data() + i, hdrBuf, sizeof(hdrBuf)) != 0)
+			continue;
+
+		headerOffset = long(i);
+		break;
+	}
+
+	if (headerOffset == -1)
+		LOG_L(L_WARNING, "[DemoStreamWriter::%s] unexpected deflate framing, statistics will not be written to \"%s\"", __func__, fileName.c_str());
+
+	fwrite(outBuf.data(), 1, numOut, file);
+
+	zStream.next_out = outBuf.data();
+	zStream.avail_out = outBuf.size();
+
+	if (deflateParams(&zStream, Z_BEST_COMPRESSION, Z_DEFAULT_STRATEGY) == Z_OK)
+		fwrite(outBuf.data(), 1, outBuf.size() - zStream.avail_out, file);
+
+	writeThread = spring::thread(&CDemoStreamWriter::WriterLoop, this);
+}
+
+
+void CDemoStreamWriter::Append(const char* data, size_t len)
+{
+	if (file == nullptr || len == 0)
+		return;
+
+	bool flush = false;
+
+	{
+		std::lock_guard<spring::mutex> lock(pendingMutex);
+
+		pendingData.append(data, len);
+		flush = (pendingData.size() >= FLUSH_BLOCK_SIZE);
+	}
+
+	if (flush)
+		pendingCond.notify_all();
+}
+
+
+void CDemoStreamWriter::WriterLoop()
 {
-	std::lock_guard<spring::mutex> lock(demoMutex);
+	std::string block;
+
+	while (true) {
+		bool done = false;
+
+		{
+			std::unique_lock<spring::mutex> lock(pendingMutex);
 
-	SetStream();
+			// also wake up periodically, so a crash does not take more
+			// than a few seconds of demo data with it
+			pendingCond.wait_for(lock, std::chrono::seconds(5), [&]() { return (stop || pendingData.size() >= FLUSH_BLOCK_SIZE); });
+
+			block.clear();
+			std::swap(block, pendingData);
+			done = stop;
+		}
+
+		if (!block.empty() || done)
+			WriteBlock(block, done? Z_FINISH: Z_SYNC_FLUSH);
+
+		if (done)
+			break;
+	}
+}
+
+void CDemoStreamWriter::WriteBlock(const std::string& block, int flush)
+{
+	// deflate does not modify its input
+	zStream.next_in = (Bytef*) const_cast<char*>(block.data());
+	zStream.avail_in = block.size();
+
+	do {
+		zStream.next_out = outBuf.data();
+		zStream.avail_out = outBuf.size();
+
+		const int ret = deflate(&zStream, flush);
+		const size_t numOut = outBuf.size() - zStream.avail_out;
+
+		if (ret != Z_OK && ret != Z_STREAM_END) {
+			LOG_L(L_ERROR, "[DemoStreamWriter::%s] deflate error %d", __func__, ret);
+			break;
+		}
+
+		if (numOut != 0 && fwrite(outBuf.data(), 1, numOut, file) != numOut) {
+			LOG_L(L_ERROR, "[DemoStreamWriter::%s] write error (%s)", __func__, strerror(errno));
+			break;
+		}
+	} while (zStream.avail_out == 0);
+
+	tailCrc = crc32(tailCrc, (const Bytef*) block.data(), block.size());
+	tailLen += block.size();
+
+	fflush(file);
+
+	if (syncPolicy >= 2)
+		SyncFile();
+}
+
+void CDemoStreamWriter::SyncFile()
+{
+	#ifndef _WIN32
+	fdatasync(fileno(file));
+	#else
+	_commit(_fileno(file));
+	#endif
+}
+
+
+void CDemoStreamWriter::Shutdown(const DemoFileHeader* finalHeader)
+{
+	if (file == nullptr)
+		return;
+
+	{
+		std::lock_guard<spring::mutex> lock(pendingMutex);
+		stop = true;
+	}
+
+	pendingCond.notify_all();
+
+	if (writeThread.joinable())
+		writeThread.join();
+
+	if (finalHeader != nullptr && headerOffset != -1) {
+		unsigned char hdrBuf[sizeof(DemoFileHeader)];
+		unsigned char tailBuf[8];
+
+		memcpy(hdrBuf, finalHeader, sizeof(hdrBuf));
+
+		// patch the stored header bytes, then fix up the gzip trailer
+		// (crc over the uncompressed stream, which just changed, plus
+		// its unchanged length modulo 2^32)
+		const uLong crc = crc32_combine(crc32(crc32(0L, Z_NULL, 0), hdrBuf, sizeof(hdrBuf)), tailCrc, tailLen);
+		const size_t len = GetStreamLen();
+
+		for (int i = 0; i < 4; i++) {
+			tailBuf[i    ] = (crc >> (i * 8)) & 0xFF;
+			tailBuf[i + 4] = (len >> (i * 8)) & 0xFF;
+		}
+
+		fseek(file, headerOffset, SEEK_SET);
+		fwrite(hdrBuf, 1, sizeof(hdrBuf), file);
+		fseek(file, -8, SEEK_END);
+		fwrite(tailBuf, 1, sizeof(tailBuf), file);
+		fflush(file);
+	}
+
+	if (syncPolicy >= 1)
+		SyncFile();
+
+	deflateEnd(&zStream);
+	fclose(file);
+	file = nullptr;
+}
+
+
+
+
+CDemoRecorder::CDemoRecorder() { memset(&fileHeader, 0, sizeof(fileHeader)); }
+CDemoRecorder::CDemoRecorder(CDemoRecorder&& r) { *this = std::move(r); }
+
+CDemoRecorder::CDemoRecorder(const std::string& mapName, const std::string& modName, bool serverDemo): isServerDemo(serverDemo)
+{
 	SetName(mapName, modName);
 	SetFileHeader();
-	WriteFileHeader(false);
 
-	file = gzopen(demoName.c_str(), "wb9");
+	// the initial on-disk header marks the demo as in-progress; it only
+	// gets patched once, when the demo is closed (readers handle demos
+	// with demoStreamSize == 0, i.e. of crashed games, by replaying up
+	// to EOF)
+	DemoFileHeader tmpHeader;
+	memcpy(&tmpHeader, &fileHeader, sizeof(fileHeader));
+	tmpHeader.demoStreamSize = 0;
+	tmpHeader.swab();
+
+	writer.reset(new CDemoStreamWriter(demoName, tmpHeader, configHandler->GetInt("DemoWriteSync")));
+
+	if (!writer->IsOpen())
+		writer.reset();
 }
 
 CDemoRecorder::~CDemoRecorder()
 {
-	if (file == nullptr)
+	if (writer == nullptr)
 		return;
 
 	WriteWinnerList();
 	WritePlayerStats();
 	WriteTeamStats();
-	WriteFileHeader(true);
-	WriteDemoFile();
-}
+	WriteSeekIndex();
 
+	DemoFileHeader tmpHeader;
+	memcpy(&tmpHeader, &fileHeader, sizeof(fileHeader));
+	tmpHeader.swab();
 
-void CDemoRecorder::SetStream()
-{
-	demoStreams[isServerDemo].clear();
-	demoStreams[isServerDemo].reserve(8 * 1024 * 1024);
+	writer->Close(tmpHeader);
+
+	LOG("[DemoRecorder::%s] wrote %s-demo \"%s\" (" _STPF_ " bytes)", __func__, (isServerDemo? "server": "client"), demoName.c_str(), writer->GetStreamLen());
+
+	writer.reset();
 }
 
+
 void CDemoRecorder::SetFileHeader()
 {
 	memset(&fileHeader, 0, sizeof(DemoFileHeader));
@@ -74,55 +371,46 @@ void CDemoRecorder::SetFileHeader()
 	fileHeader.teamStatElemSize = sizeof(TeamStatistics);
 	fileHeader.teamStatPeriod = TeamStatistics::statsPeriod;
 	fileHeader.winningAllyTeamsSize = 0;
-}
-
-void CDemoRecorder::WriteDemoFile()
-{
-	// zlib FAQ claims the lib is thread-safe, "however any library routines that zlib uses and
-	// any application-provided memory allocation routines must also be thread-safe. zlib's gz*
-	// functions use stdio library routines, and most of zlib's functions use the library memory
-	// allocation routines by default" (so code below should be OK)
-	// gz* should usually be finished before ctor runs again when reloading, but take no chances
-	std::string& data = demoStreams[isServerDemo];
-	std::function<void(gzFile, std::string&)> func = [](gzFile file, std::string& data) {
-		std::lock_guard<spring::mutex> lock(demoMutex);
-
-		gzwrite(file, data.c_str(), data.size());
-		gzflush(file, Z_FINISH);
-		gzclose(file);
-	};
-
-	LOG("[DemoRecorder::%s] writing %s-demo \"%s\" (" _STPF_ " bytes)", __func__, (isServerDemo? "server": "client"), demoName.c_str(), data.size());
-
-	#ifndef _WIN32
-	// NOTE: can not use ThreadPool for this directly here, workers are already gone
-	// FIXME: does not currently (august 2017) compile on Windows mingw buildbots
-	ThreadPool::AddExtJob(spring::thread(std::move(func), file, std::ref(data)));
-	#else
-	ThreadPool::AddExtJob(std::move(std::async(std::launch::async, std::move(func), file, std::ref(data))));
-	#endif
+	fileHeader.seekIndexSize = 0;
+	fileHeader.seekIndexPeriod = DEMO_SEEK_INDEX_PERIOD;
 }
 
 void CDemoRecorder::WriteSetupText(const std::string& text)
 {
+	if (writer == nullptr)
+		return;
+
 	int length = text.length();
 	while (text[length - 1] == '\0') {
 		--length;
 	}
 
 	fileHeader.scriptSize = length;
-	demoStreams[isServerDemo].append(text.c_str(), length);
+	writer->Append(text.c_str(), length);
 }
 
 void CDemoRecorder::SaveToDemo(const unsigned char* buf, const unsigned length, const float modGameTime)
 {
+	if (writer == nullptr)
+		return;
+
+	// one index entry per seekIndexPeriod of game time, pointing
+	// at the first chunk past the interval boundary
+	if (seekIndex.empty() || modGameTime >= (seekIndex.back().modGameTime + fileHeader.seekIndexPeriod)) {
+		DemoSeekIndexEntry entry;
+
+		entry.modGameTime = modGameTime;
+		entry.streamOffset = fileHeader.demoStreamSize;
+		seekIndex.push_back(entry);
+	}
+
 	DemoStreamChunkHeader chunkHeader;
 
 	chunkHeader.modGameTime = modGameTime;
 	chunkHeader.length = length;
 	chunkHeader.swab();
-	demoStreams[isServerDemo].append(reinterpret_cast<const char*>(&chunkHeader), sizeof(chunkHeader));
-	demoStreams[isServerDemo].append(reinterpret_cast<const char*>(buf), length);
+	writer->Append(reinterpret_cast<const char*>(&chunkHeader), sizeof(chunkHeader));
+	writer->Append(reinterpret_cast<const char*>(buf), length);
 	fileHeader.demoStreamSize += (length + sizeof(chunkHeader));
 }
 
@@ -160,7 +448,7 @@ void CDemoRecorder::SetName(const std::string& mapName, const std::string& modNa
 void CDemoRecorder::SetGameID(const unsigned char* buf)
 {
 	memcpy(&fileHeader.gameID, buf, sizeof(fileHeader.gameID));
-	WriteFileHeader(false);
+	// the on-disk header is only patched once, when the demo is closed
 }
 
 void CDemoRecorder::SetTime(int gameTime, int wallclockTime)
@@ -215,42 +503,19 @@ void CDemoRecorder::SetWinningAllyTeams(const std::vector<unsigned char>& winnin
 	winningAllyTeams = winningAllyTeamIDs;
 }
 
-/** @brief Write DemoFileHeader
-Write the DemoFileHeader at the start of the file and restores the original
-position in the file afterwards. */
-unsigned int CDemoRecorder::WriteFileHeader(bool updateStreamLength)
-{
-	DemoFileHeader tmpHeader;
-	memcpy(&tmpHeader, &fileHeader, sizeof(fileHeader));
-
-	if (!updateStreamLength)
-		tmpHeader.demoStreamSize = 0;
-
-	// to little endian
-	tmpHeader.swab();
-
-	if (demoStreams[isServerDemo].empty()) {
-		demoStreams[isServerDemo].append(reinterpret_cast<const char*>(&tmpHeader), sizeof(tmpHeader));
-	} else {
-		assert(demoStreams[isServerDemo].size() >= sizeof(tmpHeader));
-		memcpy(&demoStreams[isServerDemo][0], reinterpret_cast<const char*>(&tmpHeader), sizeof(tmpHeader)); // no non-const .data() until C++17
-	}
-
-	return (demoStreams[isServerDemo].size());
-}
-
 /** @brief Write the CPlayer::Statistics at the current position in the file. */
 void CDemoRecorder::WritePlayerStats()
 {
-	const size_t pos = demoStreams[isServerDemo].size();
+	size_t size = 0;
 
 	for (PlayerStatistics& stats: playerStats) {
 		stats.swab();
-		demoStreams[isServerDemo].append(reinterpret_cast<const char*>(&stats), sizeof(PlayerStatistics));
+		writer->Append(reinterpret_cast<const char*>(&stats), sizeof(PlayerStatistics));
+		size += sizeof(PlayerStatistics);
 	}
 
 	fileHeader.numPlayers = playerStats.size();
-	fileHeader.playerStatSize = int(demoStreams[isServerDemo].size() - pos);
+	fileHeader.playerStatSize = int(size);
 
 	playerStats.clear();
 }
@@ -263,38 +528,51 @@ void CDemoRecorder::WriteWinnerList()
 	if (fileHeader.numTeams == 0)
 		return;
 
-	const size_t pos = demoStreams[isServerDemo].size();
-
 	// Write the array of winningAllyTeams.
 	for (size_t i = 0; i < winningAllyTeams.size(); i++) { // NOLINT{modernize-loop-convert}
-		demoStreams[isServerDemo].append(reinterpret_cast<const char*>(&winningAllyTeams[i]), sizeof(unsigned char));
+		writer->Append(reinterpret_cast<const char*>(&winningAllyTeams[i]), sizeof(unsigned char));
 	}
 
-	winningAllyTeams.clear();
+	fileHeader.winningAllyTeamsSize = int(winningAllyTeams.size());
 
-	fileHeader.winningAllyTeamsSize = int(demoStreams[isServerDemo].size() - pos);
+	winningAllyTeams.clear();
 }
 
 /** @brief Write the TeamStatistics at the current position in the file. */
 void CDemoRecorder::WriteTeamStats()
 {
-	const size_t pos = demoStreams[isServerDemo].size();
+	size_t size = 0;
 
 	// Write array of dwords indicating number of TeamStatistics per team.
 	for (std::vector<TeamStatistics>& history: teamStats) {
 		unsigned int c = swabDWord(history.size());
-		demoStreams[isServerDemo].append(reinterpret_cast<const char*>(&c), sizeof(unsigned int));
+		writer->Append(reinterpret_cast<const char*>(&c), sizeof(unsigned int));
+		size += sizeof(unsigned int);
 	}
 
 	// Write big array of TeamStatistics.
 	for (std::vector<TeamStatistics>& history: teamStats) {
 		for (TeamStatistics& stats: history) {
 			stats.swab();
-			demoStreams[isServerDemo].append(reinterpret_cast<const char*>(&stats), sizeof(TeamStatistics));
+			writer->Append(reinterpret_cast<const char*>(&stats), sizeof(TeamStatistics));
+			size += sizeof(TeamStatistics);
 		}
 	}
 
-	fileHeader.teamStatSize = int(demoStreams[isServerDemo].size() - pos);
+	fileHeader.teamStatSize = int(size);
 
 	teamStats.clear();
 }
+
+/** @brief Write the seek index at the current position in the file. */
+void CDemoRecorder::WriteSeekIndex()
+{
+	fileHeader.seekIndexSize = int(seekIndex.size() * sizeof(DemoSeekIndexEntry));
+
+	for (DemoSeekIndexEntry& entry: seekIndex) {
+		entry.swab();
+		writer->Append(reinterpret_cast<const char*>(&entry), sizeof(entry));
+	}
+
+	seekIndex.clear();
+}
@@ -3,14 +3,17 @@
 #ifndef DEMO_RECORDER
 #define DEMO_RECORDER
 
+#include <cstring>
+#include <memory>
 #include <vector>
 #include <sstream>
-#include <zlib.h>
 
 #include "Demo.h"
 #include "Game/Players/PlayerStatistics.h"
 #include "Sim/Misc/TeamStatistics.h"
 
+class CDemoStreamWriter;
+
 
 /**
  * @brief Used to record demos
@@ -18,11 +21,13 @@
 class CDemoRecorder : public CDemo
 {
 public:
-	CDemoRecorder() { memset(&fileHeader, 0, sizeof(fileHeader)); }
+	// defined out-of-line, all ctors need the definition of CDemoStreamWriter
+	// to be able to destroy <writer> during stack unwinding
+	CDemoRecorder();
 	CDemoRecorder(const std::string& mapName, const std::string& modName, bool serverDemo);
 
 	CDemoRecorder(const CDemoRecorder&) = delete;
-	CDemoRecorder(CDemoRecorder&& r) { *this = std::move(r); }
+	CDemoRecorder(CDemoRecorder&& r);
 
 	~CDemoRecorder();
 
@@ -32,24 +37,24 @@ public:
 		memcpy(&fileHeader, &r.fileHeader, sizeof(fileHeader));
 		memset(&r.fileHeader, 0, sizeof(fileHeader));
 
-		std::swap(file, r.file);
+		std::swap(writer, r.writer);
 
 		std::swap(demoName, r.demoName);
 		std::swap(playerStats, r.playerStats);
 		std::swap(teamStats, r.teamStats);
 		std::swap(winningAllyTeams, r.winningAllyTeams);
+		std::swap(seekIndex, r.seekIndex);
 
 		std::swap(isServerDemo, r.isServerDemo);
 		return *this;
 	}
 
 
-	bool IsValid() const { return (file != nullptr); }
+	bool IsValid() const { return (writer != nullptr); }
 
 	void WriteSetupText(const std::string& text);
 	void SaveToDemo(const unsigned char* buf, const unsigned length, const float modGameTime);
 
-	void SetStream();
 	void SetName(const std::string& mapName, const std::string& modName);
 	const std::string& GetName() const { return demoName; }
 
@@ -63,19 +68,21 @@ public:
 	void SetWinningAllyTeams(const std::vector<unsigned char>& winningAllyTeams);
 
 private:
-	unsigned int WriteFileHeader(bool updateStreamLength);
 	void SetFileHeader();
 	void WritePlayerStats();
 	void WriteTeamStats();
 	void WriteWinnerList();
-	void WriteDemoFile();
+	void WriteSeekIndex();
 
 private:
-	gzFile file = nullptr;
+	// background gzip writer, demo packets are appended to its pending
+	// buffer and compressed + flushed in large blocks off the hot path
+	std::unique_ptr<CDemoStreamWriter> writer;
 
 	std::vector<PlayerStatistics> playerStats;
 	std::vector< std::vector<TeamStatistics> > teamStats;
 	std::vector<unsigned char> winningAllyTeams;
+	std::vector<DemoSeekIndexEntry> seekIndex;
 
 	bool isServerDemo = false;
 };
@@ -4,8 +4,16 @@
 #include "CregLoadSaveHandler.h"
 #include "LuaLoadSaveHandler.h"
 #include "Game/GameSetup.h"
+#include "Sim/Misc/GlobalConstants.h"
+#include "System/Config/ConfigHandler.h"
 #include "System/FileSystem/FileSystem.h"
 #include "System/Log/ILog.h"
+#include "System/StringUtil.h"
+
+CONFIG(int, AutoSaveInterval)
+	.defaultValue(0)
+	.minimumValue(0)
+	.description("Time in minutes between background autosaves, 0 disables them.");
 
 SaveFileData globalSaveFileData;
 
@@ -45,6 +53,29 @@ bool ILoadSaveHandler::CreateSave(
 	return true;
 }
 
+void ILoadSaveHandler::ScheduleAutoSave(int frameNum)
+{
+	const int interval = configHandler->GetInt("AutoSaveInterval") * 60 * GAME_SPEED;
+
+	if (interval <= 0 || frameNum <= 0 || (frameNum % interval) != 0)
+		return;
+
+	// never clobber a manual save queued this frame
+	if (!globalSaveFileData.name.empty())
+		return;
+
+	// alternate between two slots so a crash during the write can
+	// not also take out the previous autosave; the actual save runs
+	// through the regular queue, i.e. state is serialized between
+	// frames and compressed plus written out on a pool thread
+	static int slot = 0;
+
+	globalSaveFileData.name = FileSystem::EnsurePathSepAtEnd("Saves") + "autosave" + IntToString(slot = 1 - slot) + ".ssf";
+	globalSaveFileData.args = "-y";
+
+	LOG("[ILoadSaveHandler::%s] queued autosave to \"%s\" at frame %d", __func__, globalSaveFileData.name.c_str(), frameNum);
+}
+
 std::string ILoadSaveHandler::FindSaveFile(const std::string& file)
 {
 	if (FileSystem::FileExists(file))
@@ -17,6 +17,8 @@ public:
 	static ILoadSaveHandler* CreateHandler(const std::string& saveFile);
 
 	static bool CreateSave(const std::string& saveFile, const std::string& saveArgs);
+	/// queues a rotating background save every AutoSaveInterval minutes
+	static void ScheduleAutoSave(int frameNum);
 	static bool CreateSave(SaveFileData fileData) {
 		if (fileData.name.empty())
 			return false;
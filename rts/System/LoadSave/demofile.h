@@ -40,6 +40,8 @@
  *         CTeam::Statistics for each team.
  *       - Array of all CTeam::Statistics (total number of items is the
  *         sum of the elements in the array of dwords).
+ *     - Seek index, one DemoSeekIndexEntry per seekIndexPeriod of game
+ *       time (seekIndexSize bytes in total, 0 for old demos).
  *
  * The header is designed to be extensible: it contains a version field and a
  * headerSize field to support this. The version field is a major version number
@@ -70,6 +72,8 @@ struct DemoFileHeader
 	int teamStatElemSize;         ///< sizeof(CTeam::Statistics)
 	int teamStatPeriod;           ///< Interval (in seconds) between team stats.
 	int winningAllyTeamsSize;     ///< The size of the vector of the winning ally teams
+	int seekIndexSize;            ///< Size of the entire seek-index chunk (0 if not present).
+	int seekIndexPeriod;          ///< Interval (in seconds game time) between seek-index entries.
 
 
 	/// Change structure from host endian to little endian or vice versa.
@@ -89,6 +93,8 @@ struct DemoFileHeader
 		swabDWordInPlace(teamStatElemSize);
 		swabDWordInPlace(teamStatPeriod);
 		swabDWordInPlace(winningAllyTeamsSize);
+		swabDWordInPlace(seekIndexSize);
+		swabDWordInPlace(seekIndexPeriod);
 	}
 };
 
@@ -115,6 +121,27 @@ struct DemoStreamChunkHeader
 	}
 };
 
+/**
+ * @brief Spring demo seek-index entry
+ *
+ * Recorded once per seekIndexPeriod of game time, each entry points at a
+ * chunk header inside the demo stream so replay viewers can reposition
+ * the stream near a given game time without walking all chunks. Note
+ * that the simulation state at that point must be obtained separately
+ * (e.g. from a savegame snapshot); the index only locates the packets.
+ */
+struct DemoSeekIndexEntry
+{
+	float modGameTime;          ///< Gametime of the chunk this entry points at.
+	std::uint32_t streamOffset; ///< Offset of that chunk from the start of the demo stream.
+
+	/// Change structure from host endian to little endian or vice versa.
+	void swab() {
+		swabFloatInPlace(modGameTime);
+		swabDWordInPlace(streamOffset);
+	}
+};
+
 #pragma pack(pop)
 
 #endif // DEMO_FILE_H
@@ -0,0 +1,242 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "AsyncSink.h"
+#include "Backend.h"
+#include "Level.h"
+#include "System/MainDefines.h"
+#include "System/Misc/SpringTime.h"
+#include "System/Threading/SpringThreading.h"
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
+
+namespace log_async {
+	// must be a power of two (index masking)
+	static constexpr uint32_t RING_SIZE = 256;
+	static constexpr uint32_t RING_MASK = RING_SIZE - 1;
+
+	// keep cells small; overlong records are truncated rather than
+	// making the ring several MB large for the rare huge message
+	static constexpr size_t MAX_MSG_SIZE = 1024 - (sizeof(std::atomic<uint32_t>) + sizeof(int) + sizeof(const char*));
+
+	struct AsyncLogRecord {
+		std::atomic<uint32_t> seq;
+
+		int level;
+		// section names are static literals, storing the pointer is safe
+		const char* section;
+		char msg[MAX_MSG_SIZE];
+	};
+
+	// bounded multi-producer single-consumer ring (Vyukov-style); a
+	// cell is writable when its sequence equals the producer position
+	// and readable when it equals that position plus one
+	static std::array<AsyncLogRecord, RING_SIZE> ring;
+
+	static std::atomic<uint32_t> tailPos = {0};
+	static uint32_t headPos = 0; // writer thread only
+
+	static std::atomic<unsigned int> numDroppedRecords = {0};
+	static std::atomic<bool> threadRunning = {false};
+
+	static std::array<log_sink_ptr, 8> sinks = {{nullptr}};
+	static size_t numSinks = 0;
+	static spring::spinlock sinksLock;
+
+	static spring::thread writerThread;
+
+
+	static void InitRing() {
+		for (uint32_t i = 0; i < RING_SIZE; i++) {
+			ring[i].seq.store(i, std::memory_order_relaxed);
+		}
+
+		tailPos.store(0, std::memory_order_relaxed);
+		headPos = 0;
+	}
+
+	static bool Enqueue(int level, const char* section, const char* record)
+	{
+		uint32_t pos = tailPos.load(std::memory_order_relaxed);
+
+		for (;;) {
+			AsyncLogRecord& cell = ring[pos & RING_MASK];
+			const int32_t dif = int32_t(cell.seq.load(std::memory_order_acquire)) - int32_t(pos);
+
+			if (dif == 0) {
+				// cell free; on failure pos was reloaded by the CAS
+				if (tailPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+
+				continue;
+			}
+
+			// consumer has not freed this cell yet, ring is full
+			if (dif < 0)
+				return false;
+
+			pos = tailPos.load(std::memory_order_relaxed);
+		}
+
+		AsyncLogRecord& cell = ring[pos & RING_MASK];
+
+		cell.level = level;
+		cell.section = section;
+
+		STRNCPY(cell.msg, record, sizeof(cell.msg) - 1);
+		cell.msg[sizeof(cell.msg) - 1] = 0;
+
+		// publish
+		cell.seq.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	static bool Dequeue(AsyncLogRecord& out)
+	{
+		AsyncLogRecord& cell = ring[headPos & RING_MASK];
+
+		if (int32_t(cell.seq.load(std::memory_order_acquire)) - int32_t(headPos + 1) < 0)
+			return false;
+
+		out.level = cell.level;
+		out.section = cell.section;
+		memcpy(out.msg, cell.msg, sizeof(cell.msg));
+
+		// mark the cell writable for the producer one lap ahead
+		cell.seq.store(headPos + RING_SIZE, std::memory_order_release);
+		headPos += 1;
+		return true;
+	}
+
+
+	static void ForwardRecord(const AsyncLogRecord& rec)
+	{
+		sinksLock.lock();
+
+		for (size_t i = 0; i < numSinks; i++) {
+			sinks[i](rec.level, rec.section, rec.msg);
+		}
+
+		sinksLock.unlock();
+	}
+
+	static void DrainRing()
+	{
+		AsyncLogRecord rec;
+
+		while (Dequeue(rec)) {
+			ForwardRecord(rec);
+		}
+	}
+
+	static void WriterLoop()
+	{
+		while (threadRunning.load(std::memory_order_relaxed)) {
+			AsyncLogRecord rec;
+
+			if (!Dequeue(rec)) {
+				spring_msecs(10).sleep(true);
+				continue;
+			}
+
+			ForwardRecord(rec);
+		}
+
+		DrainRing();
+	}
+
+
+	// entry point registered with the backend; runs on whatever
+	// thread called LOG(), so it must stay allocation- and lock-free
+	static void SinkRecord(int level, const char* section, const char* record)
+	{
+		if (Enqueue(level, section, record))
+			return;
+
+		numDroppedRecords.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	// crash handling; flush whatever is still queued on this thread
+	static void SinkCleanup() { DrainRing(); }
+}
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void log_async_registerSink(log_sink_ptr sink)
+{
+	assert(sink != nullptr);
+
+	log_async::sinksLock.lock();
+
+	if (log_async::numSinks == log_async::sinks.size()) {
+		log_async::sinksLock.unlock();
+		return;
+	}
+
+	log_async::sinks[log_async::numSinks++] = sink;
+
+	const bool spawnThread = (log_async::numSinks == 1);
+
+	log_async::sinksLock.unlock();
+
+	if (!spawnThread)
+		return;
+
+	log_async::InitRing();
+	log_async::threadRunning.store(true);
+	log_async::writerThread = spring::thread(&log_async::WriterLoop);
+
+	log_backend_registerSink(&log_async::SinkRecord);
+	log_backend_registerCleanup(&log_async::SinkCleanup);
+}
+
+void log_async_unregisterSink(log_sink_ptr sink)
+{
+	log_async::sinksLock.lock();
+
+	bool found = false;
+
+	for (size_t i = 0; i < log_async::numSinks; i++) {
+		found |= (log_async::sinks[i] == sink);
+
+		// remove without leaving holes
+		if (found && ((i + 1) < log_async::numSinks))
+			log_async::sinks[i] = log_async::sinks[i + 1];
+	}
+
+	if (found)
+		log_async::sinks[--log_async::numSinks] = nullptr;
+
+	const bool joinThread = (found && log_async::numSinks == 0);
+
+	log_async::sinksLock.unlock();
+
+	if (!joinThread)
+		return;
+
+	// stop enqueueing before draining, then join; the final drain in
+	// WriterLoop forwards to an empty sink array which is harmless
+	log_backend_unregisterSink(&log_async::SinkRecord);
+	log_backend_unregisterCleanup(&log_async::SinkCleanup);
+
+	log_async::threadRunning.store(false);
+
+	if (log_async::writerThread.joinable())
+		log_async::writerThread.join();
+}
+
+unsigned int log_async_getNumDroppedRecords(void)
+{
+	return (log_async::numDroppedRecords.load(std::memory_order_relaxed));
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
@@ -0,0 +1,50 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef LOG_ASYNC_SINK_H
+#define LOG_ASYNC_SINK_H
+
+/**
+ * This is an asynchronous routing layer for the ILog.h logging API.
+ * Records are enqueued into a bounded lock-free ring on the calling
+ * thread and forwarded to the registered downstream sinks from a
+ * dedicated writer thread, so verbose diagnostic sections no longer
+ * stall the sim on sink (disk, console) latency. When the ring is
+ * full, records are dropped and counted instead of blocking.
+ */
+
+#include "Backend.h" // log_sink_ptr
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name logging_sink_async_control
+ * ILog.h async-sink control interface.
+ */
+///@{
+
+/**
+ * Start routing log records to the supplied sink from the writer
+ * thread; the thread is spawned when the first sink is registered.
+ * The sink must be thread-safe with respect to the render/sim
+ * threads only if it is also registered synchronously elsewhere.
+ */
+void log_async_registerSink(log_sink_ptr sink);
+
+/**
+ * Stop routing log records to the supplied sink; unregistering the
+ * last sink joins the writer thread after draining the ring.
+ */
+void log_async_unregisterSink(log_sink_ptr sink);
+
+/// number of records dropped so far because the ring was full
+unsigned int log_async_getNumDroppedRecords(void);
+
+///@}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // LOG_ASYNC_SINK_H
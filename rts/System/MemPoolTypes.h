@@ -3,6 +3,7 @@
 #ifndef MEMPOOL_TYPES_H
 #define MEMPOOL_TYPES_H
 
+#include <algorithm> // max
 #include <cassert>
 #include <cstring> // memset
 
@@ -16,6 +17,22 @@
 #include "System/ContainerUtil.h"
 #include "System/SafeUtil.h"
 
+// per-pool occupancy and failure counters; exhaustion used to be
+// completely silent in release builds so these are kept up to date
+// unconditionally (the cost is a handful of integer ops per event)
+struct SMemPoolStats {
+	size_t numAllocs = 0; // lifetime number of pages handed out
+	size_t numFrees  = 0; // lifetime number of pages given back
+	size_t numFails  = 0; // allocation requests the pool could not serve
+	size_t numInUse  = 0; // pages currently handed out
+	size_t maxInUse  = 0; // high-water mark of numInUse
+
+	void TrackAlloc() { numAllocs++; maxInUse = std::max(maxInUse, ++numInUse); }
+	void TrackFree() { numFrees++; numInUse--; }
+	void TrackFail() { numFails++; }
+	void Clear() { *this = {}; }
+};
+
 template<size_t S> struct DynMemPool {
 public:
 	void* allocMem(size_t size) {
@@ -36,6 +53,7 @@ public:
 		m = pages[curr_page_index = i].data();
 
 		table.emplace(m, i);
+		stats.TrackAlloc();
 		return m;
 	}
 
@@ -56,6 +74,7 @@ public:
 
 		indcs.push_back(pair.second);
 		table.erase(pair.first);
+		stats.TrackFree();
 	}
 
 
@@ -78,12 +97,16 @@ public:
 	bool mapped(void* p) const { return (table.find(p) != table.end()); }
 	bool alloced(void* p) const { return ((curr_page_index < pages.size()) && (pages[curr_page_index].data() == p)); }
 
+	const SMemPoolStats& get_stats() const { return stats; }
+
 	void clear() {
 		pages.clear();
 		indcs.clear();
 		table.clear();
 
 		curr_page_index = 0;
+
+		stats.Clear();
 	}
 	void reserve(size_t n) {
 		indcs.reserve(n);
@@ -98,6 +121,8 @@ private:
 	spring::unsynced_map<void*, size_t> table;
 
 	size_t curr_page_index = 0;
+
+	SMemPoolStats stats;
 };
 
 
@@ -119,8 +144,10 @@ public:
 
 		if (indcs.empty()) {
 			// pool is full
-			if (num_chunks == N)
+			if (num_chunks == N) {
+				stats.TrackFail();
 				return ptr;
+			}
 
 			assert(chunks[num_chunks] == nullptr);
 			chunks[num_chunks].reset(new t_chunk_mem());
@@ -139,6 +166,7 @@ public:
 
 		assert(size <= PAGE_SIZE());
 		memcpy(ptr = page_mem(page_index = idx), &idx, sizeof(idx));
+		stats.TrackAlloc();
 		return (ptr + sizeof(idx));
 	}
 
@@ -160,6 +188,7 @@ public:
 		memset(page_mem(idx), 0, sizeof(idx) + S);
 
 		indcs.push_back(idx);
+		stats.TrackFree();
 	}
 
 
@@ -176,6 +205,8 @@ public:
 		}
 
 		page_index = 0;
+
+		stats.Clear();
 	}
 
 
@@ -207,6 +238,8 @@ public:
 	bool mapped(void* ptr) const { return ((page_idx(ptr) < (num_chunks * K)) && (page_mem(page_idx(ptr), sizeof(uint32_t)) == ptr)); }
 	bool alloced(void* ptr) const { return ((page_index < (num_chunks * K)) && (page_mem(page_index, sizeof(uint32_t)) == ptr)); }
 
+	const SMemPoolStats& get_stats() const { return stats; }
+
 private:
 	// first sizeof(uint32_t) bytes are reserved for index
 	typedef std::array<uint8_t[sizeof(uint32_t) + S], K> t_chunk_mem;
@@ -217,6 +250,8 @@ private:
 
 	size_t num_chunks = 0;
 	size_t page_index = 0;
+
+	SMemPoolStats stats;
 };
 
 
@@ -232,6 +267,12 @@ public:
 
 		size_t i = 0;
 
+		// NOTE: exhaustion is a hard error, but gets counted before the
+		// assert so release builds at least leave a trace of it in the
+		// stats instead of silently corrupting memory
+		if (!can_alloc())
+			stats.TrackFail();
+
 		assert(can_alloc());
 
 		if (free_page_count == 0) {
@@ -240,6 +281,7 @@ public:
 			i = indcs[--free_page_count];
 		}
 
+		stats.TrackAlloc();
 		return (pages[curr_page_index = i].data());
 	}
 
@@ -257,6 +299,8 @@ public:
 
 		// mark page as free
 		indcs[free_page_count++] = base_offset(m) / PAGE_SIZE();
+
+		stats.TrackFree();
 	}
 
 
@@ -283,6 +327,8 @@ public:
 	bool can_alloc() const { return (used_page_count < NUM_PAGES() || free_page_count > 0); }
 	bool can_free() const { return (free_page_count < NUM_PAGES()); }
 
+	const SMemPoolStats& get_stats() const { return stats; }
+
 	void reserve(size_t) {} // no-op
 	void clear() {
 		std::memset(pages.data(), 0, total_size());
@@ -291,6 +337,8 @@ public:
 		used_page_count = 0;
 		free_page_count = 0;
 		curr_page_index = 0;
+
+		stats.Clear();
 	}
 
 private:
@@ -300,6 +348,52 @@ private:
 	size_t used_page_count = 0;
 	size_t free_page_count = 0; // indcs[fpc-1] is the last recycled page
 	size_t curr_page_index = 0;
+
+	SMemPoolStats stats;
+};
+
+
+// never returns memory to the CRT; freed blocks go onto per-size
+// free-lists for reuse by the next same-sized request, so long-lived
+// containers with steady churn (e.g. the per-unit command queues)
+// stop hitting the heap once warmed up
+// NOTE: not thread-safe, only use from (sim) containers that are
+// never touched concurrently
+struct RecyclingMemPool {
+public:
+	static void* allocMem(size_t size) {
+		auto& freeBlocks = FreeBlocks()[size];
+
+		if (!freeBlocks.empty())
+			return (spring::VectorBackPop(freeBlocks));
+
+		return (::operator new(size));
+	}
+
+	static void freeMem(void* m, size_t size) {
+		FreeBlocks()[size].push_back(m);
+	}
+
+private:
+	static spring::unordered_map<size_t, std::vector<void*>>& FreeBlocks() {
+		static spring::unordered_map<size_t, std::vector<void*>> freeBlocks;
+		return freeBlocks;
+	}
+};
+
+
+template<typename T> class RecyclingAllocator {
+public:
+	using value_type = T;
+
+	RecyclingAllocator() = default;
+	template<typename U> RecyclingAllocator(const RecyclingAllocator<U>&) {}
+
+	T* allocate(size_t n) { return (static_cast<T*>(RecyclingMemPool::allocMem(n * sizeof(T)))); }
+	void deallocate(T* p, size_t n) { RecyclingMemPool::freeMem(p, n * sizeof(T)); }
+
+	template<typename U> bool operator == (const RecyclingAllocator<U>&) const { return true; }
+	template<typename U> bool operator != (const RecyclingAllocator<U>&) const { return false; }
 };
 
 #endif
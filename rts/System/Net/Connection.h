@@ -65,6 +65,12 @@ public:
 	unsigned int GetNumQueuedPings() const { return numPings; }
 	virtual unsigned int GetPacketQueueSize() const { return 0; }
 
+	/**
+	 * Smoothed variation (in milliseconds) of the inter-arrival times of
+	 * frame messages; clients use this to size their smoothing buffer.
+	 */
+	virtual float GetFramePacketJitter() const { return 0.0f; }
+
 	virtual std::string Statistics() const = 0;
 	virtual std::string GetFullAddress() const = 0;
 	virtual void Unmute() = 0;
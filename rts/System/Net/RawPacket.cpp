@@ -5,15 +5,83 @@
 
 #include "RawPacket.h"
 
+#include "System/ContainerUtil.h"
 #include "System/Log/ILog.h"
+#include "System/Threading/SpringThreading.h"
 
 namespace netcode
 {
 
+// buffers are binned by rounding their size up to the next power of
+// two (so a bin serves all requests it previously satisfied), capped
+// in count to bound the warmup cost of a burst of large packets
+static constexpr uint32_t POOL_MIN_BUF_SIZE = 16;
+static constexpr uint32_t POOL_MAX_BUF_SIZE = 4096;
+static constexpr size_t POOL_MAX_BIN_BUFS = 1024;
+
+static std::vector<uint8_t*> poolBins[9];
+static_assert((POOL_MIN_BUF_SIZE << 8) == POOL_MAX_BUF_SIZE, "bin count out of sync with size bounds");
+static spring::mutex poolMutex;
+
+static uint32_t PoolBufSize(uint32_t size)
+{
+	uint32_t binSize = POOL_MIN_BUF_SIZE;
+
+	while (binSize < size)
+		binSize <<= 1;
+
+	return binSize;
+}
+
+static uint32_t PoolBinIndex(uint32_t binSize)
+{
+	uint32_t index = 0;
+
+	while ((POOL_MIN_BUF_SIZE << index) < binSize)
+		index++;
+
+	return index;
+}
+
+
+uint8_t* RawPacket::AllocBuf(uint32_t size)
+{
+	if (size > POOL_MAX_BUF_SIZE)
+		return (new uint8_t[size]);
+
+	const uint32_t binSize = PoolBufSize(size);
+
+	{
+		std::lock_guard<spring::mutex> lock(poolMutex);
+		std::vector<uint8_t*>& bin = poolBins[PoolBinIndex(binSize)];
+
+		if (!bin.empty())
+			return (spring::VectorBackPop(bin));
+	}
+
+	return (new uint8_t[binSize]);
+}
+
+void RawPacket::FreeBuf(uint8_t* buf, uint32_t size)
+{
+	if (size <= POOL_MAX_BUF_SIZE) {
+		std::lock_guard<spring::mutex> lock(poolMutex);
+		std::vector<uint8_t*>& bin = poolBins[PoolBinIndex(PoolBufSize(size))];
+
+		if (bin.size() < POOL_MAX_BIN_BUFS) {
+			bin.push_back(buf);
+			return;
+		}
+	}
+
+	delete[] buf;
+}
+
+
 RawPacket::RawPacket(const uint8_t* const tdata, const uint32_t newLength): length(newLength)
 {
 	if (length > 0) {
-		data = new uint8_t[length];
+		data = AllocBuf(length);
 		memcpy(data, tdata, length);
 	} else {
 		LOG_L(L_ERROR, "[%s] tried to pack a zero-length packet", __func__);
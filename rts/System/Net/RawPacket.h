@@ -39,7 +39,7 @@ public:
 		if (length == 0)
 			return;
 
-		data = new uint8_t[length];
+		data = AllocBuf(length);
 	}
 
 	RawPacket(const uint32_t length, uint8_t msgID): RawPacket(length) {
@@ -116,12 +116,23 @@ public:
 		if (length == 0)
 			return;
 
-		delete[] data;
+		FreeBuf(data, length);
 		data = nullptr;
 
 		length = 0;
 	}
 
+	/**
+	 * Packet payload buffers are recycled through per-size free-lists
+	 * so the steady per-frame message churn (NETMSG_NEWFRAME, keyframes,
+	 * commands, ...) stops hitting the heap once warmed up; thread-safe
+	 * since packets are created and released on different threads
+	 * (client, server and demo-recorder). Sizes above the pooling cutoff
+	 * (bulk transfers like map and mod data) fall through to plain new[].
+	 */
+	static uint8_t* AllocBuf(uint32_t size);
+	static void FreeBuf(uint8_t* buf, uint32_t size);
+
 public:
 	uint8_t id = 0;
 	uint8_t* data = nullptr;
@@ -2,6 +2,10 @@
 
 #include "Socket.h"
 
+#ifdef __linux__
+#include <sys/socket.h>
+#endif
+
 #include "lib/streflop/streflop_cond.h"
 
 #include "System/Log/ILog.h"
@@ -13,6 +17,146 @@ namespace netcode
 
 asio::io_service netservice;
 
+
+void SendDatagramBatch::Enqueue(const asio::ip::udp::endpoint& dest, const std::vector<std::uint8_t>& data)
+{
+	if (numUsed == datagrams.size())
+		datagrams.emplace_back();
+
+	Datagram& dg = datagrams[numUsed++];
+
+	dg.dest = dest;
+	dg.data = data;
+}
+
+void SendDatagramBatch::Flush(asio::ip::udp::socket& sock)
+{
+	if (numUsed == 0)
+		return;
+
+	size_t numSent = 0;
+
+#ifdef __linux__
+	{
+		std::vector<mmsghdr> msgVec(numUsed);
+		std::vector<iovec> iovVec(numUsed);
+
+		for (size_t i = 0; i < numUsed; i++) {
+			Datagram& dg = datagrams[i];
+
+			iovVec[i].iov_base = dg.data.data();
+			iovVec[i].iov_len = dg.data.size();
+
+			msgVec[i].msg_hdr.msg_name = dg.dest.data();
+			msgVec[i].msg_hdr.msg_namelen = dg.dest.size();
+			msgVec[i].msg_hdr.msg_iov = &iovVec[i];
+			msgVec[i].msg_hdr.msg_iovlen = 1;
+		}
+
+		// usually a single syscall for the whole tick; partial sends can
+		// happen on a full socket buffer, punt to the fallback path then
+		int ret = 0;
+
+		while (numSent < numUsed && (ret = sendmmsg(sock.native_handle(), msgVec.data() + numSent, numUsed - numSent, 0)) > 0) {
+			numSent += ret;
+		}
+	}
+#endif
+
+	for (; numSent < numUsed; numSent++) {
+		const Datagram& dg = datagrams[numSent];
+
+		asio::error_code err;
+
+		sock.send_to(asio::buffer(dg.data), dg.dest, 0, err);
+
+		if (CheckErrorCode(err))
+			break;
+	}
+
+	numUsed = 0;
+}
+
+
+size_t RecvDatagramBatch::Receive(asio::ip::udp::socket& sock)
+{
+	numUsed = 0;
+
+#ifdef __linux__
+	{
+		constexpr int maxBatchSize = 64;
+
+		mmsghdr msgVec[maxBatchSize];
+		iovec iovVec[maxBatchSize];
+
+		int numRecvd = maxBatchSize;
+
+		// keep draining while the previous call filled its whole batch
+		while (numRecvd == maxBatchSize) {
+			if (datagrams.size() < numUsed + maxBatchSize)
+				datagrams.resize(numUsed + maxBatchSize);
+
+			for (int i = 0; i < maxBatchSize; i++) {
+				Datagram& dg = datagrams[numUsed + i];
+
+				dg.sender = asio::ip::udp::endpoint();
+				dg.data.resize(udpMaxPacketSize);
+
+				iovVec[i].iov_base = dg.data.data();
+				iovVec[i].iov_len = dg.data.size();
+
+				msgVec[i].msg_hdr = {};
+				msgVec[i].msg_hdr.msg_name = dg.sender.data();
+				msgVec[i].msg_hdr.msg_namelen = dg.sender.capacity();
+				msgVec[i].msg_hdr.msg_iov = &iovVec[i];
+				msgVec[i].msg_hdr.msg_iovlen = 1;
+			}
+
+			if ((numRecvd = recvmmsg(sock.native_handle(), msgVec, maxBatchSize, MSG_DONTWAIT, nullptr)) <= 0)
+				break;
+
+			for (int i = 0; i < numRecvd; i++) {
+				Datagram& dg = datagrams[numUsed + i];
+
+				dg.sender.resize(msgVec[i].msg_hdr.msg_namelen);
+				dg.data.resize(msgVec[i].msg_len);
+			}
+
+			numUsed += numRecvd;
+		}
+	}
+#else
+	while (true) {
+		if (datagrams.size() == numUsed)
+			datagrams.emplace_back();
+
+		Datagram& dg = datagrams[numUsed];
+		dg.data.resize(udpMaxPacketSize);
+
+		asio::error_code err;
+
+		const size_t bytesReceived = sock.receive_from(asio::buffer(dg.data), dg.sender, 0, err);
+
+		// socket is drained
+		if (err == asio::error::would_block || err == asio::error::try_again)
+			break;
+
+		if (CheckErrorCode(err))
+			break;
+
+		// benign per-datagram error (e.g. connection_reset), carries no data
+		if (err)
+			continue;
+
+		dg.data.resize(bytesReceived);
+		numUsed += 1;
+	}
+#endif
+
+	return numUsed;
+}
+
+
 bool CheckErrorCode(asio::error_code& err)
 {
 	// connection reset can happen when host did not start up
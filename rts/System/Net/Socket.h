@@ -3,6 +3,9 @@
 #ifndef SOCKET_H
 #define SOCKET_H
 
+#include <cstdint>
+#include <vector>
+
 #include <asio/io_service.hpp>
 #include <asio/ip/udp.hpp>
 #include <asio/ip/tcp.hpp>
@@ -13,6 +16,66 @@ namespace netcode
 
 extern asio::io_service netservice;
 
+/// no datagram we ever send or accept exceeds this (cf. UDPConnection::SetMTU)
+constexpr unsigned udpMaxPacketSize = 4096;
+
+/**
+ * @brief collects outgoing datagrams so they go out in one syscall
+ *
+ * Connections sharing a socket (i.e. all clients of a server) enqueue
+ * their serialized packets here instead of calling send_to once per
+ * packet; the owner flushes the whole batch with a single sendmmsg
+ * where available (one send_to per datagram otherwise).
+ */
+class SendDatagramBatch
+{
+public:
+	void Enqueue(const asio::ip::udp::endpoint& dest, const std::vector<std::uint8_t>& data);
+	void Flush(asio::ip::udp::socket& sock);
+
+	bool Empty() const { return (numUsed == 0); }
+
+private:
+	struct Datagram {
+		asio::ip::udp::endpoint dest;
+		std::vector<std::uint8_t> data;
+	};
+
+	// entries beyond numUsed are kept around so their buffers get reused
+	std::vector<Datagram> datagrams;
+	size_t numUsed = 0;
+};
+
+/**
+ * @brief drains all pending datagrams from a socket in few syscalls
+ *
+ * Receiving counterpart of SendDatagramBatch; one recvmmsg call pulls
+ * in a whole batch where available (one non-blocking receive_from per
+ * datagram otherwise). Buffers are recycled from tick to tick, so the
+ * steady state allocates nothing. The socket must be non-blocking.
+ */
+class RecvDatagramBatch
+{
+public:
+	/// empties the socket, returns the number of datagrams received
+	size_t Receive(asio::ip::udp::socket& sock);
+
+	size_t GetNumDatagrams() const { return numUsed; }
+
+	const std::vector<std::uint8_t>& GetData(size_t i) const { return datagrams[i].data; }
+	const asio::ip::udp::endpoint& GetSender(size_t i) const { return datagrams[i].sender; }
+
+private:
+	struct Datagram {
+		asio::ip::udp::endpoint sender;
+		std::vector<std::uint8_t> data;
+	};
+
+	// entries beyond numUsed are kept around so their buffers get reused
+	std::vector<Datagram> datagrams;
+	size_t numUsed = 0;
+};
+
 /**
  * Check if a network error occured and eventually log it.
  * @returns true if a network error occured, false otherwise
@@ -3,6 +3,7 @@
 #include "UDPConnection.h"
 
 #include <cinttypes>
+#include <cmath>
 
 
 #include "Socket.h"
@@ -24,7 +25,7 @@ CONFIG(bool, UDPConnectionLogDebugMessages).defaultValue(false);
 namespace netcode {
 using namespace asio;
 
-static constexpr unsigned udpMaxPacketSize = 4096;
+// udpMaxPacketSize lives in Socket.h now
 static constexpr int maxChunkSize = 254;
 static constexpr int chunksPerSec = 30;
 
@@ -271,6 +272,10 @@ void UDPConnection::Init()
 	lastPacketRecvTime = spring_gettime();
 	lastChunkCreatedTime = spring_gettime();
 
+	lastFrameMsgRecvTime = spring_gettime();
+	lastFrameMsgRecvDelta = -1.0f;
+	framePacketJitter = 0.0f;
+
 	#ifdef ENABLE_DEBUG_STATS
 	lastDebugMessageTime = spring_gettime();
 	lastFramePacketRecvTime = spring_gettime();
@@ -647,8 +652,23 @@ void UDPConnection::ProcessRawPacket(Packet& incoming)
 				msgQueue.emplace_back(new RawPacket(bufp, pktLength));
 				std::shared_ptr<const RawPacket>& msgPacket = msgQueue.back();
 
-				#ifdef ENABLE_DEBUG_STATS
 				// server sends both of these, clients send only keyframe messages
+				if (msgPacket->data[0] == NETMSG_NEWFRAME || msgPacket->data[0] == NETMSG_KEYFRAME) {
+					const spring_time frameMsgRecvTime = spring_gettime();
+					const float frameMsgRecvDelta = (frameMsgRecvTime - lastFrameMsgRecvTime).toMilliSecsf();
+
+					// RFC 3550 style estimate of the variation in frame message
+					// inter-arrival times; late resends inflate this as well,
+					// which is intentional since the client-side buffer has to
+					// absorb loss-recovery delays too
+					if (lastFrameMsgRecvDelta >= 0.0f)
+						framePacketJitter += (std::fabs(frameMsgRecvDelta - lastFrameMsgRecvDelta) - framePacketJitter) * (1.0f / 16.0f);
+
+					lastFrameMsgRecvDelta = frameMsgRecvDelta;
+					lastFrameMsgRecvTime = frameMsgRecvTime;
+				}
+
+				#ifdef ENABLE_DEBUG_STATS
 				// TODO: would be easy to feed this data into a Q3A-style lagometer
 				//
 				if (msgPacket->data[0] == NETMSG_NEWFRAME || msgPacket->data[0] == NETMSG_KEYFRAME) {
@@ -1057,7 +1077,12 @@ void UDPConnection::SendPacket(Packet& pkt)
 	asio::error_code err;
 
 	EMULATE_LATENCY( !EMULATE_PACKET_LOSS( LOSS_COUNTER ) ) {
-		mySocket->send_to(buffer(sendBuffer), addr, flags, err);
+		if (sendBatch != nullptr) {
+			// goes out when the listener flushes, after all connections updated
+			sendBatch->Enqueue(addr, sendBuffer);
+		} else {
+			mySocket->send_to(buffer(sendBuffer), addr, flags, err);
+		}
 	}
 
 	if (CheckErrorCode(err))
@@ -1130,6 +1155,10 @@ void UDPConnection::Close(bool flush) {
 	if (closed)
 		return;
 
+	// the listener might not get to flush its batch again,
+	// make sure any goodbye packets go out immediately
+	sendBatch = nullptr;
+
 	Flush(flush);
 	muted = true;
 	if (!sharedSocket) {
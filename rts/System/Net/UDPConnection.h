@@ -8,6 +8,7 @@
 #include <deque>
 
 #include "Connection.h"
+#include "Socket.h"
 #include "System/Misc/SpringTime.h"
 #include "System/UnorderedSet.hpp"
 
@@ -134,6 +135,12 @@ public:
 
 	const asio::ip::udp::endpoint& GetEndpoint() const { return addr; }
 
+	float GetFramePacketJitter() const override { return framePacketJitter; }
+
+	/// if set, serialized packets are enqueued there (and sent when the
+	/// owner of the batch flushes it) instead of via per-packet send_to
+	void SetSendBatch(SendDatagramBatch* batch) { sendBatch = batch; }
+
 private:
 	void InitConnection(asio::ip::udp::endpoint address,
 			std::shared_ptr<asio::ip::udp::socket> socket);
@@ -219,9 +226,18 @@ private:
 	int lastInOrder;
 	int lastNak;
 
+	/// jitter-estimator state; arrival time and inter-arrival delta of
+	/// the previous frame message, and the smoothed delta variation
+	spring_time lastFrameMsgRecvTime;
+	float lastFrameMsgRecvDelta;
+	float framePacketJitter;
+
 	/// Our socket
 	std::shared_ptr<asio::ip::udp::socket> mySocket;
 
+	/// owned by the UDPListener whose socket we share, if any
+	SendDatagramBatch* sendBatch = nullptr;
+
 	RawPacket fragmentBuffer;
 
 	// Traffic statistics and stuff
@@ -40,6 +40,16 @@ UDPListener::UDPListener(int port, const std::string& ip): acceptNewConnections(
 }
 
 UDPListener::~UDPListener() {
+	// connections can outlive us, stop them from using the batch
+	for (const auto& p: connMap) {
+		std::shared_ptr<UDPConnection> uc = p.second.lock();
+
+		if (uc == nullptr)
+			continue;
+
+		uc->SetSendBatch(nullptr);
+	}
+
 	for (const auto& p: dropMap) {
 		LOG("[%s] dropped %lu packets from unknown IP %s", __func__, (unsigned long) p.second, (p.first).c_str());
 	}
@@ -110,17 +120,12 @@ std::string UDPListener::TryBindSocket(int port, std::shared_ptr<asio::ip::udp::
 void UDPListener::Update() {
 	netservice.poll();
 
-	size_t bytesAvailable = 0;
+	// everything pending on the socket this tick, in few syscalls
+	recvBatch.Receive(*socket);
 
-	while ((bytesAvailable = socket->available()) > 0) {
-		recvBuffer.clear();
-		recvBuffer.resize(bytesAvailable, 0);
-
-		ip::udp::endpoint udpEndPoint;
-		asio::ip::udp::socket::message_flags msgFlags = 0;
-		asio::error_code err;
-
-		const size_t bytesReceived = socket->receive_from(asio::buffer(recvBuffer), udpEndPoint, msgFlags, err);
+	for (size_t n = 0; n < recvBatch.GetNumDatagrams(); n++) {
+		const std::vector<std::uint8_t>& recvData = recvBatch.GetData(n);
+		const ip::udp::endpoint& udpEndPoint = recvBatch.GetSender(n);
 
 		const auto ci = connMap.find(udpEndPoint);
 
@@ -128,13 +133,10 @@ void UDPListener::Update() {
 		if (ci != connMap.end() && ci->second.expired())
 			continue;
 
-		if (CheckErrorCode(err))
-			break;
-
-		if (bytesReceived < Packet::headerSize)
+		if (recvData.size() < Packet::headerSize)
 			continue;
 
-		Packet data(&recvBuffer[0], bytesReceived);
+		Packet data(recvData.data(), recvData.size());
 
 		if (ci != connMap.end()) {
 			ci->second.lock()->ProcessRawPacket(data);
@@ -146,6 +148,7 @@ void UDPListener::Update() {
 		if (acceptNewConnections && data.lastContinuous == -1 && data.nakType == 0)	{
 			if (!data.chunks.empty() && (*data.chunks.begin())->chunkNumber == 0) {
 				std::shared_ptr<UDPConnection> incoming(new UDPConnection(socket, udpEndPoint));
+				incoming->SetSendBatch(&sendBatch);
 				waiting.push(incoming);
 				connMap[udpEndPoint] = incoming;
 				incoming->ProcessRawPacket(data);
@@ -183,12 +186,16 @@ void UDPListener::Update() {
 		i->second.lock()->Update();
 		++i;
 	}
+
+	// everything the connections produced this tick, in one syscall
+	sendBatch.Flush(*socket);
 }
 
 
 std::shared_ptr<UDPConnection> UDPListener::SpawnConnection(const std::string& ip, const unsigned port)
 {
 	std::shared_ptr<UDPConnection> newConn(new UDPConnection(socket, ip::udp::endpoint(WrapIP(ip), port)));
+	newConn->SetSendBatch(&sendBatch);
 	connMap[newConn->GetEndpoint()] = newConn;
 	return newConn;
 }
@@ -3,6 +3,7 @@
 #ifndef _UDP_LISTENER_H
 #define _UDP_LISTENER_H
 
+#include "Socket.h"
 #include "System/Misc/NonCopyable.h"
 #include <memory>
 #include <asio/ip/udp.hpp>
@@ -85,7 +86,11 @@ private:
 	/// socket being listened on
 	std::shared_ptr<asio::ip::udp::socket> socket;
 
-	std::vector<std::uint8_t> recvBuffer;
+	/// outgoing datagrams of all connections, flushed once per Update
+	SendDatagramBatch sendBatch;
+
+	/// incoming datagrams of all connections, drained once per Update
+	RecvDatagramBatch recvBatch;
 
 	/// all connections
 	std::map< asio::ip::udp::endpoint, std::weak_ptr<UDPConnection> > connMap;
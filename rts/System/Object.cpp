@@ -2,8 +2,6 @@
 
 
 #include "System/Object.h"
-#include "System/ContainerUtil.h"
-#include "System/creg/STL_Map.h"
 #include "System/Log/ILog.h"
 #include "System/Platform/CrashHandler.h"
 
@@ -14,28 +12,16 @@ CR_REG_METADATA(CObject, (
 
 	CR_MEMBER(detached),
 
-	CR_MEMBER(listening),
-	CR_MEMBER(listeners),
-	CR_MEMBER(listenersDepTbl),
-	CR_MEMBER(listeningDepTbl)
+	CR_IGNORED(listenerLinks),
+	CR_IGNORED(listeningLinks),
+
+	CR_SERIALIZER(Serialize)
 ))
 
 std::atomic<std::int64_t> CObject::cur_sync_id(0);
 
 
 
-static bool VectorInsertSorted(std::vector<CObject*>& v, CObject* o)
-{
-	return (spring::VectorInsertUniqueSorted(v, o, [](const CObject* a, const CObject* b) { return (a->GetSyncID() < b->GetSyncID()); }));
-}
-
-static bool VectorEraseSorted(std::vector<CObject*>& v, CObject* o)
-{
-	return (spring::VectorEraseUniqueSorted(v, o, [](const CObject* a, const CObject* b) { return (a->GetSyncID() < b->GetSyncID()); }));
-}
-
-
-
 CObject::CObject() : detached(false)
 {
 	// Note1: this static var is shared between all different types of classes synced & unsynced (CUnit, CFeature, CProjectile, ...)
@@ -54,35 +40,53 @@ CObject::~CObject()
 	assert(!detached);
 	detached = true;
 
-	for (const auto& p: listenersDepTbl) {
-		assert(p.first >= DEPENDENCE_ATTACKER && p.first < DEPENDENCE_COUNT);
-		assert(p.second < listeners.size());
+	// every edge on either chain belongs to us, so unhook it from the
+	// counterparty's chain and free it; nothing ever has to search the
+	// counterparty's containers
+	for (DependenceLink *l = listenerLinks, *n = nullptr; l != nullptr; l = n) {
+		n = l->nextListener;
+
+		assert(l->target == this);
+		assert(l->dep >= DEPENDENCE_ATTACKER && l->dep < DEPENDENCE_COUNT);
 
-		for (CObject* obj: listeners[p.second]) {
-			obj->DependentDied(this);
+		l->listener->DependentDied(this);
 
-			const auto jt = obj->listeningDepTbl.find(p.first);
+		UnlinkListeningChain(l);
+		delete l;
+	}
 
-			if (jt == obj->listeningDepTbl.end())
-				continue;
+	for (DependenceLink *l = listeningLinks, *n = nullptr; l != nullptr; l = n) {
+		n = l->nextListening;
 
-			VectorEraseSorted(obj->listening[ jt->second ], this);
-		}
+		assert(l->listener == this);
+		assert(l->dep >= DEPENDENCE_ATTACKER && l->dep < DEPENDENCE_COUNT);
+
+		UnlinkListenerChain(l);
+		delete l;
 	}
+}
 
-	for (const auto& p: listeningDepTbl) {
-		assert(p.first >= DEPENDENCE_ATTACKER && p.first < DEPENDENCE_COUNT);
-		assert(p.second < listening.size());
 
-		for (CObject* obj: listening[p.second]) {
-			const auto jt = obj->listenersDepTbl.find(p.first);
+void CObject::UnlinkListenerChain(DependenceLink* l)
+{
+	if (l->prevListener != nullptr)
+		l->prevListener->nextListener = l->nextListener;
+	else
+		l->target->listenerLinks = l->nextListener;
 
-			if (jt == obj->listenersDepTbl.end())
-				continue;
+	if (l->nextListener != nullptr)
+		l->nextListener->prevListener = l->prevListener;
+}
 
-			VectorEraseSorted(obj->listeners[ jt->second ], this);
-		}
-	}
+void CObject::UnlinkListeningChain(DependenceLink* l)
+{
+	if (l->prevListening != nullptr)
+		l->prevListening->nextListening = l->nextListening;
+	else
+		l->listener->listeningLinks = l->nextListening;
+
+	if (l->nextListening != nullptr)
+		l->nextListening->prevListening = l->prevListening;
 }
 
 
@@ -99,8 +103,27 @@ void CObject::AddDeathDependence(CObject* obj, DependenceType dep)
 	if (detached || obj->detached)
 		return;
 
-	VectorInsertSorted(const_cast<TSyncSafeSet&>(     GetListening(dep)),  obj);
-	VectorInsertSorted(const_cast<TSyncSafeSet&>(obj->GetListeners(dep)), this);
+	// adding the same (object, type) pair twice must stay a no-op
+	for (const DependenceLink* l = listeningLinks; l != nullptr; l = l->nextListening) {
+		if (l->target == obj && l->dep == dep)
+			return;
+	}
+
+	DependenceLink* l = new DependenceLink();
+	l->listener = this;
+	l->target = obj;
+	l->dep = dep;
+
+	// push onto the heads of both chains
+	if ((l->nextListening = listeningLinks) != nullptr)
+		listeningLinks->prevListening = l;
+
+	listeningLinks = l;
+
+	if ((l->nextListener = obj->listenerLinks) != nullptr)
+		obj->listenerLinks->prevListener = l;
+
+	obj->listenerLinks = l;
 }
 
 
@@ -111,10 +134,68 @@ void CObject::DeleteDeathDependence(CObject* obj, DependenceType dep)
 	if (detached || obj->detached)
 		return;
 
-	const auto it =      listeningDepTbl.find(dep);
-	const auto jt = obj->listenersDepTbl.find(dep);
+	for (DependenceLink* l = listeningLinks; l != nullptr; l = l->nextListening) {
+		if (l->target != obj || l->dep != dep)
+			continue;
 
-	if (it !=      listeningDepTbl.end()) VectorEraseSorted(     listening[ it->second ],  obj);
-	if (jt != obj->listenersDepTbl.end()) VectorEraseSorted(obj->listeners[ jt->second ], this);
+		UnlinkListeningChain(l);
+		UnlinkListenerChain(l);
+		delete l;
+		return;
+	}
 }
 
+
+#ifdef USING_CREG
+void CObject::Serialize(creg::ISerializer* s)
+{
+	// only the listening side of each edge is stored; loading re-creates
+	// the links, which rebuilds the listener chains of all our targets
+	if (s->IsWriting()) {
+		std::int32_t numDeps = 0;
+
+		for (const DependenceLink* l = listeningLinks; l != nullptr; l = l->nextListening) {
+			numDeps++;
+		}
+
+		s->SerializeInt(&numDeps, sizeof(numDeps));
+
+		for (DependenceLink* l = listeningLinks; l != nullptr; l = l->nextListening) {
+			s->SerializeObjectPtr((void**)&l->target, l->target->GetClass());
+			s->SerializeInt(&l->dep, sizeof(l->dep));
+		}
+
+		return;
+	}
+
+	std::int32_t numDeps = 0;
+
+	s->SerializeInt(&numDeps, sizeof(numDeps));
+
+	for (std::int32_t i = 0; i < numDeps; i++) {
+		DependenceLink* l = new DependenceLink();
+		l->listener = this;
+
+		// target can still be an unfixed placeholder here, so hooking
+		// it into its target's listener chain waits for the callback
+		s->SerializeObjectPtr((void**)&l->target, CObject::StaticClass());
+		s->SerializeInt(&l->dep, sizeof(l->dep));
+
+		if ((l->nextListening = listeningLinks) != nullptr)
+			listeningLinks->prevListening = l;
+
+		listeningLinks = l;
+	}
+
+	s->AddPostLoadCallback([](void* userdata) {
+		CObject* self = static_cast<CObject*>(userdata);
+
+		for (DependenceLink* l = self->listeningLinks; l != nullptr; l = l->nextListening) {
+			if ((l->nextListener = l->target->listenerLinks) != nullptr)
+				l->target->listenerLinks->prevListener = l;
+
+			l->target->listenerLinks = l;
+		}
+	}, this);
+}
+#endif
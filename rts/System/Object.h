@@ -3,30 +3,51 @@
 #ifndef OBJECT_H
 #define OBJECT_H
 
+#include <array>
 #include <atomic>
 #include <functional>
-#include <vector>
 
 #include "ObjectDependenceTypes.h"
 #include "System/creg/creg_cond.h"
-#include "System/UnorderedMap.hpp"
 
 class CObject
 {
 public:
 	CR_DECLARE(CObject)
 
+	/**
+	 * @brief one edge of the death-dependence graph
+	 *
+	 * Doubly linked into the listener chain of <target> and the listening
+	 * chain of <listener> so either endpoint can unlink it in O(1) when
+	 * it dies; dependences used to live in per-type sorted vectors which
+	 * every death had to search-and-erase on all its counterparties.
+	 */
+	struct DependenceLink {
+		CObject* listener = nullptr; ///< object that gets DependentDied(target)
+		CObject* target = nullptr;   ///< object whose death is awaited
+
+		int dep = 0;
+
+		DependenceLink* prevListener = nullptr; ///< chain over target->listenerLinks
+		DependenceLink* nextListener = nullptr;
+		DependenceLink* prevListening = nullptr; ///< chain over listener->listeningLinks
+		DependenceLink* nextListening = nullptr;
+	};
+
 	CObject();
 	virtual ~CObject();
 
+	void Serialize(creg::ISerializer* s);
+
 	/// Request to not inform this when obj dies
 	virtual void DeleteDeathDependence(CObject* obj, DependenceType dep);
 	/// Request to inform this when obj dies
 	virtual void AddDeathDependence(CObject* obj, DependenceType dep);
 	/// Called when an object died, that this is interested in
-	/// Any derived implementations should *NOT* modify listening
-	/// or listeners because we iterate over both within our dtor
-	/// when calling this
+	/// Any derived implementations should *NOT* add or delete
+	/// dependences involving the dying object because we walk
+	/// its chains within our dtor when calling this
 	virtual void DependentDied(CObject* obj) {}
 
 /*
@@ -69,68 +90,45 @@ public:
 
 private:
 	// Note, this has nothing to do with the UnitID, FeatureID, ...
-	// Its only purpose is to make the sorting in TSyncSafeSet syncsafe
+	// Its only purpose is to make object creation order deterministic
 	std::int64_t sync_id;
 	static std::atomic<std::int64_t> cur_sync_id;
 
+	/// remove <l> from the listener chain of its target
+	static void UnlinkListenerChain(DependenceLink* l);
+	/// remove <l> from the listening chain of its listener
+	static void UnlinkListeningChain(DependenceLink* l);
+
 public:
-	typedef std::vector<CObject*> TSyncSafeSet;
-	typedef std::vector<TSyncSafeSet> TDependenceMap;
 	typedef std::function<bool(const CObject*, int*)> TObjFilterPred;
 
 	bool detached;
 
 protected:
-	const TSyncSafeSet& GetListeners(const DependenceType dep) {
-		const auto it = listenersDepTbl.find(dep);
+	const DependenceLink* GetListenerLinks() const { return listenerLinks; }
+	const DependenceLink* GetListeningLinks() const { return listeningLinks; }
 
-		if (it == listenersDepTbl.end()) {
-			listeners.emplace_back();
-			listenersDepTbl[dep] = listeners.size() - 1;
-			return (listeners.back());
-		}
-
-		return (listeners[it->second]);
-	}
-	const TSyncSafeSet& GetListening(const DependenceType dep) {
-		const auto it = listeningDepTbl.find(dep);
+	template<size_t N> void FilterListeners(const TObjFilterPred& fp, std::array<int, N>& ids) const {
+		ids[0] = 0;
 
-		if (it == listeningDepTbl.end()) {
-			listening.emplace_back();
-			listeningDepTbl[dep] = listening.size() - 1;
-			return (listening.back());
+		for (const DependenceLink* l = listenerLinks; l != nullptr; l = l->nextListener) {
+			ids[0] += ((ids[0] < (N - 1)) && fp(l->listener, &ids[ids[0] + 1]));
 		}
-
-		return (listening[it->second]);
 	}
+	template<size_t N> void FilterListening(const TObjFilterPred& fp, std::array<int, N>& ids) const {
+		ids[0] = 0;
 
-	const TDependenceMap& GetAllListeners() const { return listeners; }
-	const TDependenceMap& GetAllListening() const { return listening; }
-
-	template<size_t N> static void FilterDepObjects(
-		const TDependenceMap& depObjects,
-		const TObjFilterPred& filterPred,
-		std::array<int, N>& objectIDs
-	) {
-		objectIDs[0] = 0;
-
-		for (const auto& objs: depObjects) {
-			for (const CObject* obj: objs) {
-				objectIDs[0] += ((objectIDs[0] < (N - 1)) && filterPred(obj, &objectIDs[objectIDs[0] + 1]));
-			}
+		for (const DependenceLink* l = listeningLinks; l != nullptr; l = l->nextListening) {
+			ids[0] += ((ids[0] < (N - 1)) && fp(l->target, &ids[ids[0] + 1]));
 		}
 	}
 
-	template<size_t N> void FilterListeners(const TObjFilterPred& fp, std::array<int, N>& ids) const { FilterDepObjects(listeners, fp, ids); }
-	template<size_t N> void FilterListening(const TObjFilterPred& fp, std::array<int, N>& ids) const { FilterDepObjects(listening, fp, ids); }
-
 protected:
-	spring::unordered_map<int, size_t> listenersDepTbl; // maps dependence-type to index into listeners
-	spring::unordered_map<int, size_t> listeningDepTbl; // maps dependence-type to index into listening
-
-	TDependenceMap listeners;
-	TDependenceMap listening;
+	// chain heads; an edge appears on the listener chain of its target
+	// and the listening chain of its listener, one node per (listener,
+	// target, type) triple
+	DependenceLink* listenerLinks = nullptr;
+	DependenceLink* listeningLinks = nullptr;
 };
 
 #endif /* OBJECT_H */
-
@@ -25,6 +25,14 @@ namespace CrashHandler {
 	 *   the parameter is specific to the needs of one platform.
 	 */
 	void SuspendedStacktrace(Threading::ThreadControls* ctls, const char* threadName);
+
+	/*
+	 * Captures the raw instruction-pointer chain of a running thread without
+	 * any symbol extraction or translation, so it is cheap enough for the
+	 * Watchdog to call periodically while a thread exceeds its soft frame
+	 * budget. Returns the number of frames written to iparray.
+	 */
+	int SuspendedStackSample(Threading::ThreadControls* ctls, void** iparray, int maxDepth);
 #else
 	bool InitImageHlpDll();
 #endif
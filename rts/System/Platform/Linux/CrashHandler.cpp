@@ -884,6 +884,42 @@ namespace CrashHandler
     }
 
 
+	/**
+	 * Raw-IP variant of SuspendedStacktrace for the Watchdog sampler; only
+	 * walks the stack of the suspended thread, all symbol extraction and
+	 * translation is deferred until the sample aggregate gets reported.
+	 * @brief SuspendedStackSample
+	 */
+    int SuspendedStackSample(Threading::ThreadControls* ctls, void** iparray, int maxDepth)
+    {
+		assert(ctls != nullptr);
+		assert(ctls->handle != 0);
+
+		int numFrames = 0;
+
+		ctls->Suspend();
+
+#if !(defined(__arm__) || defined(__APPLE__))
+		// see thread_unwind; on platforms where ucontext_t and
+		// unw_context_t are not aliases we can only unwind the
+		// calling thread, which is useless for sampling
+		unw_cursor_t cursor;
+
+		if (unw_init_local(&cursor, &ctls->ucontext) == 0) {
+			for (; numFrames < maxDepth && unw_step(&cursor); numFrames++) {
+				unw_word_t ip;
+
+				unw_get_reg(&cursor, UNW_REG_IP, &ip);
+				iparray[numFrames] = reinterpret_cast<void*>(ip);
+			}
+		}
+#endif
+
+		ctls->Resume();
+		return numFrames;
+    }
+
+
 	/**
 	 * This stack trace is tailored for the SIGSEGV / SIGILL / SIGFPE etc signal handler.
 	 * The thread to be traced is usually in a halted state, but the signal handler can
@@ -18,6 +18,10 @@
 	#include <shlwapi.h>
 	#include <iphlpapi.h>
 
+	// the K32-prefixed variants live in kernel32, no psapi.lib needed
+	#define PSAPI_VERSION 2
+	#include <psapi.h>
+
 	#ifndef SHGFP_TYPE_CURRENT
 		#define SHGFP_TYPE_CURRENT 0
 	#endif
@@ -42,6 +46,7 @@
 #if !defined(_WIN32)
 #include <dlfcn.h> // for dladdr(), dlopen()
 #include <pwd.h> // for getpw*()
+#include <sys/resource.h> // for getrusage()
 #include <sys/statvfs.h>
 #include <sys/types.h>
 #include <sys/utsname.h> // for uname()
@@ -515,6 +520,29 @@ namespace Platform
 		#endif
 	}
 
+	double GetPeakRSSMegs() {
+		#ifdef _WIN32
+		PROCESS_MEMORY_COUNTERS pmc;
+
+		if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+			return (pmc.PeakWorkingSetSize / (1024.0 * 1024.0));
+
+		return 0.0;
+		#else
+		struct rusage ru;
+
+		if (getrusage(RUSAGE_SELF, &ru) != 0)
+			return 0.0;
+
+		#ifdef __APPLE__
+		// ru_maxrss is in bytes here, kilobytes everywhere else
+		return (ru.ru_maxrss / (1024.0 * 1024.0));
+		#else
+		return (ru.ru_maxrss / 1024.0);
+		#endif
+		#endif
+	}
+
 
 	uint32_t NativeWordSize() { return (sizeof(void*)); }
 	uint32_t SystemWordSize() { return ((Is32BitEmulation())? 8: NativeWordSize()); }
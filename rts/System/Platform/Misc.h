@@ -93,6 +93,8 @@ namespace Platform
 	bool IsRunningInGDB();
 
 	uint64_t FreeDiskSpace(const std::string& path);
+	/// peak resident-set size of the running process so far, in megabytes
+	double GetPeakRSSMegs();
 	uint32_t NativeWordSize(); // compiled process code
 	uint32_t SystemWordSize(); // host operating system
 
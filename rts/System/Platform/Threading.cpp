@@ -9,9 +9,12 @@
 	#include "System/Sync/FPUCheck.h"
 #endif
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
 #if defined(__APPLE__) || defined(__FreeBSD__)
 #elif defined(_WIN32)
 	#include <windows.h>
@@ -43,6 +46,76 @@ namespace Threading {
 	static cpu_set_t cpusSystem;
 #endif
 
+	static constexpr int MAX_NUMA_NODES = 4;
+
+	static int numNumaNodes = 1;
+	static std::uint32_t numaNodeMasks[MAX_NUMA_NODES] = {0};
+
+
+	static void DetectNumaNodes()
+	{
+		numNumaNodes = 0;
+
+	#if (!defined(__APPLE__) && !defined(__FreeBSD__) && !defined(_WIN32))
+		// sysfs lists each node's cores as comma-separated ranges ("0-7,16-23");
+		// parsing it directly avoids a libnuma dependency
+		for (int node = 0; node < MAX_NUMA_NODES; node++) {
+			char path[64];
+			char buff[512] = {0};
+
+			snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+
+			FILE* file = fopen(path, "r");
+
+			if (file == nullptr)
+				break;
+
+			const char* line = fgets(buff, sizeof(buff) - 1, file);
+			fclose(file);
+
+			if (line == nullptr)
+				continue;
+
+			std::uint32_t nodeMask = 0;
+
+			for (const char* p = line; *p != '\0'; p++) {
+				char* end = nullptr;
+
+				const long lo = strtol(p, &end, 10);
+				      long hi = lo;
+
+				if (end == p)
+					break;
+
+				if (*end == '-')
+					hi = strtol(p = end + 1, &end, 10);
+
+				// cores beyond the 32-bit mask limit can not be addressed
+				for (long n = lo; n <= std::min(hi, 31L); n++)
+					nodeMask |= (1u << n);
+
+				if (*(p = end) != ',')
+					break;
+			}
+
+			// memory-only nodes, or nodes whose cores we may not run on
+			if ((nodeMask &= GetAvailableCoresMask()) == 0)
+				continue;
+
+			numaNodeMasks[numNumaNodes++] = nodeMask;
+		}
+	#endif
+
+		// platforms without topology info collapse to a single node
+		if (numNumaNodes == 0) {
+			numNumaNodes = 1;
+			numaNodeMasks[0] = GetAvailableCoresMask();
+		}
+
+		if (numNumaNodes > 1)
+			LOG("[Threading] %d NUMA nodes detected", numNumaNodes);
+	}
+
 
 	void DetectCores()
 	{
@@ -60,10 +133,22 @@ namespace Threading {
 		sched_getaffinity(0, sizeof(cpu_set_t), &cpusSystem);
 	#endif
 
+		DetectNumaNodes();
 		GetPhysicalCpuCores(); // (uses a static, too)
 	}
 
 
+	int GetNumNumaNodes() { return numNumaNodes; }
+
+	std::uint32_t GetNumaNodeCoresMask(int node)
+	{
+		if (node < 0 || node >= numNumaNodes)
+			return 0;
+
+		return numaNodeMasks[node];
+	}
+
+
 
 	#if defined(__APPLE__) || defined(__FreeBSD__)
 	#elif defined(_WIN32)
@@ -117,6 +117,14 @@ namespace Threading {
 	void SetAffinityHelper(const char* threadName, std::uint32_t affinity);
 	std::uint32_t GetAvailableCoresMask();
 
+	/**
+	 * NUMA topology; nodes without any cores we can run on are skipped
+	 * and platforms that expose no topology info report a single node
+	 * covering all available cores
+	 */
+	int GetNumNumaNodes();
+	std::uint32_t GetNumaNodeCoresMask(int node);
+
 	/**
 	 * returns count of cpu cores/ hyperthreadings cores
 	 */
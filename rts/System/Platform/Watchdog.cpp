@@ -23,6 +23,8 @@
 
 CONFIG(int, HangTimeout).defaultValue(10).minimumValue(-1).maximumValue(600)
 		.description("Number of seconds that, if spent in the same code segment, indicate a hang; -1 to disable.");
+CONFIG(int, HangSoftTimeout).defaultValue(0).minimumValue(0).maximumValue(600)
+		.description("Number of seconds in the same code segment before the watchdog starts collecting stack samples for a stall report; must be smaller than HangTimeout, 0 to disable.");
 
 namespace Watchdog
 {
@@ -86,6 +88,38 @@ namespace Watchdog
 
 	static spring_time hangTimeout = spring_msecs(0);
 
+	#ifndef _WIN32
+	// sampling-profiler state; stalls that exceed the soft timeout but
+	// recover before the hard one leave an aggregated trace report in
+	// the log instead of no evidence at all (SuspendedStackSample only
+	// exists on platforms with suspend/resume thread controls)
+	static constexpr unsigned int MAX_SAMPLE_DEPTH = 16;
+	static constexpr unsigned int MAX_SAMPLE_BUCKETS = 32;
+
+	struct StackSampleBucket {
+		unsigned int hits = 0;
+		unsigned int numFrames = 0;
+		void* frames[MAX_SAMPLE_DEPTH];
+	};
+
+	struct ThreadSampleState {
+		bool sampling = false;
+
+		unsigned int numBuckets = 0;
+		unsigned int numSamples = 0;
+		// samples dropped because all buckets were taken
+		unsigned int numUnbucketed = 0;
+
+		spring_time stallStartTime = spring_notime;
+		spring_time lastSampleTime = spring_notime;
+
+		StackSampleBucket buckets[MAX_SAMPLE_BUCKETS];
+	};
+
+	static ThreadSampleState sampleStates[WDT_COUNT];
+	static spring_time softHangTimeout = spring_msecs(0);
+	#endif
+
 
 	static inline void UpdateActiveThreads(Threading::NativeThreadId num) {
 		unsigned int active = WDT_COUNT;
@@ -112,6 +146,79 @@ namespace Watchdog
 	}
 
 
+	#ifndef _WIN32
+	static void CollectStackSample(unsigned int num)
+	{
+		WatchDogThreadInfo* threadInfo = registeredThreads[num];
+		ThreadSampleState& state = sampleStates[num];
+
+		if (threadInfo->ctls == nullptr)
+			return;
+
+		void* iparray[MAX_SAMPLE_DEPTH];
+		const int numFrames = CrashHandler::SuspendedStackSample(threadInfo->ctls.get(), iparray, MAX_SAMPLE_DEPTH);
+
+		if (numFrames <= 0)
+			return;
+
+		state.numSamples += 1;
+		state.lastSampleTime = spring_gettime();
+
+		// merge identical samples into one bucket, cf. the
+		// backtrace pool kept by SyncDebugger::ServerDump
+		for (unsigned int i = 0; i < state.numBuckets; ++i) {
+			StackSampleBucket& bucket = state.buckets[i];
+
+			if (bucket.numFrames != (unsigned int) numFrames)
+				continue;
+			if (memcmp(bucket.frames, iparray, numFrames * sizeof(void*)) != 0)
+				continue;
+
+			bucket.hits += 1;
+			return;
+		}
+
+		if (state.numBuckets >= MAX_SAMPLE_BUCKETS) {
+			state.numUnbucketed += 1;
+			return;
+		}
+
+		StackSampleBucket& bucket = state.buckets[state.numBuckets++];
+
+		bucket.hits = 1;
+		bucket.numFrames = numFrames;
+		memcpy(bucket.frames, iparray, numFrames * sizeof(void*));
+	}
+
+	static void EmitSampleReport(unsigned int num)
+	{
+		ThreadSampleState& state = sampleStates[num];
+
+		// most frequent traces first
+		std::sort(state.buckets, state.buckets + state.numBuckets, [](const StackSampleBucket& a, const StackSampleBucket& b) {
+			return (a.hits > b.hits);
+		});
+
+		LOG_L(L_WARNING, "[Watchdog] thread [%s] stalled for %.1fs; %u stack samples in %u distinct traces (%u unbucketed)",
+			threadNames[num], (state.lastSampleTime - state.stallStartTime).toSecsf(), state.numSamples, state.numBuckets, state.numUnbucketed);
+
+		for (unsigned int i = 0; i < state.numBuckets; ++i) {
+			const StackSampleBucket& bucket = state.buckets[i];
+
+			LOG_L(L_WARNING, "\ttrace %u, %u/%u samples:", i, bucket.hits, state.numSamples);
+
+			// the "{%p}" part is resolved to "functionname [filename:lineno]"
+			// by the stacktrace translator, same as SyncDebugger backtraces
+			for (unsigned int j = 0; j < bucket.numFrames; ++j) {
+				LOG_L(L_WARNING, "\t\t#%u {%p}", j, bucket.frames[j]);
+			}
+		}
+
+		state = ThreadSampleState{};
+	}
+	#endif
+
+
 	__FORCE_ALIGN_STACK__
 	static void HangDetectorLoop()
 	{
@@ -133,6 +240,23 @@ namespace Watchdog
 				WatchDogThreadInfo* threadInfo = registeredThreads[i];
 				const spring_time curwdt = threadInfo->timer;
 
+				#ifndef _WIN32
+				ThreadSampleState& state = sampleStates[i];
+
+				if (spring_istime(softHangTimeout) && spring_istime(curwdt) && (curtime - curwdt) > softHangTimeout) {
+					// soft budget exceeded; collect evidence while the stall lasts
+					if (!state.sampling) {
+						state.sampling = true;
+						state.stallStartTime = curwdt;
+					}
+
+					CollectStackSample(i);
+				} else if (state.sampling) {
+					// timer was cleared again, the stall is over
+					EmitSampleReport(i);
+				}
+				#endif
+
 				if (spring_istime(curwdt) && (curtime - curwdt) > hangTimeout) {
 					hangDetected = true;
 					hangThreads[i] = true;
@@ -164,6 +288,15 @@ namespace Watchdog
 				CrashHandler::CleanupStacktrace(LOG_LEVEL_WARNING);
 			}
 
+			#ifndef _WIN32
+			// sample at ~10Hz while the soft timeout is armed; the
+			// hard-hang check is cheap enough to run just as often
+			if (spring_istime(softHangTimeout)) {
+				spring::this_thread::sleep_for(std::chrono::milliseconds(100));
+				continue;
+			}
+			#endif
+
 			spring::this_thread::sleep_for(std::chrono::seconds(1));
 		}
 	}
@@ -394,6 +527,14 @@ namespace Watchdog
 
 		hangTimeout = spring_secs(hangTimeoutSecs);
 
+		#ifndef _WIN32
+		const int softTimeoutSecs = configHandler->GetInt("HangSoftTimeout");
+
+		// a soft timeout >= the hard one could never produce a report
+		if (softTimeoutSecs > 0 && softTimeoutSecs < hangTimeoutSecs)
+			softHangTimeout = spring_secs(softTimeoutSecs);
+		#endif
+
 		// start the watchdog thread
 		hangDetectorThread = std::move(spring::thread(&HangDetectorLoop));
 
@@ -421,5 +562,12 @@ namespace Watchdog
 			registeredThreads[i] = &registeredThreadsData[WDT_COUNT];
 		memset(threadSlots, 0, sizeof(threadSlots));
 		threadNumTable.clear();
+
+		#ifndef _WIN32
+		for (unsigned int i = 0; i < WDT_COUNT; ++i)
+			sampleStates[i] = ThreadSampleState{};
+
+		softHangTimeout = spring_msecs(0);
+		#endif
 	}
 }
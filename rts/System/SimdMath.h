@@ -0,0 +1,122 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef SIMD_MATH_H
+#define SIMD_MATH_H
+
+#include <cmath>
+#include <cstddef>
+#include <xmmintrin.h>
+
+#include "System/BranchPrediction.h"
+#include "System/float4.h"
+#include "System/MainDefines.h"
+#include "System/Matrix44f.h"
+
+/**
+ * SSE batch kernels over contiguous float4 and CMatrix44f arrays.
+ *
+ * The single-element operations (CMatrix44f::operator*, the float3
+ * Normalize family, ...) already vectorize their inner arithmetic,
+ * but callers that walk whole arrays still reload constant operands
+ * and pay loop overhead per element; these kernels hoist the shared
+ * operands into registers across the entire range. All loads and
+ * stores go through the unaligned intrinsics just as in the SSE
+ * paths of Matrix44f.cpp, so plain std::vector storage works.
+ *
+ * NOTE: synced code must stay on the streflop-backed scalar paths
+ * in float3 and SpringMath for cross-platform determinism, these
+ * helpers are for unsynced consumers (rendering, etc) only.
+ */
+namespace simdmath {
+	/**
+	 * transforms <count> points (or directions, depending on their
+	 * w-components) by a single matrix; src and dst may alias
+	 */
+	__FORCE_ALIGN_STACK__
+	static inline void TransformPoints(const CMatrix44f& m, const float4* src, float4* dst, size_t count)
+	{
+		const __m128 mc0 = _mm_loadu_ps(&m.md[0][0]);
+		const __m128 mc1 = _mm_loadu_ps(&m.md[1][0]);
+		const __m128 mc2 = _mm_loadu_ps(&m.md[2][0]);
+		const __m128 mc3 = _mm_loadu_ps(&m.md[3][0]);
+
+		for (size_t i = 0; i < count; i++) {
+			const __m128 v = _mm_loadu_ps(&src[i].x);
+
+			__m128 out;
+			out =                 _mm_mul_ps(mc0, _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0))) ;
+			out = _mm_add_ps(out, _mm_mul_ps(mc1, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1))));
+			out = _mm_add_ps(out, _mm_mul_ps(mc2, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2))));
+			out = _mm_add_ps(out, _mm_mul_ps(mc3, _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3))));
+
+			_mm_storeu_ps(&dst[i].x, out);
+		}
+	}
+
+	/**
+	 * normalizes the xyz-components of <count> vectors in-place with
+	 * SafeNormalize semantics (near-zero vectors are left untouched);
+	 * the w-components are preserved
+	 */
+	__FORCE_ALIGN_STACK__
+	static inline void NormalizeVectors(float4* vecs, size_t count)
+	{
+		for (size_t i = 0; i < count; i++) {
+			const __m128 v = _mm_loadu_ps(&vecs[i].x);
+			const __m128 sq = _mm_mul_ps(v, v);
+
+			const __m128 sqy = _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(1, 1, 1, 1));
+			const __m128 sqz = _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(2, 2, 2, 2));
+
+			float sql;
+			_mm_store_ss(&sql, _mm_add_ss(_mm_add_ss(sq, sqy), sqz));
+
+			if (!likely(sql > float3::nrm_eps()))
+				continue;
+
+			float out[4];
+			_mm_storeu_ps(out, _mm_mul_ps(v, _mm_set1_ps(1.0f / std::sqrt(sql))));
+
+			vecs[i].x = out[0];
+			vecs[i].y = out[1];
+			vecs[i].z = out[2];
+		}
+	}
+
+	/**
+	 * writes the squared xyz-distance between <count> pairs of points
+	 */
+	__FORCE_ALIGN_STACK__
+	static inline void SqDistances(const float4* srcA, const float4* srcB, float* dst, size_t count)
+	{
+		for (size_t i = 0; i < count; i++) {
+			const __m128 d = _mm_sub_ps(_mm_loadu_ps(&srcA[i].x), _mm_loadu_ps(&srcB[i].x));
+			const __m128 sq = _mm_mul_ps(d, d);
+
+			const __m128 sqy = _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(1, 1, 1, 1));
+			const __m128 sqz = _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(2, 2, 2, 2));
+
+			_mm_store_ss(&dst[i], _mm_add_ss(_mm_add_ss(sq, sqy), sqz));
+		}
+	}
+
+	/**
+	 * scales <count> matrices in-place by per-element weights, e.g.
+	 * 0/1 visibility flags; four vector multiplies instead of the 16
+	 * scalar ones of CMatrix44f::operator*=(float)
+	 */
+	__FORCE_ALIGN_STACK__
+	static inline void ScaleMatrices(CMatrix44f* mats, const float* weights, size_t count)
+	{
+		for (size_t i = 0; i < count; i++) {
+			const __m128 w = _mm_set1_ps(weights[i]);
+
+			_mm_storeu_ps(&mats[i].md[0][0], _mm_mul_ps(_mm_loadu_ps(&mats[i].md[0][0]), w));
+			_mm_storeu_ps(&mats[i].md[1][0], _mm_mul_ps(_mm_loadu_ps(&mats[i].md[1][0]), w));
+			_mm_storeu_ps(&mats[i].md[2][0], _mm_mul_ps(_mm_loadu_ps(&mats[i].md[2][0]), w));
+			_mm_storeu_ps(&mats[i].md[3][0], _mm_mul_ps(_mm_loadu_ps(&mats[i].md[3][0]), w));
+		}
+	}
+}
+
+#endif // SIMD_MATH_H
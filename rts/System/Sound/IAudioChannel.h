@@ -71,6 +71,7 @@ protected:
 	virtual void SoundSourceFinished(CSoundSource* sndSource) = 0;
 
 	friend class CSoundSource;
+	friend class CSound; // drains deferred play-requests into FindSourceAndPlay
 
 public:
 	float volume;
@@ -3,6 +3,7 @@
 #include "AudioChannel.h"
 
 #include "ALShared.h"
+#include "Sound.h"
 #include "SoundItem.h"
 #include "SoundSource.h"
 #include "Game/GlobalUnsynced.h"
@@ -61,11 +62,29 @@ void AudioChannel::SoundSourceFinished(CSoundSource* sndSource)
 }
 
 
-void AudioChannel::FindSourceAndPlay(size_t id, const float3& pos, const float3& velocity, float volume, bool relative)
+void AudioChannel::EnqueuePlay(size_t id, const float3& pos, const float3& velocity, float volume, bool relative)
 {
 	if (id == 0 || volume <= 0.0f)
 		return;
 
+	if (!enabled)
+		return;
+
+	// don't spam to many sounds per frame
+	if (emitsThisFrame >= emitsPerFrame)
+		return;
+
+	emitsThisFrame++;
+
+	// item lookup, culling and source allocation all need soundMutex;
+	// defer them to the sound thread so PlaySample never stalls behind
+	// the 30Hz mixer update
+	static_cast<CSound*>(sound)->EnqueuePlayRequest(this, id, pos, velocity, volume, relative);
+}
+
+
+void AudioChannel::FindSourceAndPlay(size_t id, const float3& pos, const float3& velocity, float volume, bool relative)
+{
 	std::lock_guard<spring::recursive_mutex> lck(soundMutex);
 
 	if (!enabled)
@@ -87,12 +106,6 @@ void AudioChannel::FindSourceAndPlay(size_t id, const float3& pos, const float3&
 		LOG("[AudioChannel::%s] maximum distance ignored for relative playback of sound-item \"%s\"", __func__, (sndItem->Name()).c_str());
 	}
 
-	// don't spam to many sounds per frame
-	if (emitsThisFrame >= emitsPerFrame)
-		return;
-
-	emitsThisFrame++;
-
 	// check if the sound item is already played
 	if (curSources.size() >= maxConcurrentSources) {
 		CSoundSource* src = nullptr;
@@ -132,22 +145,22 @@ void AudioChannel::FindSourceAndPlay(size_t id, const float3& pos, const float3&
 
 void AudioChannel::PlaySample(size_t id, float volume)
 {
-	FindSourceAndPlay(id, -FwdVector, ZeroVector, volume, true);
+	EnqueuePlay(id, -FwdVector, ZeroVector, volume, true);
 }
 
 void AudioChannel::PlaySample(size_t id, const float3& pos, float volume)
 {
-	FindSourceAndPlay(id, pos, ZeroVector, volume, false);
+	EnqueuePlay(id, pos, ZeroVector, volume, false);
 }
 
 void AudioChannel::PlaySample(size_t id, const float3& pos, const float3& velocity, float volume)
 {
-	FindSourceAndPlay(id, pos, velocity, volume, false);
+	EnqueuePlay(id, pos, velocity, volume, false);
 }
 
 void AudioChannel::PlaySample(size_t id, const CWorldObject* obj, float volume)
 {
-	FindSourceAndPlay(id, obj->pos, obj->speed, volume, false);
+	EnqueuePlay(id, obj->pos, obj->speed, volume, false);
 }
 
 
@@ -159,10 +172,10 @@ void AudioChannel::PlayRandomSample(const GuiSoundSet& soundSet, const float3& p
 	switch (soundSet.NumSounds()) {
 		case  0: {                                         return; } break;
 		case  1: { soundIdx =                                   0; } break;
-		default: { soundIdx = guRNG.NextInt(soundSet.NumSounds()); } break;
+		default: { soundIdx = guThreadRNG().NextInt(soundSet.NumSounds()); } break;
 	}
 
-	FindSourceAndPlay(soundSet.getID(soundIdx), pos, vel, soundSet.getVolume(soundIdx), false);
+	EnqueuePlay(soundSet.getID(soundIdx), pos, vel, soundSet.getVolume(soundIdx), false);
 }
 
 
@@ -50,6 +50,8 @@ public:
 	float StreamGetPlayTime() override;
 
 protected:
+	void EnqueuePlay(size_t id, const float3& pos, const float3& velocity, float volume, bool relative);
+
 	void FindSourceAndPlay(size_t id, const float3& pos, const float3& velocity, float volume, bool relative) override;
 	void SoundSourceFinished(CSoundSource* sndSource) override;
 
@@ -20,6 +20,8 @@
 #include <cinttypes>
 #include <functional>
 
+#include "System/ConcurrentQueue.h"
+#include "System/Sound/IAudioChannel.h"
 #include "System/Sound/ISoundChannels.h"
 #include "System/Sound/SoundLog.h"
 #include "SoundSource.h"
@@ -48,6 +50,28 @@
 spring::recursive_mutex soundMutex;
 
 
+struct PlayRequest {
+	IAudioChannel* channel = nullptr;
+
+	size_t id = 0;
+
+	float3 position;
+	float3 velocity;
+
+	float volume = 1.0f;
+	bool relative = false;
+};
+
+// fed by the {sim,draw} threads, drained by UpdateThread
+static moodycamel::ConcurrentQueue<PlayRequest> playRequests;
+
+
+void CSound::EnqueuePlayRequest(IAudioChannel* channel, size_t id, const float3& pos, const float3& velocity, float volume, bool relative)
+{
+	playRequests.enqueue({channel, id, pos, velocity, volume, relative});
+}
+
+
 CSound::CSound()
 {
 	configHandler->NotifyOnChange(this, {"snd_volmaster", "snd_eaxpreset", "snd_filter", "UseEFX", "snd_volgeneral", "snd_volunitreply", "snd_volbattle", "snd_volui", "snd_volmusic", "PitchAdjust"});
@@ -706,6 +730,16 @@ void CSound::Update()
 		GetSoundId(*preloadSet.begin());
 	}
 
+	{
+		// drain play-requests deferred by AudioChannel::EnqueuePlay;
+		// distance/priority culling and source allocation happen here
+		PlayRequest pr;
+
+		while (playRequests.try_dequeue(pr)) {
+			pr.channel->FindSourceAndPlay(pr.id, pr.position, pr.velocity, pr.volume, pr.relative);
+		}
+	}
+
 	for (CSoundSource& source: soundSources) {
 		source.Update();
 	}
@@ -18,6 +18,7 @@
 #include "SoundItem.h"
 
 class CSoundSource;
+class IAudioChannel;
 class SoundBuffer;
 class SoundItem;
 
@@ -69,6 +70,10 @@ public:
 	ALCdevice* GetCurrentDevice() { return curDevice; }
 	int GetFrameSize() const { return frameSize; }
 
+	/// lock-free handoff of a PlaySample request to UpdateThread, which
+	/// culls it and allocates a source without blocking the caller
+	void EnqueuePlayRequest(IAudioChannel* channel, size_t id, const float3& pos, const float3& velocity, float volume, bool relative);
+
 private:
 	typedef spring::unordered_map<std::string, std::string> SoundItemNameMap;
 	typedef spring::unordered_map<std::string, SoundItemNameMap> SoundItemDefsMap;
@@ -28,6 +28,7 @@
 #include "aGui/Gui.h"
 #endif
 #include "ExternalAI/AILibraryManager.h"
+#include "Game/Benchmark.h"
 #include "Game/CameraHandler.h"
 #include "Game/ClientSetup.h"
 #include "Game/GameSetup.h"
@@ -48,6 +49,7 @@
 #include "Net/Protocol/NetProtocol.h" // clientNet
 #include "Rendering/GlobalRendering.h"
 #include "Rendering/Fonts/glFont.h"
+#include "Rendering/Screenshot.h"
 #include "Rendering/GL/FBO.h"
 #include "Rendering/Shaders/ShaderHandler.h"
 #include "Rendering/Textures/Bitmap.h"
@@ -116,6 +118,7 @@ DEFINE_bool     (hidden,                                   false, "Start in back
 DEFINE_bool     (nocolor,                                  false, "Disables colorized stdout");
 DEFINE_string   (server,                                   "",    "Set listening IP for server");
 DEFINE_bool     (textureatlas,                             false, "Dump each finalized textureatlas in textureatlasN.tga");
+DEFINE_bool     (benchmark,                                false, "Replay the given demofile at maximum speed and print a machine-readable performance report on exit");
 
 DEFINE_bool_EX  (list_ai_interfaces, "list-ai-interfaces", false, "Dump a list of available AI Interfaces to stdout");
 DEFINE_bool_EX  (list_skirmish_ais,  "list-skirmish-ais",  false, "Dump a list of available Skirmish AIs to stdout");
@@ -407,6 +410,8 @@ void SpringApp::ParseCmdLine(int argc, char* argv[])
 	if (argc >= 2)
 		inputFile = argv[1];
 
+	CBenchmark::enabled = FLAGS_benchmark;
+
 #ifndef _WIN32
 	if (!FLAGS_nocolor && (getenv("SPRING_NOCOLOR") == nullptr)) {
 		// don't colorize, if our output is piped to a diff tool or file
@@ -772,6 +777,9 @@ bool SpringApp::Update()
 	swap = (retc && activeController != nullptr && activeController->Draw());
 	#endif
 
+	// hand completed screenshot readbacks to the encoder pool
+	DumpScreenshotQueue();
+
 	// always swap by default, not doing so can upset some drivers
 	globalRendering->SwapBuffers(swap, false);
 	return retc;
@@ -874,6 +882,8 @@ void SpringApp::Kill(bool fromRun)
 	killedCount += 1;
 
 	LOG("[SpringApp::%s][1] fromRun=%d", __func__, fromRun);
+	// encode any screenshots still in flight while the GL context lives
+	DumpScreenshotQueue(true);
 	ThreadPool::SetThreadCount(0);
 	LOG("[SpringApp::%s][2]", __func__);
 	LuaVFSDownload::Free(true);
@@ -927,6 +937,8 @@ void SpringApp::Kill(bool fromRun)
 	CGlobalRendering::KillStatic();
 	CLuaSocketRestrictions::KillStatic();
 
+	globalConfig.Kill();
+
 	// also gets rid of configHandler
 	FileSystemInitializer::Cleanup();
 	DataDirLocater::FreeInstance();
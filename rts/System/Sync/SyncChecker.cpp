@@ -9,5 +9,10 @@
 unsigned CSyncChecker::g_checksum;
 int CSyncChecker::inSyncedCode;
 
+#ifdef TRACE_SYNC_HEAVY
+unsigned char CSyncChecker::g_batchBuf[CSyncChecker::BATCH_SIZE];
+unsigned CSyncChecker::g_batchLen;
+#endif
+
 
 #endif // SYNCDEBUG
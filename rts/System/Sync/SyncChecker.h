@@ -7,6 +7,7 @@
 
 #ifdef TRACE_SYNC_HEAVY
 	#include "HsiehHash.h"
+	#include <cstring>
 #endif
 
 #include <assert.h>
@@ -30,14 +31,33 @@ class CSyncChecker {
 		/**
 		 * Keeps a running checksum over all assignments to synced variables.
 		 */
+#ifdef TRACE_SYNC_HEAVY
+		static unsigned GetChecksum() { FlushBatch(); return g_checksum; }
+		static void NewFrame() { g_checksum = 0xfade1eaf; g_batchLen = 0; }
+#else
 		static unsigned GetChecksum() { return g_checksum; }
 		static void NewFrame() { g_checksum = 0xfade1eaf; }
+#endif
 
 		static void Sync(const void* p, unsigned size) {
 			// most common cases first, make it easy for compiler to optimize for it
 			// simple xor is not enough to detect multiple zeroes, e.g.
 #ifdef TRACE_SYNC_HEAVY
-			g_checksum = HsiehHash((const char*)p, size, g_checksum);
+			// batched: append the raw bytes and hash them in large blocks,
+			// a full avalanching HsiehHash pass per synced assignment (with
+			// every call serialized through g_checksum) is what makes heavy
+			// sync-trace builds too slow to run against live desyncs
+			if ((g_batchLen + size) > BATCH_SIZE)
+				FlushBatch();
+
+			if (size > BATCH_SIZE) {
+				// oversized writes (bulk arrays) are hashed directly
+				g_checksum = HsiehHash((const char*)p, size, g_checksum);
+				return;
+			}
+
+			memcpy(&g_batchBuf[g_batchLen], p, size);
+			g_batchLen += size;
 #else
 			switch(size) {
 			case 1:
@@ -83,6 +103,26 @@ class CSyncChecker {
 		}
 
 	private:
+#ifdef TRACE_SYNC_HEAVY
+		static void FlushBatch() {
+			if (g_batchLen == 0)
+				return;
+
+			g_checksum = HsiehHash((const char*)&g_batchBuf[0], g_batchLen, g_checksum);
+			g_batchLen = 0;
+		}
+#endif
+
+	private:
+#ifdef TRACE_SYNC_HEAVY
+		static constexpr unsigned BATCH_SIZE = 1 << 16;
+
+		/**
+		 * Raw synced mutations pending their next block hash.
+		 */
+		static unsigned char g_batchBuf[BATCH_SIZE];
+		static unsigned g_batchLen;
+#endif
 
 		/**
 		 * The sync checksum
@@ -8,12 +8,10 @@
 #include <vector>
 
 
-#include "Lua/LuaParser.h"
 #include "System/TdfParser.h"
 #include "System/StringUtil.h"
 #include "System/FileSystem/ArchiveScanner.h"
 #include "System/FileSystem/FileHandler.h"
-#include "System/FileSystem/VFSHandler.h"
 #include "System/Log/ILog.h"
 
 void TdfParser::TdfSection::print(std::ostream & out) const
@@ -98,48 +96,252 @@ void TdfParser::print(std::ostream & out) const {
 }
 
 
-void TdfParser::ParseLuaTable(const LuaTable& table, TdfSection* currentSection) {
-	std::vector<std::string> keys;
-	table.GetKeys(keys);
-
-	for (const std::string& key: keys) {
-		LuaTable::DataType dt = table.GetType(key);
-		switch (dt) {
-			case LuaTable::DataType::TABLE: {
-				ParseLuaTable(table.SubTable(key), currentSection->construct_subsection(key));
-			} break;
-			case LuaTable::DataType::BOOLEAN: {
-				currentSection->AddPair(key, table.Get(key, false));
-			} break;
-			case LuaTable::DataType::NUMBER: {
-				currentSection->AddPair(key, table.Get(key, 0.0f));
-			} break;
-			case LuaTable::DataType::STRING: {
-				currentSection->AddPair(key, table.Get(key, std::string("")));
-			} break;
-			default:
-				throw content_error("invalid datatype for key " + key);
+namespace {
+
+// native implementation of the grammar in gamedata/parse_tdf.lua; the old
+// path embedded the entire buffer in a generated Lua chunk and executed it
+// through LuaParser while holding the global VFS lock, which copied the
+// data several times and choked on files containing "]]" or NUL bytes
+struct TdfScanner {
+public:
+	TdfScanner(const char* b, size_t s, const std::string& n): buf(b), size(s), tdfName(n) {}
+
+	void Parse(TdfParser::TdfSection* root) {
+		if (ParseElements(root) != 0)
+			Crash("extra junk");
+	}
+
+private:
+	bool AtEnd() const { return (pos >= size); }
+	char CurrChar() const { return (AtEnd() ? 0 : buf[pos]); }
+
+	static bool IsSpace(char c) { return (c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f'); }
+	static bool IsBlank(char c) { return (c == ' ' || c == '\t'); }
+
+	void Crash(const char* msg) const;
+
+	void EatWhite();
+	std::string ParseKey();
+	std::string ParseValue();
+	void ParseSection(TdfParser::TdfSection* parent);
+	char ParseElements(TdfParser::TdfSection* section);
+
+private:
+	const char* buf;
+	size_t size;
+	size_t pos = 0;
+
+	const std::string& tdfName;
+};
+
+
+void TdfScanner::Crash(const char* msg) const
+{
+	size_t lineNum = 1;
+	size_t lineStart = 0;
+
+	for (size_t i = 0; i < pos && i < size; i++) {
+		if (buf[i] != '\n')
+			continue;
+		lineNum++;
+		lineStart = i + 1;
+	}
+
+	size_t lineEnd = lineStart;
+
+	while (lineEnd < size && buf[lineEnd] != '\n' && buf[lineEnd] != '\r')
+		lineEnd++;
+
+	throw content_error(msg + (" (" + tdfName + " line " + IntToString(lineNum) + ")  \"" + std::string(buf + lineStart, lineEnd - lineStart) + "\""));
+}
+
+
+void TdfScanner::EatWhite()
+{
+	while (!AtEnd()) {
+		const char c = buf[pos];
+
+		if (IsSpace(c)) {
+			pos++;
+			continue;
+		}
+
+		if (c != '/' || (pos + 1) >= size)
+			break;
+
+		if (buf[pos + 1] == '/') {
+			// line comment
+			pos += 2;
+
+			while (!AtEnd() && buf[pos] != '\n')
+				pos++;
+
+			continue;
 		}
+
+		if (buf[pos + 1] == '*') {
+			// block comment
+			size_t p = pos + 2;
+
+			while ((p + 1) < size && (buf[p] != '*' || buf[p + 1] != '/'))
+				p++;
+
+			// unterminated comments are left in place, as in parse_tdf.lua
+			if ((p + 1) >= size)
+				break;
+
+			pos = p + 2;
+			continue;
+		}
+
+		break;
 	}
 }
 
 
-void TdfParser::ParseBuffer(const char* buf, size_t size) {
-	CVFSHandler::GrabLock();
+std::string TdfScanner::ParseKey()
+{
+	const size_t start = pos;
+
+	while (!AtEnd() && !IsSpace(buf[pos]) && buf[pos] != '=')
+		pos++;
+
+	const size_t len = pos - start;
+
+	while (!AtEnd() && IsBlank(buf[pos]))
+		pos++;
+
+	if (len == 0 || CurrChar() != '=') {
+		pos = start;
+		Crash("could not find key");
+	}
+
+	pos++;
+
+	while (!AtEnd() && IsBlank(buf[pos]))
+		pos++;
+
+	return std::string(buf + start, len);
+}
+
 
-	vfsHandler->SetName("TDFParserVFS");
+std::string TdfScanner::ParseValue()
+{
+	// look for quoted string
+	if (CurrChar() == '"') {
+		size_t p = pos + 1;
+
+		while (p < size && buf[p] != '"' && buf[p] != '\n')
+			p++;
+
+		if (p < size && buf[p] == '"') {
+			const size_t valStart = pos + 1;
+			const size_t valLen = p - valStart;
+
+			p++;
+
+			while (p < size && IsBlank(buf[p]))
+				p++;
+
+			if (p < size && buf[p] == ';') {
+				while (p < size && buf[p] == ';')
+					p++;
+
+				pos = p;
+				return std::string(buf + valStart, valLen);
+			}
+		}
+	}
+
+	// unquoted string (can not contain ';')
+	size_t p = pos;
+
+	while (p < size && buf[p] != ';' && buf[p] != '\n')
+		p++;
+
+	if (p < size && buf[p] == ';') {
+		std::string val(buf + pos, p - pos);
+
+		while (p < size && buf[p] == ';')
+			p++;
+
+		pos = p;
+		return val;
+	}
+
+	Crash("could not find value, missing \";\" ?");
+	return "";
+}
+
+
+void TdfScanner::ParseSection(TdfParser::TdfSection* parent)
+{
+	// caller checked CurrChar() == '['
+	size_t p = pos + 1;
+
+	while (p < size && buf[p] != ']')
+		p++;
 
-	{
-		const std::string script = std::string("local TDF = VFS.Include('gamedata/parse_tdf.lua'); return TDF.ParseText([[") + buf + "]])";
+	if (p >= size || p == (pos + 1))
+		Crash("missing section");
 
-		LuaParser luaParser(script, SPRING_VFS_BASE);
-		luaParser.Execute();
-		ParseLuaTable(luaParser.GetRoot(), GetRootSection());
+	const std::string name(buf + pos + 1, p - pos - 1);
+
+	pos = p + 1;
+
+	EatWhite();
+
+	if (CurrChar() != '{')
+		Crash("missing section start brace");
+
+	pos++;
+
+	if (ParseElements(parent->construct_subsection(name)) != '}')
+		Crash("missing section end brace");
+}
+
+
+// elements can be either sections, or key/value pairs
+char TdfScanner::ParseElements(TdfParser::TdfSection* section)
+{
+	while (true) {
+		EatWhite();
+
+		const char c = CurrChar();
+
+		if (c == 0)
+			return 0;
+
+		if (c == '}') {
+			pos++;
+			return c;
+		}
+
+		if (c == '[') {
+			ParseSection(section);
+			continue;
+		}
+
+		const std::string key = ParseKey();
+		const std::string value = ParseValue();
+
+		section->add_name_value(key, value);
 	}
+}
+
+}
 
-	vfsHandler->SetName("SpringVFS");
 
-	CVFSHandler::FreeLock();
+void TdfParser::ParseBuffer(const char* buf, size_t size) {
+	TdfScanner scanner(buf, size, filename);
+
+	try {
+		scanner.Parse(GetRootSection());
+	} catch (const content_error& ec) {
+		// keep whatever was parsed up to the error; the Lua-based parser
+		// did not propagate syntax errors to callers either
+		LOG_L(L_ERROR, "[TdfParser::%s] %s", __func__, ec.what());
+	}
 }
 
 void TdfParser::LoadBuffer(const char* buf, size_t size)
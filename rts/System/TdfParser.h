@@ -12,8 +12,6 @@
 #include "System/float3.h"
 #include "System/UnorderedMap.hpp"
 
-class LuaTable;
-
 /**
  * Used to parse TDF Config files.
  * An example of such a file is script.txt.
@@ -113,7 +111,6 @@ private:
 
 	std::vector<std::string> GetLocationVector(std::string const& location) const;
 
-	void ParseLuaTable(const LuaTable& table, TdfSection* currentSection);
 	void ParseBuffer(char const* buf, size_t size);
 
 public:
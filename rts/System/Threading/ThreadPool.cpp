@@ -14,6 +14,7 @@
 	#include "System/Config/ConfigHandler.h"
 #endif
 #include "System/Log/ILog.h"
+#include "System/bitops.h"
 #include "System/Platform/Threading.h"
 #include "System/Threading/SpringThreading.h"
 
@@ -76,6 +77,9 @@ static spring::signal newTasksSignal[2];
 
 static _threadlocal int threadnum(0);
 
+// NUMA node each pool thread was pinned to; set during SetDefaultThreadCount
+static std::array<std::uint8_t, ThreadPool::MAX_THREADS> threadNumaNodes = {};
+
 #ifndef UNITSYNC
 // if enabled, allows OpenGL calls from ThreadPool tasks
 // so certain logic (e.g. loading models) can be written
@@ -95,6 +99,14 @@ namespace ThreadPool {
 int GetThreadNum() { return threadnum; }
 static void SetThreadNum(const int idx) { threadnum = idx; }
 
+int GetThreadNumaNode(int threadNum)
+{
+	if (threadNum < 0 || threadNum >= MAX_THREADS)
+		return 0;
+
+	return threadNumaNodes[threadNum];
+}
+
 
 static int GetConfigNumWorkers() {
 	#ifndef UNIT_TEST
@@ -425,9 +437,8 @@ static void KillThreads(int wantedNumThreads, int curNumThreads)
 static std::uint32_t FindWorkerThreadCore(std::int32_t index, std::uint32_t availCores, std::uint32_t avoidCores)
 {
 	// find an unused core for worker-thread <index>
-	const auto FindCore = [&index](std::uint32_t targetCores) {
+	const auto FindCore = [](std::uint32_t targetCores, std::int32_t n) {
 		std::uint32_t workerCore = 1;
-		std::int32_t n = index;
 
 		while ((workerCore != 0) && !(workerCore & targetCores))
 			workerCore <<= 1;
@@ -442,11 +453,25 @@ static std::uint32_t FindWorkerThreadCore(std::int32_t index, std::uint32_t avai
 		return workerCore;
 	};
 
-	const std::uint32_t threadAvailCore = FindCore(availCores);
-	const std::uint32_t threadAvoidCore = FindCore(avoidCores);
+	// fill up the cores of one NUMA node before spilling over into the
+	// next, so parallel regions run by few workers stay within a single
+	// memory domain instead of being striped across sockets
+	{
+		std::int32_t n = index;
+
+		for (int node = 0, numNodes = Threading::GetNumNumaNodes(); node < numNodes; node++) {
+			const std::uint32_t nodeAvailCores = availCores & Threading::GetNumaNodeCoresMask(node);
+			const std::int32_t numNodeCores = count_bits_set(nodeAvailCores);
+
+			if (n < numNodeCores)
+				return (FindCore(nodeAvailCores, n));
+
+			n -= numNodeCores;
+		}
+	}
+
+	const std::uint32_t threadAvoidCore = FindCore(avoidCores, index);
 
-	if (threadAvailCore != 0)
-		return threadAvailCore;
 	// select one of the main-thread cores if no others are available
 	if (threadAvoidCore != 0)
 		return threadAvoidCore;
@@ -617,6 +642,17 @@ void SetDefaultThreadCount()
 			// const std::uint32_t workerCore = workerAvailCores;
 
 			Threading::SetAffinity(workerCore);
+
+			// remember which memory domain this worker ended up on, so
+			// for_mt users can partition their data accordingly
+			for (int node = 0, numNodes = Threading::GetNumNumaNodes(); node < numNodes; node++) {
+				if ((workerCore & Threading::GetNumaNodeCoresMask(node)) == 0)
+					continue;
+
+				threadNumaNodes[i] = node;
+				break;
+			}
+
 			return workerCore;
 		};
 
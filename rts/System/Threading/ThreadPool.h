@@ -14,6 +14,12 @@ namespace ThreadPool {
 		f(args ...);
 	}
 
+	template<class F, class... Args>
+	static inline void EnqueueWithAffinity(uint32_t affinityKey, F&& f, Args&&... args)
+	{
+		f(args ...);
+	}
+
 	static inline void AddExtJob(spring::thread&& t) { t.join(); }
 	static inline void AddExtJob(std::future<void>&& f) { f.get(); }
 	static inline void ClearExtJobs() {}
@@ -22,6 +28,7 @@ namespace ThreadPool {
 	static inline void SetDefaultThreadCount() {}
 	static inline void SetThreadCount(int num) {}
 	static inline int GetThreadNum() { return 0; }
+	static inline int GetThreadNumaNode(int threadNum) { return 0; }
 	static inline int GetMaxThreads() { return 1; }
 	static inline int GetNumThreads() { return 1; }
 	static inline void NotifyWorkerThreads(bool force, bool async) {}
@@ -85,6 +92,10 @@ namespace ThreadPool {
 	static auto Enqueue(F&& f, Args&&... args)
 	-> std::shared_ptr<std::future<typename std::result_of<F(Args...)>::type>>;
 
+	template<class F, class... Args>
+	static auto EnqueueWithAffinity(uint32_t affinityKey, F&& f, Args&&... args)
+	-> std::shared_ptr<std::future<typename std::result_of<F(Args...)>::type>>;
+
 	void AddExtJob(spring::thread&& t);
 	void AddExtJob(std::future<void>&& f);
 	void ClearExtJobs();
@@ -102,6 +113,9 @@ namespace ThreadPool {
 	void SetDefaultThreadCount();
 	void SetThreadCount(int num);
 	int GetThreadNum();
+	/// NUMA node the given pool thread is pinned to (0 on single-node
+	/// systems); lets callers schedule work on the node owning its data
+	int GetThreadNumaNode(int threadNum);
 	bool HasThreads();
 	int GetMaxThreads();
 	int GetNumThreads();
@@ -602,23 +616,53 @@ public:
 	{
 		assert(to >= from);
 
-		remainingTasks.store((step == 1) ? (to - from) : ((to - from + step - 1) / step));
-		ctr.store(0);
+		const int numTasks = (step == 1) ? (to - from) : ((to - from + step - 1) / step);
+
+		remainingTasks.store(numTasks);
 
-		this->from = from;
-		this->to   = to;
-		this->step = step;
-		this->func = func;
+		// split the range into one contiguous block per thread; every
+		// thread drains its own block first and only then steals from
+		// the others, so repeated loops over the same data mostly hand
+		// each thread the iterations it executed (and cached) the last
+		// time around while uneven work still gets balanced
+		numBlocks = std::min(int(blocks.size()), ThreadPool::GetNumThreads());
+
+		for (int b = 0; b < numBlocks; b++) {
+			blocks[b].nxt.store((numTasks * (b    )) / numBlocks);
+			blocks[b].end.store((numTasks * (b + 1)) / numBlocks);
+		}
+
+		// claiming iterations one at a time turns the shared cursor
+		// into a contention point for cheap loop bodies; chunks keep
+		// the fetch_add rate low without hurting balance much
+		this->chunk = std::max(numTasks / (numBlocks * 8), 1);
+		this->from  = from;
+		this->step  = step;
+		this->func  = func;
 	}
 
 	bool IsSliceTask() const override { return true; }
 	bool ExecuteStep() override
 	{
-		const int i = from + (step * ctr.fetch_add(1, std::memory_order_relaxed));
+		const int tid = ThreadPool::GetThreadNum();
 
-		if (i < to) {
-			func(i);
-			remainingTasks -= 1;
+		// own block first, then steal; victim scan starts at our right
+		// neighbour so concurrent thieves fan out over different blocks
+		// instead of all ganging up on block zero
+		for (int b = 0; b < numBlocks; b++) {
+			auto& block = blocks[(tid + b) % numBlocks];
+
+			const int beg = block.nxt.fetch_add(chunk, std::memory_order_relaxed);
+			const int end = std::min(beg + chunk, block.end.load(std::memory_order_relaxed));
+
+			if (beg >= end)
+				continue;
+
+			for (int i = beg; i < end; i++) {
+				func(from + (step * i));
+			}
+
+			remainingTasks -= (end - beg);
 			return true;
 		}
 
@@ -626,11 +670,19 @@ public:
 	}
 
 private:
-	std::atomic<int> ctr;
+	// cursors live on their own cache-line, stealing a chunk from one
+	// block must not invalidate the lines owners of other blocks spin on
+	struct alignas(64) SliceBlock {
+		std::atomic<int> nxt;
+		std::atomic<int> end;
+	};
+
+	std::array<SliceBlock, ThreadPool::MAX_THREADS> blocks;
 	std::function<void(const int)> func;
 
+	int numBlocks;
+	int chunk;
 	int from;
-	int to;
 	int step;
 };
 #endif
@@ -819,6 +871,33 @@ namespace ThreadPool {
 		ThreadPool::PushTaskGroup(task);
 		return fut;
 	}
+
+	// as Enqueue, but with a stable key-to-worker mapping instead of the
+	// round-robin distribution; repeat jobs touching the same resource
+	// (same model, same sound item, ...) are then always handled by the
+	// worker whose caches are already warm with its data
+	template<class F, class... Args>
+	static inline auto EnqueueWithAffinity(uint32_t affinityKey, F&& f, Args&&... args)
+	-> std::shared_ptr<std::future<typename std::result_of<F(Args...)>::type>>
+	{
+		typedef typename std::result_of<F(Args...)>::type return_type;
+
+		if (!ThreadPool::HasThreads()) {
+			// directly process when there are no worker threads
+			auto task = std::make_shared< std::packaged_task<return_type()> >(std::bind(f, args ...));
+			auto fut = std::make_shared<std::future<return_type>>(task->get_future());
+			(*task)();
+			return fut;
+		}
+
+		auto task = new AsyncTask<F, Args...>(std::forward<F>(f), std::forward<Args>(args)...);
+		auto fut = task->GetFuture();
+
+		task->wantedThread.store(1 + affinityKey % (ThreadPool::GetNumThreads() - 1));
+
+		ThreadPool::PushTaskGroup(task);
+		return fut;
+	}
 }
 
 #endif
@@ -1,18 +1,18 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
 #include <algorithm>
+#include <array>
 #include <climits>
 #include <cstring>
+#include <fstream>
 
 #include "System/TimeProfiler.h"
 #include "System/GlobalRNG.h"
+#include "System/MainDefines.h"
 #include "System/StringHash.h"
 #include "System/Log/ILog.h"
 #include "System/Threading/SpringThreading.h"
-
-#ifdef THREADPOOL
-	#include "System/Threading/ThreadPool.h"
-#endif
+#include "System/Threading/ThreadPool.h"
 
 static spring::spinlock profileMutex;
 static spring::spinlock hashToNameMutex;
@@ -22,6 +22,44 @@ static spring::unordered_map<unsigned, int> refCounters;
 static CGlobalUnsyncedRNG profileColorRNG;
 
 
+// per-thread ring buffers of completed scopes; each is written only by
+// its owning thread and drained only by the main thread during Update,
+// so worker-thread timers never contend on (or wait for) profileMutex
+struct ScopeEventRing {
+	static constexpr uint32_t CAPACITY = 4096; // must be a power of two
+
+	std::atomic<uint32_t> head = {0};
+	std::atomic<uint32_t> tail = {0}; // only advanced by the drain
+
+	std::array<CTimeProfiler::ScopeEvent, CAPACITY> events;
+};
+
+static std::array<ScopeEventRing, ThreadPool::MAX_THREADS> scopeEventRings;
+
+// current timer nesting level of this thread
+static _threadlocal unsigned scopeEventDepth = 0;
+
+// how long drained events are kept around for DumpTraceFile
+static constexpr float MAX_TRACE_MSECS = 10.0f * 1000.0f;
+
+
+static void PushScopeEvent(unsigned nameHash, const spring_time startTime, const spring_time endTime, bool threadTimer)
+{
+	ScopeEventRing& ring = scopeEventRings[ThreadPool::GetThreadNum()];
+
+	const uint32_t head = ring.head.load(std::memory_order_relaxed);
+
+	// drop the event if the drain has fallen a full lap behind; never
+	// overwrite unread slots, the reader might be copying one of them
+	if ((head - ring.tail.load(std::memory_order_relaxed)) >= ScopeEventRing::CAPACITY)
+		return;
+
+	ring.events[head & (ScopeEventRing::CAPACITY - 1)] = {nameHash, scopeEventDepth, startTime, endTime, threadTimer};
+	// release, the drain may not observe a half-written event
+	ring.head.store(head + 1, std::memory_order_release);
+}
+
+
 spring_time BasicTimer::GetDuration() const
 {
 	return spring_difftime(spring_gettime(), startTime);
@@ -41,6 +79,8 @@ ScopedTimer::ScopedTimer(const unsigned _nameHash, bool _autoShowGraph, bool _sp
 		iter = refCounters.insert(std::pair<unsigned, int>(nameHash, 0)).first;
 
 	++(iter->second);
+
+	scopeEventDepth += 1;
 }
 
 ScopedTimer::~ScopedTimer()
@@ -51,6 +91,11 @@ ScopedTimer::~ScopedTimer()
 	assert(iter != refCounters.end());
 	assert(iter->second > 0);
 
+	// ctor and dtor strictly nest, so this is our own entry depth again
+	scopeEventDepth -= 1;
+
+	PushScopeEvent(nameHash, startTime, spring_gettime(), false);
+
 	if (--(iter->second) == 0) {
 		profiler.AddTime(nameHash, startTime, GetDuration(), autoShowGraph, specialTimer, false);
 	}
@@ -92,11 +137,17 @@ ScopedMtTimer::ScopedMtTimer(unsigned _nameHash, bool _autoShowGraph)
 	: BasicTimer(_nameHash)
 	, autoShowGraph(_autoShowGraph)
 {
+	scopeEventDepth += 1;
 }
 
 ScopedMtTimer::~ScopedMtTimer()
 {
-	profiler.AddTime(nameHash, startTime, GetDuration(), autoShowGraph, false, true);
+	// only write the local ring here; aggregation into <profiles> is
+	// done by the drain, worker timing must not touch the spinlock or
+	// it distorts the very workloads being measured
+	scopeEventDepth -= 1;
+
+	PushScopeEvent(nameHash, startTime, spring_gettime(), true);
 }
 
 
@@ -181,6 +232,8 @@ void CTimeProfiler::ResetState() {
 	threadProfiles.clear();
 	threadProfiles.resize(ThreadPool::GetMaxThreads());
 	#endif
+	threadScopeEvents.clear();
+	threadScopeEvents.resize(ThreadPool::MAX_THREADS);
 
 	profileColorRNG.Seed(spring_tomsecs(lastBigUpdate = spring_gettime()));
 
@@ -217,8 +270,47 @@ void CTimeProfiler::Update()
 	RefreshProfilesRaw();
 }
 
+void CTimeProfiler::DrainScopeEventsRaw()
+{
+	const spring_time minTime = spring_gettime() - spring_time::fromMilliSecs(int64_t(MAX_TRACE_MSECS));
+
+	for (size_t tid = 0; tid < scopeEventRings.size() && tid < threadScopeEvents.size(); tid++) {
+		ScopeEventRing& ring = scopeEventRings[tid];
+
+		auto& events = threadScopeEvents[tid];
+
+		// acquire pairs with the release in PushScopeEvent
+		const uint32_t head = ring.head.load(std::memory_order_acquire);
+
+		for (uint32_t tail = ring.tail.load(std::memory_order_relaxed); tail != head; tail++) {
+			const ScopeEvent& e = ring.events[tail & (ScopeEventRing::CAPACITY - 1)];
+
+			events.push_back(e);
+
+			if (!e.threadTimer || !enabled)
+				continue;
+
+			// merged aggregation of worker scopes, formerly done (under
+			// profileMutex) by every ScopedMtTimer dtor individually
+			#ifdef THREADPOOL
+			threadProfiles[tid].emplace_back(e.startTime, e.endTime);
+			#endif
+			AddTimeRaw(e.nameHash, e.startTime, e.endTime - e.startTime, false, false);
+		}
+
+		ring.tail.store(head, std::memory_order_relaxed);
+
+		// only keep a bounded window of raw events around for dumping
+		while (!events.empty() && events.front().endTime < minTime) {
+			events.pop_front();
+		}
+	}
+}
+
 void CTimeProfiler::UpdateRaw()
 {
+	DrainScopeEventsRaw();
+
 	currentPosition += 1;
 	currentPosition &= (TimeRecord::numFrames - 1);
 
@@ -411,3 +503,48 @@ void CTimeProfiler::PrintProfilingInfo() const
 	}
 }
 
+bool CTimeProfiler::DumpTraceFile(const char* fileName) const
+{
+	std::ofstream file(fileName);
+
+	if (!file.good()) {
+		LOG_L(L_ERROR, "[TimeProfiler::%s] could not open \"%s\" for writing", __func__, fileName);
+		return false;
+	}
+
+	// Chrome trace-event format; complete ("X") events carry begin-time
+	// and duration in microseconds, viewers rebuild the scope hierarchy
+	// from their containment
+	file << "{\"traceEvents\":[";
+
+	bool first = true;
+
+	{
+		std::lock_guard<spring::spinlock> lock(hashToNameMutex);
+
+		for (size_t tid = 0; tid < threadScopeEvents.size(); tid++) {
+			for (const ScopeEvent& e: threadScopeEvents[tid]) {
+				const auto iter = hashToName.find(e.nameHash);
+				const char* name = (iter != hashToName.end()) ? iter->second.c_str() : "???";
+
+				if (!first)
+					file << ",";
+
+				first = false;
+
+				file << "\n{\"pid\":0,\"tid\":" << tid;
+				file << ",\"ph\":\"X\"";
+				file << ",\"ts\":" << e.startTime.toMicroSecs<double>();
+				file << ",\"dur\":" << (e.endTime - e.startTime).toMicroSecs<double>();
+				file << ",\"name\":\"" << name << "\"";
+				file << ",\"args\":{\"depth\":" << e.depth << "}}";
+			}
+		}
+	}
+
+	file << "\n]}\n";
+
+	LOG("[TimeProfiler::%s] wrote trace of the last %.0f seconds to \"%s\"", __func__, MAX_TRACE_MSECS * 0.001f, fileName);
+	return true;
+}
+
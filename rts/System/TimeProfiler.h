@@ -104,6 +104,19 @@ public:
 	static bool UnRegisterTimer(const char* name);
 
 
+	// raw scope measurement; depth gives the true parent-child nesting
+	// of timers on the recording thread (parents fully enclose children
+	// in time, which flame-graph viewers use to rebuild the hierarchy)
+	struct ScopeEvent {
+		unsigned nameHash;
+		unsigned depth;
+
+		spring_time startTime;
+		spring_time endTime;
+
+		bool threadTimer;
+	};
+
 	struct TimeRecord {
 		TimeRecord() {
 			memset(frames, 0, sizeof(frames));
@@ -167,6 +180,10 @@ public:
 	void SetEnabled(bool b) { enabled = b; }
 	void PrintProfilingInfo() const;
 
+	// writes buffered scope events as a Chrome trace-event file which
+	// flame-graph viewers (chrome://tracing, speedscope, ...) can open
+	bool DumpTraceFile(const char* fileName) const;
+
 	void AddTime(
 		unsigned nameHash,
 		const spring_time startTime,
@@ -183,11 +200,15 @@ public:
 		const bool threadTimer
 	);
 
+private:
+	void DrainScopeEventsRaw();
+
 private:
 	spring::unordered_map<unsigned, TimeRecord> profiles;
 
 	std::vector< std::pair<std::string, TimeRecord> > sortedProfiles;
 	std::vector< std::deque< std::pair<spring_time, spring_time> > > threadProfiles;
+	std::vector< std::deque<ScopeEvent> > threadScopeEvents;
 
 	spring_time lastBigUpdate;
 
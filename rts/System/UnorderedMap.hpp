@@ -7,6 +7,12 @@
 // boost's implementation also uses LL buckets; see boost/unordered/detail/buckets.hpp
 // (we want open addressing, so google's {sparse,dense}_hash_map are better candidates)
 // #define USE_BOOST_HASH_MAP
+//
+// NOTE:
+//   with USE_EMILIB_HASH_MAP the spring:: aliases resolve to a flat
+//   open-addressing table (SpringHashMap.hpp), so sim-side users pay
+//   no per-node allocations or pointer chasing; creg serialization of
+//   either alias is handled by creg/STL_Map.h
 
 
 #ifndef USE_EMILIB_HASH_MAP
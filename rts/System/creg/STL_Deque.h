@@ -11,11 +11,12 @@
 
 namespace creg
 {
-	/// Deque type (uses vector implementation)
-	template<typename T>
-	struct DeduceType< std::deque <T> > {
+	/// Deque type (uses vector implementation); allocator-agnostic so
+	/// pool-backed deques serialize the same as default-allocated ones
+	template<typename T, typename A>
+	struct DeduceType< std::deque <T, A> > {
 		static std::unique_ptr<IType> Get() {
-			return std::unique_ptr<IType>(new DynamicArrayType< std::deque<T> >());
+			return std::unique_ptr<IType>(new DynamicArrayType< std::deque<T, A> >());
 		}
 	};
 }
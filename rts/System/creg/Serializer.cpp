@@ -114,6 +114,98 @@ void WriteVarSizeUInt(std::ostream* stream, T val)
 	} while (v > 0);
 }
 
+//-------------------------------------------------------------------------
+// Compiled layout plans
+//-------------------------------------------------------------------------
+// flattens the reflective member walk (base-chain recursion, flag tests,
+// per-element type deduction in static arrays) of a class into a linear
+// op table; built lazily once per class and shared by every object of
+// that class in both the saving and the loading direction
+
+namespace {
+	struct PlanOp {
+		enum OpType {
+			OP_BASIC,      // single varint-encoded basic member
+			OP_BASIC_SPAN, // static array of basic members
+			OP_TYPE_SPAN,  // static array of any other element type
+			OP_TYPE,       // anything else, dispatched through IType
+			OP_PROC        // a class's Serialize() hook
+		};
+
+		OpType op;
+
+		unsigned int offset;
+		int size;  // element size for OP_BASIC{_SPAN} and OP_TYPE_SPAN
+		int count; // element count for OP_*_SPAN
+
+		creg::IType* type;
+		creg::Class* procClass;
+	};
+
+	typedef std::vector<PlanOp> SerializePlan;
+
+	void BuildSerializePlan(creg::Class* c, SerializePlan& plan)
+	{
+		if (c->base() != nullptr)
+			BuildSerializePlan(c->base(), plan);
+
+		for (creg::Class::Member& m: c->members) {
+			if (m.flags & creg::CM_NoSerialize)
+				continue;
+
+			PlanOp po;
+			po.offset = m.offset;
+			po.size = m.type->GetSize();
+			po.count = 1;
+			po.type = m.type.get();
+			po.procClass = nullptr;
+
+			const creg::StaticArrayBaseType* sat = dynamic_cast<creg::StaticArrayBaseType*>(po.type);
+
+			if (dynamic_cast<creg::BasicType*>(po.type) != nullptr) {
+				po.op = PlanOp::OP_BASIC;
+			} else if (sat != nullptr) {
+				// note: StaticArrayType::Serialize re-deduces (allocates!)
+				// the element type per element, the span ops reuse the one
+				// instance the array type already owns
+				po.size = sat->elemType->GetSize();
+				po.count = m.type->GetSize() / po.size;
+				po.type = sat->elemType.get();
+				po.op = (dynamic_cast<creg::BasicType*>(po.type) != nullptr)? PlanOp::OP_BASIC_SPAN: PlanOp::OP_TYPE_SPAN;
+			} else {
+				po.op = PlanOp::OP_TYPE;
+			}
+
+			plan.push_back(po);
+		}
+
+		if (c->HasSerialize()) {
+			PlanOp po;
+			po.op = PlanOp::OP_PROC;
+			po.offset = 0;
+			po.size = 0;
+			po.count = 0;
+			po.type = nullptr;
+			po.procClass = c;
+			plan.push_back(po);
+		}
+	}
+
+	const SerializePlan& GetSerializePlan(creg::Class* c)
+	{
+		static std::map<creg::Class*, SerializePlan> plans;
+
+		const auto it = plans.find(c);
+
+		if (it != plans.end())
+			return it->second;
+
+		SerializePlan& plan = plans[c];
+		BuildSerializePlan(c, plan);
+		return plan;
+	}
+}
+
 //-------------------------------------------------------------------------
 // Base output serializer
 //-------------------------------------------------------------------------
@@ -138,11 +230,46 @@ COutputStreamSerializer::ObjectRef* COutputStreamSerializer::FindObjectRef(void*
 }
 
 void COutputStreamSerializer::SerializeObject(Class* c, void* ptr, ObjectRef* objr)
+{
+	// the reflective walk below only exists for its per-member debug
+	// bookkeeping; take the compiled-layout path whenever that is off
+	if (!LOG_IS_ENABLED_S(LOG_SECTION_CREG_SERIALIZER, L_DEBUG)) {
+		for (const PlanOp& po: GetSerializePlan(c)) {
+			void* memberAddr = ((char*)ptr) + po.offset;
+
+			switch (po.op) {
+				case PlanOp::OP_BASIC: {
+					SerializeInt(memberAddr, po.size);
+				} break;
+				case PlanOp::OP_BASIC_SPAN: {
+					for (int i = 0; i < po.count; i++)
+						SerializeInt(((char*)memberAddr) + i * po.size, po.size);
+				} break;
+				case PlanOp::OP_TYPE_SPAN: {
+					for (int i = 0; i < po.count; i++)
+						po.type->Serialize(this, ((char*)memberAddr) + i * po.size);
+				} break;
+				case PlanOp::OP_TYPE: {
+					po.type->Serialize(this, memberAddr);
+				} break;
+				case PlanOp::OP_PROC: {
+					po.procClass->CallSerializeProc(ptr, this);
+				} break;
+			}
+		}
+
+		return;
+	}
+
+	SerializeObjectDebug(c, ptr, objr);
+}
+
+void COutputStreamSerializer::SerializeObjectDebug(Class* c, void* ptr, ObjectRef* objr)
 {
 	const unsigned objstart = stream->tellp();
 
 	if (c->base())
-		SerializeObject(c->base(), ptr, objr);
+		SerializeObjectDebug(c->base(), ptr, objr);
 
 	ObjectMemberGroup omg;
 	omg.membersClass = c;
@@ -200,12 +327,12 @@ void COutputStreamSerializer::SerializeObjectInstance(void* inst, creg::Class* o
 	} else if (obj->isEmbedded) {
 		throw std::string("Reserialization of embedded object (") + objClass->name + ")";
 	} else {
-		std::vector<ObjectRef*>::iterator it = std::find(pendingObjects.begin(), pendingObjects.end(), obj);
-		if (it == pendingObjects.end()) {
+		// object was referenced by pointer first and queued, the save
+		// loop skips it now that it gets embedded here instead
+		if (!obj->isPending)
 			throw std::string("Object pointer was serialized (") + objClass->name + ")";
-		} else {
-			pendingObjects.erase(it);
-		}
+
+		obj->isPending = false;
 	}
 	obj->class_ = objClass;
 	obj->isEmbedded = true;
@@ -226,6 +353,7 @@ void COutputStreamSerializer::SerializeObjectPtr(void** ptr, creg::Class* objCla
 		if (!obj) {
 			objects.emplace_back(*ptr, objects.size(), false, objClass);
 			obj = &objects.back();
+			obj->isPending = true;
 			ptrToId[*ptr].push_back(obj);
 			pendingObjects.push_back(obj);
 		}
@@ -286,6 +414,7 @@ void COutputStreamSerializer::SavePackage(std::ostream* s, void* rootObj, Class*
 	// Insert the first object that will provide references to everything
 	objects.emplace_back(rootObj, objects.size(), false, rootObjClass);
 	obj = &objects.back();
+	obj->isPending = true;
 	ptrToId[rootObj].push_back(obj);
 	pendingObjects.push_back(obj);
 
@@ -296,6 +425,11 @@ void COutputStreamSerializer::SavePackage(std::ostream* s, void* rootObj, Class*
 		pendingObjects.clear();
 
 		for (ObjectRef* obj: po) {
+			// cleared if the object got embedded into another meanwhile
+			if (!obj->isPending)
+				continue;
+
+			obj->isPending = false;
 			SerializeObject(obj->class_, obj->ptr, obj);
 			//LOG_SL(LOG_SECTION_CREG_SERIALIZER, L_DEBUG, "Serialized %s size:%i", obj->class_->name.c_str(), sz);
 		}
@@ -405,9 +539,44 @@ bool CInputStreamSerializer::IsWriting()
 }
 
 void CInputStreamSerializer::SerializeObject(Class* c, void* ptr)
+{
+	// mirror of the saving side: compiled layout unless the per-member
+	// debug logging of the reflective walk is wanted
+	if (!LOG_IS_ENABLED_S(LOG_SECTION_CREG_SERIALIZER, L_DEBUG)) {
+		for (const PlanOp& po: GetSerializePlan(c)) {
+			void* memberAddr = ((char*)ptr) + po.offset;
+
+			switch (po.op) {
+				case PlanOp::OP_BASIC: {
+					SerializeInt(memberAddr, po.size);
+				} break;
+				case PlanOp::OP_BASIC_SPAN: {
+					for (int i = 0; i < po.count; i++)
+						SerializeInt(((char*)memberAddr) + i * po.size, po.size);
+				} break;
+				case PlanOp::OP_TYPE_SPAN: {
+					for (int i = 0; i < po.count; i++)
+						po.type->Serialize(this, ((char*)memberAddr) + i * po.size);
+				} break;
+				case PlanOp::OP_TYPE: {
+					po.type->Serialize(this, memberAddr);
+				} break;
+				case PlanOp::OP_PROC: {
+					po.procClass->CallSerializeProc(ptr, this);
+				} break;
+			}
+		}
+
+		return;
+	}
+
+	SerializeObjectDebug(c, ptr);
+}
+
+void CInputStreamSerializer::SerializeObjectDebug(Class* c, void* ptr)
 {
 	if (c->base())
-		SerializeObject(c->base(), ptr);
+		SerializeObjectDebug(c->base(), ptr);
 
 	for (uint a = 0; a < c->members.size(); a++)
 	{
@@ -5,6 +5,7 @@
 
 #include "ISerializer.h"
 #include "creg_cond.h"
+#include "System/UnorderedMap.hpp"
 
 #ifdef USING_CREG
 
@@ -39,6 +40,7 @@ namespace creg {
 				id=0;
 				classIndex=0;
 				isEmbedded=false;
+				isPending=false;
 				class_=0;
 			}
 			ObjectRef(void* ptr, int id, bool isEmbedded, Class* class_) {
@@ -46,6 +48,7 @@ namespace creg {
 				this->id=id;
 				classIndex=0;
 				this->isEmbedded=isEmbedded;
+				isPending=false;
 				this->class_=class_;
 			}
 			ObjectRef(const ObjectRef&src) :memberGroups(src.memberGroups){
@@ -53,11 +56,13 @@ namespace creg {
 				id=src.id;
 				classIndex=src.classIndex;
 				isEmbedded=src.isEmbedded;
+				isPending=src.isPending;
 				class_=src.class_;
 			}
 			void* ptr;
 			int id, classIndex;
 			bool isEmbedded;
+			bool isPending; // queued in pendingObjects, not written yet
 			Class* class_;
 			std::vector<COutputStreamSerializer::ObjectMemberGroup> memberGroups;
 			bool isThisObject(void* objPtr, Class* objClass, bool objEmbedded) const
@@ -81,7 +86,9 @@ namespace creg {
 		struct ClassRef;
 
 		std::ostream* stream;
-		std::map<void*,std::vector<ObjectRef*> > ptrToId;
+		// hashed on the raw address; consulted once per serialized
+		// pointer and instance, by far the hottest structure here
+		spring::unsynced_map<void*,std::vector<ObjectRef*> > ptrToId;
 		std::deque<ObjectRef> objects;
 		std::vector<ObjectRef*> pendingObjects; // these objects still have to be saved
 		std::map<Class*, int> classSizes;
@@ -95,6 +102,9 @@ namespace creg {
 		ObjectRef* FindObjectRef(void* inst, Class* objClass, bool isEmbedded);
 
 		void SerializeObject(Class* c, void* ptr, ObjectRef* objr);
+		// reflective walk with per-member bookkeeping, only taken when
+		// the CregSerializer debug-log section is enabled
+		void SerializeObjectDebug(Class* c, void* ptr, ObjectRef* objr);
 
 	public:
 		COutputStreamSerializer();
@@ -158,6 +168,7 @@ namespace creg {
 		std::vector<PostLoadCallback> callbacks;
 
 		void SerializeObject(Class* c, void* ptr);
+		void SerializeObjectDebug(Class* c, void* ptr);
 	public:
 		CInputStreamSerializer();
 		~CInputStreamSerializer();
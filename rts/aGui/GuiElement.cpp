@@ -1,5 +1,7 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
+#include <algorithm> // max
+#include <cassert>
 #include <cstring> // memset
 #include "GuiElement.h"
 
@@ -11,20 +13,13 @@
 namespace agui
 {
 
-struct RenderElem {
+// all element geometry of one type (box, extra, outline) lives in a
+// single shared buffer; every element owns a fixed-size vertex slot
+// addressed by elIndex, so geometry updates are plain sub-uploads and
+// drawing never creates, fills or rebinds per-element buffer objects
+struct RenderBuffer {
 public:
-	RenderElem() = default;
-	RenderElem(RenderElem&& e) { *this = std::move(e); }
-	RenderElem(const RenderElem& e) = delete;
-
-	RenderElem& operator = (const RenderElem& e) = delete;
-	RenderElem& operator = (RenderElem&& e) {
-		array = std::move(e.array);
-		verts = std::move(e.verts);
-		return *this;
-	}
-
-	void EnableAttribs() {
+	void EnableAttribs() const {
 		// texcoors are effectively ignored for all elements except Picture
 		// (however, shader always samples from the texture so do not leave
 		// them undefined)
@@ -33,37 +28,57 @@ public:
 		glVertexAttribPointer(0, 3, GL_FLOAT, false, sizeof(VA_TYPE_T), VA_TYPE_OFFSET(float, 0));
 		glVertexAttribPointer(1, 2, GL_FLOAT, false, sizeof(VA_TYPE_T), VA_TYPE_OFFSET(float, 3));
 	}
-	void DisableAttribs() {
-	}
 
-	void Generate() {
-		array.Generate();
-		verts.Generate();
-	}
-	void Bind() {
+	void ReserveSlots(size_t numSlots, unsigned int slotVerts) {
+		if (numSlots <= numReservedSlots)
+			return;
+
+		if (numReservedSlots == 0)
+			array.Generate();
+
+		numReservedSlots = std::max(numSlots, std::max<size_t>(numReservedSlots * 2, 16));
+
 		array.Bind();
 		verts.Bind();
-	}
-	void Unbind() {
+		// Resize copies into a fresh buffer object, so the attribute
+		// bindings have to be respecified against the new id
+		verts.Resize(numReservedSlots * slotVerts * sizeof(VA_TYPE_T), GL_DYNAMIC_DRAW);
+		EnableAttribs();
 		array.Unbind();
 		verts.Unbind();
 	}
-	void Submit(unsigned int mode, unsigned int size = 4) {
+
+	void Update(size_t slotIndx, unsigned int numBytes, const VA_TYPE_T* elemsPtr) {
+		verts.Bind();
+		glBufferSubData(GL_ARRAY_BUFFER, slotIndx * numBytes, numBytes, elemsPtr);
+		verts.Unbind();
+	}
+
+	void Submit(unsigned int mode, unsigned int firstVert, unsigned int numVerts) const {
 		array.Bind();
-		glDrawArrays(mode, 0, size);
+		glDrawArrays(mode, firstVert, numVerts);
 		array.Unbind();
 	}
+
 	void Delete() {
 		array.Delete();
 		verts.Delete();
+		numReservedSlots = 0;
 	}
 
 	VAO array;
 	VBO verts;
+
+	size_t numReservedSlots = 0;
 };
 
-static std::vector<RenderElem> renderElems[3];
+// vertices per element slot; [0] holds the background box, [1] any
+// subclass extra (e.g. the Window title-bar), [2] the outline strip
+static constexpr unsigned int slotNumVerts[3] = {4, 4, 10};
+
+static RenderBuffer renderBuffers[3];
 static std::vector<size_t> freeIndices;
+static size_t numElemSlots = 0;
 
 
 
@@ -73,26 +88,17 @@ int GuiElement::screenoffset[2];
 
 GuiElement::GuiElement(GuiElement* _parent) : parent(_parent), fixedSize(false), weight(1), elIndex(-1)
 {
-	if (renderElems[0].empty()) {
-		for (auto& rev: renderElems) {
-			rev.reserve(16);
-		}
-	}
-
 	if (freeIndices.empty()) {
-		elIndex = renderElems[0].size();
-		for (auto& rev: renderElems) {
-			rev.emplace_back();
+		elIndex = numElemSlots++;
+
+		for (unsigned int n = 0; n < 3; ++n) {
+			renderBuffers[n].ReserveSlots(numElemSlots, slotNumVerts[n]);
 		}
 	} else {
 		elIndex = freeIndices.back();
 		freeIndices.pop_back();
 	}
 
-	for (auto& rev: renderElems) {
-		rev[elIndex].Generate();
-	}
-
 	std::memset(pos, 0, sizeof(pos));
 	std::memset(size, 0, sizeof(size));
 
@@ -109,32 +115,38 @@ GuiElement::~GuiElement()
 	for (auto i = children.begin(), e = children.end(); i != e; ++i) {
 		delete *i;
 	}
-	for (auto& rev: renderElems) {
-		rev[elIndex].Delete();
-		rev[elIndex] = std::move(RenderElem());
-	}
 
 	freeIndices.push_back(elIndex);
+
+	// last element gone, release the shared buffers (these get
+	// regenerated on demand if the GUI comes back to life)
+	if (freeIndices.size() == numElemSlots) {
+		for (auto& buf: renderBuffers) {
+			buf.Delete();
+		}
+
+		freeIndices.clear();
+		numElemSlots = 0;
+	}
 }
 
 
 
 void GuiElement::DrawBox(unsigned int indx) {
-	renderElems[indx][elIndex].Submit(GL_TRIANGLE_STRIP, 4);
+	renderBuffers[indx].Submit(GL_TRIANGLE_STRIP, elIndex * slotNumVerts[indx], slotNumVerts[indx]);
 }
 
 void GuiElement::DrawOutline() {
-	renderElems[2][elIndex].Submit(GL_TRIANGLE_STRIP, 10);
+	renderBuffers[2].Submit(GL_TRIANGLE_STRIP, elIndex * slotNumVerts[2], slotNumVerts[2]);
 }
 
 
 void GuiElement::GeometryChangeSelfRaw(unsigned int bufIndx, unsigned int numBytes, const VA_TYPE_T* elemsPtr) const
 {
-	renderElems[bufIndx][elIndex].Bind();
-	renderElems[bufIndx][elIndex].verts.New(numBytes, GL_DYNAMIC_DRAW, elemsPtr);
-	renderElems[bufIndx][elIndex].EnableAttribs();
-	renderElems[bufIndx][elIndex].Unbind();
-	renderElems[bufIndx][elIndex].DisableAttribs();
+	// slots are fixed-size, callers may not submit partial geometry
+	assert(numBytes == slotNumVerts[bufIndx] * sizeof(VA_TYPE_T));
+
+	renderBuffers[bufIndx].Update(elIndex, numBytes, elemsPtr);
 }
 
 void GuiElement::GeometryChangeSelf()
@@ -1,6 +1,8 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -56,7 +58,7 @@ extern "C"
 {
 #endif
 
-void ParseCmdLine(int argc, char* argv[], std::string& scriptName)
+void ParseCmdLine(int argc, char* argv[], std::vector<std::string>& scriptNames)
 {
 	#undef  LOG_SECTION_CURRENT
 	#define LOG_SECTION_CURRENT LOG_SECTION_DEFAULT
@@ -73,10 +75,13 @@ void ParseCmdLine(int argc, char* argv[], std::string& scriptName)
 		exit(0);
 	}
 
-	if (argc >= 2)
-		scriptName = argv[1];
+	// every positional argument is a start script; more than one means
+	// hosting that many games from a single process (sharing the archive
+	// scanner, the VFS and the def caches between them)
+	for (int i = 1; i < argc; i++)
+		scriptNames.emplace_back(argv[i]);
 
-	if (scriptName.empty() && !FLAGS_list_config_vars) {
+	if (scriptNames.empty() && !FLAGS_list_config_vars) {
 		gflags::ShowUsageWithFlags(argv[0]);
 		exit(1);
 	}
@@ -119,14 +124,13 @@ int main(int argc, char* argv[])
 
 		CLogOutput::LogSystemInfo();
 
-		std::string scriptName;
-		std::string scriptText;
+		std::vector<std::string> scriptNames;
 		std::string binaryName = argv[0];
 
-		gflags::SetUsageMessage("Usage: " + binaryName + " [options] path_to_script.txt");
+		gflags::SetUsageMessage("Usage: " + binaryName + " [options] path_to_script.txt [path_to_script.txt ...]");
 		gflags::SetVersionString(SpringVersion::GetFull());
 		gflags::ParseCommandLineFlags(&argc, &argv, true);
-		ParseCmdLine(argc, argv, scriptName);
+		ParseCmdLine(argc, argv, scriptNames);
 
 		globalConfig.Init();
 		FileSystemInitializer::InitializeLogOutput();
@@ -136,113 +140,152 @@ int main(int argc, char* argv[])
 		CrashHandler::Install();
 
 		LOG("report any errors to Mantis or the forums.");
-		LOG("loading script from file: %s", scriptName.c_str());
 
-		// server will take ownership of these
-		std::shared_ptr<ClientSetup> dsClientSetup(new ClientSetup());
-		std::shared_ptr<GameData> dsGameData(new GameData());
-		std::shared_ptr<CGameSetup> dsGameSetup(new CGameSetup());
+		CGlobalUnsyncedRNG rng;
 
-		CFileHandler fh(scriptName);
+		const uint32_t sleepTime = FLAGS_sleeptime;
+		const uint32_t randSeed = time(nullptr) % ((spring_gettime().toNanoSecsi() + 1) * 9007);
 
-		if (!fh.FileExists())
-			throw content_error("script does not exist in given location: " + scriptName);
+		rng.Seed(randSeed);
 
-		if (!fh.LoadStringData(scriptText))
-			throw content_error("script cannot be read: " + scriptName);
+		// one hosted game per start script; each server runs its update
+		// loop on its own thread, the per-game state below is only ever
+		// touched from this (the main) thread
+		struct HostedGame {
+			std::shared_ptr<CGameSetup> setup;
+			std::unique_ptr<CGameServer> server;
 
-		dsClientSetup->LoadFromStartScript(scriptText);
+			bool demoInfoPrinted = false;
+		};
 
-		if (!dsGameSetup->Init(scriptText)) {
-			// read the script provided by cmdline
-			LOG_L(L_ERROR, "failed to load script %s", scriptName.c_str());
-			return 1;
-		}
+		std::vector<HostedGame> games;
+		games.reserve(scriptNames.size());
 
-		// create the server, it will run in a separate thread
-		CGlobalUnsyncedRNG rng;
+		// parse the scripts and resolve archive dependencies serially on
+		// the main thread; the scanner and VFS are not written to again
+		// once the servers are up, so they can be shared by all games
+		for (const std::string& scriptName: scriptNames) {
+			LOG("loading script from file: %s", scriptName.c_str());
 
-		const uint32_t sleepTime = FLAGS_sleeptime;
-		const uint32_t randSeed = time(nullptr) % ((spring_gettime().toNanoSecsi() + 1) * 9007);
+			std::string scriptText;
 
-		rng.Seed(randSeed);
-		dsGameData->SetRandomSeed(rng.NextInt());
+			// server will take ownership of these
+			std::shared_ptr<ClientSetup> dsClientSetup(new ClientSetup());
+			std::shared_ptr<GameData> dsGameData(new GameData());
+			std::shared_ptr<CGameSetup> dsGameSetup(new CGameSetup());
 
-		{
-			sha512::raw_digest dsMapChecksum;
-			sha512::raw_digest dsModChecksum;
-			sha512::hex_digest dsMapChecksumHex;
-			sha512::hex_digest dsModChecksumHex;
+			CFileHandler fh(scriptName);
 
-			std::memcpy(dsMapChecksum.data(), &dsGameSetup->dsMapHash[0], sizeof(dsGameSetup->dsMapHash));
-			std::memcpy(dsModChecksum.data(), &dsGameSetup->dsModHash[0], sizeof(dsGameSetup->dsModHash));
-			sha512::dump_digest(dsMapChecksum, dsMapChecksumHex);
-			sha512::dump_digest(dsModChecksum, dsModChecksumHex);
+			if (!fh.FileExists())
+				throw content_error("script does not exist in given location: " + scriptName);
 
-			LOG("[script-checksums]\n\tmap=%s\n\tmod=%s", dsMapChecksumHex.data(), dsModChecksumHex.data());
+			if (!fh.LoadStringData(scriptText))
+				throw content_error("script cannot be read: " + scriptName);
 
-			// use script-provided hashes if any byte is non-zero; these
-			// are only used by some client-side (pregame) sanity checks
-			const auto hashPred = [](uint8_t byte) { return (byte != 0); };
+			dsClientSetup->LoadFromStartScript(scriptText);
 
-			if (std::find_if(dsMapChecksum.begin(), dsMapChecksum.end(), hashPred) != dsMapChecksum.end()) {
-				dsGameData->SetMapChecksum(dsMapChecksum.data());
-				dsGameSetup->LoadStartPositions(false); // reduced mode
-			} else {
-				dsGameData->SetMapChecksum(&archiveScanner->GetArchiveCompleteChecksumBytes(dsGameSetup->mapName)[0]);
+			if (!dsGameSetup->Init(scriptText)) {
+				// read the script provided by cmdline
+				LOG_L(L_ERROR, "failed to load script %s", scriptName.c_str());
+				return 1;
+			}
 
-				CFileHandler f("maps/" + dsGameSetup->mapName);
-				if (!f.FileExists())
-					vfsHandler->AddArchiveWithDeps(dsGameSetup->mapName, false);
+			dsGameData->SetRandomSeed(rng.NextInt());
 
-				dsGameSetup->LoadStartPositions(); // full mode
-			}
+			{
+				sha512::raw_digest dsMapChecksum;
+				sha512::raw_digest dsModChecksum;
+				sha512::hex_digest dsMapChecksumHex;
+				sha512::hex_digest dsModChecksumHex;
+
+				std::memcpy(dsMapChecksum.data(), &dsGameSetup->dsMapHash[0], sizeof(dsGameSetup->dsMapHash));
+				std::memcpy(dsModChecksum.data(), &dsGameSetup->dsModHash[0], sizeof(dsGameSetup->dsModHash));
+				sha512::dump_digest(dsMapChecksum, dsMapChecksumHex);
+				sha512::dump_digest(dsModChecksum, dsModChecksumHex);
+
+				LOG("[script-checksums]\n\tmap=%s\n\tmod=%s", dsMapChecksumHex.data(), dsModChecksumHex.data());
+
+				// use script-provided hashes if any byte is non-zero; these
+				// are only used by some client-side (pregame) sanity checks
+				const auto hashPred = [](uint8_t byte) { return (byte != 0); };
+
+				if (std::find_if(dsMapChecksum.begin(), dsMapChecksum.end(), hashPred) != dsMapChecksum.end()) {
+					dsGameData->SetMapChecksum(dsMapChecksum.data());
+					dsGameSetup->LoadStartPositions(false); // reduced mode
+				} else {
+					dsGameData->SetMapChecksum(&archiveScanner->GetArchiveCompleteChecksumBytes(dsGameSetup->mapName)[0]);
 
-			if (std::find_if(dsModChecksum.begin(), dsModChecksum.end(), hashPred) != dsModChecksum.end()) {
-				dsGameData->SetModChecksum(dsModChecksum.data());
-			} else {
-				const std::string& modArchive = archiveScanner->ArchiveFromName(dsGameSetup->modName);
-				const sha512::raw_digest& modCheckSum = archiveScanner->GetArchiveCompleteChecksumBytes(modArchive);
+					CFileHandler f("maps/" + dsGameSetup->mapName);
+					if (!f.FileExists())
+						vfsHandler->AddArchiveWithDeps(dsGameSetup->mapName, false);
 
-				dsGameData->SetModChecksum(&modCheckSum[0]);
+					dsGameSetup->LoadStartPositions(); // full mode
+				}
+
+				if (std::find_if(dsModChecksum.begin(), dsModChecksum.end(), hashPred) != dsModChecksum.end()) {
+					dsGameData->SetModChecksum(dsModChecksum.data());
+				} else {
+					const std::string& modArchive = archiveScanner->ArchiveFromName(dsGameSetup->modName);
+					const sha512::raw_digest& modCheckSum = archiveScanner->GetArchiveCompleteChecksumBytes(modArchive);
+
+					dsGameData->SetModChecksum(&modCheckSum[0]);
+				}
 			}
-		}
 
-		LOG("starting server...");
+			LOG("starting server...");
 
-		{
 			dsGameData->SetSetupText(dsGameSetup->setupText);
-			CGameServer server(dsClientSetup, dsGameData, dsGameSetup);
 
-			while (!server.HasGameID()) {
-				// wait until gameID has been generated or
-				// a timeout occurs (if no clients connect)
-				if (server.HasFinished())
-					break;
+			games.emplace_back();
+			games.back().setup = dsGameSetup;
+			// creates the server, it will run in a separate thread
+			games.back().server.reset(new CGameServer(dsClientSetup, dsGameData, dsGameSetup));
+		}
 
-				spring_sleep(spring_secs(sleepTime));
-			}
+		{
+			bool haveRunningGame = true;
+
+			while (haveRunningGame) {
+				haveRunningGame = false;
+
+				for (HostedGame& game: games) {
+					CGameServer& server = *game.server;
+
+					if (server.HasFinished())
+						continue;
 
-			while (!server.HasFinished()) {
-				static bool printData = (server.GetDemoRecorder() != nullptr);
+					haveRunningGame = true;
 
-				if (printData) {
-					printData = false;
+					// wait until the gameID has been generated (or a
+					// timeout occurs if no clients connect) before the
+					// demo info can be printed
+					if (game.demoInfoPrinted || !server.HasGameID())
+						continue;
+
+					game.demoInfoPrinted = true;
+
+					if (server.GetDemoRecorder() == nullptr)
+						continue;
 
 					const std::unique_ptr<CDemoRecorder>& demoRec = server.GetDemoRecorder();
 					const std::uint8_t* gameID = (demoRec->GetFileHeader()).gameID;
 
 					LOG("recording demo: %s", (demoRec->GetName()).c_str());
-					LOG("using mod: %s", (dsGameSetup->modName).c_str());
-					LOG("using map: %s", (dsGameSetup->mapName).c_str());
+					LOG("using mod: %s", (game.setup->modName).c_str());
+					LOG("using map: %s", (game.setup->mapName).c_str());
 					LOG("GameID: %02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x", gameID[0], gameID[1], gameID[2], gameID[3], gameID[4], gameID[5], gameID[6], gameID[7], gameID[8], gameID[9], gameID[10], gameID[11], gameID[12], gameID[13], gameID[14], gameID[15]);
 				}
 
-				spring_secs(sleepTime).sleep(true);
+				if (haveRunningGame)
+					spring_secs(sleepTime).sleep(true);
 			}
 		}
 
+		// joins the server threads
+		games.clear();
+
 		LOG("exiting");
+		globalConfig.Kill();
 		FileSystemInitializer::Cleanup();
 		DataDirLocater::FreeInstance();
 
@@ -235,6 +235,7 @@ GLAPI void APIENTRY glCompressedTexSubImage2D(GLenum target, GLint level, GLint
 GLAPI void APIENTRY glCompressedTexSubImage1D(GLenum target, GLint level, GLint xoffset, GLsizei width, GLenum format, GLsizei imageSize, const GLvoid *data) {}
 GLAPI void APIENTRY glGetCompressedTexImage(GLenum target, GLint level, GLvoid *img) {}
 
+GLAPI void APIENTRY glTexBuffer(GLenum target, GLenum internalformat, GLuint buffer) {}
 GLAPI void APIENTRY glTexStorage2D(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height) {}
 GLAPI void APIENTRY glTexStorage3D(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth) {}
 
@@ -273,6 +274,7 @@ GLAPI void APIENTRY glFlushMappedBufferRange(GLenum target, GLintptr offset, GLs
 GLAPI GLvoid* APIENTRY glMapBuffer(GLenum target, GLenum access) { return (GLvoid*) 0; }
 GLAPI GLboolean APIENTRY glUnmapBuffer(GLenum target) { return GL_FALSE; }
 
+GLAPI void APIENTRY glMultiDrawArrays(GLenum mode, const GLint *first, const GLsizei *count, GLsizei drawcount) {}
 GLAPI void APIENTRY glMultiTexCoord2i(GLenum target, GLint s, GLint t) {}
 GLAPI void APIENTRY glMultiTexCoord2iv(GLenum target, const GLint *v) {}
 
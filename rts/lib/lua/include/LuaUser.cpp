@@ -310,10 +310,23 @@ void spring_lua_alloc_get_stats(SLuaAllocState* state)
 #endif
 }
 
-bool spring_lua_alloc_skip_gc(float gcLoadMult)
+bool spring_lua_alloc_skip_gc(const SLuaAllocState* las, float gcLoadMult)
 {
+	const uint64_t maxAllocedBytes = MAX_ALLOC_BYTES[__archBits__ == 64];
+
+	// close to the global limit every handle must collect since any
+	// garbage it reclaims helps stave off allocation failures (which
+	// kill the state outright)
+	if (gLuaAllocState.allocedBytes.load() > ((maxAllocedBytes / 4) * 3))
+		return false;
+
+	// otherwise weight by the handle's own share of the limit; running
+	// steps through a lean state because some *other* state hoards the
+	// memory reclaims nothing from the latter but still costs us frame
+	// time
+	//
 	// randomly skip a GC cycle with probability 1 - (weighted memory load ratio)
-	const float rawLoadRatio = float(gLuaAllocState.allocedBytes.load()) / float(MAX_ALLOC_BYTES[__archBits__ == 64]);
+	const float rawLoadRatio = float(las->allocedBytes.load()) / float(maxAllocedBytes);
 	const float modLoadRatio = gcLoadMult * rawLoadRatio;
 	return (lguRNG.NextFloat() > modLoadRatio);
 }
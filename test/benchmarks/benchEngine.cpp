@@ -0,0 +1,222 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+// microbenchmarks for known sim hot paths, built and run through the
+// "benchmarks" target; results are printed and dumped as JSON so the
+// numbers from two releases can be diffed instead of discovering a
+// sim-speed regression on the autohost
+//
+// iteration counts are fixed (not adaptive) so successive runs and
+// different builds always execute the exact same amount of work
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "Sim/Misc/QuadField.h"
+#include "System/float3.h"
+#include "System/float4.h"
+#include "System/Matrix44f.h"
+#include "System/Misc/SpringTime.h"
+#include "System/SimdMath.h"
+
+InitSpringTime ist;
+
+
+static inline float randf()
+{
+	return rand() / float(RAND_MAX);
+}
+
+
+struct BenchResult {
+	const char* name;
+
+	unsigned iters;
+	double nsPerIter;
+};
+
+static std::vector<BenchResult> results;
+
+// sinks so the optimizer can not discard the benchmark bodies
+static volatile float floatSink = 0.0f;
+static volatile int intSink = 0;
+
+
+template<typename F>
+static void RunBench(const char* name, unsigned iters, F&& f)
+{
+	// warm up caches and branch predictors outside the timed region
+	for (unsigned i = 0; i < (iters / 16); i++) {
+		f(i);
+	}
+
+	const spring_time t0 = spring_gettime();
+
+	for (unsigned i = 0; i < iters; i++) {
+		f(i);
+	}
+
+	const spring_time t1 = spring_gettime();
+
+	results.push_back({name, iters, (t1 - t0).toNanoSecsi() / double(iters)});
+
+	printf("%-40s %10u iters %12.2f ns/iter\n", name, iters, results.back().nsPerIter);
+}
+
+
+static void BenchFloat3()
+{
+	constexpr unsigned NUM_VECS = 1024;
+
+	std::vector<float3> vecs(NUM_VECS);
+
+	for (float3& v: vecs) {
+		v = float3(randf() - 0.5f, randf() - 0.5f, randf() - 0.5f) * 100.0f;
+	}
+
+	RunBench("float3::dot", 1 << 22, [&](unsigned i) {
+		floatSink = vecs[i % NUM_VECS].dot(vecs[(i + 1) % NUM_VECS]);
+	});
+	RunBench("float3::cross", 1 << 22, [&](unsigned i) {
+		floatSink = vecs[i % NUM_VECS].cross(vecs[(i + 1) % NUM_VECS]).y;
+	});
+	RunBench("float3::SafeNormalize", 1 << 21, [&](unsigned i) {
+		float3 v = vecs[i % NUM_VECS];
+		floatSink = v.SafeNormalize().x;
+	});
+	RunBench("float3::SqDistance2D", 1 << 22, [&](unsigned i) {
+		floatSink = vecs[i % NUM_VECS].SqDistance2D(vecs[(i + 1) % NUM_VECS]);
+	});
+}
+
+static void BenchMatrix44f()
+{
+	constexpr unsigned NUM_MATS = 256;
+
+	std::vector<CMatrix44f> mats(NUM_MATS);
+	std::vector<float3> vecs(NUM_MATS);
+
+	for (unsigned i = 0; i < NUM_MATS; i++) {
+		mats[i].RotateX(randf() * 6.28f);
+		mats[i].Translate(randf() * 100.0f, randf() * 100.0f, randf() * 100.0f);
+
+		vecs[i] = float3(randf(), randf(), randf()) * 100.0f;
+	}
+
+	RunBench("Matrix44f::operator*(Matrix44f)", 1 << 20, [&](unsigned i) {
+		floatSink = (mats[i % NUM_MATS] * mats[(i + 1) % NUM_MATS]).md[3][0];
+	});
+	RunBench("Matrix44f::operator*(float3)", 1 << 22, [&](unsigned i) {
+		floatSink = (mats[i % NUM_MATS] * vecs[i % NUM_MATS]).x;
+	});
+}
+
+static void BenchSimdMath()
+{
+	constexpr unsigned NUM_VECS = 1024;
+
+	std::vector<float4> srcVecs(NUM_VECS);
+	std::vector<float4> dstVecs(NUM_VECS);
+
+	CMatrix44f mat;
+	mat.RotateY(randf() * 6.28f);
+	mat.Translate(randf() * 100.0f, randf() * 100.0f, randf() * 100.0f);
+
+	for (float4& v: srcVecs) {
+		v = float4(randf() - 0.5f, randf() - 0.5f, randf() - 0.5f, 1.0f) * 100.0f;
+	}
+
+	// per-element cost of the batch kernels, to compare against the
+	// scalar float3/Matrix44f single-op numbers above
+	RunBench("simdmath::TransformPoints", 1 << 12, [&](unsigned i) {
+		simdmath::TransformPoints(mat, srcVecs.data(), dstVecs.data(), NUM_VECS);
+		floatSink = dstVecs[i % NUM_VECS].x;
+	});
+	RunBench("simdmath::NormalizeVectors", 1 << 12, [&](unsigned i) {
+		dstVecs = srcVecs;
+		simdmath::NormalizeVectors(dstVecs.data(), NUM_VECS);
+		floatSink = dstVecs[i % NUM_VECS].x;
+	});
+
+	std::vector<float> sqDists(NUM_VECS);
+
+	RunBench("simdmath::SqDistances", 1 << 12, [&](unsigned i) {
+		simdmath::SqDistances(srcVecs.data(), dstVecs.data(), sqDists.data(), NUM_VECS);
+		floatSink = sqDists[i % NUM_VECS];
+	});
+}
+
+static void BenchQuadField()
+{
+	// synthetic 64x64-quad map, same quad size the game uses
+	constexpr int NUM_QUADS_X = 64;
+	constexpr int NUM_QUADS_Z = 64;
+	constexpr unsigned NUM_RAYS = 1024;
+
+	quadField.Init(int2(NUM_QUADS_X, NUM_QUADS_Z), CQuadField::BASE_QUAD_SIZE);
+
+	const float mapWidth  = NUM_QUADS_X * CQuadField::BASE_QUAD_SIZE * 1.0f;
+	const float mapHeight = NUM_QUADS_Z * CQuadField::BASE_QUAD_SIZE * 1.0f;
+
+	std::vector<float3> rayStarts(NUM_RAYS);
+	std::vector<float3> rayDirs(NUM_RAYS);
+	std::vector<float> rayLengths(NUM_RAYS);
+
+	for (unsigned i = 0; i < NUM_RAYS; i++) {
+		rayStarts[i] = float3(randf() * mapWidth, 0.0f, randf() * mapHeight);
+		rayDirs[i] = float3(randf() - 0.5f, 0.0f, randf() - 0.5f).SafeNormalize();
+		rayLengths[i] = randf() * mapWidth * 0.5f;
+	}
+
+	RunBench("QuadField::GetQuads(pos, radius)", 1 << 16, [&](unsigned i) {
+		QuadFieldQuery qfQuery;
+		quadField.GetQuads(qfQuery, rayStarts[i % NUM_RAYS], rayLengths[i % NUM_RAYS] * 0.25f);
+		intSink = qfQuery.quads->size();
+	});
+	RunBench("QuadField::GetQuadsOnRay", 1 << 16, [&](unsigned i) {
+		QuadFieldQuery qfQuery;
+		quadField.GetQuadsOnRay(qfQuery, rayStarts[i % NUM_RAYS], rayDirs[i % NUM_RAYS], rayLengths[i % NUM_RAYS]);
+		intSink = qfQuery.quads->size();
+	});
+
+	quadField.Kill();
+}
+
+
+static void DumpResults(const char* fileName)
+{
+	FILE* file = fopen(fileName, "w");
+
+	if (file == nullptr) {
+		printf("could not open \"%s\" for writing\n", fileName);
+		return;
+	}
+
+	fprintf(file, "{\"benchmarks\":[");
+
+	for (size_t n = 0; n < results.size(); n++) {
+		const BenchResult& r = results[n];
+
+		fprintf(file, "%s\n{\"name\":\"%s\",\"iterations\":%u,\"ns_per_iter\":%.3f}", (n > 0)? ",": "", r.name, r.iters, r.nsPerIter);
+	}
+
+	fprintf(file, "\n]}\n");
+	fclose(file);
+
+	printf("wrote %u results to \"%s\"\n", unsigned(results.size()), fileName);
+}
+
+
+int main(int argc, char** argv)
+{
+	// fixed seed, runs must be repeatable
+	srand(12345);
+
+	BenchFloat3();
+	BenchMatrix44f();
+	BenchSimdMath();
+	BenchQuadField();
+
+	DumpResults((argc > 1)? argv[1]: "benchmark-results.json");
+	return 0;
+}
@@ -25,6 +25,7 @@
 #include "System/FileSystem/ArchiveScanner.h"
 #include "System/FileSystem/DataDirsAccess.h"
 #include "System/FileSystem/DataDirLocater.h"
+#include "System/FileSystem/FileQueryFlags.h"
 #include "System/FileSystem/FileHandler.h"
 #include "System/FileSystem/VFSHandler.h"
 #include "System/FileSystem/FileSystem.h"
@@ -575,6 +576,124 @@ EXPORT(const char*) GetArchivePath(const char* archiveName)
 
 
 
+// on-disk cache for extracted map meta-data and minimaps, keyed by the
+// single checksum of the containing archive; only new or changed content
+// pays the (VFS-mount plus Lua-parse) extraction cost across lobby runs
+static constexpr uint32_t MAP_CACHE_VERSION = 1;
+
+struct MapInfoCacheHeader {
+	uint32_t version;
+	int32_t width;
+	int32_t height;
+	int32_t tidalStrength;
+	int32_t gravity;
+	int32_t extractorRadius;
+	int32_t minWind;
+	int32_t maxWind;
+	float maxMetal;
+	uint32_t descriptionLen;
+	uint32_t authorLen;
+	uint32_t numStartPos;
+};
+
+static std::string GetMapCacheFile(const std::string& mapName, const std::string& tag)
+{
+	const std::string archiveName = archiveScanner->ArchiveFromName(mapName);
+
+	// name could not be resolved, entry can not be keyed
+	if (archiveName == mapName)
+		return "";
+
+	const std::string archivePath = archiveScanner->GetArchivePath(archiveName) + archiveName;
+	const uint32_t archiveChecksum = archiveScanner->GetArchiveSingleChecksum(archivePath);
+
+	if (archiveChecksum == 0)
+		return "";
+
+	const std::string cacheDir = dataDirsAccess.LocateDir(FileSystem::GetCacheDir() + "/unitsync/", FileQueryFlags::WRITE | FileQueryFlags::CREATE_DIRS);
+
+	if (cacheDir.empty())
+		return "";
+
+	return (FileSystem::EnsurePathSepAtEnd(cacheDir) + IntToString(archiveChecksum, "%08x") + "." + tag);
+}
+
+static bool ReadMapInfoCache(const std::string& cacheFile, InternalMapInfo* outInfo)
+{
+	if (cacheFile.empty())
+		return false;
+
+	FILE* file = fopen(cacheFile.c_str(), "rb");
+
+	if (file == nullptr)
+		return false;
+
+	MapInfoCacheHeader header;
+
+	bool ok = (fread(&header, sizeof(header), 1, file) == 1);
+
+	ok = ok && (header.version == MAP_CACHE_VERSION);
+	// basic sanity, strings are bounded by the API contract anyway
+	ok = ok && (header.descriptionLen <= 1024) && (header.authorLen <= 1024) && (header.numStartPos <= 255);
+
+	if (ok) {
+		outInfo->width           = header.width;
+		outInfo->height          = header.height;
+		outInfo->tidalStrength   = header.tidalStrength;
+		outInfo->gravity         = header.gravity;
+		outInfo->extractorRadius = header.extractorRadius;
+		outInfo->minWind         = header.minWind;
+		outInfo->maxWind         = header.maxWind;
+		outInfo->maxMetal        = header.maxMetal;
+
+		outInfo->description.resize(header.descriptionLen);
+		outInfo->author.resize(header.authorLen);
+		outInfo->xPos.resize(header.numStartPos);
+		outInfo->zPos.resize(header.numStartPos);
+
+		ok = ok && (header.descriptionLen == 0 || fread(&outInfo->description[0], 1, header.descriptionLen, file) == header.descriptionLen);
+		ok = ok && (header.authorLen      == 0 || fread(&outInfo->author[0],      1, header.authorLen,      file) == header.authorLen     );
+		ok = ok && (header.numStartPos    == 0 || fread(&outInfo->xPos[0], sizeof(float), header.numStartPos, file) == header.numStartPos);
+		ok = ok && (header.numStartPos    == 0 || fread(&outInfo->zPos[0], sizeof(float), header.numStartPos, file) == header.numStartPos);
+	}
+
+	fclose(file);
+	return ok;
+}
+
+static void WriteMapInfoCache(const std::string& cacheFile, const InternalMapInfo& info)
+{
+	if (cacheFile.empty())
+		return;
+
+	FILE* file = fopen(cacheFile.c_str(), "wb");
+
+	if (file == nullptr)
+		return;
+
+	MapInfoCacheHeader header;
+	header.version         = MAP_CACHE_VERSION;
+	header.width           = info.width;
+	header.height          = info.height;
+	header.tidalStrength   = info.tidalStrength;
+	header.gravity         = info.gravity;
+	header.extractorRadius = info.extractorRadius;
+	header.minWind         = info.minWind;
+	header.maxWind         = info.maxWind;
+	header.maxMetal        = info.maxMetal;
+	header.descriptionLen  = info.description.size();
+	header.authorLen       = info.author.size();
+	header.numStartPos     = info.xPos.size();
+
+	fwrite(&header, sizeof(header), 1, file);
+	fwrite(info.description.data(), 1, info.description.size(), file);
+	fwrite(info.author.data(), 1, info.author.size(), file);
+	fwrite(info.xPos.data(), sizeof(float), info.xPos.size(), file);
+	fwrite(info.zPos.data(), sizeof(float), info.zPos.size(), file);
+	fclose(file);
+}
+
+
 static bool internal_GetMapInfo(const char* mapName, InternalMapInfo* outInfo)
 {
 	CheckInit();
@@ -583,6 +702,11 @@ static bool internal_GetMapInfo(const char* mapName, InternalMapInfo* outInfo)
 
 	LOG_L(L_DEBUG, "get map info: %s", mapName);
 
+	const std::string cacheFile = GetMapCacheFile(mapName, "mapinfo");
+
+	if (ReadMapInfoCache(cacheFile, outInfo))
+		return true;
+
 	const std::string mapFile = GetMapFile(mapName);
 
 	ScopedMapLoader mapLoader(mapName, mapFile);
@@ -656,6 +780,7 @@ static bool internal_GetMapInfo(const char* mapName, InternalMapInfo* outInfo)
 		LOG_L(L_DEBUG, "startpos: %.0f, %.0f", pos.x, pos.z);
 	}
 
+	WriteMapInfoCache(cacheFile, *outInfo);
 	return true;
 }
 
@@ -851,6 +976,48 @@ EXPORT(unsigned int) GetMapChecksumFromName(const char* mapName)
 // Used to return the image
 static unsigned short imgbuf[1024*1024];
 
+static bool ReadMinimapCache(const std::string& cacheFile, int mipLevel)
+{
+	if (cacheFile.empty())
+		return false;
+
+	FILE* file = fopen(cacheFile.c_str(), "rb");
+
+	if (file == nullptr)
+		return false;
+
+	const uint32_t mipSize = 1024 >> mipLevel;
+	const size_t numPixels = mipSize * mipSize;
+
+	uint32_t header[2];
+
+	bool ok = (fread(header, sizeof(header), 1, file) == 1);
+
+	ok = ok && (header[0] == MAP_CACHE_VERSION) && (header[1] == mipSize);
+	ok = ok && (fread(imgbuf, sizeof(unsigned short), numPixels, file) == numPixels);
+
+	fclose(file);
+	return ok;
+}
+
+static void WriteMinimapCache(const std::string& cacheFile, int mipLevel)
+{
+	if (cacheFile.empty())
+		return;
+
+	FILE* file = fopen(cacheFile.c_str(), "wb");
+
+	if (file == nullptr)
+		return;
+
+	const uint32_t mipSize = 1024 >> mipLevel;
+	const uint32_t header[2] = {MAP_CACHE_VERSION, mipSize};
+
+	fwrite(header, sizeof(header), 1, file);
+	fwrite(imgbuf, sizeof(unsigned short), mipSize * mipSize, file);
+	fclose(file);
+}
+
 static unsigned short* GetMinimapSM3(std::string mapFileName, int mipLevel)
 {
 	throw content_error("SM3 maps are no longer supported as of Spring 95.0");
@@ -962,6 +1129,12 @@ EXPORT(unsigned short*) GetMinimap(const char* mapName, int mipLevel)
 			throw std::out_of_range("Miplevel must be between 0 and 8 (inclusive) in GetMinimap.");
 
 		const std::string mapFile = GetMapFile(mapName);
+		const std::string cacheFile = GetMapCacheFile(mapName, IntToString(mipLevel, "mm%i"));
+
+		// a cache hit skips mounting the archive entirely
+		if (ReadMinimapCache(cacheFile, mipLevel))
+			return imgbuf;
+
 		ScopedMapLoader mapLoader(mapName, mapFile);
 
 		unsigned short* ret = nullptr;
@@ -972,6 +1145,9 @@ EXPORT(unsigned short*) GetMinimap(const char* mapName, int mipLevel)
 			ret = GetMinimapSM3(mapFile, mipLevel);
 		}
 
+		if (ret != nullptr)
+			WriteMinimapCache(cacheFile, mipLevel);
+
 		return ret;
 	}
 	UNITSYNC_CATCH_BLOCKS;